@@ -0,0 +1,130 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "harness/BenchmarkHarness.h"
+#include "pdk/base/ds/ByteArray.h"
+#include "pdk/base/ds/ByteArrayMatcher.h"
+
+using pdk::ds::ByteArray;
+using pdk::ds::ByteArrayMatcher;
+
+namespace {
+
+constexpr int BUFFER_SIZE = 64 * 1024;
+
+ByteArray make_log_text(int size)
+{
+   ByteArray text;
+   text.reserve(size);
+   for (int i = 0; text.size() < size; ++i) {
+      text.append("2026-10-17 12:00:00 [info] request ");
+      text.append(ByteArray::number(i));
+      text.append(" served\n");
+   }
+   text.truncate(size);
+   return text;
+}
+
+void append_chunks(pdk::benchmark::State &state, int chunkSize, bool reserve)
+{
+   const ByteArray chunk(chunkSize, 'x');
+   const int chunks = BUFFER_SIZE / chunkSize;
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      ByteArray buffer;
+      if (reserve) {
+         buffer.reserve(BUFFER_SIZE);
+      }
+      for (int j = 0; j < chunks; ++j) {
+         buffer.append(chunk);
+      }
+      pdk::benchmark::do_not_optimize(buffer);
+   }
+   state.setBytesPerIteration(chunks * chunkSize);
+}
+
+} // anonymous
+
+PDK_BENCHMARK(ByteArrayAppend16Bytes)
+{
+   append_chunks(state, 16, false);
+}
+
+PDK_BENCHMARK(ByteArrayAppend16BytesReserved)
+{
+   append_chunks(state, 16, true);
+}
+
+PDK_BENCHMARK(ByteArrayAppend4KiB)
+{
+   append_chunks(state, 4096, false);
+}
+
+PDK_BENCHMARK(ByteArrayAppendChar)
+{
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      ByteArray buffer;
+      for (int j = 0; j < 4096; ++j) {
+         buffer.append(static_cast<char>('a' + (j & 15)));
+      }
+      pdk::benchmark::do_not_optimize(buffer);
+   }
+   state.setBytesPerIteration(4096);
+}
+
+// copies only bump the reference count
+PDK_BENCHMARK(ByteArrayCopyShared)
+{
+   const ByteArray source = make_log_text(BUFFER_SIZE);
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      ByteArray copy = source;
+      pdk::benchmark::do_not_optimize(copy);
+   }
+   state.setItemsPerIteration(1);
+}
+
+// the first write to a shared copy pays for the detach
+PDK_BENCHMARK(ByteArrayCopyDetach)
+{
+   const ByteArray source = make_log_text(BUFFER_SIZE);
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      ByteArray copy = source;
+      copy[0] = 'X';
+      pdk::benchmark::do_not_optimize(copy);
+   }
+   state.setBytesPerIteration(BUFFER_SIZE);
+}
+
+PDK_BENCHMARK(ByteArrayIndexOf)
+{
+   ByteArray text = make_log_text(BUFFER_SIZE);
+   text.append("[error] disk full\n");
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      int index = text.indexOf("[error]");
+      pdk::benchmark::do_not_optimize(index);
+   }
+   state.setBytesPerIteration(text.size());
+}
+
+PDK_BENCHMARK(ByteArrayMatcherIndexIn)
+{
+   ByteArray text = make_log_text(BUFFER_SIZE);
+   text.append("[error] disk full\n");
+   const ByteArrayMatcher matcher(ByteArray("[error]"));
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      int index = matcher.indexIn(text);
+      pdk::benchmark::do_not_optimize(index);
+   }
+   state.setBytesPerIteration(text.size());
+}
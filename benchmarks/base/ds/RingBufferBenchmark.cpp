@@ -0,0 +1,72 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "harness/BenchmarkHarness.h"
+#include "pdk/base/ds/internal/RingBufferPrivate.h"
+
+#include <vector>
+
+using pdk::ds::internal::RingBuffer;
+
+namespace {
+
+constexpr int SEGMENT_SIZE = 1460;
+
+// socket style traffic, bursts of segments drained by reads of another size
+void stream_segments(pdk::benchmark::State &state, int chunkSize)
+{
+   const std::vector<char> segment(SEGMENT_SIZE, 'x');
+   char data[3000];
+   RingBuffer buffer(chunkSize);
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      for (int j = 0; j < 6; ++j) {
+         buffer.append(segment.data(), SEGMENT_SIZE);
+      }
+      while (!buffer.isEmpty()) {
+         buffer.read(data, sizeof(data));
+      }
+      pdk::benchmark::do_not_optimize(data);
+   }
+   state.setBytesPerIteration(6 * SEGMENT_SIZE);
+}
+
+} // anonymous
+
+PDK_BENCHMARK(RingBufferStream4KiB)
+{
+   stream_segments(state, 4096);
+}
+
+PDK_BENCHMARK(RingBufferStream16KiB)
+{
+   stream_segments(state, 16384);
+}
+
+// lookups deep into a buffer of many chunks
+PDK_BENCHMARK(RingBufferPeekDeep)
+{
+   const std::vector<char> chunk(4096, 'x');
+   RingBuffer buffer;
+   for (int i = 0; i < 256; ++i) {
+      buffer.append(chunk.data(), 4096);
+   }
+   char data[64];
+   pdk::pint64 pos = 0;
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      pos = (pos + 4099) % (buffer.size() - sizeof(data));
+      pdk::benchmark::do_not_optimize(buffer.peek(data, sizeof(data), pos));
+   }
+   state.setBytesPerIteration(sizeof(data));
+}
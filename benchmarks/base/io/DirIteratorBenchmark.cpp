@@ -0,0 +1,103 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "harness/BenchmarkHarness.h"
+#include "pdk/base/io/fs/DirIterator.h"
+#include "pdk/base/io/fs/Dir.h"
+#include "pdk/base/lang/String.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using pdk::io::fs::Dir;
+using pdk::io::fs::DirIterator;
+using pdk::lang::String;
+
+namespace {
+
+constexpr int FILE_COUNT = 20000;
+constexpr int DIR_COUNT = 100;
+
+// a flat directory of many files and a few subdirectories, removed again
+// when the suite exits
+class ScanDirectory
+{
+public:
+   ScanDirectory()
+   {
+      char path[] = "/tmp/pdk_dir_benchmark_XXXXXX";
+      if (::mkdtemp(path)) {
+         m_root = path;
+      }
+      char name[32];
+      for (int i = 0; i < FILE_COUNT; ++i) {
+         std::snprintf(name, sizeof(name), "/file%05d.dat", i);
+         ::close(::open((m_root + name).c_str(), O_WRONLY | O_CREAT, 0644));
+      }
+      for (int i = 0; i < DIR_COUNT; ++i) {
+         std::snprintf(name, sizeof(name), "/dir%03d", i);
+         ::mkdir((m_root + name).c_str(), 0755);
+      }
+   }
+
+   ~ScanDirectory()
+   {
+      std::string command = "rm -rf " + m_root;
+      pdk::benchmark::do_not_optimize(std::system(command.c_str()));
+   }
+
+   String getPath() const
+   {
+      return String::fromStdString(m_root);
+   }
+
+private:
+   std::string m_root;
+};
+
+const ScanDirectory &scan_directory()
+{
+   static const ScanDirectory directory;
+   return directory;
+}
+
+void scan(pdk::benchmark::State &state, Dir::Filters filters)
+{
+   const String path = scan_directory().getPath();
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      DirIterator iterator(path, filters);
+      while (iterator.hasNext()) {
+         pdk::benchmark::do_not_optimize(iterator.next());
+      }
+   }
+   state.setItemsPerIteration(FILE_COUNT + DIR_COUNT + 2);
+}
+
+} // anonymous
+
+PDK_BENCHMARK(DirIteratorAllEntries)
+{
+   scan(state, Dir::Filter::AllEntries);
+}
+
+// the files are ruled out by their d_type before a FileInfo exists
+PDK_BENCHMARK(DirIteratorDirsOnly)
+{
+   scan(state, Dir::Filter::Dirs);
+}
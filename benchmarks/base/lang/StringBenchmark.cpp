@@ -0,0 +1,311 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "harness/BenchmarkHarness.h"
+#include "pdk/base/lang/String.h"
+#include "pdk/base/lang/StringMatcher.h"
+#include "pdk/utils/Locale.h"
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using pdk::lang::String;
+using pdk::lang::StringMatcher;
+using pdk::lang::Latin1String;
+using pdk::lang::Character;
+using pdk::ds::ByteArray;
+using pdk::utils::Locale;
+
+namespace {
+
+// the same generator everywhere, results only compare when inputs do
+String make_ascii_text(int size)
+{
+   String text;
+   text.reserve(size);
+   for (int i = 0; text.size() < size; ++i) {
+      text.append(Latin1String("GET /api/v1/items?id="));
+      text.append(String::number(i));
+      text.append(Latin1String(" HTTP/1.1\r\n"));
+   }
+   text.truncate(size);
+   return text;
+}
+
+// mostly CJK with ascii punctuation, exercises the 3 byte utf-8 paths
+String make_cjk_text(int size)
+{
+   static const char16_t pattern[] = u"数据库连接, 服务器 ok; ";
+   const int patternLength = static_cast<int>(sizeof(pattern) / sizeof(pattern[0])) - 1;
+   String text;
+   text.reserve(size);
+   while (text.size() < size) {
+      text.append(String::fromUtf16(pattern, patternLength));
+   }
+   text.truncate(size);
+   return text;
+}
+
+// greek words between ascii spaces, exercises the 2 byte utf-8 paths
+String make_greek_text(int size)
+{
+   static const char16_t pattern[] = u"καλημέρα κόσμε, βάση δεδομένων ";
+   const int patternLength = static_cast<int>(sizeof(pattern) / sizeof(pattern[0])) - 1;
+   String text;
+   text.reserve(size);
+   while (text.size() < size) {
+      text.append(String::fromUtf16(pattern, patternLength));
+   }
+   text.truncate(size);
+   return text;
+}
+
+constexpr int TEXT_SIZE = 64 * 1024;
+
+constexpr int INTEGER_COUNT = 4096;
+
+// prices, measurements and random bit patterns, the mix a json api sees
+std::vector<double> make_doubles(int count)
+{
+   std::mt19937_64 random(1017);
+   std::vector<double> values;
+   values.reserve(count);
+   for (int i = 0; values.size() < static_cast<size_t>(count); ++i) {
+      double value;
+      if (i % 3 == 0) {
+         value = static_cast<double>(random() % 1000000) / 100;
+      } else if (i % 3 == 1) {
+         value = std::ldexp(static_cast<double>(random() >> 11), static_cast<int>(random() % 80) - 90);
+      } else {
+         const std::uint64_t bits = random();
+         std::memcpy(&value, &bits, sizeof(value));
+         if (!std::isfinite(value)) {
+            continue;
+         }
+      }
+      values.push_back(value);
+   }
+   return values;
+}
+
+constexpr int DOUBLE_COUNT = 4096;
+
+void to_utf8(pdk::benchmark::State &state, const String &text)
+{
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      ByteArray utf8 = text.toUtf8();
+      pdk::benchmark::do_not_optimize(utf8);
+   }
+   state.setBytesPerIteration(text.size() * sizeof(char16_t));
+}
+
+void from_utf8(pdk::benchmark::State &state, const String &text)
+{
+   const ByteArray utf8 = text.toUtf8();
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      String decoded = String::fromUtf8(utf8);
+      pdk::benchmark::do_not_optimize(decoded);
+   }
+   state.setBytesPerIteration(utf8.size());
+}
+
+void match_pattern(pdk::benchmark::State &state, pdk::CaseSensitivity cs)
+{
+   String text = make_ascii_text(TEXT_SIZE);
+   // the needle sits at the very end, every match scans the whole text
+   text.append(Latin1String("X-Request-Id: abcdef"));
+   const StringMatcher matcher(Latin1String("x-request-id"), cs);
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      int index = matcher.indexIn(text);
+      pdk::benchmark::do_not_optimize(index);
+   }
+   state.setBytesPerIteration(text.size() * sizeof(char16_t));
+}
+
+} // anonymous
+
+PDK_BENCHMARK(StringToUtf8Ascii)
+{
+   to_utf8(state, make_ascii_text(TEXT_SIZE));
+}
+
+PDK_BENCHMARK(StringToUtf8Cjk)
+{
+   to_utf8(state, make_cjk_text(TEXT_SIZE));
+}
+
+PDK_BENCHMARK(StringToUtf8Greek)
+{
+   to_utf8(state, make_greek_text(TEXT_SIZE));
+}
+
+PDK_BENCHMARK(StringFromUtf8Ascii)
+{
+   from_utf8(state, make_ascii_text(TEXT_SIZE));
+}
+
+PDK_BENCHMARK(StringFromUtf8Cjk)
+{
+   from_utf8(state, make_cjk_text(TEXT_SIZE));
+}
+
+PDK_BENCHMARK(StringFromUtf8Greek)
+{
+   from_utf8(state, make_greek_text(TEXT_SIZE));
+}
+
+PDK_BENCHMARK(StringToLatin1)
+{
+   const String text = make_ascii_text(TEXT_SIZE);
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      ByteArray latin1 = text.toLatin1();
+      pdk::benchmark::do_not_optimize(latin1);
+   }
+   state.setBytesPerIteration(text.size() * sizeof(char16_t));
+}
+
+PDK_BENCHMARK(StringFromLatin1)
+{
+   const ByteArray latin1 = make_ascii_text(TEXT_SIZE).toLatin1();
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      String decoded = String::fromLatin1(latin1);
+      pdk::benchmark::do_not_optimize(decoded);
+   }
+   state.setBytesPerIteration(latin1.size());
+}
+
+PDK_BENCHMARK(StringIndexOfChar)
+{
+   // the needle is missing, the whole text is scanned
+   const String text = make_ascii_text(TEXT_SIZE);
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      int index = text.indexOf(Character('#'));
+      pdk::benchmark::do_not_optimize(index);
+   }
+   state.setBytesPerIteration(text.size() * sizeof(char16_t));
+}
+
+PDK_BENCHMARK(StringNumberInt)
+{
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      String number = String::number(static_cast<int>(i * 2654435761u));
+      pdk::benchmark::do_not_optimize(number);
+   }
+   state.setItemsPerIteration(1);
+}
+
+PDK_BENCHMARK(ByteArrayNumberLongLong)
+{
+   ByteArray number;
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      number.setNum(static_cast<pdk::plonglong>(i * PDK_UINT64_C(0x9e3779b97f4a7c15)));
+      pdk::benchmark::do_not_optimize(number);
+   }
+   state.setItemsPerIteration(1);
+}
+
+PDK_BENCHMARK(StringToInt)
+{
+   std::vector<String> texts;
+   for (int i = 0; i < INTEGER_COUNT; ++i) {
+      texts.push_back(String::number(static_cast<int>(i * 2654435761u)));
+   }
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      int value = texts[i % INTEGER_COUNT].toInt();
+      pdk::benchmark::do_not_optimize(value);
+   }
+   state.setItemsPerIteration(1);
+}
+
+PDK_BENCHMARK(ByteArrayToLongLong)
+{
+   std::vector<ByteArray> texts;
+   for (int i = 0; i < INTEGER_COUNT; ++i) {
+      texts.push_back(ByteArray::number(static_cast<pdk::plonglong>(i * PDK_UINT64_C(0x9e3779b97f4a7c15)) >> (i % 64)));
+   }
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      pdk::plonglong value = texts[i % INTEGER_COUNT].toLongLong();
+      pdk::benchmark::do_not_optimize(value);
+   }
+   state.setItemsPerIteration(1);
+}
+
+PDK_BENCHMARK(StringNumberDoubleShortest)
+{
+   const std::vector<double> values = make_doubles(DOUBLE_COUNT);
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      String number = String::number(values[i % DOUBLE_COUNT], 'g', Locale::FloatingPointShortest);
+      pdk::benchmark::do_not_optimize(number);
+   }
+   state.setItemsPerIteration(1);
+}
+
+PDK_BENCHMARK(StringNumberDoublePrecision6)
+{
+   const std::vector<double> values = make_doubles(DOUBLE_COUNT);
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      String number = String::number(values[i % DOUBLE_COUNT]);
+      pdk::benchmark::do_not_optimize(number);
+   }
+   state.setItemsPerIteration(1);
+}
+
+PDK_BENCHMARK(ByteArrayToDouble)
+{
+   const std::vector<double> values = make_doubles(DOUBLE_COUNT);
+   std::vector<ByteArray> texts;
+   for (double value : values) {
+      texts.push_back(ByteArray::number(value, 'g', Locale::FloatingPointShortest));
+   }
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      double value = texts[i % DOUBLE_COUNT].toDouble();
+      pdk::benchmark::do_not_optimize(value);
+   }
+   state.setItemsPerIteration(1);
+}
+
+PDK_BENCHMARK(StringMatcherCaseSensitive)
+{
+   match_pattern(state, pdk::CaseSensitivity::Sensitive);
+}
+
+PDK_BENCHMARK(StringMatcherCaseInsensitive)
+{
+   match_pattern(state, pdk::CaseSensitivity::Insensitive);
+}
+
+PDK_BENCHMARK(StringCompareCaseInsensitive)
+{
+   const String text = make_ascii_text(TEXT_SIZE);
+   const String upper = text.toUpper();
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      int result = String::compare(text, upper, pdk::CaseSensitivity::Insensitive);
+      pdk::benchmark::do_not_optimize(result);
+   }
+   state.setBytesPerIteration(text.size() * sizeof(char16_t));
+}
+
+PDK_BENCHMARK(StringIndexOfCaseInsensitive)
+{
+   // a short needle at the very end, found through its first character
+   String text = make_ascii_text(TEXT_SIZE);
+   text.append(Latin1String("X-Trace: 1"));
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      int index = text.indexOf(Latin1String("x-tra"), 0, pdk::CaseSensitivity::Insensitive);
+      pdk::benchmark::do_not_optimize(index);
+   }
+   state.setBytesPerIteration(text.size() * sizeof(char16_t));
+}
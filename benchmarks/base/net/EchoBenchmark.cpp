@@ -0,0 +1,200 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "harness/BenchmarkHarness.h"
+#include "pdk/base/net/TcpServer.h"
+#include "pdk/base/net/TcpSocket.h"
+#include "pdk/base/net/UdpSocket.h"
+
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+
+using pdk::net::TcpServer;
+using pdk::net::TcpSocket;
+using pdk::net::UdpSocket;
+using pdk::net::NetworkDatagram;
+using pdk::net::HostAddress;
+using pdk::ds::ByteArray;
+
+namespace {
+
+// echoes one connection back to the client from a thread of its own, the
+// sockets there are driven by the blocking waitFor functions
+class TcpEchoServer
+{
+public:
+   TcpEchoServer()
+   {
+      std::promise<pdk::puint16> port;
+      std::future<pdk::puint16> serverPort = port.get_future();
+      m_thread = std::thread([&port]() {
+         TcpServer server;
+         server.listen(HostAddress::SpecialAddress::LocalHost);
+         port.set_value(server.getServerPort());
+         if (!server.waitForNewConnection(-1)) {
+            return;
+         }
+         TcpSocket *socket = server.nextPendingConnection();
+         socket->setNoDelay(true);
+         while (socket->waitForReadyRead(-1)) {
+            socket->write(socket->readAll());
+            while (socket->bytesToWrite() > 0 && socket->waitForBytesWritten(-1)) {
+            }
+         }
+         delete socket;
+      });
+      m_serverPort = serverPort.get();
+   }
+
+   ~TcpEchoServer()
+   {
+      m_thread.join();
+   }
+
+   pdk::puint16 getPort() const
+   {
+      return m_serverPort;
+   }
+
+private:
+   pdk::puint16 m_serverPort;
+   std::thread m_thread;
+};
+
+void echo_over_tcp(pdk::benchmark::State &state, int messageSize, int writesPerMessage)
+{
+   state.pauseTiming();
+   TcpEchoServer server;
+   {
+      TcpSocket client;
+      client.setNoDelay(true);
+      client.connectToHost(HostAddress::SpecialAddress::LocalHost, server.getPort());
+      client.waitForConnected(-1);
+      const int pieceSize = messageSize / writesPerMessage;
+      const ByteArray piece(pieceSize, 'x');
+      state.resumeTiming();
+      for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+         // pieces written back to back leave the socket in one gather write
+         for (int j = 0; j < writesPerMessage; ++j) {
+            client.write(piece);
+         }
+         pdk::pint64 received = 0;
+         while (received < messageSize) {
+            if (client.bytesToWrite() > 0) {
+               client.waitForBytesWritten(-1);
+            }
+            if (client.bytesAvailable() == 0) {
+               client.waitForReadyRead(-1);
+            }
+            received += client.skip(client.bytesAvailable());
+         }
+      }
+      state.pauseTiming();
+      client.disconnectFromHost();
+   }
+   state.setBytesPerIteration(messageSize);
+}
+
+// echoes datagrams in batches until it sees an empty one
+class UdpEchoServer
+{
+public:
+   UdpEchoServer()
+   {
+      std::promise<pdk::puint16> port;
+      std::future<pdk::puint16> serverPort = port.get_future();
+      m_thread = std::thread([&port]() {
+         UdpSocket socket;
+         socket.bind(HostAddress::SpecialAddress::LocalHost);
+         port.set_value(socket.getLocalPort());
+         std::vector<NetworkDatagram> datagrams;
+         while (socket.waitForReadyRead(-1)) {
+            if (socket.readDatagrams(datagrams, 64, 2048) <= 0) {
+               continue;
+            }
+            if (datagrams.back().getData().isEmpty()) {
+               return;
+            }
+            // the sender of each datagram becomes its destination
+            socket.writeDatagrams(datagrams);
+         }
+      });
+      m_serverPort = serverPort.get();
+   }
+
+   ~UdpEchoServer()
+   {
+      UdpSocket stop;
+      stop.writeDatagram(ByteArray(), HostAddress::SpecialAddress::LocalHost, m_serverPort);
+      m_thread.join();
+   }
+
+   pdk::puint16 getPort() const
+   {
+      return m_serverPort;
+   }
+
+private:
+   pdk::puint16 m_serverPort;
+   std::thread m_thread;
+};
+
+void echo_over_udp(pdk::benchmark::State &state, int batchSize)
+{
+   state.pauseTiming();
+   UdpEchoServer server;
+   UdpSocket client;
+   client.bind(HostAddress::SpecialAddress::LocalHost);
+   const std::vector<NetworkDatagram> outgoing(batchSize, NetworkDatagram(ByteArray(64, 'x'),
+                                                                          HostAddress::SpecialAddress::LocalHost,
+                                                                          server.getPort()));
+   std::vector<NetworkDatagram> incoming;
+   state.resumeTiming();
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      client.writeDatagrams(outgoing);
+      int received = 0;
+      // loopback does not drop datagrams unless a socket buffer overflows,
+      // give up on a batch instead of hanging when that happens
+      while (received < batchSize && client.waitForReadyRead(1000)) {
+         received += std::max(client.readDatagrams(incoming, batchSize, 2048), 0);
+      }
+   }
+   state.pauseTiming();
+   state.setItemsPerIteration(batchSize);
+}
+
+} // anonymous
+
+PDK_BENCHMARK(TcpEchoRoundTrip64Bytes)
+{
+   echo_over_tcp(state, 64, 1);
+}
+
+PDK_BENCHMARK(TcpEchoThroughput64KiB)
+{
+   echo_over_tcp(state, 64 * 1024, 16);
+}
+
+PDK_BENCHMARK(UdpEchoSingleDatagram)
+{
+   echo_over_udp(state, 1);
+}
+
+PDK_BENCHMARK(UdpEchoBatch32Datagrams)
+{
+   echo_over_udp(state, 32);
+}
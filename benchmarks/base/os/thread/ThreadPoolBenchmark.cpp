@@ -0,0 +1,132 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "harness/BenchmarkHarness.h"
+#include "pdk/base/os/thread/ThreadPool.h"
+#include "pdk/base/os/thread/Runnable.h"
+
+#include <atomic>
+#include <thread>
+
+using pdk::os::thread::ThreadPool;
+using pdk::os::thread::Runnable;
+
+namespace {
+
+// about as little work as a task can do, so the scheduling cost dominates
+class TinyTask : public Runnable
+{
+public:
+   explicit TinyTask(std::atomic<std::uint64_t> &done)
+      : m_done(done)
+   {}
+   
+   void run() override
+   {
+      m_done.fetch_add(1, std::memory_order_release);
+   }
+   
+private:
+   std::atomic<std::uint64_t> &m_done;
+};
+
+// submits its tiny tasks from inside the pool, the fork-join shape
+// that the local queues are meant for
+class FanOutTask : public Runnable
+{
+public:
+   FanOutTask(ThreadPool &pool, std::atomic<std::uint64_t> &done, std::uint64_t count)
+      : m_pool(pool),
+        m_done(done),
+        m_count(count)
+   {}
+   
+   void run() override
+   {
+      for (std::uint64_t i = 0; i < m_count; ++i) {
+         m_pool.start(new TinyTask(m_done));
+      }
+   }
+   
+private:
+   ThreadPool &m_pool;
+   std::atomic<std::uint64_t> &m_done;
+   std::uint64_t m_count;
+};
+
+void wait_for_tasks(const std::atomic<std::uint64_t> &done, std::uint64_t total)
+{
+   while (done.load(std::memory_order_acquire) < total) {
+      std::this_thread::yield();
+   }
+}
+
+// spin up all the workers before the clock starts
+void warm_up(ThreadPool &pool)
+{
+   std::atomic<std::uint64_t> done(0);
+   const int threads = pool.getMaxThreadCount();
+   for (int i = 0; i < threads; ++i) {
+      pool.start(new TinyTask(done));
+   }
+   wait_for_tasks(done, threads);
+}
+
+void run_fan_out(pdk::benchmark::State &state, bool workStealing)
+{
+   state.pauseTiming();
+   ThreadPool pool;
+   pool.setWorkStealingEnabled(workStealing);
+   warm_up(pool);
+   const std::uint64_t seeds = static_cast<std::uint64_t>(pool.getMaxThreadCount());
+   const std::uint64_t perSeed = (state.getIterations() + seeds - 1) / seeds;
+   std::atomic<std::uint64_t> done(0);
+   state.resumeTiming();
+   for (std::uint64_t i = 0; i < seeds; ++i) {
+      pool.start(new FanOutTask(pool, done, perSeed));
+   }
+   wait_for_tasks(done, seeds * perSeed);
+   state.pauseTiming();
+   pool.waitForDone();
+   state.setItemsPerIteration(1);
+}
+
+} // anonymous
+
+PDK_BENCHMARK(ThreadPoolExternalSubmitTinyTasks)
+{
+   state.pauseTiming();
+   ThreadPool pool;
+   warm_up(pool);
+   std::atomic<std::uint64_t> done(0);
+   state.resumeTiming();
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      pool.start(new TinyTask(done));
+   }
+   wait_for_tasks(done, state.getIterations());
+   state.pauseTiming();
+   pool.waitForDone();
+   state.setItemsPerIteration(1);
+}
+
+PDK_BENCHMARK(ThreadPoolFanOutSharedQueue)
+{
+   run_fan_out(state, false);
+}
+
+PDK_BENCHMARK(ThreadPoolFanOutWorkStealing)
+{
+   run_fan_out(state, true);
+}
@@ -0,0 +1,313 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "harness/BenchmarkHarness.h"
+#include "pdk/base/utils/json/JsonArray.h"
+#include "pdk/base/utils/json/JsonDocument.h"
+#include "pdk/base/utils/json/JsonObject.h"
+#include "pdk/base/utils/json/JsonPath.h"
+#include "pdk/base/utils/json/JsonReader.h"
+#include "pdk/base/utils/json/JsonStreamWriter.h"
+#include "pdk/base/io/Buffer.h"
+#include "pdk/base/io/fs/TemporaryFile.h"
+#include "pdk/base/utils/json/JsonValue.h"
+#include <vector>
+
+using pdk::ds::ByteArray;
+using pdk::io::Buffer;
+using pdk::io::IoDevice;
+using pdk::io::fs::TemporaryFile;
+using pdk::lang::String;
+using pdk::lang::Latin1String;
+using pdk::utils::json::JsonArray;
+using pdk::utils::json::JsonDocument;
+using pdk::utils::json::JsonObject;
+using pdk::utils::json::JsonPath;
+using pdk::utils::json::JsonReader;
+using pdk::utils::json::JsonStreamWriter;
+using pdk::utils::json::JsonValue;
+
+namespace {
+
+// an api response shaped document, records with strings, numbers and
+// nested arrays, about 200 bytes of text per record
+JsonDocument make_document(int records)
+{
+   JsonArray items;
+   for (int i = 0; i < records; ++i) {
+      JsonObject item;
+      item.insert(Latin1String("id"), i);
+      item.insert(Latin1String("name"), String(Latin1String("item \"%1\"\n")).arg(i));
+      item.insert(Latin1String("price"), i * 0.25 + 0.1);
+      item.insert(Latin1String("active"), (i & 1) == 0);
+      JsonArray tags;
+      tags.append(Latin1String("alpha"));
+      tags.append(Latin1String("beta"));
+      tags.append(i % 7);
+      item.insert(Latin1String("tags"), tags);
+      items.append(item);
+   }
+   JsonObject root;
+   root.insert(Latin1String("count"), records);
+   root.insert(Latin1String("items"), items);
+   return JsonDocument(root);
+}
+
+// log message shaped records, long plain ascii strings dominate the text
+ByteArray make_text_document(int records)
+{
+   JsonArray items;
+   for (int i = 0; i < records; ++i) {
+      JsonObject item;
+      item.insert(Latin1String("level"), Latin1String("info"));
+      item.insert(Latin1String("message"), String(Latin1String("request %1 served from the upstream cache after "
+                                                              "revalidation, the client asked for the full body "
+                                                              "and the connection was kept alive for reuse")).arg(i));
+      item.insert(Latin1String("path"), String(Latin1String("/api/v2/catalog/products/%1/variants/details")).arg(i));
+      items.append(item);
+   }
+   return JsonDocument(items).toJson(JsonDocument::JsonFormat::Compact);
+}
+
+// numbers nested a few levels deep and pretty printed, whitespace is
+// more than half of the text
+ByteArray make_indented_numbers(int records)
+{
+   JsonArray rows;
+   for (int i = 0; i < records; ++i) {
+      JsonArray row;
+      for (int j = 0; j < 8; ++j) {
+         row.append(i * 8 + j);
+      }
+      JsonObject cell;
+      cell.insert(Latin1String("row"), row);
+      rows.append(cell);
+   }
+   JsonObject root;
+   root.insert(Latin1String("rows"), rows);
+   return JsonDocument(root).toJson(JsonDocument::JsonFormat::Indented);
+}
+
+constexpr int RECORDS = 1000;
+
+} // anonymous
+
+PDK_BENCHMARK(JsonParseCompact)
+{
+   const ByteArray json = make_document(RECORDS).toJson(JsonDocument::JsonFormat::Compact);
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      JsonDocument document = JsonDocument::fromJson(json);
+      pdk::benchmark::do_not_optimize(document);
+   }
+   state.setBytesPerIteration(json.size());
+}
+
+PDK_BENCHMARK(JsonParseIndented)
+{
+   const ByteArray json = make_document(RECORDS).toJson(JsonDocument::JsonFormat::Indented);
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      JsonDocument document = JsonDocument::fromJson(json);
+      pdk::benchmark::do_not_optimize(document);
+   }
+   state.setBytesPerIteration(json.size());
+}
+
+PDK_BENCHMARK(JsonParseLongStrings)
+{
+   const ByteArray json = make_text_document(RECORDS);
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      JsonDocument document = JsonDocument::fromJson(json);
+      pdk::benchmark::do_not_optimize(document);
+   }
+   state.setBytesPerIteration(json.size());
+}
+
+PDK_BENCHMARK(JsonParseIndentedNumbers)
+{
+   const ByteArray json = make_indented_numbers(RECORDS);
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      JsonDocument document = JsonDocument::fromJson(json);
+      pdk::benchmark::do_not_optimize(document);
+   }
+   state.setBytesPerIteration(json.size());
+}
+
+PDK_BENCHMARK(JsonReaderTokens)
+{
+   ByteArray json = make_document(RECORDS).toJson(JsonDocument::JsonFormat::Compact);
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      Buffer buffer(&json);
+      buffer.open(IoDevice::OpenMode::ReadOnly);
+      JsonReader reader(&buffer);
+      int tokens = 0;
+      while (!reader.atEnd()) {
+         reader.readNext();
+         ++tokens;
+      }
+      pdk::benchmark::do_not_optimize(tokens);
+   }
+   state.setBytesPerIteration(json.size());
+}
+
+PDK_BENCHMARK(JsonSerializeCompact)
+{
+   const JsonDocument document = make_document(RECORDS);
+   pdk::pint64 size = 0;
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      ByteArray json = document.toJson(JsonDocument::JsonFormat::Compact);
+      size = json.size();
+      pdk::benchmark::do_not_optimize(json);
+   }
+   state.setBytesPerIteration(size);
+}
+
+PDK_BENCHMARK(JsonSerializeIndented)
+{
+   const JsonDocument document = make_document(RECORDS);
+   pdk::pint64 size = 0;
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      ByteArray json = document.toJson(JsonDocument::JsonFormat::Indented);
+      size = json.size();
+      pdk::benchmark::do_not_optimize(json);
+   }
+   state.setBytesPerIteration(size);
+}
+
+// the records of make_document() pushed one by one, no tree is built
+PDK_BENCHMARK(JsonStreamWriterCompact)
+{
+   pdk::pint64 size = 0;
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      ByteArray json;
+      Buffer buffer(&json);
+      buffer.open(IoDevice::OpenMode::WriteOnly);
+      {
+         JsonStreamWriter writer(&buffer);
+         writer.beginObject();
+         writer.writeKey(Latin1String("count"));
+         writer.writeNumber(RECORDS);
+         writer.writeKey(Latin1String("items"));
+         writer.beginArray();
+         for (int record = 0; record < RECORDS; ++record) {
+            writer.beginObject();
+            writer.writeKey(Latin1String("active"));
+            writer.writeBool((record & 1) == 0);
+            writer.writeKey(Latin1String("id"));
+            writer.writeNumber(record);
+            writer.writeKey(Latin1String("name"));
+            writer.writeString(String(Latin1String("item \"%1\"\n")).arg(record));
+            writer.writeKey(Latin1String("price"));
+            writer.writeNumber(record * 0.25 + 0.1);
+            writer.writeKey(Latin1String("tags"));
+            writer.beginArray();
+            writer.writeString(Latin1String("alpha"));
+            writer.writeString(Latin1String("beta"));
+            writer.writeNumber(record % 7);
+            writer.endArray();
+            writer.endObject();
+         }
+         writer.endArray();
+         writer.endObject();
+      }
+      size = json.size();
+      pdk::benchmark::do_not_optimize(json);
+   }
+   state.setBytesPerIteration(size);
+}
+
+// loading a binary snapshot, once copied and validated, once mapped
+PDK_BENCHMARK(JsonFromBinaryData)
+{
+   const ByteArray binary = make_document(RECORDS).toBinaryData();
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      JsonDocument document = JsonDocument::fromBinaryData(binary);
+      pdk::benchmark::do_not_optimize(document);
+   }
+   state.setBytesPerIteration(binary.size());
+}
+
+PDK_BENCHMARK(JsonFromMappedFile)
+{
+   const ByteArray binary = make_document(RECORDS).toBinaryData();
+   TemporaryFile file;
+   file.open();
+   file.write(binary);
+   file.close();
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      JsonDocument document = JsonDocument::fromMappedFile(file.getFileName(),
+                                                           JsonDocument::DataValidation::BypassValidation);
+      pdk::benchmark::do_not_optimize(document);
+   }
+   state.setItemsPerIteration(1);
+}
+
+PDK_BENCHMARK(JsonObjectLookup)
+{
+   const JsonObject root = make_document(RECORDS).getObject();
+   const JsonArray items = root.getValue(Latin1String("items")).toArray();
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      const JsonObject item = items.at(static_cast<int>(i % RECORDS)).toObject();
+      double price = item.getValue(Latin1String("price")).toDouble();
+      pdk::benchmark::do_not_optimize(price);
+   }
+   state.setItemsPerIteration(1);
+}
+
+// the same lookup as a compiled path, once per record
+PDK_BENCHMARK(JsonPathLookup)
+{
+   const JsonDocument document = make_document(RECORDS);
+   std::vector<JsonPath> paths;
+   for (int i = 0; i < RECORDS; ++i) {
+      paths.emplace_back(String(Latin1String("/items/%1/price")).arg(i));
+   }
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      double price = paths[i % RECORDS].evaluate(document).toDouble();
+      pdk::benchmark::do_not_optimize(price);
+   }
+   state.setItemsPerIteration(1);
+}
+
+// one wide object, binary search against the hash index
+PDK_BENCHMARK(JsonWideObjectLookup)
+{
+   JsonObject object;
+   std::vector<String> keys;
+   for (int i = 0; i < 4096; ++i) {
+      keys.push_back(String(Latin1String("field_%1")).arg(i * 7919 % 4096));
+      object.insert(keys.back(), i);
+   }
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      int value = object.getValue(keys[i % keys.size()]).toInt();
+      pdk::benchmark::do_not_optimize(value);
+   }
+   state.setItemsPerIteration(1);
+}
+
+PDK_BENCHMARK(JsonWideObjectIndexedLookup)
+{
+   JsonObject object;
+   std::vector<String> keys;
+   for (int i = 0; i < 4096; ++i) {
+      keys.push_back(String(Latin1String("field_%1")).arg(i * 7919 % 4096));
+      object.insert(keys.back(), i);
+   }
+   object.enableLookupIndex();
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      int value = object.getValue(keys[i % keys.size()]).toInt();
+      pdk::benchmark::do_not_optimize(value);
+   }
+   state.setItemsPerIteration(1);
+}
@@ -0,0 +1,107 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+
+#include "harness/BenchmarkHarness.h"
+#include "pdk/global/Logging.h"
+#include "pdk/base/io/LoggingCategory.h"
+
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+using pdk::MessageLogger;
+using pdk::LogOverflowPolicy;
+
+PDK_STATIC_LOGGING_CATEGORY(sg_benchmarkStaticCategory, "pdk.benchmark.static")
+
+namespace {
+
+// pdk.* categories start with debug off, every check below is skipped
+PDK_LOGGING_CATEGORY(benchmark_function_category, "pdk.benchmark.function")
+
+constexpr int CHECKS_PER_ITERATION = 16;
+
+enum class LogMode
+{
+   Formatted,
+   DeferredText,
+   DeferredBinary
+};
+
+// the calling thread's cost of a printf style log call, the writer thread
+// sends everything to /dev/null
+void log_calls(pdk::benchmark::State &state, LogMode mode)
+{
+   ::setenv("PDK_LOGGING_TO_CONSOLE", "1", 1);
+   const int saved = ::dup(STDERR_FILENO);
+   const int null = ::open("/dev/null", O_WRONLY);
+   ::dup2(null, STDERR_FILENO);
+   pdk::enable_async_logging(LogOverflowPolicy::Block, 4 * 1024 * 1024);
+   if (mode != LogMode::Formatted) {
+      pdk::enable_structured_logging(mode == LogMode::DeferredBinary ? "/dev/null" : nullptr);
+   }
+   MessageLogger logger(__FILE__, __LINE__, PDK_FUNC_INFO);
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      logger.info("request %d took %.3f ms for %s", static_cast<int>(i), i * 0.25, "client");
+   }
+   state.pauseTiming();
+   pdk::disable_async_logging();
+   ::dup2(saved, STDERR_FILENO);
+   ::close(saved);
+   ::close(null);
+   state.resumeTiming();
+   state.setItemsPerIteration(1);
+}
+
+} // anonymous
+
+PDK_BENCHMARK(LoggingCategoryDisabledFunction)
+{
+   benchmark_function_category();
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      for (int j = 0; j < CHECKS_PER_ITERATION; ++j) {
+         cdebug_stream(benchmark_function_category, "value %d", j);
+         pdk::benchmark::do_not_optimize(j);
+      }
+   }
+   state.setItemsPerIteration(CHECKS_PER_ITERATION);
+}
+
+PDK_BENCHMARK(LoggingCategoryDisabledStatic)
+{
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      for (int j = 0; j < CHECKS_PER_ITERATION; ++j) {
+         sdebug_stream(sg_benchmarkStaticCategory, "value %d", j);
+         pdk::benchmark::do_not_optimize(j);
+      }
+   }
+   state.setItemsPerIteration(CHECKS_PER_ITERATION);
+}
+
+PDK_BENCHMARK(LoggingFormatted)
+{
+   log_calls(state, LogMode::Formatted);
+}
+
+PDK_BENCHMARK(LoggingDeferredText)
+{
+   log_calls(state, LogMode::DeferredText);
+}
+
+PDK_BENCHMARK(LoggingDeferredBinary)
+{
+   log_calls(state, LogMode::DeferredBinary);
+}
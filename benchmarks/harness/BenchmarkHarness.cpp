@@ -0,0 +1,255 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "harness/BenchmarkHarness.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace pdk {
+namespace benchmark {
+
+namespace {
+
+struct BenchmarkEntry
+{
+   const char *m_name;
+   BenchmarkFunc m_func;
+};
+
+std::vector<BenchmarkEntry> &benchmark_registry()
+{
+   static std::vector<BenchmarkEntry> registry;
+   return registry;
+}
+
+enum class OutputFormat
+{
+   Table,
+   // one json object per line, stable keys so runs of two versions diff well
+   Json,
+   Csv
+};
+
+struct Options
+{
+   std::string m_filter;
+   std::string m_outputFile;
+   double m_minTime = 0.2; // seconds per measured run
+   int m_repetitions = 5;
+   OutputFormat m_format = OutputFormat::Table;
+};
+
+struct Result
+{
+   const char *m_name;
+   std::uint64_t m_iterations;
+   double m_nsPerOp;
+   double m_minNsPerOp;
+   double m_maxNsPerOp;
+   double m_itemsPerSecond;
+   double m_mbPerSecond;
+};
+
+bool parse_options(int argc, char **argv, Options &options)
+{
+   for (int i = 1; i < argc; ++i) {
+      const char *arg = argv[i];
+      if (std::strncmp(arg, "--filter=", 9) == 0) {
+         options.m_filter = arg + 9;
+      } else if (std::strncmp(arg, "--min-time=", 11) == 0) {
+         options.m_minTime = std::atof(arg + 11);
+      } else if (std::strncmp(arg, "--repetitions=", 14) == 0) {
+         options.m_repetitions = std::max(1, std::atoi(arg + 14));
+      } else if (std::strcmp(arg, "--format=table") == 0) {
+         options.m_format = OutputFormat::Table;
+      } else if (std::strcmp(arg, "--format=json") == 0) {
+         options.m_format = OutputFormat::Json;
+      } else if (std::strcmp(arg, "--format=csv") == 0) {
+         options.m_format = OutputFormat::Csv;
+      } else if (std::strncmp(arg, "--output=", 9) == 0) {
+         options.m_outputFile = arg + 9;
+      } else {
+         std::fprintf(stderr, "usage: %s [--filter=substr] [--min-time=seconds] [--repetitions=n]\n"
+                      "       [--format=table|json|csv] [--output=file]\n", argv[0]);
+         return false;
+      }
+   }
+   return true;
+}
+
+// the executable name without its directory, tells the suites apart
+// when the results of several of them are concatenated
+const char *suite_name(const char *argv0)
+{
+   const char *slash = std::strrchr(argv0, '/');
+   return slash ? slash + 1 : argv0;
+}
+
+void print_header(std::FILE *out, OutputFormat format)
+{
+   if (format == OutputFormat::Table) {
+      std::fprintf(out, "%-48s %14s %14s %14s %12s\n", "benchmark", "iterations", "ns/op", "items/s", "MB/s");
+   } else if (format == OutputFormat::Csv) {
+      std::fprintf(out, "suite,benchmark,iterations,ns_per_op,min_ns_per_op,max_ns_per_op,items_per_second,mb_per_second\n");
+   }
+}
+
+void print_result(std::FILE *out, OutputFormat format, const char *suite, const Result &result)
+{
+   const unsigned long long iterations = static_cast<unsigned long long>(result.m_iterations);
+   switch (format) {
+   case OutputFormat::Table:
+      std::fprintf(out, "%-48s %14llu %14.2f %14.0f %12.2f\n", result.m_name,
+                   iterations, result.m_nsPerOp, result.m_itemsPerSecond, result.m_mbPerSecond);
+      break;
+   case OutputFormat::Json:
+      // benchmark names are C identifiers, nothing needs escaping
+      std::fprintf(out, "{\"suite\":\"%s\",\"benchmark\":\"%s\",\"iterations\":%llu,"
+                   "\"ns_per_op\":%.3f,\"min_ns_per_op\":%.3f,\"max_ns_per_op\":%.3f,"
+                   "\"items_per_second\":%.1f,\"mb_per_second\":%.3f}\n",
+                   suite, result.m_name, iterations, result.m_nsPerOp, result.m_minNsPerOp,
+                   result.m_maxNsPerOp, result.m_itemsPerSecond, result.m_mbPerSecond);
+      break;
+   case OutputFormat::Csv:
+      std::fprintf(out, "%s,%s,%llu,%.3f,%.3f,%.3f,%.1f,%.3f\n", suite, result.m_name, iterations,
+                   result.m_nsPerOp, result.m_minNsPerOp, result.m_maxNsPerOp,
+                   result.m_itemsPerSecond, result.m_mbPerSecond);
+      break;
+   }
+   std::fflush(out);
+}
+
+} // anonymous
+
+class Runner
+{
+public:
+   static State run(const BenchmarkFunc &func, std::uint64_t iterations)
+   {
+      State state(iterations);
+      state.start();
+      func(state);
+      state.stop();
+      return state;
+   }
+};
+
+State::State(std::uint64_t iterations)
+   : m_iterations(iterations),
+     m_items(0),
+     m_bytes(0),
+     m_elapsed(0),
+     m_running(false)
+{}
+
+void State::start()
+{
+   m_running = true;
+   m_startTime = Clock::now();
+}
+
+void State::stop()
+{
+   if (m_running) {
+      m_elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - m_startTime);
+      m_running = false;
+   }
+}
+
+void State::pauseTiming()
+{
+   stop();
+}
+
+void State::resumeTiming()
+{
+   start();
+}
+
+int register_benchmark(const char *name, BenchmarkFunc func)
+{
+   benchmark_registry().push_back(BenchmarkEntry{name, std::move(func)});
+   return static_cast<int>(benchmark_registry().size());
+}
+
+int run_benchmarks(int argc, char **argv)
+{
+   Options options;
+   if (!parse_options(argc, argv, options)) {
+      return 1;
+   }
+   std::FILE *out = stdout;
+   if (!options.m_outputFile.empty()) {
+      // appending lets every suite of a run share one result file
+      out = std::fopen(options.m_outputFile.c_str(), "a");
+      if (!out) {
+         std::perror(options.m_outputFile.c_str());
+         return 1;
+      }
+   }
+   const char *suite = suite_name(argv[0]);
+   // a result file that already holds a header only gets more rows
+   if (out == stdout || (std::fseek(out, 0, SEEK_END) == 0 && std::ftell(out) <= 0)) {
+      print_header(out, options.m_format);
+   }
+   for (const BenchmarkEntry &entry : benchmark_registry()) {
+      if (!options.m_filter.empty() && std::strstr(entry.m_name, options.m_filter.c_str()) == nullptr) {
+         continue;
+      }
+      const std::chrono::nanoseconds minTime(static_cast<std::int64_t>(options.m_minTime * 1e9));
+      // grow the iteration count until one run takes long enough to measure
+      std::uint64_t iterations = 1;
+      State probe = Runner::run(entry.m_func, iterations);
+      while (probe.getElapsed() < minTime && iterations < (UINT64_C(1) << 40)) {
+         const double elapsed = std::max<double>(probe.getElapsed().count(), 1.0);
+         const double scale = std::min(std::max(minTime.count() * 1.4 / elapsed, 2.0), 100.0);
+         iterations = static_cast<std::uint64_t>(iterations * scale);
+         probe = Runner::run(entry.m_func, iterations);
+      }
+      std::vector<double> samples;
+      samples.reserve(options.m_repetitions);
+      for (int i = 0; i < options.m_repetitions; ++i) {
+         State state = Runner::run(entry.m_func, iterations);
+         samples.push_back(static_cast<double>(state.getElapsed().count()) / iterations);
+      }
+      std::sort(samples.begin(), samples.end());
+      Result result;
+      result.m_name = entry.m_name;
+      result.m_iterations = iterations;
+      result.m_nsPerOp = samples[samples.size() / 2];
+      result.m_minNsPerOp = samples.front();
+      result.m_maxNsPerOp = samples.back();
+      result.m_itemsPerSecond = probe.getItemsPerIteration() * 1e9 / result.m_nsPerOp;
+      result.m_mbPerSecond = probe.getBytesPerIteration() * 1e9 / result.m_nsPerOp / (1024.0 * 1024.0);
+      print_result(out, options.m_format, suite, result);
+   }
+   if (out != stdout) {
+      std::fclose(out);
+   }
+   return 0;
+}
+
+} // benchmark
+} // pdk
+
+int main(int argc, char **argv)
+{
+   return pdk::benchmark::run_benchmarks(argc, argv);
+}
@@ -0,0 +1,107 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_BENCHMARKS_HARNESS_BENCHMARK_HARNESS_H
+#define PDK_BENCHMARKS_HARNESS_BENCHMARK_HARNESS_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace pdk {
+namespace benchmark {
+
+// state handed to every benchmark body, the body runs its workload
+// getIterations() times and may exclude setup code with pauseTiming()
+class State
+{
+public:
+   using Clock = std::chrono::steady_clock;
+
+   explicit State(std::uint64_t iterations);
+
+   std::uint64_t getIterations() const
+   {
+      return m_iterations;
+   }
+
+   void pauseTiming();
+   void resumeTiming();
+
+   // per iteration workload, used to report items/s and MB/s
+   void setItemsPerIteration(std::uint64_t items)
+   {
+      m_items = items;
+   }
+
+   void setBytesPerIteration(std::uint64_t bytes)
+   {
+      m_bytes = bytes;
+   }
+
+   std::uint64_t getItemsPerIteration() const
+   {
+      return m_items;
+   }
+
+   std::uint64_t getBytesPerIteration() const
+   {
+      return m_bytes;
+   }
+
+   std::chrono::nanoseconds getElapsed() const
+   {
+      return m_elapsed;
+   }
+
+private:
+   friend class Runner;
+   void start();
+   void stop();
+
+   std::uint64_t m_iterations;
+   std::uint64_t m_items;
+   std::uint64_t m_bytes;
+   Clock::time_point m_startTime;
+   std::chrono::nanoseconds m_elapsed;
+   bool m_running;
+};
+
+using BenchmarkFunc = std::function<void(State &)>;
+
+int register_benchmark(const char *name, BenchmarkFunc func);
+int run_benchmarks(int argc, char **argv);
+
+// keep the optimizer from throwing away a computed value
+template <typename T>
+inline void do_not_optimize(const T &value)
+{
+   asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobber_memory()
+{
+   asm volatile("" : : : "memory");
+}
+
+} // benchmark
+} // pdk
+
+#define PDK_BENCHMARK(name) \
+   static void name(pdk::benchmark::State &); \
+   static const int name##Registered = pdk::benchmark::register_benchmark(#name, name); \
+   static void name(pdk::benchmark::State &state)
+
+#endif // PDK_BENCHMARKS_HARNESS_BENCHMARK_HARNESS_H
@@ -0,0 +1,176 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "harness/BenchmarkHarness.h"
+#include "pdk/kernel/CoreApplication.h"
+#include "pdk/kernel/CoreEvent.h"
+#include "pdk/kernel/EventLoop.h"
+#include "pdk/kernel/Object.h"
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using pdk::kernel::CoreApplication;
+using pdk::kernel::Event;
+using pdk::kernel::EventLoop;
+using pdk::kernel::Object;
+using pdk::kernel::TimerEvent;
+
+namespace {
+
+// postEvent and the timers need the dispatcher of the main thread, the
+// application is deliberately kept alive until the process exits
+void ensure_application()
+{
+   static int argc = 1;
+   static char name[] = "KernelBenchmark";
+   static char *argv[] = {name, nullptr};
+   static CoreApplication *app = new CoreApplication(argc, argv);
+   pdk::benchmark::do_not_optimize(app);
+}
+
+const Event::Type BENCHMARK_EVENT = static_cast<Event::Type>(Event::registerEventType());
+
+class CountingReceiver : public Object
+{
+public:
+   bool event(Event *event) override
+   {
+      if (event->getType() == BENCHMARK_EVENT) {
+         m_received.fetch_add(1, std::memory_order_release);
+         return true;
+      }
+      return Object::event(event);
+   }
+
+   void timerEvent(TimerEvent *) override
+   {
+      ++m_timerEvents;
+   }
+
+   std::uint64_t getReceived() const
+   {
+      return m_received.load(std::memory_order_acquire);
+   }
+
+   std::uint64_t m_timerEvents = 0;
+
+private:
+   std::atomic<std::uint64_t> m_received{0};
+};
+
+void process_until(const std::function<bool()> &done)
+{
+   while (!done()) {
+      CoreApplication::processEvents(EventLoop::WaitForMoreEvents);
+   }
+}
+
+void dispatch_timers(pdk::benchmark::State &state, int timerCount)
+{
+   state.pauseTiming();
+   ensure_application();
+   CountingReceiver receiver;
+   std::vector<int> timers;
+   for (int i = 0; i < timerCount; ++i) {
+      timers.push_back(receiver.startTimer(0, pdk::TimerType::PreciseTimer));
+   }
+   const std::uint64_t expected = state.getIterations() * timerCount;
+   state.resumeTiming();
+   process_until([&]() {
+      return receiver.m_timerEvents >= expected;
+   });
+   state.pauseTiming();
+   for (int timerId : timers) {
+      receiver.killTimer(timerId);
+   }
+   state.setItemsPerIteration(timerCount);
+}
+
+} // anonymous
+
+// post and deliver on the same thread, the cost of the queue itself
+PDK_BENCHMARK(PostEventSameThreadBatch1000)
+{
+   state.pauseTiming();
+   ensure_application();
+   CountingReceiver receiver;
+   state.resumeTiming();
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      for (int j = 0; j < 1000; ++j) {
+         CoreApplication::postEvent(&receiver, new Event(BENCHMARK_EVENT));
+      }
+      CoreApplication::sendPostedEvents(&receiver, BENCHMARK_EVENT);
+   }
+   state.setItemsPerIteration(1000);
+}
+
+// one event at a time from another thread, which waits until it was
+// delivered, so ns/op is the wake up latency of the receiving loop
+PDK_BENCHMARK(PostEventCrossThreadRoundTrip)
+{
+   state.pauseTiming();
+   ensure_application();
+   CountingReceiver receiver;
+   const std::uint64_t iterations = state.getIterations();
+   state.resumeTiming();
+   std::thread poster([&]() {
+      for (std::uint64_t i = 0; i < iterations; ++i) {
+         CoreApplication::postEvent(&receiver, new Event(BENCHMARK_EVENT));
+         while (receiver.getReceived() <= i) {
+            std::this_thread::yield();
+         }
+      }
+   });
+   process_until([&]() {
+      return receiver.getReceived() >= iterations;
+   });
+   state.pauseTiming();
+   poster.join();
+   state.setItemsPerIteration(1);
+}
+
+// posts without waiting, most posts find the inbox already non empty
+PDK_BENCHMARK(PostEventCrossThreadBurst)
+{
+   state.pauseTiming();
+   ensure_application();
+   CountingReceiver receiver;
+   const std::uint64_t total = state.getIterations() * 100;
+   state.resumeTiming();
+   std::thread poster([&]() {
+      for (std::uint64_t i = 0; i < total; ++i) {
+         CoreApplication::postEvent(&receiver, new Event(BENCHMARK_EVENT));
+      }
+   });
+   process_until([&]() {
+      return receiver.getReceived() >= total;
+   });
+   state.pauseTiming();
+   poster.join();
+   state.setItemsPerIteration(100);
+}
+
+PDK_BENCHMARK(TimerDispatchSingleZeroTimer)
+{
+   dispatch_timers(state, 1);
+}
+
+PDK_BENCHMARK(TimerDispatch100ZeroTimers)
+{
+   dispatch_timers(state, 100);
+}
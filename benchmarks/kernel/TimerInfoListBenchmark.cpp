@@ -0,0 +1,205 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "harness/BenchmarkHarness.h"
+#include "pdk/kernel/Object.h"
+#include "pdk/kernel/internal/TimerInfoUnixPrivate.h"
+#include "pdk/kernel/internal/CoreUnixPrivate.h"
+
+#include <list>
+#include <time.h>
+
+using pdk::kernel::Object;
+using pdk::kernel::internal::TimerInfo;
+using pdk::kernel::internal::TimerInfoList;
+using pdk::kernel::operator<;
+
+namespace {
+
+constexpr int REGISTERED_TIMERS = 10000;
+
+timespec current_time()
+{
+   timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts;
+}
+
+timespec timeout_after(const timespec &now, int ms)
+{
+   timespec ts = now;
+   ts.tv_sec += ms / 1000;
+   ts.tv_nsec += (ms % 1000) * 1000 * 1000;
+   return pdk::kernel::normalized_timespec(ts);
+}
+
+// the sorted std::list layout TimerInfoList used before it became a heap,
+// kept here as the baseline: sorted linear insertion and lookup by id
+class SortedTimerList : public std::list<TimerInfo *>
+{
+public:
+   ~SortedTimerList()
+   {
+      for (TimerInfo *t : *this) {
+         delete t;
+      }
+   }
+
+   void registerTimer(int timerId, int interval)
+   {
+      TimerInfo *t = new TimerInfo;
+      t->m_id = timerId;
+      t->m_interval = interval;
+      t->m_timerType = pdk::TimerType::CoarseTimer;
+      t->m_obj = nullptr;
+      t->m_activateRef = nullptr;
+      t->m_timeout = timeout_after(current_time(), interval);
+      iterator iter = begin();
+      while (iter != end() && !(t->m_timeout < (*iter)->m_timeout)) {
+         ++iter;
+      }
+      insert(iter, t);
+   }
+
+   bool unregisterTimer(int timerId)
+   {
+      for (iterator iter = begin(); iter != end(); ++iter) {
+         if ((*iter)->m_id == timerId) {
+            delete *iter;
+            erase(iter);
+            return true;
+         }
+      }
+      return false;
+   }
+
+   bool timerWait(timespec &tm)
+   {
+      for (TimerInfo *t : *this) {
+         if (!t->m_activateRef) {
+            tm = t->m_timeout;
+            return true;
+         }
+      }
+      return false;
+   }
+};
+
+// spread the per connection timeouts between 1 and 30 seconds
+int connection_timeout(int index)
+{
+   return 1000 + (index * 7919) % 29000;
+}
+
+} // anonymous
+
+PDK_BENCHMARK(TimerInfoListRegisterUnregister)
+{
+   state.pauseTiming();
+   Object receiver;
+   TimerInfoList timers;
+   for (int i = 1; i <= REGISTERED_TIMERS; ++i) {
+      timers.registerTimer(i, connection_timeout(i), pdk::TimerType::CoarseTimer, &receiver);
+   }
+   state.resumeTiming();
+   // restart one connection timeout per iteration
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      const int timerId = static_cast<int>(i % REGISTERED_TIMERS) + 1;
+      timers.unregisterTimer(timerId);
+      timers.registerTimer(timerId, connection_timeout(static_cast<int>(i)),
+                           pdk::TimerType::CoarseTimer, &receiver);
+   }
+   state.pauseTiming();
+   for (TimerInfo *t : timers) {
+      delete t;
+   }
+   state.setItemsPerIteration(1);
+}
+
+PDK_BENCHMARK(SortedListRegisterUnregister)
+{
+   state.pauseTiming();
+   SortedTimerList timers;
+   for (int i = 1; i <= REGISTERED_TIMERS; ++i) {
+      timers.registerTimer(i, connection_timeout(i));
+   }
+   state.resumeTiming();
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      const int timerId = static_cast<int>(i % REGISTERED_TIMERS) + 1;
+      timers.unregisterTimer(timerId);
+      timers.registerTimer(timerId, connection_timeout(static_cast<int>(i)));
+   }
+   state.pauseTiming();
+   state.setItemsPerIteration(1);
+}
+
+PDK_BENCHMARK(TimerInfoListTimerWait)
+{
+   state.pauseTiming();
+   Object receiver;
+   TimerInfoList timers;
+   for (int i = 1; i <= REGISTERED_TIMERS; ++i) {
+      timers.registerTimer(i, connection_timeout(i), pdk::TimerType::CoarseTimer, &receiver);
+   }
+   state.resumeTiming();
+   timespec tm;
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      pdk::benchmark::do_not_optimize(timers.timerWait(tm));
+   }
+   state.pauseTiming();
+   for (TimerInfo *t : timers) {
+      delete t;
+   }
+   state.setItemsPerIteration(1);
+}
+
+PDK_BENCHMARK(SortedListTimerWait)
+{
+   state.pauseTiming();
+   SortedTimerList timers;
+   for (int i = 1; i <= REGISTERED_TIMERS; ++i) {
+      timers.registerTimer(i, connection_timeout(i));
+   }
+   state.resumeTiming();
+   timespec tm;
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      pdk::benchmark::do_not_optimize(timers.timerWait(tm));
+   }
+   state.pauseTiming();
+   state.setItemsPerIteration(1);
+}
+
+PDK_BENCHMARK(TimerInfoListActivateTimers)
+{
+   constexpr int DUE_TIMERS = 100;
+   state.pauseTiming();
+   Object receiver;
+   TimerInfoList timers;
+   for (int i = 1; i <= REGISTERED_TIMERS; ++i) {
+      // a handful of zero interval timers are due on every pass,
+      // the rest are idle connection timeouts
+      int interval = i <= DUE_TIMERS ? 0 : connection_timeout(i);
+      timers.registerTimer(i, interval, pdk::TimerType::PreciseTimer, &receiver);
+   }
+   state.resumeTiming();
+   for (std::uint64_t i = 0; i < state.getIterations(); ++i) {
+      pdk::benchmark::do_not_optimize(timers.getActivateTimers());
+   }
+   state.pauseTiming();
+   for (TimerInfo *t : timers) {
+      delete t;
+   }
+   state.setItemsPerIteration(DUE_TIMERS);
+}
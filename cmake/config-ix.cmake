@@ -36,6 +36,7 @@ check_include_file(unistd.h PDK_HAVE_UNISTD_H)
 check_include_file(valgrind/valgrind.h PDK_HAVE_VALGRIND_VALGRIND_H)
 check_include_file(zlib.h PDK_HAVE_ZLIB_H)
 check_include_file(fenv.h PDK_HAVE_FENV_H)
+check_include_file(linux/io_uring.h PDK_HAVE_LINUX_IO_URING_H)
 
 # library checks
 check_library_exists(pthread pthread_create "" PDK_HAVE_LIBPTHREAD)
@@ -44,6 +45,9 @@ check_library_exists(pthread pthread_rwlock_init "" PDK_HAVE_PTHREAD_RWLOCK_INIT
 check_library_exists(pthread pthread_mutex_lock "" PDK_HAVE_PTHREAD_MUTEX_LOCK)
 check_library_exists(dl dlopen "" PDK_HAVE_LIBDL)
 check_library_exists(rt clock_gettime "" PDK_HAVE_LIBRT)
+if(PDK_ENABLE_ZLIB AND PDK_HAVE_ZLIB_H)
+    check_library_exists(z compress2 "" PDK_HAVE_LIBZ)
+endif()
 
 # function checks
 check_symbol_exists(getpagesize unistd.h HAVE_GETPAGESIZE)
@@ -61,6 +65,10 @@ endif()
 set(CMAKE_REQUIRED_DEFINITIONS "-D_LARGEFILE64_SOURCE")
 check_symbol_exists(lseek64 "sys/types.h;unistd.h" PDK_HAVE_LSEEK64)
 set(CMAKE_REQUIRED_DEFINITIONS "")
+set(CMAKE_REQUIRED_DEFINITIONS "-D_GNU_SOURCE")
+check_symbol_exists(posix_spawn_file_actions_addchdir_np spawn.h
+    PDK_HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCHDIR_NP)
+set(CMAKE_REQUIRED_DEFINITIONS "")
 
 check_symbol_exists(mallctl malloc_np.h PDK_HAVE_MALLCTL)
 check_symbol_exists(mallinfo malloc.h PDK_HAVE_MALLINFO)
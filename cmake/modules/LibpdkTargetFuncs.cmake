@@ -632,3 +632,23 @@ function(pdk_add_unittest test_suite test_name)
         set_property(TARGET ${test_name} PROPERTY FOLDER "${test_suite_folder}")
     endif ()
 endfunction()
+
+# Generic support for adding a benchmark, every benchmark executable links
+# the small harness in benchmarks/harness which provides main().
+function(pdk_add_benchmark benchmark_suite benchmark_name)
+    if(NOT PDK_ENABLE_BENCHMARK)
+        set(EXCLUDE_FROM_ALL ON)
+    endif()
+    include_directories(${PDK_MAIN_SRC_DIR}/benchmarks)
+    pdk_add_executable(${benchmark_name} IGNORE_EXTERNALIZE_DEBUGINFO NO_INSTALL_RPATH
+        ${ARGN} ${PDK_BENCHMARK_HARNESS_SOURCES})
+    set(outdir ${CMAKE_CURRENT_BINARY_DIR}/${CMAKE_CFG_INTDIR})
+    pdk_set_output_directory(${benchmark_name} BINARY_DIR ${outdir} LIBRARY_DIR ${outdir})
+    target_link_libraries(${benchmark_name} ${PDK_PTHREAD_LIB} libpdk)
+    add_dependencies(${benchmark_suite} ${benchmark_name})
+    set_property(GLOBAL APPEND PROPERTY PDK_BENCHMARK_TARGETS ${benchmark_name})
+    get_target_property(benchmark_suite_folder ${benchmark_suite} FOLDER)
+    if (NOT ${benchmark_suite_folder} STREQUAL "NOTFOUND")
+        set_property(TARGET ${benchmark_name} PROPERTY FOLDER "${benchmark_suite_folder}")
+    endif ()
+endfunction()
@@ -0,0 +1,144 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_COMPRESS_ARCHIVE_H
+#define PDK_M_BASE_COMPRESS_ARCHIVE_H
+
+#include "pdk/global/Global.h"
+#include "pdk/base/ds/ByteArray.h"
+#include "pdk/base/ds/StringList.h"
+#include "pdk/base/lang/String.h"
+#include "pdk/base/io/IoDevice.h"
+#include "pdk/utils/ScopedPointer.h"
+
+namespace pdk {
+namespace compress {
+
+// forward declare class with namespace
+namespace internal {
+class ArchivePrivate;
+} // internal
+
+using internal::ArchivePrivate;
+using pdk::ds::ByteArray;
+using pdk::ds::StringList;
+using pdk::lang::String;
+using pdk::io::IoDevice;
+using pdk::kernel::Object;
+
+class PDK_CORE_EXPORT ArchiveEntry
+{
+public:
+   enum class Method
+   {
+      Stored,
+      Deflated,
+      // encrypted entries and compression methods we can not decode
+      Unsupported
+   };
+
+   ArchiveEntry();
+
+   String getName() const;
+   // the name as raw bytes, the view points into the mapped archive
+   ByteArray getRawName() const;
+   Method getMethod() const
+   {
+      return m_method;
+   }
+
+   pdk::pint64 getSize() const
+   {
+      return m_size;
+   }
+
+   pdk::pint64 getCompressedSize() const
+   {
+      return m_compressedSize;
+   }
+
+   pdk::puint32 getCrc32() const
+   {
+      return m_crc32;
+   }
+
+   bool isDir() const;
+
+private:
+   friend class internal::ArchivePrivate;
+   const char *m_name;
+   int m_nameLength;
+   Method m_method;
+   pdk::puint32 m_crc32;
+   pdk::pint64 m_size;
+   pdk::pint64 m_compressedSize;
+   // zip only knows where the local header starts, the data offset is
+   // looked up on first access so indexing never touches the entry pages
+   pdk::pint64 m_headerOffset;
+   mutable pdk::pint64 m_dataOffset;
+};
+
+// read only access to an archive file, the file is mapped once and the
+// directory is indexed on open. stored entries are handed out as views
+// into the mapping. close() and the destructor unmap the file, every view
+// and device returned here is dangling after that, copy the data with
+// ByteArray(view.getConstRawData(), view.size()) to keep it longer.
+class PDK_CORE_EXPORT Archive
+{
+public:
+   virtual ~Archive();
+
+   bool open();
+   void close();
+   bool isOpen() const;
+   String getFileName() const;
+   String getErrorString() const;
+
+   int getEntryCount() const;
+   const ArchiveEntry &getEntry(int index) const;
+   const ArchiveEntry *findEntry(const String &name) const;
+   bool contains(const String &name) const
+   {
+      return findEntry(name) != nullptr;
+   }
+
+   StringList getEntryNames() const;
+
+   // the bytes of the entry as they are stored in the archive, a view
+   // into the mapping that is not checked against the crc-32
+   ByteArray getRawData(const ArchiveEntry &entry) const;
+   // stored entries come back as views into the mapping, deflated ones
+   // are inflated into a buffer of their own. the crc-32 of the directory
+   // is checked, a mismatch gives an empty array.
+   ByteArray readEntry(const String &name) const;
+   // a readable device over the entry, deflated data is decompressed
+   // while it is read. the device reads from the mapping and does not
+   // check the crc-32. the caller owns the device and has to delete it
+   // before the archive is closed.
+   IoDevice *openEntry(const String &name, Object *parent = nullptr) const;
+
+protected:
+   Archive(ArchivePrivate &dd);
+   pdk::utils::ScopedPointer<ArchivePrivate> m_implPtr;
+
+private:
+   PDK_DECLARE_PRIVATE(Archive);
+   PDK_DISABLE_COPY(Archive);
+};
+
+} // compress
+} // pdk
+
+#endif // PDK_M_BASE_COMPRESS_ARCHIVE_H
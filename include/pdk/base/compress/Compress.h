@@ -0,0 +1,58 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_COMPRESS_COMPRESS_H
+#define PDK_M_BASE_COMPRESS_COMPRESS_H
+
+#include "pdk/global/Global.h"
+#include "pdk/base/ds/ByteArray.h"
+
+namespace pdk {
+namespace compress {
+
+using pdk::ds::ByteArray;
+
+enum class CompressionFormat
+{
+   // zlib header and adler32 trailer
+   Zlib,
+   // gzip header and crc32 trailer, readable by the gzip tool
+   Gzip,
+   // deflate data without any framing
+   RawDeflate,
+   // decompression only, takes zlib as well as gzip streams
+   AutoDetect
+};
+
+// the result starts with the uncompressed size as a 32 bit big endian
+// number followed by a zlib stream, the layout the resource compiler uses.
+// level runs from 0 to 9, -1 picks the zlib default.
+PDK_CORE_EXPORT ByteArray compress(const char *data, int size, int level = -1);
+PDK_CORE_EXPORT ByteArray uncompress(const char *data, int size);
+
+inline ByteArray compress(const ByteArray &data, int level = -1)
+{
+   return compress(data.getConstRawData(), data.size(), level);
+}
+
+inline ByteArray uncompress(const ByteArray &data)
+{
+   return uncompress(data.getConstRawData(), data.size());
+}
+
+} // compress
+} // pdk
+
+#endif // PDK_M_BASE_COMPRESS_COMPRESS_H
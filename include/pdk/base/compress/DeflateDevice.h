@@ -0,0 +1,72 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_COMPRESS_DEFLATE_DEVICE_H
+#define PDK_M_BASE_COMPRESS_DEFLATE_DEVICE_H
+
+#include "pdk/base/io/IoDevice.h"
+#include "pdk/base/compress/Compress.h"
+
+namespace pdk {
+namespace compress {
+
+// forward declare class with namespace
+namespace internal {
+class DeflateDevicePrivate;
+} // internal
+
+using internal::DeflateDevicePrivate;
+using pdk::io::IoDevice;
+using pdk::kernel::Object;
+
+// compresses everything written to it into another device, a chunk at a
+// time so that memory use does not depend on the amount of data. The
+// stream trailer is written by close(), the target device stays open.
+class PDK_CORE_EXPORT DeflateDevice : public IoDevice
+{
+public:
+   // level runs from 0 to 9, -1 picks the zlib default
+   explicit DeflateDevice(IoDevice *device, CompressionFormat format = CompressionFormat::Zlib,
+                          int level = -1, Object *parent = nullptr);
+   ~DeflateDevice();
+
+   IoDevice *getDevice() const;
+   CompressionFormat getFormat() const;
+   // bytes written to this device and bytes handed to the target so far
+   pdk::pint64 getTotalIn() const;
+   pdk::pint64 getTotalOut() const;
+
+   // only write only mode is supported, the target is opened for writing
+   // when it is not open yet
+   bool open(OpenModes mode) override;
+   void close() override;
+   bool isSequential() const override;
+   // pushes all pending data to the target on a byte boundary, so that
+   // the reading side can decode it without waiting for more
+   bool flush();
+
+protected:
+   pdk::pint64 readData(char *data, pdk::pint64 maxLength) override;
+   pdk::pint64 writeData(const char *data, pdk::pint64 length) override;
+
+private:
+   PDK_DECLARE_PRIVATE(DeflateDevice);
+   PDK_DISABLE_COPY(DeflateDevice);
+};
+
+} // compress
+} // pdk
+
+#endif // PDK_M_BASE_COMPRESS_DEFLATE_DEVICE_H
@@ -0,0 +1,69 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_COMPRESS_INFLATE_DEVICE_H
+#define PDK_M_BASE_COMPRESS_INFLATE_DEVICE_H
+
+#include "pdk/base/io/IoDevice.h"
+#include "pdk/base/compress/Compress.h"
+
+namespace pdk {
+namespace compress {
+
+// forward declare class with namespace
+namespace internal {
+class InflateDevicePrivate;
+} // internal
+
+using internal::InflateDevicePrivate;
+using pdk::io::IoDevice;
+using pdk::kernel::Object;
+
+// decompresses data read from another device on demand, the compressed
+// side is pulled in fixed size chunks
+class PDK_CORE_EXPORT InflateDevice : public IoDevice
+{
+public:
+   explicit InflateDevice(IoDevice *device, CompressionFormat format = CompressionFormat::AutoDetect,
+                          Object *parent = nullptr);
+   ~InflateDevice();
+
+   IoDevice *getDevice() const;
+   CompressionFormat getFormat() const;
+   pdk::pint64 getTotalIn() const;
+   pdk::pint64 getTotalOut() const;
+
+   // only read only mode is supported, the source is opened for reading
+   // when it is not open yet
+   bool open(OpenModes mode) override;
+   void close() override;
+   bool isSequential() const override;
+   // true once the end of the compressed stream was seen and all of the
+   // decompressed data has been read
+   bool atEnd() const override;
+
+protected:
+   pdk::pint64 readData(char *data, pdk::pint64 maxLength) override;
+   pdk::pint64 writeData(const char *data, pdk::pint64 length) override;
+
+private:
+   PDK_DECLARE_PRIVATE(InflateDevice);
+   PDK_DISABLE_COPY(InflateDevice);
+};
+
+} // compress
+} // pdk
+
+#endif // PDK_M_BASE_COMPRESS_INFLATE_DEVICE_H
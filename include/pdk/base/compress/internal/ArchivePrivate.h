@@ -0,0 +1,73 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_COMPRESS_INTERNAL_ARCHIVE_PRIVATE_H
+#define PDK_M_BASE_COMPRESS_INTERNAL_ARCHIVE_PRIVATE_H
+
+#include "pdk/base/compress/Archive.h"
+#include "pdk/base/io/fs/File.h"
+
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace pdk {
+namespace compress {
+namespace internal {
+
+using pdk::io::fs::File;
+
+class ArchivePrivate
+{
+public:
+   ArchivePrivate(const String &fileName);
+   virtual ~ArchivePrivate();
+
+   // fills m_entries from the mapped data, sets m_errorString on failure
+   virtual bool readDirectory() = 0;
+
+   bool map();
+   void unmap();
+   void reset();
+   void addEntry(const char *name, int nameLength, ArchiveEntry::Method method,
+                 pdk::puint32 crc32, pdk::pint64 size, pdk::pint64 compressedSize,
+                 pdk::pint64 headerOffset, pdk::pint64 dataOffset);
+   void buildIndex();
+   // -1 when the entry data does not lie inside the mapping
+   pdk::pint64 getDataOffset(const ArchiveEntry &entry) const;
+   // compares the crc-32 of the uncompressed data with the directory
+   static bool checkCrc32(const ArchiveEntry &entry, const ByteArray &data);
+   bool isInside(pdk::pint64 offset, pdk::pint64 length) const
+   {
+      return offset >= 0 && length >= 0 && offset <= m_size && length <= m_size - offset;
+   }
+
+   File m_file;
+   String m_errorString;
+   const uchar *m_data;
+   pdk::pint64 m_size;
+   std::vector<ArchiveEntry> m_entries;
+   // names are views into the mapping
+   std::unordered_map<std::string_view, int> m_index;
+};
+
+// parses a zip central directory, shared with zip based phar archives
+bool read_zip_directory(ArchivePrivate &archive);
+
+} // internal
+} // compress
+} // pdk
+
+#endif // PDK_M_BASE_COMPRESS_INTERNAL_ARCHIVE_PRIVATE_H
@@ -0,0 +1,43 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_COMPRESS_INTERNAL_COMPRESS_PRIVATE_H
+#define PDK_M_BASE_COMPRESS_INTERNAL_COMPRESS_PRIVATE_H
+
+#include "pdk/base/compress/Compress.h"
+#include "pdk/base/lang/String.h"
+
+namespace pdk {
+namespace compress {
+namespace internal {
+
+using pdk::lang::String;
+
+enum
+{
+   // the most bytes the streaming devices hold on either side of zlib
+   CompressChunkSize = 16384
+};
+
+// the windowBits argument of deflateInit2() and inflateInit2()
+int get_window_bits(CompressionFormat format, bool inflating);
+// message is the msg field of the stream, it may be null
+String zlib_error_string(int errorCode, const char *message);
+
+} // internal
+} // compress
+} // pdk
+
+#endif // PDK_M_BASE_COMPRESS_INTERNAL_COMPRESS_PRIVATE_H
@@ -0,0 +1,52 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_COMPRESS_PHAR_PHAR_ARCHIVE_H
+#define PDK_M_BASE_COMPRESS_PHAR_PHAR_ARCHIVE_H
+
+#include "pdk/base/compress/Archive.h"
+
+namespace pdk {
+namespace compress {
+namespace phar {
+
+// forward declare class with namespace
+namespace internal {
+class PharArchivePrivate;
+} // internal
+
+using internal::PharArchivePrivate;
+
+// reads php archives in the native phar layout as well as zip based ones,
+// tar based phars are not supported. gzip compressed entries come back
+// inflated, bzip2 compressed ones are reported as unsupported.
+class PDK_CORE_EXPORT PharArchive : public Archive
+{
+public:
+   explicit PharArchive(const String &fileName);
+   ~PharArchive();
+
+   // the alias recorded in the manifest, empty for zip based phars
+   String getAlias() const;
+
+private:
+   PDK_DECLARE_PRIVATE(PharArchive);
+};
+
+} // phar
+} // compress
+} // pdk
+
+#endif // PDK_M_BASE_COMPRESS_PHAR_PHAR_ARCHIVE_H
@@ -0,0 +1,48 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_COMPRESS_ZIP_ZIP_ARCHIVE_H
+#define PDK_M_BASE_COMPRESS_ZIP_ZIP_ARCHIVE_H
+
+#include "pdk/base/compress/Archive.h"
+
+namespace pdk {
+namespace compress {
+namespace zip {
+
+// forward declare class with namespace
+namespace internal {
+class ZipArchivePrivate;
+} // internal
+
+using internal::ZipArchivePrivate;
+
+// reads stored and deflated entries of zip and zip64 files, archives
+// spanning several disks are rejected
+class PDK_CORE_EXPORT ZipArchive : public Archive
+{
+public:
+   explicit ZipArchive(const String &fileName);
+   ~ZipArchive();
+
+private:
+   PDK_DECLARE_PRIVATE(ZipArchive);
+};
+
+} // zip
+} // compress
+} // pdk
+
+#endif // PDK_M_BASE_COMPRESS_ZIP_ZIP_ARCHIVE_H
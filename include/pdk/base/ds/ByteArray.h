@@ -458,6 +458,8 @@ private:
    static ByteArray trimmedHelper(ByteArray &a);
    static ByteArray simplifiedHelper(const ByteArray &a);
    static ByteArray simplifiedHelper(ByteArray &a);
+   template <typename T>
+   T toIntegralHelper(bool *ok, int base) const;
    
    friend class ByteRef;
    friend class String;
@@ -18,12 +18,17 @@
 
 #include "pdk/global/Global.h"
 #include "pdk/base/ds/ByteArray.h"
-#include <list>
+#include <deque>
 
 #ifndef PDK_RING_BUFFER_CHUNK_SIZE
 #define PDK_RING_BUFFER_CHUNK_SIZE 4096
 #endif
 
+// bytes of drained chunks each thread keeps for reuse, 0 disables the pool
+#ifndef PDK_RING_BUFFER_POOL_SIZE
+#define PDK_RING_BUFFER_POOL_SIZE (256 * 1024)
+#endif
+
 namespace pdk {
 namespace ds {
 namespace internal {
@@ -60,6 +65,12 @@ class RingBuffer
    }
    
    PDK_CORE_EXPORT const char *readPointerAtPosition(pdk::pint64 pos, pdk::pint64 &length) const;
+   // fills up to maxSegments contiguous blocks of the buffered data in order,
+   // ready for a scatter/gather write, returns the number of blocks filled
+   PDK_CORE_EXPORT int readSegments(const char **segments, pdk::pint64 *lengths, int maxSegments) const;
+   // makes the first length bytes contiguous, copying them into one chunk
+   // only when they span several, returns nullptr if fewer bytes are buffered
+   PDK_CORE_EXPORT const char *linearize(pdk::pint64 length);
    PDK_CORE_EXPORT void free(pdk::pint64 bytes);
    PDK_CORE_EXPORT char *reserve(pdk::pint64 bytes);
    PDK_CORE_EXPORT char *reserveFront(pdk::pint64 bytes);
@@ -135,8 +146,14 @@ class RingBuffer
    {
       return indexOf('\n') >= 0;
    }
+   
+   // drained chunks the calling thread holds for reuse
+   PDK_CORE_EXPORT static int getPooledChunkCount();
 private:
-   std::list<ByteArray> m_buffers;
+   ByteArray allocateChunk(int size);
+   void recycleChunk(ByteArray &chunk);
+   
+   std::deque<ByteArray> m_buffers;
    int m_head;
    int m_tail;
    int m_tailBuffer;
@@ -19,6 +19,8 @@
 #include "pdk/global/Global.h"
 #include "pdk/base/io/Debug.h"
 
+#include <atomic>
+
 namespace pdk {
 namespace io {
 
@@ -29,8 +31,20 @@ class PDK_CORE_EXPORT LoggingCategory
 {
    PDK_DISABLE_COPY(LoggingCategory);
 public:
+   // bits of the category bitmap, see PDK_STATIC_LOGGING_CATEGORY
+   enum EnabledBit : uchar
+   {
+      DebugBit = 0x01,
+      InfoBit = 0x02,
+      WarningBit = 0x04,
+      CriticalBit = 0x08
+   };
+   
    explicit LoggingCategory(const char *category);
    LoggingCategory(const char *category, pdk::MsgType severityLevel);
+   // keeps enabledBits in step with the enabled message types
+   LoggingCategory(std::atomic<uchar> &enabledBits, const char *category,
+                   pdk::MsgType severityLevel = pdk::MsgType::DebugMsg);
    ~LoggingCategory();
    bool isEnabled(pdk::MsgType type) const;
    void setEnabled(pdk::MsgType type, bool enable);
@@ -62,17 +76,17 @@ public:
    
    bool isInfoEnabled() const
    {
-      return enabled.load() >> InfoShift & 1;
+      return m_enabled.load() >> InfoShift & 1;
    }
    
    bool isWarningEnabled() const
    {
-      return enabled.load() >> WarningShift & 1;
+      return m_enabled.load() >> WarningShift & 1;
    }
    
    bool isCriticalEnabled() const
    {
-      return enabled.load() >> CriticalShift & 1;
+      return m_enabled.load() >> CriticalShift & 1;
    }
 #endif
    const char *getCategoryName() const
@@ -91,13 +105,33 @@ public:
       return *this;
    }
    
+   // what the default filter enables before any rule applies
+   static constexpr uchar getInitialBits(const char *category,
+                                         pdk::MsgType severityLevel = pdk::MsgType::DebugMsg)
+   {
+      const bool debug = severityLevel == pdk::MsgType::DebugMsg;
+      const bool info = debug || severityLevel == pdk::MsgType::InfoMsg;
+      const bool warning = info || severityLevel == pdk::MsgType::WarningMsg;
+      const bool critical = warning || severityLevel == pdk::MsgType::CriticalMsg;
+      return (debug && !isPdkCategory(category) ? DebugBit : 0) | (info ? InfoBit : 0) |
+            (warning ? WarningBit : 0) | (critical ? CriticalBit : 0);
+   }
+   
    static LoggingCategory *getDefaultCategory();
    using CategoryFilter = void (*)(LoggingCategory*);
    static CategoryFilter installFilter(CategoryFilter);
    static void setFilterRules(const String &rules);
 private:
    void init(const char *category, pdk::MsgType severityLevel);
-   PDK_DECL_UNUSED_MEMBER void *m_data; // reserved for future use
+   
+   // "pdk" or "pdk." followed by anything
+   static constexpr bool isPdkCategory(const char *category)
+   {
+      return category && category[0] == 'p' && category[1] == 'd' && category[2] == 'k' &&
+            (category[3] == '\0' || category[3] == '.');
+   }
+   
+   std::atomic<uchar> *m_enabledBits;
    const char *m_name;
 #ifdef PDK_BIG_ENDIAN
    enum {
@@ -139,6 +173,27 @@ private:
    return category; \
 }
 
+// a category with its enabled bits in the category bitmap, a contiguous
+// run of bytes shared by every category declared this way, checking one of
+// them takes a load and a branch instead of a call
+#if defined(PDK_OF_ELF) && (defined(PDK_CC_GNU) || defined(PDK_CC_CLANG))
+#  define PDK_LOGGING_CATEGORY_BITMAP __attribute__((section("pdk_logging_category_bitmap")))
+#else
+#  define PDK_LOGGING_CATEGORY_BITMAP
+#endif
+
+#define PDK_DECLARE_STATIC_LOGGING_CATEGORY(name) \
+   extern std::atomic<uchar> name##EnabledBits; \
+   extern const pdk::io::LoggingCategory name;
+
+#define PDK_STATIC_LOGGING_CATEGORY(name, ...) \
+   PDK_LOGGING_CATEGORY_BITMAP std::atomic<uchar> name##EnabledBits( \
+      pdk::io::LoggingCategory::getInitialBits(__VA_ARGS__)); \
+   const pdk::io::LoggingCategory name(name##EnabledBits, __VA_ARGS__);
+
+#define PDK_STATIC_LOGGING_CATEGORY_ENABLED(name, bit) \
+   PDK_UNLIKELY(name##EnabledBits.load(std::memory_order_relaxed) & pdk::io::LoggingCategory::bit)
+
 #define cdebug_stream(category, ...) \
    for (bool pdkCategoryEnabled = category().isDebugEnabled(); pdkCategoryEnabled; pdkCategoryEnabled = false) \
    pdk::MessageLogger(PDK_MESSAGELOG_FILE, PDK_MESSAGELOG_LINE, PDK_MESSAGELOG_FUNC, category().getCategoryName()).debug(__VA_ARGS__)
@@ -155,17 +210,39 @@ private:
    for (bool pdkCategoryEnabled = category().isCriticalEnabled(); pdkCategoryEnabled; pdkCategoryEnabled = false) \
    pdk::MessageLogger(PDK_MESSAGELOG_FILE, PDK_MESSAGELOG_LINE, PDK_MESSAGELOG_FUNC, category().getCategoryName()).critical(__VA_ARGS__)
 
+#define sdebug_stream(category, ...) \
+   for (bool pdkCategoryEnabled = PDK_STATIC_LOGGING_CATEGORY_ENABLED(category, DebugBit); pdkCategoryEnabled; pdkCategoryEnabled = false) \
+   pdk::MessageLogger(PDK_MESSAGELOG_FILE, PDK_MESSAGELOG_LINE, PDK_MESSAGELOG_FUNC, category.getCategoryName()).debug(__VA_ARGS__)
+
+#define sinfo_stream(category, ...) \
+   for (bool pdkCategoryEnabled = PDK_STATIC_LOGGING_CATEGORY_ENABLED(category, InfoBit); pdkCategoryEnabled; pdkCategoryEnabled = false) \
+   pdk::MessageLogger(PDK_MESSAGELOG_FILE, PDK_MESSAGELOG_LINE, PDK_MESSAGELOG_FUNC, category.getCategoryName()).info(__VA_ARGS__)
+
+#define swarning_stream(category, ...) \
+   for (bool pdkCategoryEnabled = PDK_STATIC_LOGGING_CATEGORY_ENABLED(category, WarningBit); pdkCategoryEnabled; pdkCategoryEnabled = false) \
+   pdk::MessageLogger(PDK_MESSAGELOG_FILE, PDK_MESSAGELOG_LINE, PDK_MESSAGELOG_FUNC, category.getCategoryName()).warning(__VA_ARGS__)
+
+#define scritical_stream(category, ...) \
+   for (bool pdkCategoryEnabled = PDK_STATIC_LOGGING_CATEGORY_ENABLED(category, CriticalBit); pdkCategoryEnabled; pdkCategoryEnabled = false) \
+   pdk::MessageLogger(PDK_MESSAGELOG_FILE, PDK_MESSAGELOG_LINE, PDK_MESSAGELOG_FUNC, category.getCategoryName()).critical(__VA_ARGS__)
+
 #if defined(PDK_NO_DEBUG_OUTPUT)
 #  undef cdebug_stream
 #  define cdebug_stream(category) PDK_NO_DEBUG_MACRO()
+#  undef sdebug_stream
+#  define sdebug_stream(category, ...) PDK_NO_DEBUG_MACRO(__VA_ARGS__)
 #endif
 #if defined(PDK_NO_INFO_OUTPUT)
 #  undef cinfo_stream
 #  define cinfo_stream(category) PDK_NO_DEBUG_MACRO()
+#  undef sinfo_stream
+#  define sinfo_stream(category, ...) PDK_NO_DEBUG_MACRO(__VA_ARGS__)
 #endif
 #if defined(PDK_NO_WARNING_OUTPUT)
 #  undef cwarning_stream
 #  define cwarning_stream(category) PDK_NO_DEBUG_MACRO()
+#  undef swarning_stream
+#  define swarning_stream(category, ...) PDK_NO_DEBUG_MACRO(__VA_ARGS__)
 #endif
 
 } // io
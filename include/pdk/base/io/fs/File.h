@@ -19,6 +19,7 @@
 #include "pdk/base/io/fs/FileDevice.h"
 #include "pdk/base/lang/String.h"
 #include <cstdio>
+#include <functional>
 
 #ifdef open
 #error pdk/base/io/fs/File.h must be included before any header file that defines open
@@ -43,6 +44,10 @@ class PDK_CORE_EXPORT File : public FileDevice
    PDK_DECLARE_PRIVATE(File);
    
 public:
+   // result is the number of bytes transferred, or -1 with errorCode
+   // holding the errno value
+   using AsyncIoCallback = std::function<void(pdk::pint64 result, int errorCode)>;
+   
    File();
    File(const String &name);
    explicit File(Object *parent);
@@ -110,6 +115,16 @@ public:
    bool open(int fd, OpenModes ioFlags, FileHandleFlags handleFlags = FileHandleFlag::DontCloseHandle);
    
    pdk::pint64 getSize() const override;
+   void close() override;
+   
+   // positional reads and writes that bypass the IoDevice buffers and do
+   // not move the file position, the buffer has to stay valid until the
+   // callback has run on this thread's event loop or in waitForAsyncIo(),
+   // called from any other thread waitForAsyncIo() blocks until the
+   // issuing thread has run the callbacks
+   int readAsync(pdk::pint64 offset, char *data, pdk::pint64 maxSize, const AsyncIoCallback &callback);
+   int writeAsync(pdk::pint64 offset, const char *data, pdk::pint64 size, const AsyncIoCallback &callback);
+   bool waitForAsyncIo(int msecs = -1);
    
    bool resize(pdk::pint64 sz) override;
    static bool resize(const String &filename, pdk::pint64 sz);
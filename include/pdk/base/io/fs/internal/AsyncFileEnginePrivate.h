@@ -0,0 +1,153 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_IO_FS_INTERNAL_ASYNC_FILE_ENGINE_PRIVATE_H
+#define PDK_M_BASE_IO_FS_INTERNAL_ASYNC_FILE_ENGINE_PRIVATE_H
+
+#include "pdk/kernel/Object.h"
+#include "pdk/kernel/CoreEvent.h"
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <sys/uio.h>
+
+namespace pdk {
+namespace io {
+namespace fs {
+namespace internal {
+
+using pdk::kernel::Object;
+using pdk::kernel::Event;
+
+class AsyncFileNotifier;
+
+class AsyncFileRequest
+{
+public:
+   enum class Operation
+   {
+      Read,
+      Write
+   };
+
+   using Callback = std::function<void(pdk::pint64 result, int errorCode)>;
+
+   int m_id;
+   Operation m_operation;
+   int m_fd;
+   pdk::pint64 m_offset;
+   iovec m_iov;
+   Callback m_callback;
+   // bytes transferred, or -1 with the errno value in m_errorCode
+   pdk::pint64 m_result;
+   int m_errorCode;
+};
+
+// where the requests are actually carried out, every backend signals
+// finished requests by making getNotifyHandle() readable
+class AsyncFileBackend
+{
+public:
+   virtual ~AsyncFileBackend();
+   virtual const char *getName() const = 0;
+   virtual void submit(std::vector<AsyncFileRequest *> &batch) = 0;
+   virtual void takeCompleted(std::vector<AsyncFileRequest *> &completed) = 0;
+   virtual int getNotifyHandle() const = 0;
+};
+
+// counts the outstanding requests of one File, the count drops when the
+// engine lets go of a request, after its callback ran or when the engine
+// of an exiting thread throws it away, so any thread can wait for it
+class AsyncIoTracker
+{
+public:
+   class Ticket
+   {
+   public:
+      explicit Ticket(const std::shared_ptr<AsyncIoTracker> &tracker);
+      ~Ticket();
+
+   private:
+      std::shared_ptr<AsyncIoTracker> m_tracker;
+   };
+
+   AsyncIoTracker();
+   int getPendingCount() const;
+   bool waitForDone(int msecs = -1);
+
+private:
+   mutable std::mutex m_mutex;
+   std::condition_variable m_done;
+   int m_pendingCount;
+};
+
+// carries out a request synchronously with pread()/pwrite()
+void perform_async_file_request(AsyncFileRequest *request);
+
+#if PDK_CONFIG(io_uring)
+// returns nullptr when the kernel does not provide io_uring
+AsyncFileBackend *create_io_uring_backend();
+#endif
+AsyncFileBackend *create_thread_pool_backend();
+
+// per thread engine for non blocking file reads and writes, requests
+// queued during one event loop iteration go to the backend in one batch
+// and the callbacks run on the thread that issued them
+class AsyncFileEngine : public Object
+{
+public:
+   using Callback = AsyncFileRequest::Callback;
+   using Operation = AsyncFileRequest::Operation;
+
+   ~AsyncFileEngine();
+   static AsyncFileEngine *getInstance();
+
+   int submit(Operation operation, int fd, pdk::pint64 offset, char *data,
+              pdk::pint64 size, const Callback &callback);
+   // runs callbacks until no request for fd (all when fd is -1) is pending
+   bool waitForRequests(int fd, int msecs = -1);
+   int getPendingCount(int fd = -1) const;
+   const char *getBackendName() const;
+   void processCompletions();
+
+protected:
+   bool event(Event *event) override;
+
+private:
+   AsyncFileEngine();
+   void ensureNotifier();
+   void flushSubmissions();
+   bool waitForNotification(int msecs);
+
+   AsyncFileBackend *m_backend;
+   AsyncFileNotifier *m_notifier;
+   std::vector<AsyncFileRequest *> m_queued;
+   std::vector<AsyncFileRequest *> m_completed;
+   std::unordered_map<int, int> m_pendingPerHandle;
+   int m_pendingCount;
+   int m_nextRequestId;
+   bool m_submitPosted;
+   static int sm_submitEventType;
+};
+
+} // internal
+} // fs
+} // io
+} // pdk
+
+#endif // PDK_M_BASE_IO_FS_INTERNAL_ASYNC_FILE_ENGINE_PRIVATE_H
@@ -19,6 +19,8 @@
 #include "pdk/base/io/fs/File.h"
 #include "pdk/base/io/fs/internal/FileDevicePrivate.h"
 
+#include <memory>
+
 namespace pdk {
 namespace io {
 namespace fs {
@@ -28,6 +30,8 @@ class TemporaryFile;
 
 namespace internal {
 
+class AsyncFileEngine;
+class AsyncIoTracker;
 using pdk::io::fs::File;
 using pdk::io::fs::TemporaryFile;
 
@@ -42,8 +46,13 @@ protected:
    bool openExternalFile(int flags, FILE *fh, File::FileHandleFlags handleFlags);
    
    AbstractFileEngine *getEngine() const override;
+   int submitAsyncIo(bool write, pdk::pint64 offset, char *data, pdk::pint64 size,
+                     const File::AsyncIoCallback &callback);
    
    String m_fileName;
+   // engine of the thread that issued the outstanding async requests
+   AsyncFileEngine *m_asyncEngine;
+   std::shared_ptr<AsyncIoTracker> m_asyncIo;
    friend class TemporaryFile;
 };
 
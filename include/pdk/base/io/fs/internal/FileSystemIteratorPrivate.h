@@ -30,6 +30,11 @@
 #include "pdk/utils/ScopedPointer.h"
 #endif
 
+// linux hands out directory entries in batches through getdents64
+#if defined(PDK_OS_LINUX)
+#  define PDK_FILESYSTEMITERATOR_USE_GETDENTS
+#endif
+
 namespace pdk {
 namespace io {
 namespace fs {
@@ -58,8 +63,18 @@ private:
    int m_uncShareIndex;
    bool m_onlyDirs;
 #else
+#  if defined(PDK_FILESYSTEMITERATOR_USE_GETDENTS)
+   int m_fd;
+   pdk::utils::ScopedArrayPointer<char> m_buffer;
+   int m_bufferPos;
+   int m_bufferEnd;
+#  else
    PDK_DIR *m_dir;
    PDK_DIRENT *m_dirEntry;
+#  endif
+   String m_filePath; // m_nativePath decoded once for all entries
+   Dir::Filters m_filters;
+   DirIterator::IteratorFlags m_iteratorFlags;
    int m_lastError;
 #endif
    
@@ -242,6 +242,7 @@ public:
    void fillFromStatxBuf(const struct statx &statBuffer);
    void fillFromStatBuf(const PDK_STATBUF &statBuffer);
    void fillFromDirEnt(const PDK_DIRENT &statBuffer);
+   void fillFromDirEntType(unsigned char type);
 #endif
    
 #if defined(PDK_OS_WIN)
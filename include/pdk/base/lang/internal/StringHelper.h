@@ -29,6 +29,33 @@ char32_t fold_case(char32_t ch, char32_t &last) noexcept;
 char16_t fold_case(char16_t ch) noexcept;
 Character fold_case(Character ch) noexcept;
 
+// every latin-1 unit but U+00B5 folds to a latin-1 unit, the tables are
+// only needed for the others
+inline bool folds_in_latin1(char16_t ch) noexcept
+{
+   return ch < 0x100 && ch != 0xb5;
+}
+
+inline char16_t fold_latin1(char16_t ch) noexcept
+{
+   return ((ch >= 'A' && ch <= 'Z') || (ch >= 0xc0 && ch <= 0xde && ch != 0xd7)) ? ch + 0x20 : ch;
+}
+
+// fold_case() without the table lookup for latin-1
+inline char32_t fold_case_fast(const char16_t *ch, const char16_t *start) noexcept
+{
+   return folds_in_latin1(*ch) ? fold_latin1(*ch) : fold_case(ch, start);
+}
+
+// the length of the leading run of lhs and rhs that is equal as it is or
+// after folding inside latin-1, the rest needs fold_case()
+int fold_equal_prefix(const char16_t *lhs, const char16_t *rhs, int length) noexcept;
+int fold_equal_prefix(const char16_t *lhs, const char *rhs, int length) noexcept;
+
+// the first unit of [begin, end) whose fold_case() is folded, a latin-1
+// character, nullptr when there is none
+const char16_t *find_folded_char(const char16_t *begin, const char16_t *end, char16_t folded) noexcept;
+
 } // internal
 } // lang
 } // pdk
@@ -0,0 +1,95 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_NET_HOST_ADDRESS_H
+#define PDK_M_BASE_NET_HOST_ADDRESS_H
+
+#include "pdk/global/Global.h"
+#include "pdk/base/lang/String.h"
+
+struct sockaddr;
+
+namespace pdk {
+namespace net {
+
+using pdk::lang::String;
+
+// an IPv4 or IPv6 address, host names are not resolved here
+class PDK_CORE_EXPORT HostAddress
+{
+public:
+   enum class SpecialAddress
+   {
+      Null,
+      Broadcast,
+      LocalHost,
+      LocalHostIPv6,
+      Any,
+      AnyIPv6,
+      AnyIPv4
+   };
+
+   enum class NetworkLayerProtocol
+   {
+      IPv4Protocol,
+      IPv6Protocol,
+      AnyIPProtocol,
+      UnknownNetworkLayerProtocol
+   };
+
+   HostAddress();
+   HostAddress(SpecialAddress address);
+   explicit HostAddress(pdk::puint32 ip4Address);
+   explicit HostAddress(const pdk::puint8 *ip6Address);
+   explicit HostAddress(const String &address);
+   explicit HostAddress(const sockaddr *address);
+
+   bool setAddress(const String &address);
+   void setAddress(pdk::puint32 ip4Address);
+   void setAddress(const pdk::puint8 *ip6Address);
+   bool setAddress(const sockaddr *address);
+   void clear();
+
+   NetworkLayerProtocol getProtocol() const
+   {
+      return m_protocol;
+   }
+
+   pdk::puint32 toIPv4Address(bool *ok = nullptr) const;
+   // 16 bytes in network order
+   const pdk::puint8 *toIPv6Address() const
+   {
+      return m_ip6;
+   }
+
+   String toString() const;
+   bool isNull() const;
+   bool isLoopback() const;
+   bool operator ==(const HostAddress &other) const;
+   bool operator !=(const HostAddress &other) const
+   {
+      return !(*this == other);
+   }
+
+private:
+   NetworkLayerProtocol m_protocol;
+   pdk::puint32 m_ip4;
+   pdk::puint8 m_ip6[16];
+};
+
+} // net
+} // pdk
+
+#endif // PDK_M_BASE_NET_HOST_ADDRESS_H
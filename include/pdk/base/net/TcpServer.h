@@ -0,0 +1,84 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_NET_TCP_SERVER_H
+#define PDK_M_BASE_NET_TCP_SERVER_H
+
+#include "pdk/kernel/Object.h"
+#include "pdk/base/net/TcpSocket.h"
+#include <functional>
+
+namespace pdk {
+namespace net {
+
+// forward declare class with namespace
+namespace internal {
+class TcpServerPrivate;
+} // internal
+
+using internal::TcpServerPrivate;
+
+class PDK_CORE_EXPORT TcpServer : public Object
+{
+public:
+   using NewConnectionHandler = std::function<void()>;
+
+   explicit TcpServer(Object *parent = nullptr);
+   virtual ~TcpServer();
+
+   // the any address listens on IPv6 and IPv4 at the same time when the
+   // system allows it
+   bool listen(const HostAddress &address = HostAddress::SpecialAddress::Any, pdk::puint16 port = 0);
+   void close();
+   bool isListening() const;
+
+   void setMaxPendingConnections(int count);
+   int getMaxPendingConnections() const;
+
+   pdk::puint16 getServerPort() const;
+   HostAddress getServerAddress() const;
+   int getSocketDescriptor() const;
+
+   bool waitForNewConnection(int msecs = 0, bool *timedOut = nullptr);
+   virtual bool hasPendingConnections() const;
+   // the socket stays a child of the server until it is reparented
+   virtual TcpSocket *nextPendingConnection();
+
+   TcpSocket::SocketError getServerError() const;
+   String getErrorString() const;
+
+   void pauseAccepting();
+   void resumeAccepting();
+
+   // runs from the event loop once a batch of connections was accepted
+   void setNewConnectionHandler(const NewConnectionHandler &handler);
+
+   // SIGNALS:
+   // void newConnection();
+   // void acceptError(TcpSocket::SocketError socketError);
+
+protected:
+   virtual void incomingConnection(int socketDescriptor);
+   void addPendingConnection(TcpSocket *socket);
+
+private:
+   PDK_DECLARE_PRIVATE(TcpServer);
+   PDK_DISABLE_COPY(TcpServer);
+};
+
+} // net
+} // pdk
+
+#endif // PDK_M_BASE_NET_TCP_SERVER_H
@@ -0,0 +1,135 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_NET_TCP_SOCKET_H
+#define PDK_M_BASE_NET_TCP_SOCKET_H
+
+#include "pdk/base/io/IoDevice.h"
+#include "pdk/base/net/HostAddress.h"
+#include <functional>
+
+namespace pdk {
+namespace net {
+
+// forward declare class with namespace
+namespace internal {
+class TcpSocketPrivate;
+} // internal
+
+using internal::TcpSocketPrivate;
+using pdk::io::IoDevice;
+using pdk::kernel::Object;
+
+// a buffered, non blocking TCP connection. Incoming data is moved into the
+// read buffer from the event loop, queued writes are flushed with one
+// gather write per readiness event.
+class PDK_CORE_EXPORT TcpSocket : public IoDevice
+{
+public:
+   enum class SocketState
+   {
+      UnconnectedState,
+      ConnectingState,
+      ConnectedState,
+      ClosingState
+   };
+
+   enum class SocketError
+   {
+      ConnectionRefusedError,
+      RemoteHostClosedError,
+      NetworkError,
+      SocketAccessError,
+      SocketResourceError,
+      SocketTimeoutError,
+      AddressInUseError,
+      UnsupportedSocketOperationError,
+      UnknownSocketError
+   };
+
+   using ConnectedHandler = std::function<void()>;
+   using DisconnectedHandler = std::function<void()>;
+   using ReadyReadHandler = std::function<void()>;
+   using BytesWrittenHandler = std::function<void(pdk::pint64 bytes)>;
+   using ErrorHandler = std::function<void(SocketError error)>;
+
+   explicit TcpSocket(Object *parent = nullptr);
+   virtual ~TcpSocket();
+
+   void connectToHost(const HostAddress &address, pdk::puint16 port,
+                      OpenModes mode = OpenMode::ReadWrite);
+   void disconnectFromHost();
+   void abort();
+   // takes over an already connected descriptor, it is made non blocking
+   bool setSocketDescriptor(int socketDescriptor,
+                            SocketState state = SocketState::ConnectedState,
+                            OpenModes mode = OpenMode::ReadWrite);
+   int getSocketDescriptor() const;
+   bool isValid() const;
+
+   HostAddress getLocalAddress() const;
+   pdk::puint16 getLocalPort() const;
+   HostAddress getPeerAddress() const;
+   pdk::puint16 getPeerPort() const;
+
+   SocketState getState() const;
+   SocketError getError() const;
+
+   // disables Nagle's algorithm
+   void setNoDelay(bool enabled);
+   // 0 means unlimited, once the buffer is full the socket stops reading
+   // and lets the kernel apply back pressure to the peer
+   void setReadBufferSize(pdk::pint64 size);
+   pdk::pint64 getReadBufferSize() const;
+
+   // writes as much of the pending data as the socket takes without blocking
+   bool flush();
+
+   bool waitForConnected(int msecs = 30000);
+   bool waitForReadyRead(int msecs = 30000) override;
+   bool waitForBytesWritten(int msecs = 30000) override;
+   bool waitForDisconnected(int msecs = 30000);
+
+   bool isSequential() const override;
+   pdk::pint64 bytesToWrite() const override;
+   void close() override;
+
+   // handlers run from the event loop of the thread that owns the socket,
+   // or from inside the waitFor functions
+   void setConnectedHandler(const ConnectedHandler &handler);
+   void setDisconnectedHandler(const DisconnectedHandler &handler);
+   void setReadyReadHandler(const ReadyReadHandler &handler);
+   void setBytesWrittenHandler(const BytesWrittenHandler &handler);
+   void setErrorHandler(const ErrorHandler &handler);
+
+   // SIGNALS:
+   // void connected();
+   // void disconnected();
+   // void stateChanged(SocketState state);
+   // void errorOccurred(SocketError error);
+
+protected:
+   pdk::pint64 readData(char *data, pdk::pint64 maxLength) override;
+   pdk::pint64 writeData(const char *data, pdk::pint64 length) override;
+
+private:
+   PDK_DECLARE_PRIVATE(TcpSocket);
+   PDK_DISABLE_COPY(TcpSocket);
+};
+
+} // net
+} // pdk
+
+#endif // PDK_M_BASE_NET_TCP_SOCKET_H
@@ -0,0 +1,141 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_NET_UDP_SOCKET_H
+#define PDK_M_BASE_NET_UDP_SOCKET_H
+
+#include "pdk/kernel/Object.h"
+#include "pdk/base/ds/ByteArray.h"
+#include "pdk/base/net/TcpSocket.h"
+#include <functional>
+#include <vector>
+
+namespace pdk {
+namespace net {
+
+// forward declare class with namespace
+namespace internal {
+class UdpSocketPrivate;
+} // internal
+
+using internal::UdpSocketPrivate;
+using pdk::ds::ByteArray;
+
+// a datagram together with the peer it came from or goes to
+class PDK_CORE_EXPORT NetworkDatagram
+{
+public:
+   NetworkDatagram()
+      : m_port(0)
+   {}
+
+   NetworkDatagram(const ByteArray &data, const HostAddress &address, pdk::puint16 port)
+      : m_data(data),
+        m_address(address),
+        m_port(port)
+   {}
+
+   const ByteArray &getData() const
+   {
+      return m_data;
+   }
+
+   void setData(const ByteArray &data)
+   {
+      m_data = data;
+   }
+
+   const HostAddress &getAddress() const
+   {
+      return m_address;
+   }
+
+   pdk::puint16 getPort() const
+   {
+      return m_port;
+   }
+
+   void setPeer(const HostAddress &address, pdk::puint16 port)
+   {
+      m_address = address;
+      m_port = port;
+   }
+
+   bool isValid() const
+   {
+      return !m_address.isNull();
+   }
+
+private:
+   ByteArray m_data;
+   HostAddress m_address;
+   pdk::puint16 m_port;
+};
+
+class PDK_CORE_EXPORT UdpSocket : public Object
+{
+public:
+   using SocketError = TcpSocket::SocketError;
+   using ReadyReadHandler = std::function<void()>;
+
+   explicit UdpSocket(Object *parent = nullptr);
+   virtual ~UdpSocket();
+
+   bool bind(const HostAddress &address = HostAddress::SpecialAddress::Any, pdk::puint16 port = 0);
+   void close();
+   bool isValid() const;
+   int getSocketDescriptor() const;
+   HostAddress getLocalAddress() const;
+   pdk::puint16 getLocalPort() const;
+
+   bool hasPendingDatagrams() const;
+   // the size of the next datagram, -1 when none is pending
+   pdk::pint64 getPendingDatagramSize() const;
+   pdk::pint64 readDatagram(char *data, pdk::pint64 maxSize,
+                            HostAddress *address = nullptr, pdk::puint16 *port = nullptr);
+   // sending on an unbound socket binds it to an ephemeral port
+   pdk::pint64 writeDatagram(const char *data, pdk::pint64 size,
+                             const HostAddress &address, pdk::puint16 port);
+   pdk::pint64 writeDatagram(const ByteArray &datagram, const HostAddress &address, pdk::puint16 port);
+
+   // batched variants moving many datagrams per system call, datagrams
+   // longer than maxSize are truncated. Both return the number of
+   // datagrams transferred or -1 on error.
+   int readDatagrams(std::vector<NetworkDatagram> &datagrams, int maxCount,
+                     pdk::pint64 maxSize = 65536);
+   int writeDatagrams(const std::vector<NetworkDatagram> &datagrams);
+
+   bool waitForReadyRead(int msecs = 30000);
+
+   SocketError getError() const;
+   String getErrorString() const;
+
+   // runs from the event loop, further notifications are held back until
+   // the pending datagrams have been read
+   void setReadyReadHandler(const ReadyReadHandler &handler);
+
+   // SIGNALS:
+   // void readyRead();
+   // void errorOccurred(SocketError error);
+
+private:
+   PDK_DECLARE_PRIVATE(UdpSocket);
+   PDK_DISABLE_COPY(UdpSocket);
+};
+
+} // net
+} // pdk
+
+#endif // PDK_M_BASE_NET_UDP_SOCKET_H
@@ -0,0 +1,86 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_NET_INTERNAL_SOCKET_ENGINE_PRIVATE_H
+#define PDK_M_BASE_NET_INTERNAL_SOCKET_ENGINE_PRIVATE_H
+
+#include "pdk/base/net/HostAddress.h"
+#include "pdk/kernel/SocketNotifier.h"
+#include "pdk/kernel/CoreEvent.h"
+#include "pdk/pal/net/NativeSocket.h"
+
+namespace pdk {
+namespace net {
+namespace internal {
+
+using pdk::kernel::SocketNotifier;
+using pdk::kernel::Event;
+using pdk::kernel::Object;
+
+// fills storage from address and port, returns the length to hand to
+// bind() and friends or 0 for an address that cannot be used
+socklen_t to_sockaddr(const HostAddress &address, pdk::puint16 port, sockaddr_storage *storage);
+HostAddress from_sockaddr(const sockaddr_storage &storage, pdk::puint16 *port);
+// the address family a socket for address has to be created with
+int get_address_family(const HostAddress &address);
+bool get_local_address(int fd, HostAddress *address, pdk::puint16 *port);
+bool get_peer_address(int fd, HostAddress *address, pdk::puint16 *port);
+// waits until fd is readable or writable, 0 on timeout
+int wait_for_socket(int fd, bool forRead, bool forWrite, int msecs,
+                    bool *readable = nullptr, bool *writable = nullptr);
+
+// forwards readiness of a descriptor to a member function of the socket
+// class, the sockets do not rely on signals being connected
+template <typename T>
+class SocketEngineNotifier : public SocketNotifier
+{
+public:
+   using Handler = void (T::*)();
+   SocketEngineNotifier(int fd, Type type, T *receiver, Handler handler, Object *parent)
+      : SocketNotifier(fd, type, parent),
+        m_receiver(receiver),
+        m_handler(handler)
+   {}
+
+protected:
+   bool event(Event *event) override
+   {
+      if (event->getType() == Event::Type::SocketActive) {
+         (m_receiver->*m_handler)();
+         return true;
+      }
+      return SocketNotifier::event(event);
+   }
+
+private:
+   T *m_receiver;
+   Handler m_handler;
+};
+
+// the handler of a notifier may be the one tearing it down
+inline void destroy_socket_notifier(SocketNotifier *&notifier)
+{
+   if (notifier) {
+      notifier->setEnabled(false);
+      notifier->deleteLater();
+      notifier = nullptr;
+   }
+}
+
+} // internal
+} // net
+} // pdk
+
+#endif // PDK_M_BASE_NET_INTERNAL_SOCKET_ENGINE_PRIVATE_H
@@ -0,0 +1,85 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_NET_INTERNAL_TCP_SOCKET_PRIVATE_H
+#define PDK_M_BASE_NET_INTERNAL_TCP_SOCKET_PRIVATE_H
+
+#include "pdk/base/net/TcpSocket.h"
+#include "pdk/base/io/internal/IoDevicePrivate.h"
+
+namespace pdk {
+
+// forward declare class with namespace
+namespace kernel {
+class SocketNotifier;
+} // kernel
+
+namespace net {
+namespace internal {
+
+using pdk::io::internal::IoDevicePrivate;
+using pdk::kernel::SocketNotifier;
+
+class TcpSocketPrivate : public IoDevicePrivate
+{
+   PDK_DECLARE_PUBLIC(TcpSocket);
+public:
+   TcpSocketPrivate();
+   virtual ~TcpSocketPrivate();
+
+   bool initSocket(int fd, TcpSocket::SocketState state);
+   void resetSocketLayer();
+   void setupNotifiers();
+   void connectionLost(TcpSocket::SocketError error, int errorCode = 0);
+   bool isReadBufferFull() const;
+   void setError(TcpSocket::SocketError error, int errorCode = 0);
+   void setErrorFromErrno(int errorCode);
+   static TcpSocket::SocketError translateError(int errorCode);
+   void setState(TcpSocket::SocketState state);
+   void fetchConnectionParameters();
+   void disconnectFinished();
+   void updateReadNotifier();
+   void updateWriteNotifier();
+
+   // event handlers, also driven by the waitFor functions
+   void readNotification();
+   void writeNotification();
+   bool connectionNotification();
+   bool readFromSocket();
+   bool writeToSocket();
+
+   int m_socketDescriptor;
+   TcpSocket::SocketState m_state;
+   TcpSocket::SocketError m_socketError;
+   HostAddress m_localAddress;
+   HostAddress m_peerAddress;
+   pdk::puint16 m_localPort;
+   pdk::puint16 m_peerPort;
+   pdk::pint64 m_readBufferMaxSize;
+   SocketNotifier *m_readNotifier;
+   SocketNotifier *m_writeNotifier;
+   bool m_noDelay;
+   TcpSocket::ConnectedHandler m_connectedHandler;
+   TcpSocket::DisconnectedHandler m_disconnectedHandler;
+   TcpSocket::ReadyReadHandler m_readyReadHandler;
+   TcpSocket::BytesWrittenHandler m_bytesWrittenHandler;
+   TcpSocket::ErrorHandler m_errorHandler;
+};
+
+} // internal
+} // net
+} // pdk
+
+#endif // PDK_M_BASE_NET_INTERNAL_TCP_SOCKET_PRIVATE_H
@@ -0,0 +1,156 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_OS_PROCESS_PROCESS_H
+#define PDK_M_BASE_OS_PROCESS_PROCESS_H
+
+#include "pdk/base/io/IoDevice.h"
+#include "pdk/base/lang/String.h"
+#include "pdk/base/ds/StringList.h"
+#include <functional>
+
+namespace pdk {
+namespace os {
+namespace process {
+
+// forward declare class with namespace
+namespace internal {
+class ProcessPrivate;
+} // internal
+
+using internal::ProcessPrivate;
+using pdk::io::IoDevice;
+using pdk::kernel::Object;
+using pdk::lang::String;
+using pdk::ds::StringList;
+using pdk::ds::ByteArray;
+
+class PDK_CORE_EXPORT Process : public IoDevice
+{
+public:
+   enum class ProcessError
+   {
+      FailedToStart,
+      Crashed,
+      Timedout,
+      ReadError,
+      WriteError,
+      UnknownError
+   };
+
+   enum class ProcessState
+   {
+      NotRunning,
+      Starting,
+      Running
+   };
+
+   enum class ProcessChannel
+   {
+      StandardOutput,
+      StandardError
+   };
+
+   enum class ProcessChannelMode
+   {
+      SeparateChannels,
+      MergedChannels,
+      ForwardedChannels
+   };
+
+   enum class ExitStatus
+   {
+      NormalExit,
+      CrashExit
+   };
+
+   using FinishedHandler = std::function<void(int exitCode, ExitStatus exitStatus)>;
+   using ReadyReadHandler = std::function<void(ProcessChannel channel)>;
+
+   explicit Process(Object *parent = nullptr);
+   virtual ~Process();
+
+   void start(const String &program, const StringList &arguments, OpenModes mode = OpenMode::ReadWrite);
+   void start(OpenModes mode = OpenMode::ReadWrite);
+   bool open(OpenModes mode = OpenMode::ReadWrite) override;
+
+   String getProgram() const;
+   void setProgram(const String &program);
+   StringList getArguments() const;
+   void setArguments(const StringList &arguments);
+   String getWorkingDirectory() const;
+   void setWorkingDirectory(const String &dir);
+   // entries have the NAME=value form, an empty list inherits the
+   // environment of the calling process
+   StringList getEnvironment() const;
+   void setEnvironment(const StringList &environment);
+
+   ProcessChannelMode getProcessChannelMode() const;
+   void setProcessChannelMode(ProcessChannelMode mode);
+   ProcessChannel getReadChannel() const;
+   void setReadChannel(ProcessChannel channel);
+   void closeReadChannel(ProcessChannel channel);
+   void closeWriteChannel();
+
+   pdk::pint64 getProcessId() const;
+   ProcessError getError() const;
+   ProcessState getState() const;
+   int getExitCode() const;
+   ExitStatus getExitStatus() const;
+
+   bool waitForStarted(int msecs = 30000);
+   bool waitForReadyRead(int msecs = 30000) override;
+   bool waitForBytesWritten(int msecs = 30000) override;
+   bool waitForFinished(int msecs = 30000);
+
+   ByteArray readAllStandardOutput();
+   ByteArray readAllStandardError();
+
+   bool isSequential() const override;
+   pdk::pint64 bytesToWrite() const override;
+   void close() override;
+
+   // handlers run from the event loop of the thread that owns the process,
+   // or from inside the waitFor functions
+   void setFinishedHandler(const FinishedHandler &handler);
+   void setReadyReadHandler(const ReadyReadHandler &handler);
+
+   void terminate();
+   void kill();
+
+   static int execute(const String &program, const StringList &arguments);
+
+   // SIGNALS:
+   // void started();
+   // void finished(int exitCode, ExitStatus exitStatus);
+   // void errorOccurred(ProcessError error);
+   // void stateChanged(ProcessState state);
+   // void readyReadStandardOutput();
+   // void readyReadStandardError();
+
+protected:
+   pdk::pint64 readData(char *data, pdk::pint64 maxLength) override;
+   pdk::pint64 writeData(const char *data, pdk::pint64 length) override;
+
+private:
+   PDK_DECLARE_PRIVATE(Process);
+   PDK_DISABLE_COPY(Process);
+};
+
+} // process
+} // os
+} // pdk
+
+#endif // PDK_M_BASE_OS_PROCESS_PROCESS_H
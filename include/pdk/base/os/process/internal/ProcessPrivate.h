@@ -0,0 +1,119 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_OS_PROCESS_INTERNAL_PROCESS_PRIVATE_H
+#define PDK_M_BASE_OS_PROCESS_INTERNAL_PROCESS_PRIVATE_H
+
+#include "pdk/base/os/process/Process.h"
+#include "pdk/base/io/internal/IoDevicePrivate.h"
+
+namespace pdk {
+
+// forward declare class with namespace
+namespace kernel {
+class SocketNotifier;
+} // kernel
+
+namespace os {
+namespace process {
+namespace internal {
+
+using pdk::io::internal::IoDevicePrivate;
+using pdk::kernel::SocketNotifier;
+
+class ChildDeathSlot;
+
+class ProcessPrivate : public IoDevicePrivate
+{
+   PDK_DECLARE_PUBLIC(Process);
+public:
+   class Channel
+   {
+   public:
+      Channel()
+         : m_notifier(nullptr),
+           m_closed(false)
+      {
+         m_pipe[0] = -1;
+         m_pipe[1] = -1;
+      }
+
+      // the end of the pipe that stays in this process
+      int m_pipe[2];
+      SocketNotifier *m_notifier;
+      bool m_closed;
+   };
+
+   ProcessPrivate();
+   virtual ~ProcessPrivate();
+
+   bool startProcess();
+   void cleanup();
+   void setError(Process::ProcessError error, const String &description = String());
+   void setProcessState(Process::ProcessState state);
+
+   bool openChannel(Channel &channel, bool childReads);
+   void closeChannel(Channel &channel);
+   void closeWriteChannel();
+   bool startDeathWatch();
+   void stopDeathWatch();
+
+   // event handlers, also driven by the waitFor functions
+   bool readyReadStandardOutput();
+   bool readyReadStandardError();
+   bool tryReadFromChannel(Channel &channel);
+   bool canWrite();
+   bool processDied();
+   void processFinished(int status);
+
+   bool waitForStarted(int msecs);
+   bool waitForReadyRead(int msecs);
+   bool waitForBytesWritten(int msecs);
+   bool waitForFinished(int msecs);
+   bool waitForActivity(int msecs);
+
+   void terminateProcess();
+   void killProcess();
+
+   String m_program;
+   StringList m_arguments;
+   String m_workingDirectory;
+   StringList m_environment;
+   Process::ProcessChannelMode m_processChannelMode;
+   Process::ProcessChannel m_processChannel;
+   Process::ProcessState m_processState;
+   Process::ProcessError m_processError;
+   Process::ExitStatus m_exitStatus;
+   Process::FinishedHandler m_finishedHandler;
+   Process::ReadyReadHandler m_readyReadHandler;
+   Channel m_stdinChannel;
+   Channel m_stdoutChannel;
+   Channel m_stderrChannel;
+   pdk::pint64 m_pid;
+   int m_exitCode;
+   // becomes readable once the child may have changed state, either a
+   // pidfd or the pipe of a slot fed by the shared SIGCHLD handler
+   int m_deathFd;
+   ChildDeathSlot *m_deathSlot;
+   SocketNotifier *m_deathNotifier;
+   bool m_writeChannelClosing;
+};
+
+} // internal
+} // process
+} // os
+} // pdk
+
+#endif // PDK_M_BASE_OS_PROCESS_INTERNAL_PROCESS_PRIVATE_H
@@ -17,6 +17,7 @@
 #define PDK_M_BASE_OS_THREAD_RUNNABLE_H
 
 #include "pdk/global/Global.h"
+#include <atomic>
 
 namespace pdk {
 namespace os {
@@ -43,15 +44,16 @@ public:
    virtual ~Runnable();
    bool autoDelete() const
    {
-      return m_ref != -1;
+      return m_ref.load(std::memory_order_relaxed) != -1;
    }
    
    void setAutoDelete(bool autoDelete)
    {
-      m_ref = autoDelete ? 0 : -1;
+      m_ref.store(autoDelete ? 0 : -1, std::memory_order_relaxed);
    }
 private:
-   int m_ref;
+   // tasks on a worker's local queue are released without the pool lock
+   std::atomic<int> m_ref;
    friend class ThreadPool;
    friend class ThreadPoolPrivate;
    friend class ThreadPoolThread;
@@ -51,6 +51,8 @@ public:
    void releaseThread();
    bool waitForDone(int msecs = -1);
    void clear();
+   void setWorkStealingEnabled(bool enabled);
+   bool isWorkStealingEnabled() const;
    
    PDK_REQUIRED_RESULT bool tryTake(Runnable *runnable);
 private:
@@ -22,6 +22,9 @@
 #include <condition_variable>
 #include <set>
 #include <deque>
+#include <atomic>
+#include <list>
+#include <vector>
 
 namespace pdk {
 namespace os {
@@ -118,6 +121,91 @@ private:
    Runnable *m_entries[MaxPageSize];
 };
 
+// bounded Chase-Lev deque, the owning worker pushes and pops at the bottom
+// without locking, other workers steal from the top
+class WorkStealingDeque
+{
+public:
+   enum {
+      Capacity = 1024
+   };
+   
+   WorkStealingDeque()
+      : m_top(0),
+        m_bottom(0)
+   {
+      for (std::atomic<Runnable *> &entry : m_entries) {
+         entry.store(nullptr, std::memory_order_relaxed);
+      }
+   }
+   
+   // owner only, returns false when the deque is full
+   bool push(Runnable *runnable)
+   {
+      PDK_ASSERT(runnable != nullptr);
+      const pdk::pint64 bottom = m_bottom.load(std::memory_order_relaxed);
+      const pdk::pint64 top = m_top.load(std::memory_order_acquire);
+      if (bottom - top >= Capacity) {
+         return false;
+      }
+      m_entries[bottom & (Capacity - 1)].store(runnable, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+      m_bottom.store(bottom + 1, std::memory_order_relaxed);
+      return true;
+   }
+   
+   // owner only, takes the most recently pushed runnable
+   Runnable *pop()
+   {
+      const pdk::pint64 bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+      m_bottom.store(bottom, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      pdk::pint64 top = m_top.load(std::memory_order_relaxed);
+      if (top > bottom) {
+         m_bottom.store(bottom + 1, std::memory_order_relaxed);
+         return nullptr;
+      }
+      Runnable *runnable = m_entries[bottom & (Capacity - 1)].load(std::memory_order_relaxed);
+      if (top == bottom) {
+         // last entry, race the thieves for it
+         if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed)) {
+            runnable = nullptr;
+         }
+         m_bottom.store(bottom + 1, std::memory_order_relaxed);
+      }
+      return runnable;
+   }
+   
+   // any thread, takes the oldest runnable
+   Runnable *steal()
+   {
+      pdk::pint64 top = m_top.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const pdk::pint64 bottom = m_bottom.load(std::memory_order_acquire);
+      if (top >= bottom) {
+         return nullptr;
+      }
+      Runnable *runnable = m_entries[top & (Capacity - 1)].load(std::memory_order_relaxed);
+      if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+         return nullptr;
+      }
+      return runnable;
+   }
+   
+   bool isEmpty() const
+   {
+      return m_bottom.load(std::memory_order_relaxed) <= m_top.load(std::memory_order_relaxed);
+   }
+   
+private:
+   // keep the thieves' index off the owner's cache line
+   alignas(64) std::atomic<pdk::pint64> m_top;
+   alignas(64) std::atomic<pdk::pint64> m_bottom;
+   std::atomic<Runnable *> m_entries[Capacity];
+};
+
 class ThreadPoolThread;
 class PDK_CORE_EXPORT ThreadPoolPrivate : public ObjectPrivate
 {
@@ -125,10 +213,20 @@ class PDK_CORE_EXPORT ThreadPoolPrivate : public ObjectPrivate
    friend class ThreadPoolThread;
    
 public:
+   enum {
+      MaxLocalQueues = 256
+   };
+   
    ThreadPoolPrivate();
+   ~ThreadPoolPrivate();
    
    bool tryStart(Runnable *task);
    void enqueueTask(Runnable *task, int priority = 0);
+   bool tryEnqueueLocalTask(Runnable *task);
+   Runnable *stealTask(int thiefIndex);
+   void taskDequeued(const QueuePage *page);
+   void wakeWaitingThread();
+   void assignLocalQueue(ThreadPoolThread *thread);
    int getActiveThreadCount() const;
    
    void tryToStartMoreThreads();
@@ -154,6 +252,14 @@ public:
    int m_activeThreads = 0;
    uint m_stackSize = 0;
    bool m_isExiting = false;
+   
+   // work stealing state, read by workers without holding m_mutex
+   std::atomic<bool> m_workStealing;
+   std::atomic<int> m_waitingThreadCount;
+   std::atomic<int> m_queuedPriorityTasks;
+   std::atomic<int> m_localQueueCount;
+   std::atomic<WorkStealingDeque *> m_localQueues[MaxLocalQueues];
+   std::vector<int> m_freeLocalQueues;
 };
 
 } // internal
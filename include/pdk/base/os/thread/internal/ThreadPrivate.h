@@ -20,6 +20,7 @@
 #include "pdk/kernel/CoreApplication.h"
 #include "pdk/kernel/internal/ObjectPrivate.h"
 #include "pdk/base/os/thread/Atomic.h"
+#include <atomic>
 #include <map>
 #include <mutex>
 #include <vector>
@@ -71,6 +72,20 @@ inline bool operator<(const PostEvent &lhs, const PostEvent &rhs)
    return lhs.m_priority > rhs.m_priority;
 }
 
+// node of the lock-free inbox that other threads post into
+class PostEventNode
+{
+public:
+   inline PostEventNode(const PostEvent &event)
+      : m_postEvent(event),
+        m_next(nullptr)
+   {}
+   
+public:
+   PostEvent m_postEvent;
+   PostEventNode *m_next;
+};
+
 // This class holds the list of posted events.
 //  The list has to be kept sorted by priority
 class PostEventList : public std::vector<PostEvent>
@@ -80,9 +95,81 @@ public:
       : std::vector<PostEvent>(),
         m_recursion(0),
         m_startOffset(0),
-        m_insertionOffset(0)
+        m_insertionOffset(0),
+        m_incoming(nullptr),
+        m_freeNodes(nullptr),
+        m_freeNodeCount(0)
    {}
    
+   ~PostEventList()
+   {
+      PostEventNode *node = takeFreeNodes();
+      while (node) {
+         PostEventNode *next = node->m_next;
+         delete node;
+         node = next;
+      }
+   }
+   
+   // can be called from any thread without holding m_mutex, returns true
+   // when the inbox was empty, only that poster has to wake up the owner
+   bool pushIncoming(PostEventNode *node)
+   {
+      node->m_next = m_incoming.load(std::memory_order_relaxed);
+      while (!m_incoming.compare_exchange_weak(node->m_next, node, std::memory_order_release,
+                                               std::memory_order_relaxed)) {
+      }
+      return node->m_next == nullptr;
+   }
+   
+   bool hasIncoming() const
+   {
+      return m_incoming.load(std::memory_order_acquire) != nullptr;
+   }
+   
+   // detaches the whole inbox in posting order, m_mutex must be held
+   PostEventNode *takeIncoming()
+   {
+      PostEventNode *node = m_incoming.exchange(nullptr, std::memory_order_acquire);
+      PostEventNode *ordered = nullptr;
+      while (node) {
+         PostEventNode *next = node->m_next;
+         node->m_next = ordered;
+         ordered = node;
+         node = next;
+      }
+      return ordered;
+   }
+   
+   // called by the owner after merging a node, the nodes go back to the
+   // posting threads in batches so a steady stream of posts does not
+   // allocate, only the owner pushes here
+   void recycleNode(PostEventNode *node)
+   {
+      if (m_freeNodeCount.load(std::memory_order_relaxed) >= MAX_FREE_NODES) {
+         delete node;
+         return;
+      }
+      node->m_next = m_freeNodes.load(std::memory_order_relaxed);
+      while (!m_freeNodes.compare_exchange_weak(node->m_next, node, std::memory_order_release,
+                                                std::memory_order_relaxed)) {
+      }
+      m_freeNodeCount.fetch_add(1, std::memory_order_relaxed);
+   }
+   
+   // can be called from any thread, always takes every free node at once,
+   // popping a single one would be open to the ABA problem
+   PostEventNode *takeFreeNodes()
+   {
+      PostEventNode *nodes = m_freeNodes.exchange(nullptr, std::memory_order_acquire);
+      int count = 0;
+      for (PostEventNode *node = nodes; node; node = node->m_next) {
+         ++count;
+      }
+      m_freeNodeCount.fetch_sub(count, std::memory_order_relaxed);
+      return nodes;
+   }
+   
    void addEvent(const PostEvent &event) {
       int priority = event.m_priority;
       if (empty() ||
@@ -108,6 +195,12 @@ public:
    // insertionOffset == set by sendPostedEvents to tell postEvent() where to start insertions
    int m_insertionOffset;
    std::mutex m_mutex;
+   // events posted from other threads, not yet merged into the sorted list
+   std::atomic<PostEventNode *> m_incoming;
+   // merged nodes waiting to be reused by the posting threads
+   std::atomic<PostEventNode *> m_freeNodes;
+   std::atomic<int> m_freeNodeCount;
+   static constexpr int MAX_FREE_NODES = 256;
 private:
    //hides because they do not keep that list sorted. addEvent must be used
    using std::vector<PostEvent>::push_back;
@@ -191,6 +284,9 @@ public:
    }
    void ref();
    void deref();
+   void takeIncomingPostEvents();
+   // called by the posting thread on the receiver's ThreadData
+   PostEventNode *createPostEventNode(const PostEvent &event);
    inline bool hasEventDispatcher() const
    {
       return m_eventDispatcher.load() != 0;
@@ -199,7 +295,7 @@ public:
    bool canWaitLocked()
    {
       std::scoped_lock locker(m_postEventList.m_mutex);
-      return m_canWait;
+      return m_canWait && !m_postEventList.hasIncoming();
    }
    
    // This class provides per-thread (by way of being a QThreadData
@@ -275,6 +275,18 @@ enum DataEndianness
    LittleEndianness
 };
 
+struct Utf8Transcoder
+{
+   // both take whole blocks of one to three byte sequences and return where
+   // they stopped, at a four byte sequence, an error or the last few units,
+   // the scalar loops carry on from there
+   const uchar *(*decode)(char16_t *&dst, const uchar *src, const uchar *end);
+   const char16_t *(*encode)(uchar *&dst, const char16_t *src, const char16_t *end);
+   const char *name;
+};
+
+const Utf8Transcoder &utf8_transcoder();
+
 struct Utf8
 {
    static Character *convertToUnicode(Character *, const char *, int) noexcept;
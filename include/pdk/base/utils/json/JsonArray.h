@@ -500,6 +500,7 @@ private:
    friend class jsonprivate::Data;
    friend class JsonValue;
    friend class JsonDocument;
+   friend class JsonPath;
    friend PDK_CORE_EXPORT Debug operator<<(Debug, const JsonArray &);
    
    JsonArray(jsonprivate::Data *data, jsonprivate::LocalArray *array);
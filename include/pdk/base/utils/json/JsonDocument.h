@@ -116,6 +116,8 @@ public:
    
    static JsonDocument fromRawData(const char *data, int size, 
                                    DataValidation validation = DataValidation::Validate);
+   static JsonDocument fromMappedFile(const String &fileName,
+                                      DataValidation validation = DataValidation::Validate);
    const char *getRawData(int *size) const;
    
    static JsonDocument fromBinaryData(const ByteArray &data,
@@ -151,6 +153,11 @@ public:
    const JsonValue operator[](const String &key) const;
    const JsonValue operator[](Latin1String key) const;
    const JsonValue operator[](int i) const;
+   JsonValue getValue(const JsonPath &path) const;
+   
+   // builds hash tables for the objects with at least minObjectSize keys
+   // on first lookup, 0 turns them off. changing the document drops them.
+   void enableLookupIndex(int minObjectSize = 16);
    
    bool operator==(const JsonDocument &other) const;
    bool operator!=(const JsonDocument &other) const
@@ -161,6 +168,7 @@ public:
    bool isNull() const;
 private:
    friend class JsonValue;
+   friend class JsonPath;
    friend class jsonprivate::Data;
    friend class jsonprivate::Parser;
    friend PDK_CORE_EXPORT Debug operator<<(Debug, const JsonDocument &);
@@ -103,6 +103,7 @@ public:
    
    JsonValue getValue(const String &key) const;
    JsonValue getValue(Latin1String key) const;
+   JsonValue getValue(const JsonPath &path) const;
    JsonValue operator[] (const String &key) const;
    JsonValue operator[] (Latin1String key) const
    {
@@ -120,6 +121,10 @@ public:
    bool operator==(const JsonObject &other) const;
    bool operator!=(const JsonObject &other) const;
    
+   // see JsonDocument::enableLookupIndex(), the index is shared with
+   // every object and document using the same data
+   void enableLookupIndex(int minObjectSize = 16);
+   
    class const_iterator;
    
    class iterator
@@ -426,6 +431,7 @@ private:
    friend class JsonValue;
    friend class JsonDocument;
    friend class JsonValueRef;
+   friend class JsonPath;
    
    friend PDK_CORE_EXPORT Debug operator<<(Debug, const JsonObject &);
    
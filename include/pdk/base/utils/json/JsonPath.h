@@ -0,0 +1,69 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_JSON_JSON_PATH_H
+#define PDK_M_BASE_JSON_JSON_PATH_H
+
+#include "pdk/base/utils/json/JsonValue.h"
+#include "pdk/utils/SharedData.h"
+
+namespace pdk {
+namespace utils {
+namespace json {
+
+class JsonArray;
+class JsonDocument;
+class JsonObject;
+
+namespace jsonprivate {
+class JsonPathPrivate;
+} // jsonprivate
+
+using jsonprivate::JsonPathPrivate;
+
+// a json pointer (rfc 6901) such as /a/b/3/c, parsed once and evaluated
+// against any number of documents. every step remembers where its key
+// was found last time, documents of the same shape skip the key search.
+class PDK_CORE_EXPORT JsonPath
+{
+public:
+   JsonPath();
+   explicit JsonPath(const String &path);
+   explicit JsonPath(Latin1String path);
+   JsonPath(const JsonPath &other);
+   JsonPath &operator=(const JsonPath &other);
+   ~JsonPath();
+
+   // false if the path is not a valid json pointer
+   bool isValid() const;
+   // number of steps, 0 for the empty path that selects the whole value
+   int getSize() const;
+   String toString() const;
+
+   // Undefined when the path does not lead to a value
+   JsonValue evaluate(const JsonDocument &document) const;
+   JsonValue evaluate(const JsonObject &object) const;
+   JsonValue evaluate(const JsonArray &array) const;
+   JsonValue evaluate(const JsonValue &value) const;
+
+private:
+   pdk::utils::SharedDataPointer<JsonPathPrivate> m_implPtr;
+};
+
+} // json
+} // utils
+} // pdk
+
+#endif // PDK_M_BASE_JSON_JSON_PATH_H
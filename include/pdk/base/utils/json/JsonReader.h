@@ -0,0 +1,94 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_JSON_JSON_READER_H
+#define PDK_M_BASE_JSON_JSON_READER_H
+
+#include "pdk/base/utils/json/JsonDocument.h"
+#include "pdk/utils/ScopedPointer.h"
+
+namespace pdk {
+
+// forward declare class with namespace
+namespace io {
+class IoDevice;
+} // io
+
+namespace utils {
+namespace json {
+
+namespace jsonprivate {
+class JsonReaderPrivate;
+} // jsonprivate
+
+using pdk::io::IoDevice;
+using jsonprivate::JsonReaderPrivate;
+
+// pulls json tokens from a device chunk by chunk, memory use is bounded
+// by the chunk size and the longest single string or number. several top
+// level values may follow each other, which reads json lines as well.
+class PDK_CORE_EXPORT JsonReader
+{
+   PDK_DECLARE_PRIVATE(JsonReader);
+public:
+   enum class TokenType
+   {
+      NoToken,
+      Invalid,
+      BeginObject,
+      EndObject,
+      BeginArray,
+      EndArray,
+      Key,
+      Value,
+      EndOfInput
+   };
+
+   static constexpr int DefaultChunkSize = 64 * 1024;
+
+   explicit JsonReader(IoDevice *device, int chunkSize = DefaultChunkSize);
+   ~JsonReader();
+
+   TokenType readNext();
+   TokenType getTokenType() const;
+   // the key of the member whose value is read, valid after a Key token
+   // until the next one
+   String getKey() const;
+   // the string, number, bool or null of a Value token
+   JsonValue getValue() const;
+   // reads the whole value the current token starts, a BeginObject or
+   // BeginArray token is consumed up to its matching end
+   JsonValue readCurrentValue();
+   // skips the rest of the object or array the current token begins
+   bool skipCurrentContainer();
+   int getDepth() const;
+
+   bool atEnd() const;
+   bool hasError() const;
+   JsonParseError::ParseError getError() const;
+   String getErrorString() const;
+   // offset of the error in bytes from the start of the input
+   pdk::pint64 getErrorOffset() const;
+
+private:
+   PDK_DISABLE_COPY(JsonReader);
+   pdk::utils::ScopedPointer<JsonReaderPrivate> m_implPtr;
+};
+
+} // json
+} // utils
+} // pdk
+
+#endif // PDK_M_BASE_JSON_JSON_READER_H
@@ -0,0 +1,85 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_JSON_JSON_STREAM_WRITER_H
+#define PDK_M_BASE_JSON_JSON_STREAM_WRITER_H
+
+#include "pdk/base/utils/json/JsonDocument.h"
+#include "pdk/utils/ScopedPointer.h"
+
+namespace pdk {
+
+// forward declare class with namespace
+namespace io {
+class IoDevice;
+} // io
+
+namespace utils {
+namespace json {
+
+namespace jsonprivate {
+class JsonStreamWriterPrivate;
+} // jsonprivate
+
+using pdk::io::IoDevice;
+using jsonprivate::JsonStreamWriterPrivate;
+
+// writes json text to a device while it is produced, only a small buffer
+// is held in memory. the output is the same JsonDocument::toJson() gives
+// for the equivalent document, members keep the order they are written in.
+class PDK_CORE_EXPORT JsonStreamWriter
+{
+   PDK_DECLARE_PRIVATE(JsonStreamWriter);
+public:
+   static constexpr int DefaultBufferSize = 16 * 1024;
+
+   explicit JsonStreamWriter(IoDevice *device,
+                             JsonDocument::JsonFormat format = JsonDocument::JsonFormat::Compact,
+                             int bufferSize = DefaultBufferSize);
+   // flushes what is still buffered
+   ~JsonStreamWriter();
+
+   void beginObject();
+   void endObject();
+   void beginArray();
+   void endArray();
+   void writeKey(const String &key);
+   void writeKey(Latin1String key);
+
+   // arrays and objects are written with all their content
+   void writeValue(const JsonValue &value);
+   void writeString(const String &value);
+   void writeString(Latin1String value);
+   void writeNumber(double value);
+   void writeNumber(int value);
+   void writeNumber(pdk::pint64 value);
+   void writeBool(bool value);
+   void writeNull();
+
+   bool flush();
+   int getDepth() const;
+   // true once the device refused a write, later output is dropped
+   bool hasError() const;
+
+private:
+   PDK_DISABLE_COPY(JsonStreamWriter);
+   pdk::utils::ScopedPointer<JsonStreamWriterPrivate> m_implPtr;
+};
+
+} // json
+} // utils
+} // pdk
+
+#endif // PDK_M_BASE_JSON_JSON_STREAM_WRITER_H
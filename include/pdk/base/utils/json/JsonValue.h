@@ -32,6 +32,7 @@ namespace json {
 
 class JsonArray;
 class JsonObject;
+class JsonPath;
 
 using pdk::io::Debug;
 using pdk::lang::String;
@@ -48,6 +49,7 @@ class Header;
 class LocalArray;
 class LocalValue;
 class LocalEntry;
+class JsonPathPrivate;
 } // internal
 
 class PDK_CORE_EXPORT JsonValue
@@ -164,8 +166,10 @@ private:
    {}
    
    friend class jsonprivate::LocalValue;
+   friend class jsonprivate::JsonPathPrivate;
    friend class JsonArray;
    friend class JsonObject;
+   friend class JsonPath;
    friend PDK_CORE_EXPORT Debug operator<<(Debug, const JsonValue &);
    
    JsonValue(jsonprivate::Data *data, jsonprivate::Base *base, const jsonprivate::LocalValue& value);
@@ -0,0 +1,82 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_JSON_INTERNAL_JSON_INDEX_PRIVATE_H
+#define PDK_M_BASE_JSON_INTERNAL_JSON_INDEX_PRIVATE_H
+
+#include "pdk/base/utils/json/internal/JsonPrivate.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace pdk {
+namespace utils {
+namespace json {
+namespace jsonprivate {
+
+// hash tables over the keys of the large objects of one document, built
+// the first time an object is searched. the tables refer to positions in
+// the binary data, any change to the document clears them.
+class LookupIndex
+{
+public:
+   explicit LookupIndex(int minObjectSize)
+      : m_minObjectSize(minObjectSize)
+   {}
+
+   inline int getMinObjectSize() const
+   {
+      return m_minObjectSize;
+   }
+
+   // position of key in the table of object, -1 if it has no such key
+   int indexOf(const LocalObject *object, const String &key);
+   int indexOf(const LocalObject *object, Latin1String key);
+   void clear();
+
+private:
+   // the upper half of a slot is the key hash, the lower the entry
+   // position plus one, zero marks an empty slot
+   using Slots = std::vector<pdk::puint64>;
+
+   const Slots &getSlots(const LocalObject *object);
+   template <typename Key>
+   int find(const LocalObject *object, const Key &key);
+
+   int m_minObjectSize;
+   std::mutex m_mutex;
+   std::unordered_map<const LocalObject *, std::unique_ptr<Slots>> m_tables;
+};
+
+// key lookup in an object of data, through the index when there is one
+template <typename Key>
+inline int index_of_key(Data *data, const LocalObject *object, const Key &key)
+{
+   if (data->m_lookupIndex && (int)object->m_length >= data->m_lookupIndex->getMinObjectSize()) {
+      return data->m_lookupIndex->indexOf(object, key);
+   }
+   bool exists = false;
+   const int index = object->indexOf(key, &exists);
+   return exists ? index : -1;
+}
+
+} // jsonprivate
+} // json
+} // utils
+} // pdk
+
+#endif // PDK_M_BASE_JSON_INTERNAL_JSON_INDEX_PRIVATE_H
@@ -19,6 +19,8 @@
 #include "pdk/global/Global.h"
 #include "pdk/base/utils/json/JsonDocument.h"
 #include "pdk/base/ds/VarLengthArray.h"
+#include "pdk/base/utils/json/internal/JsonScannerPrivate.h"
+#include "pdk/base/text/codecs/internal/UtfCodecPrivate.h"
 #include <vector>
 
 namespace pdk {
@@ -26,6 +28,145 @@ namespace utils {
 namespace json {
 namespace jsonprivate {
 
+// the string and number scanning below is shared by Parser, which builds
+// the binary document, and the streaming JsonReader
+
+inline bool add_hex_digit(char digit, uint *result)
+{
+   *result <<= 4;
+   if (digit >= '0' && digit <= '9') {
+      *result |= (digit - '0');
+   } else if (digit >= 'a' && digit <= 'f') {
+      *result |= (digit - 'a') + 10;
+   } else if (digit >= 'A' && digit <= 'F') {
+      *result |= (digit - 'A') + 10;
+   } else {
+      return false;
+   }
+   return true;
+}
+
+inline bool scan_escape_sequence(const char *&json, const char *end, uint *ch)
+{
+   ++json;
+   if (json >= end) {
+      return false;
+   }
+   uint escaped = *json++;
+   switch (escaped) {
+   case '"':
+      *ch = '"'; break;
+   case '\\':
+      *ch = '\\'; break;
+   case '/':
+      *ch = '/'; break;
+   case 'b':
+      *ch = 0x8; break;
+   case 'f':
+      *ch = 0xc; break;
+   case 'n':
+      *ch = 0xa; break;
+   case 'r':
+      *ch = 0xd; break;
+   case 't':
+      *ch = 0x9; break;
+   case 'u': {
+      *ch = 0;
+      if (json > end - 4)
+         return false;
+      for (int i = 0; i < 4; ++i) {
+         if (!add_hex_digit(*json, ch)) {
+            return false;
+         }
+         ++json;
+      }
+      return true;
+   }
+   default:
+      // this is not as strict as one could be, but allows for more Json files
+      // to be parsed correctly.
+      *ch = escaped;
+      return true;
+   }
+   return true;
+}
+
+inline bool scan_utf8_char(const char *&json, const char *end, uint *result)
+{
+   const uchar *&src = reinterpret_cast<const uchar *&>(json);
+   const uchar *uend = reinterpret_cast<const uchar *>(end);
+   uchar b = *src++;
+   namespace codecsinternal = pdk::text::codecs::internal;
+   int res = codecsinternal::Utf8Functions::fromUtf8<codecsinternal::Utf8BaseTraits>(b, result, src, uend);
+   if (res < 0) {
+      // decoding error, backtrack the character we read above
+      --json;
+      return false;
+   }   
+   return true;
+}
+
+// scans number = [ minus ] int [ frac ] [ exp ], returns the first byte
+// after it, isInt is cleared when a fraction or an exponent was seen
+inline const char *scan_number(const char *json, const char *end, bool *isInt)
+{
+   *isInt = true;
+   // minus
+   if (json < end && *json == '-') {
+      ++json;
+   }
+   // int = zero / ( digit1-9 *DIGIT )
+   if (json < end && *json == '0') {
+      ++json;
+   } else {
+      while (json < end && *json >= '0' && *json <= '9') {
+         ++json;
+      }
+   }
+   // frac = decimal-point 1*DIGIT
+   if (json < end && *json == '.') {
+      *isInt = false;
+      ++json;
+      while (json < end && *json >= '0' && *json <= '9') {
+         ++json;
+      }
+   }
+   // exp = e [ minus / plus ] 1*DIGIT
+   if (json < end && (*json == 'e' || *json == 'E')) {
+      *isInt = false;
+      ++json;
+      if (json < end && (*json == '-' || *json == '+')) {
+         ++json;
+      }
+      while (json < end && *json >= '0' && *json <= '9') {
+         ++json;
+      }
+   }
+   return json;
+}
+
+// converts the integers that fit the inline value of the binary format
+// without going through ByteArray::toInt
+inline bool parse_short_int(const char *begin, const char *end, int *result)
+{
+   const char *digits = (begin < end && *begin == '-') ? begin + 1 : begin;
+   if (end <= digits || end - digits > 9) {
+      return false;
+   }
+   int n = 0;
+   for (const char *digit = digits; digit < end; ++digit) {
+      n = n * 10 + (*digit - '0');
+   }
+   if (digits != begin) {
+      n = -n;
+   }
+   if (n >= (1<<25) || n <= -(1<<25)) {
+      return false;
+   }
+   *result = n;
+   return true;
+}
+
 class Parser
 {
 public:
@@ -67,6 +208,7 @@ private:
    const char *m_head;
    const char *m_json;
    const char *m_end;
+   const JsonScanner *m_scanner;
    
    char *m_data;
    int m_dataLength;
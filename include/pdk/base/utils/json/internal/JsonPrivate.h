@@ -31,6 +31,14 @@
 #include <limits>
 
 namespace pdk {
+
+// forward declare class with namespace
+namespace io {
+namespace fs {
+class File;
+} // fs
+} // io
+
 namespace utils {
 namespace json {
 namespace jsonprivate {
@@ -101,6 +109,7 @@ class LocalArray;
 class LocalObject;
 class LocalValue;
 class LocalEntry;
+class LookupIndex;
 
 template<typename T>
 using local_littleendian = LEInteger<T>;
@@ -771,18 +780,25 @@ public:
    };
    uint m_compactionCounter : 31;
    uint m_ownsData : 1;
+   // set when m_rawData is a mapping of this file, see JsonDocument::fromMappedFile()
+   pdk::io::fs::File *m_mappedFile;
+   LookupIndex *m_lookupIndex;
    
    inline Data(char *raw, int a)
       : m_alloc(a), 
         m_rawData(raw), 
         m_compactionCounter(0), 
-        m_ownsData(true)
+        m_ownsData(true),
+        m_mappedFile(nullptr),
+        m_lookupIndex(nullptr)
    {}
    
    inline Data(int reserved, JsonValue::Type valueType)
       : m_rawData(0),
         m_compactionCounter(0), 
-        m_ownsData(true)
+        m_ownsData(true),
+        m_mappedFile(nullptr),
+        m_lookupIndex(nullptr)
    {
       PDK_ASSERT(valueType == JsonValue::Type::Array || valueType == JsonValue::Type::Object);
       
@@ -800,10 +816,27 @@ public:
    
    inline ~Data()
    {
+      if (m_lookupIndex) {
+         enableLookupIndex(0);
+      }
       if (m_ownsData) {
          free(m_rawData);
+      } else if (m_mappedFile) {
+         releaseMappedFile();
+      }
+   }
+   
+   void releaseMappedFile();
+   // hash lookups for objects with at least minObjectSize keys, 0 drops the index
+   void enableLookupIndex(int minObjectSize);
+   // the index refers to positions in the data, it is cleared before they change
+   inline void clearLookupIndex()
+   {
+      if (m_lookupIndex) {
+         clearLookupTables();
       }
    }
+   void clearLookupTables();
    
    uint offsetOf(const void *ptr) const 
    {
@@ -0,0 +1,52 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_M_BASE_JSON_INTERNAL_JSON_SCANNER_PRIVATE_H
+#define PDK_M_BASE_JSON_INTERNAL_JSON_SCANNER_PRIVATE_H
+
+#include "pdk/global/Global.h"
+
+namespace pdk {
+namespace utils {
+namespace json {
+namespace jsonprivate {
+
+// block wise classification of json text, the parser hands the long runs
+// of whitespace and plain string content to these. the implementation
+// (avx2, sse2, neon or scalar) is picked once at runtime, setting
+// PDK_JSON_NO_SIMD=1 forces the scalar one.
+struct JsonScanner
+{
+   // first byte at or after pos that is not json whitespace, end if none
+   const char *(*skipWhitespace)(const char *pos, const char *end);
+   // first byte at or after pos that is a quote, a backslash or not ascii,
+   // everything before it is copied verbatim into latin1 strings
+   const char *(*scanStringRun)(const char *pos, const char *end);
+   const char *name;
+};
+
+const JsonScanner &json_scanner();
+
+inline bool is_json_whitespace(char c)
+{
+   return c == 0x20 || c == 0x09 || c == 0x0a || c == 0x0d;
+}
+
+} // jsonprivate
+} // json
+} // utils
+} // pdk
+
+#endif // PDK_M_BASE_JSON_INTERNAL_JSON_SCANNER_PRIVATE_H
@@ -31,6 +31,11 @@ namespace json {
 namespace jsonprivate {
 
 using pdk::ds::ByteArray;
+using pdk::lang::String;
+
+// append the json text of a string (without the quotes) or of a number
+void escape_string(const String &str, ByteArray &json);
+void double_to_json(double value, ByteArray &json);
 
 class Writer
 {
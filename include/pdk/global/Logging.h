@@ -18,6 +18,8 @@
 
 #include "pdk/global/Global.h"
 
+#include <cstdio>
+
 namespace pdk {
 
 // forward declare class with namespace
@@ -182,6 +184,37 @@ PDK_CORE_EXPORT void set_message_pattern(const String &messagePattern);
 PDK_CORE_EXPORT String format_log_message(pdk::MsgType type, const MessageLogContext &context,
                                           const String &buf);
 
+// what a thread does when its async log buffer is full
+enum class LogOverflowPolicy
+{
+   Drop,  // discard the message
+   Block, // wait until the writer thread made room
+   Count  // discard the message, the writer reports how many were lost
+};
+
+// the default message handler hands formatted messages to a background
+// writer through per-thread buffers of threadBufferSize bytes instead of
+// writing them itself, messages of different threads may interleave in
+// any order, returns false where it is not supported
+PDK_CORE_EXPORT bool enable_async_logging(LogOverflowPolicy policy = LogOverflowPolicy::Count,
+                                          int threadBufferSize = 64 * 1024);
+// writes what is queued and stops the writer thread
+PDK_CORE_EXPORT void disable_async_logging();
+PDK_CORE_EXPORT void flush_async_logging();
+PDK_CORE_EXPORT pdk::puint64 get_dropped_log_message_count();
+
+// printf style message logger calls queue the format and the raw arguments
+// instead of a formatted message, the writer thread formats them or, given
+// a file, appends them to it as binary records for decode_binary_log,
+// starts async logging when it is off, format strings, file, function and
+// category names have to live as long as the process does
+PDK_CORE_EXPORT bool enable_structured_logging(const char *binaryLogFile = nullptr);
+// closes the binary log file, async logging stays on
+PDK_CORE_EXPORT void disable_structured_logging();
+// writes one line per record of a binary log file, false when it is not
+// one or is cut short
+PDK_CORE_EXPORT bool decode_binary_log(const char *binaryLogFile, FILE *output);
+
 } // pdk
 
 #endif // PDK_GLOBAL_LOGGING_H
@@ -0,0 +1,137 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_GLOBAL_INTERNAL_LOGGING_PRIVATE_H
+#define PDK_GLOBAL_INTERNAL_LOGGING_PRIVATE_H
+
+#include "pdk/global/Logging.h"
+
+#include <cstdarg>
+
+namespace pdk {
+
+// forward declare class with namespace
+namespace ds {
+class ByteArray;
+} // ds
+
+namespace internal {
+
+// where the writer thread sends a record, stderr or the platform log
+enum class LogSink : uchar
+{
+   Console,
+   System
+};
+
+// queues a formatted message for the writer thread, false when async
+// logging is off or the message must be written by the caller
+bool post_async_log_record(pdk::MsgType type, LogSink sink, const MessageLogContext &context,
+                           const char *message, int length);
+// waits until the writer has written everything queued so far
+void flush_async_log_records();
+// writes a System record, message is nul terminated, Logging.cpp owns the
+// platform log handlers
+void write_system_log_record(pdk::MsgType type, const MessageLogContext &context,
+                             const char *message);
+
+// a message logger call keeps at most this many arguments, star width
+// and precision included
+constexpr int MAX_LOG_ARGUMENTS = 32;
+
+// what String::vasprintf reads for one argument
+enum class LogArgument : uchar
+{
+   Int,
+   Long,
+   LongLong,
+   SizeT,
+   Double,
+   LongDouble,
+   Pointer,
+   String
+};
+
+// the raw arguments of a log call, strings are still those of the caller
+struct CapturedLogArguments
+{
+   union Value
+   {
+      pdk::pint64 m_integer;
+      double m_double;
+      long double m_longDouble;
+      const void *m_pointer;
+      const char *m_string;
+   };
+   
+   int m_count;
+   LogArgument m_kinds[MAX_LOG_ARGUMENTS];
+   Value m_values[MAX_LOG_ARGUMENTS];
+   pdk::puint32 m_lengths[MAX_LOG_ARGUMENTS];
+   size_t m_encodedSize;
+   // the format is copied into the record, it may be gone by the time
+   // the writer thread gets to it
+   size_t m_formatLength;
+};
+
+// when and where a record the writer thread formats was logged
+struct LogRecordOrigin
+{
+   pdk::pint64 m_time; // ns since the epoch
+   pdk::puint64 m_thread;
+};
+
+// binary log files start with this, the records that follow use the byte
+// order of the process that wrote them
+constexpr char BINARY_LOG_MAGIC[] = "PDKLOG1\n";
+constexpr size_t BINARY_LOG_MAGIC_SIZE = sizeof(BINARY_LOG_MAGIC) - 1;
+// a string table entry, tag, id, length and the bytes
+constexpr char BINARY_LOG_STRING = 'S';
+// a record, tag, type, format, file, function and category ids, line,
+// time in ns since the epoch, thread id, argument size and the arguments
+constexpr char BINARY_LOG_RECORD = 'R';
+
+// reads the arguments the format asks for, false when String::vasprintf
+// has to format it in the calling thread, %n and %ls for instance
+bool capture_log_arguments(const char *format, va_list ap, CapturedLogArguments &arguments);
+// captures a formatted message as the only argument of the format it returns
+const char *capture_log_text(const char *text, int length, CapturedLogArguments &arguments);
+// writes m_encodedSize bytes, 8 byte slots with strings copied inline
+void encode_log_arguments(const CapturedLogArguments &arguments, char *out);
+// formats encoded arguments the way String::vasprintf formats the original
+// ones, false when they do not match the format
+bool format_log_arguments(const char *format, const char *encoded, size_t size, String &out);
+// FNV-1a of a format, the address alone does not identify one
+pdk::puint64 log_format_hash(const char *format, size_t length);
+// the thread id %{threadid} prints
+pdk::puint64 get_log_thread_id();
+
+bool is_structured_logging_enabled();
+// queues the format and the encoded arguments for the writer thread, false
+// when the caller has to format the message itself
+bool post_deferred_log_record(pdk::MsgType type, LogSink sink, const MessageLogContext &context,
+                              const char *format, const CapturedLogArguments &arguments);
+// applies the message pattern to a message the writer thread formatted,
+// %{time} and %{threadid} describe origin, out is what the default message
+// handler would write, false when the pattern leaves nothing
+bool format_deferred_log_message(pdk::MsgType type, const MessageLogContext &context, LogSink sink,
+                                 const LogRecordOrigin &origin, const String &message,
+                                 pdk::ds::ByteArray &out);
+
+} // internal
+} // pdk
+
+#endif // PDK_GLOBAL_INTERNAL_LOGGING_PRIVATE_H
@@ -0,0 +1,78 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_KERNEL_EVENT_DISPATCHER_EPOLL_H
+#define PDK_KERNEL_EVENT_DISPATCHER_EPOLL_H
+
+#include "pdk/kernel/EventDispatcherUnix.h"
+
+#include <sys/epoll.h>
+#include <vector>
+
+namespace pdk {
+namespace kernel {
+
+namespace internal {
+class EventDispatcherEpollPrivate;
+} // internal
+
+using internal::EventDispatcherEpollPrivate;
+
+// Linux only event dispatcher, the socket notifiers are kept in a
+// persistent epoll(7) interest set which is updated incrementally
+// when notifiers are registered or unregistered, so one wakeup costs
+// O(ready) instead of O(registered). Timers and the thread pipe are
+// shared with EventDispatcherUNIX.
+class PDK_CORE_EXPORT EventDispatcherEpoll : public EventDispatcherUNIX
+{
+   PDK_DECLARE_PRIVATE(EventDispatcherEpoll);
+
+public:
+   explicit EventDispatcherEpoll(Object *parent = nullptr);
+   ~EventDispatcherEpoll();
+
+   bool processEvents(EventLoop::ProcessEventsFlags flags) override;
+
+   void registerSocketNotifier(SocketNotifier *notifier) final;
+   void unregisterSocketNotifier(SocketNotifier *notifier) final;
+
+protected:
+   EventDispatcherEpoll(EventDispatcherEpollPrivate &dd, Object *parent = nullptr);
+};
+
+namespace internal {
+
+class PDK_CORE_EXPORT EventDispatcherEpollPrivate : public EventDispatcherUNIXPrivate
+{
+   PDK_DECLARE_PUBLIC(EventDispatcherEpoll);
+
+public:
+   EventDispatcherEpollPrivate();
+   ~EventDispatcherEpollPrivate();
+
+   bool updateInterestSet(int fd, short oldEvents, short newEvents);
+   int waitForEvents(const timespec *timeout);
+   int markPendingSocketNotifiers(int nready);
+
+   int m_epollFd;
+   std::vector<epoll_event> m_readyEvents;
+};
+
+} // internal
+
+} // kernel
+} // pdk
+
+#endif // PDK_KERNEL_EVENT_DISPATCHER_EPOLL_H
@@ -17,6 +17,7 @@
 #define PDK_KERNEL_EVENT_DISPATCHER_UNIX_H
 
 #include "pdk/kernel/AbstractEventDispatcher.h"
+#include "pdk/kernel/SocketNotifier.h"
 #include "pdk/kernel/internal/AbstractEventDispatcherPrivate.h"
 #include "pdk/kernel/internal/CoreUnixPrivate.h"
 #include "pdk/base/ds/VarLengthArray.h"
@@ -42,6 +43,9 @@ struct PDK_CORE_EXPORT SocketNotifierSetUNIX final
    inline bool isEmpty() const noexcept;
    inline short events() const noexcept;
    SocketNotifier *m_notifiers[3];
+   // set while the notifier of that type sits in the pending list,
+   // so marking it pending twice needs no search
+   bool m_pending[3];
 };
 
 struct ThreadPipe
@@ -79,8 +83,8 @@ public:
    bool processEvents(EventLoop::ProcessEventsFlags flags) override;
    bool hasPendingEvents() override;
    
-   void registerSocketNotifier(SocketNotifier *notifier) final;
-   void unregisterSocketNotifier(SocketNotifier *notifier) final;
+   void registerSocketNotifier(SocketNotifier *notifier) override;
+   void unregisterSocketNotifier(SocketNotifier *notifier) override;
    
    void registerTimer(int timerId, int interval, pdk::TimerType timerType, Object *object) final;
    bool unregisterTimer(int timerId) final;
@@ -111,7 +115,8 @@ public:
    
    void markPendingSocketNotifiers();
    int getActivateSocketNotifiers();
-   void setSocketNotifierPending(SocketNotifier *notifier);
+   void setSocketNotifierPending(SocketNotifierSetUNIX &snSet, SocketNotifier::Type type);
+   void clearSocketNotifierPending(SocketNotifierSetUNIX &snSet, SocketNotifier::Type type);
    
    ThreadPipe m_threadPipe;
    std::vector<pollfd> m_pollfds;
@@ -130,6 +135,9 @@ inline SocketNotifierSetUNIX::SocketNotifierSetUNIX() noexcept
    m_notifiers[0] = 0;
    m_notifiers[1] = 0;
    m_notifiers[2] = 0;
+   m_pending[0] = false;
+   m_pending[1] = false;
+   m_pending[2] = false;
 }
 
 inline bool SocketNotifierSetUNIX::isEmpty() const noexcept
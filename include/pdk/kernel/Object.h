@@ -19,6 +19,7 @@
 #include "pdk/global/Global.h"
 #include "pdk/utils/ScopedPointer.h"
 #include "pdk/base/lang/String.h"
+#include <atomic>
 #include <list>
 
 namespace pdk {
@@ -76,7 +77,8 @@ public:
    uint m_isWindow : 1; //for Window
    uint m_deleteLaterCalled : 1;
    uint m_unused : 24;
-   int m_postedEvents;
+   // updated by posting threads without the post event mutex
+   std::atomic<int> m_postedEvents;
 };
 
 class Object
@@ -67,6 +67,9 @@ public:
       event->m_spont = spontaneous;
    }
    static void removePostedEvent(Event *);
+   static bool needsLockedPost(Event *event);
+   // m_mutex of postedEvents must be held, deletes the event when it is folded
+   static bool compressIncomingEvent(Event *event, Object *receiver, PostEventList *postedEvents);
    static Thread *getMainThread();
    static bool threadRequiresCoreApplication();
    static void sendPostedEvents(Object *receiver, Event::Type eventType, ThreadData *data);
@@ -20,6 +20,8 @@
 #include "pdk/kernel/AbstractEventDispatcher.h"
 #include <sys/time.h>
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 namespace pdk {
 namespace kernel {
@@ -33,6 +35,8 @@ struct TimerInfo {
    timespec m_timeout;  // - when to actually fire
    Object *m_obj;     // - object to receive event
    TimerInfo **m_activateRef; // - ref from activateTimers
+   size_t m_heapIndex; // - slot in the TimerInfoList heap
+   pdk::puint64 m_sequence; // - orders timers with the same timeout
    
 #ifdef PDK_TIMERINFO_DEBUG
    timeval m_expected; // when timer is expected to fire
@@ -41,7 +45,12 @@ struct TimerInfo {
 #endif
 };
 
-class PDK_CORE_EXPORT TimerInfoList : public std::list<TimerInfo *>
+// The timers are kept in a binary min-heap ordered by timeout, timers with
+// the same timeout fire in the order they were (re)scheduled, the vector
+// itself is the heap storage. Every TimerInfo remembers its slot and the
+// timers are indexed by id, so registering, rescheduling and cancelling a
+// timer cost O(log n) and finding the next timeout is O(1).
+class PDK_CORE_EXPORT TimerInfoList : public std::vector<TimerInfo *>
 {
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(PDK_OS_MAC))
    timespec m_previousTime;
@@ -69,6 +78,14 @@ public:
 public:
     timespec m_currentTime;
 private:
+   void heapSiftUp(size_t index);
+   void heapSiftDown(size_t index);
+   void heapRemove(TimerInfo *timeInfo);
+   TimerInfo *firstWaitingTimer() const;
+   int countExpiredTimers(const timespec &currentTime) const;
+   
+   std::unordered_map<int, TimerInfo *> m_timerIds;
+   pdk::puint64 m_nextSequence;
    // state variables used by activateTimers()
    TimerInfo *m_firstTimerInfo;
 };
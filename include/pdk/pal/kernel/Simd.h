@@ -68,8 +68,9 @@
  *   guaranteed to work. This is useful with runtime detection (see below).
  *
  * Runtime detection of a CPU sub-architecture can be done with the
- * cpu_has_feature(XXX) function. There are two strategies for generating
- * optimized code like that:
+ * CPU_HAS_FEATURE(XXX) macro, it reads CPUID on x86 and the auxiliary vector
+ * on ARM Linux once and caches the result. There are two strategies for
+ * generating optimized code like that:
  *
  * 1) place the optimized code in a different translation unit (C or assembly
  * sources) and pass the correct flags to the compiler to enable support. Those
@@ -94,13 +95,31 @@
  *      void foo()
  *      {
  *      #if PDK_COMPILER_SUPPORTS_HERE(XXX)
- *          if (cpu_has_feature(XXX)) {
+ *          if (CPU_HAS_FEATURE(XXX)) {
  *              foo_optimized_xxx();
  *              return;
  *          }
  *      #endif
  *          foo_plain();
  *      }
+ *
+ * On x86 PDK_SIMD_DISPATCH_X86 says every sub-architecture can be used in
+ * PDK_FUNCTION_TARGET functions whatever the build flags are. Kernels with
+ * several implementations list them in a SimdKernel table and pick one at
+ * startup with select_simd_kernel():
+ *
+ *      using FooFunction = void (*)(const char *, int);
+ *      static const SimdKernel<FooFunction> kernels[] = {
+ *      #ifdef PDK_SIMD_DISPATCH_X86
+ *          {CPU_FEATURE_BIT(AVX2), foo_avx2, "avx2"},
+ *      #endif
+ *          {0, foo_plain, "scalar"}
+ *      };
+ *      static const SimdKernel<FooFunction> &foo = select_simd_kernel(kernels);
+ *
+ * PDK_NO_CPU_FEATURE="avx2 sse4.2" in the environment hides features from
+ * the detection, so the other implementations can be tested and measured
+ * on the same machine.
  */
 
 #if defined(__MINGW64_VERSION_MAJOR) || defined(PDK_CC_MSVC)
@@ -276,6 +295,14 @@
 #  include <arm_acle.h>
 #endif
 
+#if defined(PDK_PROCESSOR_X86) && defined(PDK_COMPILER_SUPPORTS_SIMD_ALWAYS) \
+   && (defined(PDK_CC_GNU) || defined(PDK_CC_CLANG)) && !defined(PDK_CC_INTEL)
+// functions tagged with PDK_FUNCTION_TARGET may use any x86 intrinsics,
+// whatever the -m flags of the build are
+#  include <immintrin.h>
+#  define PDK_SIMD_DISPATCH_X86
+#endif
+
 #undef PDK_COMPILER_SUPPORTS_SIMD_ALWAYS
 
 namespace pdk {
@@ -286,7 +313,7 @@ enum CPUFeatures : long
 {
 #if defined(PDK_PROCESSOR_ARM)
    CPUFeaturesNEON = 0,
-   CPUFeaturesARM_NEON = NEON,
+   CPUFeaturesARM_NEON = CPUFeaturesNEON,
    CPUFeaturesCRC32 = 1,
 #elif defined(PDK_PROCESSOR_MIPS)
    CPUFeaturesDSP = 0,
@@ -451,8 +478,43 @@ inline puint64 cpu_features()
 }
 }
 
-#define CPU_HAS_FEATURE(feature) ((COMPILER_CPU_FEATURE & (PDK_UINT64_C(1) << CPUFeatures##feature))\
-   || (cpu_features() & (PDK_UINT64_C(1) << CPUFeatures##feature)))
+#define CPU_HAS_FEATURE(feature) ((pdk::pal::kernel::COMPILER_CPU_FEATURE & CPU_FEATURE_BIT(feature))\
+   || (pdk::pal::kernel::cpu_features() & CPU_FEATURE_BIT(feature)))
+
+#define CPU_FEATURE_BIT(feature) (PDK_UINT64_C(1) << pdk::pal::kernel::CPUFeatures##feature)
+
+// one implementation of a kernel and the CPU_FEATURE_BIT()s it needs
+template <typename Function>
+struct SimdKernel
+{
+   puint64 features;
+   Function function;
+   const char *name;
+};
+
+namespace
+{
+inline bool cpu_has_features(puint64 required)
+{
+   return ((COMPILER_CPU_FEATURE | cpu_features()) & required) == required;
+}
+
+// the first kernel of the table the cpu can run, tables list the widest
+// unit first and end with the portable one, which is taken regardless
+template <typename Function, size_t N>
+inline const SimdKernel<Function> &select_simd_kernel(const SimdKernel<Function> (&kernels)[N])
+{
+   for (size_t i = 0; i + 1 < N; ++i) {
+      if (cpu_has_features(kernels[i].features)) {
+         return kernels[i];
+      }
+   }
+   return kernels[N - 1];
+}
+}
+
+// logs the names of the detected features with debug_stream()
+PDK_CORE_EXPORT void dump_cpu_features();
 
 #define ALIGNMENT_PROLOGUE_16BYTES(ptr, i, length) \
    for (; i < static_cast<int>(std::min(static_cast<pdk::uintptr>(length), ((4 - ((reinterpret_cast<pdk::uintptr>(ptr) >> 2) & 0x3)) & 0x3))); ++i)
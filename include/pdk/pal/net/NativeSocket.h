@@ -0,0 +1,87 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#ifndef PDK_PAL_NET_NATIVE_SOCKET_H
+#define PDK_PAL_NET_NATIVE_SOCKET_H
+
+#include "pdk/global/Global.h"
+
+#ifdef PDK_OS_UNIX
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+
+namespace pdk {
+namespace pal {
+namespace net {
+
+// thin wrappers over the socket system calls, every function returns -1
+// and leaves the reason in errno on failure. Descriptors handed out here
+// are non blocking and close-on-exec.
+
+enum
+{
+   // the most connections taken from the backlog per readiness event
+   MaxAcceptBatch = 64,
+   // the most buffers handed to one gather write
+   MaxGatherSegments = 64,
+   // the most datagrams moved by one batched system call
+   MaxDatagramBatch = 64
+};
+
+class NativeDatagram
+{
+public:
+   // the payload, m_size is the number of bytes actually transferred
+   iovec m_buffer;
+   pdk::pint64 m_size;
+   sockaddr_storage m_address;
+   socklen_t m_addressLength;
+   // set for datagrams that did not fit into m_buffer
+   bool m_truncated;
+};
+
+int create_socket(int family, int type);
+int close_socket(int fd);
+// for descriptors that did not come from this layer
+bool set_nonblocking(int fd);
+int bind_socket(int fd, const sockaddr *address, socklen_t length);
+int listen_socket(int fd, int backlog);
+// EINPROGRESS in errno means the connection completes asynchronously
+int connect_socket(int fd, const sockaddr *address, socklen_t length);
+// 0 at end of file
+pdk::pint64 read_socket(int fd, char *data, pdk::pint64 maxLength);
+// bytes the next read returns without blocking
+pdk::pint64 bytes_available(int fd);
+bool set_socket_option(int fd, int level, int option, int value);
+// the pending error of a socket, used to finish a non blocking connect
+int get_socket_error(int fd);
+// accepts up to maxCount connections in one go, 0 when none is pending
+int accept_connections(int listener, int *accepted, int maxCount);
+pdk::pint64 gather_write(int fd, const iovec *segments, int count);
+// the size of the next queued datagram without taking it, -1 when none is
+pdk::pint64 pending_datagram_size(int fd);
+// 0 when nothing is pending
+int receive_datagrams(int fd, NativeDatagram *datagrams, int count);
+int send_datagrams(int fd, NativeDatagram *datagrams, int count);
+
+} // net
+} // pal
+} // pdk
+
+#endif // PDK_PAL_NET_NATIVE_SOCKET_H
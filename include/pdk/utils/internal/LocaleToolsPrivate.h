@@ -88,6 +88,30 @@ PDK_CORE_EXPORT double pdk_strntod(const char *s00, int len, char const **se, bo
 pdk::plonglong pdk_strtoll(const char *nptr, const char **endptr, int base, bool *ok);
 pdk::pulonglong pdk_strtoull(const char *nptr, const char **endptr, int base, bool *ok);
 
+// allocation free decimal conversions for the hot paths of String, ByteArray,
+// TextStream and Locale. the parsers accept [+-]digits and nothing else,
+// false means the text is not such a number or out of range. the
+// formatters write without a terminating '\0' and return the length
+constexpr int LONGLONG_DECIMAL_BUFFER_SIZE = 20;
+PDK_CORE_EXPORT bool pdk_strntoll_decimal(const char *num, int len, pdk::plonglong &value);
+PDK_CORE_EXPORT bool pdk_strntoull_decimal(const char *num, int len, pdk::pulonglong &value);
+PDK_CORE_EXPORT int pdk_lltoa_decimal(pdk::plonglong l, char *buffer);
+PDK_CORE_EXPORT int pdk_ulltoa_decimal(pdk::pulonglong l, char *buffer);
+
+// whether strtoll would read num in base as a decimal, a leading zero is
+// octal when the base is left open
+inline bool is_decimal_base(const char *num, int len, int base)
+{
+   if (base == 10) {
+      return true;
+   }
+   if (base != 0) {
+      return false;
+   }
+   const int start = len > 0 && (num[0] == '-' || num[0] == '+') ? 1 : 0;
+   return len - start < 2 || num[start] != '0';
+}
+
 } // internal
 } // utils
 } // pdk
@@ -0,0 +1,798 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/global/Global.h"
+#include "pdk/global/Logging.h"
+#include "pdk/global/internal/LoggingPrivate.h"
+#include "pdk/base/lang/String.h"
+#include "pdk/base/ds/ByteArray.h"
+
+#ifdef PDK_OS_UNIX
+# include <atomic>
+# include <cerrno>
+# include <chrono>
+# include <climits>
+# include <condition_variable>
+# include <cstdio>
+# include <cstdlib>
+# include <cstring>
+# include <deque>
+# include <memory>
+# include <mutex>
+# include <string>
+# include <thread>
+# include <unordered_map>
+# include <vector>
+# include <fcntl.h>
+# include <sys/uio.h>
+# include <unistd.h>
+#endif
+
+namespace pdk {
+
+using internal::LogSink;
+using internal::CapturedLogArguments;
+
+#ifdef PDK_OS_UNIX
+
+using pdk::ds::ByteArray;
+
+namespace {
+
+enum class RecordKind : uchar
+{
+   Padding,
+   Text,
+   Binary
+};
+
+// size and kind lead, a padding record needs nothing else
+struct RecordHeader
+{
+   pdk::puint32 m_size; // header and payload, a multiple of 8
+   RecordKind m_kind;
+   LogSink m_sink;
+   uchar m_type;
+   pdk::puint32 m_length; // text without its terminator, size of the arguments
+   int m_line;
+   const char *m_file;
+   const char *m_function;
+   const char *m_category;
+};
+
+// a Binary record carries these, the encoded arguments and a copy of the
+// format with its terminator
+struct DeferredPayload
+{
+   pdk::puint32 m_formatLength;
+   pdk::pint64 m_time;
+   pdk::puint64 m_thread;
+};
+
+constexpr pdk::puint32 RECORD_ALIGNMENT = 8;
+constexpr pdk::puint32 MIN_BUFFER_SIZE = 4096;
+constexpr pdk::puint32 MAX_BUFFER_SIZE = 64 * 1024 * 1024;
+constexpr size_t WRITE_BATCH = 64;
+
+// single producer, single consumer byte ring of one thread, the positions
+// only grow and are taken modulo the capacity
+struct ThreadLogBuffer
+{
+   explicit ThreadLogBuffer(pdk::puint32 capacity)
+      : m_capacity(capacity),
+        m_data(new char[capacity])
+   {}
+   
+   alignas(64) std::atomic<pdk::puint64> m_head{0};
+   alignas(64) std::atomic<pdk::puint64> m_tail{0};
+   // set while the owner writes a record, disable waits for it
+   std::atomic<bool> m_busy{false};
+   std::atomic<bool> m_owned{true};
+   ThreadLogBuffer *m_next = nullptr;
+   const pdk::puint32 m_capacity;
+   std::unique_ptr<char[]> m_data;
+};
+
+struct AsyncLogState
+{
+   std::atomic<bool> m_enabled{false};
+   std::atomic<bool> m_running{false};
+   std::atomic<bool> m_sleeping{false};
+   std::atomic<bool> m_stop{false};
+   std::atomic<LogOverflowPolicy> m_policy{LogOverflowPolicy::Count};
+   std::atomic<pdk::puint64> m_dropped{0};
+   std::atomic<bool> m_structured{false};
+   // buffers are never freed, those of exited threads get new owners
+   std::atomic<ThreadLogBuffer *> m_buffers{nullptr};
+   pdk::puint32 m_bufferSize = MIN_BUFFER_SIZE;
+   std::mutex m_mutex;
+   std::condition_variable m_wakeUp;
+   std::condition_variable m_drained;
+   std::mutex m_controlMutex;
+   // held by the writer while it drains, the file changes between drains
+   std::mutex m_binaryMutex;
+   int m_binaryFd = -1;
+   pdk::puint32 m_binaryGeneration = 0;
+   std::thread m_writer;
+};
+
+AsyncLogState &async_state()
+{
+   // never destroyed, threads may log during static destruction
+   static AsyncLogState *state = new AsyncLogState;
+   return *state;
+}
+
+thread_local ThreadLogBuffer *t_buffer = nullptr;
+thread_local bool t_exiting = false;
+thread_local bool t_isWriter = false;
+
+pdk::puint64 current_thread_id()
+{
+   static thread_local pdk::puint64 id = internal::get_log_thread_id();
+   return id;
+}
+
+struct ThreadLogBufferOwner
+{
+   ~ThreadLogBufferOwner()
+   {
+      t_exiting = true;
+      if (t_buffer) {
+         t_buffer->m_owned.store(false, std::memory_order_release);
+         t_buffer = nullptr;
+      }
+   }
+};
+
+ThreadLogBuffer *thread_buffer(AsyncLogState &state)
+{
+   if (t_buffer || t_exiting) {
+      return t_buffer;
+   }
+   static thread_local ThreadLogBufferOwner owner;
+   PDK_UNUSED(owner);
+   for (ThreadLogBuffer *buffer = state.m_buffers.load(std::memory_order_acquire); buffer;
+        buffer = buffer->m_next) {
+      bool owned = false;
+      if (buffer->m_capacity == state.m_bufferSize && !buffer->m_owned.load(std::memory_order_relaxed) &&
+          buffer->m_owned.compare_exchange_strong(owned, true, std::memory_order_acquire)) {
+         t_buffer = buffer;
+         return buffer;
+      }
+   }
+   ThreadLogBuffer *buffer = new ThreadLogBuffer(state.m_bufferSize);
+   buffer->m_next = state.m_buffers.load(std::memory_order_relaxed);
+   while (!state.m_buffers.compare_exchange_weak(buffer->m_next, buffer, std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+   }
+   t_buffer = buffer;
+   return buffer;
+}
+
+void wake_writer(AsyncLogState &state)
+{
+   // pairs with the fence of the writer before it goes to sleep
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   if (state.m_sleeping.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(state.m_mutex);
+      state.m_sleeping.store(false, std::memory_order_relaxed);
+      state.m_wakeUp.notify_one();
+   }
+}
+
+bool has_pending_records(AsyncLogState &state)
+{
+   for (ThreadLogBuffer *buffer = state.m_buffers.load(std::memory_order_acquire); buffer;
+        buffer = buffer->m_next) {
+      if (buffer->m_head.load(std::memory_order_relaxed) != buffer->m_tail.load(std::memory_order_acquire)) {
+         return true;
+      }
+   }
+   return false;
+}
+
+void write_console(std::vector<iovec> &iov)
+{
+   size_t index = 0;
+   while (index < iov.size()) {
+      const int count = static_cast<int>(std::min<size_t>(iov.size() - index, IOV_MAX));
+      ssize_t written = ::writev(STDERR_FILENO, &iov[index], count);
+      if (written < 0) {
+         if (errno == EINTR) {
+            continue;
+         }
+         break;
+      }
+      while (written > 0) {
+         iovec &vec = iov[index];
+         if (static_cast<size_t>(written) >= vec.iov_len) {
+            written -= vec.iov_len;
+            ++index;
+         } else {
+            vec.iov_base = static_cast<char *>(vec.iov_base) + written;
+            vec.iov_len -= written;
+            written = 0;
+         }
+      }
+   }
+   iov.clear();
+}
+
+void write_all(int fd, const char *data, size_t size)
+{
+   while (size > 0) {
+      const ssize_t written = ::write(fd, data, size);
+      if (written < 0) {
+         if (errno == EINTR) {
+            continue;
+         }
+         return;
+      }
+      data += written;
+      size -= written;
+   }
+}
+
+struct ConsumedRange
+{
+   ThreadLogBuffer *m_buffer;
+   pdk::puint64 m_head;
+};
+
+class LogWriter
+{
+public:
+   explicit LogWriter(AsyncLogState &state)
+      : m_state(state),
+        m_reportedDrops(state.m_dropped.load(std::memory_order_relaxed))
+   {
+      m_iov.reserve(WRITE_BATCH + 1);
+   }
+   
+   void run();
+   
+private:
+   bool drain();
+   void writeBatch();
+   void formatRecord(const RecordHeader *header);
+   void appendBinaryRecord(const RecordHeader *header);
+   pdk::puint32 getStringId(const char *string);
+   pdk::puint32 getFormatId(const char *format, pdk::puint32 length);
+   pdk::puint32 appendString(const char *string, pdk::puint32 length);
+   
+   template <typename T>
+   void appendBinary(const T &value)
+   {
+      m_binary.append(reinterpret_cast<const char *>(&value), sizeof(T));
+   }
+   
+   AsyncLogState &m_state;
+   std::vector<iovec> m_iov;
+   std::vector<ConsumedRange> m_consumed;
+   // console text of Binary records, kept in place until it is written
+   std::deque<ByteArray> m_formatted;
+   pdk::puint64 m_reportedDrops;
+   char m_dropReport[64];
+   int m_binaryFd = -1;
+   pdk::puint32 m_binaryGeneration = 0;
+   std::string m_binary;
+   pdk::puint32 m_nextStringId = 1;
+   std::unordered_map<const char *, pdk::puint32> m_stringIds;
+   // formats are copies, they are interned by their text
+   std::unordered_map<pdk::puint64, std::pair<std::string, pdk::puint32>> m_formatIds;
+};
+
+inline const char *deferred_format(const RecordHeader *header)
+{
+   return reinterpret_cast<const char *>(header + 1) + sizeof(DeferredPayload) + header->m_length;
+}
+
+void LogWriter::writeBatch()
+{
+   // records go back to their producers only once they are written
+   write_console(m_iov);
+   m_formatted.clear();
+   if (!m_binary.empty()) {
+      write_all(m_binaryFd, m_binary.data(), m_binary.size());
+      m_binary.clear();
+   }
+   for (const ConsumedRange &range : m_consumed) {
+      range.m_buffer->m_head.store(range.m_head, std::memory_order_release);
+   }
+   m_consumed.clear();
+}
+
+void LogWriter::formatRecord(const RecordHeader *header)
+{
+   const DeferredPayload *payload = reinterpret_cast<const DeferredPayload *>(header + 1);
+   String message;
+   if (!internal::format_log_arguments(deferred_format(header), reinterpret_cast<const char *>(payload + 1),
+                                       header->m_length, message)) {
+      return;
+   }
+   const pdk::MsgType type = static_cast<pdk::MsgType>(header->m_type);
+   MessageLogContext context(header->m_file, header->m_line, header->m_function, header->m_category);
+   const internal::LogRecordOrigin origin = {payload->m_time, payload->m_thread};
+   ByteArray text;
+   if (!internal::format_deferred_log_message(type, context, header->m_sink, origin, message, text)) {
+      return;
+   }
+   if (header->m_sink == LogSink::Console) {
+      m_formatted.push_back(text);
+      const ByteArray &queued = m_formatted.back();
+      m_iov.push_back({const_cast<char *>(queued.getConstRawData()), static_cast<size_t>(queued.size())});
+   } else {
+      writeBatch();
+      internal::write_system_log_record(type, context, text.getConstRawData());
+   }
+}
+
+pdk::puint32 LogWriter::getStringId(const char *string)
+{
+   if (!string) {
+      return 0;
+   }
+   auto iter = m_stringIds.find(string);
+   if (iter != m_stringIds.end()) {
+      return iter->second;
+   }
+   // file, function and category are keyed by address, they are literals
+   // that live as long as the process does
+   const pdk::puint32 id = appendString(string, static_cast<pdk::puint32>(std::strlen(string)));
+   m_stringIds.emplace(string, id);
+   return id;
+}
+
+pdk::puint32 LogWriter::getFormatId(const char *format, pdk::puint32 length)
+{
+   const pdk::puint64 hash = internal::log_format_hash(format, length);
+   auto iter = m_formatIds.find(hash);
+   if (iter != m_formatIds.end() && iter->second.first.compare(0, std::string::npos, format, length) == 0) {
+      return iter->second.second;
+   }
+   // a colliding format replaces the entry, it only costs a second copy
+   const pdk::puint32 id = appendString(format, length);
+   m_formatIds[hash] = std::make_pair(std::string(format, length), id);
+   return id;
+}
+
+pdk::puint32 LogWriter::appendString(const char *string, pdk::puint32 length)
+{
+   const pdk::puint32 id = m_nextStringId++;
+   m_binary.push_back(internal::BINARY_LOG_STRING);
+   appendBinary(id);
+   appendBinary(length);
+   m_binary.append(string, length);
+   return id;
+}
+
+void LogWriter::appendBinaryRecord(const RecordHeader *header)
+{
+   const DeferredPayload *payload = reinterpret_cast<const DeferredPayload *>(header + 1);
+   const pdk::puint32 ids[] = {
+      getFormatId(deferred_format(header), payload->m_formatLength),
+      getStringId(header->m_file),
+      getStringId(header->m_function),
+      getStringId(header->m_category)
+   };
+   m_binary.push_back(internal::BINARY_LOG_RECORD);
+   appendBinary(header->m_type);
+   appendBinary(ids);
+   appendBinary(header->m_line);
+   appendBinary(payload->m_time);
+   appendBinary(payload->m_thread);
+   appendBinary(header->m_length);
+   m_binary.append(reinterpret_cast<const char *>(payload + 1), header->m_length);
+}
+
+bool LogWriter::drain()
+{
+   std::lock_guard<std::mutex> binaryLock(m_state.m_binaryMutex);
+   if (m_binaryGeneration != m_state.m_binaryGeneration) {
+      // a new file starts a new string table
+      m_binaryGeneration = m_state.m_binaryGeneration;
+      m_nextStringId = 1;
+      m_stringIds.clear();
+      m_formatIds.clear();
+   }
+   m_binaryFd = m_state.m_binaryFd;
+   bool found = false;
+   for (ThreadLogBuffer *buffer = m_state.m_buffers.load(std::memory_order_acquire); buffer;
+        buffer = buffer->m_next) {
+      pdk::puint64 head = buffer->m_head.load(std::memory_order_relaxed);
+      const pdk::puint64 tail = buffer->m_tail.load(std::memory_order_acquire);
+      const pdk::puint64 mask = buffer->m_capacity - 1;
+      while (head != tail) {
+         const RecordHeader *header = reinterpret_cast<const RecordHeader *>(buffer->m_data.get() + (head & mask));
+         head += header->m_size;
+         found = true;
+         if (header->m_kind == RecordKind::Binary) {
+            if (m_binaryFd != -1) {
+               appendBinaryRecord(header);
+            } else {
+               formatRecord(header);
+               if (m_iov.size() >= WRITE_BATCH) {
+                  m_consumed.push_back({buffer, head});
+                  writeBatch();
+               }
+            }
+            continue;
+         }
+         if (header->m_kind != RecordKind::Text) {
+            continue;
+         }
+         const char *payload = reinterpret_cast<const char *>(header + 1);
+         if (header->m_sink == LogSink::Console) {
+            m_iov.push_back({const_cast<char *>(payload), header->m_length + 1u});
+            if (m_iov.size() >= WRITE_BATCH) {
+               m_consumed.push_back({buffer, head});
+               writeBatch();
+            }
+         } else {
+            // console records queued before it go first
+            writeBatch();
+            MessageLogContext context(header->m_file, header->m_line, header->m_function,
+                                      header->m_category);
+            internal::write_system_log_record(static_cast<pdk::MsgType>(header->m_type), context, payload);
+         }
+      }
+      if (head != buffer->m_head.load(std::memory_order_relaxed)) {
+         m_consumed.push_back({buffer, head});
+      }
+   }
+   const pdk::puint64 dropped = m_state.m_dropped.load(std::memory_order_relaxed);
+   if (dropped != m_reportedDrops && m_state.m_policy.load(std::memory_order_relaxed) == LogOverflowPolicy::Count) {
+      const int length = std::snprintf(m_dropReport, sizeof(m_dropReport), "pdk: %llu log messages dropped\n",
+                                       static_cast<unsigned long long>(dropped - m_reportedDrops));
+      m_iov.push_back({m_dropReport, static_cast<size_t>(length)});
+   }
+   m_reportedDrops = dropped;
+   writeBatch();
+   return found;
+}
+
+void LogWriter::run()
+{
+   t_isWriter = true;
+   for (;;) {
+      const bool found = drain();
+      {
+         std::lock_guard<std::mutex> lock(m_state.m_mutex);
+         m_state.m_drained.notify_all();
+      }
+      if (found) {
+         continue;
+      }
+      if (m_state.m_stop.load(std::memory_order_acquire)) {
+         break;
+      }
+      m_state.m_sleeping.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (has_pending_records(m_state)) {
+         m_state.m_sleeping.store(false, std::memory_order_relaxed);
+         continue;
+      }
+      std::unique_lock<std::mutex> lock(m_state.m_mutex);
+      // the timeout only bounds a missed wake up
+      m_state.m_wakeUp.wait_for(lock, std::chrono::milliseconds(100), [this] {
+         return !m_state.m_sleeping.load(std::memory_order_relaxed) ||
+               m_state.m_stop.load(std::memory_order_relaxed);
+      });
+      m_state.m_sleeping.store(false, std::memory_order_relaxed);
+   }
+}
+
+void writer_main(AsyncLogState *state)
+{
+   LogWriter(*state).run();
+}
+
+// reserves a record in the ring of the calling thread and lets fill write
+// the payload, false when the caller has to write the message itself
+template <typename Fill>
+bool post_record(RecordKind kind, pdk::MsgType type, LogSink sink, const MessageLogContext &context,
+                 pdk::puint32 length, pdk::puint64 payloadSize, Fill fill)
+{
+   AsyncLogState &state = async_state();
+   if (t_isWriter || !state.m_enabled.load(std::memory_order_relaxed)) {
+      return false;
+   }
+   ThreadLogBuffer *buffer = thread_buffer(state);
+   if (!buffer) {
+      return false;
+   }
+   buffer->m_busy.store(true, std::memory_order_seq_cst);
+   if (!state.m_enabled.load(std::memory_order_seq_cst)) {
+      buffer->m_busy.store(false, std::memory_order_release);
+      return false;
+   }
+   const pdk::puint64 size = (sizeof(RecordHeader) + payloadSize + RECORD_ALIGNMENT - 1) &
+         ~pdk::puint64(RECORD_ALIGNMENT - 1);
+   if (size > buffer->m_capacity / 2) {
+      // too big to queue, the caller writes it after what is queued
+      buffer->m_busy.store(false, std::memory_order_release);
+      internal::flush_async_log_records();
+      return false;
+   }
+   const pdk::puint64 mask = buffer->m_capacity - 1;
+   const pdk::puint64 tail = buffer->m_tail.load(std::memory_order_relaxed);
+   const pdk::puint64 toEnd = buffer->m_capacity - (tail & mask);
+   // a record never wraps, the rest of the ring is skipped instead
+   const pdk::puint64 padding = toEnd < size ? toEnd : 0;
+   while (tail + padding + size - buffer->m_head.load(std::memory_order_acquire) > buffer->m_capacity) {
+      if (state.m_policy.load(std::memory_order_relaxed) != LogOverflowPolicy::Block) {
+         state.m_dropped.fetch_add(1, std::memory_order_relaxed);
+         buffer->m_busy.store(false, std::memory_order_release);
+         wake_writer(state);
+         return true;
+      }
+      wake_writer(state);
+      std::this_thread::yield();
+   }
+   char *data = buffer->m_data.get();
+   if (padding) {
+      RecordHeader *header = reinterpret_cast<RecordHeader *>(data + (tail & mask));
+      header->m_size = static_cast<pdk::puint32>(padding);
+      header->m_kind = RecordKind::Padding;
+   }
+   RecordHeader *header = reinterpret_cast<RecordHeader *>(data + ((tail + padding) & mask));
+   header->m_size = static_cast<pdk::puint32>(size);
+   header->m_kind = kind;
+   header->m_sink = sink;
+   header->m_type = static_cast<uchar>(type);
+   header->m_length = length;
+   header->m_line = context.m_line;
+   header->m_file = context.m_file;
+   header->m_function = context.m_function;
+   header->m_category = context.m_category;
+   fill(reinterpret_cast<char *>(header + 1));
+   buffer->m_tail.store(tail + padding + size, std::memory_order_release);
+   buffer->m_busy.store(false, std::memory_order_release);
+   wake_writer(state);
+   return true;
+}
+
+// the writer picks up the new file with its next drain
+void replace_binary_log(AsyncLogState &state, int fd)
+{
+   std::lock_guard<std::mutex> lock(state.m_binaryMutex);
+   if (state.m_binaryFd != -1) {
+      ::close(state.m_binaryFd);
+   }
+   state.m_binaryFd = fd;
+   ++state.m_binaryGeneration;
+}
+
+} // anonymous namespace
+
+namespace internal {
+
+bool post_async_log_record(pdk::MsgType type, LogSink sink, const MessageLogContext &context,
+                           const char *message, int length)
+{
+   if (length < 0) {
+      return false;
+   }
+   return post_record(RecordKind::Text, type, sink, context, static_cast<pdk::puint32>(length),
+                      static_cast<pdk::puint64>(length) + 1, [=](char *payload) {
+      std::memcpy(payload, message, length);
+      payload[length] = sink == LogSink::Console ? '\n' : '\0';
+   });
+}
+
+bool is_structured_logging_enabled()
+{
+   return async_state().m_structured.load(std::memory_order_relaxed);
+}
+
+bool post_deferred_log_record(pdk::MsgType type, LogSink sink, const MessageLogContext &context,
+                              const char *format, const CapturedLogArguments &arguments)
+{
+   const pdk::pint64 time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+   if (arguments.m_formatLength >= UINT_MAX) {
+      return false;
+   }
+   return post_record(RecordKind::Binary, type, sink, context, static_cast<pdk::puint32>(arguments.m_encodedSize),
+                      sizeof(DeferredPayload) + arguments.m_encodedSize + arguments.m_formatLength + 1,
+                      [&](char *payload) {
+      DeferredPayload *deferred = reinterpret_cast<DeferredPayload *>(payload);
+      deferred->m_formatLength = static_cast<pdk::puint32>(arguments.m_formatLength);
+      deferred->m_time = time;
+      deferred->m_thread = current_thread_id();
+      char *encoded = reinterpret_cast<char *>(deferred + 1);
+      encode_log_arguments(arguments, encoded);
+      std::memcpy(encoded + arguments.m_encodedSize, format, arguments.m_formatLength + 1);
+   });
+}
+
+void flush_async_log_records()
+{
+   AsyncLogState &state = async_state();
+   if (t_isWriter || !state.m_running.load(std::memory_order_acquire)) {
+      return;
+   }
+   std::vector<ConsumedRange> targets;
+   for (ThreadLogBuffer *buffer = state.m_buffers.load(std::memory_order_acquire); buffer;
+        buffer = buffer->m_next) {
+      targets.push_back({buffer, buffer->m_tail.load(std::memory_order_acquire)});
+   }
+   auto written = [&targets]() {
+      for (const ConsumedRange &target : targets) {
+         if (target.m_buffer->m_head.load(std::memory_order_acquire) < target.m_head) {
+            return false;
+         }
+      }
+      return true;
+   };
+   std::unique_lock<std::mutex> lock(state.m_mutex);
+   state.m_sleeping.store(false, std::memory_order_relaxed);
+   state.m_wakeUp.notify_one();
+   // a writer stuck on a blocked terminal must not hang a fatal message
+   const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+   while (!written() && state.m_running.load(std::memory_order_relaxed)) {
+      if (state.m_drained.wait_until(lock, deadline) == std::cv_status::timeout) {
+         break;
+      }
+   }
+}
+
+} // internal
+
+bool enable_async_logging(LogOverflowPolicy policy, int threadBufferSize)
+{
+   AsyncLogState &state = async_state();
+   std::lock_guard<std::mutex> control(state.m_controlMutex);
+   state.m_policy.store(policy, std::memory_order_relaxed);
+   if (state.m_running.load(std::memory_order_relaxed)) {
+      return true;
+   }
+   pdk::puint32 capacity = MIN_BUFFER_SIZE;
+   while (capacity < MAX_BUFFER_SIZE && static_cast<pdk::pint64>(capacity) < threadBufferSize) {
+      capacity <<= 1;
+   }
+   state.m_bufferSize = capacity;
+   state.m_stop.store(false, std::memory_order_relaxed);
+   state.m_writer = std::thread(writer_main, &state);
+   state.m_running.store(true, std::memory_order_release);
+   state.m_enabled.store(true, std::memory_order_seq_cst);
+   static bool registered = false;
+   if (!registered) {
+      std::atexit(disable_async_logging);
+      registered = true;
+   }
+   return true;
+}
+
+void disable_async_logging()
+{
+   AsyncLogState &state = async_state();
+   std::lock_guard<std::mutex> control(state.m_controlMutex);
+   if (!state.m_running.load(std::memory_order_relaxed) || t_isWriter) {
+      return;
+   }
+   state.m_structured.store(false, std::memory_order_relaxed);
+   state.m_enabled.store(false, std::memory_order_seq_cst);
+   // records being written still reach the writer
+   for (ThreadLogBuffer *buffer = state.m_buffers.load(std::memory_order_acquire); buffer;
+        buffer = buffer->m_next) {
+      while (buffer->m_busy.load(std::memory_order_seq_cst)) {
+         std::this_thread::yield();
+      }
+   }
+   {
+      std::lock_guard<std::mutex> lock(state.m_mutex);
+      state.m_stop.store(true, std::memory_order_release);
+      state.m_sleeping.store(false, std::memory_order_relaxed);
+      state.m_wakeUp.notify_one();
+   }
+   state.m_writer.join();
+   state.m_running.store(false, std::memory_order_release);
+   replace_binary_log(state, -1);
+}
+
+bool enable_structured_logging(const char *binaryLogFile)
+{
+   AsyncLogState &state = async_state();
+   if (!state.m_running.load(std::memory_order_acquire) && !enable_async_logging()) {
+      return false;
+   }
+   int fd = -1;
+   if (binaryLogFile) {
+      fd = ::open(binaryLogFile, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+      if (fd == -1) {
+         return false;
+      }
+      write_all(fd, internal::BINARY_LOG_MAGIC, internal::BINARY_LOG_MAGIC_SIZE);
+   }
+   // what is queued goes where it was meant to go
+   internal::flush_async_log_records();
+   replace_binary_log(state, fd);
+   state.m_structured.store(true, std::memory_order_relaxed);
+   return true;
+}
+
+void disable_structured_logging()
+{
+   AsyncLogState &state = async_state();
+   state.m_structured.store(false, std::memory_order_relaxed);
+   internal::flush_async_log_records();
+   replace_binary_log(state, -1);
+}
+
+void flush_async_logging()
+{
+   internal::flush_async_log_records();
+}
+
+pdk::puint64 get_dropped_log_message_count()
+{
+   return async_state().m_dropped.load(std::memory_order_relaxed);
+}
+
+#else // PDK_OS_UNIX
+
+namespace internal {
+
+bool post_async_log_record(pdk::MsgType, LogSink, const MessageLogContext &, const char *, int)
+{
+   return false;
+}
+
+void flush_async_log_records()
+{}
+
+bool is_structured_logging_enabled()
+{
+   return false;
+}
+
+bool post_deferred_log_record(pdk::MsgType, LogSink, const MessageLogContext &, const char *,
+                              const CapturedLogArguments &)
+{
+   return false;
+}
+
+} // internal
+
+bool enable_async_logging(LogOverflowPolicy, int)
+{
+   return false;
+}
+
+void disable_async_logging()
+{}
+
+void flush_async_logging()
+{}
+
+bool enable_structured_logging(const char *)
+{
+   return false;
+}
+
+void disable_structured_logging()
+{}
+
+pdk::puint64 get_dropped_log_message_count()
+{
+   return 0;
+}
+
+#endif // PDK_OS_UNIX
+
+} // pdk
@@ -0,0 +1,666 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/global/Global.h"
+#include "pdk/global/Logging.h"
+#include "pdk/global/internal/LoggingPrivate.h"
+#include "pdk/base/lang/String.h"
+#include "pdk/base/ds/ByteArray.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace pdk {
+
+using pdk::ds::ByteArray;
+using internal::CapturedLogArguments;
+using internal::LogArgument;
+using internal::MAX_LOG_ARGUMENTS;
+
+namespace {
+
+constexpr size_t SLOT_SIZE = 8;
+constexpr size_t LONG_DOUBLE_SIZE = 16;
+constexpr pdk::puint32 NULL_STRING = 0xffffffffu;
+
+static_assert(sizeof(long double) <= LONG_DOUBLE_SIZE, "long double does not fit its slot");
+
+// one escape of a format, read the way String::vasprintf reads it
+struct LogEscape
+{
+   const char *m_begin; // the '%'
+   const char *m_end;
+   int m_stars;         // star width and precision, read before the value
+   bool m_hasValue;
+   bool m_deferrable;
+   LogArgument m_argument;
+};
+
+inline bool is_digit(char c)
+{
+   return c >= '0' && c <= '9';
+}
+
+// moves c to the end of the next escape, false when there is none, a bad
+// escape ends before the character that made it bad
+bool next_log_escape(const char *&c, LogEscape &escape)
+{
+   while (*c != '\0' && *c != '%') {
+      ++c;
+   }
+   if (*c == '\0') {
+      return false;
+   }
+   escape.m_begin = c;
+   escape.m_stars = 0;
+   escape.m_hasValue = false;
+   escape.m_deferrable = true;
+   escape.m_argument = LogArgument::Int;
+   ++c;
+   if (*c == '\0' || *c == '%') {
+      // a trailing % and %% read nothing
+      c += *c == '%';
+      escape.m_end = c;
+      return true;
+   }
+   while (*c == '#' || *c == '0' || *c == '-' || *c == ' ' || *c == '+' || *c == '\'') {
+      ++c;
+   }
+   if (is_digit(*c)) {
+      while (is_digit(*c)) {
+         ++c;
+      }
+   } else if (*c == '*') {
+      ++escape.m_stars;
+      ++c;
+   }
+   if (*c == '.') {
+      ++c;
+      if (is_digit(*c)) {
+         while (is_digit(*c)) {
+            ++c;
+         }
+      } else if (*c == '*') {
+         ++escape.m_stars;
+         ++c;
+      }
+   }
+   // the length modifiers of String::vasprintf, hh and ll included
+   char length = '\0';
+   switch (*c) {
+   case 'h':
+   case 'l':
+      length = *c++;
+      if (*c == length) {
+         length = length == 'h' ? 'H' : 'q';
+         ++c;
+      }
+      break;
+   case 'L':
+   case 'j':
+   case 't':
+      length = *c++;
+      break;
+   case 'z':
+   case 'Z':
+      length = 'z';
+      ++c;
+      break;
+   default:
+      break;
+   }
+   if (*c == '\0') {
+      // an incomplete escape is text, its star arguments are read anyway
+      escape.m_end = c;
+      return true;
+   }
+   escape.m_end = c + 1;
+   escape.m_hasValue = true;
+   switch (*c) {
+   case 'd':
+   case 'i':
+   case 'o':
+   case 'u':
+   case 'x':
+   case 'X':
+      switch (length) {
+      case 'l':
+         escape.m_argument = LogArgument::Long;
+         break;
+      case 'j':
+         // unsigned conversions read nothing for j and t
+         escape.m_argument = LogArgument::Long;
+         escape.m_hasValue = *c == 'd' || *c == 'i';
+         break;
+      case 't':
+         escape.m_hasValue = *c == 'd' || *c == 'i';
+         break;
+      case 'q':
+         escape.m_argument = LogArgument::LongLong;
+         break;
+      case 'z':
+         escape.m_argument = LogArgument::SizeT;
+         break;
+      case 'L':
+         escape.m_hasValue = false;
+         break;
+      default:
+         break;
+      }
+      break;
+   case 'e':
+   case 'E':
+   case 'f':
+   case 'F':
+   case 'g':
+   case 'G':
+   case 'a':
+   case 'A':
+      escape.m_argument = length == 'L' ? LogArgument::LongDouble : LogArgument::Double;
+      break;
+   case 'c':
+      break;
+   case 's':
+      escape.m_argument = LogArgument::String;
+      escape.m_deferrable = length != 'l';
+      break;
+   case 'p':
+      escape.m_argument = LogArgument::Pointer;
+      break;
+   case 'n':
+      escape.m_deferrable = false;
+      break;
+   default:
+      escape.m_end = c;
+      escape.m_hasValue = false;
+      break;
+   }
+   return true;
+}
+
+// the arguments of a format in the order they are read
+struct LogFormat
+{
+   const char *m_format;
+   size_t m_length;
+   pdk::puint64 m_hash;
+   bool m_deferrable;
+   int m_count;
+   LogArgument m_kinds[MAX_LOG_ARGUMENTS];
+};
+
+void parse_log_format(const char *format, LogFormat &parsed)
+{
+   parsed.m_format = format;
+   parsed.m_deferrable = true;
+   parsed.m_count = 0;
+   const char *c = format;
+   LogEscape escape;
+   while (next_log_escape(c, escape)) {
+      const int count = escape.m_stars + (escape.m_hasValue ? 1 : 0);
+      if (!escape.m_deferrable || parsed.m_count + count > MAX_LOG_ARGUMENTS) {
+         parsed.m_deferrable = false;
+         return;
+      }
+      for (int i = 0; i < escape.m_stars; ++i) {
+         parsed.m_kinds[parsed.m_count++] = LogArgument::Int;
+      }
+      if (escape.m_hasValue) {
+         parsed.m_kinds[parsed.m_count++] = escape.m_argument;
+      }
+   }
+}
+
+// the parse of a format is cached per thread, formats are mostly literals
+// but a buffer may be reused for a different one, so the text has to
+// match as well as the address
+const LogFormat &cached_log_format(const char *format)
+{
+   constexpr size_t CACHE_SIZE = 64;
+   static thread_local LogFormat cache[CACHE_SIZE];
+   const size_t length = std::strlen(format);
+   const pdk::puint64 hash = internal::log_format_hash(format, length);
+   LogFormat &entry = cache[(reinterpret_cast<std::uintptr_t>(format) >> 3) % CACHE_SIZE];
+   if (entry.m_format != format || entry.m_length != length || entry.m_hash != hash) {
+      parse_log_format(format, entry);
+      entry.m_length = length;
+      entry.m_hash = hash;
+   }
+   return entry;
+}
+
+size_t string_slot_size(pdk::puint32 length)
+{
+   const size_t bytes = length == NULL_STRING ? 0 : length + 1;
+   return SLOT_SIZE + ((bytes + SLOT_SIZE - 1) & ~(SLOT_SIZE - 1));
+}
+
+// bounded reads of encoded arguments
+class ArgumentReader
+{
+public:
+   ArgumentReader(const char *data, size_t size)
+      : m_data(data),
+        m_end(data + size)
+   {}
+
+   template <typename T>
+   bool read(T &value, size_t slotSize = SLOT_SIZE)
+   {
+      if (static_cast<size_t>(m_end - m_data) < slotSize) {
+         return false;
+      }
+      std::memcpy(&value, m_data, sizeof(T));
+      m_data += slotSize;
+      return true;
+   }
+
+   bool readString(const char *&string)
+   {
+      pdk::puint32 length;
+      if (!read(length)) {
+         return false;
+      }
+      const size_t bytes = string_slot_size(length) - SLOT_SIZE;
+      if (static_cast<size_t>(m_end - m_data) < bytes ||
+          (length != NULL_STRING && m_data[length] != '\0')) {
+         return false;
+      }
+      string = length == NULL_STRING ? nullptr : m_data;
+      m_data += bytes;
+      return true;
+   }
+
+   bool atEnd() const
+   {
+      return m_data == m_end;
+   }
+
+private:
+   const char *m_data;
+   const char *m_end;
+};
+
+template <typename T>
+String format_escape(const char *spec, const int *stars, int starCount, T value)
+{
+   switch (starCount) {
+   case 0:
+      return String::asprintf(spec, value);
+   case 1:
+      return String::asprintf(spec, stars[0], value);
+   default:
+      return String::asprintf(spec, stars[0], stars[1], value);
+   }
+}
+
+const char *msg_type_name(pdk::MsgType type)
+{
+   switch (type) {
+   case pdk::MsgType::DebugMsg:
+      return "debug";
+   case pdk::MsgType::InfoMsg:
+      return "info";
+   case pdk::MsgType::WarningMsg:
+      return "warning";
+   case pdk::MsgType::CriticalMsg:
+      return "critical";
+   case pdk::MsgType::FatalMsg:
+      return "fatal";
+   }
+   return "unknown";
+}
+
+// reads the binary log file format written by the async log writer
+class BinaryLogReader
+{
+public:
+   explicit BinaryLogReader(const std::string &data)
+      : m_data(data.data()),
+        m_end(data.data() + data.size())
+   {}
+
+   template <typename T>
+   bool read(T &value)
+   {
+      if (static_cast<size_t>(m_end - m_data) < sizeof(T)) {
+         return false;
+      }
+      std::memcpy(&value, m_data, sizeof(T));
+      m_data += sizeof(T);
+      return true;
+   }
+
+   bool skip(size_t size, const char *&data)
+   {
+      if (static_cast<size_t>(m_end - m_data) < size) {
+         return false;
+      }
+      data = m_data;
+      m_data += size;
+      return true;
+   }
+
+   bool atEnd() const
+   {
+      return m_data == m_end;
+   }
+
+private:
+   const char *m_data;
+   const char *m_end;
+};
+
+} // anonymous namespace
+
+namespace internal {
+
+bool capture_log_arguments(const char *format, va_list ap, CapturedLogArguments &arguments)
+{
+   const LogFormat &parsed = cached_log_format(format);
+   if (!parsed.m_deferrable) {
+      return false;
+   }
+   arguments.m_count = parsed.m_count;
+   arguments.m_formatLength = parsed.m_length;
+   size_t size = 0;
+   for (int i = 0; i < parsed.m_count; ++i) {
+      CapturedLogArguments::Value &value = arguments.m_values[i];
+      arguments.m_kinds[i] = parsed.m_kinds[i];
+      switch (parsed.m_kinds[i]) {
+      case LogArgument::Int:
+         value.m_integer = va_arg(ap, int);
+         break;
+      case LogArgument::Long:
+         value.m_integer = va_arg(ap, long);
+         break;
+      case LogArgument::LongLong:
+         value.m_integer = va_arg(ap, pdk::pint64);
+         break;
+      case LogArgument::SizeT:
+         value.m_integer = static_cast<pdk::pint64>(va_arg(ap, size_t));
+         break;
+      case LogArgument::Double:
+         value.m_double = va_arg(ap, double);
+         break;
+      case LogArgument::LongDouble:
+         value.m_longDouble = va_arg(ap, long double);
+         size += LONG_DOUBLE_SIZE - SLOT_SIZE;
+         break;
+      case LogArgument::Pointer:
+         value.m_pointer = va_arg(ap, void *);
+         break;
+      case LogArgument::String: {
+         value.m_string = va_arg(ap, const char *);
+         const size_t length = value.m_string ? std::strlen(value.m_string) : 0;
+         if (length >= NULL_STRING) {
+            return false;
+         }
+         arguments.m_lengths[i] = value.m_string ? static_cast<pdk::puint32>(length) : NULL_STRING;
+         size += string_slot_size(arguments.m_lengths[i]) - SLOT_SIZE;
+         break;
+      }
+      }
+      size += SLOT_SIZE;
+   }
+   arguments.m_encodedSize = size;
+   return true;
+}
+
+const char *capture_log_text(const char *text, int length, CapturedLogArguments &arguments)
+{
+   arguments.m_count = 1;
+   arguments.m_kinds[0] = LogArgument::String;
+   arguments.m_values[0].m_string = text;
+   arguments.m_lengths[0] = static_cast<pdk::puint32>(length);
+   arguments.m_encodedSize = string_slot_size(arguments.m_lengths[0]);
+   arguments.m_formatLength = 2;
+   return "%s";
+}
+
+void encode_log_arguments(const CapturedLogArguments &arguments, char *out)
+{
+   for (int i = 0; i < arguments.m_count; ++i) {
+      const CapturedLogArguments::Value &value = arguments.m_values[i];
+      switch (arguments.m_kinds[i]) {
+      case LogArgument::Double:
+         std::memcpy(out, &value.m_double, SLOT_SIZE);
+         out += SLOT_SIZE;
+         break;
+      case LogArgument::LongDouble:
+         std::memset(out, 0, LONG_DOUBLE_SIZE);
+         std::memcpy(out, &value.m_longDouble, sizeof(long double));
+         out += LONG_DOUBLE_SIZE;
+         break;
+      case LogArgument::Pointer: {
+         const pdk::puint64 pointer = reinterpret_cast<std::uintptr_t>(value.m_pointer);
+         std::memcpy(out, &pointer, SLOT_SIZE);
+         out += SLOT_SIZE;
+         break;
+      }
+      case LogArgument::String: {
+         const pdk::puint32 length = arguments.m_lengths[i];
+         std::memset(out, 0, SLOT_SIZE);
+         std::memcpy(out, &length, sizeof(length));
+         const size_t slotSize = string_slot_size(arguments.m_lengths[i]);
+         if (value.m_string) {
+            std::memcpy(out + SLOT_SIZE, value.m_string, length);
+            std::memset(out + SLOT_SIZE + length, 0, slotSize - SLOT_SIZE - length);
+         }
+         out += slotSize;
+         break;
+      }
+      default:
+         std::memcpy(out, &value.m_integer, SLOT_SIZE);
+         out += SLOT_SIZE;
+         break;
+      }
+   }
+}
+
+pdk::puint64 log_format_hash(const char *format, size_t length)
+{
+   pdk::puint64 hash = 14695981039346656037ull;
+   for (size_t i = 0; i < length; ++i) {
+      hash = (hash ^ static_cast<uchar>(format[i])) * 1099511628211ull;
+   }
+   return hash;
+}
+
+bool format_log_arguments(const char *format, const char *encoded, size_t size, String &out)
+{
+   ArgumentReader reader(encoded, size);
+   std::string spec;
+   const char *c = format;
+   const char *text = format;
+   LogEscape escape;
+   while (next_log_escape(c, escape)) {
+      out.append(String::fromUtf8(text, static_cast<int>(escape.m_begin - text)));
+      text = escape.m_end;
+      c = escape.m_end;
+      if (!escape.m_deferrable) {
+         return false;
+      }
+      int stars[2];
+      for (int i = 0; i < escape.m_stars; ++i) {
+         pdk::pint64 star;
+         if (!reader.read(star)) {
+            return false;
+         }
+         stars[i] = static_cast<int>(star);
+      }
+      // the escape alone goes through String::vasprintf, that keeps every
+      // flag of it as it would have been in the calling thread
+      spec.assign(escape.m_begin, escape.m_end);
+      if (!escape.m_hasValue) {
+         out.append(format_escape(spec.c_str(), stars, escape.m_stars, 0));
+         continue;
+      }
+      switch (escape.m_argument) {
+      case LogArgument::Int: {
+         pdk::pint64 value;
+         if (!reader.read(value)) {
+            return false;
+         }
+         out.append(format_escape(spec.c_str(), stars, escape.m_stars, static_cast<int>(value)));
+         break;
+      }
+      case LogArgument::Long: {
+         pdk::pint64 value;
+         if (!reader.read(value)) {
+            return false;
+         }
+         out.append(format_escape(spec.c_str(), stars, escape.m_stars, static_cast<long>(value)));
+         break;
+      }
+      case LogArgument::LongLong: {
+         pdk::pint64 value;
+         if (!reader.read(value)) {
+            return false;
+         }
+         out.append(format_escape(spec.c_str(), stars, escape.m_stars, value));
+         break;
+      }
+      case LogArgument::SizeT: {
+         pdk::pint64 value;
+         if (!reader.read(value)) {
+            return false;
+         }
+         out.append(format_escape(spec.c_str(), stars, escape.m_stars, static_cast<size_t>(value)));
+         break;
+      }
+      case LogArgument::Double: {
+         double value;
+         if (!reader.read(value)) {
+            return false;
+         }
+         out.append(format_escape(spec.c_str(), stars, escape.m_stars, value));
+         break;
+      }
+      case LogArgument::LongDouble: {
+         long double value;
+         if (!reader.read(value, LONG_DOUBLE_SIZE)) {
+            return false;
+         }
+         out.append(format_escape(spec.c_str(), stars, escape.m_stars, value));
+         break;
+      }
+      case LogArgument::Pointer: {
+         pdk::puint64 value;
+         if (!reader.read(value)) {
+            return false;
+         }
+         out.append(format_escape(spec.c_str(), stars, escape.m_stars,
+                                  reinterpret_cast<void *>(static_cast<std::uintptr_t>(value))));
+         break;
+      }
+      case LogArgument::String: {
+         const char *value;
+         if (!reader.readString(value)) {
+            return false;
+         }
+         out.append(format_escape(spec.c_str(), stars, escape.m_stars, value));
+         break;
+      }
+      }
+   }
+   out.append(String::fromUtf8(text, static_cast<int>(std::strlen(text))));
+   return reader.atEnd();
+}
+
+} // internal
+
+bool decode_binary_log(const char *binaryLogFile, FILE *output)
+{
+   FILE *file = std::fopen(binaryLogFile, "rb");
+   if (!file) {
+      return false;
+   }
+   std::string data;
+   char chunk[64 * 1024];
+   size_t count;
+   while ((count = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+      data.append(chunk, count);
+   }
+   std::fclose(file);
+   if (data.compare(0, internal::BINARY_LOG_MAGIC_SIZE, internal::BINARY_LOG_MAGIC) != 0) {
+      return false;
+   }
+   BinaryLogReader reader(data);
+   const char *magic;
+   reader.skip(internal::BINARY_LOG_MAGIC_SIZE, magic);
+   // id 0 is the null string
+   std::vector<std::string> strings(1);
+   auto lookup = [&strings](pdk::puint32 id, const char *&string) {
+      if (id >= strings.size()) {
+         return false;
+      }
+      string = id ? strings[id].c_str() : nullptr;
+      return true;
+   };
+   while (!reader.atEnd()) {
+      char tag;
+      reader.read(tag);
+      if (tag == internal::BINARY_LOG_STRING) {
+         pdk::puint32 id;
+         pdk::puint32 length;
+         const char *bytes;
+         if (!reader.read(id) || !reader.read(length) || !reader.skip(length, bytes) ||
+             id != strings.size()) {
+            return false;
+         }
+         strings.emplace_back(bytes, length);
+         continue;
+      }
+      if (tag != internal::BINARY_LOG_RECORD) {
+         return false;
+      }
+      uchar type;
+      pdk::puint32 ids[4];
+      int line;
+      pdk::pint64 time;
+      pdk::puint64 thread;
+      pdk::puint32 argumentSize;
+      const char *arguments;
+      if (!reader.read(type) || !reader.read(ids) || !reader.read(line) || !reader.read(time) ||
+          !reader.read(thread) || !reader.read(argumentSize) || !reader.skip(argumentSize, arguments)) {
+         return false;
+      }
+      const char *format;
+      const char *fileName;
+      const char *function;
+      const char *category;
+      if (!lookup(ids[0], format) || !lookup(ids[1], fileName) || !lookup(ids[2], function) ||
+          !lookup(ids[3], category) || !format) {
+         return false;
+      }
+      String message;
+      if (!internal::format_log_arguments(format, arguments, argumentSize, message)) {
+         return false;
+      }
+      const ByteArray text = message.toUtf8();
+      std::fprintf(output, "%lld.%06lld %llu %s %s: %s\n",
+                   static_cast<long long>(time / 1000000000), static_cast<long long>(time / 1000 % 1000000),
+                   static_cast<unsigned long long>(thread), msg_type_name(static_cast<pdk::MsgType>(type)),
+                   category ? category : "default", text.getConstRawData());
+   }
+   return true;
+}
+
+} // pdk
@@ -23,6 +23,7 @@
 #include "pdk/base/time/DateTime.h"
 #include "pdk/base/os/thread/Thread.h"
 #include "pdk/base/io/internal/LoggingRegisteryPrivate.h"
+#include "pdk/global/internal/LoggingPrivate.h"
 #include "pdk/kernel/internal/CoreApplicationPrivate.h"
 #include "pdk/kernel/CoreApplication.h"
 #include "pdk/kernel/ElapsedTimer.h"
@@ -74,7 +75,7 @@ static long pdk_gettid()
 {
    // no error handling
    // this syscall has existed since Linux 2.4.11 and cannot fail
-   return syscall();
+   return syscall(SYS_gettid);
 }
 #elif defined(PDK_OS_DARWIN)
 #  include <pthread.h>
@@ -104,6 +105,7 @@ static pdk::pint64 pdk_gettid()
 #  include <execinfo.h>
 #endif
 
+#include <algorithm>
 #include <cstdlib>
 #include <stdio.h>
 
@@ -131,6 +133,7 @@ PDK_NORETURN
 #endif
 void pdk_message_fatal(pdk::MsgType, const MessageLogContext &context, const String &message);
 void pdk_message_print(pdk::MsgType, const MessageLogContext &context, const String &message);
+bool pdk_message_deferred(pdk::MsgType msgType, const MessageLogContext &context, const char *msg, va_list ap);
 
 int checked_var_value(const char *varname)
 {
@@ -146,20 +149,32 @@ int checked_var_value(const char *varname)
    return ok ? value : 1;
 }
 
+static AtomicInt &get_fatal_criticals()
+{
+   static AtomicInt fatalCriticals = checked_var_value("PDK_FATAL_CRITICALS");
+   return fatalCriticals;
+}
+
+static AtomicInt &get_fatal_warnings()
+{
+   static AtomicInt fatalWarnings = checked_var_value("PDK_FATAL_WARNINGS");
+   return fatalWarnings;
+}
+
 static bool is_fatal(pdk::MsgType msgType)
 {
    if (msgType == pdk::MsgType::FatalMsg) {
       return true;
    }
    if (msgType == pdk::MsgType::CriticalMsg) {
-      static AtomicInt fatalCriticals = checked_var_value("PDK_FATAL_CRITICALS");
+      AtomicInt &fatalCriticals = get_fatal_criticals();
       
       // it's fatal if the current value is exactly 1,
       // otherwise decrement if it's non-zero
       return fatalCriticals.load() && fatalCriticals.fetchAndAddRelaxed(-1) == 1;
    }
    if (msgType == pdk::MsgType::WarningMsg || msgType == pdk::MsgType::CriticalMsg) {
-      static AtomicInt fatalWarnings = checked_var_value("PDK_FATAL_WARNINGS");
+      AtomicInt &fatalWarnings = get_fatal_warnings();
       // it's fatal if the current value is exactly 1,
       // otherwise decrement if it's non-zero
       return fatalWarnings.load() && fatalWarnings.fetchAndAddRelaxed(-1) == 1;
@@ -168,6 +183,22 @@ static bool is_fatal(pdk::MsgType msgType)
    return false;
 }
 
+// whether is_fatal() may ever return true for the type, without counting
+// the message
+static bool may_be_fatal(pdk::MsgType msgType)
+{
+   if (msgType == pdk::MsgType::FatalMsg) {
+      return true;
+   }
+   if (msgType == pdk::MsgType::CriticalMsg) {
+      return get_fatal_criticals().load() != 0;
+   }
+   if (msgType == pdk::MsgType::WarningMsg) {
+      return get_fatal_warnings().load() != 0;
+   }
+   return false;
+}
+
 bool will_log_to_console()
 {
    // rules to determine if we'll log preferably to the console:
@@ -239,6 +270,9 @@ inline void convert_to_wchar_t_elided(wchar_t *d, size_t space, const char *s) P
 PDK_NEVER_INLINE
 String pdk_message(pdk::MsgType msgType, const MessageLogContext &context, const char *msg, va_list ap)
 {
+   if (pdk_message_deferred(msgType, context, msg, ap)) {
+      return String();
+   }
    String buf = String::vasprintf(msg, ap);
    pdk_message_print(msgType, context, buf);
    return buf;
@@ -1030,7 +1064,9 @@ static void slog2_default_handler(pdk::MsgType msgType, const char *message)
 
 PDK_GLOBAL_STATIC(MessagePattern, sg_messagePattern);
 
-String format_log_message(pdk::MsgType type, const MessageLogContext &context, const String &str)
+// origin is set for records the writer thread formats
+static String format_log_message(pdk::MsgType type, const MessageLogContext &context, const String &str,
+                                 const internal::LogRecordOrigin *origin)
 {
    String message;
    std::lock_guard<std::mutex> lock(MessagePattern::sm_mutex);
@@ -1091,7 +1127,11 @@ String format_log_message(pdk::MsgType type, const MessageLogContext &context, c
          message.append(CoreApplication::getAppName());
       } else if (token == sg_threadidTokenC) {
          // print the TID as decimal
-         message.append(String::number(pdk_gettid()));
+         if (origin) {
+            message.append(String::number(origin->m_thread));
+         } else {
+            message.append(String::number(pdk_gettid()));
+         }
       } else if (token == sg_qthreadptrTokenC) {
          message.append(Latin1String("0x"));
          message.append(String::number(pdk::plonglong(Thread::getCurrentThread()->getCurrentThread()), 16));
@@ -1106,21 +1146,30 @@ String format_log_message(pdk::MsgType type, const MessageLogContext &context, c
          std::advance(iter, timeArgsIdx);
          String timeFormat = *iter;
          timeArgsIdx++;
+         // a record the writer thread formats was logged that long ago
+         pdk::pint64 age = 0;
+         if (origin) {
+            age = std::max<pdk::pint64>(DateTime::getCurrentMSecsSinceEpoch() - origin->m_time / 1000000, 0);
+         }
          if (timeFormat == Latin1String("process")) {
-            pdk::puint64 ms = pattern->m_timer.elapsed();
+            pdk::puint64 ms = std::max<pdk::pint64>(pattern->m_timer.elapsed() - age, 0);
             message.append(String::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
          } else if (timeFormat ==  Latin1String("boot")) {
             // just print the milliseconds since the elapsed timer reference
             // like the Linux kernel does
             ElapsedTimer now;
             now.start();
-            uint ms = now.msecsSinceReference();
+            uint ms = now.msecsSinceReference() - age;
             message.append(String::asprintf("%6d.%03d", uint(ms / 1000), uint(ms % 1000)));
 #if PDK_CONFIG(datestring)
-         } else if (timeFormat.isEmpty()) {
-            message.append(DateTime::getCurrentDateTime().toString(pdk::DateFormat::ISODate));
          } else {
-            message.append(DateTime::getCurrentDateTime().toString(timeFormat));
+            const DateTime when = origin ? DateTime::fromMSecsSinceEpoch(origin->m_time / 1000000)
+                                         : DateTime::getCurrentDateTime();
+            if (timeFormat.isEmpty()) {
+               message.append(when.toString(pdk::DateFormat::ISODate));
+            } else {
+               message.append(when.toString(timeFormat));
+            }
 #endif // PDK_CONFIG(datestring)
          }
       } else if (token == sg_ifCategoryTokenC) {
@@ -1142,6 +1191,11 @@ String format_log_message(pdk::MsgType type, const MessageLogContext &context, c
    return message;
 }
 
+String format_log_message(pdk::MsgType type, const MessageLogContext &context, const String &str)
+{
+   return format_log_message(type, context, str, nullptr);
+}
+
 namespace {
 
 void pdk_default_msg_handler(pdk::MsgType type, const char *buf);
@@ -1213,6 +1267,46 @@ void syslog_default_message_handler(pdk::MsgType type, const char *message)
 }
 #endif
 
+namespace internal {
+
+void write_system_log_record(pdk::MsgType type, const MessageLogContext &context,
+                             const char *message)
+{
+#if PDK_CONFIG(journald)
+   systemd_default_message_handler(type, context, String::fromUtf8(message));
+#elif PDK_CONFIG(syslog)
+   PDK_UNUSED(context);
+   syslog_default_message_handler(type, message);
+#else
+   PDK_UNUSED(type);
+   PDK_UNUSED(context);
+   PDK_UNUSED(message);
+#endif
+}
+
+pdk::puint64 get_log_thread_id()
+{
+   return static_cast<pdk::puint64>(pdk_gettid());
+}
+
+bool format_deferred_log_message(pdk::MsgType type, const MessageLogContext &context, LogSink sink,
+                                 const LogRecordOrigin &origin, const String &message, ByteArray &out)
+{
+   const String logMessage = format_log_message(type, context, message, &origin);
+   if (logMessage.isNull()) {
+      return false;
+   }
+   if (sink == LogSink::System) {
+      out = logMessage.toUtf8();
+   } else {
+      out = logMessage.toLocal8Bit();
+      out.append('\n');
+   }
+   return true;
+}
+
+} // internal
+
 namespace {
 
 void pdk_default_message_handler(pdk::MsgType type, const MessageLogContext &context,
@@ -1233,15 +1327,21 @@ void pdk_default_message_handler(pdk::MsgType type, const MessageLogContext &con
       logMessage.append(Latin1Character('\n'));
       slog2_default_handler(type, logMessage.toLocal8Bit().getConstRawData());
       return;
-#elif PDK_CONFIG(journald)
-      systemd_default_message_handler(type, context, logMessage);
-      return;
-#elif PDK_CONFIG(syslog)
-      syslog_default_message_handler(type, logMessage.toUtf8().getConstRawData());
+#elif PDK_CONFIG(journald) || PDK_CONFIG(syslog)
+      const ByteArray utf8 = logMessage.toUtf8();
+      if (!internal::post_async_log_record(type, internal::LogSink::System, context,
+                                           utf8.getConstRawData(), utf8.size())) {
+         internal::write_system_log_record(type, context, utf8.getConstRawData());
+      }
       return;
 #endif
    }
-   fprintf(stderr, "%s\n", logMessage.toLocal8Bit().getConstRawData());
+   const ByteArray local = logMessage.toLocal8Bit();
+   if (internal::post_async_log_record(type, internal::LogSink::Console, context,
+                                       local.getConstRawData(), local.size())) {
+      return;
+   }
+   fprintf(stderr, "%s\n", local.getConstRawData());
    fflush(stderr);
 }
 
@@ -1293,8 +1393,52 @@ void pdk_message_print(pdk::MsgType msgType, const MessageLogContext &context, c
    }
 }
 
+// structured logging leaves formatting to the writer thread as long as the
+// default handler would get the message
+bool pdk_message_deferred(pdk::MsgType msgType, const MessageLogContext &context, const char *msg, va_list ap)
+{
+   // a fatal message has to be formatted for pdk_message_fatal
+   if (!internal::is_structured_logging_enabled() || !msg || may_be_fatal(msgType) ||
+       sg_msgHandler.load() != pdk_default_msg_handler ||
+       sg_messageHandler.load() != pdk_default_message_handler) {
+      return false;
+   }
+   if (!context.m_category || (strcmp(context.m_category, "default") == 0)) {
+      if (LoggingCategory *defaultCategory = LoggingCategory::getDefaultCategory()) {
+         if (!defaultCategory->isEnabled(msgType)) {
+            return true;
+         }
+      }
+   }
+   internal::LogSink sink = internal::LogSink::Console;
+   if (!pdk_logging_to_console()) {
+#if defined(PDK_OS_WIN) || PDK_CONFIG(slog2)
+      return false;
+#elif PDK_CONFIG(journald) || PDK_CONFIG(syslog)
+      sink = internal::LogSink::System;
+#endif
+   }
+   internal::CapturedLogArguments arguments;
+   va_list copy;
+   va_copy(copy, ap);
+   const bool captured = internal::capture_log_arguments(msg, copy, arguments);
+   va_end(copy);
+   if (captured) {
+      return internal::post_deferred_log_record(msgType, sink, context, msg, arguments);
+   }
+   // %n and friends are formatted here, the record still takes the
+   // structured path
+   va_copy(copy, ap);
+   const ByteArray utf8 = String::vasprintf(msg, copy).toUtf8();
+   va_end(copy);
+   const char *format = internal::capture_log_text(utf8.getConstRawData(), utf8.size(), arguments);
+   return internal::post_deferred_log_record(msgType, sink, context, format, arguments);
+}
+
 void pdk_message_fatal(pdk::MsgType, const MessageLogContext &context, const String &message)
 {
+   // the fatal message may still sit in an async log buffer
+   internal::flush_async_log_records();
 #if defined(PDK_CC_MSVC) && defined(PDK_DEBUG) && defined(_DEBUG) && defined(_CRT_ERROR)
    wchar_t contextFileL[256];
    // we probably should let the compiler do this for us, by declaring QMessageLogContext::file to
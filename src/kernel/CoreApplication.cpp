@@ -55,6 +55,8 @@
 #if defined(PDK_OS_UNIX)
 # if defined(PDK_OS_DARWIN)
 #  include "pdk/kernel/EventDispatcherCf.h"
+# elif defined(PDK_OS_LINUX)
+#  include "pdk/kernel/EventDispatcherEpoll.h"
 # endif
 # include "pdk/kernel/EventDispatcherUnix.h"
 #endif
@@ -68,6 +70,7 @@ using pdk::os::thread::Thread;
 using pdk::os::thread::internal::ThreadData;
 using pdk::os::thread::internal::PostEvent;
 using pdk::os::thread::internal::PostEventList;
+using pdk::os::thread::internal::PostEventNode;
 using pdk::os::thread::ThreadStorageData;
 using pdk::os::thread::ThreadPool;
 using pdk::os::thread::internal::ScopedScopeLevelCounter;
@@ -438,6 +441,7 @@ void CoreApplicationPrivate::cleanupThreadData()
       ThreadStorageData::finish(reinterpret_cast<void **>(data));
    }
    std::lock_guard<std::mutex> locker(m_threadData->m_postEventList.m_mutex);
+   m_threadData->takeIncomingPostEvents();
    for (size_t i = 0; i < m_threadData->m_postEventList.size(); ++i) {
       const PostEvent &pe = m_threadData->m_postEventList.at(i);
       if (pe.m_event) {
@@ -464,6 +468,16 @@ void CoreApplicationPrivate::createEventDispatcher()
    } else {
       sm_eventDispatcher = new EventDispatcherUNIX(apiPtr);
    }
+#  elif defined(PDK_OS_LINUX)
+   bool ok = false;
+   int value = pdk::env_var_intval("PDK_EVENT_DISPATCHER_POLL", &ok);
+   if (ok && value > 0) {
+      sm_eventDispatcher = new EventDispatcherUNIX(apiPtr);
+   } else {
+      sm_eventDispatcher = new EventDispatcherEpoll(apiPtr);
+   }
+#  else
+   sm_eventDispatcher = new EventDispatcherUNIX(apiPtr);
 #  endif
 #else
 #  error "pdk::kernel::EventDispatcher not yet ported to this platform"
@@ -1041,6 +1055,33 @@ void CoreApplication::postEvent(Object *receiver, Event *event, pdk::EventPriori
       delete event;
       return;
    }
+   if (!CoreApplicationPrivate::needsLockedPost(event)) {
+      // queue the event on the lock-free inbox, the receiver's thread runs
+      // compressEvent() when it merges it into the sorted list, following
+      // the receiver if it has moved meanwhile
+      pdk::utils::ScopedPointer<Event> eventDeleter(event);
+      PostEventNode *node = data->createPostEventNode(PostEvent(receiver, event, pdk::as_integer<pdk::EventPriority>(priority)));
+      eventDeleter.take();
+      event->m_posted = true;
+      ++receiver->getImplPtr()->m_postedEvents;
+      // only the poster that finds the inbox empty has to wake the dispatcher,
+      // everybody else is picked up by the same sendPostedEvents() pass
+      if (data->m_postEventList.pushIncoming(node)) {
+         AbstractEventDispatcher* dispatcher = data->m_eventDispatcher.loadAcquire();
+         if (dispatcher) {
+            dispatcher->wakeUp();
+         }
+      }
+      // pairs with the fence in ObjectPrivate::setThreadDataHelper(), if the
+      // receiver moved meanwhile the mover may have drained the inbox before
+      // the node arrived, forward it before the old thread can merge it
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (data != *pdata) {
+         std::lock_guard<std::mutex> locker(data->m_postEventList.m_mutex);
+         data->takeIncomingPostEvents();
+      }
+      return;
+   }
    // lock the post event mutex
    data->m_postEventList.m_mutex.lock();
    // if object has moved to another thread, follow it
@@ -1055,6 +1096,8 @@ void CoreApplication::postEvent(Object *receiver, Event *event, pdk::EventPriori
       data->m_postEventList.m_mutex.lock();
    }
    MutexUnlocker locker(&data->m_postEventList.m_mutex);
+   // compressEvent() has to see the events still sitting in the inbox
+   data->takeIncomingPostEvents();
    // if this is one of the compressible events, do compression
    if (receiver->getImplPtr()->m_postedEvents
        && sm_self && sm_self->compressEvent(event, receiver, &data->m_postEventList)) {
@@ -1168,6 +1211,7 @@ void CoreApplicationPrivate::sendPostedEvents(Object *receiver, Event::Type even
    }
    ++data->m_postEventList.m_recursion;
    std::unique_lock<std::mutex> locker(data->m_postEventList.m_mutex);
+   data->takeIncomingPostEvents();
    // by default, we assume that the event dispatcher can go to sleep after
    // processing all events. if any new events are posted while we send
    // events, canWait will be set to false.
@@ -1304,6 +1348,7 @@ void CoreApplicationPrivate::removePostedEvent(Event * event)
    }
    ThreadData *data = ThreadData::current();
    std::lock_guard<std::mutex> locker(data->m_postEventList.m_mutex);
+   data->takeIncomingPostEvents();
    if (data->m_postEventList.size() == 0) {
 #if defined(PDK_DEBUG)
       debug_stream("CoreApplication::removePostedEvent: Internal error: %p %d is posted",
@@ -1330,6 +1375,38 @@ void CoreApplicationPrivate::removePostedEvent(Event * event)
    }
 }
 
+bool CoreApplicationPrivate::needsLockedPost(Event *event)
+{
+   switch (event->getType()) {
+   // deferred deletes record the loop level of the posting thread, and
+   // quit is folded before anything else gets the chance to run
+   case Event::Type::DeferredDelete:
+   case Event::Type::Quit:
+#ifdef PDK_OS_WIN
+   case Event::Type::Timer:
+#endif
+      return true;
+   default:
+      return false;
+   }
+}
+
+bool CoreApplicationPrivate::compressIncomingEvent(Event *event, Object *receiver,
+                                                   PostEventList *postedEvents)
+{
+   // the poster has counted and flagged the event already, compressEvent()
+   // expects it to be neither, exactly like on the locked path
+   --receiver->getImplPtr()->m_postedEvents;
+   event->m_posted = false;
+   if (receiver->getImplPtr()->m_postedEvents && CoreApplication::sm_self
+       && CoreApplication::sm_self->compressEvent(event, receiver, postedEvents)) {
+      return true;
+   }
+   event->m_posted = true;
+   ++receiver->getImplPtr()->m_postedEvents;
+   return false;
+}
+
 void CoreApplicationPrivate::ref()
 {
    m_quitLockRef.ref();
@@ -1370,6 +1447,7 @@ void CoreApplication::removePostedEvents(Object *receiver, Event::Type eventType
 {
    ThreadData *data = receiver ? receiver->getImplPtr()->m_threadData : ThreadData::current();
    std::unique_lock<std::mutex> locker(data->m_postEventList.m_mutex);
+   data->takeIncomingPostEvents();
    // the Object destructor calls this function directly.  this can
    // happen while the event loop is in the middle of posting events,
    // and when we get here, we may not have any more posted events
@@ -61,8 +61,9 @@ namespace
 {
 
 
-#if PDK_COMPILER_SUPPORTS_HERE(SSE4_2)
-inline bool hash_fast_crc32()
+#if PDK_COMPILER_SUPPORTS_HERE(SSE4_2) || defined(PDK_SIMD_DISPATCH_X86)
+// built whatever the -m flags are, taken when cpuid reports sse4.2
+inline bool has_fast_crc32()
 {
    return CPU_HAS_FEATURE(SSE4_2);
 }
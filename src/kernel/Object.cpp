@@ -31,6 +31,7 @@
 #include "pdk/stdext/utility/Algorithms.h"
 #include "pdk/utils/SharedPointer.h"
 
+#include <atomic>
 #include <utility>
 #include <memory>
 #include <set>
@@ -473,7 +474,7 @@ void ObjectPrivate::moveToThreadHelper()
 void ObjectPrivate::setThreadDataHelper(ThreadData *currentData, ThreadData *targetData)
 {
    PDK_Q(Object);
-   // move posted events
+   // move posted events, the ones still in the inbox follow below
    int eventsMoved = 0;
    for (size_t i = 0; i < currentData->m_postEventList.size(); ++i) {
       const PostEvent &pe = currentData->m_postEventList.at(i);
@@ -501,6 +502,12 @@ void ObjectPrivate::setThreadDataHelper(ThreadData *currentData, ThreadData *tar
    targetData->ref();
    m_threadData->deref();
    m_threadData = targetData;
+   // switch first and drain afterwards, a lock-free poster that still read
+   // currentData either gets its node forwarded here or sees the switch in
+   // CoreApplication::postEvent() and forwards the node itself, otherwise
+   // currentData would later touch a receiver that may be deleted already
+   std::atomic_thread_fence(std::memory_order_seq_cst);
+   currentData->takeIncomingPostEvents();
    ObjectList::iterator iter = m_children.begin();
    ObjectList::iterator endMark = m_children.end();
    while (iter != endMark) {
@@ -0,0 +1,373 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/global/PlatformDefs.h"
+#include "pdk/kernel/CoreApplication.h"
+#include "pdk/kernel/internal/CoreApplicationPrivate.h"
+#include "pdk/kernel/SocketNotifier.h"
+#include "pdk/kernel/EventDispatcherEpoll.h"
+#include "pdk/kernel/internal/CoreUnixPrivate.h"
+#include "pdk/base/os/thread/Thread.h"
+#include "pdk/base/os/thread/internal/ThreadPrivate.h"
+#include "pdk/global/Logging.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+namespace pdk {
+namespace kernel {
+
+using internal::EventDispatcherEpollPrivate;
+using internal::CoreApplicationPrivate;
+
+namespace {
+
+// one epoll_wait call reports at most as many descriptors as the buffer
+// holds, it starts small and grows while it keeps coming back full
+constexpr size_t INITIAL_READY_EVENTS = 64;
+constexpr size_t MAX_READY_EVENTS = 4096;
+
+const char *socketType(SocketNotifier::Type type)
+{
+   switch (type) {
+   case SocketNotifier::Type::Read:
+      return "Read";
+      break;
+   case SocketNotifier::Type::Write:
+      return "Write";
+      break;
+   case SocketNotifier::Type::Exception:
+      return "Exception";
+      break;
+   }
+   PDK_UNREACHABLE();
+}
+
+uint32_t to_epoll_events(short pollEvents)
+{
+   uint32_t result = 0;
+   if (pollEvents & POLLIN) {
+      result |= EPOLLIN;
+   }
+   if (pollEvents & POLLOUT) {
+      result |= EPOLLOUT;
+   }
+   if (pollEvents & POLLPRI) {
+      result |= EPOLLPRI;
+   }
+   return result;
+}
+
+int timespec_to_msecs(const timespec &ts)
+{
+   // round up, otherwise a timer that is due in less than one millisecond
+   // would make us spin on epoll_wait until it expires
+   // and clamp, epoll_wait takes an int and a far away timer must not
+   // wrap around into a negative, i.e. infinite, timeout
+   constexpr time_t maxSecs = std::numeric_limits<int>::max() / 1000 - 1;
+   if (ts.tv_sec >= maxSecs) {
+      return std::numeric_limits<int>::max();
+   }
+   return static_cast<int>(ts.tv_sec * 1000 + (ts.tv_nsec + 999999) / 1000000);
+}
+
+bool is_invalid_socket(int fd)
+{
+   return ::fcntl(fd, F_GETFD) == -1 && errno == EBADF;
+}
+
+} // anonymous
+
+namespace internal {
+
+EventDispatcherEpollPrivate::EventDispatcherEpollPrivate()
+   : m_epollFd(::epoll_create1(EPOLL_CLOEXEC)),
+     m_readyEvents(INITIAL_READY_EVENTS)
+{
+   if (PDK_UNLIKELY(m_epollFd == -1)) {
+      fatal_stream("EventDispatcherEpollPrivate(): Can not continue without an epoll instance");
+   }
+   epoll_event event;
+   std::memset(&event, 0, sizeof(event));
+   event.events = EPOLLIN;
+   event.data.fd = m_threadPipe.m_fds[0];
+   if (PDK_UNLIKELY(::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, event.data.fd, &event) == -1)) {
+      fatal_stream("EventDispatcherEpollPrivate(): Can not watch the thread pipe");
+   }
+}
+
+EventDispatcherEpollPrivate::~EventDispatcherEpollPrivate()
+{
+   if (m_epollFd >= 0) {
+      safe_close(m_epollFd);
+   }
+}
+
+bool EventDispatcherEpollPrivate::updateInterestSet(int fd, short oldEvents, short newEvents)
+{
+   if (oldEvents == newEvents) {
+      return true;
+   }
+   epoll_event event;
+   std::memset(&event, 0, sizeof(event));
+   event.events = to_epoll_events(newEvents);
+   event.data.fd = fd;
+   int op = EPOLL_CTL_MOD;
+   if (oldEvents == 0) {
+      op = EPOLL_CTL_ADD;
+   } else if (newEvents == 0) {
+      op = EPOLL_CTL_DEL;
+   }
+   if (::epoll_ctl(m_epollFd, op, fd, &event) == 0) {
+      return true;
+   }
+   // a closed descriptor is dropped from the interest set by the kernel,
+   // so the number may come back here for a brand new socket
+   if (op == EPOLL_CTL_MOD && errno == ENOENT &&
+       ::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) == 0) {
+      return true;
+   }
+   if (op == EPOLL_CTL_DEL && (errno == ENOENT || errno == EBADF)) {
+      return true;
+   }
+   warning_stream("SocketNotifier: Unable to watch socket %d with epoll: %s",
+                  fd, std::strerror(errno));
+   return false;
+}
+
+int EventDispatcherEpollPrivate::waitForEvents(const timespec *timeout)
+{
+   const int maxEvents = static_cast<int>(m_readyEvents.size());
+   if (!timeout) {
+      // no timeout -> block forever
+      int ret;
+      PDK_EINTR_LOOP(ret, ::epoll_wait(m_epollFd, m_readyEvents.data(), maxEvents, -1));
+      return ret;
+   }
+   const timespec start = get_time();
+   timespec remaining = *timeout;
+   while (true) {
+      const int ret = ::epoll_wait(m_epollFd, m_readyEvents.data(), maxEvents,
+                                   timespec_to_msecs(remaining));
+      if (ret != -1 || errno != EINTR) {
+         return ret;
+      }
+      // recalculate the timeout
+      remaining = *timeout + start - get_time();
+      if (remaining.tv_sec < 0) {
+         return 0;
+      }
+   }
+}
+
+int EventDispatcherEpollPrivate::markPendingSocketNotifiers(int nready)
+{
+   static const struct
+   {
+      SocketNotifier::Type m_type;
+      uint32_t m_flags;
+   } notifierFlags[] = {
+   {SocketNotifier::Type::Read,      EPOLLIN | EPOLLHUP | EPOLLERR},
+   {SocketNotifier::Type::Write,     EPOLLOUT | EPOLLHUP | EPOLLERR},
+   {SocketNotifier::Type::Exception, EPOLLPRI | EPOLLHUP | EPOLLERR}
+};
+   int wakeUps = 0;
+   for (int i = 0; i < nready; ++i) {
+      const epoll_event &event = m_readyEvents[i];
+      const int fd = event.data.fd;
+      if (fd == m_threadPipe.m_fds[0]) {
+         pollfd pfd = make_pollfd(fd, POLLIN);
+         pfd.revents = (event.events & EPOLLIN) ? POLLIN : 0;
+         wakeUps += m_threadPipe.check(pfd);
+         continue;
+      }
+      auto iter = m_socketNotifiers.find(fd);
+      if (iter == m_socketNotifiers.end()) {
+         continue;
+      }
+      SocketNotifierSetUNIX &snSet = iter->second;
+      // epoll has no POLLNVAL, a descriptor closed behind our back is
+      // reported through EPOLLHUP / EPOLLERR if at all
+      const bool invalid = (event.events & (EPOLLHUP | EPOLLERR)) && is_invalid_socket(fd);
+      for (const auto &nflag : notifierFlags) {
+         SocketNotifier *notifier = snSet.m_notifiers[static_cast<int>(nflag.m_type)];
+         if (!notifier) {
+            continue;
+         }
+         if (invalid) {
+            warning_stream("SocketNotifier: Invalid socket %d with type %s, disabling...",
+                           fd, socketType(notifier->getType()));
+            notifier->setEnabled(false);
+            // disabling the last notifier erases the set
+            iter = m_socketNotifiers.find(fd);
+            if (iter == m_socketNotifiers.end()) {
+               break;
+            }
+            continue;
+         }
+         if (event.events & nflag.m_flags) {
+            setSocketNotifierPending(snSet, nflag.m_type);
+         }
+      }
+   }
+   if (static_cast<size_t>(nready) == m_readyEvents.size() &&
+       m_readyEvents.size() < MAX_READY_EVENTS) {
+      m_readyEvents.resize(m_readyEvents.size() * 2);
+   }
+   return wakeUps;
+}
+
+} // internal
+
+EventDispatcherEpoll::EventDispatcherEpoll(Object *parent)
+   : EventDispatcherUNIX(*new EventDispatcherEpollPrivate, parent)
+{}
+
+EventDispatcherEpoll::EventDispatcherEpoll(EventDispatcherEpollPrivate &dd, Object *parent)
+   : EventDispatcherUNIX(dd, parent)
+{}
+
+EventDispatcherEpoll::~EventDispatcherEpoll()
+{}
+
+void EventDispatcherEpoll::registerSocketNotifier(SocketNotifier *notifier)
+{
+   PDK_ASSERT(notifier);
+   int sockfd = notifier->getSocket();
+   SocketNotifier::Type type = notifier->getType();
+#ifndef PDK_NO_DEBUG
+   if (notifier->getThread() != getThread() || getThread() != Thread::getCurrentThread()) {
+      warning_stream("SocketNotifier: socket notifiers cannot be enabled from another thread");
+      return;
+   }
+#endif
+   PDK_D(EventDispatcherEpoll);
+   SocketNotifierSetUNIX &snSet = implPtr->m_socketNotifiers[sockfd];
+   const short oldEvents = snSet.events();
+   int typeValue = static_cast<int>(type);
+   if (snSet.m_notifiers[typeValue] && snSet.m_notifiers[typeValue] != notifier) {
+      warning_stream("%s: Multiple socket notifiers for same socket %d and type %s",
+                     PDK_FUNC_INFO, sockfd, socketType(type));
+   }
+   snSet.m_notifiers[typeValue] = notifier;
+   if (!implPtr->updateInterestSet(sockfd, oldEvents, snSet.events())) {
+      snSet.m_notifiers[typeValue] = nullptr;
+      if (snSet.isEmpty()) {
+         implPtr->m_socketNotifiers.erase(sockfd);
+      }
+   }
+}
+
+void EventDispatcherEpoll::unregisterSocketNotifier(SocketNotifier *notifier)
+{
+   PDK_ASSERT(notifier);
+   int sockfd = notifier->getSocket();
+   SocketNotifier::Type type = notifier->getType();
+#ifndef PDK_NO_DEBUG
+   if (notifier->getThread() != getThread() || getThread() != Thread::getCurrentThread()) {
+      warning_stream("SocketNotifier: socket notifier (fd %d) cannot be disabled from another thread.", sockfd);
+      return;
+   }
+#endif
+   PDK_D(EventDispatcherEpoll);
+   auto iter = implPtr->m_socketNotifiers.find(sockfd);
+   if (iter == implPtr->m_socketNotifiers.end()) {
+      return;
+   }
+   SocketNotifierSetUNIX &snSet = iter->second;
+   int typeValue = static_cast<int>(type);
+   if (snSet.m_notifiers[typeValue] == nullptr) {
+      return;
+   }
+   if (snSet.m_notifiers[typeValue] != notifier) {
+      warning_stream("%s: Multiple socket notifiers for same socket %d and type %s",
+                     PDK_FUNC_INFO, sockfd, socketType(type));
+      return;
+   }
+   implPtr->clearSocketNotifierPending(snSet, type);
+   const short oldEvents = snSet.events();
+   snSet.m_notifiers[typeValue] = nullptr;
+   implPtr->updateInterestSet(sockfd, oldEvents, snSet.events());
+   if (snSet.isEmpty()) {
+      implPtr->m_socketNotifiers.erase(iter);
+   }
+}
+
+bool EventDispatcherEpoll::processEvents(EventLoop::ProcessEventsFlags flags)
+{
+   PDK_D(EventDispatcherEpoll);
+   implPtr->m_interrupt.store(0);
+   // we are awake, broadcast it
+   // emit awake() signal;
+   CoreApplicationPrivate::sendPostedEvents(0, Event::Type::None, implPtr->m_threadData);
+   const bool includeTimers = (flags & EventLoop::X11ExcludeTimers) == 0;
+   const bool includeNotifiers = (flags & EventLoop::ExcludeSocketNotifiers) == 0;
+   const bool waitForEvents = flags & EventLoop::WaitForMoreEvents;
+   const bool canWait = (implPtr->m_threadData->canWaitLocked()
+                         && !implPtr->m_interrupt.load()
+                         && waitForEvents);
+   if (canWait) {
+      // emit aboutToBlock();
+   }
+   if (implPtr->m_interrupt.load()) {
+      return false;
+   }
+   timespec *ts = nullptr;
+   timespec waitTs = { 0, 0 };
+   if (!canWait || (includeTimers && implPtr->m_timerList.timerWait(waitTs))) {
+      ts = &waitTs;
+   }
+   int nevents = 0;
+   if (includeNotifiers) {
+      const int nready = implPtr->waitForEvents(ts);
+      switch (nready) {
+      case -1:
+         perror("pdk::kernel::epoll_wait");
+         break;
+      case 0:
+         break;
+      default:
+         nevents += implPtr->markPendingSocketNotifiers(nready);
+         nevents += implPtr->getActivateSocketNotifiers();
+         break;
+      }
+   } else {
+      // the interest set is level triggered, waiting on it would return
+      // immediately for every ready socket, so only watch the thread pipe
+      pollfd wakeUpPfd = implPtr->m_threadPipe.prepare();
+      switch (safe_poll(&wakeUpPfd, 1, ts)) {
+      case -1:
+         perror("pdk::kernel::safe_poll");
+         break;
+      case 0:
+         break;
+      default:
+         nevents += implPtr->m_threadPipe.check(wakeUpPfd);
+         break;
+      }
+   }
+   if (includeTimers) {
+      nevents += implPtr->getActivateTimers();
+   }
+   // return true if we handled events, false otherwise
+   return (nevents > 0);
+}
+
+} // kernel
+} // pdk
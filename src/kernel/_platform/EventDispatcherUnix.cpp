@@ -213,17 +213,34 @@ EventDispatcherUNIXPrivate::~EventDispatcherUNIXPrivate()
    pdk::stdext::delete_all(m_timerList);
 }
 
-void EventDispatcherUNIXPrivate::setSocketNotifierPending(SocketNotifier *notifier)
+void EventDispatcherUNIXPrivate::setSocketNotifierPending(SocketNotifierSetUNIX &snSet,
+                                                          SocketNotifier::Type type)
 {
+   int typeValue = static_cast<int>(type);
+   SocketNotifier *notifier = snSet.m_notifiers[typeValue];
    PDK_ASSERT(notifier);
-   auto iter = std::find(m_pendingNotifiers.cbegin(),
-                         m_pendingNotifiers.cend(), notifier);
-   if (iter != m_pendingNotifiers.cend()) {
+   if (snSet.m_pending[typeValue]) {
       return;
    }
+   snSet.m_pending[typeValue] = true;
    m_pendingNotifiers.push_back(notifier);
 }
 
+void EventDispatcherUNIXPrivate::clearSocketNotifierPending(SocketNotifierSetUNIX &snSet,
+                                                            SocketNotifier::Type type)
+{
+   int typeValue = static_cast<int>(type);
+   if (!snSet.m_pending[typeValue]) {
+      return;
+   }
+   snSet.m_pending[typeValue] = false;
+   auto iter = std::find(m_pendingNotifiers.cbegin(),
+                         m_pendingNotifiers.cend(), snSet.m_notifiers[typeValue]);
+   if (iter != m_pendingNotifiers.cend()) {
+      m_pendingNotifiers.erase(iter);
+   }
+}
+
 int EventDispatcherUNIXPrivate::getActivateTimers()
 {
    return m_timerList.getActivateTimers();
@@ -237,7 +254,7 @@ void EventDispatcherUNIXPrivate::markPendingSocketNotifiers()
       }
       auto iter = m_socketNotifiers.find(pfd.fd);
       PDK_ASSERT(iter != m_socketNotifiers.end());
-      const SocketNotifierSetUNIX &snSet = iter->second;
+      SocketNotifierSetUNIX &snSet = iter->second;
       static const struct
       {
          SocketNotifier::Type m_type;
@@ -258,7 +275,7 @@ void EventDispatcherUNIXPrivate::markPendingSocketNotifiers()
             notifier->setEnabled(false);
          }
          if (pfd.revents & nflag.m_flags) {
-            setSocketNotifierPending(notifier);
+            setSocketNotifierPending(snSet, nflag.m_type);
          }
       }
    }
@@ -276,6 +293,11 @@ int EventDispatcherUNIXPrivate::getActivateSocketNotifiers()
    while (!m_pendingNotifiers.empty()) {
       SocketNotifier *notifier = m_pendingNotifiers.front();
       m_pendingNotifiers.pop_front();
+      // a pending notifier is always registered, unregistering drops it
+      // from the pending list
+      auto iter = m_socketNotifiers.find(notifier->getSocket());
+      PDK_ASSERT(iter != m_socketNotifiers.end());
+      iter->second.m_pending[static_cast<int>(notifier->getType())] = false;
       CoreApplication::sendEvent(notifier, &event);
       ++nActivated;
    }
@@ -389,13 +411,8 @@ void EventDispatcherUNIX::unregisterSocketNotifier(SocketNotifier *notifier)
    }
 #endif
    PDK_D(EventDispatcherUNIX);
-   const auto piter = std::find(implPtr->m_pendingNotifiers.cbegin(),
-                                implPtr->m_pendingNotifiers.cend(), notifier);
-   if (piter != implPtr->m_pendingNotifiers.cend()) {
-      implPtr->m_pendingNotifiers.erase(piter);
-   }
    auto iter = implPtr->m_socketNotifiers.find(sockfd);
-   if (iter != implPtr->m_socketNotifiers.end()) {
+   if (iter == implPtr->m_socketNotifiers.end()) {
       return;
    }
    SocketNotifierSetUNIX &snSet = iter->second;
@@ -408,6 +425,7 @@ void EventDispatcherUNIX::unregisterSocketNotifier(SocketNotifier *notifier)
                      PDK_FUNC_INFO, sockfd, socketType(type));
       return;
    }
+   implPtr->clearSocketNotifierPending(snSet, type);
    snSet.m_notifiers[typeValue] = nullptr;
    if (snSet.isEmpty()) {
       implPtr->m_socketNotifiers.erase(iter);
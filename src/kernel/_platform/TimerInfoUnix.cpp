@@ -62,6 +62,7 @@ TimerInfoList::TimerInfoList()
       m_msPerTick = 0;
    }
 #endif
+   m_nextSequence = 0;
    m_firstTimerInfo = nullptr;
 }
 
@@ -141,22 +142,138 @@ void TimerInfoList::repairTimersIfNeeded()
 
 #endif
 
+namespace {
+
+// the heap order, equal timeouts keep their scheduling order
+inline bool timer_before(const TimerInfo *first, const TimerInfo *second)
+{
+   if (first->m_timeout < second->m_timeout) {
+      return true;
+   }
+   return !(second->m_timeout < first->m_timeout) && first->m_sequence < second->m_sequence;
+}
+
+} // anonymous namespace
+
 /*
-  insert timer info into list
+  insert timer info into the heap
 */
 void TimerInfoList::timerInsert(TimerInfo *timeInfo)
 {
-   TimerInfoList::iterator iter = begin();
-   TimerInfoList::iterator endMark = end();
-   while (iter != endMark) {
-      const TimerInfo * const t = *iter;
-      if (!(timeInfo->m_timeout < t->m_timeout)) {
+   timeInfo->m_sequence = m_nextSequence++;
+   push_back(timeInfo);
+   heapSiftUp(size() - 1);
+}
+
+void TimerInfoList::heapSiftUp(size_t index)
+{
+   TimerInfo *timeInfo = (*this)[index];
+   while (index > 0) {
+      size_t parent = (index - 1) / 2;
+      TimerInfo *parentInfo = (*this)[parent];
+      if (!timer_before(timeInfo, parentInfo)) {
          break;
-      }   
-      ++iter;
+      }
+      (*this)[index] = parentInfo;
+      parentInfo->m_heapIndex = index;
+      index = parent;
+   }
+   (*this)[index] = timeInfo;
+   timeInfo->m_heapIndex = index;
+}
+
+void TimerInfoList::heapSiftDown(size_t index)
+{
+   const size_t count = size();
+   TimerInfo *timeInfo = (*this)[index];
+   while (true) {
+      size_t child = 2 * index + 1;
+      if (child >= count) {
+         break;
+      }
+      if (child + 1 < count && timer_before((*this)[child + 1], (*this)[child])) {
+         ++child;
+      }
+      TimerInfo *childInfo = (*this)[child];
+      if (!timer_before(childInfo, timeInfo)) {
+         break;
+      }
+      (*this)[index] = childInfo;
+      childInfo->m_heapIndex = index;
+      index = child;
+   }
+   (*this)[index] = timeInfo;
+   timeInfo->m_heapIndex = index;
+}
+
+void TimerInfoList::heapRemove(TimerInfo *timeInfo)
+{
+   const size_t index = timeInfo->m_heapIndex;
+   TimerInfo *last = back();
+   pop_back();
+   if (last == timeInfo) {
+      return;
+   }
+   // move the last timer into the hole, it may belong above or below it
+   (*this)[index] = last;
+   last->m_heapIndex = index;
+   if (index > 0 && timer_before(last, (*this)[(index - 1) / 2])) {
+      heapSiftUp(index);
+   } else {
+      heapSiftDown(index);
+   }
+}
+
+TimerInfo *TimerInfoList::firstWaitingTimer() const
+{
+   if (empty()) {
+      return nullptr;
+   }
+   if (!front()->m_activateRef) {
+      return front();
+   }
+   // only timers of nested event loops are being activated, walk down
+   // through them and keep the earliest idle timer, the subtree of an
+   // idle timer can never fire before the timer itself
+   TimerInfo *result = nullptr;
+   std::vector<size_t> pending(1, 0);
+   while (!pending.empty()) {
+      const size_t index = pending.back();
+      pending.pop_back();
+      TimerInfo *t = (*this)[index];
+      if (result && !timer_before(t, result)) {
+         continue;
+      }
+      if (!t->m_activateRef) {
+         result = t;
+         continue;
+      }
+      for (size_t child = 2 * index + 1; child <= 2 * index + 2 && child < size(); ++child) {
+         pending.push_back(child);
+      }
+   }
+   return result;
+}
+
+int TimerInfoList::countExpiredTimers(const timespec &currentTime) const
+{
+   int count = 0;
+   if (empty() || currentTime < front()->m_timeout) {
+      return count;
+   }
+   std::vector<size_t> pending(1, 0);
+   while (!pending.empty()) {
+      const size_t index = pending.back();
+      pending.pop_back();
+      if (currentTime < (*this)[index]->m_timeout) {
+         continue;
+      }
+      ++count;
+      for (size_t child = 2 * index + 1; child <= 2 * index + 2 && child < size(); ++child) {
+         pending.push_back(child);
+      }
    }
-   std::advance(iter, 1);
-   insert(iter, timeInfo);
+   return count;
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -345,13 +462,7 @@ bool TimerInfoList::timerWait(timespec &tm)
    timespec currentTime = updateCurrentTime();
    repairTimersIfNeeded();
    // Find first waiting timer not already active
-   TimerInfo *t = nullptr;
-   for (TimerInfoList::const_iterator iter = cbegin(); iter != cend(); ++iter) {
-      if (!(*iter)->m_activateRef) {
-         t = *iter;
-         break;
-      }
-   }
+   TimerInfo *t = firstWaitingTimer();
    if (!t) {
       return false;
    }
@@ -371,20 +482,16 @@ int TimerInfoList::timerRemainingTime(int timerId)
    timespec currentTime = updateCurrentTime();
    repairTimersIfNeeded();
    timespec tm = {0, 0};
-   TimerInfoList::iterator iter = begin();
-   TimerInfoList::iterator endMark = end();
-   while (iter != endMark) {
-      TimerInfo *t = *iter;
-      if (t->m_id == timerId) {
-         if (currentTime < t->m_timeout) {
-            // time to wait
-            tm = round_to_millisecond(t->m_timeout - currentTime);
-            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-         } else {
-            return 0;
-         }
+   auto iter = m_timerIds.find(timerId);
+   if (iter != m_timerIds.end()) {
+      TimerInfo *t = iter->second;
+      if (currentTime < t->m_timeout) {
+         // time to wait
+         tm = round_to_millisecond(t->m_timeout - currentTime);
+         return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+      } else {
+         return 0;
       }
-      ++iter;
    }
    
 #ifndef PDK_NO_DEBUG
@@ -401,6 +508,8 @@ void TimerInfoList::registerTimer(int timerId, int interval, pdk::TimerType time
    t->m_timerType = timerType;
    t->m_obj = object;
    t->m_activateRef = 0;
+   t->m_heapIndex = 0;
+   t->m_sequence = 0;
    timespec expected = updateCurrentTime() + interval;
    switch (timerType) {
    case pdk::TimerType::PreciseTimer:
@@ -442,6 +551,7 @@ void TimerInfoList::registerTimer(int timerId, int interval, pdk::TimerType time
       }
    }
    timerInsert(t);
+   m_timerIds[timerId] = t;
 #ifdef PDK_TIMERINFO_DEBUG
    t->m_expected = expected;
    t->m_cumulativeError = 0;
@@ -474,27 +584,23 @@ Debug operator<<(Debug s, pdk::TimerType t)
 
 bool TimerInfoList::unregisterTimer(int timerId)
 {
+   auto iter = m_timerIds.find(timerId);
+   if (iter == m_timerIds.end()) {
+      // id not found
+      return false;
+   }
    // set timer inactive
-   TimerInfoList::iterator iter = begin();
-   TimerInfoList::iterator endMark = end();
-   while (iter != endMark) {
-      TimerInfo *t = *iter;
-      if (t->m_id == timerId) {
-         // found it
-         erase(iter);
-         if (t == m_firstTimerInfo) {
-            m_firstTimerInfo = nullptr;
-         }
-         if (t->m_activateRef) {
-            *(t->m_activateRef) = 0;
-         }            
-         delete t;
-         return true;
-      }
-      ++iter;
+   TimerInfo *t = iter->second;
+   m_timerIds.erase(iter);
+   heapRemove(t);
+   if (t == m_firstTimerInfo) {
+      m_firstTimerInfo = nullptr;
    }
-   // id not found
-   return false;
+   if (t->m_activateRef) {
+      *(t->m_activateRef) = 0;
+   }
+   delete t;
+   return true;
 }
 
 bool TimerInfoList::unregisterTimers(Object *object)
@@ -502,23 +608,30 @@ bool TimerInfoList::unregisterTimers(Object *object)
    if (empty()) {
       return false;
    }
-   TimerInfoList::iterator iter = begin();
-   TimerInfoList::iterator endMark = end();
-   while (iter != endMark) {
-      TimerInfo *t = *iter;
-      if (t->m_obj == object) {
-         // object found
-         erase(iter);
-         if (t == m_firstTimerInfo) {
-            m_firstTimerInfo = nullptr;
-         }  
-         if (t->m_activateRef) {
-            *(t->m_activateRef) = 0;
-         }
-         delete t;
-         // move back one so that we don't skip the new current item
+   size_t kept = 0;
+   for (size_t i = 0; i < size(); ++i) {
+      TimerInfo *t = (*this)[i];
+      if (t->m_obj != object) {
+         (*this)[kept++] = t;
+         continue;
       }
-      ++iter;
+      // object found
+      m_timerIds.erase(t->m_id);
+      if (t == m_firstTimerInfo) {
+         m_firstTimerInfo = nullptr;
+      }  
+      if (t->m_activateRef) {
+         *(t->m_activateRef) = 0;
+      }
+      delete t;
+   }
+   resize(kept);
+   // rebuild the heap from the remaining timers
+   for (size_t i = 0; i < kept; ++i) {
+      (*this)[i]->m_heapIndex = i;
+   }
+   for (size_t i = kept / 2; i-- > 0;) {
+      heapSiftDown(i);
    }
    return true;
 }
@@ -557,12 +670,7 @@ int TimerInfoList::getActivateTimers()
 #endif
    repairTimersIfNeeded();   
    // Find out how many timer have expired
-   for (TimerInfoList::const_iterator iter = cbegin(); iter != cend(); ++iter) {
-      if (currentTime < (*iter)->m_timeout) {
-         break;
-      }
-      maxCount++;
-   }
+   maxCount = countExpiredTimers(currentTime);
    //fire the timers.
    while (maxCount--) {
       if (empty()) {
@@ -582,9 +690,6 @@ int TimerInfoList::getActivateTimers()
          m_firstTimerInfo = currentTimerInfo;
       }
       
-      // remove from list
-      pop_front();
-      
 #ifdef PDK_TIMERINFO_DEBUG
       float diff;
       if (currentTime < currentTimerInfo->m_expected) {
@@ -606,10 +711,11 @@ int TimerInfoList::getActivateTimers()
       }
       
 #endif
-      // determine next timeout time
+      // determine next timeout time, the timeout only grows so
+      // the timer just has to sink from the top of the heap
       calculate_next_timeout(currentTimerInfo, currentTime);
-      // reinsert timer
-      timerInsert(currentTimerInfo);
+      currentTimerInfo->m_sequence = m_nextSequence++;
+      heapSiftDown(currentTimerInfo->m_heapIndex);
       if (currentTimerInfo->m_interval > 0) {
          n_act++;
       }
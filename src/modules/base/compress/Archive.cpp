@@ -0,0 +1,355 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/compress/internal/ArchivePrivate.h"
+#include "pdk/base/compress/InflateDevice.h"
+#include "pdk/base/io/Buffer.h"
+#include "pdk/global/Endian.h"
+#include "pdk/global/Logging.h"
+
+#if PDK_CONFIG(zlib)
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <limits>
+
+namespace pdk {
+namespace compress {
+
+using pdk::io::Buffer;
+using pdk::lang::Latin1String;
+
+ArchiveEntry::ArchiveEntry()
+   : m_name(nullptr),
+     m_nameLength(0),
+     m_method(Method::Unsupported),
+     m_crc32(0),
+     m_size(0),
+     m_compressedSize(0),
+     m_headerOffset(-1),
+     m_dataOffset(-1)
+{}
+
+String ArchiveEntry::getName() const
+{
+   return String::fromUtf8(m_name, m_nameLength);
+}
+
+ByteArray ArchiveEntry::getRawName() const
+{
+   return ByteArray::fromRawData(m_name, m_nameLength);
+}
+
+bool ArchiveEntry::isDir() const
+{
+   return m_nameLength > 0 && m_name[m_nameLength - 1] == '/';
+}
+
+namespace internal {
+
+namespace {
+
+pdk::puint32 compute_crc32(const char *data, pdk::pint64 length)
+{
+#if PDK_CONFIG(zlib)
+   uLong crc = ::crc32(0L, Z_NULL, 0);
+   while (length > 0) {
+      const uInt chunk = static_cast<uInt>(std::min<pdk::pint64>(length, std::numeric_limits<uInt>::max()));
+      crc = ::crc32(crc, reinterpret_cast<const Bytef *>(data), chunk);
+      data += chunk;
+      length -= chunk;
+   }
+   return static_cast<pdk::puint32>(crc);
+#else
+   // bitwise, only builds without zlib get here and they only read
+   // stored entries
+   pdk::puint32 crc = 0xffffffff;
+   for (pdk::pint64 i = 0; i < length; ++i) {
+      crc ^= static_cast<uchar>(data[i]);
+      for (int bit = 0; bit < 8; ++bit) {
+         crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+      }
+   }
+   return ~crc;
+#endif
+}
+
+} // anonymous namespace
+
+bool ArchivePrivate::checkCrc32(const ArchiveEntry &entry, const ByteArray &data)
+{
+   if (compute_crc32(data.getConstRawData(), data.size()) == entry.getCrc32()) {
+      return true;
+   }
+   warning_stream("Archive::readEntry: Crc-32 mismatch in %s", entry.getName().toUtf8().getConstRawData());
+   return false;
+}
+
+ArchivePrivate::ArchivePrivate(const String &fileName)
+   : m_file(fileName),
+     m_data(nullptr),
+     m_size(0)
+{}
+
+ArchivePrivate::~ArchivePrivate()
+{}
+
+bool ArchivePrivate::map()
+{
+   if (!m_file.open(IoDevice::OpenMode::ReadOnly)) {
+      m_errorString = m_file.getErrorString();
+      return false;
+   }
+   m_size = m_file.getSize();
+   if (m_size == 0) {
+      m_errorString = Latin1String("The archive is empty");
+      return false;
+   }
+   m_data = m_file.map(0, m_size);
+   if (!m_data) {
+      m_errorString = m_file.getErrorString();
+      return false;
+   }
+   return true;
+}
+
+void ArchivePrivate::unmap()
+{
+   // the file stays open while mapped, the engine keeps track of the
+   // mapping and needs the descriptor to release it
+   if (m_data) {
+      m_file.unmap(const_cast<uchar *>(m_data));
+   }
+   m_file.close();
+   m_data = nullptr;
+   m_size = 0;
+}
+
+void ArchivePrivate::reset()
+{
+   m_index.clear();
+   std::vector<ArchiveEntry>().swap(m_entries);
+   unmap();
+}
+
+void ArchivePrivate::addEntry(const char *name, int nameLength, ArchiveEntry::Method method,
+                              pdk::puint32 crc32, pdk::pint64 size, pdk::pint64 compressedSize,
+                              pdk::pint64 headerOffset, pdk::pint64 dataOffset)
+{
+   m_entries.emplace_back();
+   ArchiveEntry &entry = m_entries.back();
+   entry.m_name = name;
+   entry.m_nameLength = nameLength;
+   entry.m_method = method;
+   entry.m_crc32 = crc32;
+   entry.m_size = size;
+   entry.m_compressedSize = compressedSize;
+   entry.m_headerOffset = headerOffset;
+   entry.m_dataOffset = dataOffset;
+}
+
+void ArchivePrivate::buildIndex()
+{
+   m_index.reserve(m_entries.size());
+   for (size_t i = 0; i < m_entries.size(); ++i) {
+      const ArchiveEntry &entry = m_entries[i];
+      // a later entry with the same name wins, like unzip does
+      m_index[std::string_view(entry.m_name, entry.m_nameLength)] = static_cast<int>(i);
+   }
+}
+
+pdk::pint64 ArchivePrivate::getDataOffset(const ArchiveEntry &entry) const
+{
+   if (entry.m_dataOffset < 0 && entry.m_headerOffset >= 0) {
+      // zip local header, the name and extra field lengths may differ
+      // from the ones in the central directory
+      const pdk::pint64 offset = entry.m_headerOffset;
+      if (isInside(offset, 30) && pdk::from_little_endian<pdk::puint32>(m_data + offset) == 0x04034b50) {
+         entry.m_dataOffset = offset + 30 +
+               pdk::from_little_endian<pdk::puint16>(m_data + offset + 26) +
+               pdk::from_little_endian<pdk::puint16>(m_data + offset + 28);
+      }
+   }
+   if (!isInside(entry.m_dataOffset, entry.m_compressedSize)) {
+      return -1;
+   }
+   return entry.m_dataOffset;
+}
+
+} // internal
+
+Archive::Archive(ArchivePrivate &dd)
+   : m_implPtr(&dd)
+{}
+
+Archive::~Archive()
+{
+   close();
+}
+
+bool Archive::open()
+{
+   PDK_D(Archive);
+   if (isOpen()) {
+      return true;
+   }
+   implPtr->m_errorString.clear();
+   if (!implPtr->map() || !implPtr->readDirectory()) {
+      implPtr->reset();
+      return false;
+   }
+   implPtr->buildIndex();
+   return true;
+}
+
+void Archive::close()
+{
+   PDK_D(Archive);
+   implPtr->reset();
+}
+
+bool Archive::isOpen() const
+{
+   PDK_D(const Archive);
+   return implPtr->m_data != nullptr;
+}
+
+String Archive::getFileName() const
+{
+   PDK_D(const Archive);
+   return implPtr->m_file.getFileName();
+}
+
+String Archive::getErrorString() const
+{
+   PDK_D(const Archive);
+   return implPtr->m_errorString;
+}
+
+int Archive::getEntryCount() const
+{
+   PDK_D(const Archive);
+   return static_cast<int>(implPtr->m_entries.size());
+}
+
+const ArchiveEntry &Archive::getEntry(int index) const
+{
+   PDK_D(const Archive);
+   PDK_ASSERT_X(index >= 0 && index < getEntryCount(), "Archive::getEntry", "index out of range");
+   return implPtr->m_entries[index];
+}
+
+const ArchiveEntry *Archive::findEntry(const String &name) const
+{
+   PDK_D(const Archive);
+   const ByteArray utf8 = name.toUtf8();
+   auto iter = implPtr->m_index.find(std::string_view(utf8.getConstRawData(), utf8.size()));
+   if (iter == implPtr->m_index.end()) {
+      return nullptr;
+   }
+   return &implPtr->m_entries[iter->second];
+}
+
+StringList Archive::getEntryNames() const
+{
+   PDK_D(const Archive);
+   StringList names;
+   for (const ArchiveEntry &entry : implPtr->m_entries) {
+      names.push_back(entry.getName());
+   }
+   return names;
+}
+
+ByteArray Archive::getRawData(const ArchiveEntry &entry) const
+{
+   PDK_D(const Archive);
+   const pdk::pint64 offset = implPtr->getDataOffset(entry);
+   if (offset < 0 || entry.getCompressedSize() > std::numeric_limits<int>::max()) {
+      return ByteArray();
+   }
+   return ByteArray::fromRawData(reinterpret_cast<const char *>(implPtr->m_data + offset),
+                                 static_cast<int>(entry.getCompressedSize()));
+}
+
+ByteArray Archive::readEntry(const String &name) const
+{
+   const ArchiveEntry *entry = findEntry(name);
+   if (!entry) {
+      return ByteArray();
+   }
+   if (entry->getMethod() == ArchiveEntry::Method::Stored) {
+      const ByteArray data = getRawData(*entry);
+      if (data.size() != entry->getSize() || !ArchivePrivate::checkCrc32(*entry, data)) {
+         return ByteArray();
+      }
+      return data;
+   }
+   if (entry->getMethod() != ArchiveEntry::Method::Deflated ||
+       entry->getSize() > std::numeric_limits<int>::max()) {
+      return ByteArray();
+   }
+   pdk::utils::ScopedPointer<IoDevice> device(openEntry(name));
+   if (!device) {
+      return ByteArray();
+   }
+   // the size comes from the directory, the data decides how much is there
+   ByteArray data(static_cast<int>(entry->getSize()), pdk::Uninitialized);
+   pdk::pint64 total = 0;
+   while (total < data.size()) {
+      const pdk::pint64 readBytes = device->read(data.getRawData() + total, data.size() - total);
+      if (readBytes <= 0) {
+         break;
+      }
+      total += readBytes;
+   }
+   if (total != data.size() || !device->atEnd()) {
+      warning_stream("Archive::readEntry: Entry size does not match the archive directory");
+      return ByteArray();
+   }
+   if (!ArchivePrivate::checkCrc32(*entry, data)) {
+      return ByteArray();
+   }
+   return data;
+}
+
+IoDevice *Archive::openEntry(const String &name, Object *parent) const
+{
+   const ArchiveEntry *entry = findEntry(name);
+   if (!entry || entry->getMethod() == ArchiveEntry::Method::Unsupported) {
+      return nullptr;
+   }
+   const ByteArray rawData = getRawData(*entry);
+   if (rawData.isNull()) {
+      return nullptr;
+   }
+   Buffer *buffer = new Buffer(parent);
+   // shares the mapped bytes, Buffer does not copy raw data
+   buffer->setData(rawData);
+   if (entry->getMethod() == ArchiveEntry::Method::Stored) {
+      buffer->open(IoDevice::OpenMode::ReadOnly);
+      return buffer;
+   }
+   InflateDevice *inflater = new InflateDevice(buffer, CompressionFormat::RawDeflate, parent);
+   buffer->setParent(inflater);
+   if (!inflater->open(IoDevice::OpenMode::ReadOnly)) {
+      delete inflater;
+      return nullptr;
+   }
+   return inflater;
+}
+
+} // compress
+} // pdk
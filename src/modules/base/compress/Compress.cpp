@@ -0,0 +1,190 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/compress/Compress.h"
+#include "pdk/base/compress/internal/CompressPrivate.h"
+#include "pdk/global/Logging.h"
+
+#if PDK_CONFIG(zlib)
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <climits>
+
+namespace pdk {
+namespace compress {
+
+using pdk::lang::Latin1String;
+
+namespace internal {
+
+int get_window_bits(CompressionFormat format, bool inflating)
+{
+   switch (format) {
+   case CompressionFormat::Gzip:
+      return 15 + 16;
+   case CompressionFormat::RawDeflate:
+      return -15;
+   case CompressionFormat::AutoDetect:
+      return inflating ? 15 + 32 : 15;
+   case CompressionFormat::Zlib:
+      break;
+   }
+   return 15;
+}
+
+String zlib_error_string(int errorCode, const char *message)
+{
+   if (message) {
+      return Latin1String(message);
+   }
+#if PDK_CONFIG(zlib)
+   switch (errorCode) {
+   case Z_MEM_ERROR:
+      return Latin1String("Not enough memory");
+   case Z_DATA_ERROR:
+   case Z_NEED_DICT:
+      return Latin1String("Input data is corrupted");
+   case Z_BUF_ERROR:
+      return Latin1String("Compressed data is truncated");
+   case Z_STREAM_ERROR:
+      return Latin1String("Invalid compression parameters");
+   default:
+      break;
+   }
+#else
+   PDK_UNUSED(errorCode);
+#endif
+   return Latin1String("Unknown compression error");
+}
+
+} // internal
+
+#if PDK_CONFIG(zlib)
+
+ByteArray compress(const char *data, int size, int level)
+{
+   if (size < 0 || (!data && size > 0)) {
+      warning_stream("compress: Data is null");
+      return ByteArray();
+   }
+   if (level < -1 || level > 9) {
+      level = -1;
+   }
+   const uLong bound = ::compressBound(static_cast<uLong>(size));
+   if (bound > static_cast<uLong>(INT_MAX - 4)) {
+      warning_stream("compress: Input is too large");
+      return ByteArray();
+   }
+   ByteArray result(static_cast<int>(bound) + 4, pdk::Initialization::Uninitialized);
+   uLongf length = bound;
+   Bytef *out = reinterpret_cast<Bytef *>(result.getRawData());
+   const int ret = ::compress2(out + 4, &length, reinterpret_cast<const Bytef *>(data),
+                               static_cast<uLong>(size), level);
+   if (ret != Z_OK) {
+      warning_stream("compress: %s", internal::zlib_error_string(ret, nullptr).toLatin1().getConstRawData());
+      return ByteArray();
+   }
+   const pdk::puint32 expected = static_cast<pdk::puint32>(size);
+   out[0] = static_cast<Bytef>(expected >> 24);
+   out[1] = static_cast<Bytef>(expected >> 16);
+   out[2] = static_cast<Bytef>(expected >> 8);
+   out[3] = static_cast<Bytef>(expected);
+   result.resize(static_cast<int>(length) + 4);
+   return result;
+}
+
+ByteArray uncompress(const char *data, int size)
+{
+   if (!data) {
+      warning_stream("uncompress: Data is null");
+      return ByteArray();
+   }
+   if (size <= 4) {
+      if (size < 4 || (data[0] != 0 || data[1] != 0 || data[2] != 0 || data[3] != 0)) {
+         warning_stream("uncompress: Input data is corrupted");
+      }
+      return ByteArray();
+   }
+   const uchar *header = reinterpret_cast<const uchar *>(data);
+   const pdk::puint32 expected = (pdk::puint32(header[0]) << 24) | (pdk::puint32(header[1]) << 16) |
+         (pdk::puint32(header[2]) << 8) | pdk::puint32(header[3]);
+   if (expected > static_cast<pdk::puint32>(INT_MAX)) {
+      warning_stream("uncompress: Input data is corrupted");
+      return ByteArray();
+   }
+   z_stream stream;
+   stream.zalloc = Z_NULL;
+   stream.zfree = Z_NULL;
+   stream.opaque = Z_NULL;
+   stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data + 4));
+   stream.avail_in = static_cast<uInt>(size - 4);
+   if (::inflateInit(&stream) != Z_OK) {
+      warning_stream("uncompress: Not enough memory");
+      return ByteArray();
+   }
+   // the header only hints at the size, a corrupted one must not make us
+   // allocate gigabytes up front
+   const int hardLimit = INT_MAX;
+   int capacity = static_cast<int>(std::min<pdk::puint32>(std::max<pdk::puint32>(expected, 1), 1 << 26));
+   ByteArray result(capacity, pdk::Initialization::Uninitialized);
+   int ret;
+   do {
+      if (static_cast<int>(stream.total_out) == capacity) {
+         if (capacity == hardLimit) {
+            ret = Z_MEM_ERROR;
+            break;
+         }
+         capacity = capacity > hardLimit / 2 ? hardLimit : capacity * 2;
+         result.resize(capacity);
+      }
+      stream.next_out = reinterpret_cast<Bytef *>(result.getRawData()) + stream.total_out;
+      stream.avail_out = static_cast<uInt>(capacity - static_cast<int>(stream.total_out));
+      ret = ::inflate(&stream, Z_NO_FLUSH);
+   } while (ret == Z_OK);
+   const int length = static_cast<int>(stream.total_out);
+   ::inflateEnd(&stream);
+   if (ret != Z_STREAM_END) {
+      warning_stream("uncompress: %s", internal::zlib_error_string(ret, nullptr).toLatin1().getConstRawData());
+      return ByteArray();
+   }
+   result.resize(length);
+   return result;
+}
+
+#else
+
+ByteArray compress(const char *data, int size, int level)
+{
+   PDK_UNUSED(data);
+   PDK_UNUSED(size);
+   PDK_UNUSED(level);
+   warning_stream("compress: pdk built without zlib support");
+   return ByteArray();
+}
+
+ByteArray uncompress(const char *data, int size)
+{
+   PDK_UNUSED(data);
+   PDK_UNUSED(size);
+   warning_stream("uncompress: pdk built without zlib support");
+   return ByteArray();
+}
+
+#endif // PDK_CONFIG(zlib)
+
+} // compress
+} // pdk
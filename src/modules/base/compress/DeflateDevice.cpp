@@ -0,0 +1,278 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/compress/DeflateDevice.h"
+#include "pdk/base/compress/internal/CompressPrivate.h"
+#include "pdk/base/io/internal/IoDevicePrivate.h"
+#include "pdk/global/Logging.h"
+
+#if PDK_CONFIG(zlib)
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace pdk {
+namespace compress {
+
+using pdk::lang::Latin1String;
+
+namespace internal {
+
+using pdk::io::internal::IoDevicePrivate;
+
+class DeflateDevicePrivate : public IoDevicePrivate
+{
+   PDK_DECLARE_PUBLIC(DeflateDevice);
+public:
+   DeflateDevicePrivate()
+      : m_device(nullptr),
+        m_format(CompressionFormat::Zlib),
+        m_level(-1),
+        m_streamInitialized(false),
+        m_totalIn(0),
+        m_totalOut(0)
+   {}
+
+   bool deflateChunks(int flushMode);
+   void endStream();
+
+   IoDevice *m_device;
+   CompressionFormat m_format;
+   int m_level;
+#if PDK_CONFIG(zlib)
+   z_stream m_stream;
+#endif
+   bool m_streamInitialized;
+   pdk::pint64 m_totalIn;
+   pdk::pint64 m_totalOut;
+   // the only output buffer, every filled chunk goes straight to the device
+   std::vector<char> m_chunk;
+};
+
+#if PDK_CONFIG(zlib)
+
+bool DeflateDevicePrivate::deflateChunks(int flushMode)
+{
+   PDK_Q(DeflateDevice);
+   while (true) {
+      m_stream.next_out = reinterpret_cast<Bytef *>(m_chunk.data());
+      m_stream.avail_out = CompressChunkSize;
+      const int ret = ::deflate(&m_stream, flushMode);
+      if (ret == Z_STREAM_ERROR) {
+         apiPtr->setErrorString(zlib_error_string(ret, m_stream.msg));
+         return false;
+      }
+      const int produced = CompressChunkSize - static_cast<int>(m_stream.avail_out);
+      if (produced > 0) {
+         if (m_device->write(m_chunk.data(), produced) != produced) {
+            apiPtr->setErrorString(m_device->getErrorString());
+            return false;
+         }
+         m_totalOut += produced;
+      }
+      if (flushMode == Z_FINISH) {
+         if (ret == Z_STREAM_END) {
+            return true;
+         }
+      } else if (m_stream.avail_out != 0) {
+         // deflate() only leaves output space once it consumed the input
+         return true;
+      }
+   }
+}
+
+void DeflateDevicePrivate::endStream()
+{
+   if (m_streamInitialized) {
+      m_stream.next_in = nullptr;
+      m_stream.avail_in = 0;
+      deflateChunks(Z_FINISH);
+      ::deflateEnd(&m_stream);
+      m_streamInitialized = false;
+   }
+}
+
+#else
+
+bool DeflateDevicePrivate::deflateChunks(int flushMode)
+{
+   PDK_UNUSED(flushMode);
+   return false;
+}
+
+void DeflateDevicePrivate::endStream()
+{
+}
+
+#endif // PDK_CONFIG(zlib)
+
+} // internal
+
+DeflateDevice::DeflateDevice(IoDevice *device, CompressionFormat format, int level, Object *parent)
+   : IoDevice(*new DeflateDevicePrivate, parent)
+{
+   PDK_D(DeflateDevice);
+   implPtr->m_device = device;
+   // inflating is the only thing auto detection makes sense for
+   implPtr->m_format = format == CompressionFormat::AutoDetect ? CompressionFormat::Zlib : format;
+   implPtr->m_level = (level < -1 || level > 9) ? -1 : level;
+}
+
+DeflateDevice::~DeflateDevice()
+{
+   close();
+}
+
+IoDevice *DeflateDevice::getDevice() const
+{
+   PDK_D(const DeflateDevice);
+   return implPtr->m_device;
+}
+
+CompressionFormat DeflateDevice::getFormat() const
+{
+   PDK_D(const DeflateDevice);
+   return implPtr->m_format;
+}
+
+pdk::pint64 DeflateDevice::getTotalIn() const
+{
+   PDK_D(const DeflateDevice);
+   return implPtr->m_totalIn;
+}
+
+pdk::pint64 DeflateDevice::getTotalOut() const
+{
+   PDK_D(const DeflateDevice);
+   return implPtr->m_totalOut;
+}
+
+bool DeflateDevice::open(OpenModes mode)
+{
+   PDK_D(DeflateDevice);
+   if (isOpen()) {
+      warning_stream("DeflateDevice::open: Device already open");
+      return false;
+   }
+   if ((mode & OpenMode::ReadOnly) || !(mode & OpenMode::WriteOnly)) {
+      warning_stream("DeflateDevice::open: Only WriteOnly mode is supported");
+      return false;
+   }
+   if (!implPtr->m_device) {
+      warning_stream("DeflateDevice::open: No target device");
+      return false;
+   }
+#if PDK_CONFIG(zlib)
+   if (!implPtr->m_device->isOpen() && !implPtr->m_device->open(OpenMode::WriteOnly)) {
+      setErrorString(implPtr->m_device->getErrorString());
+      return false;
+   }
+   if (!implPtr->m_device->isWritable()) {
+      setErrorString(Latin1String("The target device is not writable"));
+      return false;
+   }
+   z_stream &stream = implPtr->m_stream;
+   stream.zalloc = Z_NULL;
+   stream.zfree = Z_NULL;
+   stream.opaque = Z_NULL;
+   const int ret = ::deflateInit2(&stream, implPtr->m_level, Z_DEFLATED,
+                                  internal::get_window_bits(implPtr->m_format, false),
+                                  8, Z_DEFAULT_STRATEGY);
+   if (ret != Z_OK) {
+      setErrorString(internal::zlib_error_string(ret, stream.msg));
+      return false;
+   }
+   implPtr->m_streamInitialized = true;
+   implPtr->m_chunk.resize(internal::CompressChunkSize);
+   implPtr->m_totalIn = 0;
+   implPtr->m_totalOut = 0;
+   return IoDevice::open(mode);
+#else
+   setErrorString(Latin1String("pdk built without zlib support"));
+   return false;
+#endif
+}
+
+void DeflateDevice::close()
+{
+   PDK_D(DeflateDevice);
+   if (!isOpen()) {
+      return;
+   }
+   implPtr->endStream();
+   // the buffer is only needed while the stream is open
+   std::vector<char>().swap(implPtr->m_chunk);
+   IoDevice::close();
+}
+
+bool DeflateDevice::isSequential() const
+{
+   return true;
+}
+
+bool DeflateDevice::flush()
+{
+#if PDK_CONFIG(zlib)
+   PDK_D(DeflateDevice);
+   if (!implPtr->m_streamInitialized) {
+      return false;
+   }
+   implPtr->m_stream.next_in = nullptr;
+   implPtr->m_stream.avail_in = 0;
+   return implPtr->deflateChunks(Z_SYNC_FLUSH);
+#else
+   return false;
+#endif
+}
+
+pdk::pint64 DeflateDevice::readData(char *data, pdk::pint64 maxLength)
+{
+   PDK_UNUSED(data);
+   PDK_UNUSED(maxLength);
+   return -1;
+}
+
+pdk::pint64 DeflateDevice::writeData(const char *data, pdk::pint64 length)
+{
+#if PDK_CONFIG(zlib)
+   PDK_D(DeflateDevice);
+   if (!implPtr->m_streamInitialized) {
+      return -1;
+   }
+   pdk::pint64 remaining = length;
+   while (remaining > 0) {
+      // avail_in is only 32 bits wide
+      const uInt piece = static_cast<uInt>(std::min<pdk::pint64>(remaining, 1 << 30));
+      implPtr->m_stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data));
+      implPtr->m_stream.avail_in = piece;
+      if (!implPtr->deflateChunks(Z_NO_FLUSH)) {
+         return -1;
+      }
+      data += piece;
+      remaining -= piece;
+   }
+   implPtr->m_totalIn += length;
+   return length;
+#else
+   PDK_UNUSED(data);
+   PDK_UNUSED(length);
+   return -1;
+#endif
+}
+
+} // compress
+} // pdk
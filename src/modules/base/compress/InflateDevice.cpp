@@ -0,0 +1,258 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/compress/InflateDevice.h"
+#include "pdk/base/compress/internal/CompressPrivate.h"
+#include "pdk/base/io/internal/IoDevicePrivate.h"
+#include "pdk/global/Logging.h"
+
+#if PDK_CONFIG(zlib)
+#include <zlib.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace pdk {
+namespace compress {
+
+using pdk::lang::Latin1String;
+
+namespace internal {
+
+using pdk::io::internal::IoDevicePrivate;
+
+class InflateDevicePrivate : public IoDevicePrivate
+{
+   PDK_DECLARE_PUBLIC(InflateDevice);
+public:
+   InflateDevicePrivate()
+      : m_device(nullptr),
+        m_format(CompressionFormat::AutoDetect),
+        m_streamInitialized(false),
+        m_streamEnd(false),
+        m_totalIn(0),
+        m_totalOut(0)
+   {}
+
+   bool fillInput();
+
+   IoDevice *m_device;
+   CompressionFormat m_format;
+#if PDK_CONFIG(zlib)
+   z_stream m_stream;
+#endif
+   bool m_streamInitialized;
+   bool m_streamEnd;
+   pdk::pint64 m_totalIn;
+   pdk::pint64 m_totalOut;
+   // compressed bytes read ahead from the source
+   std::vector<char> m_input;
+};
+
+#if PDK_CONFIG(zlib)
+
+bool InflateDevicePrivate::fillInput()
+{
+   PDK_Q(InflateDevice);
+   const pdk::pint64 readBytes = m_device->read(m_input.data(), CompressChunkSize);
+   if (readBytes > 0) {
+      m_stream.next_in = reinterpret_cast<Bytef *>(m_input.data());
+      m_stream.avail_in = static_cast<uInt>(readBytes);
+      m_totalIn += readBytes;
+      return true;
+   }
+   if (readBytes < 0 || m_device->atEnd()) {
+      // the source ran dry in the middle of the stream
+      apiPtr->setErrorString(zlib_error_string(Z_BUF_ERROR, nullptr));
+      m_streamEnd = true;
+   }
+   // otherwise a sequential source has nothing for us yet
+   return false;
+}
+
+#endif // PDK_CONFIG(zlib)
+
+} // internal
+
+InflateDevice::InflateDevice(IoDevice *device, CompressionFormat format, Object *parent)
+   : IoDevice(*new InflateDevicePrivate, parent)
+{
+   PDK_D(InflateDevice);
+   implPtr->m_device = device;
+   implPtr->m_format = format;
+}
+
+InflateDevice::~InflateDevice()
+{
+   close();
+}
+
+IoDevice *InflateDevice::getDevice() const
+{
+   PDK_D(const InflateDevice);
+   return implPtr->m_device;
+}
+
+CompressionFormat InflateDevice::getFormat() const
+{
+   PDK_D(const InflateDevice);
+   return implPtr->m_format;
+}
+
+pdk::pint64 InflateDevice::getTotalIn() const
+{
+   PDK_D(const InflateDevice);
+   return implPtr->m_totalIn;
+}
+
+pdk::pint64 InflateDevice::getTotalOut() const
+{
+   PDK_D(const InflateDevice);
+   return implPtr->m_totalOut;
+}
+
+bool InflateDevice::open(OpenModes mode)
+{
+   PDK_D(InflateDevice);
+   if (isOpen()) {
+      warning_stream("InflateDevice::open: Device already open");
+      return false;
+   }
+   if ((mode & OpenMode::WriteOnly) || !(mode & OpenMode::ReadOnly)) {
+      warning_stream("InflateDevice::open: Only ReadOnly mode is supported");
+      return false;
+   }
+   if (!implPtr->m_device) {
+      warning_stream("InflateDevice::open: No source device");
+      return false;
+   }
+#if PDK_CONFIG(zlib)
+   if (!implPtr->m_device->isOpen() && !implPtr->m_device->open(OpenMode::ReadOnly)) {
+      setErrorString(implPtr->m_device->getErrorString());
+      return false;
+   }
+   if (!implPtr->m_device->isReadable()) {
+      setErrorString(Latin1String("The source device is not readable"));
+      return false;
+   }
+   z_stream &stream = implPtr->m_stream;
+   stream.zalloc = Z_NULL;
+   stream.zfree = Z_NULL;
+   stream.opaque = Z_NULL;
+   stream.next_in = Z_NULL;
+   stream.avail_in = 0;
+   const int ret = ::inflateInit2(&stream, internal::get_window_bits(implPtr->m_format, true));
+   if (ret != Z_OK) {
+      setErrorString(internal::zlib_error_string(ret, stream.msg));
+      return false;
+   }
+   implPtr->m_streamInitialized = true;
+   implPtr->m_streamEnd = false;
+   implPtr->m_input.resize(internal::CompressChunkSize);
+   implPtr->m_totalIn = 0;
+   implPtr->m_totalOut = 0;
+   return IoDevice::open(mode);
+#else
+   setErrorString(Latin1String("pdk built without zlib support"));
+   return false;
+#endif
+}
+
+void InflateDevice::close()
+{
+   PDK_D(InflateDevice);
+   if (!isOpen()) {
+      return;
+   }
+#if PDK_CONFIG(zlib)
+   if (implPtr->m_streamInitialized) {
+      ::inflateEnd(&implPtr->m_stream);
+      implPtr->m_streamInitialized = false;
+   }
+#endif
+   std::vector<char>().swap(implPtr->m_input);
+   IoDevice::close();
+}
+
+bool InflateDevice::isSequential() const
+{
+   return true;
+}
+
+bool InflateDevice::atEnd() const
+{
+   PDK_D(const InflateDevice);
+   return !isOpen() || (implPtr->m_streamEnd && bytesAvailable() == 0);
+}
+
+pdk::pint64 InflateDevice::readData(char *data, pdk::pint64 maxLength)
+{
+#if PDK_CONFIG(zlib)
+   PDK_D(InflateDevice);
+   if (!implPtr->m_streamInitialized || implPtr->m_streamEnd) {
+      return -1;
+   }
+   z_stream &stream = implPtr->m_stream;
+   const uInt wanted = static_cast<uInt>(std::min<pdk::pint64>(maxLength, 1 << 30));
+   stream.next_out = reinterpret_cast<Bytef *>(data);
+   stream.avail_out = wanted;
+   bool failed = false;
+   while (stream.avail_out > 0) {
+      if (stream.avail_in == 0 && !implPtr->fillInput()) {
+         failed = implPtr->m_streamEnd;
+         break;
+      }
+      const int ret = ::inflate(&stream, Z_NO_FLUSH);
+      if (ret == Z_STREAM_END) {
+         // gzip files may hold several members back to back, appending
+         // to a compressed log produces exactly that
+         if (implPtr->m_format == CompressionFormat::Gzip &&
+             (stream.avail_in > 0 || !implPtr->m_device->atEnd())) {
+            ::inflateReset(&stream);
+            continue;
+         }
+         implPtr->m_streamEnd = true;
+         break;
+      }
+      if (ret != Z_OK && ret != Z_BUF_ERROR) {
+         setErrorString(internal::zlib_error_string(ret, stream.msg));
+         implPtr->m_streamEnd = true;
+         failed = true;
+         break;
+      }
+   }
+   const pdk::pint64 produced = wanted - stream.avail_out;
+   implPtr->m_totalOut += produced;
+   if (produced == 0 && (failed || implPtr->m_streamEnd)) {
+      return -1;
+   }
+   return produced;
+#else
+   PDK_UNUSED(data);
+   PDK_UNUSED(maxLength);
+   return -1;
+#endif
+}
+
+pdk::pint64 InflateDevice::writeData(const char *data, pdk::pint64 length)
+{
+   PDK_UNUSED(data);
+   PDK_UNUSED(length);
+   return -1;
+}
+
+} // compress
+} // pdk
@@ -0,0 +1,200 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/compress/phar/PharArchive.h"
+#include "pdk/base/compress/internal/ArchivePrivate.h"
+#include "pdk/global/Endian.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace pdk {
+namespace compress {
+namespace phar {
+namespace internal {
+
+using pdk::compress::internal::read_zip_directory;
+using pdk::lang::Latin1String;
+
+namespace {
+
+constexpr char PHAR_HALT_TOKEN[] = "__HALT_COMPILER();";
+constexpr int PHAR_HALT_TOKEN_SIZE = sizeof(PHAR_HALT_TOKEN) - 1;
+// native phars with a signature end with it
+constexpr char PHAR_SIGNATURE_MAGIC[] = "GBMB";
+constexpr pdk::puint32 ZIP_END_SIGNATURE = 0x06054b50;
+constexpr int ZIP_END_SIZE = 22;
+
+constexpr pdk::puint32 PHAR_ENTRY_COMPRESSED_GZ = 0x00001000;
+constexpr pdk::puint32 PHAR_ENTRY_COMPRESSED_BZ2 = 0x00002000;
+
+inline pdk::puint32 read_uint32(const uchar *data)
+{
+   return pdk::from_little_endian<pdk::puint32>(data);
+}
+
+} // anonymous namespace
+
+class PharArchivePrivate : public ArchivePrivate
+{
+public:
+   PharArchivePrivate(const String &fileName)
+      : ArchivePrivate(fileName),
+        m_alias(nullptr),
+        m_aliasLength(0)
+   {}
+
+   bool readDirectory() override;
+   bool isZipBased() const;
+   bool readManifest();
+
+   const char *m_alias;
+   int m_aliasLength;
+};
+
+bool PharArchivePrivate::isZipBased() const
+{
+   const pdk::pint64 signatureOffset = m_size - 4;
+   if (signatureOffset >= 0 && std::memcmp(m_data + signatureOffset, PHAR_SIGNATURE_MAGIC, 4) == 0) {
+      return false;
+   }
+   // zip based phars are written without an archive comment
+   const pdk::pint64 endOffset = m_size - ZIP_END_SIZE;
+   return endOffset >= 0 && read_uint32(m_data + endOffset) == ZIP_END_SIGNATURE;
+}
+
+bool PharArchivePrivate::readDirectory()
+{
+   m_alias = nullptr;
+   m_aliasLength = 0;
+   if (isZipBased()) {
+      return read_zip_directory(*this);
+   }
+   return readManifest();
+}
+
+bool PharArchivePrivate::readManifest()
+{
+   // the stub is small compared to the archive, the search stops there
+   const char *begin = reinterpret_cast<const char *>(m_data);
+   const char *end = begin + m_size;
+   const char *halt = std::search(begin, end, PHAR_HALT_TOKEN, PHAR_HALT_TOKEN + PHAR_HALT_TOKEN_SIZE);
+   if (halt == end) {
+      m_errorString = Latin1String("The archive is neither a native nor a zip based phar");
+      return false;
+   }
+   pdk::pint64 offset = halt - begin + PHAR_HALT_TOKEN_SIZE;
+   // the token may be followed by " ?>" and a line break
+   if (isInside(offset, 3) && std::memcmp(m_data + offset, " ?>", 3) == 0) {
+      offset += 3;
+   }
+   if (isInside(offset, 1) && m_data[offset] == '\r') {
+      ++offset;
+   }
+   if (isInside(offset, 1) && m_data[offset] == '\n') {
+      ++offset;
+   }
+   // manifest length, entry count, api version, flags and alias length
+   if (!isInside(offset, 18)) {
+      m_errorString = Latin1String("The phar manifest is truncated");
+      return false;
+   }
+   const pdk::pint64 manifestLength = read_uint32(m_data + offset);
+   const pdk::pint64 manifestEnd = offset + 4 + manifestLength;
+   const pdk::puint32 entryCount = read_uint32(m_data + offset + 4);
+   offset += 14;
+   if (!isInside(offset, manifestEnd - offset)) {
+      m_errorString = Latin1String("The phar manifest is truncated");
+      return false;
+   }
+   // reads a length prefixed field of the manifest
+   auto readField = [&](const char *&field, pdk::pint64 &length) -> bool {
+      if (manifestEnd - offset < 4) {
+         return false;
+      }
+      length = read_uint32(m_data + offset);
+      offset += 4;
+      if (manifestEnd - offset < length) {
+         return false;
+      }
+      field = reinterpret_cast<const char *>(m_data + offset);
+      offset += length;
+      return true;
+   };
+   const char *field = nullptr;
+   pdk::pint64 fieldLength = 0;
+   pdk::pint64 aliasLength = 0;
+   // the global metadata is skipped, so is the metadata of each entry
+   if (!readField(m_alias, aliasLength) || aliasLength > 0xffff || !readField(field, fieldLength)) {
+      m_errorString = Latin1String("The phar manifest is corrupt");
+      return false;
+   }
+   m_aliasLength = static_cast<int>(aliasLength);
+   // every entry takes at least 24 bytes, guards the reservation below
+   if (entryCount > (manifestEnd - offset) / 24) {
+      m_errorString = Latin1String("The phar manifest is corrupt");
+      return false;
+   }
+   m_entries.reserve(entryCount);
+   // the entry data follows the manifest in manifest order
+   pdk::pint64 dataOffset = manifestEnd;
+   for (pdk::puint32 i = 0; i < entryCount; ++i) {
+      const char *name = nullptr;
+      pdk::pint64 nameLength = 0;
+      if (!readField(name, nameLength) || nameLength > 0xffff || manifestEnd - offset < 20) {
+         m_errorString = Latin1String("The phar manifest is corrupt");
+         return false;
+      }
+      const uchar *record = m_data + offset;
+      const pdk::pint64 size = read_uint32(record);
+      const pdk::pint64 compressedSize = read_uint32(record + 8);
+      const pdk::puint32 crc32 = read_uint32(record + 12);
+      const pdk::puint32 flags = read_uint32(record + 16);
+      offset += 20;
+      if (!readField(field, fieldLength) || !isInside(dataOffset, compressedSize)) {
+         m_errorString = Latin1String("The phar manifest is corrupt");
+         return false;
+      }
+      // phar deflates without zlib framing, the same way zip does
+      ArchiveEntry::Method method = ArchiveEntry::Method::Stored;
+      if (flags & PHAR_ENTRY_COMPRESSED_BZ2) {
+         method = ArchiveEntry::Method::Unsupported;
+      } else if (flags & PHAR_ENTRY_COMPRESSED_GZ) {
+         method = ArchiveEntry::Method::Deflated;
+      }
+      addEntry(name, static_cast<int>(nameLength), method, crc32, size, compressedSize, -1, dataOffset);
+      dataOffset += compressedSize;
+   }
+   return true;
+}
+
+} // internal
+
+PharArchive::PharArchive(const String &fileName)
+   : Archive(*new PharArchivePrivate(fileName))
+{}
+
+PharArchive::~PharArchive()
+{}
+
+String PharArchive::getAlias() const
+{
+   PDK_D(const PharArchive);
+   return String::fromUtf8(implPtr->m_alias, implPtr->m_aliasLength);
+}
+
+} // phar
+} // compress
+} // pdk
@@ -0,0 +1,234 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/compress/zip/ZipArchive.h"
+#include "pdk/base/compress/internal/ArchivePrivate.h"
+#include "pdk/global/Endian.h"
+
+#include <algorithm>
+
+namespace pdk {
+namespace compress {
+
+using pdk::lang::Latin1String;
+
+namespace internal {
+
+namespace {
+
+constexpr pdk::puint32 ZIP_CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+constexpr pdk::puint32 ZIP_END_SIGNATURE = 0x06054b50;
+constexpr pdk::puint32 ZIP64_END_SIGNATURE = 0x06064b50;
+constexpr pdk::puint32 ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+
+constexpr int ZIP_CENTRAL_HEADER_SIZE = 46;
+constexpr int ZIP_END_SIZE = 22;
+constexpr int ZIP64_END_SIZE = 56;
+constexpr int ZIP64_LOCATOR_SIZE = 20;
+// the end record is followed by a comment of at most 64k
+constexpr int ZIP_MAX_COMMENT_SIZE = 0xffff;
+
+constexpr pdk::puint16 ZIP_FLAG_ENCRYPTED = 0x0001;
+constexpr pdk::puint16 ZIP_METHOD_STORED = 0;
+constexpr pdk::puint16 ZIP_METHOD_DEFLATED = 8;
+constexpr pdk::puint16 ZIP64_EXTRA_FIELD_ID = 0x0001;
+
+inline pdk::puint16 read_uint16(const uchar *data)
+{
+   return pdk::from_little_endian<pdk::puint16>(data);
+}
+
+inline pdk::puint32 read_uint32(const uchar *data)
+{
+   return pdk::from_little_endian<pdk::puint32>(data);
+}
+
+inline pdk::puint64 read_uint64(const uchar *data)
+{
+   return pdk::from_little_endian<pdk::puint64>(data);
+}
+
+pdk::pint64 find_end_record(const ArchivePrivate &archive)
+{
+   if (archive.m_size < ZIP_END_SIZE) {
+      return -1;
+   }
+   const pdk::pint64 last = archive.m_size - ZIP_END_SIZE;
+   const pdk::pint64 first = std::max<pdk::pint64>(0, last - ZIP_MAX_COMMENT_SIZE);
+   // only the tail of the file is touched, searching backwards finds
+   // the real record before any signature bytes inside the comment
+   for (pdk::pint64 offset = last; offset >= first; --offset) {
+      if (archive.m_data[offset] == 0x50 && read_uint32(archive.m_data + offset) == ZIP_END_SIGNATURE &&
+          offset + ZIP_END_SIZE + read_uint16(archive.m_data + offset + 20) <= archive.m_size) {
+         return offset;
+      }
+   }
+   return -1;
+}
+
+// replaces the 32 bit values saturated to 0xffffffff by the ones stored
+// in the zip64 extra field, the field only lists the saturated values
+bool read_zip64_extra(const uchar *extra, int length, pdk::pint64 &size,
+                      pdk::pint64 &compressedSize, pdk::pint64 &headerOffset)
+{
+   const uchar *end = extra + length;
+   while (end - extra >= 4) {
+      const pdk::puint16 id = read_uint16(extra);
+      const pdk::puint16 fieldLength = read_uint16(extra + 2);
+      const uchar *field = extra + 4;
+      if (end - field < fieldLength) {
+         return false;
+      }
+      if (id == ZIP64_EXTRA_FIELD_ID) {
+         const uchar *fieldEnd = field + fieldLength;
+         for (pdk::pint64 *value : {&size, &compressedSize, &headerOffset}) {
+            if (*value != 0xffffffff) {
+               continue;
+            }
+            if (fieldEnd - field < 8) {
+               return false;
+            }
+            *value = static_cast<pdk::pint64>(read_uint64(field));
+            field += 8;
+         }
+         return true;
+      }
+      extra = field + fieldLength;
+   }
+   return true;
+}
+
+} // anonymous namespace
+
+bool read_zip_directory(ArchivePrivate &archive)
+{
+   const uchar *data = archive.m_data;
+   const pdk::pint64 endOffset = find_end_record(archive);
+   if (endOffset < 0) {
+      archive.m_errorString = Latin1String("The end of central directory record is missing");
+      return false;
+   }
+   const uchar *end = data + endOffset;
+   if (read_uint16(end + 4) != 0 || read_uint16(end + 6) != 0) {
+      archive.m_errorString = Latin1String("Archives spanning several disks are not supported");
+      return false;
+   }
+   pdk::pint64 entryCount = read_uint16(end + 10);
+   pdk::pint64 directorySize = read_uint32(end + 12);
+   pdk::pint64 directoryOffset = read_uint32(end + 16);
+   // where the directory record is found, differs from directoryOffset
+   // when data was prepended to the archive, like the stub of a phar
+   pdk::pint64 directoryStart = endOffset - directorySize;
+   const pdk::pint64 locatorOffset = endOffset - ZIP64_LOCATOR_SIZE;
+   if (locatorOffset >= 0 && read_uint32(data + locatorOffset) == ZIP64_LOCATOR_SIGNATURE) {
+      const uchar *locator = data + locatorOffset;
+      if (read_uint32(locator + 4) != 0 || read_uint32(locator + 16) > 1) {
+         archive.m_errorString = Latin1String("Archives spanning several disks are not supported");
+         return false;
+      }
+      // the locator may point into the prepended data as well, the zip64
+      // record sits right in front of the locator in archives we can read
+      const pdk::pint64 recordOffset = locatorOffset - ZIP64_END_SIZE;
+      if (recordOffset < 0 || read_uint32(data + recordOffset) != ZIP64_END_SIGNATURE) {
+         archive.m_errorString = Latin1String("The zip64 end of central directory record is corrupt");
+         return false;
+      }
+      const uchar *record = data + recordOffset;
+      entryCount = static_cast<pdk::pint64>(read_uint64(record + 32));
+      directorySize = static_cast<pdk::pint64>(read_uint64(record + 40));
+      directoryOffset = static_cast<pdk::pint64>(read_uint64(record + 48));
+      directoryStart = recordOffset - directorySize;
+   }
+   if (directorySize < 0 || directoryOffset < 0 || directoryStart < 0 ||
+       directoryStart < directoryOffset ||
+       entryCount > directorySize / ZIP_CENTRAL_HEADER_SIZE) {
+      archive.m_errorString = Latin1String("The central directory is corrupt");
+      return false;
+   }
+   const pdk::pint64 bias = directoryStart - directoryOffset;
+   archive.m_entries.reserve(static_cast<size_t>(entryCount));
+   const uchar *header = data + directoryStart;
+   const uchar *directoryEnd = header + directorySize;
+   for (pdk::pint64 i = 0; i < entryCount; ++i) {
+      if (directoryEnd - header < ZIP_CENTRAL_HEADER_SIZE ||
+          read_uint32(header) != ZIP_CENTRAL_HEADER_SIGNATURE) {
+         archive.m_errorString = Latin1String("The central directory is corrupt");
+         return false;
+      }
+      const pdk::puint16 flags = read_uint16(header + 8);
+      const pdk::puint16 method = read_uint16(header + 10);
+      const pdk::puint32 crc32 = read_uint32(header + 16);
+      pdk::pint64 compressedSize = read_uint32(header + 20);
+      pdk::pint64 size = read_uint32(header + 24);
+      const int nameLength = read_uint16(header + 28);
+      const int extraLength = read_uint16(header + 30);
+      const int commentLength = read_uint16(header + 32);
+      pdk::pint64 headerOffset = read_uint32(header + 42);
+      const uchar *name = header + ZIP_CENTRAL_HEADER_SIZE;
+      const uchar *next = name + nameLength + extraLength + commentLength;
+      if (next > directoryEnd ||
+          !read_zip64_extra(name + nameLength, extraLength, size, compressedSize, headerOffset) ||
+          size < 0 || compressedSize < 0 || headerOffset < 0) {
+         archive.m_errorString = Latin1String("The central directory is corrupt");
+         return false;
+      }
+      ArchiveEntry::Method entryMethod = ArchiveEntry::Method::Unsupported;
+      if (!(flags & ZIP_FLAG_ENCRYPTED)) {
+         if (method == ZIP_METHOD_STORED) {
+            entryMethod = ArchiveEntry::Method::Stored;
+         } else if (method == ZIP_METHOD_DEFLATED) {
+            entryMethod = ArchiveEntry::Method::Deflated;
+         }
+      }
+      // the local header is only read when the entry data is asked for
+      archive.addEntry(reinterpret_cast<const char *>(name), nameLength, entryMethod,
+                       crc32, size, compressedSize, headerOffset + bias, -1);
+      header = next;
+   }
+   return true;
+}
+
+} // internal
+
+namespace zip {
+namespace internal {
+
+using pdk::compress::internal::read_zip_directory;
+
+class ZipArchivePrivate : public ArchivePrivate
+{
+public:
+   ZipArchivePrivate(const String &fileName)
+      : ArchivePrivate(fileName)
+   {}
+
+   bool readDirectory() override
+   {
+      return read_zip_directory(*this);
+   }
+};
+
+} // internal
+
+ZipArchive::ZipArchive(const String &fileName)
+   : Archive(*new ZipArchivePrivate(fileName))
+{}
+
+ZipArchive::~ZipArchive()
+{}
+
+} // zip
+} // compress
+} // pdk
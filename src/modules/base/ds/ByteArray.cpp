@@ -112,14 +112,15 @@ ByteArray &ByteArray::setNum(pdk::plonglong n, int base)
 {
    const int buffsize = 66; // big enough for MAX_ULLONG in base 2
    char buff[buffsize];
-   char *p;
    
-   if (n < 0 && base == 10) {
-      p = pdk_ulltoa2(buff + buffsize, pdk::pulonglong(-(1 + n)) + 1, base);
-      *--p = '-';
-   } else {
-      p = pdk_ulltoa2(buff + buffsize, pdk::pulonglong(n), base);
+   if (base == 10) {
+      const int length = pdk::utils::internal::pdk_lltoa_decimal(n, buff);
+      clear();
+      append(buff, length);
+      return *this;
    }
+   // other bases print the two's complement of negative numbers
+   char *p = pdk_ulltoa2(buff + buffsize, pdk::pulonglong(n), base);
    
    clear();
    append(p, buffsize - (p - buff));
@@ -130,6 +131,12 @@ ByteArray &ByteArray::setNum(pdk::pulonglong n, int base)
 {
    const int buffsize = 66; // big enough for MAX_ULLONG in base 2
    char buff[buffsize];
+   if (base == 10) {
+      const int length = pdk::utils::internal::pdk_ulltoa_decimal(n, buff);
+      clear();
+      append(buff, length);
+      return *this;
+   }
    char *p = pdk_ulltoa2(buff + buffsize, n, base);
    
    clear();
@@ -137,12 +144,27 @@ ByteArray &ByteArray::setNum(pdk::pulonglong n, int base)
    return *this;
 }
 
-// @TODO wait for locale
 ByteArray &ByteArray::setNum(double n, char f, int prec)
 {
-   std::string ret = std::to_string(n);
-   clear();
-   append(ret.data(), ret.size());
+   LocaleData::DoubleForm form = LocaleData::DoubleForm::DFDecimal;
+   LocaleData::Flags flags = LocaleData::Flag::ZeroPadExponent;
+   if (is_upper(f)) {
+      flags |= LocaleData::Flag::CapitalEorX;
+   }
+   switch (to_lower(f)) {
+   case 'f':
+      form = LocaleData::DoubleForm::DFDecimal;
+      break;
+   case 'e':
+      form = LocaleData::DoubleForm::DFExponent;
+      break;
+   case 'g':
+      form = LocaleData::DoubleForm::DFSignificantDigits;
+      break;
+   default:
+      break;
+   }
+   *this = LocaleData::c()->doubleToString(n, prec, form, -1, flags).toLatin1();
    return *this;
 }
 
@@ -1366,8 +1388,20 @@ pdk::pulonglong to_integral_helper(const char *data, bool *ok, int base, pdk::pu
    return LocaleData::bytearrayToUnsLongLong(data, base, ok);
 }
 
+bool to_integral_decimal(const ByteArray &text, pdk::plonglong &value)
+{
+   return pdk::utils::internal::pdk_strntoll_decimal(text.getConstRawData(), text.size(), value);
+}
+
+bool to_integral_decimal(const ByteArray &text, pdk::pulonglong &value)
+{
+   return pdk::utils::internal::pdk_strntoull_decimal(text.getConstRawData(), text.size(), value);
+}
+
+} // anonymous namespace
+
 template <typename T>
-inline T to_integral_helper(const char *data, bool *ok, int base)
+T ByteArray::toIntegralHelper(bool *ok, int base) const
 {
    typedef typename std::conditional<std::is_unsigned<T>::value, pdk::pulonglong, pdk::plonglong>::type Int64;
 #if defined(PDK_CHECK_RANGE)
@@ -1376,8 +1410,17 @@ inline T to_integral_helper(const char *data, bool *ok, int base)
       base = 10;
    }
 #endif
-   // we select the right overload by the last, unused parameter
-   Int64 val = to_integral_helper(data, ok, base, Int64());
+   Int64 val;
+   // plain decimals need neither strtoll nor a terminated copy
+   if (pdk::utils::internal::is_decimal_base(getConstRawData(), size(), base)
+       && to_integral_decimal(*this, val)) {
+      if (ok) {
+         *ok = true;
+      }
+   } else {
+      // we select the right overload by the last, unused parameter
+      val = to_integral_helper(getNullTerminated().getConstRawData(), ok, base, Int64());
+   }
    if (T(val) != val) {
       if (ok) {
          *ok = false;
@@ -1386,46 +1429,45 @@ inline T to_integral_helper(const char *data, bool *ok, int base)
    }
    return T(val);
 }
-} // anonymous namespace
 
 pdk::plonglong ByteArray::toLongLong(bool *ok, int base) const
 {
-   return to_integral_helper<pdk::plonglong>(getNullTerminated().getConstRawData(), ok, base);
+   return toIntegralHelper<pdk::plonglong>(ok, base);
 }
 
 pdk::pulonglong ByteArray::toULongLong(bool *ok, int base) const
 {
-   return to_integral_helper<pdk::pulonglong>(getNullTerminated().getConstRawData(), ok, base);
+   return toIntegralHelper<pdk::pulonglong>(ok, base);
 }
 
 int ByteArray::toInt(bool *ok, int base) const
 {
-   return to_integral_helper<int>(getNullTerminated().getConstRawData(), ok, base);
+   return toIntegralHelper<int>(ok, base);
 }
 
 uint ByteArray::toUInt(bool *ok, int base) const
 {
-   return to_integral_helper<uint>(getNullTerminated().getConstRawData(), ok, base);
+   return toIntegralHelper<uint>(ok, base);
 }
 
 long ByteArray::toLong(bool *ok, int base) const
 {
-   return to_integral_helper<long>(getNullTerminated().getConstRawData(), ok, base);
+   return toIntegralHelper<long>(ok, base);
 }
 
 ulong ByteArray::toULong(bool *ok, int base) const
 {
-   return to_integral_helper<ulong>(getNullTerminated().getConstRawData(), ok, base);
+   return toIntegralHelper<ulong>(ok, base);
 }
 
 short ByteArray::toShort(bool *ok, int base) const
 {
-   return to_integral_helper<short>(getNullTerminated().getConstRawData(), ok, base);
+   return toIntegralHelper<short>(ok, base);
 }
 
 ushort ByteArray::toUShort(bool *ok, int base) const
 {
-   return to_integral_helper<ushort>(getNullTerminated().getConstRawData(), ok, base);
+   return toIntegralHelper<ushort>(ok, base);
 }
 
 double ByteArray::toDouble(bool *ok) const
@@ -15,28 +15,84 @@
 
 #include "pdk/base/ds/internal/RingBufferPrivate.h"
 #include "pdk/base/ds/internal/ByteArrayPrivate.h"
+#include "pdk/utils/Funcs.h"
+
+#include <vector>
 
 namespace pdk {
 namespace ds {
 namespace internal {
 
 namespace {
-ByteArray &retrive_at(std::list<ByteArray> &array, size_t pos)
+
+// drained chunks of this thread, every ring buffer of the thread draws its
+// slabs from here before it asks the allocator
+struct ChunkPool
+{
+   ~ChunkPool()
+   {
+      sm_destroyed = true;
+   }
+   
+   std::vector<ByteArray> m_chunks;
+   pdk::pint64 m_bytes = 0;
+   static thread_local bool sm_destroyed;
+};
+
+thread_local bool ChunkPool::sm_destroyed = false;
+
+ChunkPool *chunk_pool()
+{
+   static const bool disabled = PDK_RING_BUFFER_POOL_SIZE <= 0 ||
+         pdk::env_var_isset("PDK_RING_BUFFER_NO_POOL");
+   if (disabled || ChunkPool::sm_destroyed) {
+      return nullptr;
+   }
+   static thread_local ChunkPool pool;
+   return &pool;
+}
+
+} // anonymous namespace
+
+ByteArray RingBuffer::allocateChunk(int size)
 {
-   PDK_ASSERT(pos >= 0 && pos < array.size());
-   auto iter = array.begin();
-   while (pos != 0) {
-      ++iter;  
-      --pos;
+   ChunkPool *pool = size == m_basicBlockSize ? chunk_pool() : nullptr;
+   if (pool) {
+      for (size_t i = pool->m_chunks.size(); i-- > 0;) {
+         if (pool->m_chunks[i].capacity() == size) {
+            if (i + 1 != pool->m_chunks.size()) {
+               pool->m_chunks[i].swap(pool->m_chunks.back());
+            }
+            ByteArray chunk(std::move(pool->m_chunks.back()));
+            pool->m_chunks.pop_back();
+            pool->m_bytes -= size;
+            chunk.resize(size);
+            return chunk;
+         }
+      }
    }
-   return *iter;
+   return ByteArray(size, pdk::Uninitialized);
 }
 
-const ByteArray &retrive_at(const std::list<ByteArray> &array, size_t pos)
+void RingBuffer::recycleChunk(ByteArray &chunk)
 {
-   return const_cast<const ByteArray &>(retrive_at(const_cast<std::list<ByteArray> &>(array), pos));
+   // only whole slabs nobody else refers to, a chunk handed out by read()
+   // or appended from outside is shared and simply released
+   const int capacity = chunk.capacity();
+   if (capacity == 0 || capacity != m_basicBlockSize || !chunk.isDetached()) {
+      return;
+   }
+   ChunkPool *pool = chunk_pool();
+   if (pool && pool->m_bytes + capacity <= PDK_RING_BUFFER_POOL_SIZE) {
+      pool->m_bytes += capacity;
+      pool->m_chunks.push_back(std::move(chunk));
+   }
 }
 
+int RingBuffer::getPooledChunkCount()
+{
+   ChunkPool *pool = chunk_pool();
+   return pool ? static_cast<int>(pool->m_chunks.size()) : 0;
 }
 
 const char *RingBuffer::readPointerAtPosition(pint64 pos, pint64 &length) const
@@ -44,10 +100,10 @@ const char *RingBuffer::readPointerAtPosition(pint64 pos, pint64 &length) const
    if (pos >= 0) {
       pos += m_head;
       for (size_t i = 0; i < m_buffers.size(); ++i) {
-         length = (i == static_cast<size_t>(m_tailBuffer) ? m_tail : retrive_at(m_buffers, i).size());
+         length = (i == static_cast<size_t>(m_tailBuffer) ? m_tail : m_buffers[i].size());
          if (length > pos) {
             length -= pos;
-            return retrive_at(m_buffers, i).getConstRawData() + pos;
+            return m_buffers[i].getConstRawData() + pos;
          }
          pos -= length;
       }
@@ -56,6 +112,56 @@ const char *RingBuffer::readPointerAtPosition(pint64 pos, pint64 &length) const
    return 0;
 }
 
+int RingBuffer::readSegments(const char **segments, pint64 *lengths, int maxSegments) const
+{
+   if (m_bufferSize == 0) {
+      return 0;
+   }
+   int count = 0;
+   for (size_t i = 0; count < maxSegments && i <= static_cast<size_t>(m_tailBuffer); ++i) {
+      const pdk::pint64 begin = (i == 0 ? m_head : 0);
+      const pdk::pint64 end = (i == static_cast<size_t>(m_tailBuffer) ? m_tail : m_buffers[i].size());
+      if (end > begin) {
+         segments[count] = m_buffers[i].getConstRawData() + begin;
+         lengths[count] = end - begin;
+         ++count;
+      }
+   }
+   return count;
+}
+
+const char *RingBuffer::linearize(pint64 length)
+{
+   if (length < 0 || length > m_bufferSize) {
+      return nullptr;
+   }
+   if (length <= nextDataBlockSize()) {
+      return readPointer();
+   }
+   // copy whole blocks, the chunk after them then starts at offset 0
+   pdk::pint64 copied = -m_head;
+   for (size_t i = 0; copied < length; ++i) {
+      copied += (i == static_cast<size_t>(m_tailBuffer) ? m_tail : m_buffers[i].size());
+   }
+   PDK_ASSERT(copied < MAX_BYTE_ARRAY_SIZE);
+   ByteArray chunk = allocateChunk(std::max(m_basicBlockSize, static_cast<int>(copied)));
+   peek(chunk.getRawData(), copied);
+   free(copied);
+   if (m_bufferSize == 0) {
+      // everything moved, the copy becomes the only block
+      recycleChunk(m_buffers.front());
+      m_buffers.front() = std::move(chunk);
+      m_tail = static_cast<int>(copied);
+   } else {
+      chunk.resize(static_cast<int>(copied));
+      m_buffers.push_front(std::move(chunk));
+      ++m_tailBuffer;
+   }
+   m_head = 0;
+   m_bufferSize += copied;
+   return m_buffers.front().getConstRawData();
+}
+
 void RingBuffer::free(pint64 bytes)
 {
    PDK_ASSERT(bytes <= m_bufferSize);
@@ -82,6 +188,7 @@ void RingBuffer::free(pint64 bytes)
       }
       m_bufferSize -= blockSize;
       bytes -= blockSize;
+      recycleChunk(m_buffers.front());
       m_buffers.pop_front();
       --m_tailBuffer;
       m_head = 0;
@@ -95,19 +202,22 @@ char *RingBuffer::reserve(pint64 bytes)
    }
    if (m_bufferSize == 0) {
       if (m_buffers.empty()) {
-         m_buffers.push_back(ByteArray(std::max(m_basicBlockSize, static_cast<int>(bytes)), pdk::Uninitialized));
+         m_buffers.push_back(allocateChunk(std::max(m_basicBlockSize, static_cast<int>(bytes))));
       } else {
          m_buffers.front().resize(std::max(m_basicBlockSize, static_cast<int>(bytes)));
       }
    } else {
       const pdk::pint64 newSize = bytes + m_tail;
-      // if need a new buffer
-      if (0 == m_basicBlockSize || (newSize > m_buffers.back().capacity() &&
-                                    (m_tail >= m_basicBlockSize || newSize >= MAX_BYTE_ARRAY_SIZE))) {
+      const int capacity = m_buffers.back().capacity();
+      // if need a new buffer, a full slab is never grown so that it
+      // stays recyclable
+      if (0 == m_basicBlockSize || (newSize > capacity &&
+                                    (m_tail >= m_basicBlockSize || capacity == m_basicBlockSize ||
+                                     newSize >= MAX_BYTE_ARRAY_SIZE))) {
          // shrink this buffer to its current size
          m_buffers.back().resize(m_tail);
          // create a new ByteArray
-         m_buffers.push_back(ByteArray(std::max(m_basicBlockSize, static_cast<int>(bytes)), pdk::Uninitialized));
+         m_buffers.push_back(allocateChunk(std::max(m_basicBlockSize, static_cast<int>(bytes))));
          ++m_tailBuffer;
          m_tail = 0;
       } else if(newSize > m_buffers.back().size()){
@@ -129,12 +239,12 @@ char *RingBuffer::reserveFront(pint64 bytes)
    if (m_head < bytes || m_basicBlockSize == 0) {
       if (m_head > 0) {
          m_buffers.front().remove(0, m_head);
-         if (m_tailBuffer) {
+         if (m_tailBuffer == 0) {
             m_tail -= m_head;
          }
       }
       m_head = std::max(m_basicBlockSize, static_cast<int>(bytes));
-      if (m_basicBlockSize == 0) {
+      if (m_bufferSize == 0) {
          if (m_buffers.empty()) {
             m_buffers.push_front(ByteArray(m_head, pdk::Uninitialized));
          } else {
@@ -142,7 +252,7 @@ char *RingBuffer::reserveFront(pint64 bytes)
          }
          m_tail = m_head;
       } else {
-         m_buffers.push_front(ByteArray(m_head, pdk::Uninitialized));
+         m_buffers.push_front(allocateChunk(m_head));
          ++m_tailBuffer;
       }
    }
@@ -176,6 +286,7 @@ void RingBuffer::chop(pint64 bytes)
       }
       m_bufferSize -= m_tail;
       bytes -= m_tail;
+      recycleChunk(m_buffers.back());
       m_buffers.pop_back();
       --m_tailBuffer;
       m_tail = m_buffers.back().size();
@@ -187,9 +298,10 @@ void RingBuffer::clear()
    if (m_buffers.empty()) {
       return;
    }
-   auto iter = m_buffers.begin();
-   ++iter;
-   m_buffers.erase(iter, m_buffers.end());
+   for (ByteArray &chunk : m_buffers) {
+      recycleChunk(chunk);
+   }
+   m_buffers.erase(m_buffers.begin() + 1, m_buffers.end());
    m_buffers.front().clear();
    m_head = 0;
    m_tail = 0;
@@ -204,9 +316,9 @@ pdk::pint64 RingBuffer::indexOf(char c, pint64 maxLength, pint64 pos) const
    }
    pdk::pint64 index = -(pos + m_head);
    for (size_t i = 0; i < m_buffers.size(); ++i) {
-      const pdk::pint64 nextBlockIndex = std::min(index + (i == static_cast<size_t>(m_tailBuffer) ? m_tail : retrive_at(m_buffers, i).size()), maxLength);
+      const pdk::pint64 nextBlockIndex = std::min(index + (i == static_cast<size_t>(m_tailBuffer) ? m_tail : m_buffers[i].size()), maxLength);
       if (nextBlockIndex > 0) {
-         const char *ptr = retrive_at(m_buffers, i).getConstRawData();
+         const char *ptr = m_buffers[i].getConstRawData();
          if (index < 0) {
             ptr -= index;
             index = 0;
@@ -269,10 +381,10 @@ pdk::pint64 RingBuffer::peek(char *data, pdk::pint64 maxLength, pdk::pint64 pos)
    if (pos >= 0) {
       pos += m_head;
       for (size_t i = 0; readSoFar < maxLength && i < m_buffers.size(); ++i) {
-         pdk::pint64 blockLength = (i == static_cast<size_t>(m_tailBuffer) ? m_tail : retrive_at(m_buffers, i).size());
+         pdk::pint64 blockLength = (i == static_cast<size_t>(m_tailBuffer) ? m_tail : m_buffers[i].size());
          if (pos < blockLength) {
             blockLength = std::min(blockLength - pos, maxLength - readSoFar);
-            std::memcpy(data + readSoFar, retrive_at(m_buffers, i).getConstRawData() + pos, blockLength);
+            std::memcpy(data + readSoFar, m_buffers[i].getConstRawData() + pos, blockLength);
             readSoFar += blockLength;
             pos = 0;
          } else {
@@ -300,6 +412,7 @@ void RingBuffer::append(const ByteArray &qba)
       if (m_buffers.empty()) {
          m_buffers.push_back(qba);
       } else {
+         recycleChunk(m_buffers.back());
          m_buffers.back() = qba;
       }
    } else {
@@ -27,9 +27,9 @@ const char pdkDefaultCategoryName[] = "default";
 
 PDK_GLOBAL_STATIC_WITH_ARGS(LoggingCategory, pdkDefaultCategory, (pdkDefaultCategoryName));
 
-#ifndef PDK_ATOMIC_INT8_IS_SUPPORTED
 namespace {
 
+#ifndef PDK_ATOMIC_INT8_IS_SUPPORTED
 void set_bool_lane(BasicAtomicInt *atomic, bool enable, int shift)
 {
    const int bit = 1 << shift;
@@ -39,19 +39,44 @@ void set_bool_lane(BasicAtomicInt *atomic, bool enable, int shift)
       atomic->fetchAndAndRelaxed(~bit);
    }
 }
+#endif
+
+uchar get_enabled_bit(pdk::MsgType type)
+{
+   switch (type) {
+   case pdk::MsgType::DebugMsg:
+      return LoggingCategory::DebugBit;
+   case pdk::MsgType::InfoMsg:
+      return LoggingCategory::InfoBit;
+   case pdk::MsgType::WarningMsg:
+      return LoggingCategory::WarningBit;
+   case pdk::MsgType::CriticalMsg:
+      return LoggingCategory::CriticalBit;
+   case pdk::MsgType::FatalMsg:
+      break;
+   }
+   return 0;
+}
 
 } // anonymous namespace
-#endif
 
 LoggingCategory::LoggingCategory(const char *category)
-   : m_data(nullptr),
+   : m_enabledBits(nullptr),
      m_name(nullptr)
 {
    init(category, pdk::MsgType::DebugMsg);
 }
 
 LoggingCategory::LoggingCategory(const char *category, pdk::MsgType enableForLevel)
-   : m_data(nullptr),
+   : m_enabledBits(nullptr),
+     m_name(nullptr)
+{
+   init(category, enableForLevel);
+}
+
+LoggingCategory::LoggingCategory(std::atomic<uchar> &enabledBits, const char *category,
+                                 pdk::MsgType enableForLevel)
+   : m_enabledBits(&enabledBits),
      m_name(nullptr)
 {
    init(category, enableForLevel);
@@ -68,6 +93,12 @@ void LoggingCategory::init(const char *category, pdk::MsgType severityLevel)
    if (LoggingRegistry *reg = LoggingRegistry::getInstance()) {
       reg->registerCategory(this, severityLevel);
    }
+   if (m_enabledBits) {
+      // a filter need not set every type, the bits follow what it left
+      m_enabledBits->store((isDebugEnabled() ? DebugBit : 0) | (isInfoEnabled() ? InfoBit : 0) |
+                           (isWarningEnabled() ? WarningBit : 0) | (isCriticalEnabled() ? CriticalBit : 0),
+                           std::memory_order_relaxed);
+   }
 }
 
 LoggingCategory::~LoggingCategory()
@@ -127,6 +158,16 @@ void LoggingCategory::setEnabled(pdk::MsgType type, bool enable)
    case pdk::MsgType::FatalMsg:
       break;
    }
+   // filter rules change one bit at a time, a check sees the old or the
+   // new state of it
+   if (m_enabledBits) {
+      const uchar bit = get_enabled_bit(type);
+      if (enable) {
+         m_enabledBits->fetch_or(bit, std::memory_order_relaxed);
+      } else {
+         m_enabledBits->fetch_and(static_cast<uchar>(~bit), std::memory_order_relaxed);
+      }
+   }
 }
 
 LoggingCategory *LoggingCategory::getDefaultCategory()
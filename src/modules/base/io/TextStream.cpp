@@ -24,6 +24,7 @@
 #include "pdk/base/ds/VarLengthArray.h"
 #include "pdk/kernel/StringUtils.h"
 #include "pdk/utils/internal/LocalePrivate.h"
+#include "pdk/utils/internal/LocaleToolsPrivate.h"
 #include <cctype>
 #include <locale.h>
 #include <cstdlib>
@@ -1079,6 +1080,18 @@ void TextStreamPrivate::putNumber(pdk::pulonglong number, bool negative)
    
    const LocaleData *dd = m_locale.m_implPtr->m_data;
    int base = m_params.m_integerBase ? m_params.m_integerBase : 10;
+   if (base == 10 && dd == LocaleData::c()
+       && !(flags & LocaleData::Flag::AlwaysShowSign) && !(flags & LocaleData::Flag::ThousandsGroup)) {
+      // plain c locale decimals go to the buffer without a String in between
+      char buffer[pdk::utils::internal::LONGLONG_DECIMAL_BUFFER_SIZE + 1];
+      int length = 0;
+      if (negative) {
+         buffer[length++] = '-';
+      }
+      length += pdk::utils::internal::pdk_ulltoa_decimal(number, buffer + length);
+      putString(Latin1String(buffer, length), true);
+      return;
+   }
    if (negative && base == 10) {
       result = dd->longLongToString(-static_cast<pdk::plonglong>(number), -1,
                                     base, -1, flags);
@@ -27,6 +27,11 @@
 #include "pdk/kernel/internal/SystemErrorPrivate.h"
 #include "pdk/kernel/CoreApplication.h"
 #include "pdk/kernel/internal/SystemErrorPrivate.h"
+#include "pdk/global/Logging.h"
+
+#ifdef PDK_OS_UNIX
+#include "pdk/base/io/fs/internal/AsyncFileEnginePrivate.h"
+#endif
 
 namespace pdk {
 namespace io {
@@ -38,10 +43,14 @@ using internal::FileSystemEntry;
 using internal::TemporaryFileName;
 using pdk::kernel::internal::SystemError;
 using pdk::lang::Latin1String;
+#ifdef PDK_OS_UNIX
+using internal::AsyncFileEngine;
+#endif
 
 namespace internal {
 
 FilePrivate::FilePrivate()
+   : m_asyncEngine(nullptr)
 {
 }
 
@@ -87,6 +96,49 @@ AbstractFileEngine *FilePrivate::getEngine() const
    return m_fileEngine;
 }
 
+int FilePrivate::submitAsyncIo(bool write, pdk::pint64 offset, char *data, pdk::pint64 size,
+                               const File::AsyncIoCallback &callback)
+{
+#ifdef PDK_OS_UNIX
+   PDK_Q(File);
+   const int fd = apiPtr->getHandle();
+   if (fd < 0) {
+      return -1;
+   }
+   AsyncFileEngine *engine = AsyncFileEngine::getInstance();
+   if (!engine) {
+      return -1;
+   }
+   if (!m_asyncIo) {
+      m_asyncIo = std::make_shared<AsyncIoTracker>();
+   } else if (engine != m_asyncEngine && m_asyncIo->getPendingCount() > 0) {
+      warning_stream("File: async requests for one file must be issued from a single thread");
+      return -1;
+   }
+   // keep what went through write() ahead of the async requests
+   if (!m_writeBuffer.isEmpty()) {
+      apiPtr->flush();
+   }
+   m_asyncEngine = engine;
+   // the ticket lives as long as the engine holds on to the request, the
+   // callback never touches this object itself
+   auto ticket = std::make_shared<AsyncIoTracker::Ticket>(m_asyncIo);
+   return engine->submit(write ? AsyncFileEngine::Operation::Write : AsyncFileEngine::Operation::Read,
+                         fd, offset, data, size, [ticket, callback](pdk::pint64 result, int errorCode) {
+      if (callback) {
+         callback(result, errorCode);
+      }
+   });
+#else
+   PDK_UNUSED(write);
+   PDK_UNUSED(offset);
+   PDK_UNUSED(data);
+   PDK_UNUSED(size);
+   PDK_UNUSED(callback);
+   return -1;
+#endif
+}
+
 } // internal
 
 File::File()
@@ -120,6 +172,9 @@ File::File(FilePrivate &dd, Object *parent)
 
 File::~File()
 {
+   // outstanding requests still refer to the handle, when they came from
+   // another thread this blocks until that thread has finished them
+   waitForAsyncIo();
 }
 
 String File::getFileName() const
@@ -568,6 +623,56 @@ pdk::pint64 File::getSize() const
    return FileDevice::getSize(); // for now
 }
 
+void File::close()
+{
+   // the handle must not be reused while a request may still touch it
+   waitForAsyncIo();
+   FileDevice::close();
+}
+
+int File::readAsync(pdk::pint64 offset, char *data, pdk::pint64 maxSize, const AsyncIoCallback &callback)
+{
+   PDK_D(File);
+   if (!isReadable()) {
+      warning_stream("File::readAsync: device not open for reading");
+      return -1;
+   }
+   return implPtr->submitAsyncIo(false, offset, data, maxSize, callback);
+}
+
+int File::writeAsync(pdk::pint64 offset, const char *data, pdk::pint64 size, const AsyncIoCallback &callback)
+{
+   PDK_D(File);
+   if (!isWritable()) {
+      warning_stream("File::writeAsync: device not open for writing");
+      return -1;
+   }
+   return implPtr->submitAsyncIo(true, offset, const_cast<char *>(data), size, callback);
+}
+
+bool File::waitForAsyncIo(int msecs)
+{
+   PDK_D(File);
+#ifdef PDK_OS_UNIX
+   if (!implPtr->m_asyncIo || implPtr->m_asyncIo->getPendingCount() == 0) {
+      return true;
+   }
+   if (implPtr->m_asyncEngine != AsyncFileEngine::getInstance()) {
+      // only the issuing thread may run the callbacks, block until its
+      // event loop (or its engine going away) has released the requests
+      return implPtr->m_asyncIo->waitForDone(msecs);
+   }
+   // the engine counts per handle, so requests of other files sharing
+   // the descriptor are waited for as well
+   return implPtr->m_asyncEngine->waitForRequests(getHandle(), msecs)
+         && implPtr->m_asyncIo->getPendingCount() == 0;
+#else
+   PDK_UNUSED(msecs);
+   // submitAsyncIo() never queues anything here
+   return true;
+#endif
+}
+
 } // fs
 } // io
 } // pdk
@@ -17,6 +17,7 @@
 #include "pdk/base/io/fs/internal/ResourcePrivate.h"
 #include "pdk/base/io/fs/internal/ResourceIteratorPrivate.h"
 #include "pdk/base/io/fs/internal/AbstractFileEnginePrivate.h"
+#include "pdk/base/compress/Compress.h"
 #include "pdk/base/time/DateTime.h"
 #include "pdk/base/ds/ByteArray.h"
 #include "pdk/base/ds/StringList.h"
@@ -1434,8 +1435,9 @@ bool ResourceFileEnginePrivate::unmap(uchar *ptr)
 void ResourceFileEnginePrivate::uncompress() const
 {
    if (m_resource.isCompressed() && m_uncompressed.isEmpty() && m_resource.getSize()) {
-#ifndef PDK_NO_COMPRESS
-//      m_uncompressed = qUncompress(resource.data(), resource.size());
+#if PDK_CONFIG(zlib)
+      m_uncompressed = pdk::compress::uncompress(reinterpret_cast<const char *>(m_resource.getData()),
+                                                 m_resource.getSize());
 #else
       PDK_ASSERT(!"ResourceFileEngine::open: pdk built without support for compression");
 #endif
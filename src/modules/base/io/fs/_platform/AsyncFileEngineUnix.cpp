@@ -0,0 +1,448 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/io/fs/internal/AsyncFileEnginePrivate.h"
+#include "pdk/base/os/thread/ThreadPool.h"
+#include "pdk/base/os/thread/Runnable.h"
+#include "pdk/base/os/thread/ThreadStorage.h"
+#include "pdk/base/os/thread/internal/ThreadPrivate.h"
+#include "pdk/kernel/CoreApplication.h"
+#include "pdk/kernel/SocketNotifier.h"
+#include "pdk/kernel/ElapsedTimer.h"
+#include "pdk/kernel/internal/CoreUnixPrivate.h"
+#include "pdk/global/GlobalStatic.h"
+#include "pdk/global/Logging.h"
+#include "pdk/utils/Funcs.h"
+
+#include <chrono>
+#include <mutex>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace pdk {
+namespace io {
+namespace fs {
+namespace internal {
+
+using pdk::kernel::CoreApplication;
+using pdk::kernel::SocketNotifier;
+using pdk::kernel::ElapsedTimer;
+using pdk::os::thread::ThreadPool;
+using pdk::os::thread::Runnable;
+using pdk::os::thread::ThreadStorage;
+using pdk::os::thread::internal::ThreadData;
+
+using AsyncFileEngineStorage = ThreadStorage<AsyncFileEngine *>;
+PDK_GLOBAL_STATIC(AsyncFileEngineStorage, sg_asyncFileEngines);
+
+int AsyncFileEngine::sm_submitEventType = -1;
+
+namespace {
+
+// carries out the requests with pread()/pwrite() on a private thread pool,
+// used wherever io_uring is not available
+class ThreadPoolBackend : public AsyncFileBackend
+{
+public:
+   ThreadPoolBackend();
+   ~ThreadPoolBackend();
+
+   bool init();
+   const char *getName() const override
+   {
+      return "threadpool";
+   }
+
+   void submit(std::vector<AsyncFileRequest *> &batch) override;
+   void takeCompleted(std::vector<AsyncFileRequest *> &completed) override;
+   int getNotifyHandle() const override
+   {
+      return m_pipe[0];
+   }
+
+   void complete(AsyncFileRequest *request);
+
+private:
+   ThreadPool m_pool;
+   std::mutex m_mutex;
+   std::vector<AsyncFileRequest *> m_completed;
+   int m_pipe[2];
+};
+
+class AsyncFileTask : public Runnable
+{
+public:
+   AsyncFileTask(ThreadPoolBackend *backend, AsyncFileRequest *request)
+      : m_backend(backend),
+        m_request(request)
+   {}
+
+   void run() override
+   {
+      perform_async_file_request(m_request);
+      m_backend->complete(m_request);
+   }
+
+private:
+   ThreadPoolBackend *m_backend;
+   AsyncFileRequest *m_request;
+};
+
+ThreadPoolBackend::ThreadPoolBackend()
+{
+   m_pipe[0] = m_pipe[1] = -1;
+   // disk requests mostly sleep in the kernel, a few threads are enough
+   // to keep a queue going without competing with the real workers
+   m_pool.setMaxThreadCount(4);
+   m_pool.setExpiryTimeout(-1);
+}
+
+ThreadPoolBackend::~ThreadPoolBackend()
+{
+   m_pool.waitForDone();
+   if (m_pipe[0] != -1) {
+      pdk::kernel::safe_close(m_pipe[0]);
+      pdk::kernel::safe_close(m_pipe[1]);
+   }
+}
+
+bool ThreadPoolBackend::init()
+{
+   if (pdk::kernel::safe_pipe(m_pipe, O_NONBLOCK) == -1) {
+      warning_stream("AsyncFileEngine: cannot create notification pipe: %s", std::strerror(errno));
+      m_pipe[0] = m_pipe[1] = -1;
+      return false;
+   }
+   return true;
+}
+
+void ThreadPoolBackend::submit(std::vector<AsyncFileRequest *> &batch)
+{
+   for (AsyncFileRequest *request : batch) {
+      m_pool.start(new AsyncFileTask(this, request));
+   }
+   batch.clear();
+}
+
+void ThreadPoolBackend::complete(AsyncFileRequest *request)
+{
+   bool wasEmpty;
+   {
+      std::lock_guard<std::mutex> locker(m_mutex);
+      wasEmpty = m_completed.empty();
+      m_completed.push_back(request);
+   }
+   // one byte per batch, the owner picks up everything that is in the list
+   if (wasEmpty) {
+      char c = 0;
+      pdk::kernel::safe_write(m_pipe[1], &c, 1);
+   }
+}
+
+void ThreadPoolBackend::takeCompleted(std::vector<AsyncFileRequest *> &completed)
+{
+   // drain the pipe before looking at the list so no wake up gets lost
+   char buffer[64];
+   while (::read(m_pipe[0], buffer, sizeof(buffer)) > 0) {
+   }
+   std::lock_guard<std::mutex> locker(m_mutex);
+   completed.insert(completed.end(), m_completed.begin(), m_completed.end());
+   m_completed.clear();
+}
+
+} // anonymous
+
+void perform_async_file_request(AsyncFileRequest *request)
+{
+   ssize_t result;
+   do {
+      if (request->m_operation == AsyncFileRequest::Operation::Read) {
+         result = ::pread(request->m_fd, request->m_iov.iov_base, request->m_iov.iov_len,
+                          request->m_offset);
+      } else {
+         result = ::pwrite(request->m_fd, request->m_iov.iov_base, request->m_iov.iov_len,
+                           request->m_offset);
+      }
+   } while (result == -1 && errno == EINTR);
+   request->m_result = result;
+   request->m_errorCode = result < 0 ? errno : 0;
+}
+
+AsyncFileBackend::~AsyncFileBackend()
+{}
+
+AsyncIoTracker::AsyncIoTracker()
+   : m_pendingCount(0)
+{}
+
+AsyncIoTracker::Ticket::Ticket(const std::shared_ptr<AsyncIoTracker> &tracker)
+   : m_tracker(tracker)
+{
+   std::lock_guard<std::mutex> locker(m_tracker->m_mutex);
+   ++m_tracker->m_pendingCount;
+}
+
+AsyncIoTracker::Ticket::~Ticket()
+{
+   std::lock_guard<std::mutex> locker(m_tracker->m_mutex);
+   if (--m_tracker->m_pendingCount == 0) {
+      m_tracker->m_done.notify_all();
+   }
+}
+
+int AsyncIoTracker::getPendingCount() const
+{
+   std::lock_guard<std::mutex> locker(m_mutex);
+   return m_pendingCount;
+}
+
+bool AsyncIoTracker::waitForDone(int msecs)
+{
+   std::unique_lock<std::mutex> locker(m_mutex);
+   if (msecs < 0) {
+      m_done.wait(locker, [this] { return m_pendingCount == 0; });
+      return true;
+   }
+   return m_done.wait_for(locker, std::chrono::milliseconds(msecs),
+                          [this] { return m_pendingCount == 0; });
+}
+
+AsyncFileBackend *create_thread_pool_backend()
+{
+   ThreadPoolBackend *backend = new ThreadPoolBackend;
+   if (!backend->init()) {
+      delete backend;
+      return nullptr;
+   }
+   return backend;
+}
+
+class AsyncFileNotifier : public SocketNotifier
+{
+public:
+   AsyncFileNotifier(int fd, AsyncFileEngine *engine)
+      : SocketNotifier(fd, SocketNotifier::Type::Read, engine),
+        m_engine(engine)
+   {}
+
+protected:
+   bool event(Event *event) override
+   {
+      if (event->getType() == Event::Type::SocketActive) {
+         m_engine->processCompletions();
+         return true;
+      }
+      return SocketNotifier::event(event);
+   }
+
+private:
+   AsyncFileEngine *m_engine;
+};
+
+AsyncFileEngine::AsyncFileEngine()
+   : m_backend(nullptr),
+     m_notifier(nullptr),
+     m_pendingCount(0),
+     m_nextRequestId(1),
+     m_submitPosted(false)
+{
+   if (sm_submitEventType == -1) {
+      sm_submitEventType = Event::registerEventType();
+   }
+#if PDK_CONFIG(io_uring)
+   bool ok = false;
+   if (pdk::env_var_intval("PDK_ASYNC_FILE_NO_IO_URING", &ok) <= 0 || !ok) {
+      m_backend = create_io_uring_backend();
+   }
+#endif
+   if (!m_backend) {
+      m_backend = create_thread_pool_backend();
+   }
+   ensureNotifier();
+}
+
+AsyncFileEngine::~AsyncFileEngine()
+{
+   if (m_backend) {
+      for (AsyncFileRequest *request : m_queued) {
+         delete request;
+      }
+      m_pendingCount -= static_cast<int>(m_queued.size());
+      m_queued.clear();
+      // the kernel or the workers may still write into caller owned
+      // buffers, wait for them but do not call back into anything
+      // that is being torn down with the thread
+      while (m_pendingCount > 0) {
+         waitForNotification(-1);
+         m_backend->takeCompleted(m_completed);
+         m_pendingCount -= static_cast<int>(m_completed.size());
+         for (AsyncFileRequest *request : m_completed) {
+            delete request;
+         }
+         m_completed.clear();
+      }
+   }
+   delete m_notifier;
+   delete m_backend;
+}
+
+void AsyncFileEngine::ensureNotifier()
+{
+   // the event dispatcher may only be created after the first request
+   if (!m_notifier && m_backend && ThreadData::current()->hasEventDispatcher()) {
+      m_notifier = new AsyncFileNotifier(m_backend->getNotifyHandle(), this);
+   }
+}
+
+AsyncFileEngine *AsyncFileEngine::getInstance()
+{
+   AsyncFileEngineStorage *storage = sg_asyncFileEngines();
+   if (!storage) {
+      return nullptr;
+   }
+   AsyncFileEngine *&engine = storage->localData();
+   if (!engine) {
+      engine = new AsyncFileEngine;
+   }
+   return engine;
+}
+
+const char *AsyncFileEngine::getBackendName() const
+{
+   return m_backend ? m_backend->getName() : "none";
+}
+
+int AsyncFileEngine::getPendingCount(int fd) const
+{
+   if (fd == -1) {
+      return m_pendingCount;
+   }
+   auto iter = m_pendingPerHandle.find(fd);
+   return iter == m_pendingPerHandle.end() ? 0 : iter->second;
+}
+
+int AsyncFileEngine::submit(Operation operation, int fd, pdk::pint64 offset, char *data,
+                            pdk::pint64 size, const Callback &callback)
+{
+   if (!m_backend || fd < 0 || offset < 0 || size < 0) {
+      return -1;
+   }
+   AsyncFileRequest *request = new AsyncFileRequest;
+   request->m_id = m_nextRequestId++;
+   if (m_nextRequestId <= 0) {
+      m_nextRequestId = 1;
+   }
+   request->m_operation = operation;
+   request->m_fd = fd;
+   request->m_offset = offset;
+   request->m_iov.iov_base = data;
+   request->m_iov.iov_len = static_cast<size_t>(size);
+   request->m_callback = callback;
+   request->m_result = -1;
+   request->m_errorCode = 0;
+   m_queued.push_back(request);
+   ++m_pendingCount;
+   ensureNotifier();
+   ++m_pendingPerHandle[fd];
+   if (!m_notifier) {
+      // no event loop to batch for
+      flushSubmissions();
+   } else if (!m_submitPosted) {
+      // everything queued until the posted events of this loop
+      // iteration are sent goes to the backend in one go
+      m_submitPosted = true;
+      CoreApplication::postEvent(this, new Event(static_cast<Event::Type>(sm_submitEventType)));
+   }
+   return request->m_id;
+}
+
+void AsyncFileEngine::flushSubmissions()
+{
+   m_submitPosted = false;
+   if (!m_queued.empty()) {
+      m_backend->submit(m_queued);
+   }
+}
+
+bool AsyncFileEngine::event(Event *event)
+{
+   if (static_cast<int>(event->getType()) == sm_submitEventType) {
+      flushSubmissions();
+      return true;
+   }
+   return Object::event(event);
+}
+
+void AsyncFileEngine::processCompletions()
+{
+   m_backend->takeCompleted(m_completed);
+   // callbacks may submit or wait themselves, work on a private copy
+   std::vector<AsyncFileRequest *> completed;
+   completed.swap(m_completed);
+   for (AsyncFileRequest *request : completed) {
+      --m_pendingCount;
+      auto iter = m_pendingPerHandle.find(request->m_fd);
+      if (iter != m_pendingPerHandle.end() && --iter->second == 0) {
+         m_pendingPerHandle.erase(iter);
+      }
+   }
+   for (AsyncFileRequest *request : completed) {
+      if (request->m_callback) {
+         request->m_callback(request->m_result, request->m_errorCode);
+      }
+      delete request;
+   }
+}
+
+bool AsyncFileEngine::waitForNotification(int msecs)
+{
+   pollfd pfd = pdk::kernel::make_pollfd(m_backend->getNotifyHandle(), POLLIN);
+   timespec ts;
+   timespec *timeout = nullptr;
+   if (msecs >= 0) {
+      ts.tv_sec = msecs / 1000;
+      ts.tv_nsec = (msecs % 1000) * 1000 * 1000;
+      timeout = &ts;
+   }
+   return pdk::kernel::safe_poll(&pfd, 1, timeout) > 0;
+}
+
+bool AsyncFileEngine::waitForRequests(int fd, int msecs)
+{
+   flushSubmissions();
+   ElapsedTimer timer;
+   timer.start();
+   processCompletions();
+   while (getPendingCount(fd) > 0) {
+      int remaining = -1;
+      if (msecs >= 0) {
+         remaining = msecs - static_cast<int>(timer.elapsed());
+         if (remaining <= 0) {
+            return false;
+         }
+      }
+      waitForNotification(remaining);
+      processCompletions();
+   }
+   return true;
+}
+
+} // internal
+} // fs
+} // io
+} // pdk
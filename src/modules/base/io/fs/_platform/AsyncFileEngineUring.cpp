@@ -0,0 +1,356 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/io/fs/internal/AsyncFileEnginePrivate.h"
+#include "pdk/kernel/internal/CoreUnixPrivate.h"
+#include "pdk/global/Logging.h"
+
+#if PDK_CONFIG(io_uring)
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <cerrno>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace pdk {
+namespace io {
+namespace fs {
+namespace internal {
+
+namespace {
+
+// glibc has no wrappers for these, talk to the kernel directly
+// rather than pulling in liburing
+inline int io_uring_setup(unsigned entries, io_uring_params *params)
+{
+   return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+inline int io_uring_enter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+   return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags,
+                                     nullptr, 0));
+}
+
+inline int io_uring_register(int fd, unsigned opcode, const void *arg, unsigned nrArgs)
+{
+   return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nrArgs));
+}
+
+template <typename T>
+inline T *ring_field(void *ring, __u32 offset)
+{
+   return reinterpret_cast<T *>(static_cast<char *>(ring) + offset);
+}
+
+class IoUringBackend : public AsyncFileBackend
+{
+public:
+   enum {
+      QueueDepth = 256
+   };
+
+   IoUringBackend();
+   ~IoUringBackend();
+
+   bool init();
+   const char *getName() const override
+   {
+      return "io_uring";
+   }
+
+   void submit(std::vector<AsyncFileRequest *> &batch) override;
+   void takeCompleted(std::vector<AsyncFileRequest *> &completed) override;
+   int getNotifyHandle() const override
+   {
+      return m_eventFd;
+   }
+
+private:
+   bool queueRequest(AsyncFileRequest *request);
+   void enter();
+   void reclaimUnsubmitted(int errorCode);
+
+   int m_ringFd;
+   int m_eventFd;
+   void *m_sqRing;
+   void *m_cqRing;
+   size_t m_sqRingSize;
+   size_t m_cqRingSize;
+   io_uring_sqe *m_sqes;
+   size_t m_sqesSize;
+   std::atomic<unsigned> *m_sqHead;
+   std::atomic<unsigned> *m_sqTail;
+   unsigned m_sqMask;
+   unsigned *m_sqArray;
+   std::atomic<unsigned> *m_cqHead;
+   std::atomic<unsigned> *m_cqTail;
+   unsigned m_cqMask;
+   io_uring_cqe *m_cqes;
+   unsigned m_sqEntries;
+   unsigned m_cqEntries;
+   // queued in the ring but not yet handed to io_uring_enter()
+   unsigned m_unsubmitted;
+   unsigned m_inFlight;
+   // requests waiting for room in the ring
+   std::deque<AsyncFileRequest *> m_overflow;
+   // taken back out of the ring after io_uring_enter() failed
+   std::vector<AsyncFileRequest *> m_reclaimed;
+};
+
+IoUringBackend::IoUringBackend()
+   : m_ringFd(-1),
+     m_eventFd(-1),
+     m_sqRing(MAP_FAILED),
+     m_cqRing(MAP_FAILED),
+     m_sqRingSize(0),
+     m_cqRingSize(0),
+     m_sqes(static_cast<io_uring_sqe *>(MAP_FAILED)),
+     m_sqesSize(0),
+     m_unsubmitted(0),
+     m_inFlight(0)
+{}
+
+IoUringBackend::~IoUringBackend()
+{
+   if (m_sqes != MAP_FAILED) {
+      ::munmap(m_sqes, m_sqesSize);
+   }
+   if (m_cqRing != MAP_FAILED && m_cqRing != m_sqRing) {
+      ::munmap(m_cqRing, m_cqRingSize);
+   }
+   if (m_sqRing != MAP_FAILED) {
+      ::munmap(m_sqRing, m_sqRingSize);
+   }
+   if (m_eventFd != -1) {
+      pdk::kernel::safe_close(m_eventFd);
+   }
+   if (m_ringFd != -1) {
+      pdk::kernel::safe_close(m_ringFd);
+   }
+}
+
+bool IoUringBackend::init()
+{
+   io_uring_params params;
+   std::memset(&params, 0, sizeof(params));
+   m_ringFd = io_uring_setup(QueueDepth, &params);
+   if (m_ringFd < 0) {
+      // ENOSYS on old kernels, EPERM when a seccomp policy forbids it
+      m_ringFd = -1;
+      return false;
+   }
+   m_sqEntries = params.sq_entries;
+   m_cqEntries = params.cq_entries;
+   m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+   m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+   const bool singleMap = params.features & IORING_FEAT_SINGLE_MMAP;
+   if (singleMap) {
+      m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+   }
+   m_sqRing = ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                     m_ringFd, IORING_OFF_SQ_RING);
+   if (m_sqRing == MAP_FAILED) {
+      return false;
+   }
+   if (singleMap) {
+      m_cqRing = m_sqRing;
+   } else {
+      m_cqRing = ::mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        m_ringFd, IORING_OFF_CQ_RING);
+      if (m_cqRing == MAP_FAILED) {
+         return false;
+      }
+   }
+   m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+   m_sqes = static_cast<io_uring_sqe *>(::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE,
+                                               MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQES));
+   if (m_sqes == MAP_FAILED) {
+      return false;
+   }
+   m_sqHead = ring_field<std::atomic<unsigned>>(m_sqRing, params.sq_off.head);
+   m_sqTail = ring_field<std::atomic<unsigned>>(m_sqRing, params.sq_off.tail);
+   m_sqMask = *ring_field<unsigned>(m_sqRing, params.sq_off.ring_mask);
+   m_sqArray = ring_field<unsigned>(m_sqRing, params.sq_off.array);
+   m_cqHead = ring_field<std::atomic<unsigned>>(m_cqRing, params.cq_off.head);
+   m_cqTail = ring_field<std::atomic<unsigned>>(m_cqRing, params.cq_off.tail);
+   m_cqMask = *ring_field<unsigned>(m_cqRing, params.cq_off.ring_mask);
+   m_cqes = ring_field<io_uring_cqe>(m_cqRing, params.cq_off.cqes);
+
+   // completions are announced through an eventfd so that the event
+   // dispatcher can watch the ring like any other socket notifier
+   m_eventFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+   if (m_eventFd == -1) {
+      return false;
+   }
+   if (io_uring_register(m_ringFd, IORING_REGISTER_EVENTFD, &m_eventFd, 1) < 0) {
+      warning_stream("AsyncFileEngine: cannot register eventfd with io_uring: %s",
+                     std::strerror(errno));
+      return false;
+   }
+   return true;
+}
+
+bool IoUringBackend::queueRequest(AsyncFileRequest *request)
+{
+   const unsigned tail = m_sqTail->load(std::memory_order_relaxed);
+   const unsigned head = m_sqHead->load(std::memory_order_acquire);
+   // never have more in flight than the completion ring can hold
+   if (tail - head >= m_sqEntries || m_inFlight >= m_cqEntries) {
+      return false;
+   }
+   const unsigned index = tail & m_sqMask;
+   io_uring_sqe *sqe = &m_sqes[index];
+   std::memset(sqe, 0, sizeof(*sqe));
+   // the vectored variants are the ones every io_uring capable kernel knows
+   sqe->opcode = request->m_operation == AsyncFileRequest::Operation::Read
+         ? IORING_OP_READV : IORING_OP_WRITEV;
+   sqe->fd = request->m_fd;
+   sqe->off = static_cast<__u64>(request->m_offset);
+   sqe->addr = reinterpret_cast<__u64>(&request->m_iov);
+   sqe->len = 1;
+   sqe->user_data = reinterpret_cast<__u64>(request);
+   m_sqArray[index] = index;
+   m_sqTail->store(tail + 1, std::memory_order_release);
+   ++m_unsubmitted;
+   ++m_inFlight;
+   return true;
+}
+
+void IoUringBackend::enter()
+{
+   while (m_unsubmitted > 0) {
+      int submitted = io_uring_enter(m_ringFd, m_unsubmitted, 0, 0);
+      if (submitted < 0) {
+         if (errno == EINTR) {
+            continue;
+         }
+         if (errno == EAGAIN || errno == EBUSY) {
+            if (m_inFlight > m_unsubmitted) {
+               // the entries stay in the ring, takeCompleted() retries
+               // as soon as one of the requests already in the kernel
+               // completes and signals the eventfd
+               return;
+            }
+            // nothing of ours is in the kernel, so nothing would ever
+            // signal the eventfd and a waiter would block for good
+            reclaimUnsubmitted(0);
+            return;
+         }
+         warning_stream("AsyncFileEngine: io_uring_enter failed: %s", std::strerror(errno));
+         reclaimUnsubmitted(errno);
+         return;
+      }
+      m_unsubmitted -= static_cast<unsigned>(submitted);
+      if (submitted == 0) {
+         return;
+      }
+   }
+}
+
+void IoUringBackend::reclaimUnsubmitted(int errorCode)
+{
+   // without SQPOLL the kernel only looks at the ring inside
+   // io_uring_enter(), so whatever it has not consumed can be taken back,
+   // the requests fail with errorCode or, without an error, are carried
+   // out right here the way the thread pool backend does it
+   const unsigned head = m_sqHead->load(std::memory_order_acquire);
+   const unsigned tail = m_sqTail->load(std::memory_order_relaxed);
+   for (unsigned i = head; i != tail; ++i) {
+      const io_uring_sqe &sqe = m_sqes[m_sqArray[i & m_sqMask]];
+      AsyncFileRequest *request = reinterpret_cast<AsyncFileRequest *>(sqe.user_data);
+      if (errorCode != 0) {
+         request->m_result = -1;
+         request->m_errorCode = errorCode;
+      } else {
+         perform_async_file_request(request);
+      }
+      m_reclaimed.push_back(request);
+      --m_inFlight;
+   }
+   m_sqTail->store(head, std::memory_order_release);
+   m_unsubmitted = 0;
+   // handed out by takeCompleted() like any other completion
+   ::eventfd_write(m_eventFd, 1);
+}
+
+void IoUringBackend::submit(std::vector<AsyncFileRequest *> &batch)
+{
+   for (AsyncFileRequest *request : batch) {
+      if (!m_overflow.empty() || !queueRequest(request)) {
+         m_overflow.push_back(request);
+      }
+   }
+   batch.clear();
+   // a single system call for everything queued in this loop iteration
+   enter();
+}
+
+void IoUringBackend::takeCompleted(std::vector<AsyncFileRequest *> &completed)
+{
+   // reset the eventfd before reaping, a completion that arrives after
+   // this point signals it again
+   eventfd_t value;
+   ::eventfd_read(m_eventFd, &value);
+   completed.insert(completed.end(), m_reclaimed.begin(), m_reclaimed.end());
+   m_reclaimed.clear();
+   unsigned head = m_cqHead->load(std::memory_order_relaxed);
+   const unsigned tail = m_cqTail->load(std::memory_order_acquire);
+   while (head != tail) {
+      const io_uring_cqe &cqe = m_cqes[head & m_cqMask];
+      AsyncFileRequest *request = reinterpret_cast<AsyncFileRequest *>(cqe.user_data);
+      if (cqe.res < 0) {
+         request->m_result = -1;
+         request->m_errorCode = -cqe.res;
+      } else {
+         request->m_result = cqe.res;
+         request->m_errorCode = 0;
+      }
+      completed.push_back(request);
+      --m_inFlight;
+      ++head;
+   }
+   m_cqHead->store(head, std::memory_order_release);
+   while (!m_overflow.empty() && queueRequest(m_overflow.front())) {
+      m_overflow.pop_front();
+   }
+   // also retries the entries a busy kernel refused last time
+   enter();
+}
+
+} // anonymous
+
+AsyncFileBackend *create_io_uring_backend()
+{
+   IoUringBackend *backend = new IoUringBackend;
+   if (!backend->init()) {
+      delete backend;
+      return nullptr;
+   }
+   return backend;
+}
+
+} // internal
+} // fs
+} // io
+} // pdk
+
+#endif // PDK_CONFIG(io_uring)
@@ -554,8 +554,17 @@ void FileSystemMetaData::fillFromDirEnt(const PDK_DIRENT &entry)
    }
 #elif defined(_DIRENT_HAVE_D_TYPE) || defined(PDK_OS_BSD4)
    // BSD4 includes OS X and iOS
+   fillFromDirEntType(entry.d_type);
+#else
+   PDK_UNUSED(entry);
+#endif
+}
+
+void FileSystemMetaData::fillFromDirEntType(unsigned char type)
+{
+#if defined(_DIRENT_HAVE_D_TYPE) || defined(PDK_OS_BSD4)
    // ### This will clear all entry flags and knownFlagsMask
-   switch (entry.d_type)
+   switch (type)
    {
    case DT_DIR:
       m_knownFlagsMask = FileSystemMetaData::MetaDataFlag::LinkType
@@ -622,7 +631,8 @@ void FileSystemMetaData::fillFromDirEnt(const PDK_DIRENT &entry)
       clear();
    }
 #else
-   PDK_UNUSED(entry);
+   PDK_UNUSED(type);
+   clear();
 #endif
 }
 
@@ -15,57 +15,181 @@
 
 #include "pdk/global/PlatformDefs.h"
 #include "pdk/base/io/fs/internal/FileSystemIteratorPrivate.h"
+#include "pdk/base/io/fs/File.h"
 
 #ifndef PDK_NO_FILESYSTEMITERATOR
 
 #include <cstdlib>
+#include <cstring>
 #include <cerrno>
 
+#if defined(PDK_FILESYSTEMITERATOR_USE_GETDENTS)
+#  include "pdk/kernel/internal/CoreUnixPrivate.h"
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/syscall.h>
+#endif
+
 namespace pdk {
 namespace io {
 namespace fs {
 namespace internal {
 
+namespace {
+
+#if defined(PDK_FILESYSTEMITERATOR_USE_GETDENTS)
+// the record getdents64 fills in, glibc only declares it from 2.30 on
+struct LinuxDirEnt64
+{
+   pdk::puint64 m_ino;
+   pdk::pint64 m_off;
+   unsigned short m_reclen;
+   unsigned char m_type;
+   char m_name[1];
+};
+
+// a call returns as many entries as fit, about a thousand of them
+constexpr int DIRENT_BUFFER_SIZE = 32 * 1024;
+#endif
+
+// some entries are ruled out by their d_type and name alone, those never
+// cost DirIterator a FileInfo or a stat, everything else goes through
+// its filters as before
+bool is_filtered_out(const char *name, const FileSystemMetaData &metaData,
+                     Dir::Filters filters, DirIterator::IteratorFlags flags)
+{
+   if (!metaData.hasFlags(FileSystemMetaData::MetaDataFlag::LinkType
+                          | FileSystemMetaData::MetaDataFlag::FileType
+                          | FileSystemMetaData::MetaDataFlag::DirectoryType)
+       || metaData.isLink()) {
+      return false;
+   }
+   if (name[0] == '.') {
+      if (name[1] == '\0') {
+         return filters & Dir::Filter::NoDot;
+      }
+      if (name[1] == '.' && name[2] == '\0') {
+         return filters & Dir::Filter::NoDotDot;
+      }
+   }
+   if (metaData.isDirectory() && (flags & DirIterator::IteratorFlag::Subdirectories)) {
+      // may still be descended into
+      return false;
+   }
+   if (name[0] == '.' && !(filters & Dir::Filter::Hidden)) {
+      return true;
+   }
+   if (metaData.isDirectory()) {
+      return !(filters & (pdk::as_integer<Dir::Filter>(Dir::Filter::Dirs) |
+                          pdk::as_integer<Dir::Filter>(Dir::Filter::AllDirs)));
+   }
+   if (metaData.isFile()) {
+      return !(filters & Dir::Filter::Files);
+   }
+   return !(filters & Dir::Filter::System);
+}
+
+// the directory part is converted once per directory, an entry only
+// decodes its own name
+FileSystemEntry make_entry(const FileSystemEntry::NativePath &nativePath, const String &filePath,
+                           const char *name)
+{
+   const int length = int(std::strlen(name));
+   FileSystemEntry::NativePath nativeFilePath;
+   nativeFilePath.reserve(nativePath.size() + length);
+   nativeFilePath.append(nativePath).append(name, length);
+   return FileSystemEntry(filePath + File::decodeName(ByteArray::fromRawData(name, length)),
+                          nativeFilePath);
+}
+
+} // anonymous namespace
+
 FileSystemIterator::FileSystemIterator(const FileSystemEntry &entry, Dir::Filters filters,
                                        const StringList &nameFilters, DirIterator::IteratorFlags flags)
    : m_nativePath(entry.getNativeFilePath()),
+#if defined(PDK_FILESYSTEMITERATOR_USE_GETDENTS)
+     m_fd(-1),
+     m_bufferPos(0),
+     m_bufferEnd(0),
+#else
      m_dir(0),
      m_dirEntry(0),
+#endif
+     m_filters(filters),
+     m_iteratorFlags(flags),
      m_lastError(0)
 {
-   PDK_UNUSED(filters);
    PDK_UNUSED(nameFilters);
-   PDK_UNUSED(flags);
-   
+#if defined(PDK_FILESYSTEMITERATOR_USE_GETDENTS)
+   if ((m_fd = PDK_OPEN(m_nativePath.getConstRawData(), O_RDONLY | O_DIRECTORY)) == -1) {
+      m_lastError = errno;
+      return;
+   }
+   m_buffer.reset(new char[DIRENT_BUFFER_SIZE]);
+#else
    if ((m_dir = PDK_OPENDIR(m_nativePath.getConstRawData())) == 0) {
       m_lastError = errno;
-   } else {
-      if (!m_nativePath.endsWith('/')) {
-         m_nativePath.append('/');
-      }
+      return;
+   }
+#endif
+   if (!m_nativePath.endsWith('/')) {
+      m_nativePath.append('/');
    }
+   m_filePath = File::decodeName(m_nativePath);
 }
 
 FileSystemIterator::~FileSystemIterator()
 {
+#if defined(PDK_FILESYSTEMITERATOR_USE_GETDENTS)
+   if (m_fd != -1) {
+      PDK_CLOSE(m_fd);
+   }
+#else
    if (m_dir) {
       PDK_CLOSEDIR(m_dir);
    }
+#endif
 }
 
 bool FileSystemIterator::advance(FileSystemEntry &fileEntry, FileSystemMetaData &metaData)
 {
+#if defined(PDK_FILESYSTEMITERATOR_USE_GETDENTS)
+   if (m_fd == -1) {
+      return false;
+   }
+   while (true) {
+      if (m_bufferPos == m_bufferEnd) {
+         long count;
+         PDK_EINTR_LOOP(count, ::syscall(SYS_getdents64, m_fd, m_buffer.getData(), DIRENT_BUFFER_SIZE));
+         if (count <= 0) {
+            m_lastError = count == 0 ? 0 : errno;
+            return false;
+         }
+         m_bufferPos = 0;
+         m_bufferEnd = int(count);
+      }
+      const LinuxDirEnt64 *dirEntry = reinterpret_cast<const LinuxDirEnt64 *>(m_buffer.getData() + m_bufferPos);
+      m_bufferPos += dirEntry->m_reclen;
+      metaData.fillFromDirEntType(dirEntry->m_type);
+      if (!is_filtered_out(dirEntry->m_name, metaData, m_filters, m_iteratorFlags)) {
+         fileEntry = make_entry(m_nativePath, m_filePath, dirEntry->m_name);
+         return true;
+      }
+   }
+#else
    if (!m_dir) {
       return false;
    }
-   m_dirEntry = PDK_READDIR(m_dir);
-   if (m_dirEntry) {
-      fileEntry = FileSystemEntry(m_nativePath + ByteArray(m_dirEntry->d_name), FileSystemEntry::FromNativePath());
+   while ((m_dirEntry = PDK_READDIR(m_dir))) {
       metaData.fillFromDirEnt(*m_dirEntry);
-      return true;
+      if (!is_filtered_out(m_dirEntry->d_name, metaData, m_filters, m_iteratorFlags)) {
+         fileEntry = make_entry(m_nativePath, m_filePath, m_dirEntry->d_name);
+         return true;
+      }
    }
    m_lastError = errno;
    return false;
+#endif
 }
 
 } // internal
@@ -78,6 +78,8 @@ using pdk::lang::StringIterator;
 using pdk::text::codecs::TextCodec;
 using pdk::io::DataStream;
 using pdk::utils::Locale;
+using pdk::pal::kernel::SimdKernel;
+using pdk::pal::kernel::select_simd_kernel;
 
 // forward declare with namespace
 namespace internal {
@@ -173,12 +175,30 @@ int unicode_stricmp(const Character *lhsBegin, const Character *lhsEnd,
    char32_t lhsLast = 0;
    char32_t rhsLast = 0;
    while (lhsBegin < end) {
-      int diff = internal::fold_case(lhsBegin->unicode(), lhsLast) - internal::fold_case(rhsBegin->unicode(), rhsLast);
-      if (diff) {
-         return diff;
+      // runs of equal and latin-1 text skip the tables
+      const int same = internal::fold_equal_prefix(reinterpret_cast<const char16_t *>(lhsBegin),
+                                                   reinterpret_cast<const char16_t *>(rhsBegin),
+                                                   static_cast<int>(end - lhsBegin));
+      if (same) {
+         lhsBegin += same;
+         rhsBegin += same;
+         lhsLast = lhsBegin[-1].unicode();
+         rhsLast = rhsBegin[-1].unicode();
+      }
+      // the others go through them until the text is latin-1 again
+      while (lhsBegin < end) {
+         int diff = internal::fold_case(lhsBegin->unicode(), lhsLast) - internal::fold_case(rhsBegin->unicode(), rhsLast);
+         if (diff) {
+            return diff;
+         }
+         ++lhsBegin;
+         ++rhsBegin;
+         if (lhsBegin < end && (lhsBegin->unicode() == rhsBegin->unicode()
+                                || (internal::folds_in_latin1(lhsBegin->unicode())
+                                    && internal::folds_in_latin1(rhsBegin->unicode())))) {
+            break;
+         }
       }
-      ++lhsBegin;
-      ++rhsBegin;
    }
    if (lhsBegin == lhsEnd) {
       if (rhsBegin == rhsEnd) {
@@ -203,7 +223,14 @@ int unicode_stricmp(const Character *lhsBegin, const Character *lhsEnd, const ch
       end = lhsBegin + (rhsEnd - rhsBegin);
    }
    while (lhsBegin < end) {
-      int diff = internal::fold_case(lhsBegin->unicode()) - internal::fold_case(static_cast<char16_t>(*rhsBegin));
+      const int same = internal::fold_equal_prefix(reinterpret_cast<const char16_t *>(lhsBegin), rhsBegin,
+                                                   static_cast<int>(end - lhsBegin));
+      lhsBegin += same;
+      rhsBegin += same;
+      if (lhsBegin == end) {
+         break;
+      }
+      int diff = internal::fold_case(lhsBegin->unicode()) - internal::fold_case(static_cast<char16_t>(static_cast<uchar>(*rhsBegin)));
       if (diff) {
          return diff;
       }
@@ -327,7 +354,7 @@ int unicode_strncmp(const Character *lhs, const uchar *rhs, int length)
       uint mask = ~_mm256_movemask_epi8(result);
 #  else
       // expand via unpacking
-      __m128i firstHalf = _mm_unpackhi_epi8(chunk, nullMask);
+      __m128i firstHalf = _mm_unpacklo_epi8(chunk, nullMask);
       __m128i secondHalf = _mm_unpackhi_epi8(chunk, nullMask);
       // load UTF-16 data and compare
       __m128i lhsData1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ulhs + offset));
@@ -444,6 +471,327 @@ int pdk_compare_strings(Latin1String lhs, Latin1String rhs, pdk::CaseSensitivity
    return result ? result : lencmp(lhs.size(), rhs.size());
 }
 
+// the kernels of find_char(), they return the first unit equal to c in
+// [n, e) or nullptr
+using FindChar16Function = const char16_t *(*)(const char16_t *n, const char16_t *e, char16_t c);
+
+const char16_t *find_char16_scalar(const char16_t *n, const char16_t *e, char16_t c)
+{
+   for ( ; n != e; ++n) {
+      if (*n == c) {
+         return n;
+      }
+   }
+   return nullptr;
+}
+
+#ifdef __SSE2__
+const char16_t *find_char16_sse2(const char16_t *n, const char16_t *e, char16_t c)
+{
+   __m128i mch = _mm_set1_epi32(c | (c << 16));
+   
+   // we're going to read n[0..7] (16 bytes)
+   for (const char16_t *next = n + 8; next <= e; n = next, next += 8) {
+      __m128i data = _mm_loadu_si128((const __m128i*)n);
+      __m128i result = _mm_cmpeq_epi16(data, mch);
+      uint mask = _mm_movemask_epi8(result);
+      if (ushort(mask)) {
+         // found a match
+         return n + pdk::count_trailing_zero_bits(mask) / 2;
+      }
+   }
+   
+#  if !defined(__OPTIMIZE_SIZE__)
+   return UnrollTailLoop<7>::exec(e - n, static_cast<const char16_t *>(nullptr),
+                                  [=](int i) { return n[i] == c; },
+   [=](int i) { return n + i; });
+#  else
+   return find_char16_scalar(n, e, c);
+#  endif
+}
+#endif
+
+#ifdef PDK_SIMD_DISPATCH_X86
+PDK_FUNCTION_TARGET(AVX2) const char16_t *find_char16_avx2(const char16_t *n, const char16_t *e, char16_t c)
+{
+   const __m256i mch = _mm256_set1_epi16(static_cast<short>(c));
+   // we're going to read n[0..15] (32 bytes)
+   for ( ; e - n >= 16; n += 16) {
+      const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(n));
+      const uint mask = _mm256_movemask_epi8(_mm256_cmpeq_epi16(data, mch));
+      if (mask) {
+         return n + pdk::count_trailing_zero_bits(mask) / 2;
+      }
+   }
+#  ifdef __SSE2__
+   return find_char16_sse2(n, e, c);
+#  else
+   return find_char16_scalar(n, e, c);
+#  endif
+}
+#endif
+
+const SimdKernel<FindChar16Function> &find_char16_kernel()
+{
+   static const SimdKernel<FindChar16Function> kernels[] = {
+#ifdef PDK_SIMD_DISPATCH_X86
+      {CPU_FEATURE_BIT(AVX2), find_char16_avx2, "avx2"},
+#endif
+#ifdef __SSE2__
+      {0, find_char16_sse2, "sse2"},
+#endif
+      {0, find_char16_scalar, "scalar"}
+   };
+   static const SimdKernel<FindChar16Function> &kernel = select_simd_kernel(kernels);
+   return kernel;
+}
+
+// the one unit outside latin-1 whose fold_case() is the latin-1 character
+// folded, or folded itself
+char16_t latin1_fold_alias(char16_t folded)
+{
+   switch (folded) {
+   case 'k':
+      return 0x212a; // KELVIN SIGN
+   case 's':
+      return 0x17f; // LATIN SMALL LETTER LONG S
+   case 0xdf:
+      return 0x1e9e; // LATIN CAPITAL LETTER SHARP S
+   case 0xe5:
+      return 0x212b; // ANGSTROM SIGN
+   case 0xff:
+      return 0x178; // LATIN CAPITAL LETTER Y WITH DIAERESIS
+   default:
+      return folded;
+   }
+}
+
+// the kernels of internal::fold_equal_prefix() and internal::find_folded_char()
+using FoldEqualFunction = int (*)(const char16_t *lhs, const char16_t *rhs, int length);
+using FoldEqualLatin1Function = int (*)(const char16_t *lhs, const char *rhs, int length);
+using FindFoldedFunction = const char16_t *(*)(const char16_t *n, const char16_t *e, char16_t folded);
+
+inline bool fold_equal_latin1(char16_t lhs, char16_t rhs)
+{
+   return lhs == rhs || (internal::folds_in_latin1(lhs) && internal::folds_in_latin1(rhs)
+                         && internal::fold_latin1(lhs) == internal::fold_latin1(rhs));
+}
+
+int fold_equal_scalar(const char16_t *lhs, const char16_t *rhs, int length)
+{
+   int i = 0;
+   while (i < length && fold_equal_latin1(lhs[i], rhs[i])) {
+      ++i;
+   }
+   return i;
+}
+
+int fold_equal_latin1_scalar(const char16_t *lhs, const char *rhs, int length)
+{
+   int i = 0;
+   while (i < length && fold_equal_latin1(lhs[i], static_cast<uchar>(rhs[i]))) {
+      ++i;
+   }
+   return i;
+}
+
+const char16_t *find_folded_scalar(const char16_t *n, const char16_t *e, char16_t folded)
+{
+   const char16_t alias = latin1_fold_alias(folded);
+   for ( ; n != e; ++n) {
+      if (internal::fold_latin1(*n) == folded || *n == alias) {
+         return n;
+      }
+   }
+   return nullptr;
+}
+
+#ifdef __SSE2__
+// the lanes of x in [lower, lower + count) as unsigned numbers
+inline __m128i in_range_epu16(__m128i x, short lower, short count)
+{
+   const __m128i offset = _mm_xor_si128(_mm_sub_epi16(x, _mm_set1_epi16(lower)), _mm_set1_epi16(short(0x8000)));
+   return _mm_cmplt_epi16(offset, _mm_set1_epi16(short(0x8000 + count)));
+}
+
+// fold_latin1() of eight units
+inline __m128i fold_latin1_epi16(__m128i x)
+{
+   const __m128i latin1Upper = _mm_andnot_si128(_mm_cmpeq_epi16(x, _mm_set1_epi16(0xd7)),
+                                                in_range_epu16(x, 0xc0, 0x1f));
+   const __m128i upper = _mm_or_si128(in_range_epu16(x, 'A', 26), latin1Upper);
+   return _mm_add_epi16(x, _mm_and_si128(upper, _mm_set1_epi16(0x20)));
+}
+
+// the lanes equal as they are or after folding inside latin-1
+inline __m128i fold_equal_epi16(__m128i lhs, __m128i rhs)
+{
+   const __m128i micro = _mm_set1_epi16(0xb5);
+   const __m128i latin1 = _mm_andnot_si128(_mm_or_si128(_mm_cmpeq_epi16(lhs, micro), _mm_cmpeq_epi16(rhs, micro)),
+                                           _mm_and_si128(in_range_epu16(lhs, 0, 0x100), in_range_epu16(rhs, 0, 0x100)));
+   const __m128i folded = _mm_and_si128(latin1, _mm_cmpeq_epi16(fold_latin1_epi16(lhs), fold_latin1_epi16(rhs)));
+   return _mm_or_si128(_mm_cmpeq_epi16(lhs, rhs), folded);
+}
+
+int fold_equal_sse2(const char16_t *lhs, const char16_t *rhs, int length)
+{
+   int i = 0;
+   // eight units a step
+   for ( ; i + 8 <= length; i += 8) {
+      const __m128i lhsData = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs + i));
+      const __m128i rhsData = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs + i));
+      if (_mm_movemask_epi8(fold_equal_epi16(lhsData, rhsData)) != 0xffff) {
+         break;
+      }
+   }
+   return i + fold_equal_scalar(lhs + i, rhs + i, length - i);
+}
+
+int fold_equal_latin1_sse2(const char16_t *lhs, const char *rhs, int length)
+{
+   int i = 0;
+   for ( ; i + 8 <= length; i += 8) {
+      const __m128i lhsData = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lhs + i));
+      const __m128i rhsData = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(rhs + i)),
+                                                _mm_setzero_si128());
+      if (_mm_movemask_epi8(fold_equal_epi16(lhsData, rhsData)) != 0xffff) {
+         break;
+      }
+   }
+   return i + fold_equal_latin1_scalar(lhs + i, rhs + i, length - i);
+}
+
+const char16_t *find_folded_sse2(const char16_t *n, const char16_t *e, char16_t folded)
+{
+   const __m128i target = _mm_set1_epi16(static_cast<short>(folded));
+   const __m128i alias = _mm_set1_epi16(static_cast<short>(latin1_fold_alias(folded)));
+   for ( ; e - n >= 8; n += 8) {
+      const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(n));
+      const __m128i match = _mm_or_si128(_mm_cmpeq_epi16(fold_latin1_epi16(data), target),
+                                         _mm_cmpeq_epi16(data, alias));
+      const uint mask = _mm_movemask_epi8(match);
+      if (mask) {
+         return n + pdk::count_trailing_zero_bits(mask) / 2;
+      }
+   }
+   return find_folded_scalar(n, e, folded);
+}
+#endif
+
+#ifdef PDK_SIMD_DISPATCH_X86
+PDK_FUNCTION_TARGET(AVX2) inline __m256i in_range_epu16_avx2(__m256i x, short lower, short count)
+{
+   const __m256i offset = _mm256_sub_epi16(x, _mm256_set1_epi16(lower));
+   return _mm256_cmpeq_epi16(_mm256_min_epu16(offset, _mm256_set1_epi16(count - 1)), offset);
+}
+
+PDK_FUNCTION_TARGET(AVX2) inline __m256i fold_latin1_avx2(__m256i x)
+{
+   const __m256i latin1Upper = _mm256_andnot_si256(_mm256_cmpeq_epi16(x, _mm256_set1_epi16(0xd7)),
+                                                   in_range_epu16_avx2(x, 0xc0, 0x1f));
+   const __m256i upper = _mm256_or_si256(in_range_epu16_avx2(x, 'A', 26), latin1Upper);
+   return _mm256_add_epi16(x, _mm256_and_si256(upper, _mm256_set1_epi16(0x20)));
+}
+
+PDK_FUNCTION_TARGET(AVX2) inline __m256i fold_equal_avx2(__m256i lhs, __m256i rhs)
+{
+   const __m256i micro = _mm256_set1_epi16(0xb5);
+   const __m256i latin1 = _mm256_andnot_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi16(lhs, micro), _mm256_cmpeq_epi16(rhs, micro)),
+            _mm256_and_si256(in_range_epu16_avx2(lhs, 0, 0x100), in_range_epu16_avx2(rhs, 0, 0x100)));
+   const __m256i folded = _mm256_and_si256(latin1, _mm256_cmpeq_epi16(fold_latin1_avx2(lhs), fold_latin1_avx2(rhs)));
+   return _mm256_or_si256(_mm256_cmpeq_epi16(lhs, rhs), folded);
+}
+
+PDK_FUNCTION_TARGET(AVX2) int fold_equal_avx2(const char16_t *lhs, const char16_t *rhs, int length)
+{
+   int i = 0;
+   // sixteen units a step
+   for ( ; i + 16 <= length; i += 16) {
+      const __m256i lhsData = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i));
+      const __m256i rhsData = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(rhs + i));
+      if (uint(_mm256_movemask_epi8(fold_equal_avx2(lhsData, rhsData))) != 0xffffffffu) {
+         break;
+      }
+   }
+   return i + fold_equal_scalar(lhs + i, rhs + i, length - i);
+}
+
+PDK_FUNCTION_TARGET(AVX2) int fold_equal_latin1_avx2(const char16_t *lhs, const char *rhs, int length)
+{
+   int i = 0;
+   for ( ; i + 16 <= length; i += 16) {
+      const __m256i lhsData = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lhs + i));
+      const __m256i rhsData = _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(rhs + i)));
+      if (uint(_mm256_movemask_epi8(fold_equal_avx2(lhsData, rhsData))) != 0xffffffffu) {
+         break;
+      }
+   }
+   return i + fold_equal_latin1_scalar(lhs + i, rhs + i, length - i);
+}
+
+PDK_FUNCTION_TARGET(AVX2) const char16_t *find_folded_avx2(const char16_t *n, const char16_t *e, char16_t folded)
+{
+   const __m256i target = _mm256_set1_epi16(static_cast<short>(folded));
+   const __m256i alias = _mm256_set1_epi16(static_cast<short>(latin1_fold_alias(folded)));
+   for ( ; e - n >= 16; n += 16) {
+      const __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(n));
+      const __m256i match = _mm256_or_si256(_mm256_cmpeq_epi16(fold_latin1_avx2(data), target),
+                                            _mm256_cmpeq_epi16(data, alias));
+      const uint mask = _mm256_movemask_epi8(match);
+      if (mask) {
+         return n + pdk::count_trailing_zero_bits(mask) / 2;
+      }
+   }
+   return find_folded_scalar(n, e, folded);
+}
+#endif
+
+const SimdKernel<FoldEqualFunction> &fold_equal_kernel()
+{
+   static const SimdKernel<FoldEqualFunction> kernels[] = {
+#ifdef PDK_SIMD_DISPATCH_X86
+      {CPU_FEATURE_BIT(AVX2), fold_equal_avx2, "avx2"},
+#endif
+#ifdef __SSE2__
+      {0, fold_equal_sse2, "sse2"},
+#endif
+      {0, fold_equal_scalar, "scalar"}
+   };
+   static const SimdKernel<FoldEqualFunction> &kernel = select_simd_kernel(kernels);
+   return kernel;
+}
+
+const SimdKernel<FoldEqualLatin1Function> &fold_equal_latin1_kernel()
+{
+   static const SimdKernel<FoldEqualLatin1Function> kernels[] = {
+#ifdef PDK_SIMD_DISPATCH_X86
+      {CPU_FEATURE_BIT(AVX2), fold_equal_latin1_avx2, "avx2"},
+#endif
+#ifdef __SSE2__
+      {0, fold_equal_latin1_sse2, "sse2"},
+#endif
+      {0, fold_equal_latin1_scalar, "scalar"}
+   };
+   static const SimdKernel<FoldEqualLatin1Function> &kernel = select_simd_kernel(kernels);
+   return kernel;
+}
+
+const SimdKernel<FindFoldedFunction> &find_folded_kernel()
+{
+   static const SimdKernel<FindFoldedFunction> kernels[] = {
+#ifdef PDK_SIMD_DISPATCH_X86
+      {CPU_FEATURE_BIT(AVX2), find_folded_avx2, "avx2"},
+#endif
+#ifdef __SSE2__
+      {0, find_folded_sse2, "sse2"},
+#endif
+      {0, find_folded_scalar, "scalar"}
+   };
+   static const SimdKernel<FindFoldedFunction> &kernel = select_simd_kernel(kernels);
+   return kernel;
+}
+
 int find_char(const Character *str, int len, Character ch, int from,
               pdk::CaseSensitivity cs)
 {
@@ -456,36 +804,14 @@ int find_char(const Character *str, int len, Character ch, int from,
       const char16_t *n = s + from;
       const char16_t *e = s + len;
       if (cs == pdk::CaseSensitivity::Sensitive) {
-#ifdef __SSE2__
-         __m128i mch = _mm_set1_epi32(c | (c << 16));
-         
-         // we're going to read n[0..7] (16 bytes)
-         for (const char16_t *next = n + 8; next <= e; n = next, next += 8) {
-            __m128i data = _mm_loadu_si128((const __m128i*)n);
-            __m128i result = _mm_cmpeq_epi16(data, mch);
-            uint mask = _mm_movemask_epi8(result);
-            if (ushort(mask)) {
-               // found a match
-               // same as: return n - s + _bit_scan_forward(mask) / 2
-               return (reinterpret_cast<const char *>(n) - reinterpret_cast<const char *>(s)
-                       + pdk::count_trailing_zero_bits(mask)) >> 1;
-            }
-         }
-         
-#  if !defined(__OPTIMIZE_SIZE__)
-         return UnrollTailLoop<7>::exec(e - n, -1,
-                                        [=](int i) { return n[i] == c; },
-         [=](int i) { return n - s + i; });
-#  endif
-#endif
-         --n;
-         while (++n != e) {
-            if (*n == c) {
-               return  n - s;
-            }
-         }
+         const char16_t *found = find_char16_kernel().function(n, e, c);
+         return found ? static_cast<int>(found - s) : -1;
       } else {
          c = internal::fold_case(c);
+         if (c < 0x100) {
+            const char16_t *found = internal::find_folded_char(n, e, c);
+            return found ? static_cast<int>(found - s) : -1;
+         }
          --n;
          while (++n != e) {
             if (internal::fold_case(*n) == c) {
@@ -565,54 +891,33 @@ inline __m128i merge_question_marks(__m128i chunk)
 }
 #endif
 
-ByteArray pdk_convert_to_local_8bit(StringView string)
-{
-   if (string.isNull()) {
-      return ByteArray();
-   }
-   
-#ifndef PDK_NO_TEXTCODEC
-   TextCodec *localeCodec = TextCodec::getCodecForLocale();
-   if (localeCodec)
-      return localeCodec->fromUnicode(string);
-#endif // PDK_NO_TEXTCODEC
-   return pdk_convert_to_latin1(string);
-}
+// the kernels of utf16_from_latin1() and utf16_to_latin1()
+using FromLatin1Function = void (*)(char16_t *dest, const char *str, size_t size);
+using ToLatin1Function = void (*)(uchar *dest, const char16_t *src, int length);
 
-ByteArray pdk_convert_to_utf8(StringView str)
+void from_latin1_scalar(char16_t *dest, const char *str, size_t size)
 {
-   if (str.isNull()) {
-      return ByteArray();
+   // @TODO optimized for __mips_dsp
+   while (size--) {
+      *dest++ = static_cast<uchar>(*str++);
    }
-   return Utf8::convertFromUnicode(str.data(), str.length());
 }
 
-std::vector<char32_t> pdk_convert_to_ucs4(StringView string)
+void to_latin1_scalar(uchar *dest, const char16_t *src, int length)
 {
-   std::vector<char32_t> v(string.length());
-   char32_t *a = v.data();
-   StringIterator iter(string);
-   while (iter.hasNext()) {
-      *a++ = iter.next();
+   while (length--) {
+      *dest++ = (*src > 0xff) ? '?' : (uchar) *src;
+      ++src;
    }
-   v.resize(a - v.data());
-   return v;
 }
 
-template <typename StringView>
-StringView pdk_trimmed(StringView str) noexcept;
-
-} // anonymous namespace
-
-namespace internal {
-
-void utf16_from_latin1(char16_t *dest, const char *str, size_t size) noexcept
+#if defined(__SSE2__)
+void from_latin1_sse2(char16_t *dest, const char *str, size_t size)
 {
    /* SIMD:
     * Unpacking with SSE has been shown to improve performance on recent CPUs
     * The same method gives no improvement with NEON.
     */
-#if defined(__SSE2__)
    const char *end = str + size;
    pdk::ptrdiff offset = 0;
    // we're going to read str[offset..offset+15] (16 bytes)
@@ -636,17 +941,13 @@ void utf16_from_latin1(char16_t *dest, const char *str, size_t size) noexcept
    str += offset;
 #  if !defined(__OPTIMIZE_SIZE__)
    return UnrollTailLoop<15>::exec(static_cast<int>(size), [=](int i) { dest[i] = static_cast<uchar>(str[i]); });
+#  else
+   from_latin1_scalar(dest, str, size);
 #  endif
-#endif
-   // @TODO optimized for __mips_dsp
-   while (--size) {
-      *dest++ = static_cast<uchar>(*str++);
-   }
 }
 
-void utf16_to_latin1(uchar *dest, const char16_t *src, int length)
+void to_latin1_sse2(uchar *dest, const char16_t *src, int length)
 {
-#if defined(__SSE2__)
    uchar *e = dest + length;
    pdk::ptrdiff offset = 0;
    
@@ -669,12 +970,151 @@ void utf16_to_latin1(uchar *dest, const char16_t *src, int length)
    
 #  if !defined(__OPTIMIZE_SIZE__)
    return UnrollTailLoop<15>::exec(length, [=](int i) { dest[i] = (src[i]>0xff) ? '?' : (uchar) src[i]; });
+#  else
+   to_latin1_scalar(dest, src, length);
 #  endif
+}
 #endif
-   while (length--) {
-      *dest++ = (*src > 0xff) ? '?' : (uchar) *src;
-      ++src;
+
+#ifdef PDK_SIMD_DISPATCH_X86
+PDK_FUNCTION_TARGET(AVX2) void from_latin1_avx2(char16_t *dest, const char *str, size_t size)
+{
+   size_t offset = 0;
+   // 32 characters a step, zero extended a half at a time
+   for ( ; offset + 32 <= size; offset += 32) {
+      const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str + offset));
+      const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str + offset + 16));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + offset), _mm256_cvtepu8_epi16(low));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + offset + 16), _mm256_cvtepu8_epi16(high));
+   }
+   if (offset + 16 <= size) {
+      const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(str + offset));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + offset), _mm256_cvtepu8_epi16(chunk));
+      offset += 16;
+   }
+   from_latin1_scalar(dest + offset, str + offset, size - offset);
+}
+
+PDK_FUNCTION_TARGET(AVX2) void to_latin1_avx2(uchar *dest, const char16_t *src, int length)
+{
+   const __m256i latin1Max = _mm256_set1_epi16(0xff);
+   const __m256i questionMark = _mm256_set1_epi16('?');
+   int offset = 0;
+   // 32 characters a step
+   for ( ; offset + 32 <= length; offset += 32) {
+      __m256i chunk1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + offset));
+      __m256i chunk2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + offset + 16));
+      // the characters above U+00FF become question marks
+      chunk1 = _mm256_blendv_epi8(questionMark, chunk1,
+                                  _mm256_cmpeq_epi16(_mm256_min_epu16(chunk1, latin1Max), chunk1));
+      chunk2 = _mm256_blendv_epi8(questionMark, chunk2,
+                                  _mm256_cmpeq_epi16(_mm256_min_epu16(chunk2, latin1Max), chunk2));
+      // packus works inside the 128-bit lanes, put the quadwords back in order
+      const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(chunk1, chunk2), 0xd8);
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + offset), packed);
+   }
+#  ifdef __SSE2__
+   to_latin1_sse2(dest + offset, src + offset, length - offset);
+#  else
+   to_latin1_scalar(dest + offset, src + offset, length - offset);
+#  endif
+}
+#endif
+
+const SimdKernel<FromLatin1Function> &from_latin1_kernel()
+{
+   static const SimdKernel<FromLatin1Function> kernels[] = {
+#ifdef PDK_SIMD_DISPATCH_X86
+      {CPU_FEATURE_BIT(AVX2), from_latin1_avx2, "avx2"},
+#endif
+#ifdef __SSE2__
+      {0, from_latin1_sse2, "sse2"},
+#endif
+      {0, from_latin1_scalar, "scalar"}
+   };
+   static const SimdKernel<FromLatin1Function> &kernel = select_simd_kernel(kernels);
+   return kernel;
+}
+
+const SimdKernel<ToLatin1Function> &to_latin1_kernel()
+{
+   static const SimdKernel<ToLatin1Function> kernels[] = {
+#ifdef PDK_SIMD_DISPATCH_X86
+      {CPU_FEATURE_BIT(AVX2), to_latin1_avx2, "avx2"},
+#endif
+#ifdef __SSE2__
+      {0, to_latin1_sse2, "sse2"},
+#endif
+      {0, to_latin1_scalar, "scalar"}
+   };
+   static const SimdKernel<ToLatin1Function> &kernel = select_simd_kernel(kernels);
+   return kernel;
+}
+
+ByteArray pdk_convert_to_local_8bit(StringView string)
+{
+   if (string.isNull()) {
+      return ByteArray();
+   }
+   
+#ifndef PDK_NO_TEXTCODEC
+   TextCodec *localeCodec = TextCodec::getCodecForLocale();
+   if (localeCodec)
+      return localeCodec->fromUnicode(string);
+#endif // PDK_NO_TEXTCODEC
+   return pdk_convert_to_latin1(string);
+}
+
+ByteArray pdk_convert_to_utf8(StringView str)
+{
+   if (str.isNull()) {
+      return ByteArray();
+   }
+   return Utf8::convertFromUnicode(str.data(), str.length());
+}
+
+std::vector<char32_t> pdk_convert_to_ucs4(StringView string)
+{
+   std::vector<char32_t> v(string.length());
+   char32_t *a = v.data();
+   StringIterator iter(string);
+   while (iter.hasNext()) {
+      *a++ = iter.next();
    }
+   v.resize(a - v.data());
+   return v;
+}
+
+template <typename StringView>
+StringView pdk_trimmed(StringView str) noexcept;
+
+} // anonymous namespace
+
+namespace internal {
+
+void utf16_from_latin1(char16_t *dest, const char *str, size_t size) noexcept
+{
+   from_latin1_kernel().function(dest, str, size);
+}
+
+int fold_equal_prefix(const char16_t *lhs, const char16_t *rhs, int length) noexcept
+{
+   return fold_equal_kernel().function(lhs, rhs, length);
+}
+
+int fold_equal_prefix(const char16_t *lhs, const char *rhs, int length) noexcept
+{
+   return fold_equal_latin1_kernel().function(lhs, rhs, length);
+}
+
+const char16_t *find_folded_char(const char16_t *begin, const char16_t *end, char16_t folded) noexcept
+{
+   return find_folded_kernel().function(begin, end, folded);
+}
+
+void utf16_to_latin1(uchar *dest, const char16_t *src, int length)
+{
+   to_latin1_kernel().function(dest, src, length);
 }
 
 inline bool is_upper(char ch)
@@ -1614,6 +2054,20 @@ int internal::find_string(
          REHASH(*haystack);
          ++haystack;
       }
+   } else if (internal::fold_case(needle[0]) < 0x100) {
+      // candidates start with the folded first character, which the
+      // vector search finds without folding the whole haystack
+      const char16_t first = internal::fold_case(needle[0]);
+      while (haystack <= end) {
+         haystack = internal::find_folded_char(haystack, end + 1, first);
+         if (!haystack) {
+            break;
+         }
+         if (pdk_compare_strings(sv(needle), sv(haystack), pdk::CaseSensitivity::Insensitive) == 0) {
+            return haystack - (const char16_t *)haystack0;
+         }
+         ++haystack;
+      }
    } else {
       const char16_t *haystackStart = (const char16_t *)haystack0;
       for (idx = 0; idx < sl; ++idx) {
@@ -33,7 +33,7 @@ void bm_init_skiptable(const char16_t *uc, int len, uchar *skiptable, pdk::CaseS
    } else {
       const char16_t *start = uc;
       while (l--) {
-         skiptable[internal::fold_case(uc, start) & 0xff] = l;
+         skiptable[internal::fold_case_fast(uc, start) & 0xff] = l;
          uc++;
       }
    }
@@ -74,11 +74,11 @@ inline int bm_find(const char16_t *uc, uint l, int index, const char16_t *puc, u
       }
    } else {
       while (current < end) {
-         uint skip = skiptable[internal::fold_case(current, uc) & 0xff];
+         uint skip = skiptable[internal::fold_case_fast(current, uc) & 0xff];
          if (!skip) {
             // possible match
             while (skip < pl) {
-               if (internal::fold_case(current - skip, uc) != internal::fold_case(puc + pl_minus_one - skip, puc))
+               if (internal::fold_case_fast(current - skip, uc) != internal::fold_case_fast(puc + pl_minus_one - skip, puc))
                   break;
                skip++;
             }
@@ -86,7 +86,7 @@ inline int bm_find(const char16_t *uc, uint l, int index, const char16_t *puc, u
                return (current - uc) - pl_minus_one;
             // in case we don't have a match we are a bit inefficient as we only skip by one
             // when we have the non matching char in the string.
-            if (skiptable[internal::fold_case(current - skip, uc) & 0xff] == pl)
+            if (skiptable[internal::fold_case_fast(current - skip, uc) & 0xff] == pl)
                skip = pl - skip;
             else
                skip = 1;
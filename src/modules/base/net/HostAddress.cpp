@@ -0,0 +1,211 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/net/HostAddress.h"
+#include "pdk/pal/net/NativeSocket.h"
+
+#include <cstring>
+#ifdef PDK_OS_UNIX
+#include <arpa/inet.h>
+#endif
+
+namespace pdk {
+namespace net {
+
+using pdk::ds::ByteArray;
+
+namespace {
+
+const pdk::puint8 sg_loopbackIPv6[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+
+} // anonymous
+
+HostAddress::HostAddress()
+{
+   clear();
+}
+
+HostAddress::HostAddress(SpecialAddress address)
+{
+   clear();
+   switch (address) {
+   case SpecialAddress::Null:
+      break;
+   case SpecialAddress::Broadcast:
+      setAddress(pdk::puint32(0xffffffff));
+      break;
+   case SpecialAddress::LocalHost:
+      setAddress(pdk::puint32(0x7f000001));
+      break;
+   case SpecialAddress::LocalHostIPv6:
+      setAddress(sg_loopbackIPv6);
+      break;
+   case SpecialAddress::AnyIPv6:
+      m_protocol = NetworkLayerProtocol::IPv6Protocol;
+      break;
+   case SpecialAddress::AnyIPv4:
+      setAddress(pdk::puint32(0));
+      break;
+   case SpecialAddress::Any:
+      m_protocol = NetworkLayerProtocol::AnyIPProtocol;
+      break;
+   }
+}
+
+HostAddress::HostAddress(pdk::puint32 ip4Address)
+{
+   setAddress(ip4Address);
+}
+
+HostAddress::HostAddress(const pdk::puint8 *ip6Address)
+{
+   setAddress(ip6Address);
+}
+
+HostAddress::HostAddress(const String &address)
+{
+   setAddress(address);
+}
+
+HostAddress::HostAddress(const sockaddr *address)
+{
+   setAddress(address);
+}
+
+void HostAddress::clear()
+{
+   m_protocol = NetworkLayerProtocol::UnknownNetworkLayerProtocol;
+   m_ip4 = 0;
+   std::memset(m_ip6, 0, sizeof(m_ip6));
+}
+
+void HostAddress::setAddress(pdk::puint32 ip4Address)
+{
+   clear();
+   m_protocol = NetworkLayerProtocol::IPv4Protocol;
+   m_ip4 = ip4Address;
+}
+
+void HostAddress::setAddress(const pdk::puint8 *ip6Address)
+{
+   clear();
+   m_protocol = NetworkLayerProtocol::IPv6Protocol;
+   std::memcpy(m_ip6, ip6Address, sizeof(m_ip6));
+}
+
+bool HostAddress::setAddress(const String &address)
+{
+   clear();
+   const ByteArray latin1 = address.trimmed().toLatin1();
+   in_addr ip4;
+   if (::inet_pton(AF_INET, latin1.getConstRawData(), &ip4) == 1) {
+      setAddress(ntohl(ip4.s_addr));
+      return true;
+   }
+   in6_addr ip6;
+   if (::inet_pton(AF_INET6, latin1.getConstRawData(), &ip6) == 1) {
+      setAddress(reinterpret_cast<const pdk::puint8 *>(&ip6));
+      return true;
+   }
+   return false;
+}
+
+bool HostAddress::setAddress(const sockaddr *address)
+{
+   clear();
+   if (address->sa_family == AF_INET) {
+      setAddress(ntohl(reinterpret_cast<const sockaddr_in *>(address)->sin_addr.s_addr));
+      return true;
+   }
+   if (address->sa_family == AF_INET6) {
+      setAddress(reinterpret_cast<const pdk::puint8 *>(&reinterpret_cast<const sockaddr_in6 *>(address)->sin6_addr));
+      return true;
+   }
+   return false;
+}
+
+pdk::puint32 HostAddress::toIPv4Address(bool *ok) const
+{
+   if (m_protocol == NetworkLayerProtocol::IPv4Protocol) {
+      if (ok) {
+         *ok = true;
+      }
+      return m_ip4;
+   }
+   // IPv4 mapped IPv6 addresses
+   static const pdk::puint8 mappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+   if (m_protocol == NetworkLayerProtocol::IPv6Protocol &&
+       std::memcmp(m_ip6, mappedPrefix, sizeof(mappedPrefix)) == 0) {
+      if (ok) {
+         *ok = true;
+      }
+      return (pdk::puint32(m_ip6[12]) << 24) | (pdk::puint32(m_ip6[13]) << 16) |
+            (pdk::puint32(m_ip6[14]) << 8) | pdk::puint32(m_ip6[15]);
+   }
+   if (ok) {
+      *ok = false;
+   }
+   return 0;
+}
+
+String HostAddress::toString() const
+{
+   char buffer[INET6_ADDRSTRLEN];
+   if (m_protocol == NetworkLayerProtocol::IPv4Protocol) {
+      in_addr ip4;
+      ip4.s_addr = htonl(m_ip4);
+      if (::inet_ntop(AF_INET, &ip4, buffer, sizeof(buffer))) {
+         return String::fromLatin1(buffer);
+      }
+   } else if (m_protocol == NetworkLayerProtocol::IPv6Protocol) {
+      if (::inet_ntop(AF_INET6, m_ip6, buffer, sizeof(buffer))) {
+         return String::fromLatin1(buffer);
+      }
+   }
+   return String();
+}
+
+bool HostAddress::isNull() const
+{
+   return m_protocol == NetworkLayerProtocol::UnknownNetworkLayerProtocol;
+}
+
+bool HostAddress::isLoopback() const
+{
+   if (m_protocol == NetworkLayerProtocol::IPv4Protocol) {
+      return (m_ip4 & 0xff000000) == 0x7f000000;
+   }
+   if (m_protocol == NetworkLayerProtocol::IPv6Protocol) {
+      bool ok;
+      pdk::puint32 ip4 = toIPv4Address(&ok);
+      return ok ? (ip4 & 0xff000000) == 0x7f000000
+                : std::memcmp(m_ip6, sg_loopbackIPv6, sizeof(m_ip6)) == 0;
+   }
+   return false;
+}
+
+bool HostAddress::operator ==(const HostAddress &other) const
+{
+   if (m_protocol != other.m_protocol) {
+      return false;
+   }
+   if (m_protocol == NetworkLayerProtocol::IPv4Protocol) {
+      return m_ip4 == other.m_ip4;
+   }
+   return std::memcmp(m_ip6, other.m_ip6, sizeof(m_ip6)) == 0;
+}
+
+} // net
+} // pdk
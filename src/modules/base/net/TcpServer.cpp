@@ -0,0 +1,319 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/net/TcpServer.h"
+#include "pdk/base/net/internal/TcpSocketPrivate.h"
+#include "pdk/base/net/internal/SocketEnginePrivate.h"
+#include "pdk/base/os/thread/internal/ThreadPrivate.h"
+#include "pdk/kernel/internal/ObjectPrivate.h"
+#include "pdk/global/Logging.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <list>
+
+namespace pdk {
+namespace net {
+
+using pdk::kernel::SocketNotifier;
+
+namespace internal {
+
+using pdk::kernel::internal::ObjectPrivate;
+using pdk::pal::net::MaxAcceptBatch;
+
+class TcpServerPrivate : public ObjectPrivate
+{
+   PDK_DECLARE_PUBLIC(TcpServer);
+public:
+   TcpServerPrivate();
+
+   void setErrorFromErrno(int errorCode);
+   void resetSocketLayer();
+   void updateNotifier();
+   void readNotification();
+
+   std::list<TcpSocket *> m_pendingConnections;
+   int m_socketDescriptor;
+   int m_maxConnections;
+   HostAddress m_address;
+   pdk::puint16 m_port;
+   SocketNotifier *m_notifier;
+   TcpSocket::SocketError m_serverSocketError;
+   String m_serverSocketErrorString;
+   TcpServer::NewConnectionHandler m_newConnectionHandler;
+   bool m_acceptingPaused;
+};
+
+using TcpServerNotifier = SocketEngineNotifier<TcpServerPrivate>;
+
+TcpServerPrivate::TcpServerPrivate()
+   : m_socketDescriptor(-1),
+     m_maxConnections(30),
+     m_port(0),
+     m_notifier(nullptr),
+     m_serverSocketError(TcpSocket::SocketError::UnknownSocketError),
+     m_acceptingPaused(false)
+{
+}
+
+void TcpServerPrivate::setErrorFromErrno(int errorCode)
+{
+   m_serverSocketError = TcpSocketPrivate::translateError(errorCode);
+   m_serverSocketErrorString = pdk::error_string(errorCode);
+}
+
+void TcpServerPrivate::resetSocketLayer()
+{
+   destroy_socket_notifier(m_notifier);
+   if (m_socketDescriptor != -1) {
+      pdk::pal::net::close_socket(m_socketDescriptor);
+      m_socketDescriptor = -1;
+   }
+}
+
+void TcpServerPrivate::updateNotifier()
+{
+   // connections beyond the limit wait in the kernel backlog
+   if (m_notifier) {
+      m_notifier->setEnabled(!m_acceptingPaused &&
+                             static_cast<int>(m_pendingConnections.size()) < m_maxConnections);
+   }
+}
+
+void TcpServerPrivate::readNotification()
+{
+   PDK_Q(TcpServer);
+   const int room = m_maxConnections - static_cast<int>(m_pendingConnections.size());
+   if (room <= 0 || m_socketDescriptor == -1) {
+      updateNotifier();
+      return;
+   }
+   // drain the backlog in one go rather than one connection per wakeup
+   int accepted[MaxAcceptBatch];
+   const int count = pdk::pal::net::accept_connections(m_socketDescriptor, accepted,
+                                                       std::min(room, static_cast<int>(MaxAcceptBatch)));
+   if (count < 0) {
+      setErrorFromErrno(errno);
+      // @TODO emit signal
+      // emit q->acceptError(m_serverSocketError);
+      return;
+   }
+   for (int i = 0; i < count; ++i) {
+      apiPtr->incomingConnection(accepted[i]);
+   }
+   updateNotifier();
+   if (count > 0 && m_newConnectionHandler) {
+      // @TODO emit signal
+      // emit q->newConnection();
+      TcpServer::NewConnectionHandler handler = m_newConnectionHandler;
+      handler();
+   }
+}
+
+} // internal
+
+TcpServer::TcpServer(Object *parent)
+   : Object(*new TcpServerPrivate, parent)
+{
+}
+
+TcpServer::~TcpServer()
+{
+   close();
+}
+
+bool TcpServer::listen(const HostAddress &address, pdk::puint16 port)
+{
+   PDK_D(TcpServer);
+   if (implPtr->m_socketDescriptor != -1) {
+      warning_stream("TcpServer::listen() called when already listening");
+      return false;
+   }
+   HostAddress bindAddress = address;
+   int fd = pdk::pal::net::create_socket(internal::get_address_family(bindAddress), SOCK_STREAM);
+   if (fd == -1 && errno == EAFNOSUPPORT &&
+       bindAddress.getProtocol() == HostAddress::NetworkLayerProtocol::AnyIPProtocol) {
+      // no IPv6 on this host
+      bindAddress = HostAddress::SpecialAddress::AnyIPv4;
+      fd = pdk::pal::net::create_socket(AF_INET, SOCK_STREAM);
+   }
+   if (fd == -1) {
+      implPtr->setErrorFromErrno(errno);
+      return false;
+   }
+   if (bindAddress.getProtocol() == HostAddress::NetworkLayerProtocol::AnyIPProtocol) {
+      pdk::pal::net::set_socket_option(fd, IPPROTO_IPV6, IPV6_V6ONLY, 0);
+   }
+   pdk::pal::net::set_socket_option(fd, SOL_SOCKET, SO_REUSEADDR, 1);
+   sockaddr_storage storage;
+   const socklen_t length = internal::to_sockaddr(bindAddress, port, &storage);
+   if (pdk::pal::net::bind_socket(fd, reinterpret_cast<sockaddr *>(&storage), length) == -1 ||
+       pdk::pal::net::listen_socket(fd, SOMAXCONN) == -1) {
+      implPtr->setErrorFromErrno(errno);
+      pdk::pal::net::close_socket(fd);
+      return false;
+   }
+   implPtr->m_socketDescriptor = fd;
+   internal::get_local_address(fd, &implPtr->m_address, &implPtr->m_port);
+   if (implPtr->m_threadData->hasEventDispatcher()) {
+      implPtr->m_notifier = new internal::TcpServerNotifier(fd, SocketNotifier::Type::Read, implPtr,
+                                                            &TcpServerPrivate::readNotification, this);
+      implPtr->updateNotifier();
+   }
+   return true;
+}
+
+void TcpServer::close()
+{
+   PDK_D(TcpServer);
+   for (TcpSocket *socket : implPtr->m_pendingConnections) {
+      delete socket;
+   }
+   implPtr->m_pendingConnections.clear();
+   implPtr->resetSocketLayer();
+   implPtr->m_address.clear();
+   implPtr->m_port = 0;
+}
+
+bool TcpServer::isListening() const
+{
+   PDK_D(const TcpServer);
+   return implPtr->m_socketDescriptor != -1;
+}
+
+void TcpServer::setMaxPendingConnections(int count)
+{
+   PDK_D(TcpServer);
+   implPtr->m_maxConnections = count;
+   implPtr->updateNotifier();
+}
+
+int TcpServer::getMaxPendingConnections() const
+{
+   PDK_D(const TcpServer);
+   return implPtr->m_maxConnections;
+}
+
+pdk::puint16 TcpServer::getServerPort() const
+{
+   PDK_D(const TcpServer);
+   return implPtr->m_port;
+}
+
+HostAddress TcpServer::getServerAddress() const
+{
+   PDK_D(const TcpServer);
+   return implPtr->m_address;
+}
+
+int TcpServer::getSocketDescriptor() const
+{
+   PDK_D(const TcpServer);
+   return implPtr->m_socketDescriptor;
+}
+
+bool TcpServer::waitForNewConnection(int msecs, bool *timedOut)
+{
+   PDK_D(TcpServer);
+   if (timedOut) {
+      *timedOut = false;
+   }
+   if (implPtr->m_socketDescriptor == -1) {
+      return false;
+   }
+   if (hasPendingConnections()) {
+      return true;
+   }
+   const int ret = internal::wait_for_socket(implPtr->m_socketDescriptor, true, false, msecs);
+   if (ret == 0) {
+      if (timedOut) {
+         *timedOut = true;
+      }
+      return false;
+   }
+   if (ret < 0) {
+      implPtr->setErrorFromErrno(errno);
+      return false;
+   }
+   implPtr->readNotification();
+   return hasPendingConnections();
+}
+
+bool TcpServer::hasPendingConnections() const
+{
+   PDK_D(const TcpServer);
+   return !implPtr->m_pendingConnections.empty();
+}
+
+TcpSocket *TcpServer::nextPendingConnection()
+{
+   PDK_D(TcpServer);
+   if (implPtr->m_pendingConnections.empty()) {
+      return nullptr;
+   }
+   TcpSocket *socket = implPtr->m_pendingConnections.front();
+   implPtr->m_pendingConnections.pop_front();
+   implPtr->updateNotifier();
+   return socket;
+}
+
+TcpSocket::SocketError TcpServer::getServerError() const
+{
+   PDK_D(const TcpServer);
+   return implPtr->m_serverSocketError;
+}
+
+String TcpServer::getErrorString() const
+{
+   PDK_D(const TcpServer);
+   return implPtr->m_serverSocketErrorString;
+}
+
+void TcpServer::pauseAccepting()
+{
+   PDK_D(TcpServer);
+   implPtr->m_acceptingPaused = true;
+   implPtr->updateNotifier();
+}
+
+void TcpServer::resumeAccepting()
+{
+   PDK_D(TcpServer);
+   implPtr->m_acceptingPaused = false;
+   implPtr->updateNotifier();
+}
+
+void TcpServer::setNewConnectionHandler(const NewConnectionHandler &handler)
+{
+   PDK_D(TcpServer);
+   implPtr->m_newConnectionHandler = handler;
+}
+
+void TcpServer::incomingConnection(int socketDescriptor)
+{
+   TcpSocket *socket = new TcpSocket(this);
+   socket->setSocketDescriptor(socketDescriptor);
+   addPendingConnection(socket);
+}
+
+void TcpServer::addPendingConnection(TcpSocket *socket)
+{
+   PDK_D(TcpServer);
+   implPtr->m_pendingConnections.push_back(socket);
+}
+
+} // net
+} // pdk
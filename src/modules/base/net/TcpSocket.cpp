@@ -0,0 +1,767 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/net/TcpSocket.h"
+#include "pdk/base/net/internal/TcpSocketPrivate.h"
+#include "pdk/base/net/internal/SocketEnginePrivate.h"
+#include "pdk/base/os/thread/internal/ThreadPrivate.h"
+#include "pdk/kernel/ElapsedTimer.h"
+#include "pdk/global/Logging.h"
+
+#include <algorithm>
+#include <cerrno>
+
+namespace pdk {
+namespace net {
+
+using pdk::lang::Latin1String;
+using pdk::kernel::ElapsedTimer;
+using pdk::io::internal::substract_from_timeout;
+
+namespace internal {
+
+using pdk::pal::net::MaxGatherSegments;
+using TcpSocketNotifier = SocketEngineNotifier<TcpSocketPrivate>;
+
+TcpSocketPrivate::TcpSocketPrivate()
+   : m_socketDescriptor(-1),
+     m_state(TcpSocket::SocketState::UnconnectedState),
+     m_socketError(TcpSocket::SocketError::UnknownSocketError),
+     m_localPort(0),
+     m_peerPort(0),
+     m_readBufferMaxSize(0),
+     m_readNotifier(nullptr),
+     m_writeNotifier(nullptr),
+     m_noDelay(false)
+{
+   m_readBufferChunkSize = PDK_RING_BUFFER_CHUNK_SIZE;
+   m_writeBufferChunkSize = PDK_RING_BUFFER_CHUNK_SIZE;
+}
+
+TcpSocketPrivate::~TcpSocketPrivate()
+{
+}
+
+bool TcpSocketPrivate::initSocket(int fd, TcpSocket::SocketState state)
+{
+   m_socketDescriptor = fd;
+   if (m_noDelay) {
+      pdk::pal::net::set_socket_option(fd, IPPROTO_TCP, TCP_NODELAY, 1);
+   }
+   setState(state);
+   if (state == TcpSocket::SocketState::ConnectedState) {
+      fetchConnectionParameters();
+   }
+   setupNotifiers();
+   return true;
+}
+
+void TcpSocketPrivate::resetSocketLayer()
+{
+   destroy_socket_notifier(m_readNotifier);
+   destroy_socket_notifier(m_writeNotifier);
+   if (m_socketDescriptor != -1) {
+      pdk::pal::net::close_socket(m_socketDescriptor);
+      m_socketDescriptor = -1;
+   }
+}
+
+void TcpSocketPrivate::setupNotifiers()
+{
+   // without an event loop the socket is driven by the waitFor functions
+   if (!m_threadData->hasEventDispatcher()) {
+      return;
+   }
+   PDK_Q(TcpSocket);
+   m_readNotifier = new TcpSocketNotifier(m_socketDescriptor, SocketNotifier::Type::Read, this,
+                                          &TcpSocketPrivate::readNotification, apiPtr);
+   m_writeNotifier = new TcpSocketNotifier(m_socketDescriptor, SocketNotifier::Type::Write, this,
+                                           &TcpSocketPrivate::writeNotification, apiPtr);
+   updateReadNotifier();
+   updateWriteNotifier();
+}
+
+void TcpSocketPrivate::connectionLost(TcpSocket::SocketError error, int errorCode)
+{
+   const bool wasConnected = m_state == TcpSocket::SocketState::ConnectedState ||
+         m_state == TcpSocket::SocketState::ClosingState;
+   resetSocketLayer();
+   // unsent data has nowhere to go, what was read stays readable
+   m_writeBuffer.clear();
+   setState(TcpSocket::SocketState::UnconnectedState);
+   setError(error, errorCode);
+   if (wasConnected && m_disconnectedHandler) {
+      TcpSocket::DisconnectedHandler handler = m_disconnectedHandler;
+      handler();
+   }
+}
+
+bool TcpSocketPrivate::isReadBufferFull() const
+{
+   return m_readBufferMaxSize > 0 && m_buffer.size() >= m_readBufferMaxSize;
+}
+
+void TcpSocketPrivate::setError(TcpSocket::SocketError error, int errorCode)
+{
+   m_socketError = error;
+   if (errorCode != 0) {
+      m_errorString = pdk::error_string(errorCode);
+   } else {
+      switch (error) {
+      case TcpSocket::SocketError::ConnectionRefusedError:
+         m_errorString = Latin1String("Connection refused");
+         break;
+      case TcpSocket::SocketError::RemoteHostClosedError:
+         m_errorString = Latin1String("The remote host closed the connection");
+         break;
+      case TcpSocket::SocketError::SocketTimeoutError:
+         m_errorString = Latin1String("Socket operation timed out");
+         break;
+      case TcpSocket::SocketError::UnsupportedSocketOperationError:
+         m_errorString = Latin1String("Unsupported socket operation");
+         break;
+      default:
+         m_errorString = Latin1String("Unknown error");
+         break;
+      }
+   }
+   // @TODO emit signal
+   // emit q->errorOccurred(error);
+   if (m_errorHandler) {
+      TcpSocket::ErrorHandler handler = m_errorHandler;
+      handler(error);
+   }
+}
+
+TcpSocket::SocketError TcpSocketPrivate::translateError(int errorCode)
+{
+   switch (errorCode) {
+   case ECONNREFUSED:
+      return TcpSocket::SocketError::ConnectionRefusedError;
+   case ECONNRESET:
+   case EPIPE:
+      return TcpSocket::SocketError::RemoteHostClosedError;
+   case EACCES:
+   case EPERM:
+      return TcpSocket::SocketError::SocketAccessError;
+   case EMFILE:
+   case ENFILE:
+   case ENOBUFS:
+   case ENOMEM:
+      return TcpSocket::SocketError::SocketResourceError;
+   case ETIMEDOUT:
+      return TcpSocket::SocketError::SocketTimeoutError;
+   case EADDRINUSE:
+   case EADDRNOTAVAIL:
+      return TcpSocket::SocketError::AddressInUseError;
+   case ENETDOWN:
+   case ENETUNREACH:
+   case EHOSTUNREACH:
+      return TcpSocket::SocketError::NetworkError;
+   case EAFNOSUPPORT:
+   case EPROTONOSUPPORT:
+   case EOPNOTSUPP:
+      return TcpSocket::SocketError::UnsupportedSocketOperationError;
+   default:
+      return TcpSocket::SocketError::UnknownSocketError;
+   }
+}
+
+void TcpSocketPrivate::setErrorFromErrno(int errorCode)
+{
+   setError(translateError(errorCode), errorCode);
+}
+
+void TcpSocketPrivate::setState(TcpSocket::SocketState state)
+{
+   if (m_state == state) {
+      return;
+   }
+   m_state = state;
+   // @TODO emit signal
+   // emit q->stateChanged(state);
+}
+
+void TcpSocketPrivate::fetchConnectionParameters()
+{
+   get_local_address(m_socketDescriptor, &m_localAddress, &m_localPort);
+   get_peer_address(m_socketDescriptor, &m_peerAddress, &m_peerPort);
+}
+
+void TcpSocketPrivate::disconnectFinished()
+{
+   PDK_Q(TcpSocket);
+   resetSocketLayer();
+   setState(TcpSocket::SocketState::UnconnectedState);
+   m_localAddress.clear();
+   m_localPort = 0;
+   m_peerAddress.clear();
+   m_peerPort = 0;
+   if (m_disconnectedHandler) {
+      TcpSocket::DisconnectedHandler handler = m_disconnectedHandler;
+      handler();
+   }
+   apiPtr->IoDevice::close();
+}
+
+void TcpSocketPrivate::updateReadNotifier()
+{
+   if (m_readNotifier) {
+      m_readNotifier->setEnabled(m_state == TcpSocket::SocketState::ConnectedState &&
+                                 !isReadBufferFull());
+   }
+}
+
+void TcpSocketPrivate::updateWriteNotifier()
+{
+   // a level triggered notifier on an idle socket would fire in a loop
+   if (m_writeNotifier) {
+      m_writeNotifier->setEnabled(m_state == TcpSocket::SocketState::ConnectingState ||
+                                  !m_writeBuffer.isEmpty());
+   }
+}
+
+void TcpSocketPrivate::readNotification()
+{
+   const bool hasNewData = readFromSocket();
+   updateReadNotifier();
+   if (hasNewData && m_readyReadHandler) {
+      // @TODO emit signal
+      // emit q->readyRead();
+      TcpSocket::ReadyReadHandler handler = m_readyReadHandler;
+      handler();
+   }
+}
+
+void TcpSocketPrivate::writeNotification()
+{
+   if (m_state == TcpSocket::SocketState::ConnectingState && !connectionNotification()) {
+      return;
+   }
+   writeToSocket();
+   updateWriteNotifier();
+}
+
+bool TcpSocketPrivate::connectionNotification()
+{
+   const int errorCode = pdk::pal::net::get_socket_error(m_socketDescriptor);
+   if (errorCode != 0) {
+      resetSocketLayer();
+      setState(TcpSocket::SocketState::UnconnectedState);
+      setErrorFromErrno(errorCode);
+      return false;
+   }
+   setState(TcpSocket::SocketState::ConnectedState);
+   fetchConnectionParameters();
+   updateReadNotifier();
+   updateWriteNotifier();
+   // @TODO emit signal
+   // emit q->connected();
+   if (m_connectedHandler) {
+      TcpSocket::ConnectedHandler handler = m_connectedHandler;
+      handler();
+   }
+   return m_state == TcpSocket::SocketState::ConnectedState;
+}
+
+bool TcpSocketPrivate::readFromSocket()
+{
+   if (m_socketDescriptor == -1 || isReadBufferFull()) {
+      return false;
+   }
+   pdk::pint64 available = pdk::pal::net::bytes_available(m_socketDescriptor);
+   if (available <= 0) {
+      // nothing queued on a readable socket means end of file, read
+      // anyway to tell it apart from data arriving right now
+      available = 4096;
+   }
+   if (m_readBufferMaxSize > 0) {
+      available = std::min(available, m_readBufferMaxSize - m_buffer.size());
+   }
+   pdk::pint64 readBytes;
+   // taken right after the read, chop() may allocate and clobber errno
+   int errorCode = 0;
+   if (!m_readBuffers.empty()) {
+      char *ptr = m_buffer.reserve(available);
+      readBytes = pdk::pal::net::read_socket(m_socketDescriptor, ptr, available);
+      errorCode = errno;
+      m_buffer.chop(available - std::max(readBytes, static_cast<pdk::pint64>(0)));
+   } else {
+      // opened write only, the input is discarded
+      char discard[4096];
+      readBytes = pdk::pal::net::read_socket(m_socketDescriptor, discard,
+                                             std::min(available, static_cast<pdk::pint64>(sizeof(discard))));
+      errorCode = errno;
+   }
+   if (readBytes == -1) {
+      if (errorCode == EAGAIN || errorCode == EWOULDBLOCK) {
+         return false;
+      }
+      connectionLost(TcpSocket::SocketError::NetworkError, errorCode);
+      return false;
+   }
+   if (readBytes == 0) {
+      connectionLost(TcpSocket::SocketError::RemoteHostClosedError);
+      return false;
+   }
+   return !m_readBuffers.empty();
+}
+
+bool TcpSocketPrivate::writeToSocket()
+{
+   if (m_socketDescriptor == -1 || m_writeBuffer.isEmpty() ||
+       m_state == TcpSocket::SocketState::ConnectingState) {
+      return false;
+   }
+   // hand every queued chunk to the kernel in one system call instead of
+   // one write per chunk
+   iovec segments[MaxGatherSegments];
+   int count = 0;
+   pdk::pint64 position = 0;
+   while (count < MaxGatherSegments) {
+      pdk::pint64 length;
+      const char *ptr = m_writeBuffer.readPointerAtPosition(position, length);
+      if (length <= 0) {
+         break;
+      }
+      segments[count].iov_base = const_cast<char *>(ptr);
+      segments[count].iov_len = static_cast<size_t>(length);
+      position += length;
+      ++count;
+   }
+   const pdk::pint64 written = pdk::pal::net::gather_write(m_socketDescriptor, segments, count);
+   if (written < 0) {
+      const int errorCode = errno;
+      connectionLost(errorCode == EPIPE || errorCode == ECONNRESET
+                     ? TcpSocket::SocketError::RemoteHostClosedError
+                     : TcpSocket::SocketError::NetworkError, errorCode);
+      return false;
+   }
+   if (written == 0) {
+      return false;
+   }
+   m_writeBuffer.free(written);
+   // @TODO emit signal
+   // emit q->bytesWritten(written);
+   if (m_bytesWrittenHandler) {
+      TcpSocket::BytesWrittenHandler handler = m_bytesWrittenHandler;
+      handler(written);
+   }
+   if (m_writeBuffer.isEmpty() && m_state == TcpSocket::SocketState::ClosingState) {
+      disconnectFinished();
+   }
+   return true;
+}
+
+} // internal
+
+TcpSocket::TcpSocket(Object *parent)
+   : IoDevice(*new TcpSocketPrivate, parent)
+{
+}
+
+TcpSocket::~TcpSocket()
+{
+   PDK_D(TcpSocket);
+   implPtr->m_connectedHandler = nullptr;
+   implPtr->m_disconnectedHandler = nullptr;
+   implPtr->m_readyReadHandler = nullptr;
+   implPtr->m_bytesWrittenHandler = nullptr;
+   implPtr->m_errorHandler = nullptr;
+   if (implPtr->m_state != SocketState::UnconnectedState) {
+      abort();
+   }
+   implPtr->resetSocketLayer();
+}
+
+void TcpSocket::connectToHost(const HostAddress &address, pdk::puint16 port, OpenModes mode)
+{
+   PDK_D(TcpSocket);
+   if (implPtr->m_state == SocketState::ConnectedState ||
+       implPtr->m_state == SocketState::ConnectingState ||
+       implPtr->m_state == SocketState::ClosingState) {
+      warning_stream("TcpSocket::connectToHost() called when already connecting/connected to \"%s\"",
+                     implPtr->m_peerAddress.toString().toLocal8Bit().getConstRawData());
+      return;
+   }
+   implPtr->resetSocketLayer();
+   IoDevice::open(mode);
+   implPtr->m_peerAddress = address;
+   implPtr->m_peerPort = port;
+   sockaddr_storage storage;
+   const socklen_t length = internal::to_sockaddr(address, port, &storage);
+   if (length == 0) {
+      implPtr->setError(SocketError::UnsupportedSocketOperationError);
+      return;
+   }
+   const int fd = pdk::pal::net::create_socket(internal::get_address_family(address), SOCK_STREAM);
+   if (fd == -1) {
+      implPtr->setErrorFromErrno(errno);
+      return;
+   }
+   implPtr->initSocket(fd, SocketState::ConnectingState);
+   if (pdk::pal::net::connect_socket(fd, reinterpret_cast<sockaddr *>(&storage), length) == 0) {
+      implPtr->connectionNotification();
+   } else if (errno != EINPROGRESS) {
+      const int errorCode = errno;
+      implPtr->resetSocketLayer();
+      implPtr->setState(SocketState::UnconnectedState);
+      implPtr->setErrorFromErrno(errorCode);
+   }
+   // otherwise the write notifier fires once the handshake is done
+}
+
+void TcpSocket::disconnectFromHost()
+{
+   PDK_D(TcpSocket);
+   if (implPtr->m_state == SocketState::UnconnectedState ||
+       implPtr->m_state == SocketState::ClosingState) {
+      return;
+   }
+   if (implPtr->m_state == SocketState::ConnectingState) {
+      implPtr->resetSocketLayer();
+      implPtr->setState(SocketState::UnconnectedState);
+      IoDevice::close();
+      return;
+   }
+   implPtr->setState(SocketState::ClosingState);
+   implPtr->updateReadNotifier();
+   if (implPtr->m_writeBuffer.isEmpty()) {
+      implPtr->disconnectFinished();
+   } else {
+      // the rest is flushed from the event loop or waitForDisconnected()
+      implPtr->updateWriteNotifier();
+   }
+}
+
+void TcpSocket::abort()
+{
+   PDK_D(TcpSocket);
+   const bool wasConnected = implPtr->m_state == SocketState::ConnectedState ||
+         implPtr->m_state == SocketState::ClosingState;
+   implPtr->m_writeBuffer.clear();
+   implPtr->resetSocketLayer();
+   implPtr->setState(SocketState::UnconnectedState);
+   if (wasConnected && implPtr->m_disconnectedHandler) {
+      DisconnectedHandler handler = implPtr->m_disconnectedHandler;
+      handler();
+   }
+   IoDevice::close();
+}
+
+bool TcpSocket::setSocketDescriptor(int socketDescriptor, SocketState state, OpenModes mode)
+{
+   PDK_D(TcpSocket);
+   if (!pdk::pal::net::set_nonblocking(socketDescriptor)) {
+      implPtr->setErrorFromErrno(errno);
+      return false;
+   }
+   implPtr->resetSocketLayer();
+   IoDevice::open(mode);
+   return implPtr->initSocket(socketDescriptor, state);
+}
+
+int TcpSocket::getSocketDescriptor() const
+{
+   PDK_D(const TcpSocket);
+   return implPtr->m_socketDescriptor;
+}
+
+bool TcpSocket::isValid() const
+{
+   PDK_D(const TcpSocket);
+   return implPtr->m_socketDescriptor != -1;
+}
+
+HostAddress TcpSocket::getLocalAddress() const
+{
+   PDK_D(const TcpSocket);
+   return implPtr->m_localAddress;
+}
+
+pdk::puint16 TcpSocket::getLocalPort() const
+{
+   PDK_D(const TcpSocket);
+   return implPtr->m_localPort;
+}
+
+HostAddress TcpSocket::getPeerAddress() const
+{
+   PDK_D(const TcpSocket);
+   return implPtr->m_peerAddress;
+}
+
+pdk::puint16 TcpSocket::getPeerPort() const
+{
+   PDK_D(const TcpSocket);
+   return implPtr->m_peerPort;
+}
+
+TcpSocket::SocketState TcpSocket::getState() const
+{
+   PDK_D(const TcpSocket);
+   return implPtr->m_state;
+}
+
+TcpSocket::SocketError TcpSocket::getError() const
+{
+   PDK_D(const TcpSocket);
+   return implPtr->m_socketError;
+}
+
+void TcpSocket::setNoDelay(bool enabled)
+{
+   PDK_D(TcpSocket);
+   implPtr->m_noDelay = enabled;
+   if (implPtr->m_socketDescriptor != -1) {
+      pdk::pal::net::set_socket_option(implPtr->m_socketDescriptor, IPPROTO_TCP,
+                                       TCP_NODELAY, enabled ? 1 : 0);
+   }
+}
+
+void TcpSocket::setReadBufferSize(pdk::pint64 size)
+{
+   PDK_D(TcpSocket);
+   implPtr->m_readBufferMaxSize = size;
+   implPtr->updateReadNotifier();
+}
+
+pdk::pint64 TcpSocket::getReadBufferSize() const
+{
+   PDK_D(const TcpSocket);
+   return implPtr->m_readBufferMaxSize;
+}
+
+bool TcpSocket::flush()
+{
+   PDK_D(TcpSocket);
+   bool dataWritten = false;
+   while (implPtr->writeToSocket()) {
+      dataWritten = true;
+   }
+   implPtr->updateWriteNotifier();
+   return dataWritten;
+}
+
+bool TcpSocket::waitForConnected(int msecs)
+{
+   PDK_D(TcpSocket);
+   if (implPtr->m_state == SocketState::ConnectedState) {
+      return true;
+   }
+   if (implPtr->m_state != SocketState::ConnectingState) {
+      return false;
+   }
+   const int ret = internal::wait_for_socket(implPtr->m_socketDescriptor, false, true, msecs);
+   if (ret == 0) {
+      implPtr->setError(SocketError::SocketTimeoutError);
+      return false;
+   }
+   if (ret < 0) {
+      implPtr->setErrorFromErrno(errno);
+      return false;
+   }
+   return implPtr->connectionNotification();
+}
+
+bool TcpSocket::waitForReadyRead(int msecs)
+{
+   PDK_D(TcpSocket);
+   ElapsedTimer timer;
+   timer.start();
+   if (implPtr->m_state == SocketState::ConnectingState && !waitForConnected(msecs)) {
+      return false;
+   }
+   while (implPtr->m_socketDescriptor != -1 && !implPtr->isReadBufferFull()) {
+      bool readable = false;
+      bool writable = false;
+      const int ret = internal::wait_for_socket(implPtr->m_socketDescriptor, true,
+                                                !implPtr->m_writeBuffer.isEmpty(),
+                                                substract_from_timeout(msecs, static_cast<int>(timer.elapsed())),
+                                                &readable, &writable);
+      if (ret == 0) {
+         implPtr->setError(SocketError::SocketTimeoutError);
+         return false;
+      }
+      if (ret < 0) {
+         implPtr->setErrorFromErrno(errno);
+         return false;
+      }
+      if (readable && implPtr->readFromSocket()) {
+         if (implPtr->m_readyReadHandler) {
+            ReadyReadHandler handler = implPtr->m_readyReadHandler;
+            handler();
+         }
+         return true;
+      }
+      if (writable) {
+         implPtr->writeToSocket();
+      }
+   }
+   return false;
+}
+
+bool TcpSocket::waitForBytesWritten(int msecs)
+{
+   PDK_D(TcpSocket);
+   ElapsedTimer timer;
+   timer.start();
+   if (implPtr->m_state == SocketState::ConnectingState && !waitForConnected(msecs)) {
+      return false;
+   }
+   while (implPtr->m_socketDescriptor != -1 && !implPtr->m_writeBuffer.isEmpty()) {
+      bool readable = false;
+      bool writable = false;
+      // keep reading so that a peer blocked on its own writes does not
+      // leave both sides waiting
+      const int ret = internal::wait_for_socket(implPtr->m_socketDescriptor, !implPtr->isReadBufferFull(), true,
+                                                substract_from_timeout(msecs, static_cast<int>(timer.elapsed())),
+                                                &readable, &writable);
+      if (ret == 0) {
+         implPtr->setError(SocketError::SocketTimeoutError);
+         return false;
+      }
+      if (ret < 0) {
+         implPtr->setErrorFromErrno(errno);
+         return false;
+      }
+      if (readable) {
+         implPtr->readFromSocket();
+      }
+      if (writable && implPtr->writeToSocket()) {
+         implPtr->updateWriteNotifier();
+         return true;
+      }
+   }
+   return false;
+}
+
+bool TcpSocket::waitForDisconnected(int msecs)
+{
+   PDK_D(TcpSocket);
+   if (implPtr->m_state == SocketState::UnconnectedState) {
+      warning_stream("TcpSocket::waitForDisconnected() is not allowed in UnconnectedState");
+      return false;
+   }
+   ElapsedTimer timer;
+   timer.start();
+   if (implPtr->m_state == SocketState::ConnectingState && !waitForConnected(msecs)) {
+      return false;
+   }
+   while (implPtr->m_socketDescriptor != -1) {
+      bool readable = false;
+      bool writable = false;
+      const int ret = internal::wait_for_socket(implPtr->m_socketDescriptor, !implPtr->isReadBufferFull(),
+                                                !implPtr->m_writeBuffer.isEmpty(),
+                                                substract_from_timeout(msecs, static_cast<int>(timer.elapsed())),
+                                                &readable, &writable);
+      if (ret == 0) {
+         implPtr->setError(SocketError::SocketTimeoutError);
+         return false;
+      }
+      if (ret < 0) {
+         implPtr->setErrorFromErrno(errno);
+         return false;
+      }
+      if (readable) {
+         implPtr->readFromSocket();
+      }
+      if (writable) {
+         implPtr->writeToSocket();
+      }
+   }
+   return implPtr->m_state == SocketState::UnconnectedState;
+}
+
+bool TcpSocket::isSequential() const
+{
+   return true;
+}
+
+pdk::pint64 TcpSocket::bytesToWrite() const
+{
+   PDK_D(const TcpSocket);
+   return implPtr->m_writeBuffer.size();
+}
+
+void TcpSocket::close()
+{
+   PDK_D(TcpSocket);
+   disconnectFromHost();
+   if (implPtr->m_state == SocketState::UnconnectedState) {
+      IoDevice::close();
+   }
+}
+
+void TcpSocket::setConnectedHandler(const ConnectedHandler &handler)
+{
+   PDK_D(TcpSocket);
+   implPtr->m_connectedHandler = handler;
+}
+
+void TcpSocket::setDisconnectedHandler(const DisconnectedHandler &handler)
+{
+   PDK_D(TcpSocket);
+   implPtr->m_disconnectedHandler = handler;
+}
+
+void TcpSocket::setReadyReadHandler(const ReadyReadHandler &handler)
+{
+   PDK_D(TcpSocket);
+   implPtr->m_readyReadHandler = handler;
+}
+
+void TcpSocket::setBytesWrittenHandler(const BytesWrittenHandler &handler)
+{
+   PDK_D(TcpSocket);
+   implPtr->m_bytesWrittenHandler = handler;
+}
+
+void TcpSocket::setErrorHandler(const ErrorHandler &handler)
+{
+   PDK_D(TcpSocket);
+   implPtr->m_errorHandler = handler;
+}
+
+pdk::pint64 TcpSocket::readData(char *data, pdk::pint64 maxLength)
+{
+   PDK_D(TcpSocket);
+   PDK_UNUSED(data);
+   PDK_UNUSED(maxLength);
+   // the buffer may have drained below the limit, start reading again
+   implPtr->updateReadNotifier();
+   if (implPtr->m_socketDescriptor == -1) {
+      return -1;
+   }
+   return 0;
+}
+
+pdk::pint64 TcpSocket::writeData(const char *data, pdk::pint64 length)
+{
+   PDK_D(TcpSocket);
+   if (implPtr->m_socketDescriptor == -1 || implPtr->m_state == SocketState::ClosingState) {
+      implPtr->setError(SocketError::UnknownSocketError);
+      implPtr->m_errorString = Latin1String("Socket is not connected");
+      return -1;
+   }
+   implPtr->m_writeBuffer.append(data, length);
+   // flushed in one go once the event loop sees the socket writable, small
+   // writes issued in between coalesce into a single gather write
+   implPtr->updateWriteNotifier();
+   return length;
+}
+
+} // net
+} // pdk
@@ -0,0 +1,424 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/net/UdpSocket.h"
+#include "pdk/base/net/internal/TcpSocketPrivate.h"
+#include "pdk/base/net/internal/SocketEnginePrivate.h"
+#include "pdk/base/os/thread/internal/ThreadPrivate.h"
+#include "pdk/kernel/internal/ObjectPrivate.h"
+#include "pdk/global/Logging.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+namespace pdk {
+namespace net {
+
+using pdk::lang::Latin1String;
+using pdk::kernel::SocketNotifier;
+using pdk::pal::net::NativeDatagram;
+using pdk::pal::net::MaxDatagramBatch;
+
+namespace internal {
+
+using pdk::kernel::internal::ObjectPrivate;
+
+class UdpSocketPrivate : public ObjectPrivate
+{
+   PDK_DECLARE_PUBLIC(UdpSocket);
+public:
+   UdpSocketPrivate();
+
+   bool createSocket(const HostAddress &address, HostAddress *boundAddress);
+   void resetSocketLayer();
+   void setErrorFromErrno(int errorCode);
+   socklen_t fillAddress(const HostAddress &address, pdk::puint16 port, NativeDatagram &datagram) const;
+   void readNotification();
+   void enableReadNotification();
+
+   int m_socketDescriptor;
+   int m_family;
+   HostAddress m_localAddress;
+   pdk::puint16 m_localPort;
+   SocketNotifier *m_notifier;
+   UdpSocket::SocketError m_socketError;
+   String m_errorString;
+   UdpSocket::ReadyReadHandler m_readyReadHandler;
+   // receive area of the batched reads, kept to avoid reallocating it
+   std::vector<char> m_scratch;
+};
+
+using UdpSocketNotifier = SocketEngineNotifier<UdpSocketPrivate>;
+
+UdpSocketPrivate::UdpSocketPrivate()
+   : m_socketDescriptor(-1),
+     m_family(AF_UNSPEC),
+     m_localPort(0),
+     m_notifier(nullptr),
+     m_socketError(UdpSocket::SocketError::UnknownSocketError)
+{
+}
+
+bool UdpSocketPrivate::createSocket(const HostAddress &address, HostAddress *boundAddress)
+{
+   PDK_Q(UdpSocket);
+   *boundAddress = address;
+   int family = get_address_family(address);
+   int fd = pdk::pal::net::create_socket(family, SOCK_DGRAM);
+   if (fd == -1 && errno == EAFNOSUPPORT &&
+       address.getProtocol() == HostAddress::NetworkLayerProtocol::AnyIPProtocol) {
+      // no IPv6 on this host
+      *boundAddress = HostAddress::SpecialAddress::AnyIPv4;
+      family = AF_INET;
+      fd = pdk::pal::net::create_socket(family, SOCK_DGRAM);
+   }
+   if (fd == -1) {
+      setErrorFromErrno(errno);
+      return false;
+   }
+   if (boundAddress->getProtocol() == HostAddress::NetworkLayerProtocol::AnyIPProtocol) {
+      pdk::pal::net::set_socket_option(fd, IPPROTO_IPV6, IPV6_V6ONLY, 0);
+   }
+   m_socketDescriptor = fd;
+   m_family = family;
+   if (m_threadData->hasEventDispatcher()) {
+      m_notifier = new UdpSocketNotifier(fd, SocketNotifier::Type::Read, this,
+                                         &UdpSocketPrivate::readNotification, apiPtr);
+   }
+   return true;
+}
+
+void UdpSocketPrivate::resetSocketLayer()
+{
+   destroy_socket_notifier(m_notifier);
+   if (m_socketDescriptor != -1) {
+      pdk::pal::net::close_socket(m_socketDescriptor);
+      m_socketDescriptor = -1;
+   }
+   m_family = AF_UNSPEC;
+   m_localAddress.clear();
+   m_localPort = 0;
+}
+
+void UdpSocketPrivate::setErrorFromErrno(int errorCode)
+{
+   m_socketError = TcpSocketPrivate::translateError(errorCode);
+   m_errorString = pdk::error_string(errorCode);
+   // @TODO emit signal
+   // emit q->errorOccurred(m_socketError);
+}
+
+socklen_t UdpSocketPrivate::fillAddress(const HostAddress &address, pdk::puint16 port,
+                                        NativeDatagram &datagram) const
+{
+   bool isIPv4 = address.getProtocol() == HostAddress::NetworkLayerProtocol::IPv4Protocol;
+   if (isIPv4 && m_family == AF_INET6) {
+      // a dual stack socket reaches IPv4 peers through mapped addresses
+      const pdk::puint32 ip4 = address.toIPv4Address();
+      pdk::puint8 mapped[16] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff,
+                                pdk::puint8(ip4 >> 24), pdk::puint8(ip4 >> 16),
+                                pdk::puint8(ip4 >> 8), pdk::puint8(ip4)};
+      datagram.m_addressLength = to_sockaddr(HostAddress(mapped), port, &datagram.m_address);
+   } else {
+      datagram.m_addressLength = to_sockaddr(address, port, &datagram.m_address);
+   }
+   return datagram.m_addressLength;
+}
+
+void UdpSocketPrivate::readNotification()
+{
+   // held back until the application reads, otherwise the level
+   // triggered notifier fires again right away
+   if (m_notifier) {
+      m_notifier->setEnabled(false);
+   }
+   if (m_readyReadHandler) {
+      // @TODO emit signal
+      // emit q->readyRead();
+      UdpSocket::ReadyReadHandler handler = m_readyReadHandler;
+      handler();
+   }
+}
+
+void UdpSocketPrivate::enableReadNotification()
+{
+   if (m_notifier) {
+      m_notifier->setEnabled(true);
+   }
+}
+
+} // internal
+
+UdpSocket::UdpSocket(Object *parent)
+   : Object(*new UdpSocketPrivate, parent)
+{
+}
+
+UdpSocket::~UdpSocket()
+{
+   close();
+}
+
+bool UdpSocket::bind(const HostAddress &address, pdk::puint16 port)
+{
+   PDK_D(UdpSocket);
+   if (implPtr->m_socketDescriptor != -1) {
+      warning_stream("UdpSocket::bind() called while already bound");
+      return false;
+   }
+   HostAddress bindAddress;
+   if (!implPtr->createSocket(address, &bindAddress)) {
+      return false;
+   }
+   sockaddr_storage storage;
+   const socklen_t length = internal::to_sockaddr(bindAddress, port, &storage);
+   if (pdk::pal::net::bind_socket(implPtr->m_socketDescriptor, reinterpret_cast<sockaddr *>(&storage),
+                                  length) == -1) {
+      const int errorCode = errno;
+      implPtr->resetSocketLayer();
+      implPtr->setErrorFromErrno(errorCode);
+      return false;
+   }
+   internal::get_local_address(implPtr->m_socketDescriptor, &implPtr->m_localAddress,
+                               &implPtr->m_localPort);
+   return true;
+}
+
+void UdpSocket::close()
+{
+   PDK_D(UdpSocket);
+   implPtr->resetSocketLayer();
+}
+
+bool UdpSocket::isValid() const
+{
+   PDK_D(const UdpSocket);
+   return implPtr->m_socketDescriptor != -1;
+}
+
+int UdpSocket::getSocketDescriptor() const
+{
+   PDK_D(const UdpSocket);
+   return implPtr->m_socketDescriptor;
+}
+
+HostAddress UdpSocket::getLocalAddress() const
+{
+   PDK_D(const UdpSocket);
+   return implPtr->m_localAddress;
+}
+
+pdk::puint16 UdpSocket::getLocalPort() const
+{
+   PDK_D(const UdpSocket);
+   return implPtr->m_localPort;
+}
+
+bool UdpSocket::hasPendingDatagrams() const
+{
+   return getPendingDatagramSize() != -1;
+}
+
+pdk::pint64 UdpSocket::getPendingDatagramSize() const
+{
+   PDK_D(const UdpSocket);
+   if (implPtr->m_socketDescriptor == -1) {
+      return -1;
+   }
+   return pdk::pal::net::pending_datagram_size(implPtr->m_socketDescriptor);
+}
+
+pdk::pint64 UdpSocket::readDatagram(char *data, pdk::pint64 maxSize, HostAddress *address, pdk::puint16 *port)
+{
+   PDK_D(UdpSocket);
+   if (implPtr->m_socketDescriptor == -1) {
+      warning_stream("UdpSocket::readDatagram() called on an unbound socket");
+      return -1;
+   }
+   implPtr->enableReadNotification();
+   NativeDatagram datagram;
+   datagram.m_buffer.iov_base = data;
+   datagram.m_buffer.iov_len = static_cast<size_t>(maxSize);
+   const int received = pdk::pal::net::receive_datagrams(implPtr->m_socketDescriptor, &datagram, 1);
+   if (received <= 0) {
+      if (received < 0) {
+         implPtr->setErrorFromErrno(errno);
+      }
+      return -1;
+   }
+   const HostAddress sender = internal::from_sockaddr(datagram.m_address, port);
+   if (address) {
+      *address = sender;
+   }
+   return std::min(datagram.m_size, maxSize);
+}
+
+pdk::pint64 UdpSocket::writeDatagram(const char *data, pdk::pint64 size,
+                                     const HostAddress &address, pdk::puint16 port)
+{
+   PDK_D(UdpSocket);
+   if (implPtr->m_socketDescriptor == -1) {
+      HostAddress boundAddress;
+      if (!implPtr->createSocket(address, &boundAddress)) {
+         return -1;
+      }
+   }
+   NativeDatagram datagram;
+   datagram.m_buffer.iov_base = const_cast<char *>(data);
+   datagram.m_buffer.iov_len = static_cast<size_t>(size);
+   if (implPtr->fillAddress(address, port, datagram) == 0) {
+      implPtr->setErrorFromErrno(EAFNOSUPPORT);
+      return -1;
+   }
+   const int sent = pdk::pal::net::send_datagrams(implPtr->m_socketDescriptor, &datagram, 1);
+   if (sent <= 0) {
+      // a full send queue drops the datagram like the network would
+      implPtr->setErrorFromErrno(sent == 0 ? EAGAIN : errno);
+      return -1;
+   }
+   if (implPtr->m_localPort == 0) {
+      internal::get_local_address(implPtr->m_socketDescriptor, &implPtr->m_localAddress,
+                                  &implPtr->m_localPort);
+   }
+   return datagram.m_size;
+}
+
+pdk::pint64 UdpSocket::writeDatagram(const ByteArray &datagram, const HostAddress &address, pdk::puint16 port)
+{
+   return writeDatagram(datagram.getConstRawData(), datagram.size(), address, port);
+}
+
+int UdpSocket::readDatagrams(std::vector<NetworkDatagram> &datagrams, int maxCount, pdk::pint64 maxSize)
+{
+   PDK_D(UdpSocket);
+   datagrams.clear();
+   if (implPtr->m_socketDescriptor == -1) {
+      warning_stream("UdpSocket::readDatagrams() called on an unbound socket");
+      return -1;
+   }
+   implPtr->enableReadNotification();
+   maxCount = std::min(maxCount, static_cast<int>(MaxDatagramBatch));
+   if (maxCount <= 0) {
+      return 0;
+   }
+   std::vector<char> &scratch = implPtr->m_scratch;
+   if (scratch.size() < static_cast<size_t>(maxCount * maxSize)) {
+      scratch.resize(static_cast<size_t>(maxCount * maxSize));
+   }
+   NativeDatagram natives[MaxDatagramBatch];
+   for (int i = 0; i < maxCount; ++i) {
+      natives[i].m_buffer.iov_base = scratch.data() + i * maxSize;
+      natives[i].m_buffer.iov_len = static_cast<size_t>(maxSize);
+   }
+   const int received = pdk::pal::net::receive_datagrams(implPtr->m_socketDescriptor, natives, maxCount);
+   if (received < 0) {
+      implPtr->setErrorFromErrno(errno);
+      return -1;
+   }
+   datagrams.reserve(received);
+   for (int i = 0; i < received; ++i) {
+      pdk::puint16 port;
+      const HostAddress sender = internal::from_sockaddr(natives[i].m_address, &port);
+      const pdk::pint64 size = std::min(natives[i].m_size, maxSize);
+      datagrams.emplace_back(ByteArray(static_cast<const char *>(natives[i].m_buffer.iov_base),
+                                       static_cast<int>(size)), sender, port);
+   }
+   return received;
+}
+
+int UdpSocket::writeDatagrams(const std::vector<NetworkDatagram> &datagrams)
+{
+   PDK_D(UdpSocket);
+   if (datagrams.empty()) {
+      return 0;
+   }
+   if (implPtr->m_socketDescriptor == -1) {
+      HostAddress boundAddress;
+      if (!implPtr->createSocket(datagrams.front().getAddress(), &boundAddress)) {
+         return -1;
+      }
+   }
+   NativeDatagram natives[MaxDatagramBatch];
+   size_t total = 0;
+   while (total < datagrams.size()) {
+      const int count = static_cast<int>(std::min(datagrams.size() - total,
+                                                  static_cast<size_t>(MaxDatagramBatch)));
+      for (int i = 0; i < count; ++i) {
+         const NetworkDatagram &datagram = datagrams[total + i];
+         natives[i].m_buffer.iov_base = const_cast<char *>(datagram.getData().getConstRawData());
+         natives[i].m_buffer.iov_len = static_cast<size_t>(datagram.getData().size());
+         if (implPtr->fillAddress(datagram.getAddress(), datagram.getPort(), natives[i]) == 0) {
+            implPtr->setErrorFromErrno(EAFNOSUPPORT);
+            return total > 0 ? static_cast<int>(total) : -1;
+         }
+      }
+      const int sent = pdk::pal::net::send_datagrams(implPtr->m_socketDescriptor, natives, count);
+      if (sent < 0) {
+         implPtr->setErrorFromErrno(errno);
+         return total > 0 ? static_cast<int>(total) : -1;
+      }
+      total += sent;
+      if (sent < count) {
+         // the send queue is full
+         break;
+      }
+   }
+   if (implPtr->m_localPort == 0) {
+      internal::get_local_address(implPtr->m_socketDescriptor, &implPtr->m_localAddress,
+                                  &implPtr->m_localPort);
+   }
+   return static_cast<int>(total);
+}
+
+bool UdpSocket::waitForReadyRead(int msecs)
+{
+   PDK_D(UdpSocket);
+   if (implPtr->m_socketDescriptor == -1) {
+      return false;
+   }
+   const int ret = internal::wait_for_socket(implPtr->m_socketDescriptor, true, false, msecs);
+   if (ret == 0) {
+      implPtr->m_socketError = SocketError::SocketTimeoutError;
+      implPtr->m_errorString = Latin1String("Socket operation timed out");
+      return false;
+   }
+   if (ret < 0) {
+      implPtr->setErrorFromErrno(errno);
+      return false;
+   }
+   return true;
+}
+
+UdpSocket::SocketError UdpSocket::getError() const
+{
+   PDK_D(const UdpSocket);
+   return implPtr->m_socketError;
+}
+
+String UdpSocket::getErrorString() const
+{
+   PDK_D(const UdpSocket);
+   return implPtr->m_errorString;
+}
+
+void UdpSocket::setReadyReadHandler(const ReadyReadHandler &handler)
+{
+   PDK_D(UdpSocket);
+   implPtr->m_readyReadHandler = handler;
+}
+
+} // net
+} // pdk
@@ -0,0 +1,122 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/net/internal/SocketEnginePrivate.h"
+#include "pdk/kernel/internal/CoreUnixPrivate.h"
+
+#include <cstring>
+#include <arpa/inet.h>
+#include <poll.h>
+
+namespace pdk {
+namespace net {
+namespace internal {
+
+using NetworkLayerProtocol = HostAddress::NetworkLayerProtocol;
+
+socklen_t to_sockaddr(const HostAddress &address, pdk::puint16 port, sockaddr_storage *storage)
+{
+   std::memset(storage, 0, sizeof(sockaddr_storage));
+   switch (address.getProtocol()) {
+   case NetworkLayerProtocol::IPv4Protocol: {
+      sockaddr_in *ip4 = reinterpret_cast<sockaddr_in *>(storage);
+      ip4->sin_family = AF_INET;
+      ip4->sin_port = htons(port);
+      ip4->sin_addr.s_addr = htonl(address.toIPv4Address());
+      return sizeof(sockaddr_in);
+   }
+   case NetworkLayerProtocol::IPv6Protocol:
+   case NetworkLayerProtocol::AnyIPProtocol: {
+      // the any address binds a dual stack socket
+      sockaddr_in6 *ip6 = reinterpret_cast<sockaddr_in6 *>(storage);
+      ip6->sin6_family = AF_INET6;
+      ip6->sin6_port = htons(port);
+      std::memcpy(&ip6->sin6_addr, address.toIPv6Address(), sizeof(ip6->sin6_addr));
+      return sizeof(sockaddr_in6);
+   }
+   case NetworkLayerProtocol::UnknownNetworkLayerProtocol:
+      break;
+   }
+   return 0;
+}
+
+HostAddress from_sockaddr(const sockaddr_storage &storage, pdk::puint16 *port)
+{
+   if (port) {
+      if (storage.ss_family == AF_INET) {
+         *port = ntohs(reinterpret_cast<const sockaddr_in &>(storage).sin_port);
+      } else if (storage.ss_family == AF_INET6) {
+         *port = ntohs(reinterpret_cast<const sockaddr_in6 &>(storage).sin6_port);
+      } else {
+         *port = 0;
+      }
+   }
+   return HostAddress(reinterpret_cast<const sockaddr *>(&storage));
+}
+
+int get_address_family(const HostAddress &address)
+{
+   return address.getProtocol() == NetworkLayerProtocol::IPv4Protocol ? AF_INET : AF_INET6;
+}
+
+bool get_local_address(int fd, HostAddress *address, pdk::puint16 *port)
+{
+   sockaddr_storage storage;
+   socklen_t length = sizeof(storage);
+   if (::getsockname(fd, reinterpret_cast<sockaddr *>(&storage), &length) == -1) {
+      return false;
+   }
+   *address = from_sockaddr(storage, port);
+   return true;
+}
+
+bool get_peer_address(int fd, HostAddress *address, pdk::puint16 *port)
+{
+   sockaddr_storage storage;
+   socklen_t length = sizeof(storage);
+   if (::getpeername(fd, reinterpret_cast<sockaddr *>(&storage), &length) == -1) {
+      return false;
+   }
+   *address = from_sockaddr(storage, port);
+   return true;
+}
+
+int wait_for_socket(int fd, bool forRead, bool forWrite, int msecs, bool *readable, bool *writable)
+{
+   short events = 0;
+   if (forRead) {
+      events |= POLLIN;
+   }
+   if (forWrite) {
+      events |= POLLOUT;
+   }
+   pollfd pfd = pdk::kernel::make_pollfd(fd, events);
+   int ret = pdk::kernel::poll_msecs(&pfd, 1, msecs);
+   if (ret > 0) {
+      // errors and hang ups are reported through the following read or write
+      const short failure = POLLERR | POLLHUP | POLLNVAL;
+      if (readable) {
+         *readable = pfd.revents & (POLLIN | failure);
+      }
+      if (writable) {
+         *writable = pfd.revents & (POLLOUT | failure);
+      }
+   }
+   return ret;
+}
+
+} // internal
+} // net
+} // pdk
@@ -0,0 +1,435 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/os/process/Process.h"
+#include "pdk/base/os/process/internal/ProcessPrivate.h"
+#include "pdk/kernel/SocketNotifier.h"
+#include "pdk/global/Logging.h"
+
+namespace pdk {
+namespace os {
+namespace process {
+
+using pdk::lang::Latin1String;
+
+namespace internal {
+
+ProcessPrivate::ProcessPrivate()
+   : m_processChannelMode(Process::ProcessChannelMode::SeparateChannels),
+     m_processChannel(Process::ProcessChannel::StandardOutput),
+     m_processState(Process::ProcessState::NotRunning),
+     m_processError(Process::ProcessError::UnknownError),
+     m_exitStatus(Process::ExitStatus::NormalExit),
+     m_pid(0),
+     m_exitCode(0),
+     m_deathFd(-1),
+     m_deathSlot(nullptr),
+     m_deathNotifier(nullptr),
+     m_writeChannelClosing(false)
+{
+   m_readBufferChunkSize = PDK_RING_BUFFER_CHUNK_SIZE;
+   m_writeBufferChunkSize = PDK_RING_BUFFER_CHUNK_SIZE;
+}
+
+ProcessPrivate::~ProcessPrivate()
+{
+}
+
+void ProcessPrivate::setError(Process::ProcessError error, const String &description)
+{
+   m_processError = error;
+   if (!description.isEmpty()) {
+      m_errorString = description;
+      return;
+   }
+   switch (error) {
+   case Process::ProcessError::FailedToStart:
+      m_errorString = Latin1String("Process failed to start");
+      break;
+   case Process::ProcessError::Crashed:
+      m_errorString = Latin1String("Process crashed");
+      break;
+   case Process::ProcessError::Timedout:
+      m_errorString = Latin1String("Process operation timed out");
+      break;
+   case Process::ProcessError::ReadError:
+      m_errorString = Latin1String("Error reading from process");
+      break;
+   case Process::ProcessError::WriteError:
+      m_errorString = Latin1String("Error writing to process");
+      break;
+   case Process::ProcessError::UnknownError:
+      m_errorString.clear();
+      break;
+   }
+   // @TODO emit signal
+   // emit q->errorOccurred(m_processError);
+}
+
+void ProcessPrivate::setProcessState(Process::ProcessState state)
+{
+   if (m_processState == state) {
+      return;
+   }
+   m_processState = state;
+   // @TODO emit signal
+   // emit q->stateChanged(state);
+}
+
+} // internal
+
+Process::Process(Object *parent)
+   : IoDevice(*new ProcessPrivate, parent)
+{
+}
+
+Process::~Process()
+{
+   PDK_D(Process);
+   if (implPtr->m_processState != ProcessState::NotRunning) {
+      warning_stream("Process: Destroyed while process (%s) is still running.",
+                     implPtr->m_program.toLocal8Bit().getConstRawData());
+      implPtr->m_finishedHandler = nullptr;
+      implPtr->m_readyReadHandler = nullptr;
+      kill();
+      waitForFinished();
+   }
+   implPtr->cleanup();
+}
+
+void Process::start(const String &program, const StringList &arguments, OpenModes mode)
+{
+   PDK_D(Process);
+   if (implPtr->m_processState != ProcessState::NotRunning) {
+      warning_stream("Process::start: Process is already running");
+      return;
+   }
+   implPtr->m_program = program;
+   implPtr->m_arguments = arguments;
+   open(mode);
+}
+
+void Process::start(OpenModes mode)
+{
+   open(mode);
+}
+
+bool Process::open(OpenModes mode)
+{
+   PDK_D(Process);
+   if (implPtr->m_processState != ProcessState::NotRunning) {
+      warning_stream("Process::start: Process is already running");
+      return false;
+   }
+   if (implPtr->m_program.isEmpty()) {
+      implPtr->setError(ProcessError::FailedToStart, Latin1String("No program defined"));
+      return false;
+   }
+   implPtr->m_exitCode = 0;
+   implPtr->m_exitStatus = ExitStatus::NormalExit;
+   implPtr->m_processError = ProcessError::UnknownError;
+   implPtr->m_errorString.clear();
+   implPtr->m_writeChannelClosing = false;
+   // a process is a stream, seeking modes make no sense
+   mode &= ~(pdk::as_integer<OpenMode>(OpenMode::Append) | pdk::as_integer<OpenMode>(OpenMode::Truncate));
+   IoDevice::open(mode);
+   if (isReadable() && implPtr->m_processChannelMode != ProcessChannelMode::ForwardedChannels) {
+      implPtr->setReadChannelCount(2);
+   }
+   implPtr->setCurrentReadChannel(static_cast<int>(implPtr->m_processChannel));
+   if (!implPtr->startProcess()) {
+      IoDevice::close();
+      return false;
+   }
+   return true;
+}
+
+String Process::getProgram() const
+{
+   PDK_D(const Process);
+   return implPtr->m_program;
+}
+
+void Process::setProgram(const String &program)
+{
+   PDK_D(Process);
+   if (implPtr->m_processState != ProcessState::NotRunning) {
+      warning_stream("Process::setProgram: Process is already running");
+      return;
+   }
+   implPtr->m_program = program;
+}
+
+StringList Process::getArguments() const
+{
+   PDK_D(const Process);
+   return implPtr->m_arguments;
+}
+
+void Process::setArguments(const StringList &arguments)
+{
+   PDK_D(Process);
+   if (implPtr->m_processState != ProcessState::NotRunning) {
+      warning_stream("Process::setArguments: Process is already running");
+      return;
+   }
+   implPtr->m_arguments = arguments;
+}
+
+String Process::getWorkingDirectory() const
+{
+   PDK_D(const Process);
+   return implPtr->m_workingDirectory;
+}
+
+void Process::setWorkingDirectory(const String &dir)
+{
+   PDK_D(Process);
+   implPtr->m_workingDirectory = dir;
+}
+
+StringList Process::getEnvironment() const
+{
+   PDK_D(const Process);
+   return implPtr->m_environment;
+}
+
+void Process::setEnvironment(const StringList &environment)
+{
+   PDK_D(Process);
+   implPtr->m_environment = environment;
+}
+
+Process::ProcessChannelMode Process::getProcessChannelMode() const
+{
+   PDK_D(const Process);
+   return implPtr->m_processChannelMode;
+}
+
+void Process::setProcessChannelMode(ProcessChannelMode mode)
+{
+   PDK_D(Process);
+   implPtr->m_processChannelMode = mode;
+}
+
+Process::ProcessChannel Process::getReadChannel() const
+{
+   PDK_D(const Process);
+   return implPtr->m_processChannel;
+}
+
+void Process::setReadChannel(ProcessChannel channel)
+{
+   PDK_D(Process);
+   implPtr->m_processChannel = channel;
+   implPtr->setCurrentReadChannel(static_cast<int>(channel));
+}
+
+void Process::closeReadChannel(ProcessChannel channel)
+{
+   PDK_D(Process);
+   if (channel == ProcessChannel::StandardError) {
+      implPtr->closeChannel(implPtr->m_stderrChannel);
+   } else {
+      implPtr->closeChannel(implPtr->m_stdoutChannel);
+   }
+}
+
+void Process::closeWriteChannel()
+{
+   PDK_D(Process);
+   // the pipe is closed once everything buffered has been written
+   implPtr->m_writeChannelClosing = true;
+   if (implPtr->m_writeBuffer.isEmpty()) {
+      implPtr->closeWriteChannel();
+   }
+}
+
+pdk::pint64 Process::getProcessId() const
+{
+   PDK_D(const Process);
+   return implPtr->m_pid;
+}
+
+Process::ProcessError Process::getError() const
+{
+   PDK_D(const Process);
+   return implPtr->m_processError;
+}
+
+Process::ProcessState Process::getState() const
+{
+   PDK_D(const Process);
+   return implPtr->m_processState;
+}
+
+int Process::getExitCode() const
+{
+   PDK_D(const Process);
+   return implPtr->m_exitCode;
+}
+
+Process::ExitStatus Process::getExitStatus() const
+{
+   PDK_D(const Process);
+   return implPtr->m_exitStatus;
+}
+
+bool Process::waitForStarted(int msecs)
+{
+   PDK_D(Process);
+   if (implPtr->m_processState == ProcessState::Starting) {
+      return implPtr->waitForStarted(msecs);
+   }
+   return implPtr->m_processState == ProcessState::Running;
+}
+
+bool Process::waitForReadyRead(int msecs)
+{
+   PDK_D(Process);
+   if (implPtr->m_processState == ProcessState::NotRunning) {
+      return false;
+   }
+   if (implPtr->m_processChannel == ProcessChannel::StandardError &&
+       implPtr->m_processChannelMode == ProcessChannelMode::MergedChannels) {
+      return false;
+   }
+   return implPtr->waitForReadyRead(msecs);
+}
+
+bool Process::waitForBytesWritten(int msecs)
+{
+   PDK_D(Process);
+   if (implPtr->m_processState == ProcessState::NotRunning) {
+      return false;
+   }
+   return implPtr->waitForBytesWritten(msecs);
+}
+
+bool Process::waitForFinished(int msecs)
+{
+   PDK_D(Process);
+   if (implPtr->m_processState == ProcessState::NotRunning) {
+      return false;
+   }
+   return implPtr->waitForFinished(msecs);
+}
+
+ByteArray Process::readAllStandardOutput()
+{
+   ProcessChannel channel = getReadChannel();
+   setReadChannel(ProcessChannel::StandardOutput);
+   ByteArray data = readAll();
+   setReadChannel(channel);
+   return data;
+}
+
+ByteArray Process::readAllStandardError()
+{
+   ProcessChannel channel = getReadChannel();
+   setReadChannel(ProcessChannel::StandardError);
+   ByteArray data = readAll();
+   setReadChannel(channel);
+   return data;
+}
+
+bool Process::isSequential() const
+{
+   return true;
+}
+
+pdk::pint64 Process::bytesToWrite() const
+{
+   PDK_D(const Process);
+   return implPtr->m_writeBuffer.size();
+}
+
+void Process::close()
+{
+   // @TODO emit signal
+   // emit aboutToClose();
+   while (waitForBytesWritten(-1)) {
+   }
+   kill();
+   waitForFinished(-1);
+   IoDevice::close();
+}
+
+void Process::setFinishedHandler(const FinishedHandler &handler)
+{
+   PDK_D(Process);
+   implPtr->m_finishedHandler = handler;
+}
+
+void Process::setReadyReadHandler(const ReadyReadHandler &handler)
+{
+   PDK_D(Process);
+   implPtr->m_readyReadHandler = handler;
+}
+
+void Process::terminate()
+{
+   PDK_D(Process);
+   implPtr->terminateProcess();
+}
+
+void Process::kill()
+{
+   PDK_D(Process);
+   implPtr->killProcess();
+}
+
+int Process::execute(const String &program, const StringList &arguments)
+{
+   Process process;
+   process.setProcessChannelMode(ProcessChannelMode::ForwardedChannels);
+   process.start(program, arguments);
+   if (!process.waitForFinished(-1) || process.getError() == ProcessError::FailedToStart) {
+      return -2;
+   }
+   return process.getExitStatus() == ExitStatus::NormalExit ? process.getExitCode() : -1;
+}
+
+pdk::pint64 Process::readData(char *data, pdk::pint64 maxLength)
+{
+   PDK_D(Process);
+   PDK_UNUSED(data);
+   if (!maxLength) {
+      return 0;
+   }
+   // the pipes are drained into the read buffers by the notifiers, an
+   // empty buffer of a process that is gone means end of file
+   if (implPtr->m_processState == ProcessState::NotRunning) {
+      return -1;
+   }
+   return 0;
+}
+
+pdk::pint64 Process::writeData(const char *data, pdk::pint64 length)
+{
+   PDK_D(Process);
+   if (implPtr->m_stdinChannel.m_closed || implPtr->m_writeChannelClosing) {
+      return 0;
+   }
+   implPtr->m_writeBuffer.append(data, length);
+   if (implPtr->m_stdinChannel.m_notifier) {
+      implPtr->m_stdinChannel.m_notifier->setEnabled(true);
+   }
+   return length;
+}
+
+} // process
+} // os
+} // pdk
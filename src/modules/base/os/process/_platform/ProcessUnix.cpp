@@ -0,0 +1,822 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/os/process/internal/ProcessPrivate.h"
+#include "pdk/base/os/thread/internal/ThreadPrivate.h"
+#include "pdk/kernel/SocketNotifier.h"
+#include "pdk/kernel/ElapsedTimer.h"
+#include "pdk/kernel/internal/CoreUnixPrivate.h"
+#include "pdk/global/Logging.h"
+#include "pdk/utils/Funcs.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cerrno>
+#include <cstring>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <spawn.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+#if defined(PDK_OS_LINUX)
+#include <sys/syscall.h>
+#endif
+
+extern char **environ;
+
+namespace pdk {
+namespace os {
+namespace process {
+namespace internal {
+
+using pdk::kernel::Event;
+using pdk::kernel::ElapsedTimer;
+using pdk::io::internal::substract_from_timeout;
+using pdk::ds::internal::RingBuffer;
+
+// one pipe per running process. The shared SIGCHLD handler reaps the
+// child of every slot with waitpid(WNOHANG) and only writes to the pipes
+// of the children that have exited, the status waits in the slot. Slots
+// are recycled but never freed so that the handler can walk the list
+// without taking a lock.
+class ChildDeathSlot
+{
+public:
+   std::atomic<bool> m_inUse;
+   std::atomic<pid_t> m_pid;
+   std::atomic<bool> m_exited;
+   std::atomic<int> m_status;
+   int m_pipe[2];
+   ChildDeathSlot *m_next;
+};
+
+namespace {
+
+std::atomic<ChildDeathSlot *> sg_childDeathSlots(nullptr);
+std::once_flag sg_sigchldHandlerOnce;
+struct sigaction sg_previousSigchldAction;
+
+// async-signal-safe, it runs in the SIGCHLD handler
+void reap_child_death_slot(ChildDeathSlot *slot)
+{
+   const pid_t pid = slot->m_pid.load(std::memory_order_acquire);
+   if (pid <= 0 || slot->m_exited.load(std::memory_order_acquire)) {
+      return;
+   }
+   int status = 0;
+   pid_t result;
+   do {
+      result = ::waitpid(pid, &status, WNOHANG);
+   } while (result == -1 && errno == EINTR);
+   if (result == 0) {
+      return;
+   }
+   if (result == pid) {
+      slot->m_status.store(status, std::memory_order_relaxed);
+      slot->m_exited.store(true, std::memory_order_release);
+   }
+   // on ECHILD somebody else reaped it, the owner sorts that out
+   // a full pipe already carries a pending wakeup
+   char c = 0;
+   pdk::kernel::safe_write(slot->m_pipe[1], &c, 1);
+}
+
+void sigchld_handler(int signum, siginfo_t *info, void *context)
+{
+   const int savedErrno = errno;
+   // signals of several children may be merged into one, so si_pid cannot
+   // tell which ones exited, every slot is asked and only those are woken
+   for (ChildDeathSlot *slot = sg_childDeathSlots.load(std::memory_order_acquire);
+        slot; slot = slot->m_next) {
+      if (slot->m_inUse.load(std::memory_order_relaxed)) {
+         reap_child_death_slot(slot);
+      }
+   }
+   if (sg_previousSigchldAction.sa_flags & SA_SIGINFO) {
+      if (sg_previousSigchldAction.sa_sigaction) {
+         sg_previousSigchldAction.sa_sigaction(signum, info, context);
+      }
+   } else if (sg_previousSigchldAction.sa_handler != SIG_DFL &&
+              sg_previousSigchldAction.sa_handler != SIG_IGN) {
+      sg_previousSigchldAction.sa_handler(signum);
+   }
+   errno = savedErrno;
+}
+
+void install_sigchld_handler()
+{
+   std::call_once(sg_sigchldHandlerOnce, []() {
+      struct sigaction action;
+      std::memset(&action, 0, sizeof(action));
+      action.sa_sigaction = sigchld_handler;
+      action.sa_flags = SA_NOCLDSTOP | SA_RESTART | SA_SIGINFO;
+      ::sigemptyset(&action.sa_mask);
+      ::sigaction(SIGCHLD, &action, &sg_previousSigchldAction);
+   });
+}
+
+void drain_pipe(int fd)
+{
+   char buffer[64];
+   while (pdk::kernel::safe_read(fd, buffer, sizeof(buffer)) > 0) {
+   }
+}
+
+ChildDeathSlot *acquire_child_death_slot(pid_t pid)
+{
+   install_sigchld_handler();
+   for (ChildDeathSlot *slot = sg_childDeathSlots.load(std::memory_order_acquire);
+        slot; slot = slot->m_next) {
+      bool expected = false;
+      if (slot->m_inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+         drain_pipe(slot->m_pipe[0]);
+         slot->m_exited.store(false, std::memory_order_relaxed);
+         slot->m_pid.store(pid, std::memory_order_release);
+         return slot;
+      }
+   }
+   ChildDeathSlot *slot = new ChildDeathSlot;
+   if (pdk::kernel::safe_pipe(slot->m_pipe, O_NONBLOCK) == -1) {
+      delete slot;
+      return nullptr;
+   }
+   slot->m_inUse.store(true, std::memory_order_relaxed);
+   slot->m_pid.store(pid, std::memory_order_relaxed);
+   slot->m_exited.store(false, std::memory_order_relaxed);
+   slot->m_status.store(0, std::memory_order_relaxed);
+   ChildDeathSlot *head = sg_childDeathSlots.load(std::memory_order_relaxed);
+   do {
+      slot->m_next = head;
+   } while (!sg_childDeathSlots.compare_exchange_weak(head, slot, std::memory_order_release,
+                                                      std::memory_order_relaxed));
+   return slot;
+}
+
+void release_child_death_slot(ChildDeathSlot *slot)
+{
+   slot->m_pid.store(0, std::memory_order_release);
+   slot->m_inUse.store(false, std::memory_order_release);
+}
+
+#if defined(PDK_OS_LINUX) && defined(__NR_pidfd_open)
+#define PDK_HAVE_PIDFD
+
+int pidfd_open(pid_t pid)
+{
+   return static_cast<int>(::syscall(__NR_pidfd_open, pid, 0));
+}
+
+// a pidfd turns readable once its process has exited, which needs
+// neither a signal handler nor a wakeup for every other child
+bool pidfd_supported()
+{
+   static const bool supported = []() {
+      bool ok = false;
+      if (pdk::env_var_intval("PDK_PROCESS_NO_PIDFD", &ok) > 0 && ok) {
+         return false;
+      }
+      int fd = pidfd_open(::getpid());
+      if (fd == -1) {
+         return false;
+      }
+      pdk::kernel::safe_close(fd);
+      return true;
+   }();
+   return supported;
+}
+#endif
+
+class ProcessNotifier : public SocketNotifier
+{
+public:
+   using Handler = bool (ProcessPrivate::*)();
+   ProcessNotifier(int fd, Type type, ProcessPrivate *process, Handler handler, Object *parent)
+      : SocketNotifier(fd, type, parent),
+        m_process(process),
+        m_handler(handler)
+   {}
+
+protected:
+   bool event(Event *event) override
+   {
+      if (event->getType() == Event::Type::SocketActive) {
+         (m_process->*m_handler)();
+         return true;
+      }
+      return SocketNotifier::event(event);
+   }
+
+private:
+   ProcessPrivate *m_process;
+   Handler m_handler;
+};
+
+// the handler of a notifier may be the one tearing it down
+void destroy_notifier(SocketNotifier *&notifier)
+{
+   if (notifier) {
+      notifier->setEnabled(false);
+      notifier->deleteLater();
+      notifier = nullptr;
+   }
+}
+
+class ProcessPollSet
+{
+public:
+   enum
+   {
+      Stdin,
+      Stdout,
+      Stderr,
+      Death,
+      Count
+   };
+
+   explicit ProcessPollSet(const ProcessPrivate *process)
+   {
+      // negative descriptors are skipped by poll()
+      m_fds[Stdin] = pdk::kernel::make_pollfd(process->m_writeBuffer.isEmpty()
+                                              ? -1 : process->m_stdinChannel.m_pipe[1], POLLOUT);
+      m_fds[Stdout] = pdk::kernel::make_pollfd(process->m_stdoutChannel.m_pipe[0], POLLIN);
+      m_fds[Stderr] = pdk::kernel::make_pollfd(process->m_stderrChannel.m_pipe[0], POLLIN);
+      m_fds[Death] = pdk::kernel::make_pollfd(process->m_deathFd, POLLIN);
+   }
+
+   int poll(int msecs)
+   {
+      return pdk::kernel::poll_msecs(m_fds, Count, msecs);
+   }
+
+   bool isActive(int which) const
+   {
+      return m_fds[which].fd != -1 && m_fds[which].revents != 0;
+   }
+
+private:
+   pollfd m_fds[Count];
+};
+
+int spawn_child(pid_t *pid, const char *program, char *const argv[], char *const envp[],
+                const char *workingDirectory, const int redirections[3])
+{
+#ifndef PDK_HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCHDIR_NP
+   if (workingDirectory) {
+      // posix_spawn() cannot change the directory here, fall back to
+      // vfork() which still shares the address space with the child
+      ByteArray resolved(program);
+      if (!std::strchr(program, '/')) {
+         const char *path = ::getenv("PATH");
+         ByteArray searchPath(path ? path : "/usr/bin:/bin");
+         for (const ByteArray &dir : searchPath.split(':')) {
+            ByteArray candidate = dir.isEmpty() ? ByteArray(".") : dir;
+            candidate += '/';
+            candidate += program;
+            if (::access(candidate.getConstRawData(), X_OK) == 0) {
+               resolved = candidate;
+               break;
+            }
+         }
+      }
+      volatile int childError = 0;
+      pid_t child = ::vfork();
+      if (child == -1) {
+         return errno;
+      }
+      if (child == 0) {
+         for (int target = 0; target < 3; ++target) {
+            if (redirections[target] != -1) {
+               ::dup2(redirections[target], target);
+            }
+         }
+         sigset_t emptyMask;
+         ::sigemptyset(&emptyMask);
+         ::sigprocmask(SIG_SETMASK, &emptyMask, nullptr);
+         ::signal(SIGPIPE, SIG_DFL);
+         if (::chdir(workingDirectory) == -1) {
+            childError = errno;
+            ::_exit(127);
+         }
+         ::execve(resolved.getConstRawData(), argv, envp);
+         childError = errno;
+         ::_exit(127);
+      }
+      if (childError != 0) {
+         int status;
+         pdk::kernel::safe_waitpid(child, &status, 0);
+         return childError;
+      }
+      *pid = child;
+      return 0;
+   }
+#endif
+   posix_spawn_file_actions_t actions;
+   ::posix_spawn_file_actions_init(&actions);
+   for (int target = 0; target < 3; ++target) {
+      if (redirections[target] != -1) {
+         ::posix_spawn_file_actions_adddup2(&actions, redirections[target], target);
+      }
+   }
+#ifdef PDK_HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCHDIR_NP
+   if (workingDirectory) {
+      ::posix_spawn_file_actions_addchdir_np(&actions, workingDirectory);
+   }
+#endif
+   posix_spawnattr_t attributes;
+   ::posix_spawnattr_init(&attributes);
+   // SIGPIPE is ignored by the library and SIGCHLD may carry our handler,
+   // the child starts out with neither
+   sigset_t defaultSignals;
+   ::sigemptyset(&defaultSignals);
+   ::sigaddset(&defaultSignals, SIGPIPE);
+   ::sigaddset(&defaultSignals, SIGCHLD);
+   ::posix_spawnattr_setsigdefault(&attributes, &defaultSignals);
+   sigset_t emptyMask;
+   ::sigemptyset(&emptyMask);
+   ::posix_spawnattr_setsigmask(&attributes, &emptyMask);
+   ::posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK);
+   int result = std::strchr(program, '/')
+         ? ::posix_spawn(pid, program, &actions, &attributes, argv, envp)
+         : ::posix_spawnp(pid, program, &actions, &attributes, argv, envp);
+   ::posix_spawnattr_destroy(&attributes);
+   ::posix_spawn_file_actions_destroy(&actions);
+   return result;
+}
+
+} // anonymous
+
+bool ProcessPrivate::openChannel(Channel &channel, bool childReads)
+{
+   if (&channel == &m_stdoutChannel &&
+       m_processChannelMode == Process::ProcessChannelMode::ForwardedChannels) {
+      return true;
+   }
+   if (&channel == &m_stderrChannel &&
+       m_processChannelMode != Process::ProcessChannelMode::SeparateChannels) {
+      return true;
+   }
+   if (pdk::kernel::safe_pipe(channel.m_pipe) != 0) {
+      return false;
+   }
+   // only our end is non blocking, the child gets an ordinary pipe
+   const int ownEnd = childReads ? channel.m_pipe[1] : channel.m_pipe[0];
+   ::fcntl(ownEnd, F_SETFL, ::fcntl(ownEnd, F_GETFL) | O_NONBLOCK);
+   channel.m_closed = false;
+   return true;
+}
+
+void ProcessPrivate::closeChannel(Channel &channel)
+{
+   destroy_notifier(channel.m_notifier);
+   for (int &fd : channel.m_pipe) {
+      if (fd != -1) {
+         pdk::kernel::safe_close(fd);
+         fd = -1;
+      }
+   }
+   channel.m_closed = true;
+}
+
+void ProcessPrivate::closeWriteChannel()
+{
+   m_writeChannelClosing = false;
+   closeChannel(m_stdinChannel);
+}
+
+void ProcessPrivate::cleanup()
+{
+   stopDeathWatch();
+   closeChannel(m_stdinChannel);
+   closeChannel(m_stdoutChannel);
+   closeChannel(m_stderrChannel);
+   m_writeChannelClosing = false;
+   m_pid = 0;
+}
+
+bool ProcessPrivate::startDeathWatch()
+{
+   PDK_Q(Process);
+#ifdef PDK_HAVE_PIDFD
+   if (pidfd_supported()) {
+      m_deathFd = pidfd_open(static_cast<pid_t>(m_pid));
+   }
+#endif
+   if (m_deathFd == -1) {
+      m_deathSlot = acquire_child_death_slot(static_cast<pid_t>(m_pid));
+      if (!m_deathSlot) {
+         return false;
+      }
+      m_deathFd = m_deathSlot->m_pipe[0];
+      // the child may already be gone, its SIGCHLD came before the
+      // slot existed
+      reap_child_death_slot(m_deathSlot);
+   }
+   if (m_threadData->hasEventDispatcher()) {
+      m_deathNotifier = new ProcessNotifier(m_deathFd, SocketNotifier::Type::Read, this,
+                                            &ProcessPrivate::processDied, apiPtr);
+   }
+   return true;
+}
+
+void ProcessPrivate::stopDeathWatch()
+{
+   destroy_notifier(m_deathNotifier);
+   if (m_deathSlot) {
+      release_child_death_slot(m_deathSlot);
+      m_deathSlot = nullptr;
+   } else if (m_deathFd != -1) {
+      pdk::kernel::safe_close(m_deathFd);
+   }
+   m_deathFd = -1;
+}
+
+bool ProcessPrivate::startProcess()
+{
+   PDK_Q(Process);
+   setProcessState(Process::ProcessState::Starting);
+   if (!openChannel(m_stdinChannel, true) || !openChannel(m_stdoutChannel, false) ||
+       !openChannel(m_stderrChannel, false)) {
+      setError(Process::ProcessError::FailedToStart, pdk::error_string(errno));
+      cleanup();
+      setProcessState(Process::ProcessState::NotRunning);
+      return false;
+   }
+
+   // encode everything up front, nothing may allocate between vfork()
+   // and exec in the fallback path
+   ByteArray program = m_program.toLocal8Bit();
+   ByteArray workingDirectory = m_workingDirectory.toLocal8Bit();
+   std::vector<ByteArray> encoded;
+   encoded.reserve(m_arguments.size() + m_environment.size());
+   std::vector<char *> argv;
+   argv.push_back(program.getRawData());
+   for (const String &argument : m_arguments) {
+      encoded.push_back(argument.toLocal8Bit());
+      argv.push_back(encoded.back().getRawData());
+   }
+   argv.push_back(nullptr);
+   char **envp = environ;
+   std::vector<char *> environment;
+   if (!m_environment.empty()) {
+      for (const String &entry : m_environment) {
+         encoded.push_back(entry.toLocal8Bit());
+         environment.push_back(encoded.back().getRawData());
+      }
+      environment.push_back(nullptr);
+      envp = environment.data();
+   }
+
+   int redirections[3] = {m_stdinChannel.m_pipe[0], m_stdoutChannel.m_pipe[1],
+                          m_stderrChannel.m_pipe[1]};
+   if (m_processChannelMode == Process::ProcessChannelMode::MergedChannels) {
+      redirections[2] = m_stdoutChannel.m_pipe[1];
+   }
+   pid_t pid = -1;
+   int result = spawn_child(&pid, program.getConstRawData(), argv.data(), envp,
+                            m_workingDirectory.isEmpty() ? nullptr : workingDirectory.getConstRawData(),
+                            redirections);
+   if (result != 0) {
+      setError(Process::ProcessError::FailedToStart, pdk::error_string(result));
+      cleanup();
+      setProcessState(Process::ProcessState::NotRunning);
+      return false;
+   }
+   m_pid = pid;
+
+   // the child ends belong to the child now
+   for (int *fd : {&m_stdinChannel.m_pipe[0], &m_stdoutChannel.m_pipe[1], &m_stderrChannel.m_pipe[1]}) {
+      if (*fd != -1) {
+         pdk::kernel::safe_close(*fd);
+         *fd = -1;
+      }
+   }
+   if (!startDeathWatch()) {
+      warning_stream("Process: cannot watch child %d: %s", static_cast<int>(pid), std::strerror(errno));
+      ::kill(pid, SIGKILL);
+      int status;
+      pdk::kernel::safe_waitpid(pid, &status, 0);
+      setError(Process::ProcessError::FailedToStart, pdk::error_string(errno));
+      cleanup();
+      setProcessState(Process::ProcessState::NotRunning);
+      return false;
+   }
+   if (m_threadData->hasEventDispatcher()) {
+      if (m_stdoutChannel.m_pipe[0] != -1) {
+         m_stdoutChannel.m_notifier = new ProcessNotifier(m_stdoutChannel.m_pipe[0], SocketNotifier::Type::Read,
+                                                          this, &ProcessPrivate::readyReadStandardOutput, apiPtr);
+      }
+      if (m_stderrChannel.m_pipe[0] != -1) {
+         m_stderrChannel.m_notifier = new ProcessNotifier(m_stderrChannel.m_pipe[0], SocketNotifier::Type::Read,
+                                                          this, &ProcessPrivate::readyReadStandardError, apiPtr);
+      }
+      m_stdinChannel.m_notifier = new ProcessNotifier(m_stdinChannel.m_pipe[1], SocketNotifier::Type::Write,
+                                                      this, &ProcessPrivate::canWrite, apiPtr);
+      m_stdinChannel.m_notifier->setEnabled(!m_writeBuffer.isEmpty());
+   }
+   setProcessState(Process::ProcessState::Running);
+   if (!apiPtr->isWritable()) {
+      // the child sees end of file on its stdin right away
+      closeWriteChannel();
+   }
+   return true;
+}
+
+bool ProcessPrivate::readyReadStandardOutput()
+{
+   return tryReadFromChannel(m_stdoutChannel);
+}
+
+bool ProcessPrivate::readyReadStandardError()
+{
+   return tryReadFromChannel(m_stderrChannel);
+}
+
+bool ProcessPrivate::tryReadFromChannel(Channel &channel)
+{
+   if (channel.m_pipe[0] == -1) {
+      return false;
+   }
+   int available = 0;
+   if (::ioctl(channel.m_pipe[0], FIONREAD, &available) == -1 || available <= 0) {
+      // zero bytes ready on a readable pipe means end of file
+      available = 1;
+   }
+   const size_t channelIndex = &channel == &m_stderrChannel ? 1 : 0;
+   pdk::pint64 readBytes;
+   if (channelIndex < m_readBuffers.size()) {
+      RingBuffer &buffer = m_readBuffers[channelIndex];
+      char *ptr = buffer.reserve(available);
+      readBytes = pdk::kernel::safe_read(channel.m_pipe[0], ptr, available);
+      buffer.chop(available - std::max(readBytes, static_cast<pdk::pint64>(0)));
+   } else {
+      // opened write only, the output is discarded
+      char discard[4096];
+      readBytes = pdk::kernel::safe_read(channel.m_pipe[0], discard,
+                                         std::min(available, static_cast<int>(sizeof(discard))));
+   }
+   if (readBytes == -1) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+         return false;
+      }
+      setError(Process::ProcessError::ReadError);
+      closeChannel(channel);
+      return false;
+   }
+   if (readBytes == 0) {
+      closeChannel(channel);
+      return false;
+   }
+   if (m_readyReadHandler && channelIndex < m_readBuffers.size()) {
+      m_readyReadHandler(channelIndex == 0 ? Process::ProcessChannel::StandardOutput
+                                           : Process::ProcessChannel::StandardError);
+   }
+   return true;
+}
+
+bool ProcessPrivate::canWrite()
+{
+   if (m_stdinChannel.m_pipe[1] == -1) {
+      return false;
+   }
+   if (m_writeBuffer.isEmpty()) {
+      if (m_stdinChannel.m_notifier) {
+         m_stdinChannel.m_notifier->setEnabled(false);
+      }
+      if (m_writeChannelClosing) {
+         closeWriteChannel();
+      }
+      return false;
+   }
+   const pdk::pint64 written = pdk::kernel::safe_write_nosignal(m_stdinChannel.m_pipe[1],
+                                                                m_writeBuffer.readPointer(),
+                                                                m_writeBuffer.nextDataBlockSize());
+   if (written < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+         return false;
+      }
+      closeChannel(m_stdinChannel);
+      setError(Process::ProcessError::WriteError);
+      return false;
+   }
+   m_writeBuffer.free(written);
+   // @TODO emit signal
+   // emit q->bytesWritten(written);
+   if (m_writeBuffer.isEmpty()) {
+      if (m_stdinChannel.m_notifier) {
+         m_stdinChannel.m_notifier->setEnabled(false);
+      }
+      if (m_writeChannelClosing) {
+         closeWriteChannel();
+      }
+   }
+   return true;
+}
+
+bool ProcessPrivate::processDied()
+{
+   if (m_pid <= 0) {
+      return false;
+   }
+   if (m_deathSlot) {
+      // drain before looking, a change after this point wakes us again
+      drain_pipe(m_deathFd);
+   }
+   int status = 0;
+   // the SIGCHLD handler may have reaped the child already
+   auto reapedByHandler = [this, &status]() {
+      if (!m_deathSlot || !m_deathSlot->m_exited.load(std::memory_order_acquire)) {
+         return false;
+      }
+      status = m_deathSlot->m_status.load(std::memory_order_relaxed);
+      return true;
+   };
+   pid_t result = static_cast<pid_t>(m_pid);
+   if (!reapedByHandler()) {
+      result = pdk::kernel::safe_waitpid(static_cast<pid_t>(m_pid), &status, WNOHANG);
+      if (result == -1 && reapedByHandler()) {
+         // the handler got there in between
+         result = static_cast<pid_t>(m_pid);
+      }
+   }
+   if (result == 0) {
+      // still running
+      return false;
+   }
+   if (result == -1) {
+      // reaped elsewhere, SIGCHLD is probably set to SIG_IGN
+      warning_stream("Process: exit status of child %d is lost: %s",
+                     static_cast<int>(m_pid), std::strerror(errno));
+      status = -1;
+   }
+   processFinished(status);
+   return true;
+}
+
+void ProcessPrivate::processFinished(int status)
+{
+   // pick up whatever the child wrote before it went away
+   while (tryReadFromChannel(m_stdoutChannel)) {
+   }
+   while (tryReadFromChannel(m_stderrChannel)) {
+   }
+   if (status != -1 && WIFEXITED(status)) {
+      m_exitCode = WEXITSTATUS(status);
+      m_exitStatus = Process::ExitStatus::NormalExit;
+   } else {
+      m_exitCode = (status != -1 && WIFSIGNALED(status)) ? WTERMSIG(status) : -1;
+      m_exitStatus = Process::ExitStatus::CrashExit;
+   }
+   cleanup();
+   setProcessState(Process::ProcessState::NotRunning);
+   if (m_exitStatus == Process::ExitStatus::CrashExit) {
+      setError(Process::ProcessError::Crashed);
+   }
+   if (m_finishedHandler) {
+      Process::FinishedHandler handler = m_finishedHandler;
+      handler(m_exitCode, m_exitStatus);
+   }
+}
+
+bool ProcessPrivate::waitForStarted(int msecs)
+{
+   // posix_spawn() reports exec failures itself, so the process is either
+   // running or failed by the time start() returns
+   PDK_UNUSED(msecs);
+   return m_processState == Process::ProcessState::Running;
+}
+
+bool ProcessPrivate::waitForReadyRead(int msecs)
+{
+   ElapsedTimer timer;
+   timer.start();
+   while (true) {
+      ProcessPollSet pollSet(this);
+      int ret = pollSet.poll(substract_from_timeout(msecs, static_cast<int>(timer.elapsed())));
+      if (ret < 0) {
+         break;
+      }
+      if (ret == 0) {
+         setError(Process::ProcessError::Timedout);
+         return false;
+      }
+      bool readyReadEmitted = false;
+      if (pollSet.isActive(ProcessPollSet::Stdout)) {
+         bool canRead = readyReadStandardOutput();
+         if (m_processChannel == Process::ProcessChannel::StandardOutput && canRead) {
+            readyReadEmitted = true;
+         }
+      }
+      if (pollSet.isActive(ProcessPollSet::Stderr)) {
+         bool canRead = readyReadStandardError();
+         if (m_processChannel == Process::ProcessChannel::StandardError && canRead) {
+            readyReadEmitted = true;
+         }
+      }
+      if (readyReadEmitted) {
+         return true;
+      }
+      if (pollSet.isActive(ProcessPollSet::Stdin)) {
+         canWrite();
+      }
+      if (pollSet.isActive(ProcessPollSet::Death) && processDied()) {
+         return false;
+      }
+   }
+   return false;
+}
+
+bool ProcessPrivate::waitForBytesWritten(int msecs)
+{
+   ElapsedTimer timer;
+   timer.start();
+   while (!m_writeBuffer.isEmpty() && m_stdinChannel.m_pipe[1] != -1) {
+      ProcessPollSet pollSet(this);
+      int ret = pollSet.poll(substract_from_timeout(msecs, static_cast<int>(timer.elapsed())));
+      if (ret < 0) {
+         break;
+      }
+      if (ret == 0) {
+         setError(Process::ProcessError::Timedout);
+         return false;
+      }
+      if (pollSet.isActive(ProcessPollSet::Stdout)) {
+         readyReadStandardOutput();
+      }
+      if (pollSet.isActive(ProcessPollSet::Stderr)) {
+         readyReadStandardError();
+      }
+      if (pollSet.isActive(ProcessPollSet::Stdin)) {
+         return canWrite();
+      }
+      if (pollSet.isActive(ProcessPollSet::Death) && processDied()) {
+         return false;
+      }
+   }
+   return false;
+}
+
+bool ProcessPrivate::waitForFinished(int msecs)
+{
+   ElapsedTimer timer;
+   timer.start();
+   while (true) {
+      ProcessPollSet pollSet(this);
+      int ret = pollSet.poll(substract_from_timeout(msecs, static_cast<int>(timer.elapsed())));
+      if (ret < 0) {
+         break;
+      }
+      if (ret == 0) {
+         setError(Process::ProcessError::Timedout);
+         return false;
+      }
+      if (pollSet.isActive(ProcessPollSet::Stdin)) {
+         canWrite();
+      }
+      if (pollSet.isActive(ProcessPollSet::Stdout)) {
+         readyReadStandardOutput();
+      }
+      if (pollSet.isActive(ProcessPollSet::Stderr)) {
+         readyReadStandardError();
+      }
+      if (pollSet.isActive(ProcessPollSet::Death) && processDied()) {
+         return true;
+      }
+   }
+   return false;
+}
+
+void ProcessPrivate::terminateProcess()
+{
+   // a child the SIGCHLD handler reaped may have passed its pid on
+   if (m_pid > 0 && !(m_deathSlot && m_deathSlot->m_exited.load(std::memory_order_acquire))) {
+      ::kill(static_cast<pid_t>(m_pid), SIGTERM);
+   }
+}
+
+void ProcessPrivate::killProcess()
+{
+   // a child the SIGCHLD handler reaped may have passed its pid on
+   if (m_pid > 0 && !(m_deathSlot && m_deathSlot->m_exited.load(std::memory_order_acquire))) {
+      ::kill(static_cast<pid_t>(m_pid), SIGKILL);
+   }
+}
+
+} // internal
+} // process
+} // os
+} // pdk
@@ -31,6 +31,38 @@ using pdk::kernel::EventLoop;
 
 namespace internal {
 
+namespace {
+
+// post event nodes this thread took back from the threads it posts to
+struct PostEventNodeCache
+{
+   ~PostEventNodeCache()
+   {
+      sm_destroyed = true;
+      while (m_nodes) {
+         PostEventNode *next = m_nodes->m_next;
+         delete m_nodes;
+         m_nodes = next;
+      }
+   }
+   
+   PostEventNode *m_nodes = nullptr;
+   static thread_local bool sm_destroyed;
+};
+
+thread_local bool PostEventNodeCache::sm_destroyed = false;
+
+PostEventNodeCache *post_event_node_cache()
+{
+   if (PostEventNodeCache::sm_destroyed) {
+      return nullptr;
+   }
+   static thread_local PostEventNodeCache cache;
+   return &cache;
+}
+
+} // anonymous namespace
+
 ThreadData::ThreadData(int initialRefCount)
    : m_loopLevel(0),
      m_scopeLevel(0),
@@ -61,6 +93,7 @@ ThreadData::~ThreadData()
    Thread *tempPtr = m_thread;
    m_thread = nullptr;
    delete tempPtr;
+   takeIncomingPostEvents();
    for (size_t i = 0; i < m_postEventList.size(); ++i) {
       const PostEvent &postEvent = m_postEventList.at(i);
       if (postEvent.m_event) {
@@ -84,6 +117,53 @@ void ThreadData::deref()
    }
 }
 
+void ThreadData::takeIncomingPostEvents()
+{
+   PostEventNode *node = m_postEventList.takeIncoming();
+   while (node) {
+      PostEventNode *next = node->m_next;
+      ThreadData *target = node->m_postEvent.m_receiver->getImplPtr()->m_threadData;
+      if (!target || target == this) {
+         const PostEvent &postEvent = node->m_postEvent;
+         // the event skipped compressEvent() when it was posted, give it
+         // the chance now that the complete list is at hand
+         if (!CoreApplicationPrivate::compressIncomingEvent(postEvent.m_event, postEvent.m_receiver,
+                                                            &m_postEventList)) {
+            m_postEventList.addEvent(postEvent);
+         }
+         m_postEventList.recycleNode(node);
+      } else {
+         // the receiver was moved to another thread after the event was
+         // queued here, pass the event on to its new thread
+         if (target->m_postEventList.pushIncoming(node)) {
+            AbstractEventDispatcher *dispatcher = target->m_eventDispatcher.loadAcquire();
+            if (dispatcher) {
+               dispatcher->wakeUp();
+            }
+         }
+      }
+      node = next;
+   }
+}
+
+PostEventNode *ThreadData::createPostEventNode(const PostEvent &event)
+{
+   PostEventNodeCache *cache = post_event_node_cache();
+   if (cache) {
+      if (!cache->m_nodes) {
+         cache->m_nodes = m_postEventList.takeFreeNodes();
+      }
+      if (cache->m_nodes) {
+         PostEventNode *node = cache->m_nodes;
+         cache->m_nodes = node->m_next;
+         node->m_postEvent = event;
+         node->m_next = nullptr;
+         return node;
+      }
+   }
+   return new PostEventNode(event);
+}
+
 AdoptedThread::AdoptedThread(ThreadData *data)
    : Thread(*new ThreadPrivate(data))
 {
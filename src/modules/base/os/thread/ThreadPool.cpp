@@ -22,6 +22,7 @@
 #include "pdk/stdext/utility/Algorithms.h"
 #include <algorithm>
 #include <chrono>
+#include <vector>
 
 namespace pdk {
 namespace os {
@@ -29,6 +30,7 @@ namespace thread {
 
 using internal::ThreadPoolPrivate;
 using internal::QueuePage;
+using internal::WorkStealingDeque;
 using pdk::lang::Latin1String;
 using pdk::kernel::ElapsedTimer;
 
@@ -45,56 +47,64 @@ public:
    ThreadPoolThread(ThreadPoolPrivate *manager);
    void run() override;
    void registerThreadInactive();
+   void runTask(Runnable *runnable);
+   Runnable *takeLocalTask();
+   Runnable *nextLocalTask();
+   bool hasLocalTasks() const;
    
    std::condition_variable m_runnableReady;
    ThreadPoolPrivate *m_manager;
    Runnable *m_runnable;
+   WorkStealingDeque *m_localQueue;
+   int m_localQueueIndex;
 };
 
+// the pool thread running on the current thread, if any
+static thread_local ThreadPoolThread *sg_currentPoolThread = nullptr;
+
 ThreadPoolThread::ThreadPoolThread(ThreadPoolPrivate *manager)
    : m_manager(manager),
-     m_runnable(nullptr)
+     m_runnable(nullptr),
+     m_localQueue(nullptr),
+     m_localQueueIndex(-1)
 {
    setStackSize(manager->m_stackSize);
 }
 
 void ThreadPoolThread::run()
 {
+   sg_currentPoolThread = this;
    std::unique_lock<std::mutex> locker(m_manager->m_mutex);
    for(;;) {
       Runnable *runnable = m_runnable;
       m_runnable = nullptr;
       do {
          if (runnable) {
-            const bool autoDelete = runnable->autoDelete();
             // run the task
             locker.unlock();
-            try {
-               runnable->run();
-            } catch (...) {
-               warning_stream("pdk Concurrent has caught an exception thrown from a worker thread.\n"
-                              "This is not supported, exceptions thrown in worker threads must be\n"
-                              "caught before control returns to Qt Concurrent.");
-               registerThreadInactive();
-               throw;
+            runTask(runnable);
+            // work through the local queue and steal without taking the pool lock
+            while ((runnable = nextLocalTask()) != nullptr) {
+               runTask(runnable);
             }
             locker.lock();
-            if (autoDelete && !--runnable->m_ref) {
-               delete runnable;
-            }
          }
          // if too many threads are active, expire this thread
-         if (m_manager->tooManyThreadsActive()) {
+         if (m_manager->tooManyThreadsActive() && !hasLocalTasks()) {
             break;
          }
          if (m_manager->m_queue.empty()) {
-            runnable = nullptr;
+            runnable = takeLocalTask();
+            if (runnable) {
+               continue;
+            }
             break;
          }
          QueuePage *page = m_manager->m_queue.front();
          runnable = page->pop();
+         m_manager->taskDequeued(page);
          if (page->isFinished()) {
-            m_manager->m_queue.pop_back();
+            m_manager->m_queue.pop_front();
             delete page;
          }
       } while (true);
@@ -107,6 +117,8 @@ void ThreadPoolThread::run()
       bool expired = m_manager->tooManyThreadsActive();
       if (!expired) {
          m_manager->m_waitingThreads.push_back(this);
+         m_manager->m_waitingThreadCount.store(static_cast<int>(m_manager->m_waitingThreads.size()),
+                                               std::memory_order_relaxed);
          registerThreadInactive();
          // wait for work, exiting after the expiry timeout is reached
          
@@ -116,6 +128,8 @@ void ThreadPoolThread::run()
                                m_manager->m_waitingThreads.end(), this);
          if (iter != m_manager->m_waitingThreads.end()) {
             m_manager->m_waitingThreads.erase(iter);
+            m_manager->m_waitingThreadCount.store(static_cast<int>(m_manager->m_waitingThreads.size()),
+                                                  std::memory_order_relaxed);
             expired = true;
          }
       }
@@ -134,8 +148,68 @@ void ThreadPoolThread::registerThreadInactive()
    } 
 }
 
+void ThreadPoolThread::runTask(Runnable *runnable)
+{
+   const bool autoDelete = runnable->autoDelete();
+   try {
+      runnable->run();
+   } catch (...) {
+      warning_stream("pdk Concurrent has caught an exception thrown from a worker thread.\n"
+                     "This is not supported, exceptions thrown in worker threads must be\n"
+                     "caught before control returns to Qt Concurrent.");
+      registerThreadInactive();
+      throw;
+   }
+   if (autoDelete && !--runnable->m_ref) {
+      delete runnable;
+   }
+}
+
+Runnable *ThreadPoolThread::takeLocalTask()
+{
+   if (!m_localQueue) {
+      return nullptr;
+   }
+   // newest local task first, it is the one most likely still in cache
+   Runnable *runnable = m_localQueue->pop();
+   if (!runnable && m_manager->m_workStealing.load(std::memory_order_relaxed)) {
+      runnable = m_manager->stealTask(m_localQueueIndex);
+   }
+   return runnable;
+}
+
+Runnable *ThreadPoolThread::nextLocalTask()
+{
+   // let the higher priority tasks waiting on the shared queue go first
+   if (m_manager->m_queuedPriorityTasks.load(std::memory_order_acquire) > 0) {
+      return nullptr;
+   }
+   return takeLocalTask();
+}
+
+bool ThreadPoolThread::hasLocalTasks() const
+{
+   return m_localQueue && !m_localQueue->isEmpty();
+}
+
 ThreadPoolPrivate:: ThreadPoolPrivate()
-{}
+   : m_workStealing(false),
+     m_waitingThreadCount(0),
+     m_queuedPriorityTasks(0),
+     m_localQueueCount(0)
+{
+   for (std::atomic<WorkStealingDeque *> &queue : m_localQueues) {
+      queue.store(nullptr, std::memory_order_relaxed);
+   }
+}
+
+ThreadPoolPrivate::~ThreadPoolPrivate()
+{
+   const int count = m_localQueueCount.load(std::memory_order_acquire);
+   for (int i = 0; i < count; ++i) {
+      delete m_localQueues[i].load(std::memory_order_relaxed);
+   }
+}
 
 bool ThreadPoolPrivate::tryStart(Runnable *task)
 {
@@ -152,8 +226,7 @@ bool ThreadPoolPrivate::tryStart(Runnable *task)
    if (m_waitingThreads.size() > 0) {
       // recycle an available thread
       enqueueTask(task);
-      m_waitingThreads.front()->m_runnableReady.notify_one();
-      m_waitingThreads.pop_front();
+      wakeWaitingThread();
       return true;
    }
    
@@ -187,7 +260,9 @@ void ThreadPoolPrivate::enqueueTask(Runnable *runnable, int priority)
    if (runnable->autoDelete()) {
       ++runnable->m_ref;
    }
-   
+   if (priority > 0) {
+      m_queuedPriorityTasks.fetch_add(1, std::memory_order_release);
+   }
    for (QueuePage *page : std::as_const(m_queue)) {
       if (page->getPriority() == priority && !page->isFull()) {
          page->push(runnable);
@@ -198,6 +273,86 @@ void ThreadPoolPrivate::enqueueTask(Runnable *runnable, int priority)
    m_queue.insert(iter, new QueuePage(runnable, priority));
 }
 
+bool ThreadPoolPrivate::tryEnqueueLocalTask(Runnable *task)
+{
+   PDK_ASSERT(task != nullptr);
+   ThreadPoolThread *current = sg_currentPoolThread;
+   if (!m_workStealing.load(std::memory_order_relaxed) || !current ||
+       current->m_manager != this || !current->m_localQueue) {
+      return false;
+   }
+   if (task->autoDelete()) {
+      ++task->m_ref;
+   }
+   if (!current->m_localQueue->push(task)) {
+      // local queue is full, fall back to the shared queue
+      if (task->autoDelete()) {
+         --task->m_ref;
+      }
+      return false;
+   }
+   if (m_waitingThreadCount.load(std::memory_order_relaxed) > 0) {
+      // give a waiting worker the chance to steal it
+      std::lock_guard<std::mutex> locker(m_mutex);
+      wakeWaitingThread();
+   }
+   return true;
+}
+
+Runnable *ThreadPoolPrivate::stealTask(int thiefIndex)
+{
+   const int count = m_localQueueCount.load(std::memory_order_acquire);
+   // start next to the thief so that the victims get spread out
+   for (int i = 1; i <= count; ++i) {
+      const int index = (thiefIndex + i) % count;
+      if (index == thiefIndex) {
+         continue;
+      }
+      Runnable *runnable = m_localQueues[index].load(std::memory_order_acquire)->steal();
+      if (runnable) {
+         return runnable;
+      }
+   }
+   return nullptr;
+}
+
+void ThreadPoolPrivate::taskDequeued(const QueuePage *page)
+{
+   if (page->getPriority() > 0) {
+      m_queuedPriorityTasks.fetch_sub(1, std::memory_order_release);
+   }
+}
+
+void ThreadPoolPrivate::wakeWaitingThread()
+{
+   if (m_waitingThreads.empty()) {
+      return;
+   }
+   m_waitingThreads.front()->m_runnableReady.notify_one();
+   m_waitingThreads.pop_front();
+   m_waitingThreadCount.store(static_cast<int>(m_waitingThreads.size()), std::memory_order_relaxed);
+}
+
+void ThreadPoolPrivate::assignLocalQueue(ThreadPoolThread *thread)
+{
+   int index;
+   if (!m_freeLocalQueues.empty()) {
+      index = m_freeLocalQueues.back();
+      m_freeLocalQueues.pop_back();
+   } else {
+      index = m_localQueueCount.load(std::memory_order_relaxed);
+      if (index >= MaxLocalQueues) {
+         // this thread only works from the shared queue
+         return;
+      }
+      // the queues live as long as the pool, so thieves never see a dangling one
+      m_localQueues[index].store(new WorkStealingDeque, std::memory_order_release);
+      m_localQueueCount.store(index + 1, std::memory_order_release);
+   }
+   thread->m_localQueueIndex = index;
+   thread->m_localQueue = m_localQueues[index].load(std::memory_order_relaxed);
+}
+
 int ThreadPoolPrivate::getActiveThreadCount() const
 {
    return (m_allThreads.size()
@@ -215,6 +370,7 @@ void ThreadPoolPrivate::tryToStartMoreThreads()
          break;
       }
       page->pop();
+      taskDequeued(page);
       if (page->isFinished()) {
          m_queue.pop_front();
          delete page;
@@ -233,6 +389,7 @@ void ThreadPoolPrivate::startThread(Runnable *runnable)
    PDK_ASSERT(runnable != nullptr);
    pdk::utils::ScopedPointer <ThreadPoolThread> thread(new ThreadPoolThread(this));
    thread->setObjectName(Latin1String("Thread (pooled)"));
+   assignLocalQueue(thread.getData());
    PDK_ASSERT(m_allThreads.end() == std::find(m_allThreads.begin(), m_allThreads.end(), thread.getData())); 
    // if this assert hits, we have an ABA problem (deleted threads don't get removed here)
    m_allThreads.push_back(thread.getData());
@@ -253,15 +410,22 @@ void ThreadPoolPrivate::reset()
       std::list<ThreadPoolThread *> allThreadsCopy;
       allThreadsCopy.swap(m_allThreads);
       locker.unlock();
+      std::vector<int> releasedQueues;
       for (ThreadPoolThread *thread : std::as_const(allThreadsCopy)) {
          thread->m_runnableReady.notify_all();
          thread->wait();
+         // a finished worker always leaves its local queue empty
+         if (thread->m_localQueue) {
+            releasedQueues.push_back(thread->m_localQueueIndex);
+         }
          delete thread;
       }
       locker.lock();
+      m_freeLocalQueues.insert(m_freeLocalQueues.end(), releasedQueues.begin(), releasedQueues.end());
       // repeat until all newly arrived threads have also completed
    }
    m_waitingThreads.clear();
+   m_waitingThreadCount.store(0, std::memory_order_relaxed);
    m_expiredThreads.clear();
    m_isExiting = false;
 }
@@ -299,6 +463,18 @@ void ThreadPoolPrivate::clear()
    }
    pdk::stdext::delete_all(m_queue);
    m_queue.clear();
+   m_queuedPriorityTasks.store(0, std::memory_order_release);
+   // the local queues can be drained from any thread by stealing
+   const int count = m_localQueueCount.load(std::memory_order_acquire);
+   for (int i = 0; i < count; ++i) {
+      WorkStealingDeque *queue = m_localQueues[i].load(std::memory_order_acquire);
+      while (!queue->isEmpty()) {
+         Runnable *runnable = queue->steal();
+         if (runnable && runnable->autoDelete() && !--runnable->m_ref) {
+            delete runnable;
+         }
+      }
+   }
 }
 
 void ThreadPoolPrivate::stealAndRunRunnable(Runnable *runnable)
@@ -316,6 +492,8 @@ void ThreadPoolPrivate::stealAndRunRunnable(Runnable *runnable)
 
 } // internal
 
+// only the shared queue is searched, a task sitting on a worker's local
+// queue is treated as already started
 bool ThreadPool::tryTake(Runnable *runnable)
 {
    PDK_D(ThreadPool);
@@ -327,6 +505,7 @@ bool ThreadPool::tryTake(Runnable *runnable)
       
       for (QueuePage *page : std::as_const(implPtr->m_queue)) {
          if (page->tryTake(runnable)) {
+            implPtr->taskDequeued(page);
             if (page->isFinished()) {
                auto iter = std::find(implPtr->m_queue.begin(), implPtr->m_queue.end(), page);
                implPtr->m_queue.erase(iter);
@@ -363,13 +542,14 @@ void ThreadPool::start(Runnable *runnable, int priority)
    }
    
    PDK_D(ThreadPool);
+   // tasks started from one of our workers stay on its local queue
+   if (priority == 0 && implPtr->tryEnqueueLocalTask(runnable)) {
+      return;
+   }
    std::unique_lock<std::mutex> locker(implPtr->m_mutex);
    if (!implPtr->tryStart(runnable)) {
       implPtr->enqueueTask(runnable, priority);
-      if (!implPtr->m_waitingThreads.empty()) {
-         implPtr->m_waitingThreads.front()->m_runnableReady.notify_one();
-         implPtr->m_waitingThreads.pop_front();
-      }
+      implPtr->wakeWaitingThread();
    }
 }
 
@@ -469,6 +649,18 @@ void ThreadPool::clear()
    implPtr->clear();
 }
 
+void ThreadPool::setWorkStealingEnabled(bool enabled)
+{
+   PDK_D(ThreadPool);
+   implPtr->m_workStealing.store(enabled, std::memory_order_relaxed);
+}
+
+bool ThreadPool::isWorkStealingEnabled() const
+{
+   PDK_D(const ThreadPool);
+   return implPtr->m_workStealing.load(std::memory_order_relaxed);
+}
+
 } // thread
 } // os
 } // pdk
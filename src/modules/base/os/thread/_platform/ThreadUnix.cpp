@@ -22,6 +22,8 @@
 
 #if defined(PDK_OS_DARWIN)
 #  include "pdk/kernel/EventDispatcherCf.h"
+#elif defined(PDK_OS_LINUX)
+#  include "pdk/kernel/EventDispatcherEpoll.h"
 #endif
 
 #include <thread>
@@ -85,6 +87,8 @@ using pdk::kernel::internal::CoreApplicationPrivate;
 using pdk::kernel::EventDispatcherUNIX;
 #ifdef PDK_OS_DARWIN
 using pdk::kernel::EventDispatcherCoreFoundation;
+#elif defined(PDK_OS_LINUX)
+using pdk::kernel::EventDispatcherEpoll;
 #endif
 
 PDK_STATIC_ASSERT(sizeof(pthread_t) <= sizeof(pdk::HANDLE));
@@ -323,6 +327,14 @@ void ThreadPrivate::createEventDispatcher(ThreadData *data)
    } else {
       data->m_eventDispatcher.storeRelease(new EventDispatcherUNIX);
    }
+#elif defined(PDK_OS_LINUX)
+   bool ok = false;
+   int value = pdk::env_var_intval("PDK_EVENT_DISPATCHER_POLL", &ok);
+   if (ok && value > 0) {
+      data->m_eventDispatcher.storeRelease(new EventDispatcherUNIX);
+   } else {
+      data->m_eventDispatcher.storeRelease(new EventDispatcherEpoll);
+   }
 #else
    data->m_eventDispatcher.storeRelease(new EventDispatcherUNIX);
 #endif
@@ -21,6 +21,19 @@
 #include "pdk/base/lang/Character.h"
 #include "pdk/base/lang/StringIterator.h"
 #include "pdk/pal/kernel/Simd.h"
+#include "pdk/utils/Funcs.h"
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#ifdef PDK_SIMD_DISPATCH_X86
+// compiled for every x86 build, only used when the cpu has avx2
+#  define PDK_UTF_CODEC_AVX2
+#endif
+
+#if defined(__ARM_NEON__) && defined(PDK_PROCESSOR_ARM_64) && PDK_BYTE_ORDER == PDK_LITTLE_ENDIAN
+#  define PDK_UTF_CODEC_NEON
+#endif
 
 namespace pdk {
 namespace text {
@@ -37,8 +50,7 @@ enum { Endian = 0, Data = 1 };
 
 static const uchar utf8bom[] = { 0xef, 0xbb, 0xbf };
 
-#if (defined(__SSE2__) && defined(PDK_COMPILER_SUPPORTS_SSE2)) \
-   || (defined(__ARM_NEON__) && defined(PDK_PROCESSOR_ARM_64))
+#if defined(__SSE2__) || (defined(__ARM_NEON__) && defined(PDK_PROCESSOR_ARM_64))
 static PDK_ALWAYS_INLINE uint bit_scan_reverse(unsigned v) noexcept
 {
    uint result = pdk::count_leading_zero_bits(v);
@@ -50,7 +62,7 @@ static PDK_ALWAYS_INLINE uint bit_scan_reverse(unsigned v) noexcept
 }
 #endif
 
-#if defined(__SSE2__) && defined(PDK_COMPILER_SUPPORTS_SSE2)
+#if defined(__SSE2__)
 static inline bool simd_encode_ascii(uchar *&dst, const char16_t *&nextAscii, const char16_t *&src, const char16_t *end)
 {
    // do sixteen characters at a time
@@ -81,7 +93,7 @@ static inline bool simd_encode_ascii(uchar *&dst, const char16_t *&nextAscii, co
          // characters still coming
          nextAscii = src + bit_scan_reverse(n) + 1;
          
-         n = pdk::count_trailing_zero_bits(n);
+         n = pdk::count_trailing_zero_bits(static_cast<uint>(n));
          dst += n;
          src += n;
          return false;
@@ -137,6 +149,20 @@ static inline bool simd_decode_ascii(char16_t *&dst, const uchar *&nextAscii, co
    }
    return src == end;
 }
+#elif defined(PDK_UTF_CODEC_NEON)
+// the neon transcoder widens and narrows ascii blocks itself, the scalar
+// loops go one character at a time and hand back to it
+static inline bool simd_encode_ascii(uchar *&, const char16_t *&nextAscii, const char16_t *&src, const char16_t *)
+{
+   nextAscii = src + 1;
+   return false;
+}
+
+static inline bool simd_decode_ascii(char16_t *&, const uchar *&nextAscii, const uchar *&src, const uchar *)
+{
+   nextAscii = src + 1;
+   return false;
+}
 #else
 static inline bool simd_encode_ascii(uchar *, const char16_t *, const char16_t *, const char16_t *)
 {
@@ -149,6 +175,348 @@ static inline bool simd_decode_ascii(char16_t *, const uchar *, const uchar *, c
 }
 #endif
 
+#if defined(PDK_UTF_CODEC_AVX2) || defined(PDK_UTF_CODEC_NEON)
+// blocks of one to three byte utf-8 sequences are transcoded with shuffle
+// tables, anything else is left for the scalar loops
+struct Utf8DecodeStep
+{
+   // bytes taken and characters written, zero when the block must go scalar
+   uchar m_consumed;
+   uchar m_count;
+   // characters in 32 bit lanes when a three byte sequence is among them
+   bool m_wide;
+   ushort m_shuffle;
+};
+
+struct Utf8ShuffleMask
+{
+   uchar m_bytes[16];
+};
+
+struct Utf8Tables
+{
+   // indexed by the twelve bit mask of the bytes ending a character
+   Utf8DecodeStep m_decodeSteps[4096];
+   std::vector<Utf8ShuffleMask> m_decodeShuffles;
+   // indexed by the lanes at or above U+0080 and those at or above U+0800
+   Utf8ShuffleMask m_encodeShuffles[256];
+   uchar m_encodeLengths[256];
+};
+
+static void build_utf8_decode_steps(Utf8Tables &tables)
+{
+   std::map<std::vector<uchar>, ushort> shuffleIds;
+   for (uint mask = 0; mask < 4096; ++mask) {
+      int lengths[12];
+      int count = 0;
+      int begin = 0;
+      for (int i = 0; i < 12; ++i) {
+         if (mask & (1u << i)) {
+            lengths[count++] = i - begin + 1;
+            begin = i + 1;
+         }
+      }
+      // six characters of one or two bytes fill 16 bit lanes, otherwise take
+      // up to four characters of at most three bytes in 32 bit lanes
+      int taken = 0;
+      while (taken < count && taken < 6 && lengths[taken] <= 2) {
+         ++taken;
+      }
+      const bool wide = taken < 6;
+      if (wide) {
+         taken = 0;
+         while (taken < count && taken < 4 && lengths[taken] <= 3) {
+            ++taken;
+         }
+      }
+      std::vector<uchar> shuffle(16, 0x80);
+      int pos = 0;
+      for (int j = 0; j < taken; ++j) {
+         const int length = lengths[j];
+         // lanes hold the last byte first so the lead ends up highest
+         if (wide) {
+            shuffle[4 * j] = pos + length - 1;
+            if (length >= 2) {
+               shuffle[4 * j + 1] = pos + length - 2;
+            }
+            if (length == 3) {
+               shuffle[4 * j + 2] = pos;
+            }
+         } else {
+            shuffle[2 * j] = pos + length - 1;
+            if (length == 2) {
+               shuffle[2 * j + 1] = pos;
+            }
+         }
+         pos += length;
+      }
+      auto iter = shuffleIds.find(shuffle);
+      if (iter == shuffleIds.end()) {
+         Utf8ShuffleMask bytes;
+         std::copy(shuffle.begin(), shuffle.end(), bytes.m_bytes);
+         iter = shuffleIds.emplace(shuffle, ushort(tables.m_decodeShuffles.size())).first;
+         tables.m_decodeShuffles.push_back(bytes);
+      }
+      Utf8DecodeStep &step = tables.m_decodeSteps[mask];
+      step.m_consumed = uchar(pos);
+      step.m_count = uchar(taken);
+      step.m_wide = wide;
+      step.m_shuffle = iter->second;
+   }
+}
+
+static void build_utf8_encode_shuffles(Utf8Tables &tables)
+{
+   for (uint key = 0; key < 256; ++key) {
+      Utf8ShuffleMask &shuffle = tables.m_encodeShuffles[key];
+      std::fill(shuffle.m_bytes, shuffle.m_bytes + 16, uchar(0x80));
+      int pos = 0;
+      for (int lane = 0; lane < 4; ++lane) {
+         const int length = 1 + ((key >> lane) & 1) + ((key >> (lane + 4)) & 1);
+         for (int i = 0; i < length; ++i) {
+            shuffle.m_bytes[pos++] = uchar(4 * lane + i);
+         }
+      }
+      tables.m_encodeLengths[key] = uchar(pos);
+   }
+}
+
+static const Utf8Tables &utf8_tables()
+{
+   static const Utf8Tables tables = [] {
+      Utf8Tables result;
+      build_utf8_decode_steps(result);
+      build_utf8_encode_shuffles(result);
+      return result;
+   }();
+   return tables;
+}
+
+// every byte of the step is ascii, a lead or a continuation, the leads are
+// followed by exactly the continuations they ask for and no three byte
+// sequence is overlong or a surrogate
+static inline bool utf8_step_is_valid(const Utf8DecodeStep &step, uint ascii, uint continuation,
+                                      uint lead2, uint lead3, uint lowContinuation, uint e0, uint ed)
+{
+   const uint consumed = (1u << step.m_consumed) - 1;
+   const uint expected = (lead2 << 1) | (lead3 << 1) | (lead3 << 2);
+   const uint invalid = ((e0 << 1) & lowContinuation) | ((ed << 1) & continuation & ~lowContinuation);
+   // the byte after the step must not be owed to a lead inside it
+   return step.m_consumed != 0
+         && ((ascii | continuation | lead2 | lead3) & consumed) == consumed
+         && !((expected ^ continuation) & (consumed | (consumed + 1)))
+         && !(invalid & consumed);
+}
+#endif
+
+static const uchar *decode_utf8_scalar(char16_t *&, const uchar *src, const uchar *)
+{
+   return src;
+}
+
+static const char16_t *encode_utf8_scalar(uchar *&, const char16_t *src, const char16_t *)
+{
+   return src;
+}
+
+#ifdef PDK_UTF_CODEC_AVX2
+PDK_FUNCTION_TARGET(AVX2) static const uchar *decode_utf8_avx2(char16_t *&dst, const uchar *src, const uchar *end)
+{
+   const Utf8Tables &tables = utf8_tables();
+   // stores write up to sixteen characters, the caller's buffer has room for
+   // one per remaining byte
+   while (end - src >= 16) {
+      const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+      const uint nonAscii = _mm_movemask_epi8(data);
+      if (!nonAscii) {
+         _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst), _mm256_cvtepu8_epi16(data));
+         src += 16;
+         dst += 16;
+         continue;
+      }
+      // signed compares, 0x80 to 0xbf are the bytes below -64
+      const uint continuation = _mm_movemask_epi8(_mm_cmplt_epi8(data, _mm_set1_epi8(-64)));
+      const Utf8DecodeStep &step = tables.m_decodeSteps[(~continuation >> 1) & 0xfff];
+      const uint lead2 = _mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(data, _mm_set1_epi8(-63)),
+                                                         _mm_cmplt_epi8(data, _mm_set1_epi8(-32))));
+      const uint lead3 = _mm_movemask_epi8(_mm_and_si128(_mm_cmpgt_epi8(data, _mm_set1_epi8(-33)),
+                                                         _mm_cmplt_epi8(data, _mm_set1_epi8(-16))));
+      const uint lowContinuation = _mm_movemask_epi8(_mm_cmplt_epi8(data, _mm_set1_epi8(-96)));
+      const uint e0 = _mm_movemask_epi8(_mm_cmpeq_epi8(data, _mm_set1_epi8(char(0xe0))));
+      const uint ed = _mm_movemask_epi8(_mm_cmpeq_epi8(data, _mm_set1_epi8(char(0xed))));
+      if (!utf8_step_is_valid(step, ~nonAscii, continuation, lead2, lead3, lowContinuation, e0, ed)) {
+         break;
+      }
+      const __m128i lanes = _mm_shuffle_epi8(data, _mm_loadu_si128(
+                                                reinterpret_cast<const __m128i *>(tables.m_decodeShuffles[step.m_shuffle].m_bytes)));
+      if (step.m_wide) {
+         const __m128i value = _mm_or_si128(_mm_and_si128(lanes, _mm_set1_epi32(0x7f)),
+                                            _mm_or_si128(_mm_and_si128(_mm_srli_epi32(lanes, 2), _mm_set1_epi32(0xfc0)),
+                                                         _mm_and_si128(_mm_srli_epi32(lanes, 4), _mm_set1_epi32(0xf000))));
+         _mm_storel_epi64(reinterpret_cast<__m128i *>(dst), _mm_packus_epi32(value, value));
+      } else {
+         const __m128i value = _mm_or_si128(_mm_and_si128(lanes, _mm_set1_epi16(0x7f)),
+                                            _mm_slli_epi16(_mm_and_si128(_mm_srli_epi16(lanes, 8), _mm_set1_epi16(0x1f)), 6));
+         _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), value);
+      }
+      src += step.m_consumed;
+      dst += step.m_count;
+   }
+   return src;
+}
+
+PDK_FUNCTION_TARGET(AVX2) static const char16_t *encode_utf8_avx2(uchar *&dst, const char16_t *src, const char16_t *end)
+{
+   const Utf8Tables &tables = utf8_tables();
+   // eight characters make at most 24 bytes and the last store writes 16 past
+   // the first half, the caller's buffer has room for three per character
+   while (end - src >= 16) {
+      const __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+      const __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(data, _mm_set1_epi16(short(0xf800))),
+                                                 _mm_set1_epi16(short(0xd800)));
+      if (_mm_movemask_epi8(surrogates)) {
+         break;
+      }
+      const __m256i value = _mm256_cvtepu16_epi32(data);
+      const __m256i low = _mm256_and_si256(value, _mm256_set1_epi32(0x3f));
+      const __m256i middle = _mm256_and_si256(_mm256_srli_epi32(value, 6), _mm256_set1_epi32(0x3f));
+      const __m256i two = _mm256_or_si256(_mm256_set1_epi32(0x80c0),
+                                          _mm256_or_si256(_mm256_srli_epi32(value, 6), _mm256_slli_epi32(low, 8)));
+      const __m256i three = _mm256_or_si256(_mm256_or_si256(_mm256_set1_epi32(0x8080e0), _mm256_srli_epi32(value, 12)),
+                                            _mm256_or_si256(_mm256_slli_epi32(middle, 8), _mm256_slli_epi32(low, 16)));
+      const __m256i atLeastTwo = _mm256_cmpgt_epi32(value, _mm256_set1_epi32(0x7f));
+      const __m256i atLeastThree = _mm256_cmpgt_epi32(value, _mm256_set1_epi32(0x7ff));
+      const __m256i lanes = _mm256_blendv_epi8(_mm256_blendv_epi8(value, two, atLeastTwo), three, atLeastThree);
+      const uint twoMask = _mm256_movemask_ps(_mm256_castsi256_ps(atLeastTwo));
+      const uint threeMask = _mm256_movemask_ps(_mm256_castsi256_ps(atLeastThree));
+      const uint lowKey = (twoMask & 0xf) | ((threeMask & 0xf) << 4);
+      const uint highKey = (twoMask >> 4) | (threeMask & 0xf0);
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                       _mm_shuffle_epi8(_mm256_castsi256_si128(lanes), _mm_loadu_si128(
+                                           reinterpret_cast<const __m128i *>(tables.m_encodeShuffles[lowKey].m_bytes))));
+      dst += tables.m_encodeLengths[lowKey];
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                       _mm_shuffle_epi8(_mm256_extracti128_si256(lanes, 1), _mm_loadu_si128(
+                                           reinterpret_cast<const __m128i *>(tables.m_encodeShuffles[highKey].m_bytes))));
+      dst += tables.m_encodeLengths[highKey];
+      src += 8;
+   }
+   return src;
+}
+
+#endif
+
+#ifdef PDK_UTF_CODEC_NEON
+// the bits of a compare result, one per byte lane
+static inline uint movemask_neon(uint8x16_t mask)
+{
+   static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+   const uint8x16_t bits = vandq_u8(mask, vld1q_u8(weights));
+   return vaddv_u8(vget_low_u8(bits)) | (uint(vaddv_u8(vget_high_u8(bits))) << 8);
+}
+
+static inline uint movemask_neon(uint32x4_t mask)
+{
+   static const uint32_t weights[4] = {1, 2, 4, 8};
+   return vaddvq_u32(vandq_u32(mask, vld1q_u32(weights)));
+}
+
+static const uchar *decode_utf8_neon(char16_t *&dst, const uchar *src, const uchar *end)
+{
+   const Utf8Tables &tables = utf8_tables();
+   while (end - src >= 16) {
+      const uint8x16_t data = vld1q_u8(src);
+      if (vmaxvq_u8(data) < 0x80) {
+         vst1q_u16(reinterpret_cast<uint16_t *>(dst), vmovl_u8(vget_low_u8(data)));
+         vst1q_u16(reinterpret_cast<uint16_t *>(dst) + 8, vmovl_high_u8(data));
+         src += 16;
+         dst += 16;
+         continue;
+      }
+      const uint continuation = movemask_neon(vceqq_u8(vandq_u8(data, vdupq_n_u8(0xc0)), vdupq_n_u8(0x80)));
+      const Utf8DecodeStep &step = tables.m_decodeSteps[(~continuation >> 1) & 0xfff];
+      const uint ascii = movemask_neon(vcltq_u8(data, vdupq_n_u8(0x80)));
+      const uint lead2 = movemask_neon(vandq_u8(vcgeq_u8(data, vdupq_n_u8(0xc2)), vcleq_u8(data, vdupq_n_u8(0xdf))));
+      const uint lead3 = movemask_neon(vceqq_u8(vandq_u8(data, vdupq_n_u8(0xf0)), vdupq_n_u8(0xe0)));
+      const uint lowContinuation = movemask_neon(vceqq_u8(vandq_u8(data, vdupq_n_u8(0xe0)), vdupq_n_u8(0x80)));
+      const uint e0 = movemask_neon(vceqq_u8(data, vdupq_n_u8(0xe0)));
+      const uint ed = movemask_neon(vceqq_u8(data, vdupq_n_u8(0xed)));
+      if (!utf8_step_is_valid(step, ascii, continuation, lead2, lead3, lowContinuation, e0, ed)) {
+         break;
+      }
+      const uint8x16_t lanes = vqtbl1q_u8(data, vld1q_u8(tables.m_decodeShuffles[step.m_shuffle].m_bytes));
+      if (step.m_wide) {
+         const uint32x4_t wide = vreinterpretq_u32_u8(lanes);
+         const uint32x4_t value = vorrq_u32(vandq_u32(wide, vdupq_n_u32(0x7f)),
+                                            vorrq_u32(vandq_u32(vshrq_n_u32(wide, 2), vdupq_n_u32(0xfc0)),
+                                                      vandq_u32(vshrq_n_u32(wide, 4), vdupq_n_u32(0xf000))));
+         vst1_u16(reinterpret_cast<uint16_t *>(dst), vmovn_u32(value));
+      } else {
+         const uint16x8_t narrow = vreinterpretq_u16_u8(lanes);
+         const uint16x8_t value = vorrq_u16(vandq_u16(narrow, vdupq_n_u16(0x7f)),
+                                            vshlq_n_u16(vandq_u16(vshrq_n_u16(narrow, 8), vdupq_n_u16(0x1f)), 6));
+         vst1q_u16(reinterpret_cast<uint16_t *>(dst), value);
+      }
+      src += step.m_consumed;
+      dst += step.m_count;
+   }
+   return src;
+}
+
+static inline void encode_utf8_lanes_neon(uchar *&dst, uint32x4_t value, const Utf8Tables &tables)
+{
+   const uint32x4_t low = vandq_u32(value, vdupq_n_u32(0x3f));
+   const uint32x4_t middle = vandq_u32(vshrq_n_u32(value, 6), vdupq_n_u32(0x3f));
+   const uint32x4_t two = vorrq_u32(vdupq_n_u32(0x80c0), vorrq_u32(vshrq_n_u32(value, 6), vshlq_n_u32(low, 8)));
+   const uint32x4_t three = vorrq_u32(vorrq_u32(vdupq_n_u32(0x8080e0), vshrq_n_u32(value, 12)),
+                                      vorrq_u32(vshlq_n_u32(middle, 8), vshlq_n_u32(low, 16)));
+   const uint32x4_t atLeastTwo = vcgtq_u32(value, vdupq_n_u32(0x7f));
+   const uint32x4_t atLeastThree = vcgtq_u32(value, vdupq_n_u32(0x7ff));
+   const uint32x4_t lanes = vbslq_u32(atLeastThree, three, vbslq_u32(atLeastTwo, two, value));
+   const uint key = movemask_neon(atLeastTwo) | (movemask_neon(atLeastThree) << 4);
+   vst1q_u8(dst, vqtbl1q_u8(vreinterpretq_u8_u32(lanes), vld1q_u8(tables.m_encodeShuffles[key].m_bytes)));
+   dst += tables.m_encodeLengths[key];
+}
+
+static const char16_t *encode_utf8_neon(uchar *&dst, const char16_t *src, const char16_t *end)
+{
+   const Utf8Tables &tables = utf8_tables();
+   while (end - src >= 16) {
+      const uint16x8_t data = vld1q_u16(reinterpret_cast<const uint16_t *>(src));
+      if (vmaxvq_u16(vceqq_u16(vandq_u16(data, vdupq_n_u16(0xf800)), vdupq_n_u16(0xd800)))) {
+         break;
+      }
+      encode_utf8_lanes_neon(dst, vmovl_u16(vget_low_u16(data)), tables);
+      encode_utf8_lanes_neon(dst, vmovl_high_u16(data), tables);
+      src += 8;
+   }
+   return src;
+}
+#endif
+
+// PDK_NO_CPU_FEATURE=avx2 hides avx2 from the detection and leaves the
+// blocks to the scalar loops
+static Utf8Transcoder select_utf8_transcoder()
+{
+#ifdef PDK_UTF_CODEC_AVX2
+   if (CPU_HAS_FEATURE(AVX2)) {
+      return Utf8Transcoder{decode_utf8_avx2, encode_utf8_avx2, "avx2"};
+   }
+#endif
+#ifdef PDK_UTF_CODEC_NEON
+   if (CPU_HAS_FEATURE(NEON)) {
+      return Utf8Transcoder{decode_utf8_neon, encode_utf8_neon, "neon"};
+   }
+#endif
+   return Utf8Transcoder{decode_utf8_scalar, encode_utf8_scalar, "scalar"};
+}
+
+const Utf8Transcoder &utf8_transcoder()
+{
+   static const Utf8Transcoder transcoder = select_utf8_transcoder();
+   return transcoder;
+}
+
 ByteArray Utf8::convertFromUnicode(const Character *uc, int len)
 {
    // create a ByteArray with the worst case scenario size
@@ -156,11 +524,17 @@ ByteArray Utf8::convertFromUnicode(const Character *uc, int len)
    uchar *dst = reinterpret_cast<uchar *>(const_cast<char *>(result.getConstRawData()));
    const char16_t *src = reinterpret_cast<const char16_t *>(uc);
    const char16_t *const end = src + len;
+   const Utf8Transcoder &transcoder = utf8_transcoder();
    
    while (src != end) {
       const char16_t *nextAscii = end;
       if (simd_encode_ascii(dst, nextAscii, src, end))
          break;
+      const char16_t *encoded = transcoder.encode(dst, src, end);
+      if (encoded != src) {
+         src = encoded;
+         continue;
+      }
       
       do {
          char16_t uc = *src++;
@@ -205,6 +579,7 @@ ByteArray Utf8::convertFromUnicode(const Character *uc, int len, TextCodec::Conv
    }
    
    const char16_t *nextAscii = src;
+   const Utf8Transcoder &transcoder = utf8_transcoder();
    while (src != end) {
       int res;
       char16_t uc;
@@ -213,8 +588,15 @@ ByteArray Utf8::convertFromUnicode(const Character *uc, int len, TextCodec::Conv
          surrogate_high = -1;
          res = Utf8Functions::toUtf8<Utf8BaseTraits>(uc, cursor, src, end);
       } else {
-         if (src >= nextAscii && simd_encode_ascii(cursor, nextAscii, src, end))
-            break;
+         if (src >= nextAscii) {
+            if (simd_encode_ascii(cursor, nextAscii, src, end))
+               break;
+            const char16_t *encoded = transcoder.encode(cursor, src, end);
+            if (encoded != src) {
+               src = nextAscii = encoded;
+               continue;
+            }
+         }
          
          uc = *src++;
          res = Utf8Functions::toUtf8<Utf8BaseTraits>(uc, cursor, src, end);
@@ -297,11 +679,17 @@ Character *Utf8::convertToUnicode(Character *buffer, const char *chars, int len)
          src += 3;
       }
       
+      const Utf8Transcoder &transcoder = utf8_transcoder();
       while (src < end) {
          nextAscii = end;
          if (simd_decode_ascii(dst, nextAscii, src, end)) {
             break;
          }
+         const uchar *decoded = transcoder.decode(dst, src, end);
+         if (decoded != src) {
+            src = decoded;
+            continue;
+         }
          do {
             uchar b = *src++;
             int res = Utf8Functions::fromUtf8<Utf8BaseTraits>(b, dst, src, end);
@@ -388,9 +776,20 @@ String Utf8::convertToUnicode(const char *chars, int len, TextCodec::ConverterSt
    res = 0;
    const uchar *nextAscii = src;
    const uchar *start = src;
+   const Utf8Transcoder &transcoder = utf8_transcoder();
    while (res >= 0 && src < end) {
-      if (src >= nextAscii && simd_decode_ascii(dst, nextAscii, src, end))
-         break;
+      if (src >= nextAscii) {
+         if (simd_decode_ascii(dst, nextAscii, src, end))
+            break;
+         // the first character goes through the scalar code for the bom
+         if (headerdone) {
+            const uchar *decoded = transcoder.decode(dst, src, end);
+            if (decoded != src) {
+               src = nextAscii = decoded;
+               continue;
+            }
+         }
+      }
       
       ch = *src++;
       res = Utf8Functions::fromUtf8<Utf8BaseTraits>(ch, dst, src, end);
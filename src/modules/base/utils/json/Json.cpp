@@ -14,6 +14,8 @@
 // Created by softboy on 2018/03/05.
 
 #include "pdk/base/utils/json/internal/JsonPrivate.h"
+#include "pdk/base/utils/json/internal/JsonIndexPrivate.h"
+#include "pdk/base/io/fs/File.h"
 #include <algorithm>
 
 namespace pdk {
@@ -90,10 +92,35 @@ void Data::compact()
    }
    PDK_ASSERT(offset == (int)b->m_tableOffset);
    
-   free(m_header);
+   clearLookupIndex();
+   // raw and mapped data is not ours to free, from now on the copy is
+   if (m_ownsData) {
+      free(m_header);
+   } else if (m_mappedFile) {
+      releaseMappedFile();
+   }
    m_header = h;
    m_alloc = alloc;
    m_compactionCounter = 0;
+   m_ownsData = true;
+}
+
+void Data::releaseMappedFile()
+{
+   m_mappedFile->unmap(reinterpret_cast<uchar *>(m_rawData));
+   delete m_mappedFile;
+   m_mappedFile = nullptr;
+}
+
+void Data::enableLookupIndex(int minObjectSize)
+{
+   delete m_lookupIndex;
+   m_lookupIndex = minObjectSize > 0 ? new LookupIndex(minObjectSize) : nullptr;
+}
+
+void Data::clearLookupTables()
+{
+   m_lookupIndex->clear();
 }
 
 bool Data::valid() const
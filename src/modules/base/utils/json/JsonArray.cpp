@@ -330,8 +330,13 @@ bool JsonArray::detach(uint reserve)
       m_data->m_ref.ref();
       return true;
    }
-   if (reserve == 0 && m_data->m_ref.load() == 1)
-      return true;
+   if (m_data->m_ref.load() == 1) {
+      // the data is changed in place
+      m_data->clearLookupIndex();
+      if (reserve == 0) {
+         return true;
+      }
+   }
    
    jsonprivate::Data *x = m_data->clone(m_array, reserve);
    if (!x) {
@@ -17,11 +17,15 @@
 #include "pdk/base/utils/json/JsonObject.h"
 #include "pdk/base/utils/json/JsonValue.h"
 #include "pdk/base/utils/json/JsonArray.h"
+#include "pdk/base/utils/json/JsonPath.h"
 #include "pdk/base/utils/json/internal/JsonWriterPrivate.h"
 #include "pdk/base/utils/json/internal/JsonParserPrivate.h"
 #include "pdk/base/utils/json/internal/JsonPrivate.h"
 #include "pdk/base/ds/StringList.h"
 #include "pdk/base/io/Debug.h"
+#include "pdk/base/io/fs/File.h"
+
+#include <memory>
 
 namespace pdk {
 namespace utils {
@@ -30,6 +34,9 @@ namespace json {
 using pdk::io::Debug;
 using pdk::io::DebugStateSaver;
 using pdk::lang::String;
+using pdk::io::IoDevice;
+using pdk::io::fs::File;
+using pdk::io::fs::FileDevice;
 
 JsonDocument::JsonDocument()
    : m_data(nullptr)
@@ -98,6 +105,40 @@ JsonDocument JsonDocument::fromRawData(const char *data, int size, DataValidatio
    return JsonDocument(d);
 }
 
+JsonDocument JsonDocument::fromMappedFile(const String &fileName, DataValidation validation)
+{
+   std::unique_ptr<File> file(new File(fileName));
+   if (!file->open(IoDevice::OpenMode::ReadOnly)) {
+      return JsonDocument();
+   }
+   const pdk::pint64 fileSize = file->getSize();
+   if (fileSize < pdk::pint64(sizeof(jsonprivate::Header) + sizeof(jsonprivate::Base)) ||
+       fileSize > std::numeric_limits<int>::max()) {
+      return JsonDocument();
+   }
+   // a private mapping, changing the document later copies the touched
+   // pages instead of writing through to the file
+   uchar *data = file->map(0, fileSize, FileDevice::MemoryMapFlag::MapPrivateOption);
+   if (!data) {
+      return JsonDocument();
+   }
+   jsonprivate::Header *header = reinterpret_cast<jsonprivate::Header *>(data);
+   if (header->m_tag != JsonDocument::BinaryFormatTag || header->m_version != 1u ||
+       sizeof(jsonprivate::Header) + header->getRoot()->m_size > pdk::puint64(fileSize)) {
+      file->unmap(data);
+      return JsonDocument();
+   }
+   const int size = sizeof(jsonprivate::Header) + header->getRoot()->m_size;
+   jsonprivate::Data *d = new jsonprivate::Data(reinterpret_cast<char *>(data), size);
+   d->m_ownsData = false;
+   d->m_mappedFile = file.release();
+   if (validation != DataValidation::BypassValidation && !d->valid()) {
+      delete d;
+      return JsonDocument();
+   }
+   return JsonDocument(d);
+}
+
 const char *JsonDocument::getRawData(int *size) const
 {
    if (!m_data) {
@@ -317,6 +358,18 @@ const JsonValue JsonDocument::operator[](int i) const
    return getArray().at(i);
 }
 
+JsonValue JsonDocument::getValue(const JsonPath &path) const
+{
+   return path.evaluate(*this);
+}
+
+void JsonDocument::enableLookupIndex(int minObjectSize)
+{
+   if (m_data) {
+      m_data->enableLookupIndex(minObjectSize);
+   }
+}
+
 bool JsonDocument::operator==(const JsonDocument &other) const
 {
    if (m_data == other.m_data) {
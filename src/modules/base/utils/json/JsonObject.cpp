@@ -16,7 +16,9 @@
 #include "pdk/base/utils/json/JsonObject.h"
 #include "pdk/base/utils/json/JsonValue.h"
 #include "pdk/base/utils/json/JsonArray.h"
+#include "pdk/base/utils/json/JsonPath.h"
 #include "pdk/base/utils/json/internal/JsonPrivate.h"
+#include "pdk/base/utils/json/internal/JsonIndexPrivate.h"
 #include "pdk/base/utils/json/internal/JsonWriterPrivate.h"
 #include "pdk/base/ds/StringList.h"
 #include "pdk/base/io/Debug.h"
@@ -177,9 +179,8 @@ JsonValue JsonObject::getValue(const String &key) const
    if (!m_data) {
       return JsonValue(JsonValue::Type::Undefined);
    }
-   bool keyExists;
-   int i = m_object->indexOf(key, &keyExists);
-   if (!keyExists) {
+   int i = jsonprivate::index_of_key(m_data, m_object, key);
+   if (i < 0) {
       return JsonValue(JsonValue::Type::Undefined);
    }
    return JsonValue(m_data, m_object, m_object->entryAt(i)->m_value);
@@ -190,14 +191,25 @@ JsonValue JsonObject::getValue(Latin1String key) const
    if (!m_data) {
       return JsonValue(JsonValue::Type::Undefined);
    }      
-   bool keyExists;
-   int i = m_object->indexOf(key, &keyExists);
-   if (!keyExists) {
+   int i = jsonprivate::index_of_key(m_data, m_object, key);
+   if (i < 0) {
       return JsonValue(JsonValue::Type::Undefined);
    }
    return JsonValue(m_data, m_object, m_object->entryAt(i)->m_value);
 }
 
+JsonValue JsonObject::getValue(const JsonPath &path) const
+{
+   return path.evaluate(*this);
+}
+
+void JsonObject::enableLookupIndex(int minObjectSize)
+{
+   if (m_data) {
+      m_data->enableLookupIndex(minObjectSize);
+   }
+}
+
 JsonValue JsonObject::operator [](const String &key) const
 {
    return getValue(key);
@@ -308,9 +320,7 @@ bool JsonObject::contains(const String &key) const
    if (!m_object) {  
       return false;
    }
-   bool keyExists;
-   m_object->indexOf(key, &keyExists);
-   return keyExists;
+   return jsonprivate::index_of_key(m_data, m_object, key) >= 0;
 }
 
 bool JsonObject::contains(Latin1String key) const
@@ -318,9 +328,7 @@ bool JsonObject::contains(Latin1String key) const
    if (!m_object) {
       return false;
    }
-   bool keyExists;
-   m_object->indexOf(key, &keyExists);
-   return keyExists;
+   return jsonprivate::index_of_key(m_data, m_object, key) >= 0;
 }
 
 bool JsonObject::operator==(const JsonObject &other) const
@@ -422,8 +430,12 @@ bool JsonObject::detach(uint reserve)
       m_data->m_ref.ref();
       return true;
    }
-   if (reserve == 0 && m_data->m_ref.load() == 1) {
-      return true;
+   if (m_data->m_ref.load() == 1) {
+      // the data is changed in place
+      m_data->clearLookupIndex();
+      if (reserve == 0) {
+         return true;
+      }
    }
    jsonprivate::Data *x = m_data->clone(m_object, reserve);
    if (!x) {
@@ -20,6 +20,8 @@
 #include "pdk/base/text/codecs/internal/UtfCodecPrivate.h"
 #include "pdk/base/lang/Character.h"
 
+#include <cstring>
+
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
 static int indent = 0;
@@ -55,9 +57,6 @@ namespace pdk {
 namespace utils {
 namespace json {
 
-namespace codecsinternal = pdk::text::codecs::internal;
-namespace utf8funcs = codecsinternal::Utf8Functions;
-
 using pdk::lang::Character;
 using pdk::lang::String;
 using pdk::kernel::CoreApplication;
@@ -120,6 +119,7 @@ namespace jsonprivate {
 Parser::Parser(const char *json, int length)
    : m_head(json),
      m_json(json),
+     m_scanner(&json_scanner()),
      m_data(nullptr),
      m_dataLength(0),
      m_current(0),
@@ -181,16 +181,10 @@ void Parser::eatBOM()
 
 bool Parser::eatSpace()
 {
-   while (m_json < m_end) {
-      if (*m_json > Space) {
-         break;
-      }
-      if (*m_json != Space &&
-          *m_json != Tab &&
-          *m_json != LineFeed &&
-          *m_json != Return)
-         break;
-      ++m_json;
+   // most tokens follow each other directly, only real runs of whitespace
+   // (indentation of pretty printed documents) go to the block scanner
+   if (m_json < m_end && *m_json <= Space && is_json_whitespace(*m_json)) {
+      m_json = m_scanner->skipWhitespace(m_json + 1, m_end);
    }
    return (m_json < m_end);
 }
@@ -667,54 +661,22 @@ bool Parser::parseNumber(jsonprivate::LocalValue *val, int baseOffset)
    val->m_type = pdk::as_integer<JsonValue::Type>(JsonValue::Type::Double);
    const char *start = m_json;
    bool isInt = true;
-   // minus
-   if (m_json < m_end && *m_json == '-') {
-      ++m_json;
-   }
-   // int = zero / ( digit1-9 *DIGIT )
-   if (m_json < m_end && *m_json == '0') {
-      ++m_json;
-   } else {
-      while (m_json < m_end && *m_json >= '0' && *m_json <= '9') {
-         ++m_json;
-      }
-   }
-   // frac = decimal-point 1*DIGIT
-   if (m_json < m_end && *m_json == '.') {
-      isInt = false;
-      ++m_json;
-      while (m_json < m_end && *m_json >= '0' && *m_json <= '9') {
-         ++m_json;
-      }
-   }
-   // exp = e [ minus / plus ] 1*DIGIT
-   if (m_json < m_end && (*m_json == 'e' || *m_json == 'E')) {
-      isInt = false;
-      ++m_json;
-      if (m_json < m_end && (*m_json == '-' || *m_json == '+')) {
-         ++m_json;
-      }
-      while (m_json < m_end && *m_json >= '0' && *m_json <= '9') {
-         ++m_json;
-      }
-      
-   }
+   m_json = scan_number(m_json, m_end, &isInt);
    if (m_json >= m_end) {
       m_lastError = JsonParseError::ParseError::TerminationByNumber;
       return false;
    }
+   // short integers are converted in place, without the temporary
+   // byte array and its allocation
+   int n = 0;
+   if (isInt && parse_short_int(start, m_json, &n)) {
+      val->m_intValue = n;
+      val->m_latinOrIntValue = true;
+      END;
+      return true;
+   }
    ByteArray number(start, m_json - start);
    DEBUG << "numberstring" << number;
-   if (isInt) {
-      bool ok;
-      int n = number.toInt(&ok);
-      if (ok && n < (1<<25) && n > -(1<<25)) {
-         val->m_intValue = n;
-         val->m_latinOrIntValue = true;
-         END;
-         return true;
-      }
-   }
    bool ok;
    union {
       pdk::puint64 m_ui;
@@ -740,7 +702,6 @@ bool Parser::parseNumber(jsonprivate::LocalValue *val, int baseOffset)
    return true;
 }
 
-namespace {
 /*
   
         string = quotation-mark *char quotation-mark
@@ -763,83 +724,6 @@ namespace {
         
         unescaped = %x20-21 / %x23-5B / %x5D-10FFFF
  */
-inline bool add_hex_digit(char digit, uint *result)
-{
-   *result <<= 4;
-   if (digit >= '0' && digit <= '9') {
-      *result |= (digit - '0');
-   } else if (digit >= 'a' && digit <= 'f') {
-      *result |= (digit - 'a') + 10;
-   } else if (digit >= 'A' && digit <= 'F') {
-      *result |= (digit - 'A') + 10;
-   } else {
-      return false;
-   }
-   return true;
-}
-
-inline bool scan_escape_sequence(const char *&json, const char *end, uint *ch)
-{
-   ++json;
-   if (json >= end) {
-      return false;
-   }
-   DEBUG << "scan escape" << (char)*json;
-   uint escaped = *json++;
-   switch (escaped) {
-   case '"':
-      *ch = '"'; break;
-   case '\\':
-      *ch = '\\'; break;
-   case '/':
-      *ch = '/'; break;
-   case 'b':
-      *ch = 0x8; break;
-   case 'f':
-      *ch = 0xc; break;
-   case 'n':
-      *ch = 0xa; break;
-   case 'r':
-      *ch = 0xd; break;
-   case 't':
-      *ch = 0x9; break;
-   case 'u': {
-      *ch = 0;
-      if (json > end - 4)
-         return false;
-      for (int i = 0; i < 4; ++i) {
-         if (!add_hex_digit(*json, ch)) {
-            return false;
-         }
-         ++json;
-      }
-      return true;
-   }
-   default:
-      // this is not as strict as one could be, but allows for more Json files
-      // to be parsed correctly.
-      *ch = escaped;
-      return true;
-   }
-   return true;
-}
-
-inline bool scan_utf8_char(const char *&json, const char *end, uint *result)
-{
-   const uchar *&src = reinterpret_cast<const uchar *&>(json);
-   const uchar *uend = reinterpret_cast<const uchar *>(end);
-   uchar b = *src++;
-   int res = utf8funcs::fromUtf8<codecsinternal::Utf8BaseTraits>(b, result, src, uend);
-   if (res < 0) {
-      // decoding error, backtrack the character we read above
-      --json;
-      return false;
-   }   
-   return true;
-}
-
-} // anonymous namespace
-
 bool Parser::parseString(bool *latin1)
 {
    *latin1 = true;
@@ -852,7 +736,23 @@ bool Parser::parseString(bool *latin1)
       return false;
    }
    BEGIN << "parse string stringPos=" << stringPos << m_json;
+   // plain ascii runs are copied as they are, the run may not cross the
+   // latin1 length limit checked below
+   const char *latin1End = (m_end - start > 0x7fff) ? start + 0x7fff : m_end;
    while (m_json < m_end) {
+      const char *run = m_scanner->scanStringRun(m_json, latin1End);
+      if (run > m_json) {
+         const int length = int(run - m_json);
+         int pos = reserveSpace(length);
+         if (pos < 0) {
+            return false;
+         }
+         std::memcpy(m_data + pos, m_json, length);
+         m_json = run;
+         if (m_json >= m_end) {
+            break;
+         }
+      }
       uint ch = 0;
       if (*m_json == '"') {
          break;
@@ -904,6 +804,21 @@ bool Parser::parseString(bool *latin1)
    m_json = start;
    m_current = outStart + sizeof(int);
    while (m_json < m_end) {
+      const char *run = m_scanner->scanStringRun(m_json, m_end);
+      if (run > m_json) {
+         const int length = int(run - m_json);
+         int pos = reserveSpace(2 * length);
+         if (pos < 0) {
+            return false;
+         }
+         for (int i = 0; i < length; ++i) {
+            *(jsonprivate::ple_ushort *)(m_data + pos + 2 * i) = (ushort)(uchar)m_json[i];
+         }
+         m_json = run;
+         if (m_json >= m_end) {
+            break;
+         }
+      }
       uint ch = 0;
       if (*m_json == '"') {
          break;
@@ -0,0 +1,369 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/utils/json/JsonPath.h"
+#include "pdk/base/utils/json/JsonArray.h"
+#include "pdk/base/utils/json/JsonDocument.h"
+#include "pdk/base/utils/json/JsonObject.h"
+#include "pdk/base/utils/json/internal/JsonPrivate.h"
+#include "pdk/base/utils/json/internal/JsonIndexPrivate.h"
+#include <vector>
+
+namespace pdk {
+namespace utils {
+namespace json {
+namespace jsonprivate {
+
+using pdk::lang::Latin1Character;
+
+namespace {
+
+constexpr pdk::puint32 FNV_OFFSET_BASIS = 2166136261u;
+constexpr pdk::puint32 FNV_PRIME = 16777619u;
+
+// fnv-1a over utf-16 units, latin1 keys hash like their utf-16 form
+template <typename Unit>
+inline pdk::puint32 hash_units(const Unit *units, int length)
+{
+   pdk::puint32 hash = FNV_OFFSET_BASIS;
+   for (int i = 0; i < length; ++i) {
+      const ushort unit = units[i];
+      hash = (hash ^ (unit & 0xff)) * FNV_PRIME;
+      hash = (hash ^ (unit >> 8)) * FNV_PRIME;
+   }
+   return hash;
+}
+
+inline pdk::puint32 hash_key(const String &key)
+{
+   return hash_units(key.utf16(), key.length());
+}
+
+inline pdk::puint32 hash_key(Latin1String key)
+{
+   return hash_units(reinterpret_cast<const uchar *>(key.latin1()), key.size());
+}
+
+inline pdk::puint32 hash_key(const LocalEntry *entry)
+{
+   if (entry->m_value.m_latinKey) {
+      const LocalLatin1String key = entry->getShallowLatin1Key();
+      return hash_units(reinterpret_cast<const uchar *>(key.m_implPtr->m_latin1),
+                        key.m_implPtr->m_length);
+   }
+   const LocalString key = entry->getShallowKey();
+   return hash_units(key.m_implPtr->m_utf16, key.m_implPtr->m_length);
+}
+
+} // anonymous namespace
+
+const LookupIndex::Slots &LookupIndex::getSlots(const LocalObject *object)
+{
+   std::lock_guard<std::mutex> locker(m_mutex);
+   std::unique_ptr<Slots> &slots = m_tables[object];
+   if (slots) {
+      return *slots;
+   }
+   const int length = object->m_length;
+   size_t capacity = 16;
+   while (capacity < size_t(length) * 2) {
+      capacity <<= 1;
+   }
+   slots.reset(new Slots(capacity, 0));
+   const size_t mask = capacity - 1;
+   for (int i = 0; i < length; ++i) {
+      const pdk::puint32 hash = hash_key(object->entryAt(i));
+      size_t pos = hash & mask;
+      while ((*slots)[pos]) {
+         pos = (pos + 1) & mask;
+      }
+      (*slots)[pos] = (pdk::puint64(hash) << 32) | pdk::puint32(i + 1);
+   }
+   return *slots;
+}
+
+template <typename Key>
+int LookupIndex::find(const LocalObject *object, const Key &key)
+{
+   const Slots &slots = getSlots(object);
+   const pdk::puint32 hash = hash_key(key);
+   const size_t mask = slots.size() - 1;
+   for (size_t pos = hash & mask; slots[pos]; pos = (pos + 1) & mask) {
+      const pdk::puint64 slot = slots[pos];
+      if (pdk::puint32(slot >> 32) != hash) {
+         continue;
+      }
+      const int index = int(pdk::puint32(slot)) - 1;
+      if (*object->entryAt(index) == key) {
+         return index;
+      }
+   }
+   return -1;
+}
+
+int LookupIndex::indexOf(const LocalObject *object, const String &key)
+{
+   return find(object, key);
+}
+
+int LookupIndex::indexOf(const LocalObject *object, Latin1String key)
+{
+   return find(object, key);
+}
+
+void LookupIndex::clear()
+{
+   std::lock_guard<std::mutex> locker(m_mutex);
+   m_tables.clear();
+}
+
+class JsonPathPrivate : public SharedData
+{
+public:
+   struct Segment
+   {
+      Segment(const String &key, int index)
+         : m_key(key),
+           m_index(index),
+           m_hint(-1)
+      {}
+
+      Segment(const Segment &other)
+         : m_key(other.m_key),
+           m_index(other.m_index),
+           m_hint(other.m_hint.load())
+      {}
+
+      String m_key;
+      // -1 when the token can not be an array position
+      int m_index;
+      // entry position the key was found at last time
+      mutable AtomicInt m_hint;
+   };
+
+   JsonPathPrivate()
+      : m_valid(true)
+   {}
+
+   void parse(const String &path);
+   JsonValue evaluate(Data *data, Base *base) const;
+
+   String m_path;
+   std::vector<Segment> m_segments;
+   bool m_valid;
+};
+
+namespace {
+
+// array positions are decimal without leading zeros, "-" and anything
+// else never selects an element
+int array_index(const String &token)
+{
+   const int length = token.length();
+   if (length == 0 || length > 9 || (length > 1 && token.at(0) == Latin1Character('0'))) {
+      return -1;
+   }
+   int value = 0;
+   for (int i = 0; i < length; ++i) {
+      const ushort c = token.at(i).unicode();
+      if (c < '0' || c > '9') {
+         return -1;
+      }
+      value = value * 10 + (c - '0');
+   }
+   return value;
+}
+
+} // anonymous namespace
+
+void JsonPathPrivate::parse(const String &path)
+{
+   m_path = path;
+   m_segments.clear();
+   m_valid = true;
+   const int length = path.length();
+   if (length == 0) {
+      return;
+   }
+   if (path.at(0) != Latin1Character('/')) {
+      m_valid = false;
+      return;
+   }
+   String token;
+   for (int i = 1; i <= length; ++i) {
+      if (i == length || path.at(i) == Latin1Character('/')) {
+         m_segments.emplace_back(token, array_index(token));
+         token.clear();
+         continue;
+      }
+      const Character c = path.at(i);
+      if (c != Latin1Character('~')) {
+         token.append(c);
+         continue;
+      }
+      // ~0 is a tilde and ~1 a slash, any other escape is an error
+      const Character next = i + 1 < length ? path.at(i + 1) : Character();
+      if (next == Latin1Character('0')) {
+         token.append(Latin1Character('~'));
+      } else if (next == Latin1Character('1')) {
+         token.append(Latin1Character('/'));
+      } else {
+         m_segments.clear();
+         m_valid = false;
+         return;
+      }
+      ++i;
+   }
+}
+
+JsonValue JsonPathPrivate::evaluate(Data *data, Base *base) const
+{
+   const int count = int(m_segments.size());
+   for (int step = 0; step < count; ++step) {
+      const Segment &segment = m_segments[step];
+      LocalValue value;
+      if (base->isObject()) {
+         LocalObject *object = static_cast<LocalObject *>(base);
+         // documents of the same shape keep keys at the same positions
+         int index = segment.m_hint.load();
+         if (index < 0 || index >= int(object->m_length) || *object->entryAt(index) != segment.m_key) {
+            index = index_of_key(data, object, segment.m_key);
+            if (index < 0) {
+               return JsonValue(JsonValue::Type::Undefined);
+            }
+            segment.m_hint.store(index);
+         }
+         value = object->entryAt(index)->m_value;
+      } else {
+         if (segment.m_index < 0 || segment.m_index >= int(base->m_length)) {
+            return JsonValue(JsonValue::Type::Undefined);
+         }
+         value = static_cast<LocalArray *>(base)->at(segment.m_index);
+      }
+      if (step == count - 1) {
+         return JsonValue(data, base, value);
+      }
+      if (value.m_type != pdk::as_integer<JsonValue::Type>(JsonValue::Type::Object) &&
+          value.m_type != pdk::as_integer<JsonValue::Type>(JsonValue::Type::Array)) {
+         return JsonValue(JsonValue::Type::Undefined);
+      }
+      base = value.base(base);
+   }
+   // the empty path is answered by the callers
+   return JsonValue(JsonValue::Type::Undefined);
+}
+
+} // jsonprivate
+
+JsonPath::JsonPath()
+   : m_implPtr(new JsonPathPrivate)
+{}
+
+JsonPath::JsonPath(const String &path)
+   : m_implPtr(new JsonPathPrivate)
+{
+   m_implPtr->parse(path);
+}
+
+JsonPath::JsonPath(Latin1String path)
+   : m_implPtr(new JsonPathPrivate)
+{
+   m_implPtr->parse(String(path));
+}
+
+JsonPath::JsonPath(const JsonPath &other)
+   : m_implPtr(other.m_implPtr)
+{}
+
+JsonPath &JsonPath::operator=(const JsonPath &other)
+{
+   m_implPtr = other.m_implPtr;
+   return *this;
+}
+
+JsonPath::~JsonPath()
+{}
+
+bool JsonPath::isValid() const
+{
+   return m_implPtr->m_valid;
+}
+
+int JsonPath::getSize() const
+{
+   return int(m_implPtr->m_segments.size());
+}
+
+String JsonPath::toString() const
+{
+   return m_implPtr->m_path;
+}
+
+JsonValue JsonPath::evaluate(const JsonDocument &document) const
+{
+   if (!m_implPtr->m_valid || !document.m_data) {
+      return JsonValue(JsonValue::Type::Undefined);
+   }
+   if (m_implPtr->m_segments.empty()) {
+      return document.isArray() ? JsonValue(document.getArray()) : JsonValue(document.getObject());
+   }
+   return m_implPtr->evaluate(document.m_data, document.m_data->m_header->getRoot());
+}
+
+JsonValue JsonPath::evaluate(const JsonObject &object) const
+{
+   if (!m_implPtr->m_valid) {
+      return JsonValue(JsonValue::Type::Undefined);
+   }
+   if (m_implPtr->m_segments.empty()) {
+      return JsonValue(object);
+   }
+   if (!object.m_data) {
+      return JsonValue(JsonValue::Type::Undefined);
+   }
+   return m_implPtr->evaluate(object.m_data, object.m_object);
+}
+
+JsonValue JsonPath::evaluate(const JsonArray &array) const
+{
+   if (!m_implPtr->m_valid) {
+      return JsonValue(JsonValue::Type::Undefined);
+   }
+   if (m_implPtr->m_segments.empty()) {
+      return JsonValue(array);
+   }
+   if (!array.m_data) {
+      return JsonValue(JsonValue::Type::Undefined);
+   }
+   return m_implPtr->evaluate(array.m_data, array.m_array);
+}
+
+JsonValue JsonPath::evaluate(const JsonValue &value) const
+{
+   if (!m_implPtr->m_valid) {
+      return JsonValue(JsonValue::Type::Undefined);
+   }
+   if (m_implPtr->m_segments.empty()) {
+      return value;
+   }
+   if ((!value.isObject() && !value.isArray()) || !value.m_data || !value.m_base) {
+      return JsonValue(JsonValue::Type::Undefined);
+   }
+   return m_implPtr->evaluate(value.m_data, value.m_base);
+}
+
+} // json
+} // utils
+} // pdk
@@ -0,0 +1,551 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/utils/json/JsonReader.h"
+#include "pdk/base/utils/json/JsonArray.h"
+#include "pdk/base/utils/json/JsonObject.h"
+#include "pdk/base/utils/json/internal/JsonParserPrivate.h"
+#include "pdk/base/io/IoDevice.h"
+#include "pdk/base/lang/Character.h"
+
+#include <cstring>
+#include <vector>
+
+namespace pdk {
+namespace utils {
+namespace json {
+
+using pdk::lang::Character;
+
+namespace jsonprivate {
+
+namespace {
+
+// same limit as the document parser
+constexpr int JSON_READER_NESTING_LIMIT = 1024;
+
+inline bool is_number_char(char c)
+{
+   return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+} // anonymous namespace
+
+class JsonReaderPrivate
+{
+public:
+   using TokenType = JsonReader::TokenType;
+   using ParseError = JsonParseError::ParseError;
+
+   // what the grammar allows at the current position
+   enum class State
+   {
+      TopLevel,
+      Value,
+      ValueOrEnd,
+      Key,
+      KeyOrEnd,
+      SeparatorOrEnd
+   };
+
+   JsonReaderPrivate(IoDevice *device, int chunkSize)
+      : m_device(device),
+        m_scanner(&json_scanner()),
+        m_chunkSize(chunkSize > 0 ? chunkSize : JsonReader::DefaultChunkSize),
+        m_pos(0),
+        m_bufferOffset(0),
+        m_deviceAtEnd(false),
+        m_started(false),
+        m_state(State::TopLevel),
+        m_token(TokenType::NoToken),
+        m_error(ParseError::NoError),
+        m_errorOffset(-1)
+   {}
+
+   TokenType readNext();
+   bool fill();
+   bool ensure(int length);
+   bool skipWhitespace();
+   bool readString(String *result);
+   bool readNumber();
+   bool readLiteral(const char *literal, int length, const JsonValue &value);
+   TokenType readValue();
+   TokenType endContainer();
+   TokenType setError(ParseError error);
+
+   inline const char *getCurrent() const
+   {
+      return m_buffer.getConstRawData() + m_pos;
+   }
+
+   inline const char *getBufferEnd() const
+   {
+      return m_buffer.getConstRawData() + m_buffer.size();
+   }
+
+   inline void afterValue()
+   {
+      m_state = m_containers.empty() ? State::TopLevel : State::SeparatorOrEnd;
+   }
+
+   IoDevice *m_device;
+   const JsonScanner *m_scanner;
+   int m_chunkSize;
+   // unread input, m_pos indexes the next byte to look at
+   ByteArray m_buffer;
+   int m_pos;
+   // stream offset of the first byte in m_buffer
+   pdk::pint64 m_bufferOffset;
+   bool m_deviceAtEnd;
+   bool m_started;
+   // '{' and '[' of the open containers
+   std::vector<char> m_containers;
+   State m_state;
+   TokenType m_token;
+   String m_key;
+   JsonValue m_value;
+   ParseError m_error;
+   pdk::pint64 m_errorOffset;
+};
+
+// drops the consumed bytes and appends the next chunk, returns false once
+// the device has nothing more to give
+bool JsonReaderPrivate::fill()
+{
+   if (m_deviceAtEnd || !m_device) {
+      return false;
+   }
+   if (m_pos > 0) {
+      m_buffer.remove(0, m_pos);
+      m_bufferOffset += m_pos;
+      m_pos = 0;
+   }
+   const int oldSize = m_buffer.size();
+   m_buffer.resize(oldSize + m_chunkSize);
+   pdk::pint64 readBytes = m_device->read(m_buffer.getRawData() + oldSize, m_chunkSize);
+   // pipes and sockets may just not have the next chunk yet
+   while (readBytes == 0 && m_device->isSequential() && m_device->waitForReadyRead(-1)) {
+      readBytes = m_device->read(m_buffer.getRawData() + oldSize, m_chunkSize);
+   }
+   if (readBytes <= 0) {
+      m_buffer.resize(oldSize);
+      m_deviceAtEnd = true;
+      return false;
+   }
+   m_buffer.resize(oldSize + static_cast<int>(readBytes));
+   return true;
+}
+
+bool JsonReaderPrivate::ensure(int length)
+{
+   while (m_buffer.size() - m_pos < length) {
+      if (!fill()) {
+         return false;
+      }
+   }
+   return true;
+}
+
+bool JsonReaderPrivate::skipWhitespace()
+{
+   while (true) {
+      m_pos = static_cast<int>(m_scanner->skipWhitespace(getCurrent(), getBufferEnd()) - m_buffer.getConstRawData());
+      if (m_pos < m_buffer.size()) {
+         return true;
+      }
+      if (!fill()) {
+         return false;
+      }
+   }
+}
+
+JsonReader::TokenType JsonReaderPrivate::setError(ParseError error)
+{
+   m_error = error;
+   m_errorOffset = m_bufferOffset + m_pos;
+   m_token = TokenType::Invalid;
+   return m_token;
+}
+
+// expects the opening quote at m_pos, the whole string is buffered before
+// it is decoded, its position is tracked relative to m_pos because fill()
+// moves the buffer
+bool JsonReaderPrivate::readString(String *result)
+{
+   int scanned = 1;
+   while (true) {
+      const char *begin = getCurrent();
+      const char *end = getBufferEnd();
+      const char *json = begin + scanned;
+      while (json < end) {
+         json = m_scanner->scanStringRun(json, end);
+         if (json >= end || *json == '"') {
+            break;
+         }
+         // an escape is skipped as a whole, the escaped character may be a quote
+         json += (*json == '\\') ? 2 : 1;
+      }
+      scanned = static_cast<int>(json - begin);
+      if (json < end) {
+         break;
+      }
+      if (!fill()) {
+         setError(ParseError::UnterminatedString);
+         return false;
+      }
+   }
+   const char *json = getCurrent() + 1;
+   const char *end = getCurrent() + scanned;
+   result->clear();
+   result->reserve(scanned - 1);
+   while (json < end) {
+      const char *run = m_scanner->scanStringRun(json, end);
+      if (run > json) {
+         result->append(Latin1String(json, static_cast<int>(run - json)));
+         json = run;
+         continue;
+      }
+      uint ch = 0;
+      if (*json == '\\') {
+         if (!scan_escape_sequence(json, end, &ch)) {
+            m_pos = static_cast<int>(json - m_buffer.getConstRawData());
+            setError(ParseError::IllegalEscapeSequence);
+            return false;
+         }
+      } else if (!scan_utf8_char(json, end, &ch)) {
+         m_pos = static_cast<int>(json - m_buffer.getConstRawData());
+         setError(ParseError::IllegalUTF8String);
+         return false;
+      }
+      if (Character::requiresSurrogates(ch)) {
+         result->append(Character(static_cast<char16_t>(Character::getHighSurrogate(ch))));
+         result->append(Character(static_cast<char16_t>(Character::getLowSurrogate(ch))));
+      } else {
+         result->append(Character(static_cast<char16_t>(ch)));
+      }
+   }
+   m_pos += scanned + 1;
+   return true;
+}
+
+bool JsonReaderPrivate::readNumber()
+{
+   int length = 0;
+   while (true) {
+      const char *begin = getCurrent();
+      const char *end = getBufferEnd();
+      const char *json = begin + length;
+      while (json < end && is_number_char(*json)) {
+         ++json;
+      }
+      length = static_cast<int>(json - begin);
+      if (json < end || !fill()) {
+         break;
+      }
+   }
+   const char *begin = getCurrent();
+   const char *end = begin + length;
+   bool isInt = true;
+   if (scan_number(begin, end, &isInt) != end) {
+      setError(ParseError::IllegalNumber);
+      return false;
+   }
+   int shortInt = 0;
+   if (isInt && parse_short_int(begin, end, &shortInt)) {
+      m_value = JsonValue(shortInt);
+      m_pos += length;
+      return true;
+   }
+   const ByteArray number(begin, length);
+   bool ok = false;
+   const double value = number.toDouble(&ok);
+   if (!ok) {
+      setError(ParseError::IllegalNumber);
+      return false;
+   }
+   m_value = JsonValue(value);
+   m_pos += length;
+   return true;
+}
+
+bool JsonReaderPrivate::readLiteral(const char *literal, int length, const JsonValue &value)
+{
+   if (!ensure(length) || std::memcmp(getCurrent(), literal, length) != 0) {
+      setError(ParseError::IllegalValue);
+      return false;
+   }
+   m_pos += length;
+   m_value = value;
+   return true;
+}
+
+JsonReader::TokenType JsonReaderPrivate::readValue()
+{
+   const char c = *getCurrent();
+   switch (c) {
+   case '{':
+   case '[':
+      if (m_containers.size() >= JSON_READER_NESTING_LIMIT) {
+         return setError(ParseError::DeepNesting);
+      }
+      ++m_pos;
+      m_containers.push_back(c);
+      m_state = (c == '{') ? State::KeyOrEnd : State::ValueOrEnd;
+      m_token = (c == '{') ? TokenType::BeginObject : TokenType::BeginArray;
+      return m_token;
+   case '"': {
+      String value;
+      if (!readString(&value)) {
+         return m_token;
+      }
+      m_value = JsonValue(value);
+      break;
+   }
+   case 't':
+      if (!readLiteral("true", 4, JsonValue(true))) {
+         return m_token;
+      }
+      break;
+   case 'f':
+      if (!readLiteral("false", 5, JsonValue(false))) {
+         return m_token;
+      }
+      break;
+   case 'n':
+      if (!readLiteral("null", 4, JsonValue(JsonValue::Type::Null))) {
+         return m_token;
+      }
+      break;
+   default:
+      if (c != '-' && (c < '0' || c > '9')) {
+         return setError(ParseError::IllegalValue);
+      }
+      if (!readNumber()) {
+         return m_token;
+      }
+      break;
+   }
+   afterValue();
+   m_token = TokenType::Value;
+   return m_token;
+}
+
+JsonReader::TokenType JsonReaderPrivate::endContainer()
+{
+   ++m_pos;
+   m_token = (m_containers.back() == '{') ? TokenType::EndObject : TokenType::EndArray;
+   m_containers.pop_back();
+   afterValue();
+   return m_token;
+}
+
+JsonReader::TokenType JsonReaderPrivate::readNext()
+{
+   if (m_token == TokenType::Invalid || m_token == TokenType::EndOfInput) {
+      return m_token;
+   }
+   if (!m_started) {
+      m_started = true;
+      // eat UTF-8 byte order mark
+      if (ensure(3) && std::memcmp(getCurrent(), "\xef\xbb\xbf", 3) == 0) {
+         m_pos += 3;
+      }
+   }
+   while (true) {
+      if (!skipWhitespace()) {
+         if (m_containers.empty()) {
+            m_token = TokenType::EndOfInput;
+            return m_token;
+         }
+         return setError(m_containers.back() == '{' ? ParseError::UnterminatedObject
+                                                    : ParseError::UnterminatedArray);
+      }
+      const char c = *getCurrent();
+      const bool inObject = !m_containers.empty() && m_containers.back() == '{';
+      switch (m_state) {
+      case State::SeparatorOrEnd:
+         if (c == ',') {
+            ++m_pos;
+            m_state = inObject ? State::Key : State::Value;
+            continue;
+         }
+         if (c == (inObject ? '}' : ']')) {
+            return endContainer();
+         }
+         return setError(inObject ? ParseError::UnterminatedObject : ParseError::MissingValueSeparator);
+      case State::KeyOrEnd:
+      case State::Key:
+         if (c == '}' && m_state == State::KeyOrEnd) {
+            return endContainer();
+         }
+         if (c != '"') {
+            return setError(m_state == State::Key ? ParseError::MissingObject : ParseError::UnterminatedObject);
+         }
+         if (!readString(&m_key)) {
+            return m_token;
+         }
+         if (!skipWhitespace() || *getCurrent() != ':') {
+            return setError(ParseError::MissingNameSeparator);
+         }
+         ++m_pos;
+         m_state = State::Value;
+         m_token = TokenType::Key;
+         return m_token;
+      case State::ValueOrEnd:
+         if (c == ']') {
+            return endContainer();
+         }
+         return readValue();
+      case State::Value:
+      case State::TopLevel:
+         return readValue();
+      }
+   }
+}
+
+} // jsonprivate
+
+JsonReader::JsonReader(IoDevice *device, int chunkSize)
+   : m_implPtr(new JsonReaderPrivate(device, chunkSize))
+{}
+
+JsonReader::~JsonReader()
+{}
+
+JsonReader::TokenType JsonReader::readNext()
+{
+   PDK_D(JsonReader);
+   return implPtr->readNext();
+}
+
+JsonReader::TokenType JsonReader::getTokenType() const
+{
+   PDK_D(const JsonReader);
+   return implPtr->m_token;
+}
+
+String JsonReader::getKey() const
+{
+   PDK_D(const JsonReader);
+   return implPtr->m_key;
+}
+
+JsonValue JsonReader::getValue() const
+{
+   PDK_D(const JsonReader);
+   if (implPtr->m_token != TokenType::Value) {
+      return JsonValue(JsonValue::Type::Undefined);
+   }
+   return implPtr->m_value;
+}
+
+JsonValue JsonReader::readCurrentValue()
+{
+   PDK_D(JsonReader);
+   switch (implPtr->m_token) {
+   case TokenType::Value:
+      return implPtr->m_value;
+   case TokenType::BeginArray: {
+      JsonArray array;
+      while (true) {
+         const TokenType token = implPtr->readNext();
+         if (token == TokenType::EndArray) {
+            return array;
+         }
+         if (token == TokenType::Invalid) {
+            return JsonValue(JsonValue::Type::Undefined);
+         }
+         array.append(readCurrentValue());
+      }
+   }
+   case TokenType::BeginObject: {
+      JsonObject object;
+      while (true) {
+         const TokenType token = implPtr->readNext();
+         if (token == TokenType::EndObject) {
+            return object;
+         }
+         if (token != TokenType::Key) {
+            return JsonValue(JsonValue::Type::Undefined);
+         }
+         const String key = implPtr->m_key;
+         if (implPtr->readNext() == TokenType::Invalid) {
+            return JsonValue(JsonValue::Type::Undefined);
+         }
+         object.insert(key, readCurrentValue());
+      }
+   }
+   default:
+      return JsonValue(JsonValue::Type::Undefined);
+   }
+}
+
+bool JsonReader::skipCurrentContainer()
+{
+   PDK_D(JsonReader);
+   if (implPtr->m_token != TokenType::BeginObject && implPtr->m_token != TokenType::BeginArray) {
+      return false;
+   }
+   const size_t depth = implPtr->m_containers.size();
+   while (implPtr->m_containers.size() >= depth) {
+      if (implPtr->readNext() == TokenType::Invalid) {
+         return false;
+      }
+   }
+   return true;
+}
+
+int JsonReader::getDepth() const
+{
+   PDK_D(const JsonReader);
+   return static_cast<int>(implPtr->m_containers.size());
+}
+
+bool JsonReader::atEnd() const
+{
+   PDK_D(const JsonReader);
+   return implPtr->m_token == TokenType::EndOfInput || implPtr->m_token == TokenType::Invalid;
+}
+
+bool JsonReader::hasError() const
+{
+   PDK_D(const JsonReader);
+   return implPtr->m_error != JsonParseError::ParseError::NoError;
+}
+
+JsonParseError::ParseError JsonReader::getError() const
+{
+   PDK_D(const JsonReader);
+   return implPtr->m_error;
+}
+
+String JsonReader::getErrorString() const
+{
+   PDK_D(const JsonReader);
+   JsonParseError error;
+   error.m_offset = static_cast<int>(implPtr->m_errorOffset);
+   error.m_error = implPtr->m_error;
+   return error.getErrorString();
+}
+
+pdk::pint64 JsonReader::getErrorOffset() const
+{
+   PDK_D(const JsonReader);
+   return implPtr->m_errorOffset;
+}
+
+} // json
+} // utils
+} // pdk
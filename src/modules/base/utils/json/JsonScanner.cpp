@@ -0,0 +1,198 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/utils/json/internal/JsonScannerPrivate.h"
+#include "pdk/kernel/Algorithms.h"
+#include "pdk/pal/kernel/Simd.h"
+#include "pdk/utils/Funcs.h"
+
+namespace pdk {
+namespace utils {
+namespace json {
+namespace jsonprivate {
+
+namespace {
+
+inline bool is_string_run_end(char c)
+{
+   return c == '"' || c == '\\' || static_cast<uchar>(c) >= 0x80;
+}
+
+const char *skip_whitespace_scalar(const char *pos, const char *end)
+{
+   while (pos < end && is_json_whitespace(*pos)) {
+      ++pos;
+   }
+   return pos;
+}
+
+const char *scan_string_run_scalar(const char *pos, const char *end)
+{
+   while (pos < end && !is_string_run_end(*pos)) {
+      ++pos;
+   }
+   return pos;
+}
+
+#ifdef __SSE2__
+inline __m128i whitespace_mask_sse2(__m128i chunk)
+{
+   const __m128i space = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(0x20));
+   const __m128i tab = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(0x09));
+   const __m128i lineFeed = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(0x0a));
+   const __m128i cr = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(0x0d));
+   return _mm_or_si128(_mm_or_si128(space, tab), _mm_or_si128(lineFeed, cr));
+}
+
+const char *skip_whitespace_sse2(const char *pos, const char *end)
+{
+   while (end - pos >= 16) {
+      const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+      const uint other = ~_mm_movemask_epi8(whitespace_mask_sse2(chunk)) & 0xffff;
+      if (other) {
+         return pos + pdk::count_trailing_zero_bits(other);
+      }
+      pos += 16;
+   }
+   return skip_whitespace_scalar(pos, end);
+}
+
+const char *scan_string_run_sse2(const char *pos, const char *end)
+{
+   while (end - pos >= 16) {
+      const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pos));
+      const __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')),
+                                           _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\\')));
+      // the sign bit of each byte marks the non ascii ones
+      const uint stop = _mm_movemask_epi8(_mm_or_si128(special, chunk));
+      if (stop) {
+         return pos + pdk::count_trailing_zero_bits(stop);
+      }
+      pos += 16;
+   }
+   return scan_string_run_scalar(pos, end);
+}
+#endif
+
+#ifdef PDK_SIMD_DISPATCH_X86
+PDK_FUNCTION_TARGET(AVX2) const char *skip_whitespace_avx2(const char *pos, const char *end)
+{
+   while (end - pos >= 32) {
+      const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+      const __m256i space = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(0x20));
+      const __m256i tab = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(0x09));
+      const __m256i lineFeed = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(0x0a));
+      const __m256i cr = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(0x0d));
+      const __m256i whitespace = _mm256_or_si256(_mm256_or_si256(space, tab), _mm256_or_si256(lineFeed, cr));
+      const pdk::puint32 other = ~static_cast<pdk::puint32>(_mm256_movemask_epi8(whitespace));
+      if (other) {
+         return pos + pdk::count_trailing_zero_bits(other);
+      }
+      pos += 32;
+   }
+   return skip_whitespace_scalar(pos, end);
+}
+
+PDK_FUNCTION_TARGET(AVX2) const char *scan_string_run_avx2(const char *pos, const char *end)
+{
+   while (end - pos >= 32) {
+      const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+      const __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"')),
+                                              _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\\')));
+      const pdk::puint32 stop = static_cast<pdk::puint32>(_mm256_movemask_epi8(_mm256_or_si256(special, chunk)));
+      if (stop) {
+         return pos + pdk::count_trailing_zero_bits(stop);
+      }
+      pos += 32;
+   }
+   return scan_string_run_scalar(pos, end);
+}
+
+#endif
+
+#if defined(__ARM_NEON__)
+// neon has no movemask, narrowing every byte to a nibble gives a 64 bit
+// mask whose trailing zero count divided by four is the byte index
+inline pdk::puint64 nibble_mask_neon(uint8x16_t mask)
+{
+   const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(mask), 4);
+   return vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+}
+
+const char *skip_whitespace_neon(const char *pos, const char *end)
+{
+   while (end - pos >= 16) {
+      const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(pos));
+      const uint8x16_t whitespace = vorrq_u8(vorrq_u8(vceqq_u8(chunk, vdupq_n_u8(0x20)),
+                                                      vceqq_u8(chunk, vdupq_n_u8(0x09))),
+                                             vorrq_u8(vceqq_u8(chunk, vdupq_n_u8(0x0a)),
+                                                      vceqq_u8(chunk, vdupq_n_u8(0x0d))));
+      const pdk::puint64 other = nibble_mask_neon(vmvnq_u8(whitespace));
+      if (other) {
+         return pos + pdk::count_trailing_zero_bits(other) / 4;
+      }
+      pos += 16;
+   }
+   return skip_whitespace_scalar(pos, end);
+}
+
+const char *scan_string_run_neon(const char *pos, const char *end)
+{
+   while (end - pos >= 16) {
+      const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t *>(pos));
+      const uint8x16_t stop = vorrq_u8(vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('"')),
+                                                vceqq_u8(chunk, vdupq_n_u8('\\'))),
+                                       vcgeq_u8(chunk, vdupq_n_u8(0x80)));
+      const pdk::puint64 mask = nibble_mask_neon(stop);
+      if (mask) {
+         return pos + pdk::count_trailing_zero_bits(mask) / 4;
+      }
+      pos += 16;
+   }
+   return scan_string_run_scalar(pos, end);
+}
+#endif
+
+JsonScanner select_json_scanner()
+{
+   bool ok = false;
+   const int noSimd = pdk::env_var_intval("PDK_JSON_NO_SIMD", &ok);
+   if (!ok || noSimd <= 0) {
+#ifdef PDK_SIMD_DISPATCH_X86
+      if (CPU_HAS_FEATURE(AVX2)) {
+         return JsonScanner{skip_whitespace_avx2, scan_string_run_avx2, "avx2"};
+      }
+#endif
+#ifdef __SSE2__
+      return JsonScanner{skip_whitespace_sse2, scan_string_run_sse2, "sse2"};
+#elif defined(__ARM_NEON__)
+      return JsonScanner{skip_whitespace_neon, scan_string_run_neon, "neon"};
+#endif
+   }
+   return JsonScanner{skip_whitespace_scalar, scan_string_run_scalar, "scalar"};
+}
+
+} // anonymous namespace
+
+const JsonScanner &json_scanner()
+{
+   static const JsonScanner scanner = select_json_scanner();
+   return scanner;
+}
+
+} // jsonprivate
+} // json
+} // utils
+} // pdk
@@ -0,0 +1,340 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/base/utils/json/JsonStreamWriter.h"
+#include "pdk/base/utils/json/JsonArray.h"
+#include "pdk/base/utils/json/JsonObject.h"
+#include "pdk/base/utils/json/internal/JsonWriterPrivate.h"
+#include "pdk/base/io/IoDevice.h"
+
+#include <vector>
+
+namespace pdk {
+namespace utils {
+namespace json {
+namespace jsonprivate {
+
+class JsonStreamWriterPrivate
+{
+public:
+   struct Level
+   {
+      bool m_object;
+      int m_count;
+   };
+
+   JsonStreamWriterPrivate(IoDevice *device, bool compact, int bufferSize)
+      : m_device(device),
+        m_compact(compact),
+        m_bufferSize(bufferSize > 0 ? bufferSize : JsonStreamWriter::DefaultBufferSize),
+        m_topLevelCount(0),
+        m_afterKey(false),
+        m_error(false)
+   {
+      // reserved, so emptying it on flush keeps the allocation
+      m_buffer.reserve(m_bufferSize + 64);
+   }
+
+   void beginElement();
+   void beginValue();
+   void endValue();
+   void beginContainer(bool object);
+   void endContainer(bool object);
+   void writeKey(const String &key);
+   void writeValue(const JsonValue &value);
+   bool flush();
+
+   inline void appendIndent(size_t depth)
+   {
+      for (size_t i = 0; i < depth; ++i) {
+         m_buffer += "    ";
+      }
+   }
+
+   IoDevice *m_device;
+   bool m_compact;
+   int m_bufferSize;
+   int m_topLevelCount;
+   // the value written next belongs to the key just written
+   bool m_afterKey;
+   bool m_error;
+   ByteArray m_buffer;
+   std::vector<Level> m_levels;
+};
+
+// separator and indentation in front of an array value or an object key
+void JsonStreamWriterPrivate::beginElement()
+{
+   if (m_levels.empty()) {
+      // several top level values become json lines
+      if (m_topLevelCount++ > 0 && m_compact) {
+         m_buffer += '\n';
+      }
+      return;
+   }
+   Level &level = m_levels.back();
+   if (level.m_count++ > 0) {
+      m_buffer += m_compact ? "," : ",\n";
+   }
+   if (!m_compact) {
+      appendIndent(m_levels.size());
+   }
+}
+
+void JsonStreamWriterPrivate::beginValue()
+{
+   if (m_afterKey) {
+      m_afterKey = false;
+      return;
+   }
+   PDK_ASSERT_X(m_levels.empty() || !m_levels.back().m_object, "JsonStreamWriter",
+                "a value inside an object needs a key");
+   beginElement();
+}
+
+void JsonStreamWriterPrivate::endValue()
+{
+   if (m_buffer.size() >= m_bufferSize) {
+      flush();
+   }
+}
+
+void JsonStreamWriterPrivate::beginContainer(bool object)
+{
+   beginValue();
+   m_buffer += object ? '{' : '[';
+   if (!m_compact) {
+      m_buffer += '\n';
+   }
+   m_levels.push_back({object, 0});
+}
+
+void JsonStreamWriterPrivate::endContainer(bool object)
+{
+   PDK_ASSERT_X(!m_levels.empty() && m_levels.back().m_object == object && !m_afterKey, "JsonStreamWriter",
+                object ? "endObject() does not close an object" : "endArray() does not close an array");
+   if (m_levels.empty()) {
+      return;
+   }
+   const Level level = m_levels.back();
+   m_levels.pop_back();
+   if (!m_compact) {
+      if (level.m_count > 0) {
+         m_buffer += '\n';
+      }
+      appendIndent(m_levels.size());
+   }
+   m_buffer += object ? '}' : ']';
+   if (m_levels.empty() && !m_compact) {
+      m_buffer += '\n';
+   }
+   endValue();
+}
+
+void JsonStreamWriterPrivate::writeKey(const String &key)
+{
+   PDK_ASSERT_X(!m_levels.empty() && m_levels.back().m_object && !m_afterKey, "JsonStreamWriter::writeKey",
+                "keys are only written inside objects, once per value");
+   beginElement();
+   m_buffer += '"';
+   escape_string(key, m_buffer);
+   m_buffer += m_compact ? "\":" : "\": ";
+   m_afterKey = true;
+}
+
+void JsonStreamWriterPrivate::writeValue(const JsonValue &value)
+{
+   switch (value.getType()) {
+   case JsonValue::Type::Array: {
+      const JsonArray array = value.toArray();
+      beginContainer(false);
+      for (int i = 0, size = array.getSize(); i < size; ++i) {
+         writeValue(array.at(i));
+      }
+      endContainer(false);
+      return;
+   }
+   case JsonValue::Type::Object: {
+      const JsonObject object = value.toObject();
+      beginContainer(true);
+      for (JsonObject::const_iterator iter = object.begin(); iter != object.end(); ++iter) {
+         writeKey(iter.getKey());
+         writeValue(iter.getValue());
+      }
+      endContainer(true);
+      return;
+   }
+   default:
+      break;
+   }
+   beginValue();
+   switch (value.getType()) {
+   case JsonValue::Type::Bool:
+      m_buffer += value.toBool() ? "true" : "false";
+      break;
+   case JsonValue::Type::Double:
+      double_to_json(value.toDouble(), m_buffer);
+      break;
+   case JsonValue::Type::String:
+      m_buffer += '"';
+      escape_string(value.toString(), m_buffer);
+      m_buffer += '"';
+      break;
+   default:
+      m_buffer += "null";
+   }
+   endValue();
+}
+
+bool JsonStreamWriterPrivate::flush()
+{
+   if (m_error || m_buffer.isEmpty()) {
+      m_buffer.resize(0);
+      return !m_error;
+   }
+   if (!m_device || m_device->write(m_buffer) != m_buffer.size()) {
+      m_error = true;
+   }
+   m_buffer.resize(0);
+   return !m_error;
+}
+
+} // jsonprivate
+
+JsonStreamWriter::JsonStreamWriter(IoDevice *device, JsonDocument::JsonFormat format, int bufferSize)
+   : m_implPtr(new JsonStreamWriterPrivate(device, format == JsonDocument::JsonFormat::Compact, bufferSize))
+{}
+
+JsonStreamWriter::~JsonStreamWriter()
+{
+   PDK_D(JsonStreamWriter);
+   implPtr->flush();
+}
+
+void JsonStreamWriter::beginObject()
+{
+   PDK_D(JsonStreamWriter);
+   implPtr->beginContainer(true);
+}
+
+void JsonStreamWriter::endObject()
+{
+   PDK_D(JsonStreamWriter);
+   implPtr->endContainer(true);
+}
+
+void JsonStreamWriter::beginArray()
+{
+   PDK_D(JsonStreamWriter);
+   implPtr->beginContainer(false);
+}
+
+void JsonStreamWriter::endArray()
+{
+   PDK_D(JsonStreamWriter);
+   implPtr->endContainer(false);
+}
+
+void JsonStreamWriter::writeKey(const String &key)
+{
+   PDK_D(JsonStreamWriter);
+   implPtr->writeKey(key);
+}
+
+void JsonStreamWriter::writeKey(Latin1String key)
+{
+   PDK_D(JsonStreamWriter);
+   implPtr->writeKey(String(key));
+}
+
+void JsonStreamWriter::writeValue(const JsonValue &value)
+{
+   PDK_D(JsonStreamWriter);
+   implPtr->writeValue(value);
+}
+
+void JsonStreamWriter::writeString(const String &value)
+{
+   PDK_D(JsonStreamWriter);
+   implPtr->beginValue();
+   implPtr->m_buffer += '"';
+   jsonprivate::escape_string(value, implPtr->m_buffer);
+   implPtr->m_buffer += '"';
+   implPtr->endValue();
+}
+
+void JsonStreamWriter::writeString(Latin1String value)
+{
+   writeString(String(value));
+}
+
+void JsonStreamWriter::writeNumber(double value)
+{
+   PDK_D(JsonStreamWriter);
+   implPtr->beginValue();
+   jsonprivate::double_to_json(value, implPtr->m_buffer);
+   implPtr->endValue();
+}
+
+void JsonStreamWriter::writeNumber(int value)
+{
+   writeNumber(static_cast<pdk::pint64>(value));
+}
+
+void JsonStreamWriter::writeNumber(pdk::pint64 value)
+{
+   PDK_D(JsonStreamWriter);
+   implPtr->beginValue();
+   implPtr->m_buffer += ByteArray::number(static_cast<pdk::plonglong>(value));
+   implPtr->endValue();
+}
+
+void JsonStreamWriter::writeBool(bool value)
+{
+   PDK_D(JsonStreamWriter);
+   implPtr->beginValue();
+   implPtr->m_buffer += value ? "true" : "false";
+   implPtr->endValue();
+}
+
+void JsonStreamWriter::writeNull()
+{
+   PDK_D(JsonStreamWriter);
+   implPtr->beginValue();
+   implPtr->m_buffer += "null";
+   implPtr->endValue();
+}
+
+bool JsonStreamWriter::flush()
+{
+   PDK_D(JsonStreamWriter);
+   return implPtr->flush();
+}
+
+int JsonStreamWriter::getDepth() const
+{
+   PDK_D(const JsonStreamWriter);
+   return static_cast<int>(implPtr->m_levels.size());
+}
+
+bool JsonStreamWriter::hasError() const
+{
+   PDK_D(const JsonStreamWriter);
+   return implPtr->m_error;
+}
+
+} // json
+} // utils
+} // pdk
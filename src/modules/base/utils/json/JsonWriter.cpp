@@ -38,19 +38,24 @@ static inline uchar hexdig(uint u)
    return (u < 0xa ? '0' + u : 'a' + u - 0xa);
 }
 
-ByteArray escaped_string(const String &s)
+} // anonymous namespace
+
+void escape_string(const String &s, ByteArray &ba)
 {
    const uchar replacement = '?';
-   ByteArray ba(s.length(), pdk::Uninitialized);
-   uchar *cursor = reinterpret_cast<uchar *>(const_cast<char *>(ba.getConstRawData()));
-   const uchar *baEnd = cursor + ba.length();
+   // escape straight into the tail of the output
+   const int start = ba.size();
+   ba.resize(start + s.length() + 7);
+   uchar *cursor = reinterpret_cast<uchar *>(ba.getRawData()) + start;
+   const uchar *baEnd = reinterpret_cast<const uchar *>(ba.getConstRawData()) + ba.length();
    const char16_t *src = reinterpret_cast<const char16_t *>(s.constBegin());
    const char16_t *const end = reinterpret_cast<const char16_t *>(s.constEnd());
    while (src != end) {
       if (cursor >= baEnd - 6) {
          // ensure we have enough space
          int pos = cursor - (const uchar *)ba.getConstRawData();
-         ba.resize(ba.size() * 2);
+         // grow with the rest of the string, not the whole output
+         ba.resize(ba.size() + 2 * static_cast<int>(end - src) + 7);
          cursor = (uchar *)ba.getRawData() + pos;
          baEnd = (const uchar *)ba.getConstRawData() + ba.length();
       }
@@ -97,9 +102,20 @@ ByteArray escaped_string(const String &s)
       }
    }
    ba.resize(cursor - (const uchar *)ba.getConstRawData());
-   return ba;
 }
 
+void double_to_json(double d, ByteArray &json)
+{
+   if (std::isfinite(d)) { // +2 to format to ensure the expected precision
+      const double abs = std::abs(d);
+      json += ByteArray::number(d, abs == static_cast<pdk::puint64>(abs) ? 'f' : 'g', Locale::FloatingPointShortest);
+   } else {
+      json += "null"; // +INF || -INF || NaN (see RFC4627#section2.4)
+   }
+}
+
+namespace {
+
 void value_to_json(const jsonprivate::Base *base, const jsonprivate::LocalValue &value, ByteArray &json, int indent, bool compact)
 {
    JsonValue::Type type = (JsonValue::Type)(uint)value.m_type;
@@ -107,19 +123,12 @@ void value_to_json(const jsonprivate::Base *base, const jsonprivate::LocalValue
    case JsonValue::Type::Bool:
       json += value.toBoolean() ? "true" : "false";
       break;
-   case JsonValue::Type::Double: {
-      const double d = value.toDouble(base);
-      if (std::isfinite(d)) { // +2 to format to ensure the expected precision
-         const double abs = std::abs(d);
-         json += ByteArray::number(d, abs == static_cast<pdk::puint64>(abs) ? 'f' : 'g', Locale::FloatingPointShortest);
-      } else {
-         json += "null"; // +INF || -INF || NaN (see RFC4627#section2.4)
-      }
+   case JsonValue::Type::Double:
+      double_to_json(value.toDouble(base), json);
       break;
-   }
    case JsonValue::Type::String:
       json += '"';
-      json += escaped_string(value.toString(base));
+      escape_string(value.toString(base), json);
       json += '"';
       break;
    case JsonValue::Type::Array:
@@ -171,7 +180,7 @@ void object_content_to_json(const jsonprivate::LocalObject *object, ByteArray &j
       jsonprivate::LocalEntry *e = object->entryAt(i);
       json += indentString;
       json += '"';
-      json += escaped_string(e->getKey());
+      escape_string(e->getKey(), json);
       json += compact ? "\":" : "\": ";
       value_to_json(object, e->m_value, json, indent, compact);
       if (++i == object->m_length) {
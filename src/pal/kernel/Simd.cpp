@@ -14,13 +14,235 @@
 // Created by softboy on 2018/02/24.
 
 #include "pdk/pal/kernel/Simd.h"
+#include "pdk/base/io/Debug.h"
+#include <cstdlib>
+#include <cstring>
+
+#if defined(PDK_PROCESSOR_X86) && !defined(PDK_CC_MSVC)
+#  include <cpuid.h>
+#endif
+
+#if defined(PDK_PROCESSOR_ARM) && defined(PDK_OS_LINUX)
+#  include <sys/auxv.h>
+#endif
 
 namespace pdk {
 namespace pal {
 namespace kernel {
 
+#ifdef PDK_ATOMIC_INT64_IS_SUPPORTED
+pdk::os::thread::BasicAtomicInteger<puint64> pdk_cpu_features[1] = { PDK_BASIC_ATOMIC_INITIALIZER(0) };
+#else
+pdk::os::thread::BasicAtomicInteger<unsigned int> pdk_cpu_features[2] = {
+   PDK_BASIC_ATOMIC_INITIALIZER(0), PDK_BASIC_ATOMIC_INITIALIZER(0)
+};
+#endif
+
+namespace {
+
+struct CpuFeatureName
+{
+   int feature;
+   const char *name;
+};
+
+const CpuFeatureName CPU_FEATURE_NAMES[] = {
+#if defined(PDK_PROCESSOR_ARM)
+   {CPUFeaturesNEON, "neon"},
+   {CPUFeaturesCRC32, "crc32"},
+#elif defined(PDK_PROCESSOR_MIPS)
+   {CPUFeaturesDSP, "dsp"},
+   {CPUFeaturesDSPR2, "dspr2"},
+#elif defined(PDK_PROCESSOR_X86)
+   {CPUFeaturesSSE2, "sse2"},
+   {CPUFeaturesSSE3, "sse3"},
+   {CPUFeaturesSSSE3, "ssse3"},
+   {CPUFeaturesSSE4_1, "sse4.1"},
+   {CPUFeaturesSSE4_2, "sse4.2"},
+   {CPUFeaturesMOVBE, "movbe"},
+   {CPUFeaturesPOPCNT, "popcnt"},
+   {CPUFeaturesAES, "aes"},
+   {CPUFeaturesAVX, "avx"},
+   {CPUFeaturesF16C, "f16c"},
+   {CPUFeaturesRDRAND, "rdrand"},
+   {CPUFeaturesBMI, "bmi"},
+   {CPUFeaturesHLE, "hle"},
+   {CPUFeaturesAVX2, "avx2"},
+   {CPUFeaturesBMI2, "bmi2"},
+   {CPUFeaturesRTM, "rtm"},
+   {CPUFeaturesAVX512F, "avx512f"},
+   {CPUFeaturesAVX512DQ, "avx512dq"},
+   {CPUFeaturesRDSEED, "rdseed"},
+   {CPUFeaturesAVX512IFMA, "avx512ifma"},
+   {CPUFeaturesAVX512PF, "avx512pf"},
+   {CPUFeaturesAVX512ER, "avx512er"},
+   {CPUFeaturesAVX512CD, "avx512cd"},
+   {CPUFeaturesSHA, "sha"},
+   {CPUFeaturesAVX512BW, "avx512bw"},
+   {CPUFeaturesAVX512VL, "avx512vl"},
+   {CPUFeaturesAVX512VBMI, "avx512vbmi"},
+#endif
+   {-1, nullptr}
+};
+
+inline puint64 feature_bit(int feature)
+{
+   return PDK_UINT64_C(1) << feature;
+}
+
+puint64 known_features()
+{
+   puint64 known = 0;
+   for (const CpuFeatureName *entry = CPU_FEATURE_NAMES; entry->name; ++entry) {
+      known |= feature_bit(entry->feature);
+   }
+   return known;
+}
+
+#if defined(PDK_PROCESSOR_X86)
+void cpuid(uint leaf, uint subleaf, uint registers[4])
+{
+#  ifdef PDK_CC_MSVC
+   int info[4];
+   __cpuidex(info, int(leaf), int(subleaf));
+   for (int i = 0; i < 4; ++i) {
+      registers[i] = uint(info[i]);
+   }
+#  else
+   __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#  endif
+}
+
+puint64 xgetbv0()
+{
+#  ifdef PDK_CC_MSVC
+   return _xgetbv(0);
+#  else
+   uint eax;
+   uint edx;
+   // xgetbv, spelled out for assemblers that do not know it
+   asm(".byte 0x0f, 0x01, 0xd0" : "=a" (eax), "=d" (edx) : "c" (0));
+   return (puint64(edx) << 32) | eax;
+#  endif
+}
+
+puint64 detect_processor_features()
+{
+   uint registers[4];
+   cpuid(0, 0, registers);
+   const uint maxLeaf = registers[0];
+   if (maxLeaf < 1) {
+      return 0;
+   }
+   cpuid(1, 0, registers);
+   // leaf 1 ecx lines up with the feature numbers, sse2 and avx512vbmi sit
+   // on bits the enum borrows
+   puint64 features = registers[2] & ~(feature_bit(CPUFeaturesSSE2) | feature_bit(CPUFeaturesAVX512VBMI));
+   if (registers[3] & (1u << 26)) {
+      features |= feature_bit(CPUFeaturesSSE2);
+   }
+   const bool osxsave = registers[2] & (1u << 27);
+   if (maxLeaf >= 7) {
+      cpuid(7, 0, registers);
+      features |= puint64(registers[1]) << 32;
+      if (registers[2] & (1u << 1)) {
+         features |= feature_bit(CPUFeaturesAVX512VBMI);
+      }
+   }
+   // the avx units are only usable when the os saves their registers
+   const puint64 avx512 = feature_bit(CPUFeaturesAVX512F) | feature_bit(CPUFeaturesAVX512DQ)
+         | feature_bit(CPUFeaturesAVX512IFMA) | feature_bit(CPUFeaturesAVX512PF)
+         | feature_bit(CPUFeaturesAVX512ER) | feature_bit(CPUFeaturesAVX512CD)
+         | feature_bit(CPUFeaturesAVX512BW) | feature_bit(CPUFeaturesAVX512VL)
+         | feature_bit(CPUFeaturesAVX512VBMI);
+   const puint64 xcr0 = osxsave ? xgetbv0() : 0;
+   if ((xcr0 & 0x6) != 0x6) {
+      features &= ~(feature_bit(CPUFeaturesAVX) | feature_bit(CPUFeaturesAVX2)
+                    | feature_bit(CPUFeaturesF16C) | avx512);
+   }
+   if ((xcr0 & 0xe6) != 0xe6) {
+      features &= ~avx512;
+   }
+   return features;
+}
+#elif defined(PDK_PROCESSOR_ARM) && defined(PDK_OS_LINUX)
+puint64 detect_processor_features()
+{
+   puint64 features = 0;
+   const unsigned long hwcap = getauxval(AT_HWCAP);
+#  if defined(PDK_PROCESSOR_ARM_64)
+   // HWCAP_ASIMD and HWCAP_CRC32
+   if (hwcap & (1ul << 1)) {
+      features |= feature_bit(CPUFeaturesNEON);
+   }
+   if (hwcap & (1ul << 7)) {
+      features |= feature_bit(CPUFeaturesCRC32);
+   }
+#  else
+   // HWCAP_NEON and HWCAP2_CRC32
+   if (hwcap & (1ul << 12)) {
+      features |= feature_bit(CPUFeaturesNEON);
+   }
+   if (getauxval(AT_HWCAP2) & (1ul << 4)) {
+      features |= feature_bit(CPUFeaturesCRC32);
+   }
+#  endif
+   return features;
+}
+#else
+puint64 detect_processor_features()
+{
+   return 0;
+}
+#endif
+
+// PDK_NO_CPU_FEATURE holds feature names separated by spaces or commas
+puint64 disabled_features()
+{
+   const char *names = std::getenv("PDK_NO_CPU_FEATURE");
+   if (!names) {
+      return 0;
+   }
+   puint64 disabled = 0;
+   while (*names) {
+      const size_t length = std::strcspn(names, " ,");
+      for (const CpuFeatureName *entry = CPU_FEATURE_NAMES; entry->name; ++entry) {
+         if (std::strlen(entry->name) == length && !std::strncmp(entry->name, names, length)) {
+            disabled |= feature_bit(entry->feature);
+         }
+      }
+      names += length;
+      names += std::strspn(names, " ,");
+   }
+   return disabled;
+}
+
+} // anonymous namespace
+
+void detect_cpu_features()
+{
+   // what the compiler already relies on can not be switched off
+   puint64 features = (detect_processor_features() & known_features() & ~disabled_features())
+         | COMPILER_CPU_FEATURE;
+   // racing threads store the same value
+   features |= puint64(CPUFeaturesSimdInitialized);
+#ifdef PDK_ATOMIC_INT64_IS_SUPPORTED
+   pdk_cpu_features[0].store(features);
+#else
+   pdk_cpu_features[1].store(uint(features >> 32));
+   pdk_cpu_features[0].store(uint(features));
+#endif
+}
+
 void dump_cpu_features()
 {
+   const puint64 features = cpu_features();
+   debug_stream() << "Processor features:";
+   for (const CpuFeatureName *entry = CPU_FEATURE_NAMES; entry->name; ++entry) {
+      if (features & feature_bit(entry->feature)) {
+         debug_stream() << "  " << entry->name;
+      }
+   }
 }
 
 } // kernel
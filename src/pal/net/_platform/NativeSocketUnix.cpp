@@ -0,0 +1,275 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "pdk/pal/net/NativeSocket.h"
+#include "pdk/kernel/internal/CoreUnixPrivate.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+namespace pdk {
+namespace pal {
+namespace net {
+
+namespace {
+
+bool is_transient_error(int error)
+{
+   return error == EAGAIN || error == EWOULDBLOCK;
+}
+
+} // anonymous
+
+int create_socket(int family, int type)
+{
+   int fd;
+#if defined(SOCK_NONBLOCK) && defined(SOCK_CLOEXEC)
+   fd = ::socket(family, type | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+   // kernels older than 2.6.27 reject the flags
+   if (fd != -1 || errno != EINVAL) {
+      return fd;
+   }
+#endif
+   fd = ::socket(family, type, 0);
+   if (fd != -1) {
+      set_nonblocking(fd);
+   }
+   return fd;
+}
+
+int close_socket(int fd)
+{
+   return pdk::kernel::safe_close(fd);
+}
+
+bool set_nonblocking(int fd)
+{
+   const int flags = ::fcntl(fd, F_GETFL);
+   if (flags == -1) {
+      return false;
+   }
+   ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+   return ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) != -1;
+}
+
+int bind_socket(int fd, const sockaddr *address, socklen_t length)
+{
+   return ::bind(fd, address, length);
+}
+
+int listen_socket(int fd, int backlog)
+{
+   return ::listen(fd, backlog);
+}
+
+int connect_socket(int fd, const sockaddr *address, socklen_t length)
+{
+   int ret = ::connect(fd, address, length);
+   // an interrupted connect keeps going in the background, calling it
+   // again would only report EALREADY
+   if (ret == -1 && errno == EINTR) {
+      errno = EINPROGRESS;
+   }
+   return ret;
+}
+
+pdk::pint64 read_socket(int fd, char *data, pdk::pint64 maxLength)
+{
+   return pdk::kernel::safe_read(fd, data, maxLength);
+}
+
+pdk::pint64 bytes_available(int fd)
+{
+   int available = 0;
+   if (::ioctl(fd, FIONREAD, &available) == -1) {
+      return -1;
+   }
+   return available;
+}
+
+bool set_socket_option(int fd, int level, int option, int value)
+{
+   return ::setsockopt(fd, level, option, &value, sizeof(value)) == 0;
+}
+
+int get_socket_error(int fd)
+{
+   int error = 0;
+   socklen_t length = sizeof(error);
+   if (::getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &length) == -1) {
+      return errno;
+   }
+   return error;
+}
+
+int accept_connections(int listener, int *accepted, int maxCount)
+{
+   int count = 0;
+   while (count < maxCount) {
+      int fd;
+#if defined(PDK_OS_LINUX)
+      PDK_EINTR_LOOP(fd, ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC));
+#else
+      PDK_EINTR_LOOP(fd, ::accept(listener, nullptr, nullptr));
+      if (fd != -1) {
+         set_nonblocking(fd);
+      }
+#endif
+      if (fd == -1) {
+         // ECONNABORTED only concerns the connection that went away
+         if (is_transient_error(errno) || errno == ECONNABORTED) {
+            break;
+         }
+         return count > 0 ? count : -1;
+      }
+      accepted[count++] = fd;
+   }
+   return count;
+}
+
+pdk::pint64 gather_write(int fd, const iovec *segments, int count)
+{
+   pdk::pint64 written;
+#if defined(MSG_NOSIGNAL)
+   msghdr message;
+   std::memset(&message, 0, sizeof(message));
+   message.msg_iov = const_cast<iovec *>(segments);
+   message.msg_iovlen = count;
+   PDK_EINTR_LOOP(written, ::sendmsg(fd, &message, MSG_NOSIGNAL));
+#else
+   pdk::kernel::ignore_sigpipe();
+   PDK_EINTR_LOOP(written, ::writev(fd, segments, count));
+#endif
+   if (written == -1 && is_transient_error(errno)) {
+      return 0;
+   }
+   return written;
+}
+
+pdk::pint64 pending_datagram_size(int fd)
+{
+   pdk::pint64 size;
+#if defined(PDK_OS_LINUX)
+   // MSG_TRUNC reports the real length even though nothing is copied
+   PDK_EINTR_LOOP(size, ::recv(fd, nullptr, 0, MSG_PEEK | MSG_TRUNC | MSG_DONTWAIT));
+#else
+   char c;
+   PDK_EINTR_LOOP(size, ::recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT));
+   if (size != -1) {
+      size = bytes_available(fd);
+   }
+#endif
+   return size;
+}
+
+int receive_datagrams(int fd, NativeDatagram *datagrams, int count)
+{
+   count = std::min(count, static_cast<int>(MaxDatagramBatch));
+#if defined(PDK_OS_LINUX)
+   mmsghdr messages[MaxDatagramBatch];
+   std::memset(messages, 0, sizeof(mmsghdr) * count);
+   for (int i = 0; i < count; ++i) {
+      msghdr &header = messages[i].msg_hdr;
+      header.msg_iov = &datagrams[i].m_buffer;
+      header.msg_iovlen = 1;
+      header.msg_name = &datagrams[i].m_address;
+      header.msg_namelen = sizeof(sockaddr_storage);
+   }
+   int received;
+   PDK_EINTR_LOOP(received, ::recvmmsg(fd, messages, count, MSG_DONTWAIT, nullptr));
+   if (received == -1) {
+      return is_transient_error(errno) ? 0 : -1;
+   }
+   for (int i = 0; i < received; ++i) {
+      datagrams[i].m_size = messages[i].msg_len;
+      datagrams[i].m_addressLength = messages[i].msg_hdr.msg_namelen;
+      datagrams[i].m_truncated = messages[i].msg_hdr.msg_flags & MSG_TRUNC;
+   }
+   return received;
+#else
+   int received = 0;
+   for (; received < count; ++received) {
+      NativeDatagram &datagram = datagrams[received];
+      msghdr header;
+      std::memset(&header, 0, sizeof(header));
+      header.msg_iov = &datagram.m_buffer;
+      header.msg_iovlen = 1;
+      header.msg_name = &datagram.m_address;
+      header.msg_namelen = sizeof(sockaddr_storage);
+      pdk::pint64 size;
+      PDK_EINTR_LOOP(size, ::recvmsg(fd, &header, MSG_DONTWAIT));
+      if (size == -1) {
+         if (is_transient_error(errno) || received > 0) {
+            break;
+         }
+         return -1;
+      }
+      datagram.m_size = size;
+      datagram.m_addressLength = header.msg_namelen;
+      datagram.m_truncated = header.msg_flags & MSG_TRUNC;
+   }
+   return received;
+#endif
+}
+
+int send_datagrams(int fd, NativeDatagram *datagrams, int count)
+{
+   count = std::min(count, static_cast<int>(MaxDatagramBatch));
+#if defined(PDK_OS_LINUX)
+   mmsghdr messages[MaxDatagramBatch];
+   std::memset(messages, 0, sizeof(mmsghdr) * count);
+   for (int i = 0; i < count; ++i) {
+      msghdr &header = messages[i].msg_hdr;
+      header.msg_iov = &datagrams[i].m_buffer;
+      header.msg_iovlen = 1;
+      header.msg_name = &datagrams[i].m_address;
+      header.msg_namelen = datagrams[i].m_addressLength;
+   }
+   int sent;
+   PDK_EINTR_LOOP(sent, ::sendmmsg(fd, messages, count, MSG_DONTWAIT | MSG_NOSIGNAL));
+   if (sent == -1) {
+      return is_transient_error(errno) ? 0 : -1;
+   }
+   for (int i = 0; i < sent; ++i) {
+      datagrams[i].m_size = messages[i].msg_len;
+   }
+   return sent;
+#else
+   int sent = 0;
+   for (; sent < count; ++sent) {
+      NativeDatagram &datagram = datagrams[sent];
+      pdk::pint64 size;
+      PDK_EINTR_LOOP(size, ::sendto(fd, datagram.m_buffer.iov_base, datagram.m_buffer.iov_len,
+                                    MSG_DONTWAIT, reinterpret_cast<sockaddr *>(&datagram.m_address),
+                                    datagram.m_addressLength));
+      if (size == -1) {
+         if (is_transient_error(errno) || sent > 0) {
+            break;
+         }
+         return -1;
+      }
+      datagram.m_size = size;
+   }
+   return sent;
+#endif
+}
+
+} // net
+} // pal
+} // pdk
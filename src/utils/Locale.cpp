@@ -2222,12 +2222,40 @@ String LocaleData::longLongToString(pdk::plonglong l, int precision,
                            l, precision, base, width, flags);
 }
 
+namespace {
+
+// a decimal without precision, padding or flags, written in one go
+String plain_decimal_to_string(const Character zero, const Character minus,
+                               bool negative, pdk::pulonglong magnitude)
+{
+   char digits[internal::LONGLONG_DECIMAL_BUFFER_SIZE];
+   const int length = internal::pdk_ulltoa_decimal(magnitude, digits);
+   ushort buffer[internal::LONGLONG_DECIMAL_BUFFER_SIZE + 1];
+   int size = 0;
+   if (negative) {
+      buffer[size++] = minus.unicode();
+   }
+   const ushort offset = zero.unicode() - '0';
+   for (int i = 0; i < length; ++i) {
+      buffer[size++] = digits[i] + offset;
+   }
+   return String(reinterpret_cast<Character *>(buffer), size);
+}
+
+} // anonymous namespace
+
 String LocaleData::longLongToString(const Character zero, const Character group,
                                     const Character plus, const Character minus,
                                     pdk::plonglong l, int precision,
                                     int base, int width,
                                     Flags flags)
 {
+   // grouping changes nothing below a thousand
+   if (base == 10 && precision == -1
+       && (flags == Flag::NoFlags || (flags == Flag::ThousandsGroup && l > -1000 && l < 1000))) {
+      return plain_decimal_to_string(zero, minus, l < 0,
+                                     l < 0 ? 0 - pdk::pulonglong(l) : pdk::pulonglong(l));
+   }
    bool precision_not_specified = false;
    if (precision == -1) {
       precision_not_specified = true;
@@ -2333,6 +2361,10 @@ String LocaleData::unsLongLongToString(const Character zero, const Character gro
                                        int base, int width,
                                        Flags flags)
 {
+   if (base == 10 && precision == -1
+       && (flags == Flag::NoFlags || (flags == Flag::ThousandsGroup && l < 1000))) {
+      return plain_decimal_to_string(zero, Character(), false, l);
+   }
    const Character resultZero = base == 10 ? zero : Character(Latin1Character('0'));
    String num_str = l ? internal::pdk_ulltoa(l, base, zero) : String(resultZero);
    
@@ -2664,9 +2696,43 @@ double LocaleData::stringToDouble(StringView str, bool *ok,
    return d;
 }
 
+namespace {
+
+constexpr int PLAIN_DECIMAL_MAX_LENGTH = 32;
+
+// [+-]digits in a locale that writes numbers like the c locale, narrowed
+// for the decimal fast path without going through numberToCLocale
+bool narrow_plain_decimal(const LocaleData *data, StringView str, char *latin1)
+{
+   if (data->m_zero != '0' || data->m_minus != '-' || data->m_plus != '+'
+       || str.size() > PLAIN_DECIMAL_MAX_LENGTH) {
+      return false;
+   }
+   const Character *units = str.data();
+   for (StringView::size_type i = 0; i < str.size(); ++i) {
+      const ushort unit = units[i].unicode();
+      if (unit >= 0x80) {
+         return false;
+      }
+      latin1[i] = static_cast<char>(unit);
+   }
+   return true;
+}
+
+} // anonymous namespace
+
 pdk::plonglong LocaleData::stringToLongLong(StringView str, int base, bool *ok,
                                             Locale::NumberOptions number_options) const
 {
+   char latin1[PLAIN_DECIMAL_MAX_LENGTH];
+   pdk::plonglong value;
+   if (narrow_plain_decimal(this, str, latin1) && internal::is_decimal_base(latin1, int(str.size()), base)
+       && internal::pdk_strntoll_decimal(latin1, int(str.size()), value)) {
+      if (ok != 0) {
+         *ok = true;
+      }
+      return value;
+   }
    CharBuff buff;
    if (!numberToCLocale(str, number_options, &buff)) {
       if (ok != 0) {
@@ -2681,6 +2747,15 @@ pdk::plonglong LocaleData::stringToLongLong(StringView str, int base, bool *ok,
 pdk::pulonglong LocaleData::stringToUnsLongLong(StringView str, int base, bool *ok,
                                                 Locale::NumberOptions number_options) const
 {
+   char latin1[PLAIN_DECIMAL_MAX_LENGTH];
+   pdk::pulonglong value;
+   if (narrow_plain_decimal(this, str, latin1) && internal::is_decimal_base(latin1, int(str.size()), base)
+       && internal::pdk_strntoull_decimal(latin1, int(str.size()), value)) {
+      if (ok != 0) {
+         *ok = true;
+      }
+      return value;
+   }
    CharBuff buff;
    if (!numberToCLocale(str, number_options, &buff)) {
       if (ok != 0) {
@@ -2709,6 +2784,7 @@ pdk::plonglong LocaleData::bytearrayToLongLong(const char *num, int base, bool *
 {
    bool _ok;
    const char *endptr;
+   pdk::plonglong l;
    
    if (*num == '\0') {
       if (ok != 0)
@@ -2716,7 +2792,14 @@ pdk::plonglong LocaleData::bytearrayToLongLong(const char *num, int base, bool *
       return 0;
    }
    
-   pdk::plonglong l = internal::pdk_strtoll(num, &endptr, base, &_ok);
+   const int len = static_cast<int>(pdk::strlen(num));
+   if (internal::is_decimal_base(num, len, base) && internal::pdk_strntoll_decimal(num, len, l)) {
+      if (ok != 0) {
+         *ok = true;
+      }
+      return l;
+   }
+   l = internal::pdk_strtoll(num, &endptr, base, &_ok);
    
    if (!_ok) {
       if (ok != 0) {
@@ -2743,7 +2826,15 @@ pdk::pulonglong LocaleData::bytearrayToUnsLongLong(const char *num, int base, bo
 {
    bool _ok;
    const char *endptr;
-   pdk::pulonglong l = internal::pdk_strtoull(num, &endptr, base, &_ok);
+   pdk::pulonglong l;
+   const int len = static_cast<int>(pdk::strlen(num));
+   if (internal::is_decimal_base(num, len, base) && internal::pdk_strntoull_decimal(num, len, l)) {
+      if (ok != 0) {
+         *ok = true;
+      }
+      return l;
+   }
+   l = internal::pdk_strtoull(num, &endptr, base, &_ok);
    
    if (!_ok || *endptr != '\0') {
       if (ok != 0) {
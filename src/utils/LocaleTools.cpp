@@ -16,8 +16,11 @@
 #include "pdk/utils/internal/LocaleToolsPrivate.h"
 #include "pdk/utils/internal/LocalePrivate.h"
 #include "pdk/utils/internal/DoubleScanPrintPrivate.h"
+#include "pdk/utils/internal/DoubleTablesPrivate.h"
 #include "pdk/global/internal/NumericPrivate.h"
+#include "pdk/global/Endian.h"
 #include "pdk/base/lang/String.h"
+#include "pdk/kernel/Algorithms.h"
 
 #include <ctype.h>
 #include <errno.h>
@@ -25,6 +28,7 @@
 #include <limits.h>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <time.h>
 
 #if defined(PDK_OS_LINUX) && !defined(__UCLIBC__)
@@ -50,6 +54,452 @@ PDK_CLOCALE_HOLDER
 
 using pdk::lang::Latin1String;
 
+namespace {
+
+// the clinger fast path needs double operations rounded once
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+constexpr bool EXACT_FLOATING_POINT_EVALUATION = true;
+#else
+constexpr bool EXACT_FLOATING_POINT_EVALUATION = false;
+#endif
+
+// low half of the 128 bit product, the high half goes to high
+inline pdk::puint64 umul128(pdk::puint64 a, pdk::puint64 b, pdk::puint64 *high)
+{
+#if defined(__SIZEOF_INT128__)
+   __extension__ const unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+   *high = static_cast<pdk::puint64>(product >> 64);
+   return static_cast<pdk::puint64>(product);
+#else
+   const pdk::puint64 aLow = static_cast<pdk::puint32>(a);
+   const pdk::puint64 aHigh = a >> 32;
+   const pdk::puint64 bLow = static_cast<pdk::puint32>(b);
+   const pdk::puint64 bHigh = b >> 32;
+   const pdk::puint64 b00 = aLow * bLow;
+   const pdk::puint64 mid1 = aHigh * bLow + (b00 >> 32);
+   const pdk::puint64 mid2 = aLow * bHigh + static_cast<pdk::puint32>(mid1);
+   *high = aHigh * bHigh + (mid1 >> 32) + (mid2 >> 32);
+   return (mid2 << 32) | static_cast<pdk::puint32>(b00);
+#endif
+}
+
+// (m * mul) >> j for a 128 bit mul, j is in [65, 127]
+inline pdk::puint64 mul_shift_64(pdk::puint64 m, const pdk::puint64 *mul, int j)
+{
+   pdk::puint64 high0;
+   umul128(m, mul[0], &high0);
+   pdk::puint64 high1;
+   const pdk::puint64 low1 = umul128(m, mul[1], &high1);
+   const pdk::puint64 sum = high0 + low1;
+   if (sum < high0) {
+      ++high1;
+   }
+   const int shift = j - 64;
+   return (high1 << (64 - shift)) | (sum >> shift);
+}
+
+// ceil(log2(5^e)) for e in [1, 3528], 1 for e == 0
+inline int pow5_bits(int e)
+{
+   return static_cast<int>((static_cast<pdk::puint32>(e) * 1217359) >> 19) + 1;
+}
+
+// floor(log10(2^e)) for e in [0, 1650]
+inline int log10_pow2(int e)
+{
+   return static_cast<int>((static_cast<pdk::puint32>(e) * 78913) >> 18);
+}
+
+// floor(log10(5^e)) for e in [0, 2620]
+inline int log10_pow5(int e)
+{
+   return static_cast<int>((static_cast<pdk::puint32>(e) * 732923) >> 20);
+}
+
+inline bool multiple_of_pow5(pdk::puint64 value, int p)
+{
+   int count = 0;
+   while (value % 5 == 0) {
+      value /= 5;
+      ++count;
+   }
+   return count >= p;
+}
+
+inline bool multiple_of_pow2(pdk::puint64 value, int p)
+{
+   return (value & ((pdk::puint64(1) << p) - 1)) == 0;
+}
+
+// the shortest digits that read back as d, ryu by Ulf Adams. d is finite
+// and greater than zero, the digits come without trailing zeros
+int shortest_digits(double d, char *digits, int &decpt)
+{
+   pdk::puint64 bits;
+   std::memcpy(&bits, &d, sizeof(bits));
+   const pdk::puint64 ieeeMantissa = bits & ((pdk::puint64(1) << 52) - 1);
+   const int ieeeExponent = static_cast<int>(bits >> 52) & 0x7ff;
+   // the value is m2 * 2^e2, two more bits for the bounds
+   int e2;
+   pdk::puint64 m2;
+   if (ieeeExponent == 0) {
+      e2 = 1 - 1023 - 52 - 2;
+      m2 = ieeeMantissa;
+   } else {
+      e2 = ieeeExponent - 1023 - 52 - 2;
+      m2 = (pdk::puint64(1) << 52) | ieeeMantissa;
+   }
+   const bool acceptBounds = (m2 & 1) == 0;
+   const pdk::puint64 mv = 4 * m2;
+   // the lower bound is closer when the mantissa is at a power of two
+   const pdk::puint64 mmShift = ieeeMantissa != 0 || ieeeExponent <= 1;
+   pdk::puint64 vr;
+   pdk::puint64 vp;
+   pdk::puint64 vm;
+   int e10;
+   bool vmIsTrailingZeros = false;
+   bool vrIsTrailingZeros = false;
+   if (e2 >= 0) {
+      const int q = log10_pow2(e2) - (e2 > 3);
+      e10 = q;
+      const int k = DOUBLE_POW5_INV_BITCOUNT + pow5_bits(q) - 1;
+      const int i = -e2 + q + k;
+      vr = mul_shift_64(mv, DOUBLE_POW5_INV_SPLIT[q], i);
+      vp = mul_shift_64(mv + 2, DOUBLE_POW5_INV_SPLIT[q], i);
+      vm = mul_shift_64(mv - 1 - mmShift, DOUBLE_POW5_INV_SPLIT[q], i);
+      if (q <= 21) {
+         // at most one of mp, mv and mm is a multiple of 5
+         if (mv % 5 == 0) {
+            vrIsTrailingZeros = multiple_of_pow5(mv, q);
+         } else if (acceptBounds) {
+            vmIsTrailingZeros = multiple_of_pow5(mv - 1 - mmShift, q);
+         } else {
+            vp -= multiple_of_pow5(mv + 2, q);
+         }
+      }
+   } else {
+      const int q = log10_pow5(-e2) - (-e2 > 1);
+      e10 = q + e2;
+      const int i = -e2 - q;
+      const int k = pow5_bits(i) - DOUBLE_POW5_BITCOUNT;
+      const int j = q - k;
+      vr = mul_shift_64(mv, DOUBLE_POW5_SPLIT[i], j);
+      vp = mul_shift_64(mv + 2, DOUBLE_POW5_SPLIT[i], j);
+      vm = mul_shift_64(mv - 1 - mmShift, DOUBLE_POW5_SPLIT[i], j);
+      if (q <= 1) {
+         // mv has at least 2 trailing zero bits, so does vr
+         vrIsTrailingZeros = true;
+         if (acceptBounds) {
+            vmIsTrailingZeros = mmShift == 1;
+         } else {
+            --vp;
+         }
+      } else if (q < 63) {
+         vrIsTrailingZeros = multiple_of_pow2(mv, q);
+      }
+   }
+   // drop digits while the interval still holds a shorter number
+   int removed = 0;
+   int lastRemovedDigit = 0;
+   pdk::puint64 output;
+   if (vmIsTrailingZeros || vrIsTrailingZeros) {
+      while (vp / 10 > vm / 10) {
+         vmIsTrailingZeros &= vm % 10 == 0;
+         vrIsTrailingZeros &= lastRemovedDigit == 0;
+         lastRemovedDigit = static_cast<int>(vr % 10);
+         vr /= 10;
+         vp /= 10;
+         vm /= 10;
+         ++removed;
+      }
+      if (vmIsTrailingZeros) {
+         while (vm % 10 == 0) {
+            vrIsTrailingZeros &= lastRemovedDigit == 0;
+            lastRemovedDigit = static_cast<int>(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            ++removed;
+         }
+      }
+      if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) {
+         // exactly halfway, round to even
+         lastRemovedDigit = 4;
+      }
+      output = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+   } else {
+      // the common case, no trailing zeros to track
+      bool roundUp = false;
+      if (vp / 100 > vm / 100) {
+         roundUp = vr % 100 >= 50;
+         vr /= 100;
+         vp /= 100;
+         vm /= 100;
+         removed += 2;
+      }
+      while (vp / 10 > vm / 10) {
+         roundUp = vr % 10 >= 5;
+         vr /= 10;
+         vp /= 10;
+         vm /= 10;
+         ++removed;
+      }
+      output = vr + (vr == vm || roundUp);
+   }
+   char buffer[20];
+   int length = 0;
+   do {
+      buffer[length++] = static_cast<char>('0' + output % 10);
+      output /= 10;
+   } while (output);
+   decpt = e10 + removed + length;
+   int first = 0;
+   while (length - first > 1 && buffer[first] == '0') {
+      ++first;
+   }
+   for (int i = length - 1; i >= first; --i) {
+      *digits++ = buffer[i];
+   }
+   return length - first;
+}
+
+// exact powers of ten a double holds
+constexpr double EXACT_POWERS_OF_TEN[] = {
+   1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+   1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// significand * 10^exp10 correctly rounded, by Daniel Lemire after an
+// idea of Michael Eisel. false when the result is not a normal double or
+// the product is too close to a halfway point to decide
+bool eisel_lemire(pdk::puint64 significand, int exp10, bool negative, double &result)
+{
+   if (exp10 < POW10_SIGNIFICAND_MIN_EXP10 || exp10 > POW10_SIGNIFICAND_MAX_EXP10) {
+      return false;
+   }
+   const int leadingZeros = static_cast<int>(pdk::count_leading_zero_bits(significand));
+   significand <<= leadingZeros;
+   // 217706 / 2^16 is log2(10)
+   pdk::puint64 exp2 = static_cast<pdk::puint64>(((217706 * exp10) >> 16) + 64 + 1023 - leadingZeros);
+   const pdk::puint64 *power = POW10_SIGNIFICANDS[exp10 - POW10_SIGNIFICAND_MIN_EXP10];
+   pdk::puint64 high;
+   pdk::puint64 low = umul128(significand, power[1], &high);
+   if ((high & 0x1ff) == 0x1ff && low + significand < significand) {
+      // the truncated power is not precise enough, take its lower half too
+      pdk::puint64 lowerHigh;
+      const pdk::puint64 lowerLow = umul128(significand, power[0], &lowerHigh);
+      const pdk::puint64 mergedLow = low + lowerHigh;
+      if (mergedLow < low) {
+         ++high;
+      }
+      if ((high & 0x1ff) == 0x1ff && mergedLow + 1 == 0 && lowerLow + significand < significand) {
+         return false;
+      }
+      low = mergedLow;
+   }
+   const pdk::puint64 msb = high >> 63;
+   pdk::puint64 mantissa = high >> (msb + 9);
+   exp2 -= 1 ^ msb;
+   if (low == 0 && (high & 0x1ff) == 0 && (mantissa & 3) == 1) {
+      // halfway between two doubles
+      return false;
+   }
+   mantissa += mantissa & 1;
+   mantissa >>= 1;
+   if (mantissa >> 53) {
+      mantissa >>= 1;
+      ++exp2;
+   }
+   // subnormals, infinity and overflow are left to the slow path
+   if (exp2 - 1 >= 0x7ff - 1) {
+      return false;
+   }
+   pdk::puint64 bits = (exp2 << 52) | (mantissa & ((pdk::puint64(1) << 52) - 1));
+   if (negative) {
+      bits |= pdk::puint64(1) << 63;
+   }
+   std::memcpy(&result, &bits, sizeof(result));
+   return true;
+}
+
+inline bool is_ascii_digit(char c)
+{
+   return c >= '0' && c <= '9';
+}
+
+// [+-]digits[.digits][(e|E)[+-]digits] without the help of sscanf. false
+// when num has any other form or more than 19 significant digits, then
+// sscanf decides
+bool fast_ascii_to_double(const char *num, int numLen, double &result, int &processed)
+{
+   const char *ptr = num;
+   const char *end = num + numLen;
+   bool negative = false;
+   if (ptr < end && (*ptr == '-' || *ptr == '+')) {
+      negative = *ptr == '-';
+      ++ptr;
+   }
+   pdk::puint64 significand = 0;
+   int significantDigits = 0;
+   int exponent = 0;
+   bool anyDigit = false;
+   while (ptr < end && *ptr == '0') {
+      anyDigit = true;
+      ++ptr;
+   }
+   while (ptr < end && is_ascii_digit(*ptr)) {
+      if (significantDigits == 19) {
+         return false;
+      }
+      significand = significand * 10 + (*ptr - '0');
+      ++significantDigits;
+      anyDigit = true;
+      ++ptr;
+   }
+   if (ptr < end && *ptr == '.') {
+      ++ptr;
+      if (significantDigits == 0) {
+         while (ptr < end && *ptr == '0') {
+            --exponent;
+            anyDigit = true;
+            ++ptr;
+         }
+      }
+      while (ptr < end && is_ascii_digit(*ptr)) {
+         if (significantDigits == 19) {
+            return false;
+         }
+         significand = significand * 10 + (*ptr - '0');
+         ++significantDigits;
+         --exponent;
+         anyDigit = true;
+         ++ptr;
+      }
+   }
+   if (!anyDigit) {
+      return false;
+   }
+   if (ptr < end && (*ptr == 'e' || *ptr == 'E')) {
+      const char *exponentPtr = ptr + 1;
+      bool negativeExponent = false;
+      if (exponentPtr < end && (*exponentPtr == '-' || *exponentPtr == '+')) {
+         negativeExponent = *exponentPtr == '-';
+         ++exponentPtr;
+      }
+      if (exponentPtr == end || !is_ascii_digit(*exponentPtr)) {
+         return false;
+      }
+      int value = 0;
+      while (exponentPtr < end && is_ascii_digit(*exponentPtr)) {
+         if (value < 100000) {
+            value = value * 10 + (*exponentPtr - '0');
+         }
+         ++exponentPtr;
+      }
+      exponent += negativeExponent ? -value : value;
+      ptr = exponentPtr;
+   } else if (ptr < end && (*ptr == 'x' || *ptr == 'X')) {
+      // hexadecimal
+      return false;
+   }
+   if (significand == 0) {
+      result = negative ? -0.0 : 0.0;
+   } else if (significand <= (pdk::puint64(1) << 53) && exponent >= -22 && exponent <= 22
+           && EXACT_FLOATING_POINT_EVALUATION) {
+      // both operands are exact, so is the correctly rounded result
+      double value = static_cast<double>(significand);
+      if (exponent < 0) {
+         value /= EXACT_POWERS_OF_TEN[-exponent];
+      } else {
+         value *= EXACT_POWERS_OF_TEN[exponent];
+      }
+      result = negative ? -value : value;
+   } else if (!eisel_lemire(significand, exponent, negative, result)) {
+      return false;
+   }
+   processed = static_cast<int>(ptr - num);
+   return true;
+}
+
+// eight ascii digits at once, the first digit is the low byte of chunk
+inline bool is_eight_digits(pdk::puint64 chunk)
+{
+   return !(((chunk + PDK_UINT64_C(0x4646464646464646)) | (chunk - PDK_UINT64_C(0x3030303030303030)))
+            & PDK_UINT64_C(0x8080808080808080));
+}
+
+inline pdk::puint32 parse_eight_digits(pdk::puint64 chunk)
+{
+   chunk -= PDK_UINT64_C(0x3030303030303030);
+   // pairs, then groups of four, then all eight digits
+   chunk = chunk * 10 + (chunk >> 8);
+   chunk = ((chunk & PDK_UINT64_C(0x000000ff000000ff)) * (100 + (PDK_UINT64_C(1000000) << 32))
+            + ((chunk >> 16) & PDK_UINT64_C(0x000000ff000000ff)) * (1 + (PDK_UINT64_C(10000) << 32))) >> 32;
+   return pdk::puint32(chunk);
+}
+
+// value below 10^8 as eight ascii digits with leading zeros, ready to be
+// copied to memory
+inline pdk::puint64 format_eight_digits(pdk::puint32 value)
+{
+   // one group of four digits per 32 bit lane, the leading group in the low lane
+   pdk::puint64 chunk = (value / 10000) | (pdk::puint64(value % 10000) << 32);
+   // x * 10486 >> 20 is x / 100 and x * 103 >> 10 is x / 10 in these ranges
+   pdk::puint64 high = ((chunk * 10486) >> 20) & PDK_UINT64_C(0x0000007f0000007f);
+   chunk = high | ((chunk - high * 100) << 16);
+   high = ((chunk * 103) >> 10) & PDK_UINT64_C(0x000f000f000f000f);
+   chunk = high | ((chunk - high * 10) << 8);
+   return pdk::from_little_endian(chunk | PDK_UINT64_C(0x3030303030303030));
+}
+
+inline pdk::puint64 load_eight_chars(const char *ptr)
+{
+   pdk::puint64 chunk;
+   std::memcpy(&chunk, ptr, sizeof(chunk));
+   return pdk::from_little_endian(chunk);
+}
+
+// digits only, at least one of them, with the value below 2^64
+bool parse_decimal_digits(const char *ptr, const char *end, pdk::puint64 &value)
+{
+   if (ptr == end) {
+      return false;
+   }
+   while (ptr < end && *ptr == '0') {
+      ++ptr;
+   }
+   // 19 digits never overflow
+   const char *limit = ptr + std::min<std::ptrdiff_t>(end - ptr, 19);
+   pdk::puint64 result = 0;
+   while (limit - ptr >= 8) {
+      const pdk::puint64 chunk = load_eight_chars(ptr);
+      if (!is_eight_digits(chunk)) {
+         break;
+      }
+      result = result * 100000000 + parse_eight_digits(chunk);
+      ptr += 8;
+   }
+   while (ptr < limit && is_ascii_digit(*ptr)) {
+      result = result * 10 + (*ptr - '0');
+      ++ptr;
+   }
+   if (ptr != end) {
+      // a twentieth digit fits as long as the value stays below 2^64
+      if (ptr != limit || end - ptr != 1 || !is_ascii_digit(*ptr)) {
+         return false;
+      }
+      const unsigned digit = *ptr - '0';
+      if (result > ULLONG_MAX / 10 || (result == ULLONG_MAX / 10 && digit > ULLONG_MAX % 10)) {
+         return false;
+      }
+      result = result * 10 + digit;
+   }
+   value = result;
+   return true;
+}
+
+} // anonymous namespace
+
 void double_to_ascii(double d, LocaleData::DoubleForm form, int precision, char *buf, int bufSize,
                      bool &sign, int &length, int &decpt)
 {
@@ -95,10 +545,11 @@ void double_to_ascii(double d, LocaleData::DoubleForm form, int precision, char
    // significant digits, so anything after that is mostly noise. You do get closer to the "middle"
    // of the range covered by the given double with more digits, so to a degree it does make sense
    // to honor higher precisions. We define that at more than 999 digits that is not the case.
+   const bool shortest = precision == Locale::FloatingPointShortest;
    if (precision > 999) {
       precision = 999;
-   } else if (precision == Locale::FloatingPointShortest) {
-      precision = LocaleData::DoubleMaxSignificant; // "shortest" mode not supported by snprintf
+   } else if (shortest) {
+      precision = LocaleData::DoubleMaxSignificant;
    }
    if (is_zero(d)) {
       // Negative zero is expected as simple "0", not "-0". We cannot do d < 0, though.
@@ -113,6 +564,26 @@ void double_to_ascii(double d, LocaleData::DoubleForm form, int precision, char
    } else {
       sign = false;
    }
+   
+   char digits[LocaleData::DoubleMaxSignificant];
+   int digitsDecpt;
+   const int digitCount = shortest_digits(d, digits, digitsDecpt);
+   // Rounding a normal double to at most 15 significant digits can not move it off the shortest
+   // digits when they fit, the error of the shortest digits is below half a step of the 15th
+   // digit. Otherwise snprintf rounds the exact binary value.
+   int significantDigits = precision;
+   if (form == LocaleData::DoubleForm::DFDecimal) {
+      significantDigits = digitsDecpt + precision;
+   } else if (form == LocaleData::DoubleForm::DFExponent) {
+      significantDigits = precision + 1;
+   }
+   if (digitCount <= bufSize && (shortest || (d >= DBL_MIN && digitCount <= significantDigits &&
+                                              significantDigits <= 15))) {
+      std::memcpy(buf, digits, digitCount);
+      length = digitCount;
+      decpt = digitsDecpt;
+      return;
+   }
    const int formatLength = 7; // '%', '.', 3 digits precision, 'f', '\0'
    char format[formatLength];
    format[formatLength - 1] = '\0';
@@ -268,7 +739,8 @@ double ascii_to_double(const char *num, int numLen, bool &ok, int &processed,
    }
    
    double d = 0.0;
-   if (pdk_double_sscanf(num, PDK_CLOCALE, "%lf%n", &d, &processed) < 1) {
+   if (!fast_ascii_to_double(num, numLen, d, processed) &&
+       pdk_double_sscanf(num, PDK_CLOCALE, "%lf%n", &d, &processed) < 1) {
       processed = 0;
    }
    if ((trailingJunkMode == TrailingJunkMode::TrailingJunkProhibited && processed != numLen) || std::isnan(d)) {
@@ -359,8 +831,78 @@ pdk_strtoll(const char * nptr, const char **endptr, int base, bool *ok)
    return result;
 }
 
+bool pdk_strntoll_decimal(const char *num, int len, pdk::plonglong &value)
+{
+   const char *end = num + len;
+   bool negative = false;
+   if (num < end && (*num == '-' || *num == '+')) {
+      negative = *num == '-';
+      ++num;
+   }
+   pdk::pulonglong magnitude;
+   if (!parse_decimal_digits(num, end, magnitude)) {
+      return false;
+   }
+   const pdk::pulonglong limit = negative ? pdk::pulonglong(LLONG_MAX) + 1 : pdk::pulonglong(LLONG_MAX);
+   if (magnitude > limit) {
+      return false;
+   }
+   value = negative ? pdk::plonglong(0 - magnitude) : pdk::plonglong(magnitude);
+   return true;
+}
+
+bool pdk_strntoull_decimal(const char *num, int len, pdk::pulonglong &value)
+{
+   const char *end = num + len;
+   if (num < end && *num == '+') {
+      ++num;
+   }
+   return parse_decimal_digits(num, end, value);
+}
+
+int pdk_ulltoa_decimal(pdk::pulonglong l, char *buffer)
+{
+   // whole groups of eight digits from the right, then the leading group
+   char digits[24];
+   char *p = digits + sizeof(digits);
+   while (l >= 100000000) {
+      const pdk::puint64 chunk = format_eight_digits(pdk::puint32(l % 100000000));
+      p -= 8;
+      std::memcpy(p, &chunk, sizeof(chunk));
+      l /= 100000000;
+   }
+   const pdk::puint32 leading = pdk::puint32(l);
+   const pdk::puint64 chunk = format_eight_digits(leading);
+   p -= 8;
+   std::memcpy(p, &chunk, sizeof(chunk));
+   int leadingDigits = 1;
+   for (pdk::puint32 rest = leading; rest >= 10; rest /= 10) {
+      ++leadingDigits;
+   }
+   p += 8 - leadingDigits;
+   const int length = static_cast<int>(digits + sizeof(digits) - p);
+   std::memcpy(buffer, p, length);
+   return length;
+}
+
+int pdk_lltoa_decimal(pdk::plonglong l, char *buffer)
+{
+   if (l >= 0) {
+      return pdk_ulltoa_decimal(pdk::pulonglong(l), buffer);
+   }
+   buffer[0] = '-';
+   return 1 + pdk_ulltoa_decimal(0 - pdk::pulonglong(l), buffer + 1);
+}
+
 String pdk_ulltoa(pdk::pulonglong l, int base, const Character _zero)
 {
+   if (base == 10 && _zero.unicode() == '0') {
+      if (l == 0) {
+         return String();
+      }
+      char digits[LONGLONG_DECIMAL_BUFFER_SIZE];
+      return String::fromLatin1(digits, pdk_ulltoa_decimal(l, digits));
+   }
    ushort buff[65]; // length of MAX_ULLONG in base 2
    ushort *p = buff + 65;
    if (base != 10 || _zero.unicode() == '0') {
@@ -0,0 +1,315 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/compress/DeflateDevice.h"
+#include "pdk/base/compress/phar/PharArchive.h"
+#include "pdk/base/compress/zip/ZipArchive.h"
+#include "pdk/base/io/Buffer.h"
+#include "pdk/base/io/fs/TemporaryFile.h"
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using pdk::ds::ByteArray;
+using pdk::lang::Latin1String;
+using pdk::io::Buffer;
+using pdk::io::IoDevice;
+using pdk::io::fs::TemporaryFile;
+using pdk::compress::ArchiveEntry;
+using pdk::compress::CompressionFormat;
+using pdk::compress::DeflateDevice;
+using pdk::compress::phar::PharArchive;
+using pdk::compress::zip::ZipArchive;
+
+namespace {
+
+struct TestEntry
+{
+   const char *name;
+   ByteArray data;
+   bool deflate;
+};
+
+void append_uint16(ByteArray &out, pdk::puint16 value)
+{
+   out.append(static_cast<char>(value & 0xff));
+   out.append(static_cast<char>(value >> 8));
+}
+
+void append_uint32(ByteArray &out, pdk::puint32 value)
+{
+   append_uint16(out, static_cast<pdk::puint16>(value & 0xffff));
+   append_uint16(out, static_cast<pdk::puint16>(value >> 16));
+}
+
+pdk::puint32 crc32_of(const ByteArray &data)
+{
+   pdk::puint32 crc = 0xffffffff;
+   for (int i = 0; i < data.size(); ++i) {
+      crc ^= static_cast<uchar>(data[i]);
+      for (int bit = 0; bit < 8; ++bit) {
+         crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+      }
+   }
+   return ~crc;
+}
+
+ByteArray raw_deflate(const ByteArray &data)
+{
+   ByteArray compressed;
+   Buffer sink(&compressed);
+   DeflateDevice deflater(&sink, CompressionFormat::RawDeflate);
+   EXPECT_TRUE(deflater.open(IoDevice::OpenMode::WriteOnly));
+   deflater.write(data);
+   deflater.close();
+   return compressed;
+}
+
+ByteArray make_zip(const std::vector<TestEntry> &entries, const ByteArray &prefix)
+{
+   ByteArray archive = prefix;
+   ByteArray directory;
+   for (const TestEntry &entry : entries) {
+      const ByteArray data = entry.deflate ? raw_deflate(entry.data) : entry.data;
+      const int nameLength = static_cast<int>(std::strlen(entry.name));
+      const int offset = archive.size() - prefix.size();
+      append_uint32(archive, 0x04034b50);
+      append_uint16(archive, 20);
+      append_uint16(archive, 0);
+      append_uint16(archive, entry.deflate ? 8 : 0);
+      append_uint32(archive, 0);
+      append_uint32(archive, crc32_of(entry.data));
+      append_uint32(archive, data.size());
+      append_uint32(archive, entry.data.size());
+      append_uint16(archive, nameLength);
+      // an extra field only in the local header moves the data
+      append_uint16(archive, 4);
+      archive.append(entry.name);
+      append_uint32(archive, 0);
+      archive.append(data);
+
+      append_uint32(directory, 0x02014b50);
+      append_uint16(directory, 20);
+      append_uint16(directory, 20);
+      append_uint16(directory, 0);
+      append_uint16(directory, entry.deflate ? 8 : 0);
+      append_uint32(directory, 0);
+      append_uint32(directory, crc32_of(entry.data));
+      append_uint32(directory, data.size());
+      append_uint32(directory, entry.data.size());
+      append_uint16(directory, nameLength);
+      append_uint16(directory, 0);
+      append_uint16(directory, 0);
+      append_uint16(directory, 0);
+      append_uint16(directory, 0);
+      append_uint32(directory, 0);
+      append_uint32(directory, offset);
+      directory.append(entry.name);
+   }
+   const int directoryOffset = archive.size() - prefix.size();
+   archive.append(directory);
+   append_uint32(archive, 0x06054b50);
+   append_uint16(archive, 0);
+   append_uint16(archive, 0);
+   append_uint16(archive, static_cast<pdk::puint16>(entries.size()));
+   append_uint16(archive, static_cast<pdk::puint16>(entries.size()));
+   append_uint32(archive, directory.size());
+   append_uint32(archive, directoryOffset);
+   append_uint16(archive, 0);
+   return archive;
+}
+
+ByteArray make_phar(const std::vector<TestEntry> &entries, const ByteArray &alias)
+{
+   ByteArray manifest;
+   ByteArray contents;
+   append_uint32(manifest, static_cast<pdk::puint32>(entries.size()));
+   append_uint16(manifest, 0x1100);
+   append_uint32(manifest, 0x00010000);
+   append_uint32(manifest, alias.size());
+   manifest.append(alias);
+   append_uint32(manifest, 0);
+   for (const TestEntry &entry : entries) {
+      const ByteArray data = entry.deflate ? raw_deflate(entry.data) : entry.data;
+      append_uint32(manifest, static_cast<pdk::puint32>(std::strlen(entry.name)));
+      manifest.append(entry.name);
+      append_uint32(manifest, entry.data.size());
+      append_uint32(manifest, 0);
+      append_uint32(manifest, data.size());
+      append_uint32(manifest, crc32_of(entry.data));
+      append_uint32(manifest, entry.deflate ? 0x000011a4 : 0x000001a4);
+      append_uint32(manifest, 0);
+      contents.append(data);
+   }
+   ByteArray archive("<?php __HALT_COMPILER(); ?>\r\n");
+   append_uint32(archive, manifest.size());
+   archive.append(manifest);
+   archive.append(contents);
+   // sha1 signature, the reader never looks at it
+   archive.append(ByteArray(20, 'x'));
+   append_uint32(archive, 0x0002);
+   archive.append("GBMB");
+   return archive;
+}
+
+void write_file(TemporaryFile &file, const ByteArray &data)
+{
+   ASSERT_TRUE(file.open());
+   ASSERT_EQ(file.write(data), data.size());
+   file.close();
+}
+
+ByteArray make_payload(int size)
+{
+   ByteArray payload;
+   for (int i = 0; payload.size() < size; ++i) {
+      payload.append("entry line ");
+      payload.append(ByteArray::number(i));
+      payload.append('\n');
+   }
+   payload.resize(size);
+   return payload;
+}
+
+std::vector<TestEntry> make_entries()
+{
+   return {
+      {"readme.txt", ByteArray("plain stored text"), false},
+      {"src/", ByteArray(), false},
+      {"src/big.txt", make_payload(300000), true}
+   };
+}
+
+} // anonymous
+
+TEST(ArchiveTest, testZipEntries)
+{
+   const std::vector<TestEntry> entries = make_entries();
+   // data in front of the archive, like a self extracting stub
+   for (const ByteArray &prefix : {ByteArray(), ByteArray("#!/bin/sh\nexit 0\n")}) {
+      TemporaryFile file;
+      write_file(file, make_zip(entries, prefix));
+      ZipArchive archive(file.getFileName());
+      ASSERT_TRUE(archive.open()) << archive.getErrorString().toStdString();
+      ASSERT_EQ(archive.getEntryCount(), 3);
+      ASSERT_TRUE(archive.contains(Latin1String("src/")));
+      ASSERT_TRUE(archive.findEntry(Latin1String("src/"))->isDir());
+      ASSERT_FALSE(archive.contains(Latin1String("missing")));
+
+      const ArchiveEntry *stored = archive.findEntry(Latin1String("readme.txt"));
+      ASSERT_NE(stored, nullptr);
+      ASSERT_EQ(stored->getMethod(), ArchiveEntry::Method::Stored);
+      ByteArray data = archive.readEntry(Latin1String("readme.txt"));
+      ASSERT_EQ(data, entries[0].data);
+
+      const ArchiveEntry *deflated = archive.findEntry(Latin1String("src/big.txt"));
+      ASSERT_NE(deflated, nullptr);
+      ASSERT_EQ(deflated->getMethod(), ArchiveEntry::Method::Deflated);
+      ASSERT_EQ(deflated->getSize(), entries[2].data.size());
+      ASSERT_EQ(archive.readEntry(Latin1String("src/big.txt")), entries[2].data);
+      std::unique_ptr<IoDevice> device(archive.openEntry(Latin1String("src/big.txt")));
+      ASSERT_TRUE(device);
+      ASSERT_EQ(device->read(10), entries[2].data.left(10));
+      ASSERT_EQ(device->readAll(), entries[2].data.mid(10));
+   }
+}
+
+TEST(ArchiveTest, testStoredEntryIsNotCopied)
+{
+   TemporaryFile file;
+   const std::vector<TestEntry> entries = make_entries();
+   write_file(file, make_zip(entries, ByteArray()));
+   ZipArchive archive(file.getFileName());
+   ASSERT_TRUE(archive.open());
+   const ByteArray first = archive.readEntry(Latin1String("readme.txt"));
+   const ByteArray second = archive.readEntry(Latin1String("readme.txt"));
+   // both views point at the same bytes of the mapping
+   ASSERT_EQ(first.getConstRawData(), second.getConstRawData());
+}
+
+TEST(ArchiveTest, testCrcMismatch)
+{
+   const std::vector<TestEntry> entries = make_entries();
+   ByteArray zip = make_zip(entries, ByteArray());
+   // a changed byte in the stored data
+   const int stored = zip.indexOf(entries[0].data);
+   ASSERT_GE(stored, 0);
+   zip[stored] = 'P';
+   TemporaryFile file;
+   write_file(file, zip);
+   ZipArchive archive(file.getFileName());
+   ASSERT_TRUE(archive.open());
+   ASSERT_TRUE(archive.readEntry(Latin1String("readme.txt")).isEmpty());
+   ASSERT_EQ(archive.getRawData(*archive.findEntry(Latin1String("readme.txt"))).size(), entries[0].data.size());
+
+   // the central header of src/big.txt is the last one, its crc-32
+   // starts 16 bytes in
+   ByteArray wrongCrc = make_zip(entries, ByteArray());
+   const int header = wrongCrc.lastIndexOf(ByteArray("PK\x01\x02"));
+   ASSERT_GE(header, 0);
+   wrongCrc[header + 16] = static_cast<char>(wrongCrc[header + 16] ^ 0x01);
+   TemporaryFile wrongCrcFile;
+   write_file(wrongCrcFile, wrongCrc);
+   ZipArchive other(wrongCrcFile.getFileName());
+   ASSERT_TRUE(other.open());
+   ASSERT_TRUE(other.readEntry(Latin1String("src/big.txt")).isEmpty());
+   ASSERT_EQ(other.readEntry(Latin1String("readme.txt")), entries[0].data);
+}
+
+TEST(ArchiveTest, testCorruptZip)
+{
+   ByteArray zip = make_zip(make_entries(), ByteArray());
+   TemporaryFile truncated;
+   write_file(truncated, zip.left(zip.size() - 30));
+   ZipArchive archive(truncated.getFileName());
+   ASSERT_FALSE(archive.open());
+   ASSERT_FALSE(archive.isOpen());
+   ASSERT_FALSE(archive.getErrorString().isEmpty());
+
+   TemporaryFile notZip;
+   write_file(notZip, make_payload(1000));
+   ZipArchive other(notZip.getFileName());
+   ASSERT_FALSE(other.open());
+}
+
+TEST(ArchiveTest, testNativePhar)
+{
+   const std::vector<TestEntry> entries = make_entries();
+   TemporaryFile file;
+   write_file(file, make_phar(entries, ByteArray("app.phar")));
+   PharArchive archive(file.getFileName());
+   ASSERT_TRUE(archive.open()) << archive.getErrorString().toStdString();
+   ASSERT_EQ(archive.getAlias(), Latin1String("app.phar"));
+   ASSERT_EQ(archive.getEntryCount(), 3);
+   ASSERT_EQ(archive.getEntry(0).getName(), Latin1String("readme.txt"));
+   ASSERT_EQ(archive.readEntry(Latin1String("readme.txt")), entries[0].data);
+   ASSERT_EQ(archive.readEntry(Latin1String("src/big.txt")), entries[2].data);
+   archive.close();
+   ASSERT_FALSE(archive.isOpen());
+   ASSERT_EQ(archive.getEntryCount(), 0);
+}
+
+TEST(ArchiveTest, testZipBasedPhar)
+{
+   const std::vector<TestEntry> entries = make_entries();
+   TemporaryFile file;
+   write_file(file, make_zip(entries, ByteArray("<?php __HALT_COMPILER(); ?>\n")));
+   PharArchive archive(file.getFileName());
+   ASSERT_TRUE(archive.open()) << archive.getErrorString().toStdString();
+   ASSERT_TRUE(archive.getAlias().isEmpty());
+   ASSERT_EQ(archive.readEntry(Latin1String("src/big.txt")), entries[2].data);
+}
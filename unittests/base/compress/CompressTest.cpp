@@ -0,0 +1,126 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/compress/Compress.h"
+#include "pdk/base/compress/DeflateDevice.h"
+#include "pdk/base/compress/InflateDevice.h"
+#include "pdk/base/io/Buffer.h"
+
+#include <algorithm>
+
+using pdk::ds::ByteArray;
+using pdk::io::Buffer;
+using pdk::io::IoDevice;
+using pdk::compress::CompressionFormat;
+using pdk::compress::DeflateDevice;
+using pdk::compress::InflateDevice;
+
+namespace {
+
+ByteArray make_payload(int size)
+{
+   ByteArray payload;
+   for (int i = 0; payload.size() < size; ++i) {
+      payload.append("line ");
+      payload.append(ByteArray::number(i));
+      payload.append('\n');
+   }
+   payload.resize(size);
+   return payload;
+}
+
+ByteArray deflate_to_buffer(const ByteArray &payload, CompressionFormat format)
+{
+   ByteArray compressed;
+   Buffer sink(&compressed);
+   DeflateDevice deflater(&sink, format);
+   EXPECT_TRUE(deflater.open(IoDevice::OpenMode::WriteOnly));
+   // odd sized writes cross the internal chunk boundaries
+   for (int offset = 0; offset < payload.size(); offset += 1000) {
+      int length = std::min(1000, payload.size() - offset);
+      EXPECT_EQ(deflater.write(payload.getConstRawData() + offset, length), length);
+   }
+   deflater.close();
+   EXPECT_EQ(deflater.getTotalIn(), payload.size());
+   return compressed;
+}
+
+ByteArray inflate_from_buffer(const ByteArray &compressed, CompressionFormat format)
+{
+   Buffer source;
+   source.setData(compressed);
+   InflateDevice inflater(&source, format);
+   EXPECT_TRUE(inflater.open(IoDevice::OpenMode::ReadOnly));
+   return inflater.readAll();
+}
+
+} // anonymous
+
+TEST(CompressTest, testRoundTrip)
+{
+   ByteArray payload = make_payload(100000);
+   ByteArray compressed = pdk::compress::compress(payload);
+   ASSERT_LT(compressed.size(), payload.size());
+   ASSERT_EQ(pdk::compress::uncompress(compressed), payload);
+   ASSERT_EQ(pdk::compress::uncompress(pdk::compress::compress(payload, 0)), payload);
+   ASSERT_EQ(pdk::compress::uncompress(pdk::compress::compress(ByteArray())), ByteArray());
+}
+
+TEST(CompressTest, testCorruptInput)
+{
+   ByteArray compressed = pdk::compress::compress(make_payload(1000));
+   ASSERT_TRUE(pdk::compress::uncompress(compressed.left(compressed.size() / 2)).isEmpty());
+   compressed[6] = compressed.at(6) ^ 0x55;
+   ASSERT_TRUE(pdk::compress::uncompress(compressed).isEmpty());
+   ASSERT_TRUE(pdk::compress::uncompress(ByteArray("ab")).isEmpty());
+}
+
+TEST(CompressTest, testStreamDevices)
+{
+   ByteArray payload = make_payload(200000);
+   for (CompressionFormat format : {CompressionFormat::Zlib, CompressionFormat::Gzip,
+        CompressionFormat::RawDeflate}) {
+      ByteArray compressed = deflate_to_buffer(payload, format);
+      ASSERT_LT(compressed.size(), payload.size());
+      ASSERT_EQ(inflate_from_buffer(compressed, format), payload);
+   }
+   // zlib and gzip streams are told apart by their header
+   ASSERT_EQ(inflate_from_buffer(deflate_to_buffer(payload, CompressionFormat::Gzip),
+                                 CompressionFormat::AutoDetect), payload);
+   ASSERT_EQ(inflate_from_buffer(deflate_to_buffer(payload, CompressionFormat::Zlib),
+                                 CompressionFormat::AutoDetect), payload);
+}
+
+TEST(CompressTest, testConcatenatedGzipMembers)
+{
+   ByteArray first = make_payload(5000);
+   ByteArray second = make_payload(7000);
+   ByteArray compressed = deflate_to_buffer(first, CompressionFormat::Gzip);
+   compressed.append(deflate_to_buffer(second, CompressionFormat::Gzip));
+   ASSERT_EQ(inflate_from_buffer(compressed, CompressionFormat::Gzip), first + second);
+}
+
+TEST(CompressTest, testTruncatedStream)
+{
+   ByteArray compressed = deflate_to_buffer(make_payload(50000), CompressionFormat::Zlib);
+   Buffer source;
+   source.setData(compressed.left(compressed.size() - 10));
+   InflateDevice inflater(&source);
+   ASSERT_TRUE(inflater.open(IoDevice::OpenMode::ReadOnly));
+   inflater.readAll();
+   ASSERT_TRUE(inflater.atEnd());
+   ASSERT_FALSE(inflater.getErrorString().isEmpty());
+}
@@ -310,3 +310,69 @@ TEST(RingBufferTest, testReadLine)
    ASSERT_EQ(ByteArray(stringBuf, int(strlen(stringBuf))), ba3 + ba4 + ba2);
    ASSERT_EQ(ringBuffer.size(), PDK_INT64_C(0));
 }
+
+TEST(RingBufferTest, testPooledChunksAreRecycled)
+{
+   RingBuffer ringBuffer(1000);
+   const int pooled = RingBuffer::getPooledChunkCount();
+   const std::vector<char> data(900, 'x');
+   // a write that does not fit into the tail slab starts a new one
+   for (int i = 0; i < 8; ++i) {
+      ringBuffer.append(data.data(), 900);
+   }
+   ringBuffer.free(ringBuffer.size());
+   // the last slab stays with the buffer
+   ASSERT_EQ(RingBuffer::getPooledChunkCount(), pooled + 7);
+   for (int i = 0; i < 8; ++i) {
+      ringBuffer.append(data.data(), 900);
+   }
+   ASSERT_EQ(RingBuffer::getPooledChunkCount(), pooled);
+   // a chunk handed out by read() is not pooled
+   ByteArray chunk = ringBuffer.read();
+   ASSERT_EQ(chunk.size(), 900);
+   ringBuffer.clear();
+   ASSERT_EQ(RingBuffer::getPooledChunkCount(), pooled + 7);
+}
+
+TEST(RingBufferTest, testReadSegments)
+{
+   RingBuffer ringBuffer;
+   const char *segments[4];
+   pdk::pint64 lengths[4];
+   ASSERT_EQ(ringBuffer.readSegments(segments, lengths, 4), 0);
+   ringBuffer.append(ByteArray("abc", 3));
+   ringBuffer.append(ByteArray("defg", 4));
+   ringBuffer.append("hi", 2);
+   ringBuffer.free(1);
+   // the appended array grows to take the small write
+   ASSERT_EQ(ringBuffer.readSegments(segments, lengths, 4), 2);
+   ASSERT_EQ(ByteArray(segments[0], int(lengths[0])), ByteArray("bc"));
+   ASSERT_EQ(ByteArray(segments[1], int(lengths[1])), ByteArray("defghi"));
+   ASSERT_EQ(ringBuffer.readSegments(segments, lengths, 1), 1);
+   ASSERT_EQ(lengths[0], PDK_INT64_C(2));
+}
+
+TEST(RingBufferTest, testLinearize)
+{
+   RingBuffer ringBuffer(16);
+   for (int i = 0; i < 3; ++i) {
+      ringBuffer.append("0123456789", 10);
+   }
+   ringBuffer.free(2);
+   ASSERT_EQ(ringBuffer.nextDataBlockSize(), PDK_INT64_C(8));
+   ASSERT_EQ(ringBuffer.linearize(29), nullptr);
+   const char *data = ringBuffer.linearize(15);
+   ASSERT_TRUE(data != nullptr);
+   ASSERT_TRUE(std::memcmp(data, "234567890123456", 15) == 0);
+   ASSERT_TRUE(ringBuffer.nextDataBlockSize() >= 15);
+   ASSERT_EQ(ringBuffer.size(), PDK_INT64_C(28));
+   // already contiguous, nothing moves
+   ASSERT_EQ(ringBuffer.linearize(10), data);
+   data = ringBuffer.linearize(28);
+   ASSERT_TRUE(std::memcmp(data, "2345678901234567890123456789", 28) == 0);
+   ASSERT_EQ(ringBuffer.nextDataBlockSize(), PDK_INT64_C(28));
+   char result[28];
+   ASSERT_EQ(ringBuffer.read(result, 28), PDK_INT64_C(28));
+   ASSERT_TRUE(std::memcmp(result, "2345678901234567890123456789", 28) == 0);
+   ASSERT_TRUE(ringBuffer.isEmpty());
+}
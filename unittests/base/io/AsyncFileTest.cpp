@@ -0,0 +1,256 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/global/Global.h"
+
+#ifdef PDK_OS_UNIX
+
+#include "pdk/base/io/fs/File.h"
+#include "pdk/base/io/fs/internal/AsyncFileEnginePrivate.h"
+#include "pdk/base/ds/ByteArray.h"
+#include "pdk/base/lang/String.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using pdk::ds::ByteArray;
+using pdk::io::IoDevice;
+using pdk::io::fs::File;
+using pdk::io::fs::internal::AsyncFileEngine;
+using pdk::lang::String;
+
+namespace {
+
+// every thread gets its own engine, so each backend is exercised on a
+// fresh thread with the environment set up before the engine exists
+const char *const sg_backends[] = {"io_uring", "threadpool"};
+
+// more than the io_uring queue depth, some requests have to wait for
+// room in the ring
+constexpr int MANY_REQUESTS = 600;
+constexpr int BLOCK_SIZE = 512;
+
+template <typename Func>
+void start_with_backend(std::thread &worker, const char *backend, Func func)
+{
+   if (std::strcmp(backend, "threadpool") == 0) {
+      ::setenv("PDK_ASYNC_FILE_NO_IO_URING", "1", 1);
+   } else {
+      ::unsetenv("PDK_ASYNC_FILE_NO_IO_URING");
+   }
+   worker = std::thread([backend, func]() {
+      const char *name = AsyncFileEngine::getInstance()->getBackendName();
+      if (std::strcmp(backend, "threadpool") == 0) {
+         ASSERT_STREQ(name, "threadpool");
+      } else if (std::strcmp(name, backend) != 0) {
+         // no io_uring in this kernel or build, the fallback must step in
+         ASSERT_STREQ(name, "threadpool");
+      }
+      func();
+   });
+}
+
+template <typename Func>
+void run_with_backend(const char *backend, Func func)
+{
+   std::thread worker;
+   start_with_backend(worker, backend, func);
+   worker.join();
+   ::unsetenv("PDK_ASYNC_FILE_NO_IO_URING");
+}
+
+class AsyncFileTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   {
+      char path[] = "/tmp/pdk_async_file_XXXXXX";
+      const int fd = ::mkstemp(path);
+      ASSERT_NE(fd, -1);
+      ::close(fd);
+      m_path = path;
+   }
+
+   void TearDown() override
+   {
+      ::unlink(m_path.c_str());
+   }
+
+   String getFileName() const
+   {
+      return String::fromStdString(m_path);
+   }
+
+   std::string m_path;
+};
+
+} // anonymous
+
+TEST_F(AsyncFileTest, testWriteThenRead)
+{
+   for (const char *backend : sg_backends) {
+      SCOPED_TRACE(backend);
+      run_with_backend(backend, [this]() {
+         File file(getFileName());
+         ASSERT_TRUE(file.open(IoDevice::OpenMode::ReadWrite | IoDevice::OpenMode::Truncate));
+         std::vector<pdk::pint64> results;
+         const char hello[] = "hello";
+         const char world[] = " world";
+         ASSERT_NE(file.writeAsync(0, hello, 5, [&results](pdk::pint64 result, int errorCode) {
+            ASSERT_EQ(errorCode, 0);
+            results.push_back(result);
+         }), -1);
+         ASSERT_NE(file.writeAsync(5, world, 6, [&results](pdk::pint64 result, int errorCode) {
+            ASSERT_EQ(errorCode, 0);
+            results.push_back(result);
+         }), -1);
+         ASSERT_TRUE(file.waitForAsyncIo());
+         ASSERT_EQ(results.size(), 2u);
+         ASSERT_EQ(results[0] + results[1], 11);
+         char buffer[64];
+         pdk::pint64 readResult = -1;
+         ASSERT_NE(file.readAsync(0, buffer, sizeof(buffer), [&readResult](pdk::pint64 result, int) {
+            readResult = result;
+         }), -1);
+         ASSERT_TRUE(file.waitForAsyncIo());
+         ASSERT_EQ(readResult, 11);
+         ASSERT_EQ(std::string(buffer, 11), "hello world");
+         // positional, the file position does not move
+         ASSERT_EQ(file.getPosition(), 0);
+      });
+   }
+}
+
+TEST_F(AsyncFileTest, testReadPastEnd)
+{
+   for (const char *backend : sg_backends) {
+      SCOPED_TRACE(backend);
+      run_with_backend(backend, [this]() {
+         File file(getFileName());
+         ASSERT_TRUE(file.open(IoDevice::OpenMode::ReadOnly));
+         char buffer[16];
+         pdk::pint64 readResult = -1;
+         int readError = -1;
+         ASSERT_NE(file.readAsync(4096, buffer, sizeof(buffer), [&](pdk::pint64 result, int errorCode) {
+            readResult = result;
+            readError = errorCode;
+         }), -1);
+         ASSERT_TRUE(file.waitForAsyncIo());
+         ASSERT_EQ(readResult, 0);
+         ASSERT_EQ(readError, 0);
+      });
+   }
+}
+
+TEST_F(AsyncFileTest, testRejectedRequests)
+{
+   for (const char *backend : sg_backends) {
+      SCOPED_TRACE(backend);
+      run_with_backend(backend, [this]() {
+         File file(getFileName());
+         char buffer[16] = {};
+         // not open at all
+         ASSERT_EQ(file.readAsync(0, buffer, sizeof(buffer), nullptr), -1);
+         ASSERT_TRUE(file.open(IoDevice::OpenMode::ReadOnly));
+         ASSERT_EQ(file.writeAsync(0, buffer, sizeof(buffer), nullptr), -1);
+         ASSERT_EQ(file.readAsync(-1, buffer, sizeof(buffer), nullptr), -1);
+         ASSERT_TRUE(file.waitForAsyncIo());
+      });
+   }
+}
+
+TEST_F(AsyncFileTest, testManyRequests)
+{
+   for (const char *backend : sg_backends) {
+      SCOPED_TRACE(backend);
+      run_with_backend(backend, [this]() {
+         File file(getFileName());
+         ASSERT_TRUE(file.open(IoDevice::OpenMode::ReadWrite | IoDevice::OpenMode::Truncate));
+         std::vector<char> data(MANY_REQUESTS * BLOCK_SIZE);
+         for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<char>(i / BLOCK_SIZE);
+         }
+         int done = 0;
+         for (int i = 0; i < MANY_REQUESTS; ++i) {
+            ASSERT_NE(file.writeAsync(i * BLOCK_SIZE, data.data() + i * BLOCK_SIZE, BLOCK_SIZE,
+                                      [&done](pdk::pint64 result, int errorCode) {
+               ASSERT_EQ(errorCode, 0);
+               ASSERT_EQ(result, BLOCK_SIZE);
+               ++done;
+            }), -1);
+         }
+         ASSERT_TRUE(file.waitForAsyncIo());
+         ASSERT_EQ(done, MANY_REQUESTS);
+         std::vector<char> readBack(data.size());
+         pdk::pint64 readResult = -1;
+         ASSERT_NE(file.readAsync(0, readBack.data(), readBack.size(), [&readResult](pdk::pint64 result, int) {
+            readResult = result;
+         }), -1);
+         ASSERT_TRUE(file.waitForAsyncIo());
+         ASSERT_EQ(readResult, static_cast<pdk::pint64>(data.size()));
+         ASSERT_TRUE(readBack == data);
+      });
+   }
+}
+
+TEST_F(AsyncFileTest, testDestroyWhileOtherThreadOwnsRequests)
+{
+   for (const char *backend : sg_backends) {
+      SCOPED_TRACE(backend);
+      File *file = new File(getFileName());
+      ASSERT_TRUE(file->open(IoDevice::OpenMode::ReadWrite | IoDevice::OpenMode::Truncate));
+      const char payload[] = "0123456789";
+      std::atomic<bool> submitted(false);
+      std::atomic<bool> callbackRan(false);
+      std::thread::id callbackThread;
+      std::thread::id workerThread;
+      std::thread worker;
+      start_with_backend(worker, backend, [&]() {
+         workerThread = std::this_thread::get_id();
+         ASSERT_NE(file->writeAsync(0, payload, 10, [&](pdk::pint64 result, int errorCode) {
+            ASSERT_EQ(errorCode, 0);
+            ASSERT_EQ(result, 10);
+            callbackThread = std::this_thread::get_id();
+            callbackRan = true;
+         }), -1);
+         submitted = true;
+         // without an event loop nothing is reaped before waitForRequests(),
+         // meanwhile the destructor on the main thread has to block
+         std::this_thread::sleep_for(std::chrono::milliseconds(50));
+         ASSERT_FALSE(callbackRan.load());
+         ASSERT_TRUE(AsyncFileEngine::getInstance()->waitForRequests(-1));
+      });
+      while (!submitted.load()) {
+         std::this_thread::yield();
+      }
+      delete file;
+      ASSERT_TRUE(callbackRan.load());
+      worker.join();
+      ::unsetenv("PDK_ASYNC_FILE_NO_IO_URING");
+      ASSERT_EQ(callbackThread, workerThread);
+      File check(getFileName());
+      ASSERT_TRUE(check.open(IoDevice::OpenMode::ReadOnly));
+      ASSERT_EQ(check.readAll(), ByteArray(payload, 10));
+   }
+}
+
+#endif // PDK_OS_UNIX
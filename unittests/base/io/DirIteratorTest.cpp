@@ -0,0 +1,134 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/io/fs/DirIterator.h"
+#include "pdk/base/io/fs/Dir.h"
+#include "pdk/base/lang/String.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using pdk::io::fs::Dir;
+using pdk::io::fs::DirIterator;
+using pdk::lang::String;
+
+namespace {
+
+// several getdents64 batches worth of files
+constexpr int FILE_COUNT = 3000;
+
+void create_file(const std::string &path)
+{
+   const int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+   ASSERT_NE(fd, -1);
+   ::close(fd);
+}
+
+class DirIteratorTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   {
+      char path[] = "/tmp/pdk_dir_iterator_XXXXXX";
+      ASSERT_TRUE(::mkdtemp(path) != nullptr);
+      m_root = path;
+      char name[32];
+      for (int i = 0; i < FILE_COUNT; ++i) {
+         std::snprintf(name, sizeof(name), "/file%04d.txt", i);
+         create_file(m_root + name);
+      }
+      create_file(m_root + "/.hidden");
+      ASSERT_EQ(::mkdir((m_root + "/sub").c_str(), 0755), 0);
+      create_file(m_root + "/sub/inner.txt");
+      ASSERT_EQ(::mkdir((m_root + "/.hiddendir").c_str(), 0755), 0);
+      create_file(m_root + "/.hiddendir/secret.txt");
+      ASSERT_EQ(::symlink("file0000.txt", (m_root + "/link").c_str()), 0);
+      ASSERT_EQ(::mkfifo((m_root + "/fifo").c_str(), 0644), 0);
+   }
+
+   void TearDown() override
+   {
+      std::string command = "rm -rf " + m_root;
+      ASSERT_EQ(std::system(command.c_str()), 0);
+   }
+
+   std::set<std::string> list(Dir::Filters filters,
+                              DirIterator::IteratorFlags flags = DirIterator::IteratorFlag::NoIteratorFlags)
+   {
+      std::set<std::string> names;
+      DirIterator iterator(String::fromStdString(m_root), filters, flags);
+      while (iterator.hasNext()) {
+         iterator.next();
+         names.insert(iterator.getFileName().toStdString());
+      }
+      return names;
+   }
+
+   std::set<std::string> files()
+   {
+      std::set<std::string> names;
+      char name[32];
+      for (int i = 0; i < FILE_COUNT; ++i) {
+         std::snprintf(name, sizeof(name), "file%04d.txt", i);
+         names.insert(name);
+      }
+      return names;
+   }
+
+   std::string m_root;
+};
+
+} // anonymous
+
+TEST_F(DirIteratorTest, testFilesOnly)
+{
+   // the link follows its target, the fifo is a system entry
+   std::set<std::string> expected = files();
+   expected.insert("link");
+   ASSERT_EQ(list(Dir::Filter::Files), expected);
+}
+
+TEST_F(DirIteratorTest, testDirsOnly)
+{
+   std::set<std::string> expected{"sub"};
+   ASSERT_EQ(list(Dir::Filters(Dir::Filter::Dirs) | Dir::Filter::NoDotAndDotDot), expected);
+}
+
+TEST_F(DirIteratorTest, testEverything)
+{
+   std::set<std::string> expected = files();
+   expected.insert({".hidden", "sub", ".hiddendir", "link", "fifo"});
+   ASSERT_EQ(list(Dir::Filters(Dir::Filter::AllEntries) | Dir::Filter::Hidden | Dir::Filter::System |
+                  Dir::Filter::NoDotAndDotDot), expected);
+}
+
+TEST_F(DirIteratorTest, testSubdirectories)
+{
+   // hidden directories are not descended into without Hidden
+   std::set<std::string> expected = files();
+   expected.insert({"link", "inner.txt"});
+   ASSERT_EQ(list(Dir::Filter::Files, DirIterator::IteratorFlag::Subdirectories), expected);
+   DirIterator iterator(String::fromStdString(m_root + "/sub"), Dir::Filter::Files);
+   ASSERT_TRUE(iterator.hasNext());
+   ASSERT_EQ(iterator.next().toStdString(), m_root + "/sub/inner.txt");
+   ASSERT_FALSE(iterator.hasNext());
+}
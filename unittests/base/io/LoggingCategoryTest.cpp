@@ -0,0 +1,91 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/io/LoggingCategory.h"
+#include "pdk/base/lang/String.h"
+
+using pdk::io::LoggingCategory;
+using pdk::lang::String;
+using pdk::lang::Latin1String;
+
+PDK_STATIC_LOGGING_CATEGORY(sg_staticCategory, "test.static")
+PDK_STATIC_LOGGING_CATEGORY(sg_warningCategory, "test.static.warning", pdk::MsgType::WarningMsg)
+
+namespace {
+
+static_assert(LoggingCategory::getInitialBits("app") ==
+              (LoggingCategory::DebugBit | LoggingCategory::InfoBit | LoggingCategory::WarningBit |
+               LoggingCategory::CriticalBit), "everything is on by default");
+static_assert(LoggingCategory::getInitialBits("pdk.io") ==
+              (LoggingCategory::InfoBit | LoggingCategory::WarningBit | LoggingCategory::CriticalBit),
+              "pdk categories start without debug");
+static_assert(LoggingCategory::getInitialBits("pdkx") & LoggingCategory::DebugBit, "only pdk and pdk.*");
+static_assert(LoggingCategory::getInitialBits("app", pdk::MsgType::WarningMsg) ==
+              (LoggingCategory::WarningBit | LoggingCategory::CriticalBit), "severity level");
+
+int count_evaluation(int &evaluated)
+{
+   return ++evaluated;
+}
+
+} // anonymous
+
+TEST(LoggingCategoryTest, testStaticCategoryStartsWithDefaultRules)
+{
+   ASSERT_TRUE(sg_staticCategory.isDebugEnabled());
+   ASSERT_TRUE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_staticCategory, DebugBit));
+   ASSERT_FALSE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_warningCategory, DebugBit));
+   ASSERT_FALSE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_warningCategory, InfoBit));
+   ASSERT_TRUE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_warningCategory, WarningBit));
+   ASSERT_TRUE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_warningCategory, CriticalBit));
+}
+
+TEST(LoggingCategoryTest, testStaticCategoryFollowsFilterRules)
+{
+   LoggingCategory::setFilterRules(Latin1String("test.static.debug=false\ntest.static.critical=false"));
+   ASSERT_FALSE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_staticCategory, DebugBit));
+   ASSERT_FALSE(sg_staticCategory.isDebugEnabled());
+   ASSERT_TRUE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_staticCategory, InfoBit));
+   ASSERT_TRUE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_staticCategory, WarningBit));
+   ASSERT_FALSE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_staticCategory, CriticalBit));
+   LoggingCategory::setFilterRules(Latin1String("test.static.*=true"));
+   ASSERT_TRUE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_staticCategory, CriticalBit));
+   ASSERT_TRUE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_warningCategory, DebugBit));
+   ASSERT_TRUE(sg_warningCategory.isDebugEnabled());
+   LoggingCategory::setFilterRules(String());
+   ASSERT_TRUE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_staticCategory, DebugBit));
+   ASSERT_FALSE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_warningCategory, DebugBit));
+}
+
+TEST(LoggingCategoryTest, testSetEnabledUpdatesBits)
+{
+   LoggingCategory &category = const_cast<LoggingCategory &>(sg_staticCategory);
+   category.setEnabled(pdk::MsgType::InfoMsg, false);
+   ASSERT_FALSE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_staticCategory, InfoBit));
+   ASSERT_TRUE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_staticCategory, DebugBit));
+   category.setEnabled(pdk::MsgType::InfoMsg, true);
+   ASSERT_TRUE(PDK_STATIC_LOGGING_CATEGORY_ENABLED(sg_staticCategory, InfoBit));
+}
+
+TEST(LoggingCategoryTest, testDisabledStreamSkipsArguments)
+{
+   int evaluated = 0;
+   LoggingCategory::setFilterRules(Latin1String("test.static.debug=false"));
+   sdebug_stream(sg_staticCategory, "%d", count_evaluation(evaluated));
+   ASSERT_EQ(evaluated, 0);
+   LoggingCategory::setFilterRules(String());
+}
@@ -4716,3 +4716,74 @@ TEST(StringTest, testOperatorSmaller)
     ASSERT_TRUE(Latin1String("b") > Latin1String("a"));
 }
 
+
+namespace {
+
+int folded_compare_sign(const String &lhs, const String &rhs)
+{
+    const int length = std::min(lhs.size(), rhs.size());
+    for (int i = 0; i < length; ++i) {
+        const int diff = int(lhs.at(i).toCaseFolded().unicode()) - int(rhs.at(i).toCaseFolded().unicode());
+        if (diff) {
+            return diff < 0 ? -1 : 1;
+        }
+    }
+    return lhs.size() == rhs.size() ? 0 : (lhs.size() < rhs.size() ? -1 : 1);
+}
+
+int sign(int value)
+{
+    return value < 0 ? -1 : (value > 0 ? 1 : 0);
+}
+
+} // anonymous
+
+TEST(StringTest, testCaseInsensitiveLongText)
+{
+    // long enough for the vector kernels, with the difference at every position
+    const String header(Latin1String("X-Request-Id: abcdef0123456789; Content-Type: text/plain; charset=\xe9t\xe9"));
+    const String upper = header.toUpper();
+    ASSERT_EQ(String::compare(header, upper, pdk::CaseSensitivity::Insensitive), 0);
+    ASSERT_EQ(String::compare(header, Latin1String(upper.toLatin1()), pdk::CaseSensitivity::Insensitive), 0);
+    for (int i = 0; i < header.size(); ++i) {
+        for (char16_t unit : {char16_t('#'), char16_t(0xb5), char16_t(0x3b1), char16_t(0x212a), char16_t(0xd7)}) {
+            String changed = upper;
+            changed[i] = Character(unit);
+            ASSERT_EQ(sign(String::compare(header, changed, pdk::CaseSensitivity::Insensitive)),
+                      folded_compare_sign(header, changed)) << i;
+            ASSERT_EQ(sign(String::compare(changed, header, pdk::CaseSensitivity::Insensitive)),
+                      folded_compare_sign(changed, header)) << i;
+        }
+        ASSERT_EQ(upper.indexOf(header.at(i), 0, pdk::CaseSensitivity::Insensitive),
+                  header.indexOf(header.at(i).toCaseFolded(), 0, pdk::CaseSensitivity::Insensitive));
+    }
+    ASSERT_EQ(upper.indexOf(String(Latin1String("content-type")), 0, pdk::CaseSensitivity::Insensitive), 32);
+    ASSERT_EQ(upper.indexOf(Latin1String("charset=\xc9"), 0, pdk::CaseSensitivity::Insensitive), 58);
+    ASSERT_TRUE(upper.contains(Latin1String("text/plain"), pdk::CaseSensitivity::Insensitive));
+    ASSERT_FALSE(upper.contains(Latin1String("text/html"), pdk::CaseSensitivity::Insensitive));
+    StringMatcher matcher(Latin1String("request-id: ABCDEF"), pdk::CaseSensitivity::Insensitive);
+    ASSERT_EQ(matcher.indexIn(upper), 2);
+}
+
+TEST(StringTest, testCaseInsensitiveOutsideLatin1)
+{
+    // characters outside latin-1 that fold into it
+    String kelvin(Latin1String("0123456789abcdef-0123456789-link"));
+    String plain = kelvin;
+    kelvin[kelvin.size() - 1] = Character(char16_t(0x212a));
+    ASSERT_EQ(String::compare(kelvin, plain, pdk::CaseSensitivity::Insensitive), 0);
+    ASSERT_EQ(String::compare(kelvin, Latin1String("0123456789ABCDEF-0123456789-LINK"),
+                              pdk::CaseSensitivity::Insensitive), 0);
+    ASSERT_EQ(kelvin.indexOf(Character('K'), 0, pdk::CaseSensitivity::Insensitive), kelvin.size() - 1);
+    ASSERT_EQ(kelvin.indexOf(Latin1String("-LINK"), 0, pdk::CaseSensitivity::Insensitive), 27);
+    // the micro sign folds to greek mu, not inside latin-1
+    String micro(Latin1String("0123456789abcdef 5 \xb5m"));
+    String mu = micro;
+    mu[micro.size() - 2] = Character(char16_t(0x39c));
+    ASSERT_EQ(String::compare(micro, mu, pdk::CaseSensitivity::Insensitive), 0);
+    ASSERT_NE(String::compare(micro, Latin1String("0123456789ABCDEF 5 \xb5M"), pdk::CaseSensitivity::Sensitive), 0);
+    ASSERT_EQ(micro.indexOf(Character(char16_t(0x3bc)), 0, pdk::CaseSensitivity::Insensitive), micro.size() - 2);
+    // the multiplication sign is not an upper case letter
+    ASSERT_NE(String::compare(String(Latin1String("0123456789abcdef\xd7")), Latin1String("0123456789abcdef\xf7"),
+                              pdk::CaseSensitivity::Insensitive), 0);
+}
@@ -0,0 +1,55 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/net/HostAddress.h"
+
+using pdk::net::HostAddress;
+using pdk::lang::String;
+using pdk::lang::Latin1String;
+
+TEST(HostAddressTest, testParseIPv4)
+{
+   HostAddress address(Latin1String("192.168.1.20"));
+   ASSERT_EQ(address.getProtocol(), HostAddress::NetworkLayerProtocol::IPv4Protocol);
+   ASSERT_EQ(address.toIPv4Address(), 0xc0a80114u);
+   ASSERT_EQ(address.toString(), Latin1String("192.168.1.20"));
+   ASSERT_FALSE(address.isLoopback());
+   ASSERT_TRUE(HostAddress(HostAddress::SpecialAddress::LocalHost).isLoopback());
+}
+
+TEST(HostAddressTest, testParseIPv6)
+{
+   HostAddress address(Latin1String("::1"));
+   ASSERT_EQ(address.getProtocol(), HostAddress::NetworkLayerProtocol::IPv6Protocol);
+   ASSERT_TRUE(address.isLoopback());
+   ASSERT_EQ(address, HostAddress(HostAddress::SpecialAddress::LocalHostIPv6));
+   ASSERT_EQ(address.toString(), Latin1String("::1"));
+
+   bool ok = false;
+   HostAddress mapped(Latin1String("::ffff:127.0.0.1"));
+   ASSERT_EQ(mapped.toIPv4Address(&ok), 0x7f000001u);
+   ASSERT_TRUE(ok);
+   ASSERT_TRUE(mapped.isLoopback());
+}
+
+TEST(HostAddressTest, testInvalid)
+{
+   HostAddress address;
+   ASSERT_TRUE(address.isNull());
+   ASSERT_FALSE(address.setAddress(Latin1String("not an address")));
+   ASSERT_TRUE(address.isNull());
+   ASSERT_TRUE(address.toString().isEmpty());
+}
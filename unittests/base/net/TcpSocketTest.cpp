@@ -0,0 +1,186 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/net/TcpServer.h"
+#include "pdk/base/net/TcpSocket.h"
+
+#include <memory>
+#include <vector>
+
+using pdk::net::TcpServer;
+using pdk::net::TcpSocket;
+using pdk::net::HostAddress;
+using pdk::ds::ByteArray;
+
+namespace {
+
+// a connected client and the server side of the same connection
+class Connection
+{
+public:
+   bool establish()
+   {
+      if (!m_server.listen(HostAddress::SpecialAddress::LocalHost)) {
+         return false;
+      }
+      m_client.connectToHost(HostAddress::SpecialAddress::LocalHost, m_server.getServerPort());
+      if (!m_client.waitForConnected(5000) || !m_server.waitForNewConnection(5000)) {
+         return false;
+      }
+      m_peer.reset(m_server.nextPendingConnection());
+      return m_peer != nullptr;
+   }
+
+   TcpServer m_server;
+   TcpSocket m_client;
+   std::unique_ptr<TcpSocket> m_peer;
+};
+
+} // anonymous
+
+TEST(TcpSocketTest, testConnectAndEcho)
+{
+   Connection connection;
+   ASSERT_TRUE(connection.establish());
+   TcpSocket &client = connection.m_client;
+   TcpSocket &peer = *connection.m_peer;
+   ASSERT_EQ(client.getState(), TcpSocket::SocketState::ConnectedState);
+   ASSERT_EQ(peer.getState(), TcpSocket::SocketState::ConnectedState);
+   ASSERT_EQ(client.getPeerPort(), connection.m_server.getServerPort());
+   ASSERT_EQ(peer.getPeerPort(), client.getLocalPort());
+   ASSERT_TRUE(client.getPeerAddress().isLoopback());
+
+   ASSERT_EQ(client.write("hello"), 5);
+   ASSERT_EQ(client.bytesToWrite(), 5);
+   ASSERT_TRUE(client.waitForBytesWritten(5000));
+   ASSERT_EQ(client.bytesToWrite(), 0);
+   ASSERT_TRUE(peer.waitForReadyRead(5000));
+   ASSERT_EQ(peer.readAll(), ByteArray("hello"));
+
+   peer.write("world");
+   ASSERT_TRUE(peer.flush());
+   ASSERT_TRUE(client.waitForReadyRead(5000));
+   ASSERT_EQ(client.readAll(), ByteArray("world"));
+}
+
+TEST(TcpSocketTest, testGatherWrite)
+{
+   Connection connection;
+   ASSERT_TRUE(connection.establish());
+   TcpSocket &client = connection.m_client;
+   TcpSocket &peer = *connection.m_peer;
+   // many small writes queue up in several buffer chunks
+   ByteArray expected;
+   for (int i = 0; i < 20000; ++i) {
+      ByteArray line = ByteArray::number(i) + ',';
+      expected += line;
+      client.write(line);
+   }
+   ASSERT_EQ(client.bytesToWrite(), expected.size());
+   ByteArray received;
+   while (received.size() < expected.size()) {
+      if (client.bytesToWrite() > 0) {
+         client.waitForBytesWritten(10);
+      }
+      peer.waitForReadyRead(10);
+      received += peer.readAll();
+   }
+   ASSERT_EQ(received, expected);
+}
+
+TEST(TcpSocketTest, testRemoteClose)
+{
+   Connection connection;
+   ASSERT_TRUE(connection.establish());
+   TcpSocket &client = connection.m_client;
+   TcpSocket &peer = *connection.m_peer;
+   bool disconnected = false;
+   client.setDisconnectedHandler([&disconnected]() {
+      disconnected = true;
+   });
+   peer.write("bye");
+   peer.disconnectFromHost();
+   ASSERT_TRUE(peer.getState() == TcpSocket::SocketState::UnconnectedState ||
+               peer.waitForDisconnected(5000));
+   ASSERT_TRUE(client.waitForDisconnected(5000));
+   ASSERT_TRUE(disconnected);
+   ASSERT_EQ(client.getState(), TcpSocket::SocketState::UnconnectedState);
+   ASSERT_EQ(client.getError(), TcpSocket::SocketError::RemoteHostClosedError);
+   // what arrived before the close is still readable
+   ASSERT_EQ(client.readAll(), ByteArray("bye"));
+}
+
+TEST(TcpSocketTest, testConnectionRefused)
+{
+   pdk::puint16 port;
+   {
+      TcpServer server;
+      ASSERT_TRUE(server.listen(HostAddress::SpecialAddress::LocalHost));
+      port = server.getServerPort();
+   }
+   TcpSocket client;
+   std::vector<TcpSocket::SocketError> errors;
+   client.setErrorHandler([&errors](TcpSocket::SocketError error) {
+      errors.push_back(error);
+   });
+   client.connectToHost(HostAddress::SpecialAddress::LocalHost, port);
+   ASSERT_FALSE(client.waitForConnected(5000));
+   ASSERT_EQ(client.getState(), TcpSocket::SocketState::UnconnectedState);
+   ASSERT_EQ(client.getError(), TcpSocket::SocketError::ConnectionRefusedError);
+   ASSERT_EQ(errors.size(), 1u);
+}
+
+TEST(TcpSocketTest, testAcceptBatch)
+{
+   TcpServer server;
+   ASSERT_TRUE(server.listen(HostAddress::SpecialAddress::LocalHost));
+   server.setMaxPendingConnections(100);
+   std::vector<std::unique_ptr<TcpSocket>> clients;
+   for (int i = 0; i < 10; ++i) {
+      clients.emplace_back(new TcpSocket);
+      clients.back()->connectToHost(HostAddress::SpecialAddress::LocalHost, server.getServerPort());
+      ASSERT_TRUE(clients.back()->waitForConnected(5000));
+   }
+   int accepted = 0;
+   while (accepted < 10 && server.waitForNewConnection(5000)) {
+      while (TcpSocket *socket = server.nextPendingConnection()) {
+         ++accepted;
+         delete socket;
+      }
+   }
+   ASSERT_EQ(accepted, 10);
+}
+
+TEST(TcpSocketTest, testReadBufferSize)
+{
+   Connection connection;
+   ASSERT_TRUE(connection.establish());
+   TcpSocket &client = connection.m_client;
+   TcpSocket &peer = *connection.m_peer;
+   client.setReadBufferSize(4);
+   peer.write("0123456789");
+   ASSERT_TRUE(peer.waitForBytesWritten(5000));
+   ASSERT_TRUE(client.waitForReadyRead(5000));
+   ASSERT_EQ(client.bytesAvailable(), 4);
+   // a full buffer does not take more data
+   ASSERT_FALSE(client.waitForReadyRead(100));
+   ASSERT_EQ(client.read(4), ByteArray("0123"));
+   ByteArray rest;
+   while (rest.size() < 6 && client.waitForReadyRead(5000)) {
+      rest += client.readAll();
+   }
+   ASSERT_EQ(rest, ByteArray("456789"));
+}
@@ -0,0 +1,90 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/net/UdpSocket.h"
+
+#include <vector>
+
+using pdk::net::UdpSocket;
+using pdk::net::NetworkDatagram;
+using pdk::net::HostAddress;
+using pdk::ds::ByteArray;
+
+TEST(UdpSocketTest, testWriteAndReadDatagram)
+{
+   UdpSocket receiver;
+   ASSERT_TRUE(receiver.bind(HostAddress::SpecialAddress::LocalHost));
+   ASSERT_NE(receiver.getLocalPort(), 0);
+   ASSERT_FALSE(receiver.hasPendingDatagrams());
+
+   UdpSocket sender;
+   ASSERT_EQ(sender.writeDatagram(ByteArray("ping"), HostAddress::SpecialAddress::LocalHost,
+                                  receiver.getLocalPort()), 4);
+   ASSERT_TRUE(sender.isValid());
+   ASSERT_TRUE(receiver.waitForReadyRead(5000));
+   ASSERT_TRUE(receiver.hasPendingDatagrams());
+   ASSERT_EQ(receiver.getPendingDatagramSize(), 4);
+
+   char buffer[16];
+   HostAddress address;
+   pdk::puint16 port = 0;
+   ASSERT_EQ(receiver.readDatagram(buffer, sizeof(buffer), &address, &port), 4);
+   ASSERT_EQ(ByteArray(buffer, 4), ByteArray("ping"));
+   ASSERT_EQ(address, HostAddress(HostAddress::SpecialAddress::LocalHost));
+   ASSERT_EQ(port, sender.getLocalPort());
+   ASSERT_FALSE(receiver.hasPendingDatagrams());
+}
+
+TEST(UdpSocketTest, testBatchedDatagrams)
+{
+   UdpSocket receiver;
+   ASSERT_TRUE(receiver.bind(HostAddress::SpecialAddress::LocalHost));
+   UdpSocket sender;
+   ASSERT_TRUE(sender.bind(HostAddress::SpecialAddress::LocalHost));
+
+   // more than one batch worth of datagrams
+   std::vector<NetworkDatagram> outgoing;
+   for (int i = 0; i < 100; ++i) {
+      outgoing.emplace_back(ByteArray::number(i), HostAddress::SpecialAddress::LocalHost,
+                            receiver.getLocalPort());
+   }
+   ASSERT_EQ(sender.writeDatagrams(outgoing), 100);
+
+   std::vector<NetworkDatagram> incoming;
+   std::vector<NetworkDatagram> batch;
+   while (incoming.size() < outgoing.size() && receiver.waitForReadyRead(5000)) {
+      ASSERT_GT(receiver.readDatagrams(batch, 32, 64), 0);
+      incoming.insert(incoming.end(), batch.begin(), batch.end());
+   }
+   ASSERT_EQ(incoming.size(), outgoing.size());
+   for (size_t i = 0; i < incoming.size(); ++i) {
+      ASSERT_EQ(incoming[i].getData(), outgoing[i].getData());
+      ASSERT_EQ(incoming[i].getPort(), sender.getLocalPort());
+   }
+}
+
+TEST(UdpSocketTest, testTruncatedDatagram)
+{
+   UdpSocket receiver;
+   ASSERT_TRUE(receiver.bind(HostAddress::SpecialAddress::LocalHost));
+   UdpSocket sender;
+   sender.writeDatagram(ByteArray("0123456789"), HostAddress::SpecialAddress::LocalHost,
+                        receiver.getLocalPort());
+   ASSERT_TRUE(receiver.waitForReadyRead(5000));
+   std::vector<NetworkDatagram> batch;
+   ASSERT_EQ(receiver.readDatagrams(batch, 8, 4), 1);
+   ASSERT_EQ(batch[0].getData(), ByteArray("0123"));
+}
@@ -0,0 +1,152 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/os/process/Process.h"
+
+#include <cstdlib>
+#include <vector>
+
+using pdk::os::process::Process;
+using pdk::lang::String;
+using pdk::lang::Latin1String;
+using pdk::ds::StringList;
+using pdk::ds::ByteArray;
+
+namespace {
+
+StringList shell_script(const char *script)
+{
+   StringList arguments;
+   arguments.push_back(Latin1String("-c"));
+   arguments.push_back(Latin1String(script));
+   return arguments;
+}
+
+} // anonymous
+
+TEST(ProcessTest, testReadStandardOutput)
+{
+   Process process;
+   process.start(Latin1String("sh"), shell_script("echo hello; echo world >&2"));
+   ASSERT_TRUE(process.waitForStarted());
+   ASSERT_TRUE(process.waitForFinished());
+   ASSERT_EQ(process.readAllStandardOutput(), ByteArray("hello\n"));
+   ASSERT_EQ(process.readAllStandardError(), ByteArray("world\n"));
+   ASSERT_EQ(process.getExitStatus(), Process::ExitStatus::NormalExit);
+   ASSERT_EQ(process.getExitCode(), 0);
+}
+
+TEST(ProcessTest, testExitCode)
+{
+   Process process;
+   process.start(Latin1String("sh"), shell_script("exit 7"));
+   ASSERT_TRUE(process.waitForFinished());
+   ASSERT_EQ(process.getState(), Process::ProcessState::NotRunning);
+   ASSERT_EQ(process.getExitCode(), 7);
+   ASSERT_EQ(Process::execute(Latin1String("sh"), shell_script("exit 3")), 3);
+}
+
+TEST(ProcessTest, testWriteToStandardInput)
+{
+   Process process;
+   process.start(Latin1String("cat"), StringList());
+   ASSERT_TRUE(process.waitForStarted());
+   ByteArray data(100000, 'x');
+   process.write(data);
+   process.closeWriteChannel();
+   ASSERT_TRUE(process.waitForFinished());
+   ASSERT_EQ(process.readAll(), data);
+}
+
+TEST(ProcessTest, testMergedChannels)
+{
+   Process process;
+   process.setProcessChannelMode(Process::ProcessChannelMode::MergedChannels);
+   process.start(Latin1String("sh"), shell_script("echo out; echo err >&2"));
+   ASSERT_TRUE(process.waitForFinished());
+   ASSERT_EQ(process.readAllStandardOutput(), ByteArray("out\nerr\n"));
+   ASSERT_TRUE(process.readAllStandardError().isEmpty());
+}
+
+TEST(ProcessTest, testWorkingDirectory)
+{
+   Process process;
+   process.setWorkingDirectory(Latin1String("/"));
+   process.start(Latin1String("pwd"), StringList());
+   ASSERT_TRUE(process.waitForFinished());
+   ASSERT_EQ(process.readAllStandardOutput(), ByteArray("/\n"));
+}
+
+TEST(ProcessTest, testCrash)
+{
+   Process process;
+   process.start(Latin1String("sh"), shell_script("kill -9 $$"));
+   ASSERT_TRUE(process.waitForFinished());
+   ASSERT_EQ(process.getExitStatus(), Process::ExitStatus::CrashExit);
+   ASSERT_EQ(process.getError(), Process::ProcessError::Crashed);
+}
+
+TEST(ProcessTest, testFailedToStart)
+{
+   Process process;
+   process.start(Latin1String("/nonexistent/program"), StringList());
+   ASSERT_FALSE(process.waitForStarted());
+   ASSERT_EQ(process.getError(), Process::ProcessError::FailedToStart);
+   ASSERT_EQ(process.getState(), Process::ProcessState::NotRunning);
+}
+
+TEST(ProcessTest, testManyChildren)
+{
+   std::vector<Process *> processes;
+   for (int i = 0; i < 64; ++i) {
+      Process *process = new Process;
+      process->start(Latin1String("true"), StringList());
+      processes.push_back(process);
+   }
+   for (Process *process : processes) {
+      ASSERT_TRUE(process->waitForFinished());
+      ASSERT_EQ(process->getExitCode(), 0);
+      delete process;
+   }
+}
+
+TEST(ProcessTest, testManyChildrenWithoutPidfd)
+{
+   // the child reads PDK_PROCESS_NO_PIDFD on its first process, so the
+   // shared SIGCHLD handler has to reap every one of these
+   ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+   ASSERT_EXIT({
+      ::setenv("PDK_PROCESS_NO_PIDFD", "1", 1);
+      Process sleeper;
+      sleeper.start(Latin1String("sleep"), StringList(Latin1String("10")));
+      bool ok = sleeper.waitForStarted();
+      std::vector<Process *> processes;
+      for (int i = 0; i < 64; ++i) {
+         Process *process = new Process;
+         process->start(Latin1String("sh"), shell_script(i % 2 ? "exit 1" : "exit 2"));
+         processes.push_back(process);
+      }
+      for (size_t i = 0; i < processes.size(); ++i) {
+         ok = ok && processes[i]->waitForFinished() && processes[i]->getExitCode() == (i % 2 ? 1 : 2);
+         delete processes[i];
+      }
+      // exits of other children leave it alone
+      ok = ok && sleeper.getState() == Process::ProcessState::Running && !sleeper.waitForFinished(0);
+      sleeper.kill();
+      ok = ok && sleeper.waitForFinished() && sleeper.getExitStatus() == Process::ExitStatus::CrashExit;
+      std::exit(ok ? 0 : 1);
+   }, ::testing::ExitedWithCode(0), "");
+}
@@ -0,0 +1,169 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/os/thread/ThreadPool.h"
+#include "pdk/base/os/thread/Runnable.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using pdk::os::thread::ThreadPool;
+using pdk::os::thread::Runnable;
+
+namespace {
+
+class CountingTask : public Runnable
+{
+public:
+   explicit CountingTask(std::atomic<int> &counter)
+      : m_counter(counter)
+   {}
+   
+   void run() override
+   {
+      m_counter.fetch_add(1);
+   }
+   
+private:
+   std::atomic<int> &m_counter;
+};
+
+class SpawningTask : public Runnable
+{
+public:
+   SpawningTask(ThreadPool &pool, std::atomic<int> &counter, int depth)
+      : m_pool(pool),
+        m_counter(counter),
+        m_depth(depth)
+   {}
+   
+   void run() override
+   {
+      m_counter.fetch_add(1);
+      if (m_depth > 0) {
+         m_pool.start(new SpawningTask(m_pool, m_counter, m_depth - 1));
+         m_pool.start(new SpawningTask(m_pool, m_counter, m_depth - 1));
+      }
+   }
+   
+private:
+   ThreadPool &m_pool;
+   std::atomic<int> &m_counter;
+   int m_depth;
+};
+
+class RecordingTask : public Runnable
+{
+public:
+   RecordingTask(std::mutex &mutex, std::vector<int> &order, int priority)
+      : m_mutex(mutex),
+        m_order(order),
+        m_priority(priority)
+   {}
+   
+   void run() override
+   {
+      std::lock_guard<std::mutex> locker(m_mutex);
+      m_order.push_back(m_priority);
+   }
+   
+private:
+   std::mutex &m_mutex;
+   std::vector<int> &m_order;
+   int m_priority;
+};
+
+class BlockingTask : public Runnable
+{
+public:
+   explicit BlockingTask(std::atomic<bool> &release)
+      : m_release(release)
+   {}
+   
+   void run() override
+   {
+      while (!m_release.load()) {
+         std::this_thread::yield();
+      }
+   }
+   
+private:
+   std::atomic<bool> &m_release;
+};
+
+} // anonymous
+
+TEST(ThreadPoolTest, testWorkStealingDisabledByDefault)
+{
+   ThreadPool pool;
+   ASSERT_FALSE(pool.isWorkStealingEnabled());
+   pool.setWorkStealingEnabled(true);
+   ASSERT_TRUE(pool.isWorkStealingEnabled());
+}
+
+TEST(ThreadPoolTest, testWorkStealingRunsNestedTasks)
+{
+   for (bool workStealing : {false, true}) {
+      ThreadPool pool;
+      pool.setMaxThreadCount(4);
+      pool.setWorkStealingEnabled(workStealing);
+      std::atomic<int> counter(0);
+      for (int i = 0; i < 8; ++i) {
+         pool.start(new SpawningTask(pool, counter, 10));
+      }
+      ASSERT_TRUE(pool.waitForDone());
+      // every seed spawns a full binary tree of depth 10
+      ASSERT_EQ(counter.load(), 8 * ((1 << 11) - 1));
+   }
+}
+
+TEST(ThreadPoolTest, testPriorityOrderWithWorkStealing)
+{
+   ThreadPool pool;
+   pool.setMaxThreadCount(1);
+   pool.setWorkStealingEnabled(true);
+   std::atomic<bool> release(false);
+   std::mutex mutex;
+   std::vector<int> order;
+   // keep the only worker busy until everything is queued
+   pool.start(new BlockingTask(release));
+   pool.start(new RecordingTask(mutex, order, 0), 0);
+   pool.start(new RecordingTask(mutex, order, 5), 5);
+   pool.start(new RecordingTask(mutex, order, 1), 1);
+   pool.start(new RecordingTask(mutex, order, 9), 9);
+   release.store(true);
+   ASSERT_TRUE(pool.waitForDone());
+   ASSERT_EQ(order, (std::vector<int>{9, 5, 1, 0}));
+}
+
+TEST(ThreadPoolTest, testClearDropsQueuedTasks)
+{
+   ThreadPool pool;
+   pool.setMaxThreadCount(1);
+   pool.setWorkStealingEnabled(true);
+   std::atomic<bool> release(false);
+   std::atomic<int> counter(0);
+   pool.start(new BlockingTask(release));
+   for (int i = 0; i < 10; ++i) {
+      pool.start(new CountingTask(counter));
+   }
+   pool.clear();
+   release.store(true);
+   ASSERT_TRUE(pool.waitForDone());
+   ASSERT_EQ(counter.load(), 0);
+}
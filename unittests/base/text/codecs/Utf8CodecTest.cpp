@@ -0,0 +1,227 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/text/codecs/TextCodec.h"
+#include "pdk/base/ds/ByteArray.h"
+#include "pdk/base/lang/String.h"
+
+#include <random>
+#include <vector>
+
+using pdk::ds::ByteArray;
+using pdk::lang::String;
+using pdk::lang::Character;
+using pdk::text::codecs::TextCodec;
+using pdk::text::codecs::TextDecoder;
+
+namespace {
+
+// one character per call the way the scalar loops do it, an error takes
+// the lead byte only and leaves one replacement character
+void decode_one(std::u16string &out, const uchar *&src, const uchar *end)
+{
+   const uchar lead = *src++;
+   if (lead < 0x80) {
+      out += char16_t(lead);
+      return;
+   }
+   int needed = 0;
+   uint minimum = 0;
+   uint ucs4 = 0;
+   if (lead >= 0xc2 && lead < 0xe0) {
+      needed = 2;
+      minimum = 0x80;
+      ucs4 = lead & 0x1f;
+   } else if (lead >= 0xe0 && lead < 0xf0) {
+      needed = 3;
+      minimum = 0x800;
+      ucs4 = lead & 0x0f;
+   } else if (lead >= 0xf0 && lead < 0xf5) {
+      needed = 4;
+      minimum = 0x10000;
+      ucs4 = lead & 0x07;
+   }
+   bool valid = needed && end - src >= needed - 1;
+   for (int i = 0; valid && i < needed - 1; ++i) {
+      valid = (src[i] & 0xc0) == 0x80;
+      ucs4 = (ucs4 << 6) | (src[i] & 0x3f);
+   }
+   if (!valid || ucs4 < minimum || (ucs4 >= 0xd800 && ucs4 < 0xe000) || ucs4 > 0x10ffff) {
+      out += char16_t(Character::ReplacementCharacter);
+      return;
+   }
+   src += needed - 1;
+   if (ucs4 >= 0x10000) {
+      out += Character::getHighSurrogate(ucs4);
+      out += Character::getLowSurrogate(ucs4);
+   } else {
+      out += char16_t(ucs4);
+   }
+}
+
+std::u16string scalar_decode(const ByteArray &bytes)
+{
+   std::u16string out;
+   const uchar *src = reinterpret_cast<const uchar *>(bytes.getConstRawData());
+   const uchar *end = src + bytes.size();
+   while (src < end) {
+      decode_one(out, src, end);
+   }
+   return out;
+}
+
+ByteArray scalar_encode(const std::u16string &text)
+{
+   ByteArray out;
+   for (size_t i = 0; i < text.size(); ++i) {
+      uint unit = text[i];
+      if (unit >= 0xd800 && unit < 0xe000) {
+         if (unit >= 0xdc00 || i + 1 == text.size() || text[i + 1] < 0xdc00 || text[i + 1] >= 0xe000) {
+            out.append('?');
+            continue;
+         }
+         unit = 0x10000 + ((unit - 0xd800) << 10) + (text[++i] - 0xdc00);
+      }
+      if (unit < 0x80) {
+         out.append(char(unit));
+      } else if (unit < 0x800) {
+         out.append(char(0xc0 | (unit >> 6)));
+         out.append(char(0x80 | (unit & 0x3f)));
+      } else if (unit < 0x10000) {
+         out.append(char(0xe0 | (unit >> 12)));
+         out.append(char(0x80 | ((unit >> 6) & 0x3f)));
+         out.append(char(0x80 | (unit & 0x3f)));
+      } else {
+         out.append(char(0xf0 | (unit >> 18)));
+         out.append(char(0x80 | ((unit >> 12) & 0x3f)));
+         out.append(char(0x80 | ((unit >> 6) & 0x3f)));
+         out.append(char(0x80 | (unit & 0x3f)));
+      }
+   }
+   return out;
+}
+
+// cjk, greek and cyrillic, a mix with ascii and a sprinkle of characters
+// outside the bmp, always led by ascii so no bom is involved
+std::u16string random_text(std::mt19937 &random, int kind)
+{
+   std::u16string text(1, u'x');
+   const int length = random() % 300;
+   for (int i = 0; i < length; ++i) {
+      const uint roll = random() % 100;
+      switch (kind) {
+      case 0:
+         text += char16_t(0x4e00 + random() % 0x5000);
+         break;
+      case 1:
+         text += char16_t(0x391 + random() % 0x400);
+         break;
+      case 2:
+         text += char16_t(roll < 30 ? 0x20 + random() % 0x5f
+                                    : roll < 60 ? 0x80 + random() % 0x780 : 0xe000 + random() % 0x2000);
+         break;
+      default:
+         if (roll < 4) {
+            text += char16_t(0xd800 + random() % 0x400);
+            text += char16_t(0xdc00 + random() % 0x400);
+         } else {
+            text += char16_t(roll < 50 ? random() % 0x80 : 0x800 + random() % 0xd000);
+         }
+         break;
+      }
+   }
+   return text;
+}
+
+String to_string(const std::u16string &text)
+{
+   return String::fromUtf16(text.data(), int(text.size()));
+}
+
+} // anonymous
+
+TEST(Utf8CodecTest, testRoundTrip)
+{
+   std::mt19937 random(20261017);
+   TextCodec *codec = TextCodec::codecForName("UTF-8");
+   ASSERT_TRUE(codec != nullptr);
+   for (int i = 0; i < 4000; ++i) {
+      const std::u16string text = random_text(random, i % 4);
+      const ByteArray bytes = scalar_encode(text);
+      ASSERT_EQ(to_string(text).toUtf8(), bytes);
+      ASSERT_EQ(codec->fromUnicode(to_string(text)), bytes);
+      ASSERT_EQ(String::fromUtf8(bytes), to_string(text));
+      ASSERT_EQ(codec->toUnicode(bytes), to_string(text));
+   }
+}
+
+TEST(Utf8CodecTest, testLoneSurrogates)
+{
+   std::mt19937 random(5);
+   for (int i = 0; i < 2000; ++i) {
+      std::u16string text = random_text(random, i % 3);
+      for (int j = 0; j < 3; ++j) {
+         text[random() % text.size()] = char16_t(0xd800 + random() % 0x800);
+      }
+      ASSERT_EQ(to_string(text).toUtf8(), scalar_encode(text));
+   }
+}
+
+TEST(Utf8CodecTest, testInvalidSequences)
+{
+   // overlong forms, encoded surrogates and stray bytes inside long runs of
+   // two and three byte sequences
+   static const char *const invalid[] = {
+      "\xe0\x80\x80", "\xe0\x9f\xbf", "\xed\xa0\x80", "\xed\xbf\xbf", "\xc0\x80", "\xc1\xbf",
+      "\x80", "\xbf", "\xe4\xb8", "\xe4\x41", "\xf0\x9f", "\xf5\x80\x80\x80", "\xff"
+   };
+   const ByteArray cjk("\xe4\xb8\xad\xe6\x96\x87\xe5\xad\x97\xe7\xac\xa6\xe9\x9b\x86\xe5\x90\x88");
+   const ByteArray greek("\xce\xb1\xce\xb2\xce\xb3\xce\xb4\xce\xb5\xce\xb6\xce\xb7\xce\xb8");
+   for (const char *sequence : invalid) {
+      for (int offset = 0; offset < 24; ++offset) {
+         ByteArray bytes = cjk + greek + cjk;
+         bytes.insert(offset, sequence);
+         bytes.prepend('x');
+         ASSERT_EQ(String::fromUtf8(bytes), to_string(scalar_decode(bytes))) << offset;
+      }
+   }
+   std::mt19937 random(42);
+   for (int i = 0; i < 4000; ++i) {
+      ByteArray bytes = scalar_encode(random_text(random, i % 4));
+      // the leading ascii stays, a bom would be skipped
+      for (int j = 0; j < 1 + int(random() % 4) && bytes.size() > 1; ++j) {
+         bytes[1 + int(random() % (bytes.size() - 1))] = char(random() % 256);
+      }
+      ASSERT_EQ(String::fromUtf8(bytes), to_string(scalar_decode(bytes)));
+   }
+}
+
+TEST(Utf8CodecTest, testChunkedDecoder)
+{
+   std::mt19937 random(7);
+   for (int i = 0; i < 1000; ++i) {
+      const std::u16string text = random_text(random, i % 4);
+      const ByteArray bytes = scalar_encode(text);
+      TextDecoder decoder(TextCodec::codecForName("UTF-8"));
+      String decoded;
+      for (int pos = 0; pos < bytes.size(); ) {
+         const int length = std::min<int>(1 + random() % 64, bytes.size() - pos);
+         decoded += decoder.toUnicode(bytes.getConstRawData() + pos, length);
+         pos += length;
+      }
+      ASSERT_EQ(decoded, to_string(text));
+   }
+}
@@ -0,0 +1,105 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/io/fs/File.h"
+#include "pdk/base/io/fs/TemporaryFile.h"
+#include "pdk/base/utils/json/JsonArray.h"
+#include "pdk/base/utils/json/JsonDocument.h"
+#include "pdk/base/utils/json/JsonObject.h"
+
+using pdk::ds::ByteArray;
+using pdk::lang::String;
+using pdk::lang::Latin1String;
+using pdk::io::IoDevice;
+using pdk::io::fs::File;
+using pdk::io::fs::TemporaryFile;
+using pdk::utils::json::JsonArray;
+using pdk::utils::json::JsonDocument;
+using pdk::utils::json::JsonObject;
+
+namespace {
+
+JsonDocument make_catalog()
+{
+   JsonArray products;
+   for (int i = 0; i < 500; ++i) {
+      JsonObject product;
+      product.insert(Latin1String("sku"), String(Latin1String("sku-%1")).arg(i));
+      product.insert(Latin1String("price"), i * 1.5);
+      products.append(product);
+   }
+   JsonObject root;
+   root.insert(Latin1String("products"), products);
+   root.insert(Latin1String("version"), 3);
+   return JsonDocument(root);
+}
+
+void write_file(TemporaryFile &file, const ByteArray &data)
+{
+   ASSERT_TRUE(file.open());
+   ASSERT_EQ(file.write(data), data.size());
+   file.close();
+}
+
+} // anonymous
+
+TEST(JsonDocumentTest, testFromMappedFile)
+{
+   const JsonDocument catalog = make_catalog();
+   const ByteArray binary = catalog.toBinaryData();
+   TemporaryFile file;
+   write_file(file, binary);
+   JsonDocument document = JsonDocument::fromMappedFile(file.getFileName());
+   ASSERT_FALSE(document.isNull());
+   ASSERT_EQ(document, catalog);
+   ASSERT_EQ(document[Latin1String("version")].toInt(), 3);
+   ASSERT_EQ(document[Latin1String("products")].toArray().at(42).toObject()
+             .getValue(Latin1String("sku")).toString(), String(Latin1String("sku-42")));
+   // values read from the mapping stay valid after the document is gone
+   const JsonObject product = document[Latin1String("products")].toArray().at(7).toObject();
+   document = JsonDocument();
+   ASSERT_EQ(product.getValue(Latin1String("price")).toDouble(), 10.5);
+}
+
+TEST(JsonDocumentTest, testMappedFileIsNotWritten)
+{
+   const ByteArray binary = make_catalog().toBinaryData();
+   TemporaryFile file;
+   write_file(file, binary);
+   {
+      JsonDocument document = JsonDocument::fromMappedFile(file.getFileName());
+      JsonObject root = document.getObject();
+      root.remove(Latin1String("version"));
+      root.insert(Latin1String("changed"), true);
+      document.setObject(root);
+      ASSERT_TRUE(document[Latin1String("changed")].toBool());
+   }
+   File check(file.getFileName());
+   ASSERT_TRUE(check.open(IoDevice::OpenMode::ReadOnly));
+   ASSERT_EQ(check.readAll(), binary);
+}
+
+TEST(JsonDocumentTest, testInvalidMappedFile)
+{
+   ASSERT_TRUE(JsonDocument::fromMappedFile(Latin1String("/nonexistent/catalog.bjson")).isNull());
+   TemporaryFile text;
+   write_file(text, ByteArray("{\"not\": \"binary json\"}"));
+   ASSERT_TRUE(JsonDocument::fromMappedFile(text.getFileName()).isNull());
+   ByteArray binary = make_catalog().toBinaryData();
+   TemporaryFile truncated;
+   write_file(truncated, binary.left(binary.size() / 2));
+   ASSERT_TRUE(JsonDocument::fromMappedFile(truncated.getFileName()).isNull());
+}
@@ -0,0 +1,149 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/utils/json/JsonArray.h"
+#include "pdk/base/utils/json/JsonDocument.h"
+#include "pdk/base/utils/json/JsonObject.h"
+#include "pdk/base/utils/json/JsonValue.h"
+
+using pdk::ds::ByteArray;
+using pdk::lang::String;
+using pdk::lang::Latin1String;
+using pdk::utils::json::JsonArray;
+using pdk::utils::json::JsonDocument;
+using pdk::utils::json::JsonObject;
+using pdk::utils::json::JsonParseError;
+using pdk::utils::json::JsonValue;
+
+namespace {
+
+JsonValue parse_single(const ByteArray &json)
+{
+   JsonParseError error;
+   JsonDocument document = JsonDocument::fromJson(json, &error);
+   EXPECT_EQ(error.m_error, JsonParseError::ParseError::NoError) << json.getConstRawData();
+   return document.getArray().at(0);
+}
+
+ByteArray make_ascii(int length)
+{
+   ByteArray text;
+   for (int i = 0; i < length; ++i) {
+      text.append(static_cast<char>('a' + i % 26));
+   }
+   return text;
+}
+
+} // anonymous
+
+// the scanner works on blocks of 16 and 32 bytes, every special character
+// is moved across the block boundaries
+TEST(JsonParserTest, testEscapeAtEveryPosition)
+{
+   for (int length = 1; length < 80; ++length) {
+      for (int at = 0; at < length; ++at) {
+         const ByteArray text = make_ascii(length);
+         ByteArray json("[\"");
+         json.append(text.left(at));
+         json.append("\\n\\\"");
+         json.append(text.mid(at));
+         json.append("\"]");
+         const String expected = String::fromLatin1(text.left(at)) + String(Latin1String("\n\"")) +
+               String::fromLatin1(text.mid(at));
+         ASSERT_EQ(parse_single(json).toString(), expected);
+      }
+   }
+}
+
+TEST(JsonParserTest, testNonAsciiAtEveryPosition)
+{
+   // a latin1 and a utf-16 only character
+   for (const char *utf8 : {"\xc3\xa9", "\xe2\x82\xac"}) {
+      for (int length = 1; length < 70; ++length) {
+         for (int at = 0; at <= length; at += 3) {
+            const ByteArray text = make_ascii(length);
+            ByteArray json("[\"");
+            json.append(text.left(at));
+            json.append(utf8);
+            json.append(text.mid(at));
+            json.append("\"]");
+            const String expected = String::fromLatin1(text.left(at)) + String::fromUtf8(utf8) +
+                  String::fromLatin1(text.mid(at));
+            ASSERT_EQ(parse_single(json).toString(), expected);
+         }
+      }
+   }
+}
+
+TEST(JsonParserTest, testLongStrings)
+{
+   // on both sides of the 32k limit of latin1 strings
+   for (int length : {0x7ffe, 0x7fff, 0x8000, 0x8001, 100000}) {
+      const ByteArray text = make_ascii(length);
+      const String expected = String::fromLatin1(text);
+      ASSERT_EQ(parse_single("[\"" + text + "\"]").toString(), expected);
+      ASSERT_EQ(parse_single("[\"" + text + "\xc3\xa9\"]").toString(), expected + String::fromUtf8("\xc3\xa9"));
+   }
+}
+
+TEST(JsonParserTest, testWhitespaceRuns)
+{
+   const char whitespace[] = " \t\r\n";
+   for (int length = 0; length < 70; ++length) {
+      ByteArray space;
+      for (int i = 0; i < length; ++i) {
+         space.append(whitespace[i % 4]);
+      }
+      const ByteArray json = space + "{" + space + "\"key\"" + space + ":" + space + "[" + space + "1" + space +
+            "," + space + "true" + space + "]" + space + "}" + space;
+      JsonParseError error;
+      const JsonObject object = JsonDocument::fromJson(json, &error).getObject();
+      ASSERT_EQ(error.m_error, JsonParseError::ParseError::NoError);
+      const JsonArray array = object.getValue(Latin1String("key")).toArray();
+      ASSERT_EQ(array.getSize(), 2);
+      ASSERT_EQ(array.at(0).toInt(), 1);
+      ASSERT_TRUE(array.at(1).toBool());
+   }
+}
+
+TEST(JsonParserTest, testNumbers)
+{
+   ASSERT_EQ(parse_single("[0]").toInt(), 0);
+   ASSERT_EQ(parse_single("[-0]").toInt(), 0);
+   ASSERT_EQ(parse_single("[42]").toInt(), 42);
+   ASSERT_EQ(parse_single("[-17]").toInt(), -17);
+   ASSERT_EQ(parse_single("[33554431]").toInt(), 33554431);
+   ASSERT_EQ(parse_single("[-33554431]").toInt(), -33554431);
+   // out of the inline range, stored as a double
+   ASSERT_EQ(parse_single("[33554432]").toDouble(), 33554432.0);
+   ASSERT_EQ(parse_single("[999999999]").toDouble(), 999999999.0);
+   ASSERT_EQ(parse_single("[1234567890123]").toDouble(), 1234567890123.0);
+   ASSERT_EQ(parse_single("[2.5]").toDouble(), 2.5);
+   ASSERT_EQ(parse_single("[-1e3]").toDouble(), -1000.0);
+
+   JsonParseError error;
+   JsonDocument::fromJson("[-]", &error);
+   ASSERT_EQ(error.m_error, JsonParseError::ParseError::IllegalNumber);
+}
+
+TEST(JsonParserTest, testUnterminatedString)
+{
+   for (int length = 0; length < 40; ++length) {
+      JsonParseError error;
+      JsonDocument::fromJson("[\"" + make_ascii(length), &error);
+      ASSERT_EQ(error.m_error, JsonParseError::ParseError::UnterminatedString);
+   }
+}
@@ -0,0 +1,118 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/utils/json/JsonArray.h"
+#include "pdk/base/utils/json/JsonDocument.h"
+#include "pdk/base/utils/json/JsonObject.h"
+#include "pdk/base/utils/json/JsonPath.h"
+
+using pdk::ds::ByteArray;
+using pdk::lang::String;
+using pdk::lang::Latin1String;
+using pdk::utils::json::JsonArray;
+using pdk::utils::json::JsonDocument;
+using pdk::utils::json::JsonObject;
+using pdk::utils::json::JsonPath;
+using pdk::utils::json::JsonValue;
+
+namespace {
+
+JsonDocument parse(const char *json)
+{
+   return JsonDocument::fromJson(ByteArray(json));
+}
+
+} // anonymous
+
+TEST(JsonPathTest, testParse)
+{
+   ASSERT_TRUE(JsonPath().isValid());
+   ASSERT_EQ(JsonPath().getSize(), 0);
+   JsonPath path(Latin1String("/a/b~1c/~0d/"));
+   ASSERT_TRUE(path.isValid());
+   ASSERT_EQ(path.getSize(), 4);
+   ASSERT_EQ(path.toString(), Latin1String("/a/b~1c/~0d/"));
+   ASSERT_FALSE(JsonPath(Latin1String("a/b")).isValid());
+   ASSERT_FALSE(JsonPath(Latin1String("/a~2")).isValid());
+   ASSERT_FALSE(JsonPath(Latin1String("/a~")).isValid());
+}
+
+TEST(JsonPathTest, testEvaluate)
+{
+   JsonDocument doc = parse("{\"a\": {\"b/c\": [10, {\"~d\": true}, 30]}, \"\": 1, \"7\": \"seven\"}");
+   ASSERT_EQ(JsonPath(Latin1String("/a/b~1c/0")).evaluate(doc).toInt(), 10);
+   ASSERT_TRUE(JsonPath(Latin1String("/a/b~1c/1/~0d")).evaluate(doc).toBool());
+   ASSERT_EQ(doc.getValue(JsonPath(Latin1String("/"))).toInt(), 1);
+   ASSERT_EQ(doc.getValue(JsonPath(Latin1String("/7"))).toString(), Latin1String("seven"));
+   ASSERT_TRUE(JsonPath().evaluate(doc).isObject());
+   ASSERT_TRUE(JsonPath(Latin1String("/a/b~1c")).evaluate(doc).isArray());
+   // a missing key, an index out of range, a leading zero and a step into a scalar
+   ASSERT_TRUE(JsonPath(Latin1String("/x")).evaluate(doc).isUndefined());
+   ASSERT_TRUE(JsonPath(Latin1String("/a/b~1c/3")).evaluate(doc).isUndefined());
+   ASSERT_TRUE(JsonPath(Latin1String("/a/b~1c/01")).evaluate(doc).isUndefined());
+   ASSERT_TRUE(JsonPath(Latin1String("/a/b~1c/-")).evaluate(doc).isUndefined());
+   ASSERT_TRUE(JsonPath(Latin1String("/7/x")).evaluate(doc).isUndefined());
+   ASSERT_TRUE(JsonPath(Latin1String("/a")).evaluate(JsonDocument()).isUndefined());
+
+   JsonObject inner = doc.getObject().getValue(Latin1String("a")).toObject();
+   ASSERT_EQ(inner.getValue(JsonPath(Latin1String("/b~1c/2"))).toInt(), 30);
+   JsonValue array = inner.getValue(Latin1String("b/c"));
+   ASSERT_EQ(JsonPath(Latin1String("/2")).evaluate(array).toInt(), 30);
+   ASSERT_EQ(JsonPath(Latin1String("/2")).evaluate(array.toArray()).toInt(), 30);
+}
+
+TEST(JsonPathTest, testShapeHint)
+{
+   JsonPath path(Latin1String("/user/name"));
+   JsonDocument first = parse("{\"id\": 1, \"user\": {\"age\": 3, \"name\": \"a\"}}");
+   JsonDocument second = parse("{\"id\": 2, \"user\": {\"age\": 4, \"name\": \"b\"}}");
+   // keys at other positions must not be confused with the remembered ones
+   JsonDocument other = parse("{\"user\": {\"name\": \"c\", \"zone\": 5}}");
+   ASSERT_EQ(path.evaluate(first).toString(), Latin1String("a"));
+   ASSERT_EQ(path.evaluate(second).toString(), Latin1String("b"));
+   ASSERT_EQ(path.evaluate(other).toString(), Latin1String("c"));
+   ASSERT_EQ(path.evaluate(first).toString(), Latin1String("a"));
+   JsonPath copy = path;
+   ASSERT_EQ(copy.evaluate(second).toString(), Latin1String("b"));
+}
+
+TEST(JsonPathTest, testLookupIndex)
+{
+   JsonObject object;
+   for (int i = 0; i < 200; ++i) {
+      object.insert(String(Latin1String("key%1")).arg(i), i);
+   }
+   JsonDocument doc(object);
+   doc.enableLookupIndex(16);
+   JsonObject root = doc.getObject();
+   for (int i = 0; i < 200; ++i) {
+      const String key = String(Latin1String("key%1")).arg(i);
+      ASSERT_EQ(root.getValue(key).toInt(), i);
+      ASSERT_TRUE(root.contains(key));
+   }
+   ASSERT_TRUE(root.getValue(Latin1String("key200")).isUndefined());
+   ASSERT_FALSE(root.contains(Latin1String("missing")));
+
+   // changing the object must not leave stale positions behind
+   doc = JsonDocument();
+   root.remove(Latin1String("key0"));
+   root.insert(Latin1String("aaa"), -1);
+   ASSERT_EQ(root.getValue(Latin1String("aaa")).toInt(), -1);
+   ASSERT_TRUE(root.getValue(Latin1String("key0")).isUndefined());
+   for (int i = 1; i < 200; ++i) {
+      ASSERT_EQ(root.getValue(String(Latin1String("key%1")).arg(i)).toInt(), i);
+   }
+}
@@ -0,0 +1,190 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/io/Buffer.h"
+#include "pdk/base/utils/json/JsonArray.h"
+#include "pdk/base/utils/json/JsonDocument.h"
+#include "pdk/base/utils/json/JsonObject.h"
+#include "pdk/base/utils/json/JsonReader.h"
+
+using pdk::ds::ByteArray;
+using pdk::lang::String;
+using pdk::lang::Latin1String;
+using pdk::io::Buffer;
+using pdk::io::IoDevice;
+using pdk::utils::json::JsonArray;
+using pdk::utils::json::JsonDocument;
+using pdk::utils::json::JsonObject;
+using pdk::utils::json::JsonParseError;
+using pdk::utils::json::JsonReader;
+using pdk::utils::json::JsonValue;
+
+using TokenType = JsonReader::TokenType;
+
+namespace {
+
+String value_to_string(const JsonValue &value)
+{
+   switch (value.getType()) {
+   case JsonValue::Type::Null:
+      return String(Latin1String("null"));
+   case JsonValue::Type::Bool:
+      return String(Latin1String(value.toBool() ? "true" : "false"));
+   case JsonValue::Type::Double:
+      return String::number(value.toDouble());
+   case JsonValue::Type::String:
+      return String(Latin1String("'")) + value.toString() + String(Latin1String("'"));
+   default:
+      return String(Latin1String("?"));
+   }
+}
+
+// the tokens of the input as a compact string
+String read_tokens(const ByteArray &json, int chunkSize, JsonParseError::ParseError *error = nullptr)
+{
+   ByteArray data(json);
+   Buffer buffer(&data);
+   EXPECT_TRUE(buffer.open(IoDevice::OpenMode::ReadOnly));
+   JsonReader reader(&buffer, chunkSize);
+   String result;
+   while (true) {
+      switch (reader.readNext()) {
+      case TokenType::BeginObject:
+         result.append(Latin1String("{"));
+         break;
+      case TokenType::EndObject:
+         result.append(Latin1String("}"));
+         break;
+      case TokenType::BeginArray:
+         result.append(Latin1String("["));
+         break;
+      case TokenType::EndArray:
+         result.append(Latin1String("]"));
+         break;
+      case TokenType::Key:
+         result.append(reader.getKey());
+         result.append(Latin1String(":"));
+         break;
+      case TokenType::Value:
+         result.append(value_to_string(reader.getValue()));
+         result.append(Latin1String(" "));
+         break;
+      default:
+         if (error) {
+            *error = reader.getError();
+         }
+         return result;
+      }
+   }
+}
+
+} // anonymous
+
+TEST(JsonReaderTest, testTokensAcrossChunks)
+{
+   const ByteArray json("\xef\xbb\xbf {\"name\" : \"caf\xc3\xa9 \\\"quoted\\\" \\u20ac\", \"list\": "
+                        "[1, -2.5e1, true, false, null, []], \"nested\": {\"empty\": {}}}");
+   const String expected = String::fromUtf8("{name:'caf\xc3\xa9 \"quoted\" \xe2\x82\xac' list:[1 -25 true false null []]"
+                                            "nested:{empty:{}}}");
+   // every token gets split at every possible place by the small chunks
+   for (int chunkSize : {1, 2, 3, 7, 16, 64, JsonReader::DefaultChunkSize}) {
+      JsonParseError::ParseError error = JsonParseError::ParseError::GarbageAtEnd;
+      ASSERT_EQ(read_tokens(json, chunkSize, &error), expected) << chunkSize;
+      ASSERT_EQ(error, JsonParseError::ParseError::NoError);
+   }
+}
+
+TEST(JsonReaderTest, testJsonLines)
+{
+   ByteArray lines;
+   for (int i = 0; i < 1000; ++i) {
+      lines.append("{\"id\": ");
+      lines.append(ByteArray::number(i));
+      lines.append(", \"payload\": \"");
+      lines.append(ByteArray(i % 97, 'x'));
+      lines.append("\", \"tags\": [\"a\", \"b\"]}\n");
+   }
+   Buffer buffer(&lines);
+   ASSERT_TRUE(buffer.open(IoDevice::OpenMode::ReadOnly));
+   JsonReader reader(&buffer, 100);
+   int records = 0;
+   pdk::pint64 idSum = 0;
+   while (reader.readNext() == TokenType::BeginObject) {
+      const JsonObject record = reader.readCurrentValue().toObject();
+      ASSERT_EQ(record.getValue(Latin1String("payload")).toString().size(), records % 97);
+      ASSERT_EQ(record.getValue(Latin1String("tags")).toArray().getSize(), 2);
+      idSum += record.getValue(Latin1String("id")).toInt();
+      ++records;
+      ASSERT_EQ(reader.getDepth(), 0);
+   }
+   ASSERT_EQ(reader.getTokenType(), TokenType::EndOfInput);
+   ASSERT_FALSE(reader.hasError());
+   ASSERT_EQ(records, 1000);
+   ASSERT_EQ(idSum, 999 * 1000 / 2);
+}
+
+TEST(JsonReaderTest, testSkipContainer)
+{
+   ByteArray json("{\"skip\": {\"a\": [1, {\"b\": \"]}\"}], \"c\": {}}, \"keep\": 42}");
+   Buffer buffer(&json);
+   ASSERT_TRUE(buffer.open(IoDevice::OpenMode::ReadOnly));
+   JsonReader reader(&buffer, 5);
+   ASSERT_EQ(reader.readNext(), TokenType::BeginObject);
+   ASSERT_EQ(reader.readNext(), TokenType::Key);
+   ASSERT_EQ(reader.getKey(), String(Latin1String("skip")));
+   ASSERT_EQ(reader.readNext(), TokenType::BeginObject);
+   ASSERT_TRUE(reader.skipCurrentContainer());
+   ASSERT_EQ(reader.getTokenType(), TokenType::EndObject);
+   ASSERT_EQ(reader.getDepth(), 1);
+   ASSERT_EQ(reader.readNext(), TokenType::Key);
+   ASSERT_EQ(reader.getKey(), String(Latin1String("keep")));
+   ASSERT_EQ(reader.readNext(), TokenType::Value);
+   ASSERT_EQ(reader.getValue().toInt(), 42);
+   ASSERT_EQ(reader.readNext(), TokenType::EndObject);
+   ASSERT_EQ(reader.readNext(), TokenType::EndOfInput);
+}
+
+TEST(JsonReaderTest, testErrors)
+{
+   using ParseError = JsonParseError::ParseError;
+   const struct {
+      const char *json;
+      ParseError error;
+   } cases[] = {
+      {"{\"a\" 1}", ParseError::MissingNameSeparator},
+      {"{\"a\": 1,}", ParseError::MissingObject},
+      {"{\"a\": 1", ParseError::UnterminatedObject},
+      {"[1 2]", ParseError::MissingValueSeparator},
+      {"[1, 2", ParseError::UnterminatedArray},
+      {"[\"abc", ParseError::UnterminatedString},
+      {"[\"\\u12g4\"]", ParseError::IllegalEscapeSequence},
+      {"[\"\xc3\"]", ParseError::IllegalUTF8String},
+      {"[1.2.3]", ParseError::IllegalNumber},
+      {"[tru]", ParseError::IllegalValue},
+      {"[}", ParseError::IllegalValue}
+   };
+   for (const auto &item : cases) {
+      for (int chunkSize : {1, 4, JsonReader::DefaultChunkSize}) {
+         JsonParseError::ParseError error = ParseError::NoError;
+         read_tokens(ByteArray(item.json), chunkSize, &error);
+         ASSERT_EQ(error, item.error) << item.json << " " << chunkSize;
+      }
+   }
+   ByteArray deep(2000, '[');
+   JsonParseError::ParseError error = ParseError::NoError;
+   read_tokens(deep, 64, &error);
+   ASSERT_EQ(error, ParseError::DeepNesting);
+}
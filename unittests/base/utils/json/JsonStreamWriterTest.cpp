@@ -0,0 +1,139 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/io/Buffer.h"
+#include "pdk/base/utils/json/JsonArray.h"
+#include "pdk/base/utils/json/JsonDocument.h"
+#include "pdk/base/utils/json/JsonObject.h"
+#include "pdk/base/utils/json/JsonStreamWriter.h"
+
+using pdk::ds::ByteArray;
+using pdk::lang::String;
+using pdk::lang::Latin1String;
+using pdk::io::Buffer;
+using pdk::io::IoDevice;
+using pdk::utils::json::JsonArray;
+using pdk::utils::json::JsonDocument;
+using pdk::utils::json::JsonObject;
+using pdk::utils::json::JsonStreamWriter;
+using pdk::utils::json::JsonValue;
+
+namespace {
+
+JsonObject make_object()
+{
+   JsonObject nested;
+   nested.insert(Latin1String("empty array"), JsonArray());
+   nested.insert(Latin1String("empty object"), JsonObject());
+   JsonArray list;
+   list.append(1);
+   list.append(-2.5);
+   list.append(1e100);
+   list.append(true);
+   list.append(JsonValue());
+   list.append(String::fromUtf8("tab\t quote\" back\\slash \xe2\x82\xac \x01"));
+   list.append(nested);
+   JsonObject object;
+   object.insert(Latin1String("list"), list);
+   object.insert(Latin1String("name"), Latin1String("value"));
+   object.insert(String::fromUtf8("k\xc3\xa9y\n"), false);
+   return object;
+}
+
+ByteArray stream_value(const JsonValue &value, JsonDocument::JsonFormat format, int bufferSize)
+{
+   ByteArray data;
+   Buffer buffer(&data);
+   EXPECT_TRUE(buffer.open(IoDevice::OpenMode::WriteOnly));
+   {
+      JsonStreamWriter writer(&buffer, format, bufferSize);
+      writer.writeValue(value);
+      EXPECT_EQ(writer.getDepth(), 0);
+      EXPECT_FALSE(writer.hasError());
+   }
+   return data;
+}
+
+} // anonymous
+
+TEST(JsonStreamWriterTest, testSameAsDocument)
+{
+   const JsonObject object = make_object();
+   JsonArray array;
+   array.append(object);
+   array.append(Latin1String("last"));
+   for (JsonDocument::JsonFormat format : {JsonDocument::JsonFormat::Compact, JsonDocument::JsonFormat::Indented}) {
+      for (int bufferSize : {1, 16, JsonStreamWriter::DefaultBufferSize}) {
+         ASSERT_EQ(stream_value(object, format, bufferSize), JsonDocument(object).toJson(format));
+         ASSERT_EQ(stream_value(array, format, bufferSize), JsonDocument(array).toJson(format));
+      }
+   }
+}
+
+TEST(JsonStreamWriterTest, testPushApi)
+{
+   ByteArray data;
+   Buffer buffer(&data);
+   ASSERT_TRUE(buffer.open(IoDevice::OpenMode::WriteOnly));
+   JsonStreamWriter writer(&buffer);
+   writer.beginObject();
+   writer.writeKey(Latin1String("id"));
+   writer.writeNumber(pdk::pint64(9007199254740993LL));
+   writer.writeKey(Latin1String("items"));
+   writer.beginArray();
+   for (int i = 0; i < 3; ++i) {
+      writer.writeNumber(i);
+   }
+   writer.writeString(Latin1String("a\"b"));
+   writer.writeBool(true);
+   writer.writeNull();
+   writer.writeNumber(0.5);
+   writer.endArray();
+   writer.endObject();
+   ASSERT_EQ(writer.getDepth(), 0);
+   // nothing reaches the device before the buffer fills up or is flushed
+   ASSERT_TRUE(data.isEmpty());
+   ASSERT_TRUE(writer.flush());
+   ASSERT_EQ(data, ByteArray("{\"id\":9007199254740993,\"items\":[0,1,2,\"a\\\"b\",true,null,0.5]}"));
+}
+
+TEST(JsonStreamWriterTest, testJsonLines)
+{
+   ByteArray data;
+   Buffer buffer(&data);
+   ASSERT_TRUE(buffer.open(IoDevice::OpenMode::WriteOnly));
+   {
+      JsonStreamWriter writer(&buffer, JsonDocument::JsonFormat::Compact, 8);
+      for (int i = 0; i < 3; ++i) {
+         writer.beginObject();
+         writer.writeKey(Latin1String("n"));
+         writer.writeNumber(i);
+         writer.endObject();
+      }
+   }
+   ASSERT_EQ(data, ByteArray("{\"n\":0}\n{\"n\":1}\n{\"n\":2}"));
+}
+
+TEST(JsonStreamWriterTest, testDeviceError)
+{
+   ByteArray data;
+   Buffer buffer(&data);
+   ASSERT_TRUE(buffer.open(IoDevice::OpenMode::ReadOnly));
+   JsonStreamWriter writer(&buffer);
+   writer.writeString(Latin1String("lost"));
+   ASSERT_FALSE(writer.flush());
+   ASSERT_TRUE(writer.hasError());
+}
@@ -0,0 +1,317 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/global/Logging.h"
+#include "pdk/base/lang/String.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(PDK_OS_UNIX)
+#include <unistd.h>
+#ifdef PDK_OS_LINUX
+#include <sys/syscall.h>
+#endif
+
+using pdk::MessageLogContext;
+using pdk::MessageLogger;
+using pdk::LogOverflowPolicy;
+using pdk::lang::String;
+
+namespace {
+
+constexpr int THREAD_COUNT = 4;
+constexpr int MESSAGE_COUNT = 5000;
+
+std::vector<std::string> read_lines(FILE *file)
+{
+   std::vector<std::string> lines;
+   char line[512];
+   std::rewind(file);
+   while (std::fgets(line, sizeof(line), file)) {
+      lines.push_back(line);
+   }
+   return lines;
+}
+
+// stderr goes to a temporary file while the writer runs
+class StderrCapture
+{
+public:
+   StderrCapture()
+      : m_file(std::tmpfile()),
+        m_saved(::dup(STDERR_FILENO))
+   {
+      ::dup2(::fileno(m_file), STDERR_FILENO);
+   }
+   
+   ~StderrCapture()
+   {
+      restore();
+      std::fclose(m_file);
+   }
+   
+   void restore()
+   {
+      if (m_saved != -1) {
+         ::dup2(m_saved, STDERR_FILENO);
+         ::close(m_saved);
+         m_saved = -1;
+      }
+   }
+   
+   std::vector<std::string> getLines()
+   {
+      return read_lines(m_file);
+   }
+   
+private:
+   FILE *m_file;
+   int m_saved;
+};
+
+void log_from_threads()
+{
+   std::vector<std::thread> threads;
+   for (int t = 0; t < THREAD_COUNT; ++t) {
+      threads.emplace_back([t]() {
+         MessageLogContext context;
+         for (int i = 0; i < MESSAGE_COUNT; ++i) {
+            pdk::message_output(pdk::MsgType::WarningMsg, context,
+                                String::asprintf("thread %d message %d", t, i));
+         }
+      });
+   }
+   for (std::thread &thread : threads) {
+      thread.join();
+   }
+}
+
+} // anonymous
+
+TEST(AsyncLoggingTest, testBlockKeepsEveryMessageInOrder)
+{
+   ::setenv("PDK_LOGGING_TO_CONSOLE", "1", 1);
+   StderrCapture capture;
+   ASSERT_TRUE(pdk::enable_async_logging(LogOverflowPolicy::Block, 4096));
+   log_from_threads();
+   pdk::disable_async_logging();
+   capture.restore();
+   std::map<int, int> last;
+   int count = 0;
+   for (const std::string &line : capture.getLines()) {
+      int thread = -1;
+      int message = -1;
+      ASSERT_EQ(std::sscanf(std::strstr(line.c_str(), "thread"), "thread %d message %d", &thread, &message), 2);
+      // the messages of one thread keep their order
+      ASSERT_EQ(message, last.count(thread) ? last[thread] + 1 : 0);
+      last[thread] = message;
+      ++count;
+   }
+   ASSERT_EQ(count, THREAD_COUNT * MESSAGE_COUNT);
+}
+
+TEST(AsyncLoggingTest, testCountReportsDroppedMessages)
+{
+   ::setenv("PDK_LOGGING_TO_CONSOLE", "1", 1);
+   StderrCapture capture;
+   const pdk::puint64 droppedBefore = pdk::get_dropped_log_message_count();
+   ASSERT_TRUE(pdk::enable_async_logging(LogOverflowPolicy::Count, 4096));
+   log_from_threads();
+   pdk::flush_async_logging();
+   pdk::disable_async_logging();
+   capture.restore();
+   const pdk::puint64 dropped = pdk::get_dropped_log_message_count() - droppedBefore;
+   pdk::puint64 written = 0;
+   pdk::puint64 reported = 0;
+   for (const std::string &line : capture.getLines()) {
+      unsigned long long lost = 0;
+      if (std::sscanf(line.c_str(), "pdk: %llu log messages dropped", &lost) == 1) {
+         reported += lost;
+      } else {
+         ++written;
+      }
+   }
+   ASSERT_EQ(reported, dropped);
+   ASSERT_EQ(written + dropped, pdk::puint64(THREAD_COUNT * MESSAGE_COUNT));
+}
+
+TEST(AsyncLoggingTest, testStructuredTextMatchesFormatted)
+{
+   ::setenv("PDK_LOGGING_TO_CONSOLE", "1", 1);
+   StderrCapture capture;
+   ASSERT_TRUE(pdk::enable_structured_logging());
+   std::vector<std::thread> threads;
+   for (int t = 0; t < THREAD_COUNT; ++t) {
+      threads.emplace_back([t]() {
+         for (int i = 0; i < MESSAGE_COUNT; ++i) {
+            MessageLogger(__FILE__, __LINE__, PDK_FUNC_INFO).warning("thread %d message %d %5.2f|%-4s|%x %lld %%",
+                                                                     t, i, i / 8.0, "ab", i, -1LL * i);
+         }
+      });
+   }
+   for (std::thread &thread : threads) {
+      thread.join();
+   }
+   pdk::disable_async_logging();
+   capture.restore();
+   std::map<int, int> last;
+   int count = 0;
+   for (const std::string &line : capture.getLines()) {
+      int thread = -1;
+      int message = -1;
+      ASSERT_EQ(std::sscanf(line.c_str(), "thread %d message %d", &thread, &message), 2);
+      const String expected = String::asprintf("thread %d message %d %5.2f|%-4s|%x %lld %%\n", thread, message,
+                                               message / 8.0, "ab", message, -1LL * message);
+      ASSERT_EQ(line, expected.toStdString());
+      ASSERT_EQ(message, last.count(thread) ? last[thread] + 1 : 0);
+      last[thread] = message;
+      ++count;
+   }
+   ASSERT_EQ(count, THREAD_COUNT * MESSAGE_COUNT);
+}
+
+TEST(AsyncLoggingTest, testStructuredFormatBufferReuse)
+{
+   ::setenv("PDK_LOGGING_TO_CONSOLE", "1", 1);
+   StderrCapture capture;
+   ASSERT_TRUE(pdk::enable_structured_logging());
+   // the same buffer holds another format for every call and changes
+   // again before the writer thread gets to the record
+   char format[32];
+   for (int i = 0; i < MESSAGE_COUNT; ++i) {
+      MessageLogger logger(__FILE__, __LINE__, PDK_FUNC_INFO);
+      if (i % 2) {
+         std::strcpy(format, "odd %d");
+         logger.warning(format, i);
+      } else {
+         std::strcpy(format, "even %s %d");
+         logger.warning(format, "message", i);
+      }
+   }
+   std::strcpy(format, "gone");
+   pdk::disable_async_logging();
+   capture.restore();
+   int count = 0;
+   for (const std::string &line : capture.getLines()) {
+      const std::string expected = count % 2 ? "odd " + std::to_string(count) + "\n"
+                                             : "even message " + std::to_string(count) + "\n";
+      ASSERT_EQ(line, expected);
+      ++count;
+   }
+   ASSERT_EQ(count, MESSAGE_COUNT);
+}
+
+#ifdef PDK_OS_LINUX
+TEST(AsyncLoggingTest, testStructuredTextKeepsThreadId)
+{
+   // the child reads the message pattern from the environment on first use
+   ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+   ASSERT_EXIT({
+      ::setenv("PDK_MESSAGE_PATTERN", "%{threadid} %{message}", 1);
+      ::setenv("PDK_LOGGING_TO_CONSOLE", "1", 1);
+      StderrCapture capture;
+      pdk::enable_structured_logging();
+      std::thread thread([]() {
+         MessageLogger(__FILE__, __LINE__, PDK_FUNC_INFO).warning("from %ld", static_cast<long>(::syscall(SYS_gettid)));
+      });
+      thread.join();
+      pdk::disable_async_logging();
+      capture.restore();
+      const std::vector<std::string> lines = capture.getLines();
+      long threadId = -1;
+      long logged = -2;
+      const bool matches = lines.size() == 1 &&
+            std::sscanf(lines[0].c_str(), "%ld from %ld", &threadId, &logged) == 2 && threadId == logged;
+      std::exit(matches ? 0 : 1);
+   }, ::testing::ExitedWithCode(0), "");
+}
+#endif
+
+TEST(AsyncLoggingTest, testFatalWarningIsNotDeferred)
+{
+   // the child runs this test alone, the fatal counters read the
+   // environment on first use
+   ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+   ASSERT_DEATH({
+      ::setenv("PDK_FATAL_WARNINGS", "1", 1);
+      ::setenv("PDK_LOGGING_TO_CONSOLE", "1", 1);
+      pdk::enable_structured_logging();
+      MessageLogger(__FILE__, __LINE__, PDK_FUNC_INFO).warning("fatal warning %d", 42);
+   }, "fatal warning 42");
+}
+
+TEST(AsyncLoggingTest, testBinaryLogRoundTrip)
+{
+   char path[] = "/tmp/pdk_binary_log_XXXXXX";
+   const int fd = ::mkstemp(path);
+   ASSERT_NE(fd, -1);
+   ::close(fd);
+   ASSERT_TRUE(pdk::enable_async_logging(LogOverflowPolicy::Block, 4096));
+   ASSERT_TRUE(pdk::enable_structured_logging(path));
+   int written = 0;
+   for (int i = 0; i < MESSAGE_COUNT; ++i) {
+      MessageLogger logger(__FILE__, __LINE__, PDK_FUNC_INFO, i % 2 ? "structured" : "default");
+      if (i % 100 == 0) {
+         // %n cannot be deferred, the text of it is
+         logger.critical("message %d%n of %s", i, &written, "text");
+      } else {
+         logger.critical("message %d of %s", i, i % 3 ? "binary" : nullptr);
+      }
+   }
+   pdk::disable_structured_logging();
+   pdk::disable_async_logging();
+   FILE *output = std::tmpfile();
+   ASSERT_TRUE(pdk::decode_binary_log(path, output));
+   int count = 0;
+   for (const std::string &line : read_lines(output)) {
+      char category[32];
+      int message = -1;
+      char source[32];
+      const int fields = std::sscanf(line.c_str(), "%*lld.%*lld %*llu critical %31[^:]: message %d of %31s",
+                                     category, &message, source);
+      ASSERT_EQ(message, count) << line;
+      ASSERT_STREQ(category, message % 2 ? "structured" : "default");
+      if (message % 100 == 0) {
+         ASSERT_EQ(fields, 3);
+         ASSERT_STREQ(source, "text");
+      } else if (message % 3) {
+         ASSERT_EQ(fields, 3);
+         ASSERT_STREQ(source, "binary");
+      } else {
+         // a null string prints nothing
+         ASSERT_EQ(fields, 2);
+      }
+      ++count;
+   }
+   std::fclose(output);
+   ASSERT_EQ(count, MESSAGE_COUNT);
+   ASSERT_EQ(written, 12);
+   // a file cut short is not decoded
+   ASSERT_EQ(::truncate(path, 100), 0);
+   output = std::fopen("/dev/null", "w");
+   ASSERT_FALSE(pdk::decode_binary_log(path, output));
+   std::fclose(output);
+   ::unlink(path);
+}
+
+#endif // PDK_OS_UNIX
@@ -0,0 +1,181 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/global/Global.h"
+
+#ifdef PDK_OS_LINUX
+
+#include "pdk/kernel/CoreApplication.h"
+#include "pdk/kernel/EventDispatcherEpoll.h"
+#include "pdk/kernel/SocketNotifier.h"
+#include "pdk/kernel/CoreEvent.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstdlib>
+
+using pdk::kernel::CoreApplication;
+using pdk::kernel::EventDispatcherEpoll;
+using pdk::kernel::SocketNotifier;
+using pdk::kernel::Event;
+using pdk::kernel::EventLoop;
+
+namespace {
+
+class CountingNotifier : public SocketNotifier
+{
+public:
+   CountingNotifier(int socket, Type type)
+      : SocketNotifier(socket, type)
+   {}
+
+   int m_activated = 0;
+   // deleted on the first activation
+   CountingNotifier **m_victim = nullptr;
+
+protected:
+   bool event(Event *event) override
+   {
+      if (event->getType() == Event::Type::SocketActive) {
+         ++m_activated;
+         if (m_victim && *m_victim) {
+            (*m_victim)->m_victim = nullptr;
+            delete *m_victim;
+            *m_victim = nullptr;
+         }
+      }
+      return SocketNotifier::event(event);
+   }
+};
+
+class EventDispatcherEpollTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   {
+      ::unsetenv("PDK_EVENT_DISPATCHER_POLL");
+      m_app = new CoreApplication(m_argc, m_argv);
+      ASSERT_EQ(::socketpair(AF_UNIX, SOCK_STREAM, 0, m_fds), 0);
+   }
+
+   void TearDown() override
+   {
+      close_fd(m_fds[0]);
+      close_fd(m_fds[1]);
+      delete m_app;
+   }
+
+   static void close_fd(int &fd)
+   {
+      if (fd != -1) {
+         ::close(fd);
+         fd = -1;
+      }
+   }
+
+   void writeByte(int fd)
+   {
+      char c = 'x';
+      ASSERT_EQ(::write(fd, &c, 1), 1);
+   }
+
+   void readByte(int fd)
+   {
+      char c;
+      ASSERT_EQ(::read(fd, &c, 1), 1);
+   }
+
+   int m_argc = 1;
+   char m_arg0[16] = "EpollTest";
+   char *m_argv[2] = {m_arg0, nullptr};
+   CoreApplication *m_app = nullptr;
+   int m_fds[2] = {-1, -1};
+};
+
+} // anonymous
+
+TEST_F(EventDispatcherEpollTest, testDefaultDispatcherIsEpoll)
+{
+   ASSERT_TRUE(dynamic_cast<EventDispatcherEpoll *>(CoreApplication::getEventDispatcher()) != nullptr);
+}
+
+TEST_F(EventDispatcherEpollTest, testReadNotifierActivated)
+{
+   CountingNotifier notifier(m_fds[0], SocketNotifier::Type::Read);
+   CoreApplication::processEvents();
+   ASSERT_EQ(notifier.m_activated, 0);
+   writeByte(m_fds[1]);
+   CoreApplication::processEvents();
+   ASSERT_EQ(notifier.m_activated, 1);
+   // level triggered, it keeps firing until the data is consumed
+   CoreApplication::processEvents();
+   ASSERT_EQ(notifier.m_activated, 2);
+   readByte(m_fds[0]);
+   CoreApplication::processEvents();
+   ASSERT_EQ(notifier.m_activated, 2);
+}
+
+TEST_F(EventDispatcherEpollTest, testReadAndWriteOnSameSocket)
+{
+   CountingNotifier reader(m_fds[0], SocketNotifier::Type::Read);
+   CountingNotifier writer(m_fds[0], SocketNotifier::Type::Write);
+   CoreApplication::processEvents();
+   ASSERT_EQ(reader.m_activated, 0);
+   ASSERT_EQ(writer.m_activated, 1);
+   writeByte(m_fds[1]);
+   CoreApplication::processEvents();
+   ASSERT_EQ(reader.m_activated, 1);
+   ASSERT_EQ(writer.m_activated, 2);
+   writer.setEnabled(false);
+   CoreApplication::processEvents();
+   ASSERT_EQ(reader.m_activated, 2);
+   ASSERT_EQ(writer.m_activated, 2);
+   writer.setEnabled(true);
+   CoreApplication::processEvents();
+   ASSERT_EQ(writer.m_activated, 3);
+}
+
+TEST_F(EventDispatcherEpollTest, testDeletePendingNotifier)
+{
+   CountingNotifier *first = new CountingNotifier(m_fds[0], SocketNotifier::Type::Write);
+   CountingNotifier *second = new CountingNotifier(m_fds[1], SocketNotifier::Type::Write);
+   // both sockets are writable, whichever is activated first deletes
+   // the other one while it is still pending
+   first->m_victim = &second;
+   second->m_victim = &first;
+   CoreApplication::processEvents();
+   ASSERT_TRUE((first == nullptr) != (second == nullptr));
+   CountingNotifier *survivor = first ? first : second;
+   ASSERT_EQ(survivor->m_activated, 1);
+   delete survivor;
+}
+
+TEST_F(EventDispatcherEpollTest, testClosedSocketIsDisabled)
+{
+   // keep the socket alive through a duplicate, so epoll still watches it
+   // after the descriptor the notifier knows about is gone
+   int dupFd = ::dup(m_fds[0]);
+   ASSERT_NE(dupFd, -1);
+   CountingNotifier notifier(m_fds[0], SocketNotifier::Type::Read);
+   close_fd(m_fds[0]);
+   close_fd(m_fds[1]);
+   CoreApplication::processEvents();
+   ASSERT_FALSE(notifier.isEnabled());
+   ASSERT_EQ(notifier.m_activated, 0);
+   ::close(dupFd);
+}
+
+#endif // PDK_OS_LINUX
@@ -0,0 +1,284 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/kernel/CoreApplication.h"
+#include "pdk/kernel/CoreEvent.h"
+#include "pdk/kernel/Object.h"
+#include "pdk/base/os/thread/Thread.h"
+#include "pdk/base/os/thread/internal/ThreadPrivate.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using pdk::kernel::CoreApplication;
+using pdk::kernel::Event;
+using pdk::kernel::Object;
+using pdk::os::thread::Thread;
+using pdk::os::thread::internal::PostEventList;
+using pdk::EventPriority;
+
+namespace {
+
+constexpr int POSTER_COUNT = 4;
+constexpr int EVENTS_PER_POSTER = 2000;
+
+Event::Type sg_plainType = static_cast<Event::Type>(Event::registerEventType());
+// folded by TestApplication::compressEvent()
+Event::Type sg_compressibleType = static_cast<Event::Type>(Event::registerEventType());
+
+class TaggedEvent : public Event
+{
+public:
+   TaggedEvent(Event::Type type, int poster, int sequence)
+      : Event(type),
+        m_poster(poster),
+        m_sequence(sequence)
+   {}
+
+   int m_poster;
+   int m_sequence;
+};
+
+struct Received
+{
+   Event::Type m_type;
+   int m_poster;
+   int m_sequence;
+   Thread *m_thread;
+};
+
+class TestApplication : public CoreApplication
+{
+public:
+   TestApplication(int &argc, char **argv)
+      : CoreApplication(argc, argv)
+   {}
+
+protected:
+   bool compressEvent(Event *event, Object *receiver, PostEventList *postedEvents) override
+   {
+      if (event->getType() == sg_compressibleType) {
+         for (size_t i = 0; i < postedEvents->size(); ++i) {
+            const auto &postEvent = postedEvents->at(i);
+            if (postEvent.m_receiver == receiver && postEvent.m_event
+                && postEvent.m_event->getType() == sg_compressibleType) {
+               delete event;
+               return true;
+            }
+         }
+         return false;
+      }
+      return CoreApplication::compressEvent(event, receiver, postedEvents);
+   }
+};
+
+class RecordingObject : public Object
+{
+public:
+   bool event(Event *event) override
+   {
+      if (event->getType() == sg_plainType || event->getType() == sg_compressibleType) {
+         TaggedEvent *tagged = static_cast<TaggedEvent *>(event);
+         std::lock_guard<std::mutex> locker(m_mutex);
+         m_received.push_back({tagged->getType(), tagged->m_poster, tagged->m_sequence,
+                               Thread::getCurrentThread()});
+         if (m_quitAfter > 0 && static_cast<int>(m_received.size()) == m_quitAfter) {
+            Thread::getCurrentThread()->quit();
+         }
+         return true;
+      }
+      return Object::event(event);
+   }
+
+   std::mutex m_mutex;
+   std::vector<Received> m_received;
+   int m_quitAfter = 0;
+};
+
+class PostEventTest : public ::testing::Test
+{
+protected:
+   void SetUp() override
+   {
+      m_app = new TestApplication(m_argc, m_argv);
+   }
+
+   void TearDown() override
+   {
+      delete m_app;
+   }
+
+   int m_argc = 1;
+   char m_arg0[16] = "PostEventTest";
+   char *m_argv[2] = {m_arg0, nullptr};
+   TestApplication *m_app = nullptr;
+};
+
+} // anonymous
+
+TEST_F(PostEventTest, testPriorityOrdering)
+{
+   RecordingObject receiver;
+   CoreApplication::postEvent(&receiver, new TaggedEvent(sg_plainType, 0, 0), EventPriority::LowEventPriority);
+   CoreApplication::postEvent(&receiver, new TaggedEvent(sg_plainType, 0, 1), EventPriority::NormalEventPriority);
+   CoreApplication::postEvent(&receiver, new TaggedEvent(sg_plainType, 0, 2), EventPriority::HighEventPriority);
+   CoreApplication::postEvent(&receiver, new TaggedEvent(sg_plainType, 0, 3), EventPriority::NormalEventPriority);
+   CoreApplication::postEvent(&receiver, new TaggedEvent(sg_plainType, 0, 4), EventPriority::HighEventPriority);
+   CoreApplication::sendPostedEvents(&receiver);
+   ASSERT_EQ(receiver.m_received.size(), 5u);
+   // by priority, in posting order within one priority
+   const int expected[] = {2, 4, 1, 3, 0};
+   for (int i = 0; i < 5; ++i) {
+      ASSERT_EQ(receiver.m_received[i].m_sequence, expected[i]);
+   }
+}
+
+TEST_F(PostEventTest, testCompressEvent)
+{
+   RecordingObject receiver;
+   for (int i = 0; i < 5; ++i) {
+      CoreApplication::postEvent(&receiver, new TaggedEvent(sg_compressibleType, 0, i));
+   }
+   // events posted from another thread are folded as well
+   std::thread poster([&receiver]() {
+      for (int i = 5; i < 10; ++i) {
+         CoreApplication::postEvent(&receiver, new TaggedEvent(sg_compressibleType, 1, i));
+      }
+   });
+   poster.join();
+   CoreApplication::postEvent(&receiver, new TaggedEvent(sg_plainType, 0, 10));
+   CoreApplication::sendPostedEvents(&receiver);
+   ASSERT_EQ(receiver.m_received.size(), 2u);
+   ASSERT_EQ(receiver.m_received[0].m_type, sg_compressibleType);
+   ASSERT_EQ(receiver.m_received[0].m_sequence, 0);
+   ASSERT_EQ(receiver.m_received[1].m_sequence, 10);
+}
+
+TEST_F(PostEventTest, testConcurrentPosting)
+{
+   RecordingObject receiver;
+   std::vector<std::thread> posters;
+   for (int p = 0; p < POSTER_COUNT; ++p) {
+      posters.emplace_back([&receiver, p]() {
+         for (int i = 0; i < EVENTS_PER_POSTER; ++i) {
+            CoreApplication::postEvent(&receiver, new TaggedEvent(sg_plainType, p, i));
+         }
+      });
+   }
+   // drain while the posters are still running
+   while (static_cast<int>(receiver.m_received.size()) < POSTER_COUNT * EVENTS_PER_POSTER) {
+      CoreApplication::sendPostedEvents(&receiver);
+      std::this_thread::yield();
+   }
+   for (std::thread &poster : posters) {
+      poster.join();
+   }
+   CoreApplication::sendPostedEvents(&receiver);
+   ASSERT_EQ(static_cast<int>(receiver.m_received.size()), POSTER_COUNT * EVENTS_PER_POSTER);
+   // every poster's events arrive in the order they were posted
+   std::vector<int> next(POSTER_COUNT, 0);
+   for (const Received &event : receiver.m_received) {
+      ASSERT_EQ(event.m_sequence, next[event.m_poster]);
+      ++next[event.m_poster];
+   }
+}
+
+TEST_F(PostEventTest, testPostToObjectMovedToAnotherThread)
+{
+   const int count = 20;
+   Thread worker;
+   RecordingObject *receiver = new RecordingObject;
+   receiver->m_quitAfter = count;
+   // half of the events are still queued for the main thread when the
+   // receiver moves, they have to follow it
+   for (int i = 0; i < count / 2; ++i) {
+      CoreApplication::postEvent(receiver, new TaggedEvent(sg_plainType, 0, i));
+   }
+   receiver->moveToThread(&worker);
+   for (int i = count / 2; i < count; ++i) {
+      CoreApplication::postEvent(receiver, new TaggedEvent(sg_plainType, 0, i));
+   }
+   // nothing is delivered on the old thread
+   CoreApplication::sendPostedEvents();
+   ASSERT_TRUE(receiver->m_received.empty());
+   worker.start();
+   ASSERT_TRUE(worker.wait(10000));
+   ASSERT_EQ(static_cast<int>(receiver->m_received.size()), count);
+   for (int i = 0; i < count; ++i) {
+      ASSERT_EQ(receiver->m_received[i].m_sequence, i);
+      ASSERT_EQ(receiver->m_received[i].m_thread, &worker);
+   }
+   delete receiver;
+}
+
+TEST_F(PostEventTest, testRemovePostedEventsFromInbox)
+{
+   RecordingObject receiver;
+   std::thread poster([&receiver]() {
+      for (int i = 0; i < 10; ++i) {
+         CoreApplication::postEvent(&receiver, new TaggedEvent(i % 2 ? sg_plainType : sg_compressibleType, 1, i));
+      }
+   });
+   poster.join();
+   // only the events of the given type go away, nothing was merged yet
+   CoreApplication::removePostedEvents(&receiver, sg_compressibleType);
+   CoreApplication::sendPostedEvents(&receiver);
+   ASSERT_EQ(receiver.m_received.size(), 5u);
+   for (const Received &event : receiver.m_received) {
+      ASSERT_EQ(event.m_type, sg_plainType);
+   }
+   receiver.m_received.clear();
+   std::thread secondPoster([&receiver]() {
+      for (int i = 0; i < 10; ++i) {
+         CoreApplication::postEvent(&receiver, new TaggedEvent(sg_plainType, 1, i));
+      }
+   });
+   secondPoster.join();
+   CoreApplication::removePostedEvents(&receiver);
+   CoreApplication::sendPostedEvents(&receiver);
+   ASSERT_TRUE(receiver.m_received.empty());
+}
+
+TEST_F(PostEventTest, testDeleteMovedReceiverBeforeMerge)
+{
+   // events posted from other threads while the receiver moves away must
+   // never be merged by the old thread, the receiver is gone by then
+   for (int round = 0; round < 50; ++round) {
+      Thread worker;
+      RecordingObject *receiver = new RecordingObject;
+      std::atomic<bool> started(false);
+      std::vector<std::thread> posters;
+      for (int p = 0; p < POSTER_COUNT; ++p) {
+         posters.emplace_back([receiver, p, &started]() {
+            started = true;
+            for (int i = 0; i < 100; ++i) {
+               CoreApplication::postEvent(receiver, new TaggedEvent(sg_plainType, p, i));
+            }
+         });
+      }
+      while (!started.load()) {
+         std::this_thread::yield();
+      }
+      receiver->moveToThread(&worker);
+      for (std::thread &poster : posters) {
+         poster.join();
+      }
+      delete receiver;
+      CoreApplication::sendPostedEvents();
+   }
+}
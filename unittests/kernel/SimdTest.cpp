@@ -0,0 +1,115 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/pal/kernel/Simd.h"
+#include "pdk/base/lang/String.h"
+#include "pdk/base/ds/ByteArray.h"
+
+#include <cstdlib>
+#include <random>
+
+using pdk::lang::String;
+using pdk::lang::Character;
+using pdk::ds::ByteArray;
+using pdk::pal::kernel::SimdKernel;
+using pdk::pal::kernel::select_simd_kernel;
+
+namespace {
+
+int kernel_one()
+{
+   return 1;
+}
+
+int kernel_two()
+{
+   return 2;
+}
+
+int kernel_three()
+{
+   return 3;
+}
+
+} // anonymous
+
+TEST(SimdTest, testSelectKernel)
+{
+   using Function = int (*)();
+   // no cpu has every feature bit, the portable entry is the last resort
+   const SimdKernel<Function> unsupported[] = {
+      {~PDK_UINT64_C(0), kernel_one, "everything"},
+      {0, kernel_two, "portable"}
+   };
+   ASSERT_EQ(select_simd_kernel(unsupported).function(), 2);
+   ASSERT_STREQ(select_simd_kernel(unsupported).name, "portable");
+   // an entry without requirements stops the search
+   const SimdKernel<Function> baseline[] = {
+      {~PDK_UINT64_C(0), kernel_one, "everything"},
+      {0, kernel_two, "baseline"},
+      {0, kernel_three, "portable"}
+   };
+   ASSERT_EQ(select_simd_kernel(baseline).function(), 2);
+}
+
+#if defined(PDK_PROCESSOR_X86) && (defined(PDK_CC_GNU) || defined(PDK_CC_CLANG))
+TEST(SimdTest, testDetectionMatchesCompiler)
+{
+   __builtin_cpu_init();
+   ASSERT_EQ(CPU_HAS_FEATURE(SSE2), __builtin_cpu_supports("sse2") != 0);
+   ASSERT_EQ(CPU_HAS_FEATURE(SSE4_2), __builtin_cpu_supports("sse4.2") != 0);
+   ASSERT_EQ(CPU_HAS_FEATURE(POPCNT), __builtin_cpu_supports("popcnt") != 0);
+   // a feature masked by PDK_NO_CPU_FEATURE is reported missing
+   if (!std::getenv("PDK_NO_CPU_FEATURE")) {
+      ASSERT_EQ(CPU_HAS_FEATURE(AVX2), __builtin_cpu_supports("avx2") != 0);
+   }
+}
+#endif
+
+TEST(SimdTest, testStringKernels)
+{
+   // every length around the 16 and 32 unit steps, at every start offset
+   std::mt19937 random(20261017);
+   for (int length = 0; length < 80; ++length) {
+      for (int offset = 0; offset < 4; ++offset) {
+         ByteArray latin1(offset + length, 'x');
+         String unicode(offset + length, Character('x'));
+         for (int i = 0; i < offset + length; ++i) {
+            latin1[i] = char(random() % 256);
+            unicode[i] = Character(char16_t(random() % 3 ? random() % 0x100 : random() % 0xfffe));
+         }
+         const String decoded = String::fromLatin1(latin1.getConstRawData() + offset, length);
+         ASSERT_EQ(decoded.size(), length);
+         for (int i = 0; i < length; ++i) {
+            ASSERT_EQ(decoded.at(i).unicode(), uchar(latin1.at(offset + i)));
+         }
+         const String source = unicode.substring(offset);
+         const ByteArray encoded = source.toLatin1();
+         ASSERT_EQ(encoded.size(), length);
+         for (int i = 0; i < length; ++i) {
+            const char16_t unit = source.at(i).unicode();
+            ASSERT_EQ(uchar(encoded.at(i)), unit > 0xff ? uchar('?') : uchar(unit));
+         }
+         for (int i = 0; i < length; ++i) {
+            const Character needle = source.at(i);
+            ASSERT_EQ(source.indexOf(needle), source.substring(0, i + 1).indexOf(needle));
+            ASSERT_TRUE(source.indexOf(needle) <= i);
+            ASSERT_EQ(source.at(source.indexOf(needle)), needle);
+         }
+         ASSERT_EQ(source.indexOf(Character(char16_t(0xfffe))), -1);
+      }
+   }
+}
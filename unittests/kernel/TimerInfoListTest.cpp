@@ -0,0 +1,121 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/kernel/Object.h"
+#include "pdk/kernel/internal/TimerInfoUnixPrivate.h"
+#include "pdk/kernel/internal/CoreUnixPrivate.h"
+
+using pdk::kernel::Object;
+using pdk::kernel::internal::TimerInfo;
+using pdk::kernel::internal::TimerInfoList;
+using pdk::kernel::operator<;
+
+namespace {
+
+void delete_timers(TimerInfoList &timers)
+{
+   for (TimerInfo *t : timers) {
+      delete t;
+   }
+   timers.clear();
+}
+
+bool is_heap_ordered(const TimerInfoList &timers)
+{
+   for (size_t i = 0; i < timers.size(); ++i) {
+      if (timers[i]->m_heapIndex != i) {
+         return false;
+      }
+      if (i > 0 && timers[i]->m_timeout < timers[(i - 1) / 2]->m_timeout) {
+         return false;
+      }
+   }
+   return true;
+}
+
+} // anonymous
+
+TEST(TimerInfoListTest, testTimerWaitPicksEarliestTimer)
+{
+   Object receiver;
+   TimerInfoList timers;
+   timespec tm;
+   ASSERT_FALSE(timers.timerWait(tm));
+   timers.registerTimer(1, 5000, pdk::TimerType::PreciseTimer, &receiver);
+   timers.registerTimer(2, 300, pdk::TimerType::PreciseTimer, &receiver);
+   timers.registerTimer(3, 2000, pdk::TimerType::PreciseTimer, &receiver);
+   ASSERT_TRUE(timers.timerWait(tm));
+   ASSERT_EQ(tm.tv_sec, 0);
+   ASSERT_LE(tm.tv_nsec, 300 * 1000 * 1000);
+   ASSERT_TRUE(timers.unregisterTimer(2));
+   ASSERT_TRUE(timers.timerWait(tm));
+   ASSERT_EQ(tm.tv_sec, 1);
+   ASSERT_FALSE(timers.unregisterTimer(2));
+   ASSERT_TRUE(is_heap_ordered(timers));
+   delete_timers(timers);
+}
+
+TEST(TimerInfoListTest, testRemainingTime)
+{
+   Object receiver;
+   TimerInfoList timers;
+   timers.registerTimer(7, 1000, pdk::TimerType::PreciseTimer, &receiver);
+   int remaining = timers.timerRemainingTime(7);
+   ASSERT_GT(remaining, 900);
+   ASSERT_LE(remaining, 1000);
+   delete_timers(timers);
+}
+
+TEST(TimerInfoListTest, testHeapStaysOrdered)
+{
+   Object receiver;
+   Object other;
+   TimerInfoList timers;
+   for (int i = 1; i <= 500; ++i) {
+      int interval = 50 + (i * 7919) % 20000;
+      timers.registerTimer(i, interval, pdk::TimerType::CoarseTimer, (i % 3) ? &receiver : &other);
+   }
+   ASSERT_TRUE(is_heap_ordered(timers));
+   for (int i = 1; i <= 500; i += 4) {
+      ASSERT_TRUE(timers.unregisterTimer(i));
+   }
+   ASSERT_TRUE(is_heap_ordered(timers));
+   ASSERT_EQ(timers.timerRemainingTime(1), -1);
+   ASSERT_TRUE(timers.unregisterTimers(&other));
+   ASSERT_TRUE(is_heap_ordered(timers));
+   ASSERT_TRUE(timers.getRegisteredTimers(&other).empty());
+   for (TimerInfo *t : timers) {
+      ASSERT_EQ(t->m_obj, &receiver);
+   }
+   delete_timers(timers);
+}
+
+TEST(TimerInfoListTest, testEqualTimeoutsKeepInsertionOrder)
+{
+   Object receiver;
+   TimerInfoList timers;
+   // very coarse timers are rounded to full seconds, all of these
+   // share their timeout unless a second boundary is crossed meanwhile
+   for (int i = 1; i <= 16; ++i) {
+      timers.registerTimer(i, 1000, pdk::TimerType::VeryCoarseTimer, &receiver);
+   }
+   ASSERT_TRUE(is_heap_ordered(timers));
+   for (int i = 1; i <= 16; ++i) {
+      ASSERT_EQ(timers.front()->m_id, i);
+      ASSERT_TRUE(timers.unregisterTimer(i));
+   }
+   ASSERT_TRUE(timers.empty());
+}
@@ -0,0 +1,223 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+#include "gtest/gtest.h"
+#include "pdk/base/ds/ByteArray.h"
+#include "pdk/base/lang/String.h"
+#include "pdk/utils/Locale.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+using pdk::ds::ByteArray;
+using pdk::lang::String;
+using pdk::lang::Latin1String;
+using pdk::utils::Locale;
+
+namespace {
+
+double from_bits(pdk::puint64 bits)
+{
+   double d;
+   std::memcpy(&d, &bits, sizeof(d));
+   return d;
+}
+
+pdk::puint64 to_bits(double d)
+{
+   pdk::puint64 bits;
+   std::memcpy(&bits, &d, sizeof(bits));
+   return bits;
+}
+
+ByteArray shortest(double d)
+{
+   return ByteArray::number(d, 'g', Locale::FloatingPointShortest);
+}
+
+// significant digits in the mantissa of a formatted number, the zeros
+// that pad an integer do not count
+int significant_digits(const ByteArray &text)
+{
+   int count = 0;
+   int trailingZeros = 0;
+   for (int i = 0; i < text.size() && text.at(i) != 'e'; ++i) {
+      const char c = text.at(i);
+      if (c < '0' || c > '9' || (count == 0 && c == '0')) {
+         continue;
+      }
+      trailingZeros = c == '0' ? trailingZeros + 1 : 0;
+      ++count;
+   }
+   return count - trailingZeros;
+}
+
+// the fewest digits printf needs for d to read back
+int fewest_digits(double d)
+{
+   char text[40];
+   for (int precision = 1; precision < 17; ++precision) {
+      std::snprintf(text, sizeof(text), "%.*e", precision - 1, d);
+      if (std::strtod(text, nullptr) == d) {
+         return precision;
+      }
+   }
+   return 17;
+}
+
+// random doubles of every exponent, subnormals and short mantissas included
+double random_double(std::mt19937_64 &random, int i)
+{
+   pdk::puint64 bits = random();
+   switch (i % 4) {
+   case 1:
+      bits &= PDK_UINT64_C(0x800fffffffffffff);
+      break;
+   case 2:
+      bits &= ~((PDK_UINT64_C(1) << (random() % 52)) - 1);
+      break;
+   case 3:
+      bits = (bits & PDK_UINT64_C(0x800fffffffffffff)) | (pdk::puint64(1023 + random() % 80 - 40) << 52);
+      break;
+   }
+   return from_bits(bits);
+}
+
+} // anonymous
+
+TEST(DoubleConversionTest, testShortestKnownValues)
+{
+   ASSERT_EQ(shortest(0.1), ByteArray("0.1"));
+   ASSERT_EQ(shortest(0.3), ByteArray("0.3"));
+   ASSERT_EQ(shortest(-2.5), ByteArray("-2.5"));
+   ASSERT_EQ(shortest(1.0), ByteArray("1"));
+   ASSERT_EQ(shortest(0.0), ByteArray("0"));
+   ASSERT_EQ(shortest(-0.0), ByteArray("0"));
+   ASSERT_EQ(shortest(123456.0), ByteArray("123456"));
+   ASSERT_EQ(shortest(1e23), ByteArray("1e+23"));
+   ASSERT_EQ(shortest(5e-324), ByteArray("5e-324"));
+   ASSERT_EQ(shortest(DBL_MAX), ByteArray("1.7976931348623157e+308"));
+   ASSERT_EQ(shortest(2.0 / 3), ByteArray("0.6666666666666666"));
+   // a power of two, the lower neighbour is closer than the upper one
+   ASSERT_EQ(shortest(std::ldexp(1.0, -24)), ByteArray("5.960464477539063e-08"));
+}
+
+TEST(DoubleConversionTest, testShortestRoundTrip)
+{
+   std::mt19937_64 random(20261017);
+   for (int i = 0; i < 200000; ++i) {
+      const double d = random_double(random, i);
+      if (!std::isfinite(d)) {
+         continue;
+      }
+      const ByteArray text = shortest(d);
+      bool ok = false;
+      const double back = text.toDouble(&ok);
+      ASSERT_TRUE(ok) << text.getConstRawData();
+      ASSERT_EQ(to_bits(back), to_bits(d == 0 ? 0.0 : d)) << text.getConstRawData();
+      ASSERT_EQ(significant_digits(text), d == 0 ? 0 : fewest_digits(d)) << text.getConstRawData();
+   }
+}
+
+TEST(DoubleConversionTest, testFixedPrecisionMatchesPrintf)
+{
+   std::mt19937_64 random(7);
+   std::uniform_real_distribution<double> mantissa(1.0, 10.0);
+   char expected[400];
+   for (int i = 0; i < 20000; ++i) {
+      // short decimals take the shortest digits, long ones snprintf
+      double d = mantissa(random) * std::pow(10.0, static_cast<int>(random() % 20) - 4);
+      if (i % 2) {
+         d = static_cast<double>(random() % 100000) / 1000;
+      }
+      for (int precision : {1, 3, 6, 10, 15}) {
+         std::snprintf(expected, sizeof(expected), "%.*e", precision, d);
+         ASSERT_EQ(ByteArray::number(d, 'e', precision), ByteArray(expected));
+         std::snprintf(expected, sizeof(expected), "%.*f", precision, d);
+         ASSERT_EQ(ByteArray::number(d, 'f', precision), ByteArray(expected));
+      }
+   }
+}
+
+TEST(DoubleConversionTest, testParse)
+{
+   std::mt19937_64 random(42);
+   char text[64];
+   for (int i = 0; i < 200000; ++i) {
+      const double d = random_double(random, i);
+      if (!std::isfinite(d)) {
+         continue;
+      }
+      std::snprintf(text, sizeof(text), "%.*e", static_cast<int>(random() % 18), d);
+      const double expected = std::strtod(text, nullptr);
+      if (expected == 0 || !std::isfinite(expected)) {
+         continue;
+      }
+      bool ok = false;
+      ASSERT_EQ(to_bits(ByteArray(text).toDouble(&ok)), to_bits(expected)) << text;
+      ASSERT_TRUE(ok);
+   }
+   // random decimal text with up to 19 significant digits
+   for (int i = 0; i < 100000; ++i) {
+      ByteArray number;
+      const int digits = 1 + random() % 19;
+      for (int j = 0; j < digits; ++j) {
+         number.append(static_cast<char>('0' + random() % 10));
+      }
+      number.insert(random() % (digits + 1), '.');
+      number.append('e');
+      number.append(ByteArray::number(static_cast<int>(random() % 600) - 300));
+      const double expected = std::strtod(number.getConstRawData(), nullptr);
+      if (expected == 0 || expected < DBL_MIN) {
+         continue;
+      }
+      ASSERT_EQ(to_bits(number.toDouble()), to_bits(expected)) << number.getConstRawData();
+   }
+}
+
+TEST(DoubleConversionTest, testParseEdgeCases)
+{
+   bool ok = false;
+   ASSERT_EQ(ByteArray("0").toDouble(&ok), 0.0);
+   ASSERT_TRUE(ok);
+   ASSERT_TRUE(std::signbit(ByteArray("-0").toDouble(&ok)));
+   ASSERT_TRUE(ok);
+   ASSERT_EQ(ByteArray(".5").toDouble(&ok), 0.5);
+   ASSERT_TRUE(ok);
+   ASSERT_EQ(ByteArray("5.").toDouble(&ok), 5.0);
+   ASSERT_TRUE(ok);
+   ASSERT_EQ(ByteArray("+1.5E-3").toDouble(&ok), 1.5e-3);
+   ASSERT_TRUE(ok);
+   ASSERT_EQ(ByteArray("9007199254740993").toDouble(&ok), 9007199254740992.0);
+   ASSERT_TRUE(ok);
+   ASSERT_EQ(ByteArray("123456789012345678901234567890").toDouble(&ok), 1.2345678901234568e29);
+   ASSERT_TRUE(ok);
+   ASSERT_EQ(ByteArray("4.9e-324").toDouble(&ok), 5e-324);
+   ASSERT_TRUE(ok);
+   ASSERT_EQ(ByteArray("1.7976931348623157e308").toDouble(&ok), DBL_MAX);
+   ASSERT_TRUE(ok);
+   ByteArray("1e400").toDouble(&ok);
+   ASSERT_FALSE(ok);
+   ByteArray("1e-400").toDouble(&ok);
+   ASSERT_FALSE(ok);
+   ByteArray("1.5x").toDouble(&ok);
+   ASSERT_FALSE(ok);
+   ByteArray(".").toDouble(&ok);
+   ASSERT_FALSE(ok);
+}
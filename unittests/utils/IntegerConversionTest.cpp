@@ -0,0 +1,184 @@
+// @copyright 2017-2018 zzu_softboy <zzu_softboy@163.com>
+//
+// THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+// IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+// OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+// IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+// INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+// NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+// DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+// THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+// THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// Created by softboy on 2026/10/17.
+
+
+#include "gtest/gtest.h"
+#include "pdk/base/ds/ByteArray.h"
+#include "pdk/base/io/TextStream.h"
+#include "pdk/base/lang/String.h"
+#include "pdk/utils/Locale.h"
+#include "pdk/utils/internal/LocaleToolsPrivate.h"
+
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+using pdk::ds::ByteArray;
+using pdk::io::TextStream;
+using pdk::lang::String;
+using pdk::lang::Latin1String;
+using pdk::utils::Locale;
+using pdk::utils::internal::LONGLONG_DECIMAL_BUFFER_SIZE;
+using pdk::utils::internal::pdk_lltoa_decimal;
+using pdk::utils::internal::pdk_ulltoa_decimal;
+using pdk::utils::internal::pdk_strntoll_decimal;
+using pdk::utils::internal::pdk_strntoull_decimal;
+
+namespace {
+
+// values of every length, the shift spreads them over all digit counts
+pdk::puint64 random_value(std::mt19937_64 &random)
+{
+   return random() >> (random() % 64);
+}
+
+bool parse_signed(const char *text, pdk::plonglong &value)
+{
+   return pdk_strntoll_decimal(text, static_cast<int>(std::strlen(text)), value);
+}
+
+bool parse_unsigned(const char *text, pdk::pulonglong &value)
+{
+   return pdk_strntoull_decimal(text, static_cast<int>(std::strlen(text)), value);
+}
+
+} // anonymous
+
+TEST(IntegerConversionTest, testFormatDecimal)
+{
+   std::mt19937_64 random(20261017);
+   char buffer[LONGLONG_DECIMAL_BUFFER_SIZE];
+   char expected[32];
+   for (int i = 0; i < 200000; ++i) {
+      const pdk::puint64 value = random_value(random);
+      int length = pdk_ulltoa_decimal(value, buffer);
+      ASSERT_EQ(length, std::snprintf(expected, sizeof(expected), "%llu", static_cast<unsigned long long>(value)));
+      ASSERT_EQ(std::memcmp(buffer, expected, length), 0) << expected;
+      const pdk::pint64 signedValue = static_cast<pdk::pint64>(random()) >> (random() % 64);
+      length = pdk_lltoa_decimal(signedValue, buffer);
+      ASSERT_EQ(length, std::snprintf(expected, sizeof(expected), "%lld", static_cast<long long>(signedValue)));
+      ASSERT_EQ(std::memcmp(buffer, expected, length), 0) << expected;
+   }
+   ASSERT_EQ(pdk_lltoa_decimal(LLONG_MIN, buffer), 20);
+   ASSERT_EQ(std::memcmp(buffer, "-9223372036854775808", 20), 0);
+   ASSERT_EQ(pdk_ulltoa_decimal(ULLONG_MAX, buffer), 20);
+   ASSERT_EQ(std::memcmp(buffer, "18446744073709551615", 20), 0);
+   ASSERT_EQ(pdk_ulltoa_decimal(0, buffer), 1);
+   ASSERT_EQ(buffer[0], '0');
+}
+
+TEST(IntegerConversionTest, testParseDecimal)
+{
+   std::mt19937_64 random(7);
+   char text[32];
+   for (int i = 0; i < 200000; ++i) {
+      const pdk::puint64 value = random_value(random);
+      std::snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(value));
+      pdk::pulonglong parsed = 0;
+      ASSERT_TRUE(parse_unsigned(text, parsed)) << text;
+      ASSERT_EQ(parsed, value);
+      const pdk::pint64 signedValue = static_cast<pdk::pint64>(value);
+      std::snprintf(text, sizeof(text), "%lld", static_cast<long long>(signedValue));
+      pdk::plonglong signedParsed = 0;
+      ASSERT_TRUE(parse_signed(text, signedParsed)) << text;
+      ASSERT_EQ(signedParsed, signedValue);
+   }
+   pdk::plonglong value = 0;
+   pdk::pulonglong unsignedValue = 0;
+   ASSERT_TRUE(parse_signed("+0000000000000000000000042", value));
+   ASSERT_EQ(value, 42);
+   ASSERT_TRUE(parse_signed("-9223372036854775808", value));
+   ASSERT_EQ(value, LLONG_MIN);
+   ASSERT_FALSE(parse_signed("9223372036854775808", value));
+   ASSERT_FALSE(parse_signed("-9223372036854775809", value));
+   ASSERT_TRUE(parse_unsigned("18446744073709551615", unsignedValue));
+   ASSERT_EQ(unsignedValue, ULLONG_MAX);
+   ASSERT_FALSE(parse_unsigned("18446744073709551616", unsignedValue));
+   ASSERT_FALSE(parse_unsigned("100000000000000000000", unsignedValue));
+   ASSERT_FALSE(parse_unsigned("-1", unsignedValue));
+   for (const char *junk : {"", "+", "-", " 1", "1 ", "12345678x", "1234567812345678-", "0x10", "1e3"}) {
+      ASSERT_FALSE(parse_signed(junk, value)) << junk;
+      ASSERT_FALSE(parse_unsigned(junk, unsignedValue)) << junk;
+   }
+}
+
+TEST(IntegerConversionTest, testStringAndByteArray)
+{
+   ASSERT_EQ(String::number(-1234567890123LL), Latin1String("-1234567890123"));
+   ASSERT_EQ(String::number(0), Latin1String("0"));
+   ASSERT_EQ(String::number(ULLONG_MAX), Latin1String("18446744073709551615"));
+   ASSERT_EQ(ByteArray::number(LLONG_MIN), ByteArray("-9223372036854775808"));
+   ASSERT_EQ(ByteArray::number(-255, 16), ByteArray("ffffffffffffff01"));
+   bool ok = false;
+   ASSERT_EQ(String(Latin1String("-2147483648")).toInt(&ok), INT_MIN);
+   ASSERT_TRUE(ok);
+   String(Latin1String("2147483648")).toInt(&ok);
+   ASSERT_FALSE(ok);
+   ASSERT_EQ(String(Latin1String("18446744073709551615")).toULongLong(&ok), ULLONG_MAX);
+   ASSERT_TRUE(ok);
+   String(Latin1String("-1")).toUInt(&ok);
+   ASSERT_FALSE(ok);
+   // base 0 keeps reading a leading zero as octal
+   ASSERT_EQ(String(Latin1String("-010")).toInt(&ok, 0), -8);
+   ASSERT_TRUE(ok);
+   ASSERT_EQ(ByteArray("010").toInt(&ok, 0), 8);
+   ASSERT_TRUE(ok);
+   ASSERT_EQ(ByteArray("10").toInt(&ok, 0), 10);
+   ASSERT_TRUE(ok);
+   ASSERT_EQ(ByteArray("ff").toInt(&ok, 16), 255);
+   ASSERT_TRUE(ok);
+   ByteArray("12x").toInt(&ok);
+   ASSERT_FALSE(ok);
+   // a slice of a larger buffer is read without a terminated copy
+   const char csv[] = "17,-4096,65536";
+   ASSERT_EQ(ByteArray::fromRawData(csv + 3, 5).toInt(&ok), -4096);
+   ASSERT_TRUE(ok);
+   ASSERT_EQ(ByteArray::fromRawData(csv, 2).toShort(&ok), 17);
+   ASSERT_TRUE(ok);
+   ASSERT_EQ(ByteArray::fromRawData(csv + 9, 5).toUShort(&ok), 0);
+   ASSERT_FALSE(ok);
+}
+
+TEST(IntegerConversionTest, testLocaleAndTextStream)
+{
+   Locale c = Locale::c();
+   ASSERT_EQ(c.toString(-42), Latin1String("-42"));
+   bool ok = false;
+   ASSERT_EQ(c.toLongLong(String(Latin1String("+123456789012")), &ok), 123456789012LL);
+   ASSERT_TRUE(ok);
+   // grouping still applies from a thousand on
+   Locale german(Locale::Language::German, Locale::Country::Germany);
+   ASSERT_EQ(german.toString(999), Latin1String("999"));
+   String grouped;
+   grouped.append(german.getNegativeSign());
+   grouped.append(Latin1String("1"));
+   grouped.append(german.getGroupSeparator());
+   grouped.append(Latin1String("234"));
+   grouped.append(german.getGroupSeparator());
+   grouped.append(Latin1String("567"));
+   ASSERT_EQ(german.toString(-1234567), grouped);
+
+   String text;
+   TextStream stream(&text);
+   stream << -17 << ' ' << LLONG_MIN << ' ' << ULLONG_MAX << ' ' << 0u;
+   stream.flush();
+   ASSERT_EQ(text, Latin1String("-17 -9223372036854775808 18446744073709551615 0"));
+   text.clear();
+   stream.setNumberFlags(TextStream::NumberFlag::ForceSign);
+   stream << 5;
+   stream.flush();
+   ASSERT_EQ(text, Latin1String("+5"));
+}